@@ -64,6 +64,14 @@ layout (std430, binding = 5) buffer SpotLight
     SpotLightBuffer spotLights[];
 } spotLight;
 
+layout (std140, binding = 0) uniform CameraMatrices
+{
+    mat4 view;
+    mat4 projection;
+} cameraMatrices;
+
+#include "lightCluster.glsl"
+
 struct ShadowRenderingOptions
 {
     int directional;
@@ -215,7 +223,7 @@ vec4 CalcPointLight(PointLightBuffer light, int layer)
     float attenaution = 1.0 / (light.constant + light.linear * dist + light.quadric * (dist * dist));
 
     float shadow = 0.0;
-    if (renderingOptions.shadowRendering.point > 0)
+    if (renderingOptions.shadowRendering.point > 0 && layer < textureSize(pointLightShadowMap, 0).z)
         shadow = PointShadowMapCalculation(pointLightShadowMap, vec4(position - light.position.xyz, 1.0), dist, layer);
     return GrassRendering(normal, lightDir, vec3(light.color.diffuse), vec3(light.color.specular), vec3(light.color.ambient), shadow) * attenaution;
 }
@@ -233,7 +241,7 @@ vec4 CalcSpotLight(SpotLightBuffer light, int layer)
 
     vec4 fragPositionightSpace = light.lightSpace * vec4(position, 1.0);
     float shadow = 0.0;
-    if (renderingOptions.shadowRendering.spot > 0)
+    if (renderingOptions.shadowRendering.spot > 0 && layer < textureSize(spotLightShadowMap, 0).z)
         shadow = ShadowMapCalculation(spotLightShadowMap, fragPositionightSpace, lightDir, layer);
     return GrassRendering(normal, lightDir, vec3(light.color.diffuse), vec3(light.color.specular), vec3(light.color.ambient), shadow) * intesity * attenaution;
 }
@@ -252,20 +260,23 @@ void main()
 
     else
     {
-        vec4 lightStrength;
+        vec4 lightStrength = vec4(0.0);
         for (int i = 0; i < directionalLight.light_length; i++ )
         { 
             lightStrength += CalcDirectionalLight(directionalLight.directionalLights[i], i);
         }
 
-        for (int i = 0; i < pointLight.light_length; i++ )
+        uvec4 cluster = lightClusters.lightClusters[getClusterIndex()];
+        for (uint i = 0; i < cluster.y; i++ )
         { 
-            lightStrength += CalcPointLight(pointLight.pointLights[i], i);
+            uint lightIndex = lightIndices.lightIndices[cluster.x + i];
+            lightStrength += CalcPointLight(pointLight.pointLights[lightIndex], int(lightIndex));
         }
 
-        for (int i = 0; i < spotLight.light_length; i++ )
+        for (uint i = 0; i < cluster.z; i++ )
         { 
-            lightStrength += CalcSpotLight(spotLight.spotLights[i], i);
+            uint lightIndex = lightIndices.lightIndices[cluster.x + cluster.y + i];
+            lightStrength += CalcSpotLight(spotLight.spotLights[lightIndex], int(lightIndex));
         }
 
         outColor = vec4(mix(vec4(0.0), vec4(1.0), lightStrength));
@@ -2,8 +2,9 @@
 
 #extension GL_ARB_separate_shader_objects : enable
 
-layout (location = 0) in vec3 inPosition;
-layout (location = 1) in vec3 inNormal;
+// Per blade instance attributes
+layout (location = 0) in vec4 inPositionRotation;
+layout (location = 1) in vec4 inNormalRandom;
 
 layout (std140, binding = 0) uniform CameraMatrices
 {
@@ -11,23 +12,68 @@ layout (std140, binding = 0) uniform CameraMatrices
     mat4 projection;
 } cameraMatrices;
 
-layout(std140) uniform ModelMartices
+layout (std140, binding = 2) uniform Time
 {
-    mat4 modelMatrix;
-    mat4 normalMatrix;
-} modelMartices;
+    float timestamp;
+} time;
 
-layout (location = 0) out VS_OUT
+layout (std140) uniform GrassParameters
 {
-    mat4 view;
-    mat4 viewProjection;
-    vec3 normal;
-} vs_out;
+    float thick;
+    float height;
+    float stiffness;
+    float density;
+    float patchSize;
+    float lodNear;
+    float lodFar;
+    float minDensity;
+    uint segments;
+} grassParameters;
+
+layout (std140, binding = 6) uniform WindParameters
+{
+    vec2 direcion;
+    float speed;
+} windParameters;
+
+uniform sampler2D windMap;
+
+// Segments count of blades in current draw, blade is a triangle strip of 2 * segments + 1 vertices
+uniform uint segments;
+
+layout (location = 0) out vec3 position;
+layout (location = 1) out vec3 normal;
 
 void main()
 {
-    gl_Position = modelMartices.modelMatrix * vec4(inPosition, 1.0);
-    vs_out.normal = mat3(modelMartices.normalMatrix) * inNormal;
-    vs_out.view = cameraMatrices.view;
-    vs_out.viewProjection = cameraMatrices.projection * cameraMatrices.view;
-}
\ No newline at end of file
+    vec3 root = inPositionRotation.xyz;
+    vec3 up = normalize(inNormalRandom.xyz);
+    float rnd = inNormalRandom.w;
+
+    float height = grassParameters.height * (1.0 - 0.25 * rnd);
+    float thick = grassParameters.thick * (1.0 - 0.25 * fract(rnd * 7.31));
+    float bend = (rnd - 0.5) * height * (1.0 - grassParameters.stiffness);
+
+    vec3 facing = vec3(cos(inPositionRotation.w), 0.0, sin(inPositionRotation.w));
+    vec3 tangent = facing - dot(facing, up) * up;
+    tangent = length(tangent) > 0.001 ? normalize(tangent) : normalize(cross(up, vec3(0.0, 0.0, 1.0)));
+    vec3 bendDirection = cross(tangent, up);
+
+    float timestamp = time.timestamp * windParameters.speed;
+    vec2 texelPosition = vec2(root.x + timestamp, root.z + timestamp) * (-windParameters.direcion) * (windParameters.speed / 2);
+    vec2 windTexel = texture(windMap, texelPosition).rb * windParameters.speed * windParameters.direcion;
+    vec3 wind = vec3(windTexel.x, 0.0, windTexel.y) * height;
+
+    uint level = uint(gl_VertexID) / 2;
+    float t = float(level) / float(segments);
+    float side = level == segments ? 0.0 : (gl_VertexID % 2 == 0 ? -1.0 : 1.0);
+
+    // Quadratic curve from root, bend and wind grow towards the tip
+    vec3 sway = bendDirection * bend + wind;
+    vec3 center = root + up * height * t + sway * t * t;
+    vec3 alongBlade = up * height + 2.0 * t * sway;
+
+    position = center + tangent * thick * (1.0 - t) * side;
+    normal = normalize(cross(tangent, alongBlade));
+    gl_Position = cameraMatrices.projection * cameraMatrices.view * vec4(position, 1.0);
+}
@@ -0,0 +1,38 @@
+// Light clusters built by LightClusterGrid, shared by fragment shaders of solid and grass pipelines.
+// Shader declares position input and CameraMatrices block before including it
+
+layout (std140, binding = 8) uniform LightClusterParameters
+{
+    uvec4 gridSize;
+    vec2 screenSize;
+    float sliceScale;
+    float sliceBias;
+    float clusterNear;
+} lightClusterParameters;
+
+// x - offset in light indices, y - point lights count, z - spot lights count
+layout (std430, binding = 9) buffer LightClusters
+{
+    uint light_length;
+    uvec4 lightClusters[];
+} lightClusters;
+
+layout (std430, binding = 10) buffer LightIndices
+{
+    uint light_length;
+    uint padding[3];
+    uint lightIndices[];
+} lightIndices;
+
+uint getClusterIndex()
+{
+    float depth = -(cameraMatrices.view * vec4(position, 1.0)).z;
+    uint slice = 0;
+    if (depth >= lightClusterParameters.clusterNear)
+    {
+        slice = min(uint(max(log(depth) * lightClusterParameters.sliceScale + lightClusterParameters.sliceBias, 0.0)) + 1, lightClusterParameters.gridSize.z - 1);
+    }
+
+    uvec2 tile = min(uvec2(gl_FragCoord.xy / lightClusterParameters.screenSize * vec2(lightClusterParameters.gridSize.xy)), lightClusterParameters.gridSize.xy - 1);
+    return tile.x + lightClusterParameters.gridSize.x * (tile.y + lightClusterParameters.gridSize.y * slice);
+}
@@ -0,0 +1,44 @@
+#version 450 core
+
+#extension GL_ARB_separate_shader_objects : enable
+
+layout (location = 0) in vec3 inPosition;
+layout (location = 1) in vec3 inNormal;
+
+layout (std140, set = 0, binding = 0) uniform CameraMatrices
+{
+    mat4 view;
+    mat4 projection;
+} cameraMatrices;
+
+struct ObjectData
+{
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    vec4 color;
+    uint materialIndex;
+};
+
+layout (std430, set = 1, binding = 0) readonly buffer Objects
+{
+    ObjectData objects[];
+};
+
+layout (push_constant) uniform PushConstants
+{
+    uint objectIndex;
+} pushConstants;
+
+layout (location = 0) out VS_OUT
+{
+    mat4 projection;
+    vec3 normal;
+} vs_out;
+
+void main()
+{
+    ObjectData object = objects[pushConstants.objectIndex];
+    gl_Position = cameraMatrices.view * object.modelMatrix * vec4(inPosition, 1.0);
+    vs_out.normal = normalize(mat3(object.normalMatrix) * inNormal);
+    vs_out.projection = cameraMatrices.projection;
+}
\ No newline at end of file
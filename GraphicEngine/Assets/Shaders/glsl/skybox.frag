@@ -4,7 +4,12 @@
 
 layout (location = 0) in vec3 texCoord;
 
+#ifdef VULKAN
+// Binding 0 is camera of vertex shader
+layout (set = 0, binding = 1) uniform samplerCube skybox;
+#else
 uniform samplerCube skybox;
+#endif
 
 layout (location = 0) out vec4 outColor;
 
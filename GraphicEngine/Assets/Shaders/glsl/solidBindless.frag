@@ -0,0 +1,137 @@
+#version 450 core
+
+#extension GL_ARB_separate_shader_objects : enable
+
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 normal;
+layout (location = 2) in vec3 solidColor;
+
+struct LightColor
+{
+    vec4 diffuse;
+	vec4 ambient;
+	vec4 specular;
+};
+
+struct DirectionalLightBuffer
+{
+    mat4 lightSpace;
+	vec4 direction;
+	LightColor color;
+};
+
+struct PointLightBuffer
+{
+	vec4 position;
+	float constant;
+	float linear;
+	float quadric;
+	LightColor color;
+};
+
+struct SpotLightBuffer
+{
+    mat4 lightSpace;
+	vec4 position;
+	vec4 direction;
+	float innerCutOff;
+	float outterCutOff;
+	float constant;
+	float linear;
+	float quadric;
+	LightColor color;
+};
+
+// Bindings follow descriptor set 0 of Vulkan solid pipeline, binding 0 is camera of vertex shader
+layout (std430, set = 0, binding = 1) readonly buffer DirectionalLight
+{
+    uint light_length;
+    DirectionalLightBuffer directionalLights[];
+} directionalLight;
+
+layout (std430, set = 0, binding = 2) readonly buffer PointLight
+{
+    uint light_length;
+    PointLightBuffer pointLights[];
+} pointLight;
+
+layout (std430, set = 0, binding = 3) readonly buffer SpotLight
+{
+    uint light_length;
+    SpotLightBuffer spotLights[];
+} spotLight;
+
+layout (std140, set = 0, binding = 4) uniform Eye
+{
+    vec4 eyePosition;
+} eye;
+
+layout (location = 0) out vec4 outColor;
+
+// Same lighting as spv/solid.frag.spv used by Vulkan solid pipeline before, solid color is diffuse color of object.
+// Materials, shadows and light clusters of OpenGL solid.frag have no resources in Vulkan renderer
+vec4 Diffuse(vec3 lightDir, LightColor color)
+{
+    float I = max(dot(normal, lightDir), 0.0);
+    return vec4(I * solidColor * color.diffuse.rgb + solidColor * color.ambient.rgb, 1.0);
+}
+
+vec4 CalcDirectionalLight(DirectionalLightBuffer light)
+{
+    return Diffuse(normalize(-light.direction.xyz), light.color);
+}
+
+vec4 CalcPointLight(PointLightBuffer light)
+{
+    vec3 lightDir = normalize(light.position.xyz - position);
+
+    float dist = length(position - light.position.xyz);
+    float attenaution = 1.0 / (light.constant + light.linear * dist + light.quadric * (dist * dist));
+
+    return Diffuse(lightDir, light.color) * attenaution;
+}
+
+vec4 CalcSpotLight(SpotLightBuffer light)
+{
+    vec3 lightDir = normalize(light.position.xyz - position);
+
+    float theta = dot(lightDir, -light.direction.xyz);
+    float epsilon = light.innerCutOff - light.outterCutOff;
+    float intesity = clamp((theta - light.outterCutOff) / epsilon, 0.0, 1.0);
+
+    float dist = length(position - light.position.xyz);
+    float attenaution = 1.0 / (light.constant + light.linear * dist + light.quadric * (dist * dist));
+
+    return Diffuse(lightDir, light.color) * intesity * attenaution;
+}
+
+void main()
+{
+    if (directionalLight.light_length == 0 &&
+        pointLight.light_length == 0 &&
+        spotLight.light_length == 0)
+    {
+        vec3 lightDir = normalize(eye.eyePosition.xyz - position);
+        float I = max(dot(normal, lightDir), 0.0);
+        outColor = vec4(clamp(I + 0.2, 0.0, 1.0) * solidColor, 1.0);
+        return;
+    }
+
+    vec4 lightStrength = vec4(0.0);
+    for (uint i = 0; i < directionalLight.light_length; i++)
+    {
+        lightStrength += CalcDirectionalLight(directionalLight.directionalLights[i]);
+    }
+
+    for (uint i = 0; i < pointLight.light_length; i++)
+    {
+        lightStrength += CalcPointLight(pointLight.pointLights[i]);
+    }
+
+    for (uint i = 0; i < spotLight.light_length; i++)
+    {
+        lightStrength += CalcSpotLight(spotLight.spotLights[i]);
+    }
+
+    outColor = vec4(clamp(lightStrength.rgb, 0.0, 1.0), 1.0);
+}
@@ -0,0 +1,39 @@
+#version 450 core
+
+#extension GL_ARB_separate_shader_objects : enable
+
+layout (location = 0) in vec3 inPosition;
+layout (location = 1) in vec3 inNormal;
+
+layout (std140, set = 0, binding = 0) uniform CameraMatrices
+{
+    mat4 view;
+    mat4 projection;
+} cameraMatrices;
+
+struct ObjectData
+{
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    vec4 color;
+    uint materialIndex;
+};
+
+layout (std430, set = 1, binding = 0) readonly buffer Objects
+{
+    ObjectData objects[];
+};
+
+layout (location = 0) out vec3 position;
+layout (location = 1) out vec3 normal;
+layout (location = 2) out vec3 solidColor;
+
+void main()
+{
+    // Culling pass writes index of object as first instance of its draws
+    ObjectData object = objects[gl_InstanceIndex];
+    normal = normalize(mat3(object.normalMatrix) * inNormal);
+    position = vec3(object.modelMatrix * vec4(inPosition, 1.0));
+    solidColor = vec3(object.color);
+    gl_Position = cameraMatrices.projection * cameraMatrices.view * vec4(position, 1.0);
+}
\ No newline at end of file
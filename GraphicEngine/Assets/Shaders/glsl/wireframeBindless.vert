@@ -0,0 +1,38 @@
+#version 450 core
+
+#extension GL_ARB_separate_shader_objects : enable
+
+layout (location = 0) in vec3 inPosition;
+
+layout (std140, set = 0, binding = 0) uniform CameraMatrices
+{
+    mat4 view;
+    mat4 projection;
+} cameraMatrices;
+
+struct ObjectData
+{
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    vec4 color;
+    uint materialIndex;
+};
+
+layout (std430, set = 1, binding = 0) readonly buffer Objects
+{
+    ObjectData objects[];
+};
+
+layout (push_constant) uniform PushConstants
+{
+    uint objectIndex;
+} pushConstants;
+
+layout (location = 0) out vec3 wireframeColor;
+
+void main()
+{
+    ObjectData object = objects[pushConstants.objectIndex];
+    wireframeColor = vec3(object.color);
+    gl_Position = cameraMatrices.projection * cameraMatrices.view * object.modelMatrix * vec4(inPosition, 1.0);
+}
\ No newline at end of file
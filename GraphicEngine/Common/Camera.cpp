@@ -154,6 +154,16 @@ void GraphicEngine::Common::Camera::zoom(double offset)
 	setFOV(getFOV() + offset);
 }
 
+void GraphicEngine::Common::Camera::setView(const glm::vec3& position, const glm::vec3& direction)
+{
+	m_position = position;
+	m_direction = glm::normalize(direction);
+	m_new_direction = m_direction;
+	m_yawPitch = glm::vec2(0.0f, 0.0f);
+	m_yawPitchOffset = glm::vec2(0.0f, 0.0f);
+	m_shouldUpdateView = true;
+}
+
 glm::mat4 GraphicEngine::Common::Camera::caclulatePerspective()
 {
 	return glm::perspective(glm::radians(m_cameraParameters.fov), m_cameraParameters.aspectRatio,
@@ -43,6 +43,8 @@ namespace GraphicEngine::Common
 		void rotate(const glm::vec2& offset);
 		void move(const glm::vec2& offset);
 		void zoom(double offset);
+		// Places camera without going through mouse rotation, used by scripted camera paths
+		void setView(const glm::vec3& position, const glm::vec3& direction);
 
 		glm::mat4 getViewProjectionMatrix();
 		glm::mat4 getViewMatrix();
@@ -0,0 +1,47 @@
+#include "CameraPath.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#undef min
+#undef max
+
+GraphicEngine::Common::CameraPath::CameraPath(const std::string& name, uint32_t frames, std::vector<CameraPathKey> keys) :
+	m_name{ name },
+	m_frames{ frames },
+	m_keys{ std::move(keys) }
+{
+	if (m_keys.empty())
+	{
+		throw std::invalid_argument("Camera path " + m_name + " has no keys!");
+	}
+	if (m_frames == 0)
+	{
+		throw std::invalid_argument("Camera path " + m_name + " has no frames!");
+	}
+}
+
+GraphicEngine::Common::CameraPathKey GraphicEngine::Common::CameraPath::sample(uint32_t frame) const
+{
+	if (m_keys.size() == 1 || m_frames == 1)
+		return m_keys.front();
+
+	float t = static_cast<float>(std::min(frame, m_frames - 1)) / (m_frames - 1) * (m_keys.size() - 1);
+	size_t key = std::min(static_cast<size_t>(std::floor(t)), m_keys.size() - 2);
+	float factor = t - key;
+
+	return CameraPathKey{
+		glm::mix(m_keys[key].position, m_keys[key + 1].position, factor),
+		glm::mix(m_keys[key].target, m_keys[key + 1].target, factor) };
+}
+
+const std::string& GraphicEngine::Common::CameraPath::getName() const
+{
+	return m_name;
+}
+
+uint32_t GraphicEngine::Common::CameraPath::getFramesCount() const
+{
+	return m_frames;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+namespace GraphicEngine::Common
+{
+	struct CameraPathKey
+	{
+		glm::vec3 position;
+		glm::vec3 target;
+	};
+
+	// Fixed camera flight through keys spread evenly over the path, replayed identically on every run
+	class CameraPath
+	{
+	public:
+		CameraPath(const std::string& name, uint32_t frames, std::vector<CameraPathKey> keys);
+
+		// Camera key for frame of path, position and target are interpolated linearly between neighbouring keys
+		CameraPathKey sample(uint32_t frame) const;
+
+		const std::string& getName() const;
+		uint32_t getFramesCount() const;
+
+	private:
+		std::string m_name;
+		uint32_t m_frames;
+		std::vector<CameraPathKey> m_keys;
+	};
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+namespace GraphicEngine::Common
+{
+	// Same layout as DrawElementsIndirectCommand of OpenGL and VkDrawIndexedIndirectCommand, so list can be uploaded as indirect buffer
+	struct DrawElementsCommand
+	{
+		uint32_t indexCount{ 0 };
+		uint32_t instanceCount{ 1 };
+		uint32_t firstIndex{ 0 };
+		int32_t vertexOffset{ 0 };
+		uint32_t firstInstance{ 0 };
+	};
+}
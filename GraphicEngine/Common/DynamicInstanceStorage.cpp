@@ -0,0 +1,109 @@
+#include "DynamicInstanceStorage.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+GraphicEngine::Common::DynamicInstanceStorage::DynamicInstanceStorage(uint32_t aligmentSize, uint32_t images, uint32_t instances) :
+	m_aligmentSize{ aligmentSize },
+	m_instances{ std::numeric_limits<uint32_t>::max() },
+	m_dirtyRanges(images, emptyRange())
+{
+	reserve(std::max(instances, 1u));
+}
+
+bool GraphicEngine::Common::DynamicInstanceStorage::reserve(uint32_t instances)
+{
+	if (instances <= m_capacity)
+	{
+		return false;
+	}
+
+	m_capacity = std::max(instances, m_capacity * 2);
+	m_values.resize(static_cast<size_t>(m_capacity) * m_aligmentSize);
+
+	// Whole storage is uploaded to new buffers, so nothing is left dirty
+	for (auto& dirtyRange : m_dirtyRanges)
+	{
+		dirtyRange = emptyRange();
+	}
+	return true;
+}
+
+uint32_t GraphicEngine::Common::DynamicInstanceStorage::addInstance()
+{
+	auto instance = m_instances.allocate();
+	if (!instance)
+	{
+		throw std::out_of_range("No free instance of dynamic uniform buffer!");
+	}
+	reserve(*instance + 1);
+	return *instance;
+}
+
+void GraphicEngine::Common::DynamicInstanceStorage::deleteInstance(uint32_t instance)
+{
+	m_instances.free(instance);
+}
+
+void GraphicEngine::Common::DynamicInstanceStorage::setValue(uint32_t instance, const void* value, uint32_t size)
+{
+	if (instance >= m_capacity || size > m_aligmentSize)
+	{
+		throw std::out_of_range("Instance is out of dynamic uniform buffer!");
+	}
+
+	char* destination = m_values.data() + static_cast<size_t>(instance) * m_aligmentSize;
+	if (memcmp(destination, value, size) == 0)
+	{
+		return;
+	}
+
+	memcpy(destination, value, size);
+	for (auto& dirtyRange : m_dirtyRanges)
+	{
+		dirtyRange.first = std::min(dirtyRange.first, instance);
+		dirtyRange.second = std::max(dirtyRange.second, instance + 1);
+	}
+}
+
+std::optional<std::pair<uint32_t, uint32_t>> GraphicEngine::Common::DynamicInstanceStorage::takeDirtyRange(uint32_t image)
+{
+	auto dirtyRange = std::exchange(m_dirtyRanges[image], emptyRange());
+	if (dirtyRange.first >= dirtyRange.second)
+	{
+		return std::nullopt;
+	}
+	return std::make_pair(dirtyRange.first * m_aligmentSize, (dirtyRange.second - dirtyRange.first) * m_aligmentSize);
+}
+
+const char* GraphicEngine::Common::DynamicInstanceStorage::getData() const
+{
+	return m_values.data();
+}
+
+uint32_t GraphicEngine::Common::DynamicInstanceStorage::getSize() const
+{
+	return static_cast<uint32_t>(m_values.size());
+}
+
+uint32_t GraphicEngine::Common::DynamicInstanceStorage::getInstancesCount() const
+{
+	return m_instances.getAllocatedCount();
+}
+
+uint32_t GraphicEngine::Common::DynamicInstanceStorage::getCapacity() const
+{
+	return m_capacity;
+}
+
+uint32_t GraphicEngine::Common::DynamicInstanceStorage::getAligmentSize() const
+{
+	return m_aligmentSize;
+}
+
+std::pair<uint32_t, uint32_t> GraphicEngine::Common::DynamicInstanceStorage::emptyRange()
+{
+	return { std::numeric_limits<uint32_t>::max(), 0 };
+}
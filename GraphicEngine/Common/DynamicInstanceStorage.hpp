@@ -0,0 +1,48 @@
+#pragma once
+
+#include "SlotAllocator.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace GraphicEngine::Common
+{
+	// Host copy of instances of dynamic uniform buffer. Instances live in aligned slots, capacity grows geometrically and freed slots are reused.
+	// Range of instances changed since last upload is tracked separately for each swap chain image
+	class DynamicInstanceStorage
+	{
+	public:
+		DynamicInstanceStorage(uint32_t aligmentSize, uint32_t images, uint32_t instances);
+
+		// Returns true when capacity grew, then buffers of all images have to get whole storage again
+		bool reserve(uint32_t instances);
+		// Takes lowest free slot, capacity grows only when all slots are used
+		uint32_t addInstance();
+		// Slot is reused by next added instance
+		void deleteInstance(uint32_t instance);
+
+		// Value equal to stored one is not marked for upload
+		void setValue(uint32_t instance, const void* value, uint32_t size);
+		// Byte offset and size of instances changed since last call for image, empty when nothing changed
+		std::optional<std::pair<uint32_t, uint32_t>> takeDirtyRange(uint32_t image);
+
+		const char* getData() const;
+		uint32_t getSize() const;
+		uint32_t getInstancesCount() const;
+		uint32_t getCapacity() const;
+		uint32_t getAligmentSize() const;
+
+	private:
+		static std::pair<uint32_t, uint32_t> emptyRange();
+
+	private:
+		std::vector<char> m_values;
+		uint32_t m_aligmentSize;
+		uint32_t m_capacity{ 0 };
+		SlotAllocator m_instances;
+		// Range [first, last) of instances changed since last upload to each image
+		std::vector<std::pair<uint32_t, uint32_t>> m_dirtyRanges;
+	};
+}
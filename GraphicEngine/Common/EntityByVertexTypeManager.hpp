@@ -1,114 +1,169 @@
 #pragma once
 
-#include <any>
-#include <list>
+#include <algorithm>
+#include <array>
 #include <memory>
-#include <typeindex>
-#include <unordered_map>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
 #include <execution>
-#include <mutex>
 
+#include "RenderQueue.hpp"
 #include "Vertex.hpp"
-#include "../Core/Utils/UniqueIdentifier.hpp"
+#include "../Core/Utils/TupleUtils.hpp"
 
 namespace GraphicEngine::Common
 {
+	// Entities are kept in contiguous list for each vertex type, type of list is resolved at compile time
 	template <template <typename> typename Entity>
 	class EntityByVertexTypeManager
 	{
+		template <typename VertexType>
+		using EntityList = std::vector<std::shared_ptr<Entity<VertexType>>>;
+		using EntityLists = typename Core::Utils::ContainersOfTypes<EntityList, VertexTypesRegister>::type;
 	public:
-		EntityByVertexTypeManager()
-		{
-			initialize();
-		}
-
 		template <typename VertexType>
 		void addEntity(std::shared_ptr<Entity<VertexType>> entity)
 		{
-			auto index = std::type_index(typeid(VertexType));
-			if (m_entitiesLists.find(index) == std::end(m_entitiesLists))
-			{
-				throw std::bad_typeid();
-			}
-			m_entitiesLists[index].push_back(entity);
+			getEntities<VertexType>().push_back(entity);
 		}
 
 		template <typename VertexType>
 		std::shared_ptr<Entity<VertexType>> getFirstEntity()
 		{
-			auto index = std::type_index(typeid(VertexType));
-			if (m_entitiesLists.find(index) == std::end(m_entitiesLists))
+			auto& entities = getEntities<VertexType>();
+			if (entities.empty())
 			{
-				throw std::bad_typeid();
+				throw std::out_of_range("There is no entity of given vertex type");
 			}
-			return std::any_cast<std::shared_ptr<Entity<VertexType>>>(m_entitiesLists[index].front());
+			return entities.front();
 		}
 
 		template <typename VertexType>
 		void removeEntity(std::shared_ptr<Entity<VertexType>> entity)
 		{
-			auto index = std::type_index(typeid(VertexType));
-			if (m_entitiesLists.find(index) == std::end(m_entitiesLists))
-			{
-				throw std::bad_typeid();
-			}
-			m_entitiesLists[index].remove(entity);
+			auto& entities = getEntities<VertexType>();
+			entities.erase(std::remove(std::begin(entities), std::end(entities), entity), std::end(entities));
 		}
 
 		template <typename VertexType>
-		void eraseEntity(std::list<std::any>::const_iterator entity)
+		void eraseEntity(typename EntityList<VertexType>::const_iterator entity)
 		{
-			auto index = std::type_index(typeid(VertexType));
-			if (m_entitiesLists.find(index) == std::end(m_entitiesLists))
-			{
-				throw std::bad_typeid();
-			}
-			m_entitiesLists[index].erase(entity);
+			getEntities<VertexType>().erase(entity);
 		}
 
 		template <typename VertexType, typename Comparator>
-		std::list<std::any>::const_iterator findIf(Comparator comparator)
+		typename EntityList<VertexType>::const_iterator findIf(Comparator comparator)
 		{
-			auto index = std::type_index(typeid(VertexType));
-			if (m_entitiesLists.find(index) == std::end(m_entitiesLists))
-			{
-				throw std::bad_typeid();
-			}
-			return std::find_if(std::begin(m_entitiesLists[index]), std::end(m_entitiesLists[index]), [&](std::any ent)
+			const auto& entities = getEntities<VertexType>();
+			return std::find_if(std::begin(entities), std::end(entities), comparator);
+		}
+
+		void clear()
+		{
+			Core::Utils::for_each(m_entities, [](auto& entities)
 				{
-					return comparator(std::any_cast<std::shared_ptr<Entity<VertexType>>>(ent));
+					entities.clear();
 				});
 		}
 
+		// Function has to be thread safe when parallel policy is used
 		template <typename Func, typename ExecutionPolicy = decltype(std::execution::seq)>
 		void forEachEntity(Func func, ExecutionPolicy policy = std::execution::seq)
 		{
-			Core::Utils::for_each(VertexTypesRegister::types, [&](auto vertexType)
+			Core::Utils::for_each(m_entities, [&](auto& entities)
+				{
+					std::for_each(policy, std::begin(entities), std::end(entities), func);
+				});
+		}
+
+		// Number of entities of all vertex types, handles of entities are in [0, count)
+		uint32_t getEntitiesCount()
+		{
+			uint32_t count{ 0 };
+			Core::Utils::for_each(m_entities, [&](auto& entities)
 				{
-					auto index = std::type_index(typeid(decltype(vertexType)));
-					/*for (auto entity : m_entitiesLists[index])
+					count += static_cast<uint32_t>(entities.size());
+				});
+			return count;
+		}
+
+		// Visits entities with handle in [first, last), handle is index of entity in order of forEachEntity.
+		// Does not modify manager, so disjoint ranges can be visited from several threads
+		template <typename Func>
+		void forEachEntityInRange(uint32_t first, uint32_t last, Func func)
+		{
+			uint32_t firstHandle{ 0 };
+			Core::Utils::for_each(m_entities, [&](auto& entities)
+				{
+					uint32_t begin = std::max(first, firstHandle);
+					uint32_t end = std::min(last, firstHandle + static_cast<uint32_t>(entities.size()));
+					for (uint32_t handle{ begin }; handle < end; ++handle)
 					{
-						std::shared_ptr<Entity<decltype(vertexType)>> castEntity = std::any_cast<std::shared_ptr<Entity<decltype(vertexType)>>>(entity);
-						func(castEntity);
-					}*/
-					std::mutex m;
-					std::for_each(policy, std::begin(m_entitiesLists[index]), std::end(m_entitiesLists[index]), [&](auto entity) {
-						std::lock_guard<std::mutex> guard(m);
-						std::shared_ptr<Entity<decltype(vertexType)>> castEntity = std::any_cast<std::shared_ptr<Entity<decltype(vertexType)>>>(entity);
-						func(castEntity);
-						});
+						func(entities[handle - firstHandle], handle);
+					}
+					firstHandle += static_cast<uint32_t>(entities.size());
 				});
 		}
-	protected:
-		void initialize()
+
+		// Builds and sorts draw records of each vertex type, record of entity is made by makeRecord(entity, handle)
+		template <typename MakeRecord>
+		void sortEntities(MakeRecord makeRecord)
+		{
+			uint32_t firstHandle{ 0 };
+			size_t typeIndex{ 0 };
+			Core::Utils::for_each(m_entities, [&](auto& entities)
+				{
+					auto& renderQueue = m_renderQueues[typeIndex];
+					renderQueue.clear();
+					for (uint32_t i{ 0 }; i < entities.size(); ++i)
+					{
+						renderQueue.push(makeRecord(entities[i], firstHandle + i));
+					}
+					renderQueue.sort();
+					firstHandle += static_cast<uint32_t>(entities.size());
+					++typeIndex;
+				});
+		}
+
+		// Visits entities at positions [first, last) of order made by last sortEntities, vertex types keep order of forEachEntity.
+		// Does not modify manager, so disjoint ranges can be visited from several threads
+		template <typename Func>
+		void forEachSortedEntity(uint32_t first, uint32_t last, Func func)
 		{
-			Core::Utils::for_each(VertexTypesRegister::types, [&](auto vertexType)
+			uint32_t firstHandle{ 0 };
+			size_t typeIndex{ 0 };
+			Core::Utils::for_each(m_entities, [&](auto& entities)
 				{
-					auto index = std::type_index(typeid(decltype(vertexType)));
-					m_entitiesLists[index] = std::list<std::any>();
+					const auto& records = m_renderQueues[typeIndex].getRecords();
+					uint32_t begin = std::max(first, firstHandle);
+					uint32_t end = std::min(last, firstHandle + static_cast<uint32_t>(records.size()));
+					for (uint32_t position{ begin }; position < end; ++position)
+					{
+						const auto& record = records[position - firstHandle];
+						func(entities[record.entity - firstHandle], record);
+					}
+					firstHandle += static_cast<uint32_t>(entities.size());
+					++typeIndex;
 				});
 		}
+
+		// Entities of each vertex type are visited in order of sorted draw records.
+		// Record of entity is made by makeRecord(entity, handle), handle is index of entity in order of forEachEntity
+		template <typename MakeRecord, typename Func>
+		void forEachEntitySorted(MakeRecord makeRecord, Func func)
+		{
+			sortEntities(makeRecord);
+			forEachSortedEntity(0, getEntitiesCount(), func);
+		}
+	protected:
+		template <typename VertexType>
+		EntityList<VertexType>& getEntities()
+		{
+			return std::get<EntityList<VertexType>>(m_entities);
+		}
 	protected:
-		std::unordered_map<std::type_index, std::list<std::any>> m_entitiesLists;
+		EntityLists m_entities;
+		std::array<RenderQueue, std::tuple_size_v<EntityLists>> m_renderQueues;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Vertex.hpp"
+#include "../Core/Math/VertexQuantization.hpp"
+
+#include <glm/common.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace GraphicEngine::Common
+{
+	// Unorm 16 bit xyz relative to bouding box of mesh
+	struct PackedPositionAttribute
+	{
+		using descriptor = AttributeDescriptor<glm::u16vec4, VertexType::Position, VertexAttributeFormat::UnsignedShort, true>;
+		glm::u16vec4 position{ 0 };
+	};
+
+	// Half float uv
+	struct PackedTexCoordAttribute
+	{
+		using descriptor = AttributeDescriptor<glm::u16vec2, VertexType::TexCoord, VertexAttributeFormat::HalfFloat>;
+		glm::u16vec2 texCoord{ 0 };
+	};
+
+	// Snorm 16 bit xyz
+	struct PackedNormalAttribute
+	{
+		using descriptor = AttributeDescriptor<glm::i16vec4, VertexType::Normal, VertexAttributeFormat::Short, true>;
+		glm::i16vec4 normal{ 0 };
+	};
+
+	struct PackedTangentAttribute
+	{
+		using descriptor = AttributeDescriptor<glm::i16vec4, VertexType::Tangent, VertexAttributeFormat::Short, true>;
+		glm::i16vec4 tangent{ 0 };
+	};
+
+	struct PackedBitangentAttribute
+	{
+		using descriptor = AttributeDescriptor<glm::i16vec4, VertexType::BiTangent, VertexAttributeFormat::Short, true>;
+		glm::i16vec4 bitangent{ 0 };
+	};
+
+	// Position, Normal packed from 24 to 16 bytes
+	using VertexPNPacked = VertexLayout<PackedPositionAttribute, PackedNormalAttribute>;
+	// Position, Texture Coordinates, Normal packed from 32 to 20 bytes
+	using VertexPTcNPacked = VertexLayout<PackedPositionAttribute, PackedTexCoordAttribute, PackedNormalAttribute>;
+	// Position, Texture Coordinates, Normal, Tangent, Bitangent packed from 56 to 36 bytes
+	using VertexPTcNTBPacked = VertexLayout<PackedPositionAttribute, PackedTexCoordAttribute, PackedNormalAttribute, PackedTangentAttribute, PackedBitangentAttribute>;
+
+	// Layout of vertex in vertex buffer, vertex types without packed variant are uploaded as they are
+	template <typename Vertex>
+	struct PackedVertex
+	{
+		using type = Vertex;
+		static constexpr bool isPacked = false;
+
+		static type pack(const Vertex& vertex, const Core::Math::PositionQuantization& quantization)
+		{
+			return vertex;
+		}
+	};
+
+	template <>
+	struct PackedVertex<VertexPN>
+	{
+		using type = VertexPNPacked;
+		static constexpr bool isPacked = true;
+
+		static type pack(const VertexPN& vertex, const Core::Math::PositionQuantization& quantization)
+		{
+			type packed;
+			packed.position = Core::Math::quantizePosition(vertex.position, quantization);
+			packed.normal = Core::Math::quantizeNormal(vertex.normal);
+			return packed;
+		}
+	};
+
+	template <>
+	struct PackedVertex<VertexPTcN>
+	{
+		using type = VertexPTcNPacked;
+		static constexpr bool isPacked = true;
+
+		static type pack(const VertexPTcN& vertex, const Core::Math::PositionQuantization& quantization)
+		{
+			type packed;
+			packed.position = Core::Math::quantizePosition(vertex.position, quantization);
+			packed.texCoord = Core::Math::quantizeTexCoord(vertex.texCoord);
+			packed.normal = Core::Math::quantizeNormal(vertex.normal);
+			return packed;
+		}
+	};
+
+	template <>
+	struct PackedVertex<VertexPTcNTB>
+	{
+		using type = VertexPTcNTBPacked;
+		static constexpr bool isPacked = true;
+
+		static type pack(const VertexPTcNTB& vertex, const Core::Math::PositionQuantization& quantization)
+		{
+			type packed;
+			packed.position = Core::Math::quantizePosition(vertex.position, quantization);
+			packed.texCoord = Core::Math::quantizeTexCoord(vertex.texCoord);
+			packed.normal = Core::Math::quantizeNormal(vertex.normal);
+			packed.tangent = Core::Math::quantizeNormal(vertex.tangent);
+			packed.bitangent = Core::Math::quantizeNormal(vertex.bitangent);
+			return packed;
+		}
+	};
+
+	// Positions are quantized relative to bouding box of all vertices, quantization stays default for not packed vertex types
+	template <typename Vertex>
+	std::vector<typename PackedVertex<Vertex>::type> packVertices(const std::vector<Vertex>& vertices, Core::Math::PositionQuantization& quantization)
+	{
+		quantization = Core::Math::PositionQuantization{};
+		if constexpr (PackedVertex<Vertex>::isPacked)
+		{
+			if (!vertices.empty())
+			{
+				glm::vec3 left{ std::numeric_limits<float>::max() };
+				glm::vec3 right{ std::numeric_limits<float>::lowest() };
+				for (const auto& vertex : vertices)
+				{
+					left = glm::min(left, vertex.position);
+					right = glm::max(right, vertex.position);
+				}
+				quantization = Core::Math::calculatePositionQuantization(left, right);
+			}
+		}
+
+		std::vector<typename PackedVertex<Vertex>::type> packedVertices;
+		packedVertices.reserve(vertices.size());
+		for (const auto& vertex : vertices)
+		{
+			packedVertices.push_back(PackedVertex<Vertex>::pack(vertex, quantization));
+		}
+		return packedVertices;
+	}
+}
@@ -0,0 +1,118 @@
+#include "RangeAllocator.hpp"
+
+#include <iterator>
+#include <stdexcept>
+
+namespace
+{
+	uint64_t alignUp(uint64_t value, uint32_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+}
+
+GraphicEngine::Common::RangeAllocator::RangeAllocator(uint32_t capacity) :
+	m_capacity{ capacity }
+{
+}
+
+std::optional<uint32_t> GraphicEngine::Common::RangeAllocator::allocate(uint32_t count, uint32_t alignment)
+{
+	if (count == 0 || alignment == 0)
+	{
+		throw std::invalid_argument("Range has to have at least one element and alignment!");
+	}
+
+	// Parts of free range before and after allocated range stay free
+	for (auto freeRange = std::begin(m_freeRanges); freeRange != std::end(m_freeRanges); ++freeRange)
+	{
+		uint64_t first = alignUp(freeRange->first, alignment);
+		uint64_t freeEnd = static_cast<uint64_t>(freeRange->first) + freeRange->second;
+		if (first + count > freeEnd)
+			continue;
+
+		uint32_t freeFirst = freeRange->first;
+		m_freeRanges.erase(freeRange);
+		if (first > freeFirst)
+		{
+			m_freeRanges.emplace(freeFirst, static_cast<uint32_t>(first - freeFirst));
+		}
+		if (first + count < freeEnd)
+		{
+			m_freeRanges.emplace(static_cast<uint32_t>(first + count), static_cast<uint32_t>(freeEnd - first - count));
+		}
+		m_ranges.emplace(static_cast<uint32_t>(first), count);
+		return static_cast<uint32_t>(first);
+	}
+
+	uint64_t first = alignUp(m_end, alignment);
+	if (first + count > m_capacity)
+	{
+		return std::nullopt;
+	}
+	if (first > m_end)
+	{
+		m_freeRanges.emplace(m_end, static_cast<uint32_t>(first - m_end));
+	}
+	m_end = static_cast<uint32_t>(first + count);
+	m_ranges.emplace(static_cast<uint32_t>(first), count);
+	return static_cast<uint32_t>(first);
+}
+
+void GraphicEngine::Common::RangeAllocator::free(uint32_t first)
+{
+	auto range = m_ranges.find(first);
+	if (range == std::end(m_ranges))
+	{
+		throw std::out_of_range("Range is not allocated!");
+	}
+	uint32_t count = range->second;
+	m_ranges.erase(range);
+	addFreeRange(first, count);
+}
+
+uint32_t GraphicEngine::Common::RangeAllocator::getCount(uint32_t first) const
+{
+	auto range = m_ranges.find(first);
+	if (range == std::end(m_ranges))
+	{
+		throw std::out_of_range("Range is not allocated!");
+	}
+	return range->second;
+}
+
+uint32_t GraphicEngine::Common::RangeAllocator::getEnd() const
+{
+	return m_end;
+}
+
+uint32_t GraphicEngine::Common::RangeAllocator::getCapacity() const
+{
+	return m_capacity;
+}
+
+void GraphicEngine::Common::RangeAllocator::addFreeRange(uint32_t first, uint32_t count)
+{
+	auto next = m_freeRanges.find(first + count);
+	if (next != std::end(m_freeRanges))
+	{
+		count += next->second;
+		m_freeRanges.erase(next);
+	}
+	auto freeRange = m_freeRanges.emplace(first, count).first;
+	if (freeRange != std::begin(m_freeRanges))
+	{
+		auto previous = std::prev(freeRange);
+		if (previous->first + previous->second == first)
+		{
+			previous->second += count;
+			m_freeRanges.erase(freeRange);
+			freeRange = previous;
+		}
+	}
+	if (freeRange->first + freeRange->second == m_end)
+	{
+		m_end = freeRange->first;
+		m_freeRanges.erase(freeRange);
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace GraphicEngine::Common
+{
+	// Hands out contiguous ranges of fixed size array. First free range which fits is reused, neighbouring free ranges are merged
+	// and free range at end moves end back, so used part of array stays compact
+	class RangeAllocator
+	{
+	public:
+		RangeAllocator(uint32_t capacity);
+
+		// First element of range is multiple of alignment, empty when no range fits
+		std::optional<uint32_t> allocate(uint32_t count, uint32_t alignment = 1);
+		// Range is identified by its first element
+		void free(uint32_t first);
+		uint32_t getCount(uint32_t first) const;
+
+		// One past last element of allocated ranges, elements behind it are never read
+		uint32_t getEnd() const;
+		uint32_t getCapacity() const;
+
+	private:
+		void addFreeRange(uint32_t first, uint32_t count);
+
+	private:
+		uint32_t m_capacity;
+		uint32_t m_end{ 0 };
+		// Ranges are kept by their first element
+		std::map<uint32_t, uint32_t> m_ranges;
+		std::map<uint32_t, uint32_t> m_freeRanges;
+	};
+}
@@ -0,0 +1,72 @@
+#include "RenderQueue.hpp"
+
+#include <array>
+#include <cstring>
+
+void GraphicEngine::Common::RenderQueue::clear()
+{
+	m_records.clear();
+}
+
+void GraphicEngine::Common::RenderQueue::push(const DrawRecord& record)
+{
+	m_records.push_back(record);
+}
+
+void GraphicEngine::Common::RenderQueue::sort()
+{
+	constexpr uint32_t radixBits{ 8 };
+	constexpr uint32_t bucketsCount{ 1 << radixBits };
+	constexpr uint32_t passesCount{ 64 / radixBits };
+
+	if (m_records.size() < 2)
+		return;
+
+	// Histograms of all passes are counted in one read of records
+	std::array<std::array<uint32_t, bucketsCount>, passesCount> histograms{};
+	for (const auto& record : m_records)
+	{
+		for (uint32_t pass{ 0 }; pass < passesCount; ++pass)
+		{
+			++histograms[pass][(record.sortKey >> (pass * radixBits)) & (bucketsCount - 1)];
+		}
+	}
+
+	m_sortBuffer.resize(m_records.size());
+	for (uint32_t pass{ 0 }; pass < passesCount; ++pass)
+	{
+		auto& histogram = histograms[pass];
+		uint32_t shift = pass * radixBits;
+		if (histogram[(m_records.front().sortKey >> shift) & (bucketsCount - 1)] == m_records.size())
+			continue;
+
+		uint32_t offset{ 0 };
+		for (auto& count : histogram)
+		{
+			uint32_t bucketSize = count;
+			count = offset;
+			offset += bucketSize;
+		}
+
+		for (const auto& record : m_records)
+		{
+			m_sortBuffer[histogram[(record.sortKey >> shift) & (bucketsCount - 1)]++] = record;
+		}
+		m_records.swap(m_sortBuffer);
+	}
+}
+
+const std::vector<GraphicEngine::Common::DrawRecord>& GraphicEngine::Common::RenderQueue::getRecords() const
+{
+	return m_records;
+}
+
+uint64_t GraphicEngine::Common::RenderQueue::makeSortKey(uint32_t materialId, float depth)
+{
+	uint32_t depthBits{ 0 };
+	if (depth > 0.0f)
+	{
+		std::memcpy(&depthBits, &depth, sizeof(depthBits));
+	}
+	return (static_cast<uint64_t>(materialId) << 32) | depthBits;
+}
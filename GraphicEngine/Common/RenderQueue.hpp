@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace GraphicEngine::Common
+{
+	// Flat draw record, entity is handle into list of entities of single vertex type
+	struct DrawRecord
+	{
+		uint64_t sortKey{ 0 };
+		uint32_t entity{ 0 };
+		uint32_t materialId{ 0 };
+		// Level of detail, selects index range of vertex buffer
+		uint32_t lod{ 0 };
+	};
+
+	// Draw records of one pipeline, sorted by material and then front to back
+	class RenderQueue
+	{
+	public:
+		void clear();
+		void push(const DrawRecord& record);
+
+		// Stable LSD radix sort by key, 8 bits per pass, passes where all keys have same byte are skipped
+		void sort();
+
+		const std::vector<DrawRecord>& getRecords() const;
+
+		// Material in high half, depth in low half. Bits of non negative float grow with value, so they can be sorted as integer
+		static uint64_t makeSortKey(uint32_t materialId, float depth);
+
+	private:
+		std::vector<DrawRecord> m_records;
+		std::vector<DrawRecord> m_sortBuffer;
+	};
+}
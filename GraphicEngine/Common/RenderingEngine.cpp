@@ -3,6 +3,7 @@
 GraphicEngine::RenderingEngine::RenderingEngine(std::shared_ptr<Services::ServicesManager> servicesManager,
 	std::shared_ptr<Core::EventManager> eventManager,
 	std::shared_ptr<Core::Timer> timer,
+	std::shared_ptr<Core::Profiler> profiler,
 	std::shared_ptr<Common::UI> ui,
 	std::shared_ptr<Core::Configuration> cfg) :
 	m_servicesManager{ servicesManager },
@@ -14,6 +15,7 @@ GraphicEngine::RenderingEngine::RenderingEngine(std::shared_ptr<Services::Servic
 	m_windManager{ servicesManager->getService<Services::WindManager>() },
 	m_eventManager{ eventManager },
 	m_timer{ timer },
+	m_profiler{ profiler },
 	m_ui{ ui },
 	m_cfg{ cfg }
 {}
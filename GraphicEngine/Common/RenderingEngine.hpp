@@ -4,6 +4,7 @@
 
 #include "../Core/EventManager.hpp"
 #include "../Core/Logger.hpp"
+#include "../Core/Profiler.hpp"
 #include "Vertex.hpp"
 #include "Camera.hpp"
 #include "UI.hpp"
@@ -19,12 +20,21 @@
 
 namespace GraphicEngine
 {
+	struct FrameCapture
+	{
+		uint32_t width{ 0 };
+		uint32_t height{ 0 };
+		// RGBA8, top row first
+		std::vector<uint8_t> pixels;
+	};
+
 	class RenderingEngine
 	{
 	public:
 		RenderingEngine(std::shared_ptr<Services::ServicesManager> servicesManager,
 			std::shared_ptr<Core::EventManager> eventManager,
 			std::shared_ptr<Core::Timer> timer,
+			std::shared_ptr<Core::Profiler> profiler,
 			std::shared_ptr<Common::UI> ui,
 			std::shared_ptr<Core::Configuration> cfg);
 
@@ -33,6 +43,11 @@ namespace GraphicEngine
 		virtual void resizeFrameBuffer(size_t width, size_t height) = 0;
 		virtual void cleanup() = 0;
 
+		// Has to be called before init, drivers which can not read presented image back prepare for it up front
+		void enableFrameCapture() { m_frameCaptureEnabled = true; }
+		// Reads back last drawn frame
+		virtual FrameCapture captureFrame() = 0;
+
 		virtual ~RenderingEngine() = default;
 	protected:
 		std::shared_ptr<Services::ServicesManager> m_servicesManager;
@@ -41,10 +56,13 @@ namespace GraphicEngine
 		std::shared_ptr<Services::LightManager> m_lightManager;
 		std::shared_ptr<Core::EventManager> m_eventManager;
 		std::shared_ptr<Core::Timer> m_timer;
+		std::shared_ptr<Core::Profiler> m_profiler;
 		std::shared_ptr<Common::UI> m_ui;
 		std::shared_ptr<Core::Configuration> m_cfg;
 		std::shared_ptr<Services::ViewportManager> m_viewportManager;
 		std::shared_ptr<Services::RenderingOptionsManager> m_renderingOptionsManager;
 		std::shared_ptr<Services::WindManager> m_windManager;
+
+		bool m_frameCaptureEnabled{ false };
 	};
 }
@@ -10,7 +10,8 @@ namespace GraphicEngine
 		Fragment,
 		Geometry,
 		TessalationControll,
-		TessalationEvaluation
+		TessalationEvaluation,
+		Compute
 	};
 
 	class Shader
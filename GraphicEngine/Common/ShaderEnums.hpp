@@ -13,6 +13,9 @@ namespace GraphicEngine
         Global_SpotLight = 5,
         Global_WindParameters = 6,
         Global_RenderingOptions = 7,
+        Global_LightClusterParameters = 8,
+        Global_LightClusters = 9,
+        Global_LightIndices = 10,
         // Local uniforms
         Wireframe_WireframeModelDescriptor,
         Solid_SolidColorModelDescriptor,
@@ -22,7 +25,6 @@ namespace GraphicEngine
         ShadowMap_LightSpaceMatrixArray,
         ShadowMap_LightPositionFarPlaneArray,
         Normal_ModelMartices = ShadowMap_LightSpaceModelMatrices + 12,
-        Grass_ModelMartices,
         Grass_Material,
         Grass_GrassParameters
     };
@@ -0,0 +1,65 @@
+#include "SlotAllocator.hpp"
+
+#include <stdexcept>
+
+GraphicEngine::Common::SlotAllocator::SlotAllocator(uint32_t capacity) :
+	m_capacity{ capacity }
+{
+}
+
+std::optional<uint32_t> GraphicEngine::Common::SlotAllocator::allocate()
+{
+	if (!m_freeSlots.empty())
+	{
+		uint32_t slot = *std::begin(m_freeSlots);
+		m_freeSlots.erase(std::begin(m_freeSlots));
+		m_allocated[slot] = true;
+		return slot;
+	}
+
+	if (m_allocated.size() == m_capacity)
+	{
+		return std::nullopt;
+	}
+
+	m_allocated.push_back(true);
+	return static_cast<uint32_t>(m_allocated.size() - 1);
+}
+
+void GraphicEngine::Common::SlotAllocator::free(uint32_t slot)
+{
+	if (!isAllocated(slot))
+	{
+		throw std::invalid_argument("Slot is not allocated!");
+	}
+
+	m_allocated[slot] = false;
+	m_freeSlots.insert(slot);
+
+	// Free slots at end are dropped, so end moves back to highest allocated slot
+	while (!m_allocated.empty() && !m_allocated.back())
+	{
+		m_freeSlots.erase(static_cast<uint32_t>(m_allocated.size() - 1));
+		m_allocated.pop_back();
+	}
+}
+
+bool GraphicEngine::Common::SlotAllocator::isAllocated(uint32_t slot) const
+{
+	return slot < m_allocated.size() && m_allocated[slot];
+}
+
+uint32_t GraphicEngine::Common::SlotAllocator::getAllocatedCount() const
+{
+	return static_cast<uint32_t>(m_allocated.size() - m_freeSlots.size());
+}
+
+uint32_t GraphicEngine::Common::SlotAllocator::getEnd() const
+{
+	return static_cast<uint32_t>(m_allocated.size());
+}
+
+uint32_t GraphicEngine::Common::SlotAllocator::getCapacity() const
+{
+	return m_capacity;
+}
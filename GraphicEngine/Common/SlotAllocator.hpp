@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace GraphicEngine::Common
+{
+	// Hands out indices of fixed size array, freed indices are reused from lowest one, so used part of array stays compact
+	class SlotAllocator
+	{
+	public:
+		SlotAllocator(uint32_t capacity);
+
+		// Empty when all slots are taken
+		std::optional<uint32_t> allocate();
+		void free(uint32_t slot);
+		bool isAllocated(uint32_t slot) const;
+
+		uint32_t getAllocatedCount() const;
+		// One past highest allocated slot, slots behind it are never read
+		uint32_t getEnd() const;
+		uint32_t getCapacity() const;
+
+	private:
+		uint32_t m_capacity;
+		std::vector<bool> m_allocated;
+		// Free slots below end
+		std::set<uint32_t> m_freeSlots;
+	};
+}
@@ -4,7 +4,9 @@
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 
-#include <vector>
+#include <array>
+#include <cstdint>
+#include <utility>
 
 #include "../Core/Utils/TupleUtils.hpp"
 
@@ -22,490 +24,162 @@ namespace GraphicEngine::Common
 		Weight = 0x0000080,
 	};
 
-	// Position
-	struct VertexP
+	enum class VertexAttributeFormat
 	{
-		VertexP() {}
-		VertexP(glm::vec3 pos)
-		{
-			position = pos;
-		}
-
-		glm::vec3 position = glm::vec3(0.0f);
-
-		static std::vector<std::pair<uint32_t, uint32_t>> getSizeAndOffsets()
-		{
-			std::vector<std::pair<uint32_t, uint32_t>> offsets;
-			offsets.push_back(std::pair(sizeof(position) / sizeof(position[0]), offsetof(VertexP, position)));
-			return offsets;
-		}
-
-		static uint32_t getStride()
-		{
-			return sizeof(VertexP);
-		}
-
-		static int getType()
-		{
-			return VertexType::Position;
-		}
-	};
-
-	// Position, Weight
-	struct VertexPW : VertexP
-	{
-		VertexPW() = default;
-		VertexPW(glm::vec3 position, glm::vec4 weight) :
-			VertexP{position}, weight{weight} {}
-
-		glm::vec4 weight = glm::vec4(0.0f);
-
-		static std::vector<std::pair<uint32_t, uint32_t>> getSizeAndOffsets()
-		{
-			std::vector<std::pair<uint32_t, uint32_t>> offsets;
-			offsets.reserve(2);
-			offsets.push_back(std::pair(sizeof(position) / sizeof(position[0]), offsetof(VertexPW, position)));
-			offsets.push_back(std::pair(sizeof(weight) / sizeof(weight[0]), offsetof(VertexPW, weight)));
-			return offsets;
-		}
-
-		static uint32_t getStride()
-		{
-			return sizeof(VertexPW);
-		}
-
-		static int getType()
-		{
-			return (VertexType::Position | VertexType::Weight);
-		}
+		Float,
+		HalfFloat,
+		Short,
+		UnsignedShort,
+		Byte,
+		UnsignedByte,
 	};
 
-	// Position, Color
-	struct VertexPC : VertexP
+	// Integer attributes can be normalized, then shader reads them as floats in [-1, 1] or [0, 1]
+	struct VertexAttribute
 	{
-		VertexPC() {}
-		VertexPC(glm::vec3 position, glm::vec3 color) :
-			VertexP(position), color(color) {}
-
-		glm::vec3 color = glm::vec3(0.0f);
-
-		static std::vector<std::pair<uint32_t, uint32_t>> getSizeAndOffsets()
-		{
-			std::vector<std::pair<uint32_t, uint32_t>> offsets;
-			offsets.reserve(2);
-			offsets.push_back(std::pair(sizeof(position) / sizeof(position[0]), offsetof(VertexPC, position)));
-			offsets.push_back(std::pair(sizeof(color) / sizeof(color[0]), offsetof(VertexPC, color)));
-			return offsets;
-		}
-
-		static uint32_t getStride()
-		{
-			return sizeof(VertexPC);
-		}
+		constexpr VertexAttribute(uint32_t size, uint32_t offset, VertexAttributeFormat format = VertexAttributeFormat::Float, bool normalized = false) :
+			size{ size }, offset{ offset }, format{ format }, normalized{ normalized } {}
 
-		static int getType()
-		{
-			return (VertexType::Position | VertexType::Color);
-		}
+		// Number of components
+		uint32_t size;
+		uint32_t offset;
+		VertexAttributeFormat format;
+		bool normalized;
 	};
 
-	// Position, Color, Weight
-	struct VertexPCW : VertexPC
+	// Compile time description of single attribute, every attribute tag has one
+	template <typename T, int Type, VertexAttributeFormat Format = VertexAttributeFormat::Float, bool Normalized = false>
+	struct AttributeDescriptor
 	{
-		VertexPCW() = default;
-		VertexPCW(glm::vec3 position, glm::vec3 color, glm::vec4 weight) :
-			VertexPC{ position, color }, weight{ weight } {}
-
-		glm::vec4 weight = glm::vec4(0.0f);
-
-		static std::vector<std::pair<uint32_t, uint32_t>> getSizeAndOffsets()
-		{
-			std::vector<std::pair<uint32_t, uint32_t>> offsets;
-			offsets.reserve(3);
-			offsets.push_back(std::pair(sizeof(position) / sizeof(position[0]), offsetof(VertexPCW, position)));
-			offsets.push_back(std::pair(sizeof(color) / sizeof(color[0]), offsetof(VertexPCW, color)));
-			offsets.push_back(std::pair(sizeof(weight) / sizeof(weight[0]), offsetof(VertexPCW, weight)));
-			return offsets;
-		}
-
-		static uint32_t getStride()
-		{
-			return sizeof(VertexPCW);
-		}
-
-		static int getType()
-		{
-			return (VertexType::Position | VertexType::Color | VertexType::Weight);
-		}
+		using value_type = T;
+		static constexpr int type = Type;
+		static constexpr uint32_t size = sizeof(T) / sizeof(std::declval<T&>()[0]);
+		static constexpr VertexAttributeFormat format = Format;
+		static constexpr bool normalized = Normalized;
 	};
 
-	// Position, Normal
-	struct VertexPN : VertexP
+	// Attribute tags, vertex is composed from them, so each one brings its named member
+	struct PositionAttribute
 	{
-		VertexPN() {}
-		VertexPN(glm::vec3 position, glm::vec3 normal) :
-			VertexP(position), normal(normal) {}
-
-		glm::vec3 normal = glm::vec3(0.0f);
-
-		static std::vector<std::pair<uint32_t, uint32_t>> getSizeAndOffsets()
-		{
-			std::vector<std::pair<uint32_t, uint32_t>> offsets;
-			offsets.reserve(2);
-			offsets.push_back(std::pair(sizeof(position) / sizeof(position[0]), offsetof(VertexPN, position)));
-			offsets.push_back(std::pair(sizeof(normal) / sizeof(normal[0]), offsetof(VertexPN, normal)));
-			return offsets;
-		}
-
-		static uint32_t getStride()
-		{
-			return sizeof(VertexPN);
-		}
-
-		static int getType()
-		{
-			return (VertexType::Position | VertexType::Normal);
-		}
+		using descriptor = AttributeDescriptor<glm::vec3, VertexType::Position>;
+		glm::vec3 position = glm::vec3(0.0f);
 	};
 
-	// Position, Normal, Weight
-	struct VertexPNW : VertexPN
+	struct ColorAttribute
 	{
-		VertexPNW() = default;
-		VertexPNW(glm::vec3 position, glm::vec3 normal, glm::vec4 weight) :
-			VertexPN{ position, normal }, weight{ weight } {}
-
-		glm::vec4 weight = glm::vec4(0.0f);
-
-		static std::vector<std::pair<uint32_t, uint32_t>> getSizeAndOffsets()
-		{
-			std::vector<std::pair<uint32_t, uint32_t>> offsets;
-			offsets.reserve(3);
-			offsets.push_back(std::pair(sizeof(position) / sizeof(position[0]), offsetof(VertexPNW, position)));
-			offsets.push_back(std::pair(sizeof(normal) / sizeof(normal[0]), offsetof(VertexPNW, normal)));
-			offsets.push_back(std::pair(sizeof(weight) / sizeof(weight[0]), offsetof(VertexPNW, weight)));
-			return offsets;
-		}
-
-		static uint32_t getStride()
-		{
-			return sizeof(VertexPNW);
-		}
-
-		static int getType()
-		{
-			return (VertexType::Position | VertexType::Normal | VertexType::Weight);
-		}
+		using descriptor = AttributeDescriptor<glm::vec3, VertexType::Color>;
+		glm::vec3 color = glm::vec3(0.0f);
 	};
 
-	// Position, Texture Coordinates
-	struct VertexPTc : VertexP
+	struct TexCoordAttribute
 	{
-		VertexPTc() {}
-		VertexPTc(glm::vec3 position, glm::vec2 texCoord) :
-			VertexP(position), texCoord(texCoord) {}
-
+		using descriptor = AttributeDescriptor<glm::vec2, VertexType::TexCoord>;
 		glm::vec2 texCoord = glm::vec2(0.0f);
-
-		static std::vector<std::pair<uint32_t, uint32_t>> getSizeAndOffsets()
-		{
-			std::vector<std::pair<uint32_t, uint32_t>> offsets;
-			offsets.reserve(2);
-			offsets.push_back(std::pair(sizeof(position) / sizeof(position[0]), offsetof(VertexPTc, position)));
-			offsets.push_back(std::pair(sizeof(texCoord) / sizeof(texCoord[0]), offsetof(VertexPTc, texCoord)));
-			return offsets;
-		}
-
-		static uint32_t getStride()
-		{
-			return sizeof(VertexPTc);
-		}
-
-		static int getType()
-		{
-			return (VertexType::Position | VertexType::TexCoord);
-		}
-	};
-
-	// Position, Texture Coordinates, Weight
-	struct VertexPTcW : VertexPTc
-	{
-		VertexPTcW() = default;
-		VertexPTcW(glm::vec3 position, glm::vec2 texCoord, glm::vec4 weight) :
-			VertexPTc{ position, texCoord }, weight{ weight } {}
-
-		glm::vec4 weight = glm::vec4(0.0f);
-
-		static std::vector<std::pair<uint32_t, uint32_t>> getSizeAndOffsets()
-		{
-			std::vector<std::pair<uint32_t, uint32_t>> offsets;
-			offsets.reserve(3);
-			offsets.push_back(std::pair(sizeof(position) / sizeof(position[0]), offsetof(VertexPTcW, position)));
-			offsets.push_back(std::pair(sizeof(texCoord) / sizeof(texCoord[0]), offsetof(VertexPTcW, texCoord)));
-			offsets.push_back(std::pair(sizeof(weight) / sizeof(weight[0]), offsetof(VertexPTcW, weight)));
-			return offsets;
-		}
-
-		static uint32_t getStride()
-		{
-			return sizeof(VertexPTcW);
-		}
-
-		static int getType()
-		{
-			return (VertexType::Position | VertexType::TexCoord | VertexType::Weight);
-		}
 	};
 
-	// Position, Color, Texture Coordinates
-	struct VertexPCTc : VertexPC
+	struct NormalAttribute
 	{
-		VertexPCTc() {}
-		VertexPCTc(glm::vec3 position, glm::vec3 color, glm::vec2 texCoord) :
-			VertexPC(position, color), texCoord(texCoord) {}
-
-		glm::vec2 texCoord = glm::vec2(0.0f);
-
-		static std::vector<std::pair<uint32_t, uint32_t>> getSizeAndOffsets()
-		{
-			std::vector<std::pair<uint32_t, uint32_t>> offsets;
-			offsets.reserve(3);
-			offsets.push_back(std::pair(sizeof(position) / sizeof(position[0]), offsetof(VertexPCTc, position)));
-			offsets.push_back(std::pair(sizeof(color) / sizeof(color[0]), offsetof(VertexPCTc, color)));
-			offsets.push_back(std::pair(sizeof(texCoord) / sizeof(texCoord[0]), offsetof(VertexPCTc, texCoord)));
-			return offsets;
-		}
-
-		static uint32_t getStride()
-		{
-			return sizeof(VertexPCTc);
-		}
-
-		static int getType()
-		{
-			return (VertexType::Position | VertexType::Color | VertexType::TexCoord);
-		}
+		using descriptor = AttributeDescriptor<glm::vec3, VertexType::Normal>;
+		glm::vec3 normal = glm::vec3(0.0f);
 	};
 
-	// Position, Color, Texture Coordinates, Weights
-	struct VertexPCTcW : VertexPCTc
+	struct TangentAttribute
 	{
-		VertexPCTcW() = default;
-		VertexPCTcW(glm::vec3 position, glm::vec3 color, glm::vec2 texCoord, glm::vec4 weight) :
-			VertexPCTc{position, color, texCoord}, weight{ weight } {}
-
-		glm::vec4 weight = glm::vec4(0.0f);
-
-		static std::vector<std::pair<uint32_t, uint32_t>> getSizeAndOffsets()
-		{
-			std::vector<std::pair<uint32_t, uint32_t>> offsets;
-			offsets.reserve(4);
-			offsets.push_back(std::pair(sizeof(position) / sizeof(position[0]), offsetof(VertexPCTcW, position)));
-			offsets.push_back(std::pair(sizeof(color) / sizeof(color[0]), offsetof(VertexPCTcW, color)));
-			offsets.push_back(std::pair(sizeof(texCoord) / sizeof(texCoord[0]), offsetof(VertexPCTcW, texCoord)));
-			offsets.push_back(std::pair(sizeof(weight) / sizeof(weight[0]), offsetof(VertexPCTcW, weight)));
-			return offsets;
-		}
-
-		static uint32_t getStride()
-		{
-			return sizeof(VertexPCTcW);
-		}
-
-		static int getType()
-		{
-			return (VertexType::Position | VertexType::TexCoord | VertexType::Color | VertexType::Weight);
-		}
+		using descriptor = AttributeDescriptor<glm::vec3, VertexType::Tangent>;
+		glm::vec3 tangent = glm::vec3(0.0f);
 	};
 
-	// Position, Color, Normal
-	struct VertexPCN : VertexPC
+	struct BitangentAttribute
 	{
-		VertexPCN() {}
-		VertexPCN(glm::vec3 position, glm::vec3 color, glm::vec3 normal) :
-			VertexPC(position, color), normal(normal) {}
-
-		glm::vec3 normal = glm::vec3(0.0f);
-
-		static std::vector<std::pair<uint32_t, uint32_t>> getSizeAndOffsets()
-		{
-			std::vector<std::pair<uint32_t, uint32_t>> offsets;
-			offsets.reserve(3);
-			offsets.push_back(std::pair(sizeof(position) / sizeof(position[0]), offsetof(VertexPCN, position)));
-			offsets.push_back(std::pair(sizeof(color) / sizeof(color[0]), offsetof(VertexPCN, color)));
-			offsets.push_back(std::pair(sizeof(normal) / sizeof(normal[0]), offsetof(VertexPCN, normal)));
-			return offsets;
-		}
-
-		static uint32_t getStride()
-		{
-			return sizeof(VertexPCTc);
-		}
-
-		static int getType()
-		{
-			return (VertexType::Position | VertexType::Color | VertexType::TexCoord);
-		}
+		using descriptor = AttributeDescriptor<glm::vec3, VertexType::BiTangent>;
+		glm::vec3 bitangent = glm::vec3(0.0f);
 	};
 
-	// Position, Color, Normal, Weight
-	struct VertexPCNW : VertexPCN
+	struct WeightAttribute
 	{
-		VertexPCNW() = default;
-		VertexPCNW(glm::vec3 position, glm::vec3 color, glm::vec3 normal, glm::vec4 weight) :
-			VertexPCN{ position, color, normal }, weight{ weight } {}
-
+		using descriptor = AttributeDescriptor<glm::vec4, VertexType::Weight>;
 		glm::vec4 weight = glm::vec4(0.0f);
-
-		static std::vector<std::pair<uint32_t, uint32_t>> getSizeAndOffsets()
-		{
-			std::vector<std::pair<uint32_t, uint32_t>> offsets;
-			offsets.reserve(4);
-			offsets.push_back(std::pair(sizeof(position) / sizeof(position[0]), offsetof(VertexPCNW, position)));
-			offsets.push_back(std::pair(sizeof(color) / sizeof(color[0]), offsetof(VertexPCNW, color)));
-			offsets.push_back(std::pair(sizeof(normal) / sizeof(normal[0]), offsetof(VertexPCNW, normal)));
-			offsets.push_back(std::pair(sizeof(weight) / sizeof(weight[0]), offsetof(VertexPCNW, weight)));
-			return offsets;
-		}
-
-		static uint32_t getStride()
-		{
-			return sizeof(VertexPCNW);
-		}
-
-		static int getType()
-		{
-			return (VertexPCN::getType() | VertexType::Weight);
-		}
 	};
 
-	// Position, Texture Coordinate, Normal
-	struct VertexPTcN : VertexPTc
+	// Vertex laid out as attributes in given order, without padding between them.
+	// Layout, stride and type are known at compile time, so buffers do not build them at runtime
+	template <typename... Attributes>
+	struct VertexLayout : Attributes...
 	{
-		VertexPTcN() {}
-		VertexPTcN(glm::vec3 position, glm::vec2 texCoord, glm::vec3 normal) :
-			VertexPTc(position, texCoord), normal(normal) {}
-		
-		glm::vec3 normal = glm::vec3(0.0f);
+		static constexpr size_t attributesCount = sizeof...(Attributes);
 
-		static std::vector<std::pair<uint32_t, uint32_t>> getSizeAndOffsets()
-		{
-			std::vector<std::pair<uint32_t, uint32_t>> offsets;
-			offsets.reserve(3);
-			offsets.push_back(std::pair(sizeof(position) / sizeof(position[0]), offsetof(VertexPTcN, position)));
-			offsets.push_back(std::pair(sizeof(texCoord) / sizeof(texCoord[0]), offsetof(VertexPTcN, texCoord)));
-			offsets.push_back(std::pair(sizeof(normal) / sizeof(normal[0]), offsetof(VertexPTcN, normal)));
-			return offsets;
-		}
+		VertexLayout() = default;
+		VertexLayout(typename Attributes::descriptor::value_type... values) :
+			Attributes{ values }... {}
 
-		static uint32_t getStride()
+		static constexpr std::array<VertexAttribute, attributesCount> getSizeAndOffsets()
 		{
-			return sizeof(VertexPTcN);
+			static_assert(sizeof(VertexLayout) == (sizeof(Attributes) + ...), "Vertex attributes have to be tightly packed");
+			return makeSizeAndOffsets(std::index_sequence_for<Attributes...>{});
 		}
 
-		static int getType()
+		static constexpr uint32_t getStride()
 		{
-			return (VertexType::Position | VertexType::TexCoord | VertexType::Normal);
+			return sizeof(VertexLayout);
 		}
-	};
-
-	// Position, Texture Coordinate, Normal
-	struct VertexPTcNW : VertexPTcN
-	{
-		VertexPTcNW() = default;
-		VertexPTcNW(glm::vec3 position, glm::vec2 texCoord, glm::vec3 normal, glm::vec4 weight) :
-			VertexPTcN{ position, texCoord, normal }, weight{ weight }
-		{}
-
-		glm::vec4 weight = glm::vec4(0.0f);
-
-		static std::vector<std::pair<uint32_t, uint32_t>> getSizeAndOffsets()
-		{
-			std::vector<std::pair<uint32_t, uint32_t>> offsets;
-			offsets.reserve(4);
-			offsets.push_back(std::pair(sizeof(position) / sizeof(position[0]), offsetof(VertexPTcNW, position)));
-			offsets.push_back(std::pair(sizeof(texCoord) / sizeof(texCoord[0]), offsetof(VertexPTcNW, texCoord)));
-			offsets.push_back(std::pair(sizeof(normal) / sizeof(normal[0]), offsetof(VertexPTcNW, normal)));
-			offsets.push_back(std::pair(sizeof(weight) / sizeof(weight[0]), offsetof(VertexPTcNW, weight)));
-			return offsets;
-		}
-
-		static uint32_t getStride()
-		{
-			return sizeof(VertexPTcNW);
-		}
-
-		static int getType()
-		{
-			return (VertexPTcN::getType() | VertexType::Weight);
-		}
-	};
-
-	// Position Texture Coordinates, Normal, Tangent, Bitangent
-	struct VertexPTcNTB : VertexPTcN
-	{
-		VertexPTcNTB() {}
-		VertexPTcNTB(glm::vec3 position, glm::vec2 texCoord, glm::vec3 normal, glm::vec3 tangent, glm::vec3 bitangent) :
-			VertexPTcN(position, texCoord, normal), tangent(tangent), bitangent(bitangent) {}
-
-		glm::vec3 tangent = glm::vec3(0.0f);
-		glm::vec3 bitangent = glm::vec3(0.0f);
 
-		static std::vector<std::pair<uint32_t, uint32_t>> getSizeAndOffsets()
+		static constexpr int getType()
 		{
-			std::vector<std::pair<uint32_t, uint32_t>> offsets;
-			offsets.reserve(5);
-			offsets.push_back(std::pair(sizeof(position) / sizeof(position[0]), offsetof(VertexPTcNTB, position)));
-			offsets.push_back(std::pair(sizeof(texCoord) / sizeof(texCoord[0]), offsetof(VertexPTcNTB, texCoord)));
-			offsets.push_back(std::pair(sizeof(normal) / sizeof(normal[0]), offsetof(VertexPTcNTB, normal)));
-			offsets.push_back(std::pair(sizeof(tangent) / sizeof(tangent[0]), offsetof(VertexPTcNTB, tangent)));
-			offsets.push_back(std::pair(sizeof(bitangent) / sizeof(bitangent[0]), offsetof(VertexPTcNTB, bitangent)));
-			return offsets;
+			return (0 | ... | Attributes::descriptor::type);
 		}
 
-		static uint32_t getStride()
+	private:
+		template <size_t Index>
+		static constexpr uint32_t getOffset()
 		{
-			return sizeof(VertexPTcNTB);
+			constexpr uint32_t sizes[] = { sizeof(Attributes)... };
+			uint32_t offset{ 0 };
+			for (size_t i{ 0 }; i < Index; ++i)
+			{
+				offset += sizes[i];
+			}
+			return offset;
 		}
 
-		static int getType()
+		template <size_t... Indices>
+		static constexpr std::array<VertexAttribute, attributesCount> makeSizeAndOffsets(std::index_sequence<Indices...>)
 		{
-			return (VertexType::Position | VertexType::TexCoord | VertexType::Normal | VertexType::Tangent | VertexType::BiTangent);
+			return { VertexAttribute(Attributes::descriptor::size, getOffset<Indices>(), Attributes::descriptor::format, Attributes::descriptor::normalized)... };
 		}
 	};
 
+	// Position
+	using VertexP = VertexLayout<PositionAttribute>;
+	// Position, Weight
+	using VertexPW = VertexLayout<PositionAttribute, WeightAttribute>;
+	// Position, Color
+	using VertexPC = VertexLayout<PositionAttribute, ColorAttribute>;
+	// Position, Color, Weight
+	using VertexPCW = VertexLayout<PositionAttribute, ColorAttribute, WeightAttribute>;
+	// Position, Normal
+	using VertexPN = VertexLayout<PositionAttribute, NormalAttribute>;
+	// Position, Normal, Weight
+	using VertexPNW = VertexLayout<PositionAttribute, NormalAttribute, WeightAttribute>;
+	// Position, Texture Coordinates
+	using VertexPTc = VertexLayout<PositionAttribute, TexCoordAttribute>;
+	// Position, Texture Coordinates, Weight
+	using VertexPTcW = VertexLayout<PositionAttribute, TexCoordAttribute, WeightAttribute>;
+	// Position, Color, Texture Coordinates
+	using VertexPCTc = VertexLayout<PositionAttribute, ColorAttribute, TexCoordAttribute>;
+	// Position, Color, Texture Coordinates, Weight
+	using VertexPCTcW = VertexLayout<PositionAttribute, ColorAttribute, TexCoordAttribute, WeightAttribute>;
+	// Position, Color, Normal
+	using VertexPCN = VertexLayout<PositionAttribute, ColorAttribute, NormalAttribute>;
+	// Position, Color, Normal, Weight
+	using VertexPCNW = VertexLayout<PositionAttribute, ColorAttribute, NormalAttribute, WeightAttribute>;
+	// Position, Texture Coordinates, Normal
+	using VertexPTcN = VertexLayout<PositionAttribute, TexCoordAttribute, NormalAttribute>;
+	// Position, Texture Coordinates, Normal, Weight
+	using VertexPTcNW = VertexLayout<PositionAttribute, TexCoordAttribute, NormalAttribute, WeightAttribute>;
+	// Position, Texture Coordinates, Normal, Tangent, Bitangent
+	using VertexPTcNTB = VertexLayout<PositionAttribute, TexCoordAttribute, NormalAttribute, TangentAttribute, BitangentAttribute>;
 	// Position Texture Coordinates, Normal, Tangent, Bitangent, Weight
-	struct VertexPTcNTBW : VertexPTcNTB
-	{
-		VertexPTcNTBW() {}
-		VertexPTcNTBW(glm::vec3 position, glm::vec2 texCoord, glm::vec3 normal, glm::vec3 tangent, glm::vec3 bitangent, glm::vec4 weight) :
-			VertexPTcNTB(position, texCoord, normal, tangent, bitangent), weight{ weight }{}
-
-		glm::vec4 weight = glm::vec4(0.0f);
-
-		static std::vector<std::pair<uint32_t, uint32_t>> getSizeAndOffsets()
-		{
-			std::vector<std::pair<uint32_t, uint32_t>> offsets;
-			offsets.reserve(6);
-			offsets.push_back(std::pair(sizeof(position) / sizeof(position[0]), offsetof(VertexPTcNTBW, position)));
-			offsets.push_back(std::pair(sizeof(texCoord) / sizeof(texCoord[0]), offsetof(VertexPTcNTBW, texCoord)));
-			offsets.push_back(std::pair(sizeof(normal) / sizeof(normal[0]), offsetof(VertexPTcNTBW, normal)));
-			offsets.push_back(std::pair(sizeof(tangent) / sizeof(tangent[0]), offsetof(VertexPTcNTBW, tangent)));
-			offsets.push_back(std::pair(sizeof(bitangent) / sizeof(bitangent[0]), offsetof(VertexPTcNTBW, bitangent)));
-			offsets.push_back(std::pair(sizeof(weight) / sizeof(weight[0]), offsetof(VertexPTcNTBW, weight)));
-			return offsets;
-		}
-
-		static uint32_t getStride()
-		{
-			return sizeof(VertexPTcNTBW);
-		}
-
-		static int getType()
-		{
-			return (VertexPTcNTB::getType() | VertexType::Weight);
-		}
-	};
+	using VertexPTcNTBW = VertexLayout<PositionAttribute, TexCoordAttribute, NormalAttribute, TangentAttribute, BitangentAttribute, WeightAttribute>;
 
 	// Record new vertex type so compiler will know how to access to them
 	using VertexTypesRegister = Core::Utils::TypesRegister<VertexP, VertexPW, VertexPC, VertexPCW, VertexPN, VertexPNW, VertexPTc, VertexPTcW, VertexPCTc, VertexPCTcW, VertexPCN, VertexPCNW, VertexPTcN, VertexPTcNW, VertexPTcNTB, VertexPTcNTBW>;
@@ -1,7 +1,14 @@
 #pragma once
 
+#include "DrawElementsCommand.hpp"
 #include "../Core/Utils/UniqueIdentifier.hpp"
 
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 namespace GraphicEngine::Common
 {
 	template <typename BasicVertexBuffer, typename... Args>
@@ -25,14 +32,37 @@ namespace GraphicEngine::Common
 			static_cast<BasicVertexBuffer*>(this)->drawElements(args...);
 		}
 
+		// Draws ranges of index buffer from command list, e.g. visible meshlets
+		void drawElements(Args... args, const std::vector<DrawElementsCommand>& commands)
+		{
+			static_cast<BasicVertexBuffer*>(this)->drawElements(args..., commands);
+		}
+
 		void drawEdges(Args... args)
 		{
 			static_cast<BasicVertexBuffer*>(this)->drawEdges(args...);
 		}
 
+		// Level of detail is range of indices drawn by drawElements, ranges are given by Mesh::getLodRanges
+		void setLods(const std::vector<std::pair<uint32_t, uint32_t>>& lods)
+		{
+			static_cast<BasicVertexBuffer*>(this)->setLods(lods);
+		}
+
+		void setLod(uint32_t level)
+		{
+			static_cast<BasicVertexBuffer*>(this)->setLod(level);
+		}
+
 		void unbind(Args... args)
 		{
 			static_cast<BasicVertexBuffer*>(this)->unbind(args...);
 		}
+
+		// Packed vertices have positions quantized to bouding box, this matrix has to be applied before model matrix
+		glm::mat4 getDequantizationMatrix()
+		{
+			return static_cast<BasicVertexBuffer*>(this)->getDequantizationMatrix();
+		}
 	};
 }
@@ -0,0 +1,132 @@
+#include "BenchmarkReport.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#undef min
+#undef max
+
+GraphicEngine::Core::BenchmarkReport::BenchmarkReport(nlohmann::json description) :
+	// Braces would wrap json into array
+	m_description(std::move(description))
+{
+}
+
+void GraphicEngine::Core::BenchmarkReport::addPath(const std::string& name, uint64_t frames, const std::vector<ProfilerZoneStatistics>& zones, const std::vector<ProfilerZoneStatistics>& counters)
+{
+	m_paths[name] = {
+		{ "frames", frames },
+		{ "cpu", toJson(zones, false, false) },
+		{ "gpu", toJson(zones, true, false) },
+		{ "counters", toJson(counters, false, true) } };
+}
+
+std::vector<GraphicEngine::Core::BenchmarkRegression> GraphicEngine::Core::BenchmarkReport::compare(const nlohmann::json& baseline, const BenchmarkThresholds& thresholds)
+{
+	m_regressions.clear();
+	if (!baseline.contains("version") || baseline["version"] != version || !baseline.contains("paths"))
+	{
+		throw std::runtime_error("Benchmark baseline has unsupported format!");
+	}
+
+	for (const auto& [path, current] : m_paths.items())
+	{
+		if (!baseline["paths"].contains(path))
+			continue;
+
+		const auto& baselinePath = baseline["paths"][path];
+		compareGroup(path, "cpu", baselinePath, current, "p50", thresholds.cpu, thresholds.minimumTime, m_regressions);
+		compareGroup(path, "gpu", baselinePath, current, "p50", thresholds.gpu, thresholds.minimumTime, m_regressions);
+		compareGroup(path, "counters", baselinePath, current, "average", thresholds.counters, 0.0, m_regressions);
+	}
+	return m_regressions;
+}
+
+const std::vector<GraphicEngine::Core::BenchmarkRegression>& GraphicEngine::Core::BenchmarkReport::getRegressions() const
+{
+	return m_regressions;
+}
+
+nlohmann::json GraphicEngine::Core::BenchmarkReport::toJson() const
+{
+	nlohmann::json regressions = nlohmann::json::array();
+	for (const auto& regression : m_regressions)
+	{
+		regressions.push_back({
+			{ "path", regression.path },
+			{ "group", regression.group },
+			{ "name", regression.name },
+			{ "baseline", regression.baseline },
+			{ "current", regression.current },
+			{ "change", regression.change } });
+	}
+
+	return {
+		{ "version", version },
+		{ "description", m_description },
+		{ "paths", m_paths },
+		{ "regressions", regressions } };
+}
+
+void GraphicEngine::Core::BenchmarkReport::save(const std::string& path) const
+{
+	std::ofstream file(path);
+	if (!file.is_open())
+	{
+		throw std::runtime_error("Could not open file " + path + " for writing!");
+	}
+	file << toJson().dump(4);
+}
+
+nlohmann::json GraphicEngine::Core::BenchmarkReport::load(const std::string& path)
+{
+	std::ifstream file(path);
+	if (!file.is_open())
+	{
+		throw std::runtime_error("Could not open file " + path + "!");
+	}
+	return nlohmann::json::parse(file);
+}
+
+nlohmann::json GraphicEngine::Core::BenchmarkReport::toJson(const std::vector<ProfilerZoneStatistics>& statistics, bool gpu, bool counters)
+{
+	nlohmann::json group = nlohmann::json::object();
+	for (const auto& zone : statistics)
+	{
+		if (!counters && zone.gpu != gpu)
+			continue;
+
+		group[zone.name] = {
+			{ "average", zone.average },
+			{ "p50", zone.p50 },
+			{ "p95", zone.p95 },
+			{ "p99", zone.p99 } };
+	}
+	return group;
+}
+
+void GraphicEngine::Core::BenchmarkReport::compareGroup(const std::string& path, const std::string& group, const nlohmann::json& baseline, const nlohmann::json& current,
+	const std::string& metric, double threshold, double minimum, std::vector<BenchmarkRegression>& regressions)
+{
+	if (!baseline.contains(group) || !current.contains(group))
+		return;
+
+	for (const auto& [name, values] : current[group].items())
+	{
+		if (!baseline[group].contains(name))
+			continue;
+
+		double baselineValue = baseline[group][name][metric].get<double>();
+		double currentValue = values[metric].get<double>();
+		// Zero baseline has no relative change, short zones are dominated by timer noise
+		if (baselineValue <= 0.0 || std::max(baselineValue, currentValue) < minimum)
+			continue;
+
+		double change = (currentValue - baselineValue) / baselineValue;
+		if (change > threshold)
+		{
+			regressions.push_back(BenchmarkRegression{ path, group, name, baselineValue, currentValue, change });
+		}
+	}
+}
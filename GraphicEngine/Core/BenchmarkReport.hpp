@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Profiler.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <string>
+#include <vector>
+
+namespace GraphicEngine::Core
+{
+	// Allowed relative growth of metric before it is reported, times below minimum are too noisy to compare
+	struct BenchmarkThresholds
+	{
+		double cpu{ 0.1 };
+		double gpu{ 0.1 };
+		double counters{ 0.05 };
+		double minimumTime{ 0.05 };
+	};
+
+	struct BenchmarkRegression
+	{
+		std::string path;
+		std::string group;
+		std::string name;
+		double baseline;
+		double current;
+		double change;
+	};
+
+	// Results of camera paths in format stable between commits, zones are compared by median and counters by average
+	class BenchmarkReport
+	{
+	public:
+		static constexpr uint32_t version{ 1 };
+
+		explicit BenchmarkReport(nlohmann::json description = nlohmann::json::object());
+
+		void addPath(const std::string& name, uint64_t frames, const std::vector<ProfilerZoneStatistics>& zones, const std::vector<ProfilerZoneStatistics>& counters);
+
+		// Compares with report saved by earlier run, found regressions are kept in report
+		std::vector<BenchmarkRegression> compare(const nlohmann::json& baseline, const BenchmarkThresholds& thresholds);
+
+		const std::vector<BenchmarkRegression>& getRegressions() const;
+
+		nlohmann::json toJson() const;
+		void save(const std::string& path) const;
+		static nlohmann::json load(const std::string& path);
+
+	private:
+		static nlohmann::json toJson(const std::vector<ProfilerZoneStatistics>& statistics, bool gpu, bool counters);
+		static void compareGroup(const std::string& path, const std::string& group, const nlohmann::json& baseline, const nlohmann::json& current,
+			const std::string& metric, double threshold, double minimum, std::vector<BenchmarkRegression>& regressions);
+
+	private:
+		nlohmann::json m_description;
+		nlohmann::json m_paths = nlohmann::json::object();
+		std::vector<BenchmarkRegression> m_regressions;
+	};
+}
@@ -0,0 +1,52 @@
+#include "FileWatcher.hpp"
+
+#include <stdexcept>
+#include <system_error>
+
+GraphicEngine::Core::IO::FileWatcher::FileWatcher(std::filesystem::path directory) :
+	m_directory{ std::move(directory) }
+{
+	if (!std::filesystem::is_directory(m_directory))
+	{
+		throw std::runtime_error("Watched directory does not exist: " + m_directory.string());
+	}
+	m_files = scan();
+}
+
+std::vector<std::string> GraphicEngine::Core::IO::FileWatcher::getChangedFiles()
+{
+	auto files = scan();
+	std::vector<std::string> changedFiles;
+	for (const auto& [fileName, state] : files)
+	{
+		auto previous = m_files.find(fileName);
+		if (previous == std::end(m_files) || previous->second.writeTime != state.writeTime || previous->second.size != state.size)
+		{
+			changedFiles.push_back(fileName);
+		}
+	}
+	m_files = std::move(files);
+	return changedFiles;
+}
+
+std::map<std::string, GraphicEngine::Core::IO::FileWatcher::FileState> GraphicEngine::Core::IO::FileWatcher::scan() const
+{
+	// Files can be replaced by editor while directory is read, such files are picked up by next scan
+	std::map<std::string, FileState> files;
+	std::error_code error;
+	for (const auto& entry : std::filesystem::directory_iterator(m_directory, error))
+	{
+		if (!entry.is_regular_file(error))
+			continue;
+
+		FileState state;
+		state.writeTime = entry.last_write_time(error);
+		if (error)
+			continue;
+		state.size = entry.file_size(error);
+		if (error)
+			continue;
+		files.emplace(entry.path().filename().string(), state);
+	}
+	return files;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace GraphicEngine::Core::IO
+{
+	// Finds files of directory changed since last check by comparing their write time and size, so it behaves same on every platform
+	class FileWatcher
+	{
+	public:
+		// Files present at construction are taken as unchanged
+		FileWatcher(std::filesystem::path directory);
+
+		// Names of files added or modified since last call, removed files are forgotten
+		std::vector<std::string> getChangedFiles();
+
+	private:
+		struct FileState
+		{
+			std::filesystem::file_time_type writeTime;
+			std::uintmax_t size{ 0 };
+		};
+
+		std::map<std::string, FileState> scan() const;
+
+	private:
+		std::filesystem::path m_directory;
+		std::map<std::string, FileState> m_files;
+	};
+}
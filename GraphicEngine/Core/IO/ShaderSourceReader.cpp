@@ -0,0 +1,56 @@
+#include "ShaderSourceReader.hpp"
+#include "FileReader.hpp"
+
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+	void appendShaderSource(const std::filesystem::path& path, std::set<std::filesystem::path>& includedFiles, std::string& output)
+	{
+		std::istringstream source(GraphicEngine::Core::IO::readFile<std::string>(path.string()));
+		std::string line;
+		uint32_t lineNumber{ 0 };
+		while (std::getline(source, line))
+		{
+			++lineNumber;
+			auto first = line.find_first_not_of(" \t");
+			if (first == std::string::npos || line.compare(first, 8, "#include") != 0)
+			{
+				output += line + "\n";
+				continue;
+			}
+
+			auto nameBegin = line.find('"', first);
+			auto nameEnd = nameBegin == std::string::npos ? std::string::npos : line.find('"', nameBegin + 1);
+			if (nameEnd == std::string::npos)
+			{
+				throw std::runtime_error("Invalid include in " + path.string() + " at line " + std::to_string(lineNumber));
+			}
+
+			auto includePath = path.parent_path() / line.substr(nameBegin + 1, nameEnd - nameBegin - 1);
+			if (!includedFiles.insert(includePath.lexically_normal()).second)
+			{
+				continue;
+			}
+
+			// Line directives keep line numbers of compiler messages right outside of included file
+			appendShaderSource(includePath, includedFiles, output);
+			output += "#line " + std::to_string(lineNumber + 1) + "\n";
+		}
+	}
+}
+
+std::string GraphicEngine::Core::IO::readShaderSource(const std::filesystem::path& path)
+{
+	std::set<std::filesystem::path> includedFiles{ path.lexically_normal() };
+	std::string output;
+	appendShaderSource(path, includedFiles, output);
+	return output;
+}
+
+bool GraphicEngine::Core::IO::isShaderInclude(const std::string& fileName)
+{
+	return std::filesystem::path(fileName).extension() == ".glsl";
+}
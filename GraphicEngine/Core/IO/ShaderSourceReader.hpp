@@ -0,0 +1,14 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+namespace GraphicEngine::Core::IO
+{
+	// Reads GLSL source with each line #include "file.glsl" replaced by content of that file from same directory, so OpenGL and Vulkan shaders
+	// share declarations and hash of returned source covers included files. Each file is inserted once, throws runtime_error when file is missing
+	std::string readShaderSource(const std::filesystem::path& path);
+
+	// Included files are not shader stages, e.g. lightCluster.glsl
+	bool isShaderInclude(const std::string& fileName);
+}
@@ -0,0 +1,158 @@
+#include "DrawCulling.hpp"
+#include "Meshlets.hpp"
+#include "Geometry/3D/BoudingBox3D.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#undef max
+#undef min
+
+uint32_t GraphicEngine::Core::Math::DepthPyramid::getLevelsCount() const
+{
+	return static_cast<uint32_t>(levels.size());
+}
+
+float GraphicEngine::Core::Math::DepthPyramid::getDepth(uint32_t level, uint32_t x, uint32_t y) const
+{
+	glm::uvec2 size = sizes.at(level);
+	x = std::min(x, size.x - 1);
+	y = std::min(y, size.y - 1);
+	return levels[level][static_cast<size_t>(y) * size.x + x];
+}
+
+GraphicEngine::Core::Math::DepthPyramid GraphicEngine::Core::Math::buildDepthPyramid(const std::vector<float>& depth, uint32_t width, uint32_t height)
+{
+	if (width == 0 || height == 0 || depth.size() != static_cast<size_t>(width) * height)
+	{
+		throw std::invalid_argument("Size of depth does not match extent!");
+	}
+
+	DepthPyramid depthPyramid;
+	depthPyramid.sizes.emplace_back(width, height);
+	depthPyramid.levels.push_back(depth);
+	while (depthPyramid.sizes.back().x > 1 || depthPyramid.sizes.back().y > 1)
+	{
+		glm::uvec2 previousSize = depthPyramid.sizes.back();
+		glm::uvec2 size = glm::max(previousSize / 2u, glm::uvec2(1));
+		std::vector<float> level(static_cast<size_t>(size.x) * size.y);
+		const auto& previousLevel = depthPyramid.levels.back();
+
+		for (uint32_t y{ 0 }; y < size.y; ++y)
+		{
+			for (uint32_t x{ 0 }; x < size.x; ++x)
+			{
+				uint32_t lastX = (x + 1 == size.x) ? previousSize.x - 1 : 2 * x + 1;
+				uint32_t lastY = (y + 1 == size.y) ? previousSize.y - 1 : 2 * y + 1;
+				float farthest{ 0.0f };
+				for (uint32_t previousY{ 2 * y }; previousY <= lastY; ++previousY)
+				{
+					for (uint32_t previousX{ 2 * x }; previousX <= lastX; ++previousX)
+					{
+						farthest = std::max(farthest, previousLevel[static_cast<size_t>(previousY) * previousSize.x + previousX]);
+					}
+				}
+				level[static_cast<size_t>(y) * size.x + x] = farthest;
+			}
+		}
+
+		depthPyramid.sizes.push_back(size);
+		depthPyramid.levels.push_back(std::move(level));
+	}
+	return depthPyramid;
+}
+
+bool GraphicEngine::Core::Math::isSphereOccluded(glm::vec3 center, float radius, const glm::mat4& modelViewProjection, const DepthPyramid& depthPyramid)
+{
+	// Corners of box around sphere bound its projection
+	glm::vec2 minUv{ std::numeric_limits<float>::max() };
+	glm::vec2 maxUv{ std::numeric_limits<float>::lowest() };
+	float nearestDepth{ std::numeric_limits<float>::max() };
+	for (uint32_t corner{ 0 }; corner < 8; ++corner)
+	{
+		glm::vec3 offset((corner & 1) ? radius : -radius, (corner & 2) ? radius : -radius, (corner & 4) ? radius : -radius);
+		glm::vec4 clip = modelViewProjection * glm::vec4(center + offset, 1.0f);
+		if (clip.w <= 0.0f || clip.z < 0.0f)
+		{
+			return false;
+		}
+
+		glm::vec3 ndc = glm::vec3(clip) / clip.w;
+		glm::vec2 uv(ndc.x * 0.5f + 0.5f, 0.5f - ndc.y * 0.5f);
+		minUv = glm::min(minUv, uv);
+		maxUv = glm::max(maxUv, uv);
+		nearestDepth = std::min(nearestDepth, ndc.z);
+	}
+
+	// Level is selected so bounds cover at most two texels in each direction
+	glm::uvec2 size = depthPyramid.sizes.at(0);
+	glm::uvec2 first = glm::min(glm::uvec2(glm::clamp(minUv, 0.0f, 1.0f) * glm::vec2(size)), size - 1u);
+	glm::uvec2 last = glm::min(glm::uvec2(glm::clamp(maxUv, 0.0f, 1.0f) * glm::vec2(size)), size - 1u);
+	uint32_t level{ 0 };
+	while (level + 1 < depthPyramid.getLevelsCount() && ((last.x >> level) - (first.x >> level) > 1 || (last.y >> level) - (first.y >> level) > 1))
+	{
+		++level;
+	}
+
+	float farthest = std::max(
+		std::max(depthPyramid.getDepth(level, first.x >> level, first.y >> level), depthPyramid.getDepth(level, last.x >> level, first.y >> level)),
+		std::max(depthPyramid.getDepth(level, first.x >> level, last.y >> level), depthPyramid.getDepth(level, last.x >> level, last.y >> level)));
+	return nearestDepth > farthest;
+}
+
+uint32_t GraphicEngine::Core::Math::selectCullingLod(const CullingObject& object, const glm::mat4& modelViewProjection)
+{
+	float projectedSize = BoudingBox3D(object.boundsMin, object.boundsMax).getProjectedSize(modelViewProjection);
+
+	uint32_t lodsCount = std::min(object.lodsCount, maxCullingLods);
+	uint32_t level{ 0 };
+	while (level + 1 < lodsCount && object.lodErrors[level + 1] * projectedSize <= object.lodScreenError)
+	{
+		++level;
+	}
+	return level;
+}
+
+void GraphicEngine::Core::Math::cullDraws(const std::vector<CullingDraw>& draws, const std::vector<CullingObject>& objects, const std::vector<glm::mat4>& modelMatrices,
+	const glm::mat4& viewProjection, glm::vec3 eyePosition, const DepthPyramid* depthPyramid, const glm::mat4& depthPyramidViewProjection,
+	const std::vector<uint32_t>& batchFirstCommands, std::vector<Common::DrawElementsCommand>& commands, std::vector<uint32_t>& counts)
+{
+	std::fill(std::begin(counts), std::end(counts), 0);
+	for (const auto& draw : draws)
+	{
+		if (draw.objectIndex == removedCullingObject)
+			continue;
+
+		// Draw is tested in space of mesh, so scale of model does not change its radius and cone
+		const CullingObject& object = objects.at(draw.objectIndex);
+		glm::mat4 modelMatrix = modelMatrices.at(draw.objectIndex) * object.meshMatrix;
+		if (draw.lod != selectCullingLod(object, viewProjection * modelMatrix))
+			continue;
+
+		auto frustumPlanes = calculateFrustumPlanes(viewProjection * modelMatrix);
+		if (std::any_of(std::begin(frustumPlanes), std::end(frustumPlanes), [&](const glm::vec4& plane) { return glm::dot(glm::vec3(plane), draw.center) + plane.w < -draw.radius; }))
+			continue;
+
+		if (draw.coneCutoff < 1.0f)
+		{
+			glm::vec3 direction = draw.coneApex - glm::vec3(glm::inverse(modelMatrix) * glm::vec4(eyePosition, 1.0f));
+			float length = glm::length(direction);
+			if (length > 0.0f && glm::dot(direction, draw.coneAxis) >= draw.coneCutoff * length)
+				continue;
+		}
+
+		if (depthPyramid && isSphereOccluded(draw.center, draw.radius, depthPyramidViewProjection * modelMatrix, *depthPyramid))
+			continue;
+
+		uint32_t& count = counts.at(object.batch);
+		Common::DrawElementsCommand& command = commands.at(static_cast<size_t>(batchFirstCommands.at(object.batch)) + count);
+		command = Common::DrawElementsCommand{};
+		command.indexCount = draw.indexCount;
+		command.firstIndex = object.firstIndex + draw.firstIndex;
+		command.vertexOffset = object.vertexOffset;
+		command.firstInstance = draw.objectIndex;
+		++count;
+	}
+}
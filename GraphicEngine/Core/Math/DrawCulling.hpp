@@ -0,0 +1,95 @@
+#pragma once
+
+#include "../../Common/DrawElementsCommand.hpp"
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace GraphicEngine::Core::Math
+{
+	// Draws of removed objects are kept in buffer with this object index and are skipped
+	constexpr uint32_t removedCullingObject{ std::numeric_limits<uint32_t>::max() };
+	// Levels of detail of object past this one are not selected
+	constexpr uint32_t maxCullingLods{ 8 };
+	// Every batch is drawn by one indirect draw with count, e.g. renderer draws objects of one vertex type in one batch
+	constexpr uint32_t maxCullingBatches{ 16 };
+
+	// Range of indices of one level of detail with bounds in space of mesh, layout matches std430 struct of cull.comp
+	struct CullingDraw
+	{
+		glm::vec3 center{ 0.0f };
+		float radius{ 0.0f };
+
+		// Same cone as in meshlet, cutoff 1 never culls
+		glm::vec3 coneApex{ 0.0f };
+		float coneCutoff{ 1.0f };
+		glm::vec3 coneAxis{ 0.0f };
+		uint32_t objectIndex{ 0 };
+
+		// Relative to first index of object
+		uint32_t firstIndex{ 0 };
+		uint32_t indexCount{ 0 };
+		// Draw is culled only when this level is selected for its object
+		uint32_t lod{ 0 };
+		uint32_t padding{ 0 };
+	};
+
+	static_assert(sizeof(CullingDraw) == 64, "Culling draw has to match layout of shader");
+
+	// Data of object shared by its draws, layout matches std430 struct of cull.comp
+	struct CullingObject
+	{
+		// Brings bounds from space of mesh to space of vertices, model matrix of object is multiplied by it
+		glm::mat4 meshMatrix{ 1.0f };
+
+		// Box of mesh used for selection of level, same as in Mesh::selectLod
+		glm::vec3 boundsMin{ 0.0f };
+		uint32_t lodsCount{ 1 };
+		glm::vec3 boundsMax{ 0.0f };
+		float lodScreenError{ 0.0f };
+		// Error of every level, level 0 is base mesh without error
+		float lodErrors[maxCullingLods]{};
+
+		// Place of mesh in shared vertex and index buffers
+		int32_t vertexOffset{ 0 };
+		uint32_t firstIndex{ 0 };
+		uint32_t batch{ 0 };
+		uint32_t padding{ 0 };
+	};
+
+	static_assert(sizeof(CullingObject) == 144, "Culling object has to match layout of shader");
+
+	// Level 0 is depth buffer and every next level keeps farthest depth of texels it covers, so testing against it never hides visible object.
+	// Row 0 is top of screen like in flipped viewport of renderer
+	struct DepthPyramid
+	{
+		std::vector<glm::uvec2> sizes;
+		std::vector<std::vector<float>> levels;
+
+		uint32_t getLevelsCount() const;
+		// Coordinates past edge are clamped to last texel
+		float getDepth(uint32_t level, uint32_t x, uint32_t y) const;
+	};
+
+	// Level sizes are halved and rounded down, last texel of odd row or column is merged into previous one
+	DepthPyramid buildDepthPyramid(const std::vector<float>& depth, uint32_t width, uint32_t height);
+
+	// Sphere is occluded when its nearest depth lies behind farthest depth of pyramid texels covering its screen bounds.
+	// Depth is clip z divided by w, sphere crossing near plane is never occluded
+	bool isSphereOccluded(glm::vec3 center, float radius, const glm::mat4& modelViewProjection, const DepthPyramid& depthPyramid);
+
+	// Coarsest level which error projected on screen stays under limit of object
+	uint32_t selectCullingLod(const CullingObject& object, const glm::mat4& modelViewProjection);
+
+	// Reference of cull.comp. Draws of level selected for their object are tested, objects and model matrices are indexed by object index
+	// and culling is done with model matrix multiplied by mesh matrix of object. Commands of visible draws are compacted from first command of batch
+	// of their object and counts are indexed by batch. Occlusion is tested when pyramid is given, with view projection used when it was rendered
+	void cullDraws(const std::vector<CullingDraw>& draws, const std::vector<CullingObject>& objects, const std::vector<glm::mat4>& modelMatrices,
+		const glm::mat4& viewProjection, glm::vec3 eyePosition, const DepthPyramid* depthPyramid, const glm::mat4& depthPyramidViewProjection,
+		const std::vector<uint32_t>& batchFirstCommands, std::vector<Common::DrawElementsCommand>& commands, std::vector<uint32_t>& counts);
+}
@@ -1,10 +1,16 @@
 #include "BoudingBox3D.hpp"
+#include <glm/common.hpp>
+#include <glm/vec2.hpp>
 #include <glm/vec4.hpp>
 
+#include <limits>
+
 GraphicEngine::Core::BoudingBox3D::BoudingBox3D()
 {
 	m_left = glm::vec3(10000000.0f);
 	m_right = glm::vec3(-10000000.0f);
+	m_baseLeft = m_left;
+	m_baseRight = m_right;
 }
 
 GraphicEngine::Core::BoudingBox3D::BoudingBox3D(glm::vec3 left, glm::vec3 right) :
@@ -50,3 +56,34 @@ void GraphicEngine::Core::BoudingBox3D::applyTransformation()
 	m_baseLeft = m_left;
 	m_baseRight = m_right;
 }
+
+glm::vec3 GraphicEngine::Core::BoudingBox3D::getBaseLeft() const
+{
+	return m_baseLeft;
+}
+
+glm::vec3 GraphicEngine::Core::BoudingBox3D::getBaseRight() const
+{
+	return m_baseRight;
+}
+
+float GraphicEngine::Core::BoudingBox3D::getProjectedSize(const glm::mat4& modelViewProjection) const
+{
+	glm::vec2 left(std::numeric_limits<float>::max());
+	glm::vec2 right(std::numeric_limits<float>::lowest());
+	for (uint32_t corner{ 0 }; corner < 8; ++corner)
+	{
+		glm::vec3 point((corner & 1) ? m_right.x : m_left.x, (corner & 2) ? m_right.y : m_left.y, (corner & 4) ? m_right.z : m_left.z);
+		glm::vec4 projected = modelViewProjection * glm::vec4(point, 1.0f);
+		if (projected.w <= m_eplilion)
+			return std::numeric_limits<float>::infinity();
+
+		glm::vec2 ndc = glm::vec2(projected) / projected.w;
+		left = glm::min(left, ndc);
+		right = glm::max(right, ndc);
+	}
+
+	// Normalized device coordinates span 2 units across viewport
+	glm::vec2 size = (right - left) / 2.0f;
+	return std::max(size.x, size.y);
+}
@@ -26,6 +26,13 @@ namespace GraphicEngine::Core
 
 		void applyTransformation();
 
+		// Box before transformation, in space of points it was extended with
+		glm::vec3 getBaseLeft() const;
+		glm::vec3 getBaseRight() const;
+
+		// Larger of width and height of box projected on screen as fraction of viewport, infinite when box crosses near plane
+		float getProjectedSize(const glm::mat4& modelViewProjection) const;
+
 		void operator=(BoudingBox3D boudingBox)
 		{
 			m_left = boudingBox.m_left;
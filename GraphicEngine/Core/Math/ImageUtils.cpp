@@ -55,7 +55,7 @@ glm::vec3 GraphicEngine::Core::hsvToRgb(glm::vec3 hsv)
 		return glm::vec3(hsv.z);
 
 	float h = hsv.x / 60;
-	int i = std::floorf(h);
+	int i = static_cast<int>(std::floor(h));
 	float f = h - i;
 	float p = hsv.z * (1 - hsv.y);
 	float q = hsv.z * (1 - hsv.y * f);
@@ -0,0 +1,298 @@
+#include "MeshSimplifier.hpp"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+
+namespace
+{
+	// Area weighted sum of squared distances from planes of triangles, stored as upper half of symmetric 4x4 matrix
+	struct Quadric
+	{
+		float a00{ 0.0f }, a01{ 0.0f }, a02{ 0.0f }, a03{ 0.0f };
+		float a11{ 0.0f }, a12{ 0.0f }, a13{ 0.0f };
+		float a22{ 0.0f }, a23{ 0.0f };
+		float a33{ 0.0f };
+		float weight{ 0.0f };
+
+		Quadric& operator+=(const Quadric& quadric)
+		{
+			a00 += quadric.a00; a01 += quadric.a01; a02 += quadric.a02; a03 += quadric.a03;
+			a11 += quadric.a11; a12 += quadric.a12; a13 += quadric.a13;
+			a22 += quadric.a22; a23 += quadric.a23;
+			a33 += quadric.a33;
+			weight += quadric.weight;
+			return *this;
+		}
+
+		// Mean squared distance, so error does not grow with number of merged planes
+		float evaluate(glm::vec3 p) const
+		{
+			if (weight == 0.0f)
+				return 0.0f;
+
+			float error = a00 * p.x * p.x + 2.0f * a01 * p.x * p.y + 2.0f * a02 * p.x * p.z + 2.0f * a03 * p.x
+				+ a11 * p.y * p.y + 2.0f * a12 * p.y * p.z + 2.0f * a13 * p.y
+				+ a22 * p.z * p.z + 2.0f * a23 * p.z
+				+ a33;
+			return std::max(error / weight, 0.0f);
+		}
+	};
+
+	Quadric planeQuadric(glm::vec3 normal, float distance, float weight)
+	{
+		return Quadric{
+			weight * normal.x * normal.x, weight * normal.x * normal.y, weight * normal.x * normal.z, weight * normal.x * distance,
+			weight * normal.y * normal.y, weight * normal.y * normal.z, weight * normal.y * distance,
+			weight * normal.z * normal.z, weight * normal.z * distance,
+			weight * distance * distance,
+			weight };
+	}
+
+	struct Collapse
+	{
+		uint32_t from;
+		uint32_t to;
+		float error;
+	};
+
+	// Smallest angle between triangle normal before and after collapse, which is still not treated as flip (~75 degrees)
+	constexpr float flipThreshold{ 0.25f };
+}
+
+GraphicEngine::Core::Math::SimplifiedMesh GraphicEngine::Core::Math::simplifyMesh(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, size_t targetIndicesCount)
+{
+	if (indices.size() % 3 != 0)
+	{
+		throw std::invalid_argument("Indices do not form triangle list!");
+	}
+	for (uint32_t index : indices)
+	{
+		if (index >= positions.size())
+		{
+			throw std::out_of_range("Index is out of vertices range!");
+		}
+	}
+
+	SimplifiedMesh simplifiedMesh{ indices, 0.0f };
+	if (indices.size() <= targetIndicesCount)
+		return simplifiedMesh;
+
+	size_t verticesCount = positions.size();
+
+	// Vertices with same position get same id, so seams are not seen as borders
+	auto positionLess = [&](uint32_t v1, uint32_t v2)
+	{
+		return std::tie(positions[v1].x, positions[v1].y, positions[v1].z) < std::tie(positions[v2].x, positions[v2].y, positions[v2].z);
+	};
+	std::vector<uint32_t> sortedVertices(verticesCount);
+	std::iota(std::begin(sortedVertices), std::end(sortedVertices), 0);
+	std::sort(std::begin(sortedVertices), std::end(sortedVertices), positionLess);
+
+	std::vector<uint32_t> positionIds(verticesCount);
+	std::vector<bool> locked(verticesCount, false);
+	for (size_t i{ 0 }; i < verticesCount; ++i)
+	{
+		uint32_t vertex = sortedVertices[i];
+		positionIds[vertex] = vertex;
+		if (i > 0 && positions[sortedVertices[i - 1]] == positions[vertex])
+		{
+			positionIds[vertex] = positionIds[sortedVertices[i - 1]];
+			locked[vertex] = true;
+			locked[sortedVertices[i - 1]] = true;
+		}
+	}
+
+	// Edges which do not have exactly two triangles are borders or non-manifold
+	std::vector<std::pair<uint32_t, uint32_t>> edges;
+	edges.reserve(indices.size());
+	for (size_t i{ 0 }; i < indices.size(); i += 3)
+	{
+		for (uint32_t j{ 0 }; j < 3; ++j)
+		{
+			uint32_t v1 = positionIds[indices[i + j]];
+			uint32_t v2 = positionIds[indices[i + (j + 1) % 3]];
+			edges.emplace_back(std::min(v1, v2), std::max(v1, v2));
+		}
+	}
+	std::sort(std::begin(edges), std::end(edges));
+
+	std::vector<bool> lockedPositions(verticesCount, false);
+	for (size_t begin{ 0 }, end{ 0 }; begin < edges.size(); begin = end)
+	{
+		while (end < edges.size() && edges[end] == edges[begin])
+		{
+			++end;
+		}
+		if (end - begin != 2)
+		{
+			lockedPositions[edges[begin].first] = true;
+			lockedPositions[edges[begin].second] = true;
+		}
+	}
+	for (size_t vertex{ 0 }; vertex < verticesCount; ++vertex)
+	{
+		if (lockedPositions[positionIds[vertex]])
+		{
+			locked[vertex] = true;
+		}
+	}
+
+	std::vector<Quadric> quadrics(verticesCount);
+	for (size_t i{ 0 }; i < indices.size(); i += 3)
+	{
+		glm::vec3 p0 = positions[indices[i]];
+		glm::vec3 normal = glm::cross(positions[indices[i + 1]] - p0, positions[indices[i + 2]] - p0);
+		float length = glm::length(normal);
+		if (length == 0.0f)
+			continue;
+
+		normal /= length;
+		auto quadric = planeQuadric(normal, -glm::dot(normal, p0), length / 2.0f);
+		for (uint32_t j{ 0 }; j < 3; ++j)
+		{
+			quadrics[indices[i + j]] += quadric;
+		}
+	}
+
+	std::vector<uint32_t> currentIndices{ indices };
+	size_t targetTrianglesCount = targetIndicesCount / 3;
+	float maxCollapseError{ 0.0f };
+
+	std::vector<size_t> adjacencyOffsets(verticesCount + 1);
+	std::vector<uint32_t> adjacency;
+	std::vector<uint32_t> remap(verticesCount);
+	std::vector<bool> touched(verticesCount);
+	std::vector<Collapse> collapses;
+
+	// Every pass collapses cheapest edges which do not share neighbourhood, so they can be applied independently
+	while (currentIndices.size() > targetIndicesCount)
+	{
+		std::fill(std::begin(adjacencyOffsets), std::end(adjacencyOffsets), 0);
+		for (uint32_t index : currentIndices)
+		{
+			++adjacencyOffsets[index + 1];
+		}
+		std::partial_sum(std::begin(adjacencyOffsets), std::end(adjacencyOffsets), std::begin(adjacencyOffsets));
+		adjacency.resize(currentIndices.size());
+		std::vector<size_t> adjacencyFill(std::begin(adjacencyOffsets), std::end(adjacencyOffsets) - 1);
+		for (size_t i{ 0 }; i < currentIndices.size(); ++i)
+		{
+			adjacency[adjacencyFill[currentIndices[i]]++] = static_cast<uint32_t>(i / 3);
+		}
+
+		// Interior edge is stored in opposite order by its second triangle, so it is taken only once
+		collapses.clear();
+		for (size_t i{ 0 }; i < currentIndices.size(); i += 3)
+		{
+			for (uint32_t j{ 0 }; j < 3; ++j)
+			{
+				uint32_t v1 = currentIndices[i + j];
+				uint32_t v2 = currentIndices[i + (j + 1) % 3];
+				if (v1 > v2 || (locked[v1] && locked[v2]))
+					continue;
+
+				Quadric quadric = quadrics[v1];
+				quadric += quadrics[v2];
+				float error1 = locked[v1] ? std::numeric_limits<float>::max() : quadric.evaluate(positions[v2]);
+				float error2 = locked[v2] ? std::numeric_limits<float>::max() : quadric.evaluate(positions[v1]);
+				collapses.push_back(error1 <= error2 ? Collapse{ v1, v2, error1 } : Collapse{ v2, v1, error2 });
+			}
+		}
+		std::sort(std::begin(collapses), std::end(collapses), [](const Collapse& c1, const Collapse& c2) { return c1.error < c2.error; });
+
+		std::iota(std::begin(remap), std::end(remap), 0);
+		std::fill(std::begin(touched), std::end(touched), false);
+		size_t trianglesCount = currentIndices.size() / 3;
+		bool collapsed{ false };
+
+		for (const auto& collapse : collapses)
+		{
+			if (trianglesCount <= targetTrianglesCount)
+				break;
+			if (touched[collapse.from] || touched[collapse.to])
+				continue;
+
+			// Triangles around collapsed vertex are not changed in this pass yet, since their vertices are not touched
+			bool flipped{ false };
+			size_t removedTriangles{ 0 };
+			for (size_t i{ adjacencyOffsets[collapse.from] }; i < adjacencyOffsets[collapse.from + 1] && !flipped; ++i)
+			{
+				const uint32_t* triangle = &currentIndices[3 * static_cast<size_t>(adjacency[i])];
+				if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+				{
+					++removedTriangles;
+					continue;
+				}
+
+				std::array<glm::vec3, 3> before{ positions[triangle[0]], positions[triangle[1]], positions[triangle[2]] };
+				std::array<glm::vec3, 3> after{ before };
+				for (uint32_t j{ 0 }; j < 3; ++j)
+				{
+					if (triangle[j] == collapse.from)
+						after[j] = positions[collapse.to];
+				}
+
+				glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+				glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+				float lengths = glm::length(normalBefore) * glm::length(normalAfter);
+				flipped = lengths == 0.0f || glm::dot(normalBefore, normalAfter) < flipThreshold * lengths;
+			}
+			if (flipped)
+				continue;
+
+			for (size_t i{ adjacencyOffsets[collapse.from] }; i < adjacencyOffsets[collapse.from + 1]; ++i)
+			{
+				for (uint32_t j{ 0 }; j < 3; ++j)
+				{
+					touched[currentIndices[3 * static_cast<size_t>(adjacency[i]) + j]] = true;
+				}
+			}
+			touched[collapse.to] = true;
+
+			remap[collapse.from] = collapse.to;
+			quadrics[collapse.to] += quadrics[collapse.from];
+			trianglesCount -= removedTriangles;
+			maxCollapseError = std::max(maxCollapseError, collapse.error);
+			collapsed = true;
+		}
+
+		if (!collapsed)
+			break;
+
+		size_t simplifiedIndicesCount{ 0 };
+		for (size_t i{ 0 }; i < currentIndices.size(); i += 3)
+		{
+			uint32_t v0 = remap[currentIndices[i]];
+			uint32_t v1 = remap[currentIndices[i + 1]];
+			uint32_t v2 = remap[currentIndices[i + 2]];
+			if (v0 == v1 || v1 == v2 || v0 == v2)
+				continue;
+
+			currentIndices[simplifiedIndicesCount++] = v0;
+			currentIndices[simplifiedIndicesCount++] = v1;
+			currentIndices[simplifiedIndicesCount++] = v2;
+		}
+		currentIndices.resize(simplifiedIndicesCount);
+	}
+
+	glm::vec3 left{ positions[indices.front()] };
+	glm::vec3 right{ left };
+	for (uint32_t index : indices)
+	{
+		left = glm::min(left, positions[index]);
+		right = glm::max(right, positions[index]);
+	}
+	float diagonal = glm::length(right - left);
+
+	simplifiedMesh.indices = std::move(currentIndices);
+	simplifiedMesh.error = diagonal > 0.0f ? std::sqrt(maxCollapseError) / diagonal : 0.0f;
+	return simplifiedMesh;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <glm/vec3.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace GraphicEngine::Core::Math
+{
+	struct SimplifiedMesh
+	{
+		std::vector<uint32_t> indices;
+		// Largest root mean square distance of collapsed vertex from source triangles around it, relative to diagonal of bouding box
+		float error{ 0.0f };
+	};
+
+	// Quadric error metric edge collapse of triangle list until it has at most targetIndicesCount indices or nothing more can be collapsed.
+	// Vertices are collapsed onto existing ones, so source vertex buffer with its normals and UVs is shared by simplified mesh.
+	// Borders and seams (several vertices with same position) are locked and collapses flipping triangles are rejected
+	SimplifiedMesh simplifyMesh(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, size_t targetIndicesCount);
+}
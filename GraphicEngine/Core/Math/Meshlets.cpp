@@ -0,0 +1,304 @@
+#include "Meshlets.hpp"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+	// Cone wider than this (~84 degrees from axis) is not worth testing, almost no eye position is behind all triangles
+	constexpr float minConeDot{ 0.1f };
+
+	void calculateMeshletBounds(GraphicEngine::Core::Math::Meshlet& meshlet, const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices)
+	{
+		size_t begin = meshlet.firstIndex;
+		size_t end = begin + 3 * static_cast<size_t>(meshlet.trianglesCount);
+
+		glm::vec3 left{ std::numeric_limits<float>::max() };
+		glm::vec3 right{ std::numeric_limits<float>::lowest() };
+		for (size_t i{ begin }; i < end; ++i)
+		{
+			left = glm::min(left, positions[indices[i]]);
+			right = glm::max(right, positions[indices[i]]);
+		}
+		meshlet.center = (left + right) / 2.0f;
+		meshlet.radius = 0.0f;
+		for (size_t i{ begin }; i < end; ++i)
+		{
+			meshlet.radius = std::max(meshlet.radius, glm::length(positions[indices[i]] - meshlet.center));
+		}
+
+		// Point and normal of every not degenerated triangle
+		std::vector<std::pair<glm::vec3, glm::vec3>> planes;
+		planes.reserve(meshlet.trianglesCount);
+		glm::vec3 axis{ 0.0f };
+		for (size_t i{ begin }; i < end; i += 3)
+		{
+			glm::vec3 p0 = positions[indices[i]];
+			glm::vec3 normal = glm::cross(positions[indices[i + 1]] - p0, positions[indices[i + 2]] - p0);
+			float length = glm::length(normal);
+			if (length == 0.0f)
+				continue;
+
+			planes.emplace_back(p0, normal / length);
+			axis += planes.back().second;
+		}
+
+		float axisLength = glm::length(axis);
+		if (axisLength == 0.0f)
+			return;
+		axis /= axisLength;
+
+		float minDot{ 1.0f };
+		for (const auto& [point, normal] : planes)
+		{
+			minDot = std::min(minDot, glm::dot(axis, normal));
+		}
+		if (minDot <= minConeDot)
+			return;
+
+		// Apex is moved back along axis until it is behind planes of all triangles
+		float maxOffset{ 0.0f };
+		for (const auto& [point, normal] : planes)
+		{
+			maxOffset = std::max(maxOffset, glm::dot(meshlet.center - point, normal) / glm::dot(axis, normal));
+		}
+
+		meshlet.coneApex = meshlet.center - axis * maxOffset;
+		meshlet.coneAxis = axis;
+		meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+	}
+}
+
+GraphicEngine::Core::Math::MeshletClustering GraphicEngine::Core::Math::buildMeshlets(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, uint32_t maxVertices, uint32_t maxTriangles)
+{
+	if (indices.size() % 3 != 0)
+	{
+		throw std::invalid_argument("Indices do not form triangle list!");
+	}
+	if (maxVertices < 3 || maxTriangles < 1)
+	{
+		throw std::invalid_argument("Meshlet has to fit at least one triangle!");
+	}
+
+	size_t verticesCount = positions.size();
+	size_t trianglesCount = indices.size() / 3;
+
+	// Triangles of every vertex, stored one vertex after another
+	std::vector<size_t> adjacencyOffsets(verticesCount + 1, 0);
+	for (uint32_t index : indices)
+	{
+		if (index >= verticesCount)
+		{
+			throw std::out_of_range("Index is out of vertices range!");
+		}
+		++adjacencyOffsets[index + 1];
+	}
+	std::partial_sum(std::begin(adjacencyOffsets), std::end(adjacencyOffsets), std::begin(adjacencyOffsets));
+	std::vector<uint32_t> adjacency(indices.size());
+	std::vector<size_t> adjacencyFill(std::begin(adjacencyOffsets), std::end(adjacencyOffsets) - 1);
+	for (size_t i{ 0 }; i < indices.size(); ++i)
+	{
+		adjacency[adjacencyFill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+	}
+
+	MeshletClustering clustering;
+	clustering.triangleOrder.reserve(trianglesCount);
+
+	// Vertex belongs to current meshlet when it is marked with its number
+	std::vector<uint32_t> meshletOfVertex(verticesCount, std::numeric_limits<uint32_t>::max());
+	std::vector<bool> emitted(trianglesCount, false);
+	std::vector<uint32_t> meshletVertices;
+	std::vector<uint32_t> previousMeshletVertices;
+	Meshlet meshlet;
+	glm::vec3 centroidsSum{ 0.0f };
+	size_t nextNotEmitted{ 0 };
+
+	auto centroid = [&](uint32_t triangle)
+	{
+		return (positions[indices[3 * static_cast<size_t>(triangle)]] + positions[indices[3 * static_cast<size_t>(triangle) + 1]] + positions[indices[3 * static_cast<size_t>(triangle) + 2]]) / 3.0f;
+	};
+
+	auto countNewVertices = [&](uint32_t triangle)
+	{
+		size_t first = 3 * static_cast<size_t>(triangle);
+		uint32_t newVertices{ 0 };
+		for (size_t j{ 0 }; j < 3; ++j)
+		{
+			uint32_t index = indices[first + j];
+			bool repeated = std::find(std::begin(indices) + first, std::begin(indices) + first + j, index) != std::begin(indices) + first + j;
+			if (!repeated && meshletOfVertex[index] != clustering.meshlets.size())
+				++newVertices;
+		}
+		return newVertices;
+	};
+
+	while (clustering.triangleOrder.size() < trianglesCount)
+	{
+		// Neighbour adding fewest vertices, closer one to center of meshlet on tie
+		int64_t bestTriangle{ -1 };
+		uint32_t bestNewVertices{ 0 };
+		float bestDistance{ 0.0f };
+		if (meshlet.trianglesCount < maxTriangles)
+		{
+			glm::vec3 center = meshlet.trianglesCount > 0 ? centroidsSum / static_cast<float>(meshlet.trianglesCount) : glm::vec3(0.0f);
+			for (uint32_t vertex : meshletVertices)
+			{
+				for (size_t i{ adjacencyOffsets[vertex] }; i < adjacencyOffsets[vertex + 1]; ++i)
+				{
+					uint32_t triangle = adjacency[i];
+					if (emitted[triangle])
+						continue;
+
+					uint32_t newVertices = countNewVertices(triangle);
+					if (meshlet.verticesCount + newVertices > maxVertices)
+						continue;
+
+					glm::vec3 offset = centroid(triangle) - center;
+					float distance = glm::dot(offset, offset);
+					if (bestTriangle < 0 || newVertices < bestNewVertices || (newVertices == bestNewVertices && distance < bestDistance))
+					{
+						bestTriangle = triangle;
+						bestNewVertices = newVertices;
+						bestDistance = distance;
+					}
+				}
+			}
+		}
+
+		if (bestTriangle < 0)
+		{
+			if (meshlet.trianglesCount > 0)
+			{
+				clustering.meshlets.push_back(meshlet);
+				meshlet = Meshlet{};
+				meshlet.firstIndex = static_cast<uint32_t>(3 * clustering.triangleOrder.size());
+				centroidsSum = glm::vec3(0.0f);
+				std::swap(previousMeshletVertices, meshletVertices);
+				meshletVertices.clear();
+			}
+
+			// Next meshlet starts next to previous one when possible, otherwise at first not emitted triangle
+			for (uint32_t vertex : previousMeshletVertices)
+			{
+				for (size_t i{ adjacencyOffsets[vertex] }; i < adjacencyOffsets[vertex + 1] && bestTriangle < 0; ++i)
+				{
+					if (!emitted[adjacency[i]])
+						bestTriangle = adjacency[i];
+				}
+			}
+			if (bestTriangle < 0)
+			{
+				while (emitted[nextNotEmitted])
+				{
+					++nextNotEmitted;
+				}
+				bestTriangle = static_cast<int64_t>(nextNotEmitted);
+			}
+			bestNewVertices = countNewVertices(static_cast<uint32_t>(bestTriangle));
+		}
+
+		auto triangle = static_cast<uint32_t>(bestTriangle);
+		emitted[triangle] = true;
+		clustering.triangleOrder.push_back(triangle);
+		for (size_t j{ 0 }; j < 3; ++j)
+		{
+			uint32_t vertex = indices[3 * static_cast<size_t>(triangle) + j];
+			if (meshletOfVertex[vertex] != clustering.meshlets.size())
+			{
+				meshletOfVertex[vertex] = static_cast<uint32_t>(clustering.meshlets.size());
+				meshletVertices.push_back(vertex);
+			}
+		}
+		meshlet.verticesCount += bestNewVertices;
+		++meshlet.trianglesCount;
+		centroidsSum += centroid(triangle);
+	}
+
+	if (meshlet.trianglesCount > 0)
+	{
+		clustering.meshlets.push_back(meshlet);
+	}
+
+	auto meshletIndices = reorderTriangles(indices, clustering.triangleOrder);
+	for (auto& m : clustering.meshlets)
+	{
+		calculateMeshletBounds(m, positions, meshletIndices);
+	}
+
+	return clustering;
+}
+
+std::vector<uint32_t> GraphicEngine::Core::Math::reorderTriangles(const std::vector<uint32_t>& indices, const std::vector<uint32_t>& triangleOrder)
+{
+	std::vector<uint32_t> reorderedIndices;
+	reorderedIndices.reserve(3 * triangleOrder.size());
+	for (uint32_t triangle : triangleOrder)
+	{
+		reorderedIndices.push_back(indices.at(3 * static_cast<size_t>(triangle)));
+		reorderedIndices.push_back(indices.at(3 * static_cast<size_t>(triangle) + 1));
+		reorderedIndices.push_back(indices.at(3 * static_cast<size_t>(triangle) + 2));
+	}
+	return reorderedIndices;
+}
+
+std::array<glm::vec4, 6> GraphicEngine::Core::Math::calculateFrustumPlanes(const glm::mat4& viewProjection)
+{
+	glm::mat4 m = glm::transpose(viewProjection);
+	std::array<glm::vec4, 6> planes{ m[3] + m[0], m[3] - m[0], m[3] + m[1], m[3] - m[1], m[3] + m[2], m[3] - m[2] };
+	for (auto& plane : planes)
+	{
+		plane /= glm::length(glm::vec3(plane));
+	}
+	return planes;
+}
+
+bool GraphicEngine::Core::Math::isMeshletBackFacing(const Meshlet& meshlet, glm::vec3 eyePosition)
+{
+	glm::vec3 direction = meshlet.coneApex - eyePosition;
+	float length = glm::length(direction);
+	if (meshlet.coneCutoff >= 1.0f || length == 0.0f)
+		return false;
+
+	return glm::dot(direction, meshlet.coneAxis) >= meshlet.coneCutoff * length;
+}
+
+bool GraphicEngine::Core::Math::isMeshletOutsideFrustum(const Meshlet& meshlet, const std::array<glm::vec4, 6>& frustumPlanes)
+{
+	for (const auto& plane : frustumPlanes)
+	{
+		if (glm::dot(glm::vec3(plane), meshlet.center) + plane.w < -meshlet.radius)
+			return true;
+	}
+	return false;
+}
+
+void GraphicEngine::Core::Math::cullMeshlets(const std::vector<Meshlet>& meshlets, const glm::mat4& modelViewProjection, glm::vec3 eyePosition, std::vector<Common::DrawElementsCommand>& commands)
+{
+	auto frustumPlanes = calculateFrustumPlanes(modelViewProjection);
+	size_t firstCommand = commands.size();
+
+	for (const auto& meshlet : meshlets)
+	{
+		if (isMeshletOutsideFrustum(meshlet, frustumPlanes) || isMeshletBackFacing(meshlet, eyePosition))
+			continue;
+
+		uint32_t indexCount = 3 * meshlet.trianglesCount;
+		if (commands.size() > firstCommand && commands.back().firstIndex + commands.back().indexCount == meshlet.firstIndex)
+		{
+			commands.back().indexCount += indexCount;
+			continue;
+		}
+
+		Common::DrawElementsCommand command;
+		command.indexCount = indexCount;
+		command.firstIndex = meshlet.firstIndex;
+		commands.push_back(command);
+	}
+}
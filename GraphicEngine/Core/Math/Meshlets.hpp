@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../../Common/DrawElementsCommand.hpp"
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace GraphicEngine::Core::Math
+{
+	// Contiguous range of triangle list with bounds used for culling whole cluster
+	struct Meshlet
+	{
+		uint32_t firstIndex{ 0 };
+		uint32_t trianglesCount{ 0 };
+		uint32_t verticesCount{ 0 };
+
+		glm::vec3 center{ 0.0f };
+		float radius{ 0.0f };
+
+		// All triangles face away from eye when dot(normalize(coneApex - eye), coneAxis) >= coneCutoff, cutoff 1 never culls
+		glm::vec3 coneApex{ 0.0f };
+		glm::vec3 coneAxis{ 0.0f };
+		float coneCutoff{ 1.0f };
+	};
+
+	struct MeshletClustering
+	{
+		std::vector<Meshlet> meshlets;
+		// Source triangles meshlet after meshlet, firstIndex of meshlet points to triangle list reordered this way
+		std::vector<uint32_t> triangleOrder;
+	};
+
+	// Meshlets are grown over neighbouring triangles which add fewest new vertices, so they are compact patches with narrow normal cones
+	MeshletClustering buildMeshlets(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, uint32_t maxVertices = 64, uint32_t maxTriangles = 124);
+
+	std::vector<uint32_t> reorderTriangles(const std::vector<uint32_t>& indices, const std::vector<uint32_t>& triangleOrder);
+
+	// Frustum planes of view projection matrix (Gribb, Hartmann), normalized so sphere can be tested against them
+	std::array<glm::vec4, 6> calculateFrustumPlanes(const glm::mat4& viewProjection);
+
+	bool isMeshletBackFacing(const Meshlet& meshlet, glm::vec3 eyePosition);
+
+	bool isMeshletOutsideFrustum(const Meshlet& meshlet, const std::array<glm::vec4, 6>& frustumPlanes);
+
+	// Appends visible meshlets to draw list, neighbouring meshlets are merged into one command.
+	// Matrix and eye are in space of meshlets, so model matrix has to be applied to them first
+	void cullMeshlets(const std::vector<Meshlet>& meshlets, const glm::mat4& modelViewProjection, glm::vec3 eyePosition, std::vector<Common::DrawElementsCommand>& commands);
+}
@@ -0,0 +1,199 @@
+#include "VertexCacheOptimizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+	// Parameters from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"
+	constexpr uint32_t optimizedCacheSize{ 32 };
+	constexpr float cacheDecayPower{ 1.5f };
+	constexpr float lastTriangleScore{ 0.75f };
+	constexpr float valenceBoostScale{ 2.0f };
+	constexpr float valenceBoostPower{ 0.5f };
+
+	float calculateVertexScore(int32_t cachePosition, uint32_t activeTriangles)
+	{
+		if (activeTriangles == 0)
+			return -1.0f;
+
+		float score{ 0.0f };
+		if (cachePosition >= 0)
+		{
+			// Vertices of last triangle get fixed score, so it is not preferred to use them again straight away
+			score = cachePosition < 3 ? lastTriangleScore : std::pow(1.0f - (cachePosition - 3) / static_cast<float>(optimizedCacheSize - 3), cacheDecayPower);
+		}
+
+		// Vertices with few triangles left are preferred to get rid of them quickly
+		return score + valenceBoostScale * std::pow(static_cast<float>(activeTriangles), -valenceBoostPower);
+	}
+}
+
+float GraphicEngine::Core::Math::calculateACMR(const std::vector<uint32_t>& indices, size_t verticesCount, uint32_t cacheSize)
+{
+	if (indices.size() < 3)
+		return 0.0f;
+
+	// Vertex is in FIFO cache when less than cacheSize misses happened since it was inserted
+	std::vector<int64_t> insertedAt(verticesCount, -static_cast<int64_t>(cacheSize) - 1);
+	int64_t misses{ 0 };
+	for (uint32_t index : indices)
+	{
+		if (misses - insertedAt.at(index) >= static_cast<int64_t>(cacheSize))
+		{
+			insertedAt[index] = misses;
+			++misses;
+		}
+	}
+
+	return static_cast<float>(misses) / (indices.size() / 3);
+}
+
+std::vector<uint32_t> GraphicEngine::Core::Math::calculateVertexCacheOrder(const std::vector<uint32_t>& indices, size_t verticesCount)
+{
+	if (indices.size() % 3 != 0)
+	{
+		throw std::invalid_argument("Indices do not form triangle list!");
+	}
+
+	size_t trianglesCount = indices.size() / 3;
+
+	// Not emitted triangles of every vertex, stored one vertex after another
+	std::vector<uint32_t> activeTriangles(verticesCount, 0);
+	for (uint32_t index : indices)
+	{
+		if (index >= verticesCount)
+		{
+			throw std::out_of_range("Index is out of vertices range!");
+		}
+		++activeTriangles[index];
+	}
+
+	std::vector<size_t> adjacencyOffsets(verticesCount + 1, 0);
+	for (size_t vertex{ 0 }; vertex < verticesCount; ++vertex)
+	{
+		adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + activeTriangles[vertex];
+	}
+
+	std::vector<uint32_t> adjacency(indices.size());
+	std::vector<size_t> adjacencyFill(std::begin(adjacencyOffsets), std::end(adjacencyOffsets) - 1);
+	for (size_t i{ 0 }; i < indices.size(); ++i)
+	{
+		adjacency[adjacencyFill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+	}
+
+	std::vector<int32_t> cachePositions(verticesCount, -1);
+	std::vector<float> vertexScores(verticesCount);
+	for (size_t vertex{ 0 }; vertex < verticesCount; ++vertex)
+	{
+		vertexScores[vertex] = calculateVertexScore(-1, activeTriangles[vertex]);
+	}
+
+	// Scores of triangles are only needed to pick first one, later candidates are scored when they touch cache
+	std::vector<float> triangleScores(trianglesCount);
+	for (size_t triangle{ 0 }; triangle < trianglesCount; ++triangle)
+	{
+		triangleScores[triangle] = vertexScores[indices[3 * triangle]] + vertexScores[indices[3 * triangle + 1]] + vertexScores[indices[3 * triangle + 2]];
+	}
+	std::vector<bool> emitted(trianglesCount, false);
+
+	// Modelled as LRU, with room for vertices of new triangle before old ones are dropped
+	std::vector<uint32_t> cache;
+	std::vector<uint32_t> newCache;
+	cache.reserve(optimizedCacheSize + 3);
+	newCache.reserve(optimizedCacheSize + 3);
+
+	std::vector<uint32_t> order;
+	order.reserve(trianglesCount);
+
+	int64_t bestTriangle = trianglesCount == 0 ? -1 : std::distance(std::begin(triangleScores), std::max_element(std::begin(triangleScores), std::end(triangleScores)));
+	size_t nextNotEmitted{ 0 };
+
+	while (order.size() < trianglesCount)
+	{
+		if (bestTriangle < 0)
+		{
+			// Cache does not touch any remaining triangle, continue with next one in original order
+			while (emitted[nextNotEmitted])
+			{
+				++nextNotEmitted;
+			}
+			bestTriangle = static_cast<int64_t>(nextNotEmitted);
+		}
+
+		auto triangle = static_cast<uint32_t>(bestTriangle);
+		emitted[triangle] = true;
+		order.push_back(triangle);
+
+		newCache.clear();
+		for (uint32_t i{ 0 }; i < 3; ++i)
+		{
+			uint32_t vertex = indices[3 * triangle + i];
+			if (std::find(std::begin(newCache), std::end(newCache), vertex) == std::end(newCache))
+			{
+				newCache.push_back(vertex);
+			}
+
+			auto begin = std::begin(adjacency) + adjacencyOffsets[vertex];
+			auto end = begin + activeTriangles[vertex];
+			std::iter_swap(std::find(begin, end, triangle), end - 1);
+			--activeTriangles[vertex];
+		}
+		for (uint32_t vertex : cache)
+		{
+			if (std::find(std::begin(newCache), std::end(newCache), vertex) == std::end(newCache))
+			{
+				newCache.push_back(vertex);
+			}
+		}
+		std::swap(cache, newCache);
+
+		// Positions past cache size mean vertex was evicted, its score still has to be updated
+		for (size_t position{ 0 }; position < cache.size(); ++position)
+		{
+			uint32_t vertex = cache[position];
+			cachePositions[vertex] = position < optimizedCacheSize ? static_cast<int32_t>(position) : -1;
+			vertexScores[vertex] = calculateVertexScore(cachePositions[vertex], activeTriangles[vertex]);
+		}
+
+		bestTriangle = -1;
+		float bestScore{ -1.0f };
+		for (size_t position{ 0 }; position < std::min<size_t>(cache.size(), optimizedCacheSize); ++position)
+		{
+			uint32_t vertex = cache[position];
+			for (size_t i{ adjacencyOffsets[vertex] }; i < adjacencyOffsets[vertex] + activeTriangles[vertex]; ++i)
+			{
+				uint32_t adjacentTriangle = adjacency[i];
+				float score = vertexScores[indices[3 * adjacentTriangle]] + vertexScores[indices[3 * adjacentTriangle + 1]] + vertexScores[indices[3 * adjacentTriangle + 2]];
+				if (score > bestScore)
+				{
+					bestScore = score;
+					bestTriangle = adjacentTriangle;
+				}
+			}
+		}
+
+		if (cache.size() > optimizedCacheSize)
+		{
+			cache.resize(optimizedCacheSize);
+		}
+	}
+
+	return order;
+}
+
+std::vector<uint32_t> GraphicEngine::Core::Math::optimizeVertexCache(const std::vector<uint32_t>& indices, size_t verticesCount)
+{
+	auto order = calculateVertexCacheOrder(indices, verticesCount);
+
+	std::vector<uint32_t> optimizedIndices;
+	optimizedIndices.reserve(indices.size());
+	for (uint32_t triangle : order)
+	{
+		optimizedIndices.push_back(indices[3 * triangle]);
+		optimizedIndices.push_back(indices[3 * triangle + 1]);
+		optimizedIndices.push_back(indices[3 * triangle + 2]);
+	}
+	return optimizedIndices;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace GraphicEngine::Core::Math
+{
+	struct VertexCacheStatistics
+	{
+		float acmrBefore{ 0.0f };
+		float acmrAfter{ 0.0f };
+	};
+
+	// Average cache miss ratio, transformed vertices per triangle for FIFO post-transform cache (0.5 - 3.0, lower is better)
+	float calculateACMR(const std::vector<uint32_t>& indices, size_t verticesCount, uint32_t cacheSize = 32);
+
+	// Order of triangles of triangle list after Tom Forsyth's linear-speed vertex cache optimization, winding is preserved
+	std::vector<uint32_t> calculateVertexCacheOrder(const std::vector<uint32_t>& indices, size_t verticesCount);
+
+	std::vector<uint32_t> optimizeVertexCache(const std::vector<uint32_t>& indices, size_t verticesCount);
+}
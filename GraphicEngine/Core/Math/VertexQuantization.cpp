@@ -0,0 +1,55 @@
+#include "VertexQuantization.hpp"
+
+#include <glm/common.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+
+GraphicEngine::Core::Math::PositionQuantization GraphicEngine::Core::Math::calculatePositionQuantization(glm::vec3 minPosition, glm::vec3 maxPosition)
+{
+	PositionQuantization quantization;
+	quantization.origin = minPosition;
+	glm::vec3 size = maxPosition - minPosition;
+	float extent = std::max({ size.x, size.y, size.z });
+	if (extent > 0.0f)
+	{
+		quantization.extent = extent;
+	}
+	return quantization;
+}
+
+glm::u16vec4 GraphicEngine::Core::Math::quantizePosition(glm::vec3 position, const PositionQuantization& quantization)
+{
+	return glm::packUnorm<uint16_t>(glm::vec4((position - quantization.origin) / quantization.extent, 0.0f));
+}
+
+glm::vec3 GraphicEngine::Core::Math::dequantizePosition(glm::u16vec4 position, const PositionQuantization& quantization)
+{
+	return quantization.origin + glm::vec3(glm::unpackUnorm<float>(position)) * quantization.extent;
+}
+
+glm::mat4 GraphicEngine::Core::Math::getDequantizationMatrix(const PositionQuantization& quantization)
+{
+	return glm::scale(glm::translate(glm::mat4(1.0f), quantization.origin), glm::vec3(quantization.extent));
+}
+
+glm::i16vec4 GraphicEngine::Core::Math::quantizeNormal(glm::vec3 normal)
+{
+	return glm::packSnorm<int16_t>(glm::vec4(normal, 0.0f));
+}
+
+glm::vec3 GraphicEngine::Core::Math::dequantizeNormal(glm::i16vec4 normal)
+{
+	return glm::vec3(glm::unpackSnorm<float>(normal));
+}
+
+glm::u16vec2 GraphicEngine::Core::Math::quantizeTexCoord(glm::vec2 texCoord)
+{
+	return glm::packHalf(texCoord);
+}
+
+glm::vec2 GraphicEngine::Core::Math::dequantizeTexCoord(glm::u16vec2 texCoord)
+{
+	return glm::unpackHalf(texCoord);
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <cstdint>
+
+namespace GraphicEngine::Core::Math
+{
+	// Cube around bouding box of mesh, positions are stored as 16 bit unorm inside of it.
+	// Scale is same for all axes, so normals do not have to be corrected by dequantization
+	struct PositionQuantization
+	{
+		glm::vec3 origin{ 0.0f };
+		float extent{ 1.0f };
+	};
+
+	PositionQuantization calculatePositionQuantization(glm::vec3 minPosition, glm::vec3 maxPosition);
+
+	// xyz as 16 bit unorm, w is zero
+	glm::u16vec4 quantizePosition(glm::vec3 position, const PositionQuantization& quantization);
+
+	glm::vec3 dequantizePosition(glm::u16vec4 position, const PositionQuantization& quantization);
+
+	// Maps positions read by shader in [0, 1] back to space of mesh, it is applied before model matrix
+	glm::mat4 getDequantizationMatrix(const PositionQuantization& quantization);
+
+	// xyz as 16 bit snorm, w is zero
+	glm::i16vec4 quantizeNormal(glm::vec3 normal);
+
+	glm::vec3 dequantizeNormal(glm::i16vec4 normal);
+
+	// Half floats
+	glm::u16vec2 quantizeTexCoord(glm::vec2 texCoord);
+
+	glm::vec2 dequantizeTexCoord(glm::u16vec2 texCoord);
+}
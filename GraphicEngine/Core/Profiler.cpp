@@ -0,0 +1,268 @@
+#include "Profiler.hpp"
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+
+#undef min
+#undef max
+
+GraphicEngine::Core::Profiler::Profiler() :
+	m_startTime{ Clock::now() },
+	m_frameStart{ m_startTime }
+{
+}
+
+void GraphicEngine::Core::Profiler::beginFrame()
+{
+	m_frameStart = Clock::now();
+	m_frameStarted = true;
+	m_frameEvents.clear();
+}
+
+void GraphicEngine::Core::Profiler::endFrame()
+{
+	if (!m_frameStarted)
+		return;
+
+	auto frameEnd = Clock::now();
+	m_frameEvents.push_back(TraceEvent{ "Frame", false, toMicroseconds(m_frameStart), std::chrono::duration<double, std::micro>(frameEnd - m_frameStart).count() });
+	getZone("Frame", false).frameTotal = std::chrono::duration<double, std::milli>(frameEnd - m_frameStart).count();
+	getZone("Frame", false).recorded = true;
+
+	addCounter("Draw calls", static_cast<double>(frameCounters.drawCalls.exchange(0)));
+	addCounter("Uploaded bytes", static_cast<double>(frameCounters.uploadedBytes.exchange(0)));
+
+	pushFrameSamples(m_zones);
+	pushFrameSamples(m_counters);
+
+	// GPU timings have no absolute timestamps, so they are laid out one after another from frame start on separate track
+	double gpuCursor = toMicroseconds(m_frameStart);
+	for (auto& event : m_frameEvents)
+	{
+		if (event.gpu && !event.counter)
+		{
+			event.start = gpuCursor;
+			gpuCursor += event.duration;
+		}
+	}
+
+	if (m_traceFrames.size() < framesWindow)
+	{
+		m_traceFrames.push_back(std::move(m_frameEvents));
+	}
+	else
+	{
+		m_traceFrames[m_nextTraceFrame] = std::move(m_frameEvents);
+	}
+	m_nextTraceFrame = (m_nextTraceFrame + 1) % framesWindow;
+	m_frameEvents.clear();
+
+	m_frameStarted = false;
+	++m_framesCount;
+}
+
+void GraphicEngine::Core::Profiler::beginZone(const std::string& name)
+{
+	m_openZones.push_back(OpenZone{ name, Clock::now() });
+}
+
+void GraphicEngine::Core::Profiler::endZone()
+{
+	if (m_openZones.empty())
+	{
+		throw std::runtime_error("Profiler zone ended without being started!");
+	}
+
+	auto end = Clock::now();
+	auto& openZone = m_openZones.back();
+
+	auto& zone = getZone(openZone.name, false);
+	zone.frameTotal += std::chrono::duration<double, std::milli>(end - openZone.start).count();
+	zone.recorded = true;
+
+	m_frameEvents.push_back(TraceEvent{ openZone.name, false, toMicroseconds(openZone.start), std::chrono::duration<double, std::micro>(end - openZone.start).count() });
+	m_openZones.pop_back();
+}
+
+void GraphicEngine::Core::Profiler::addGpuZone(const std::string& name, double milliseconds)
+{
+	auto& zone = getZone(name, true);
+	zone.frameTotal += milliseconds;
+	zone.recorded = true;
+
+	m_frameEvents.push_back(TraceEvent{ name, true, 0.0, milliseconds * 1000.0 });
+}
+
+void GraphicEngine::Core::Profiler::addCounter(const std::string& name, double value)
+{
+	auto& counter = getCounter(name);
+	counter.frameTotal += value;
+	counter.recorded = true;
+
+	m_frameEvents.push_back(TraceEvent{ name, false, toMicroseconds(m_frameStart), value, true });
+}
+
+std::vector<GraphicEngine::Core::ProfilerZoneStatistics> GraphicEngine::Core::Profiler::getStatistics() const
+{
+	return calculateStatistics(m_zones);
+}
+
+std::vector<GraphicEngine::Core::ProfilerZoneStatistics> GraphicEngine::Core::Profiler::getCounterStatistics() const
+{
+	return calculateStatistics(m_counters);
+}
+
+uint64_t GraphicEngine::Core::Profiler::getFramesCount() const
+{
+	return m_framesCount;
+}
+
+void GraphicEngine::Core::Profiler::reset()
+{
+	for (auto& zone : m_zones)
+	{
+		zone.samples.clear();
+		zone.nextSample = 0;
+	}
+	for (auto& counter : m_counters)
+	{
+		counter.samples.clear();
+		counter.nextSample = 0;
+	}
+	m_traceFrames.clear();
+	m_nextTraceFrame = 0;
+	m_framesCount = 0;
+}
+
+void GraphicEngine::Core::Profiler::writeChromeTrace(std::ostream& stream) const
+{
+	nlohmann::json events = nlohmann::json::array();
+	events.push_back({ { "name", "thread_name" }, { "ph", "M" }, { "pid", 0 }, { "tid", 0 }, { "args", { { "name", "CPU" } } } });
+	events.push_back({ { "name", "thread_name" }, { "ph", "M" }, { "pid", 0 }, { "tid", 1 }, { "args", { { "name", "GPU" } } } });
+
+	// Oldest frame first
+	for (size_t i{ 0 }; i < m_traceFrames.size(); ++i)
+	{
+		size_t frame = m_traceFrames.size() < framesWindow ? i : (m_nextTraceFrame + i) % framesWindow;
+		for (const auto& event : m_traceFrames[frame])
+		{
+			if (event.counter)
+			{
+				events.push_back({
+					{ "name", event.name },
+					{ "ph", "C" },
+					{ "ts", event.start },
+					{ "pid", 0 },
+					{ "args", { { "value", event.duration } } } });
+				continue;
+			}
+
+			events.push_back({
+				{ "name", event.name },
+				{ "cat", event.gpu ? "gpu" : "cpu" },
+				{ "ph", "X" },
+				{ "ts", event.start },
+				{ "dur", event.duration },
+				{ "pid", 0 },
+				{ "tid", event.gpu ? 1 : 0 } });
+		}
+	}
+
+	stream << nlohmann::json{ { "traceEvents", events }, { "displayTimeUnit", "ms" } }.dump();
+}
+
+void GraphicEngine::Core::Profiler::saveChromeTrace(const std::string& path) const
+{
+	std::ofstream file(path);
+	if (!file.is_open())
+	{
+		throw std::runtime_error("Could not open file " + path + " for writing!");
+	}
+	writeChromeTrace(file);
+}
+
+double GraphicEngine::Core::Profiler::percentile(std::vector<double> samples, double p)
+{
+	if (samples.empty())
+		return 0.0;
+
+	// Nearest rank
+	size_t rank = static_cast<size_t>(std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * samples.size()));
+	size_t index = rank == 0 ? 0 : rank - 1;
+	std::nth_element(std::begin(samples), std::begin(samples) + index, std::end(samples));
+	return samples[index];
+}
+
+GraphicEngine::Core::Profiler::ZoneHistory& GraphicEngine::Core::Profiler::getZone(const std::string& name, bool gpu)
+{
+	auto key = std::make_pair(name, gpu);
+	auto it = m_zonesIndices.find(key);
+	if (it != std::end(m_zonesIndices))
+		return m_zones[it->second];
+
+	m_zonesIndices[key] = m_zones.size();
+	m_zones.push_back(ZoneHistory{ name, gpu });
+	m_zones.back().samples.reserve(framesWindow);
+	return m_zones.back();
+}
+
+GraphicEngine::Core::Profiler::ZoneHistory& GraphicEngine::Core::Profiler::getCounter(const std::string& name)
+{
+	auto it = m_countersIndices.find(name);
+	if (it != std::end(m_countersIndices))
+		return m_counters[it->second];
+
+	m_countersIndices[name] = m_counters.size();
+	m_counters.push_back(ZoneHistory{ name, false });
+	m_counters.back().samples.reserve(framesWindow);
+	return m_counters.back();
+}
+
+double GraphicEngine::Core::Profiler::toMicroseconds(Clock::time_point timePoint) const
+{
+	return std::chrono::duration<double, std::micro>(timePoint - m_startTime).count();
+}
+
+void GraphicEngine::Core::Profiler::pushFrameSamples(std::vector<ZoneHistory>& zones)
+{
+	for (auto& zone : zones)
+	{
+		if (!zone.recorded)
+			continue;
+
+		if (zone.samples.size() < framesWindow)
+		{
+			zone.samples.push_back(zone.frameTotal);
+		}
+		else
+		{
+			zone.samples[zone.nextSample] = zone.frameTotal;
+		}
+		zone.nextSample = (zone.nextSample + 1) % framesWindow;
+		zone.frameTotal = 0.0;
+		zone.recorded = false;
+	}
+}
+
+std::vector<GraphicEngine::Core::ProfilerZoneStatistics> GraphicEngine::Core::Profiler::calculateStatistics(const std::vector<ZoneHistory>& zones)
+{
+	std::vector<ProfilerZoneStatistics> statistics;
+	statistics.reserve(zones.size());
+
+	for (const auto& zone : zones)
+	{
+		if (zone.samples.empty())
+			continue;
+
+		uint32_t lastSample = (zone.nextSample + framesWindow - 1) % framesWindow;
+		double average = std::accumulate(std::begin(zone.samples), std::end(zone.samples), 0.0) / zone.samples.size();
+		statistics.push_back(ProfilerZoneStatistics{ zone.name, zone.gpu, zone.samples[lastSample], average,
+			percentile(zone.samples, 50.0), percentile(zone.samples, 95.0), percentile(zone.samples, 99.0) });
+	}
+
+	return statistics;
+}
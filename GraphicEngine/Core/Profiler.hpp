@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Instrumentation is compiled in only when GRAPHIC_ENGINE_PROFILER is defined, otherwise macros expand to nothing
+#define PROFILER_CONCAT_IMPL(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_IMPL(a, b)
+
+#ifdef GRAPHIC_ENGINE_PROFILER
+#define PROFILE_BEGIN_FRAME(profiler) (profiler)->beginFrame()
+#define PROFILE_END_FRAME(profiler) (profiler)->endFrame()
+#define PROFILE_CPU_ZONE(profiler, name) GraphicEngine::Core::Profiler::ScopedZone PROFILER_CONCAT(profilerZone, __LINE__)(*(profiler), name)
+#define PROFILE_DRAW_CALLS(count) GraphicEngine::Core::Profiler::frameCounters.drawCalls += (count)
+#define PROFILE_UPLOADED_BYTES(bytes) GraphicEngine::Core::Profiler::frameCounters.uploadedBytes += (bytes)
+#else
+#define PROFILE_BEGIN_FRAME(profiler)
+#define PROFILE_END_FRAME(profiler)
+#define PROFILE_CPU_ZONE(profiler, name)
+#define PROFILE_DRAW_CALLS(count)
+#define PROFILE_UPLOADED_BYTES(bytes)
+#endif
+
+namespace GraphicEngine::Core
+{
+	struct ProfilerZoneStatistics
+	{
+		std::string name;
+		bool gpu;
+		// Milliseconds, percentiles are computed over rolling window of frames in which zone was recorded
+		double last;
+		double average;
+		double p50;
+		double p95;
+		double p99;
+	};
+
+	struct ProfilerFrameCounters
+	{
+		std::atomic<uint64_t> drawCalls{ 0 };
+		std::atomic<uint64_t> uploadedBytes{ 0 };
+	};
+
+	// Collects CPU zones and GPU pass timings per frame, keeps rolling window of samples and trace of recent frames.
+	// Zones recorded several times during one frame are summed, GPU timings are reported by driver specific timers few frames late.
+	// Counters are summed per frame the same way, draw calls and uploaded bytes are counted by drivers without access to profiler.
+	class Profiler
+	{
+	public:
+		static inline ProfilerFrameCounters frameCounters;
+
+		class ScopedZone
+		{
+		public:
+			ScopedZone(Profiler& profiler, const std::string& name) :
+				m_profiler{ profiler }
+			{
+				m_profiler.beginZone(name);
+			}
+
+			~ScopedZone()
+			{
+				m_profiler.endZone();
+			}
+
+			ScopedZone(const ScopedZone&) = delete;
+			ScopedZone& operator=(const ScopedZone&) = delete;
+
+		private:
+			Profiler& m_profiler;
+		};
+
+		static constexpr uint32_t framesWindow{ 240 };
+
+		Profiler();
+
+		void beginFrame();
+		void endFrame();
+
+		void beginZone(const std::string& name);
+		void endZone();
+		void addGpuZone(const std::string& name, double milliseconds);
+		void addCounter(const std::string& name, double value);
+
+		std::vector<ProfilerZoneStatistics> getStatistics() const;
+		// Counters statistics are in counter units instead of milliseconds
+		std::vector<ProfilerZoneStatistics> getCounterStatistics() const;
+		uint64_t getFramesCount() const;
+
+		// Drops collected samples and trace, used to measure separate runs
+		void reset();
+
+		// Chrome trace event format, can be opened in chrome://tracing or Perfetto
+		void writeChromeTrace(std::ostream& stream) const;
+		void saveChromeTrace(const std::string& path) const;
+
+		static double percentile(std::vector<double> samples, double p);
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		struct ZoneHistory
+		{
+			std::string name;
+			bool gpu;
+			std::vector<double> samples;
+			uint32_t nextSample{ 0 };
+			double frameTotal{ 0.0 };
+			bool recorded{ false };
+		};
+
+		struct TraceEvent
+		{
+			std::string name;
+			bool gpu;
+			double start;
+			double duration;
+			bool counter{ false };
+		};
+
+		struct OpenZone
+		{
+			std::string name;
+			Clock::time_point start;
+		};
+
+		ZoneHistory& getZone(const std::string& name, bool gpu);
+		ZoneHistory& getCounter(const std::string& name);
+		double toMicroseconds(Clock::time_point timePoint) const;
+
+		static void pushFrameSamples(std::vector<ZoneHistory>& zones);
+		static std::vector<ProfilerZoneStatistics> calculateStatistics(const std::vector<ZoneHistory>& zones);
+
+	private:
+		Clock::time_point m_startTime;
+		Clock::time_point m_frameStart;
+		bool m_frameStarted{ false };
+		uint64_t m_framesCount{ 0 };
+
+		std::vector<ZoneHistory> m_zones;
+		std::map<std::pair<std::string, bool>, size_t> m_zonesIndices;
+		std::vector<OpenZone> m_openZones;
+
+		std::vector<ZoneHistory> m_counters;
+		std::map<std::string, size_t> m_countersIndices;
+
+		std::vector<TraceEvent> m_frameEvents;
+		std::vector<std::vector<TraceEvent>> m_traceFrames;
+		uint32_t m_nextTraceFrame{ 0 };
+	};
+}
@@ -4,6 +4,7 @@
 #include "Logger.hpp"
 
 #include <chrono>
+#include <optional>
 
 namespace GraphicEngine::Core
 {
@@ -18,7 +19,7 @@ namespace GraphicEngine::Core
 
 		void updateTime()
 		{
-			auto stop = std::chrono::system_clock::now();
+			auto stop = m_fixedInterval.has_value() ? m_actualTime + m_fixedInterval.value() : std::chrono::system_clock::now();
 			m_interval = stop - m_actualTime;
 			m_actualTime = stop;
 			m_currentTimeNotifier.notify((stop - m_startTime).count());
@@ -30,6 +31,12 @@ namespace GraphicEngine::Core
 			return m_interval.count();
 		}
 
+		// Time advances by the same step on every update instead of following the clock, so runs are reproducible
+		void setFixedInterval(double seconds)
+		{
+			m_fixedInterval = std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::duration<double>(seconds));
+		}
+
 		template <typename Callback>
 		void onTimeUpdate(Callback callback)
 		{
@@ -46,6 +53,7 @@ namespace GraphicEngine::Core
 		std::chrono::time_point<std::chrono::system_clock> m_actualTime;
 		std::chrono::time_point<std::chrono::system_clock> m_startTime;
 		std::chrono::duration<double> m_interval;
+		std::optional<std::chrono::system_clock::duration> m_fixedInterval;
 
 		Subject<double> m_updateNotifier;
 		Subject<double> m_currentTimeNotifier;
@@ -14,6 +14,35 @@ namespace GraphicEngine::Core::Utils
 	template <typename... Types>
 	const std::tuple<Types...> TypesRegister<Types...>::types = { Types{}... };
 
+	// Tuple with one container for each registered type
+	template <template <typename> typename Container, typename Register>
+	struct ContainersOfTypes;
+
+	template <template <typename> typename Container, typename... Types>
+	struct ContainersOfTypes<Container, TypesRegister<Types...>>
+	{
+		using type = std::tuple<Container<Types>...>;
+	};
+
+	// Position of type in register, e.g. to give every registered type own slot of array
+	template <typename Type, typename Register>
+	struct IndexOfType;
+
+	template <typename Type, typename... Types>
+	struct IndexOfType<Type, TypesRegister<Type, Types...>> : std::integral_constant<std::size_t, 0>
+	{};
+
+	template <typename Type, typename First, typename... Types>
+	struct IndexOfType<Type, TypesRegister<First, Types...>> : std::integral_constant<std::size_t, 1 + IndexOfType<Type, TypesRegister<Types...>>::value>
+	{};
+
+	template <typename Register>
+	struct TypesCount;
+
+	template <typename... Types>
+	struct TypesCount<TypesRegister<Types...>> : std::integral_constant<std::size_t, sizeof...(Types)>
+	{};
+
 	template <std::size_t I = 0, typename FuncT, typename... Tp>
 	inline typename std::enable_if<I == sizeof...(Tp), void>::type
 		for_each(std::tuple<Tp...>&, FuncT)
@@ -24,7 +53,7 @@ namespace GraphicEngine::Core::Utils
 		for_each(std::tuple<Tp...>& t, FuncT f)
 	{
 		f(std::get<I>(t));
-		for_each<I + 1, FuncT, Tp..., void>(t, f);
+		for_each<I + 1, FuncT, Tp...>(t, f);
 	}
 
 	template <std::size_t I = 0, typename FuncT, typename... Tp>
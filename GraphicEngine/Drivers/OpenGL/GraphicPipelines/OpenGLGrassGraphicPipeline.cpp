@@ -1,6 +1,7 @@
 #include "OpenGLGrassGraphicPipeline.hpp"
 #include "../../../Core/IO/FileReader.hpp"
 #include "../../../Core/IO/FileSystem.hpp"
+#include "../../../Core/IO/ShaderSourceReader.hpp"
 
 #include "../../../Common/ShaderEnums.hpp"
 
@@ -11,7 +12,8 @@ GraphicEngine::OpenGL::OpenGLGrassGraphicPipeline::OpenGLGrassGraphicPipeline(st
 	std::shared_ptr<Texture> directionalLighttShadowMap,
 	std::shared_ptr<Texture> spotLightShadowMaps,
 	std::shared_ptr<Texture> pointLightShadowMaps,
-	std::shared_ptr<Texture> windMap)
+	std::shared_ptr<Texture> windMap,
+	Engines::Graphic::Shaders::GrassParameters grassParameters)
 {
 	using namespace Engines::Graphic::Shaders;
 
@@ -22,12 +24,13 @@ GraphicEngine::OpenGL::OpenGLGrassGraphicPipeline::OpenGLGrassGraphicPipeline(st
 	m_windMap = windMap;
 
 	OpenGLVertexShader vert(GraphicEngine::Core::IO::readFile<std::string>(Core::FileSystem::getOpenGlShaderPath("grass.vert").string()));
-	OpenGLFragmentShader frag(GraphicEngine::Core::IO::readFile<std::string>(Core::FileSystem::getOpenGlShaderPath("grass.frag").string()));
-	OpenGLGeometryShader geom(GraphicEngine::Core::IO::readFile<std::string>(Core::FileSystem::getOpenGlShaderPath("grass.geom").string()));
+	OpenGLFragmentShader frag(GraphicEngine::Core::IO::readShaderSource(Core::FileSystem::getOpenGlShaderPath("grass.frag")));
 
-	m_shaderProgram = std::make_shared<OpenGLShaderProgram>(std::vector<OpenGLShader>{ vert, geom, frag });
+	m_shaderProgram = std::make_shared<OpenGLShaderProgram>(std::vector<OpenGLShader>{ vert, frag });
+
+	m_grassField = std::make_shared<Engines::Graphic::GrassField>(grassParameters);
+	m_bladesInstanceBuffer = std::make_unique<InstanceBuffer<GrassBlade>>();
 
-	m_modelDescriptorUniformBuffer = std::make_shared<UniformBuffer<ModelMartices>>(ShaderBinding::Grass_ModelMartices, m_shaderProgram);
 	m_materialUniformBuffer = std::make_shared<UniformBuffer<GrassMaterial>>(ShaderBinding::Grass_Material, m_shaderProgram);
 	m_grassParametersUniformBuffer = std::make_shared<UniformBuffer<GrassParameters>>(ShaderBinding::Grass_GrassParameters, m_shaderProgram);
 
@@ -49,7 +52,6 @@ GraphicEngine::OpenGL::OpenGLGrassGraphicPipeline::OpenGLGrassGraphicPipeline(st
 		2.0f
 	};
 
-	GrassParameters grassParameters(0.005f, 0.2f, 0.5f);
 	m_grassParametersUniformBuffer->update(&grassParameters);
 
 	m_materialUniformBuffer->update(&grass);
@@ -65,20 +67,38 @@ GraphicEngine::OpenGL::OpenGLGrassGraphicPipeline::OpenGLGrassGraphicPipeline(st
 
 	glUniform1i(glGetUniformLocation(m_shaderProgram->getShaderProgramId(), "windMap"), 3);
 	m_windMap->use(3);
+
+	m_segmentsLocation = glGetUniformLocation(m_shaderProgram->getShaderProgramId(), "segments");
 }
 
 void GraphicEngine::OpenGL::OpenGLGrassGraphicPipeline::draw()
 {
+	updateGrassSurfaces();
+	if (m_grassFieldOutdated)
+	{
+		m_grassField->build();
+		m_bladesInstanceBuffer->update(m_grassField->getBlades());
+		m_grassFieldOutdated = false;
+	}
+
+	auto camera = m_cameraControllerManager->getActiveCamera();
+	m_grassField->selectLods(camera->getProjectionMatrix() * camera->getViewMatrix(), camera->getPosition());
+
 	m_shaderProgram->use();
+	m_bladesInstanceBuffer->bind();
 
-	auto viewMatrix = m_cameraControllerManager->getActiveCamera()->getViewMatrix();
+	for (uint32_t segments{ 1 }; segments <= m_grassField->getParameters().segments; ++segments)
+	{
+		const auto& draws = m_grassField->getDraws(segments);
+		if (draws.empty())
+			continue;
 
-	m_vertexBufferCollection->forEachEntity([&](auto vertexBufferCollection)
+		glUniform1ui(m_segmentsLocation, segments);
+		for (const auto& draw : draws)
 		{
-			vertexBufferCollection->modelDescriptor.modelMatrix = vertexBufferCollection->mesh->getModelMatrix();
-			vertexBufferCollection->modelDescriptor.normalMatrix = glm::transpose(glm::inverse(vertexBufferCollection->modelDescriptor.modelMatrix));
-			m_modelDescriptorUniformBuffer->update(&vertexBufferCollection->modelDescriptor);
-			vertexBufferCollection->vertexBuffer->drawElements(GL_TRIANGLES);
-		});
-}
+			m_bladesInstanceBuffer->draw(GL_TRIANGLE_STRIP, 2 * segments + 1, draw.firstBlade, draw.bladesCount);
+		}
+	}
 
+	m_bladesInstanceBuffer->unbind();
+}
@@ -2,6 +2,7 @@
 
 #include "OpenGLGraphicPipeline.hpp"
 #include "../../../Engines/Graphic/Pipelines/GrassGraphicPipeline.hpp"
+#include "../OpenGLInstanceBuffer.hpp"
 #include "../OpenGLTexture.hpp"
 
 namespace GraphicEngine::OpenGL
@@ -13,7 +14,8 @@ namespace GraphicEngine::OpenGL
 			std::shared_ptr<Texture> directionalLighttShadowMap,
 			std::shared_ptr<Texture> spotLightShadowMaps,
 			std::shared_ptr<Texture> pointLightShadowMaps,
-			std::shared_ptr<Texture> windMap);
+			std::shared_ptr<Texture> windMap,
+			Engines::Graphic::Shaders::GrassParameters grassParameters);
 
 		virtual void draw() override;
 	private:
@@ -23,5 +25,8 @@ namespace GraphicEngine::OpenGL
 		std::shared_ptr<Texture> m_spotLightShadowMaps;
 		std::shared_ptr<Texture> m_pointLightShadowMaps;
 		std::shared_ptr<Texture> m_windMap;
+
+		std::unique_ptr<InstanceBuffer<Engines::Graphic::Shaders::GrassBlade>> m_bladesInstanceBuffer;
+		GLint m_segmentsLocation;
 	};
 }
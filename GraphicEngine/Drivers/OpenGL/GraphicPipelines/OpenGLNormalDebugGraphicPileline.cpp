@@ -25,7 +25,7 @@ void GraphicEngine::OpenGL::OpenGLNormalDebugGraphicPipeline::draw()
 
 	m_vertexBufferCollection->forEachEntity([&](auto vertexBufferCollection)
 	{
-		vertexBufferCollection->modelDescriptor.modelMatrix = vertexBufferCollection->mesh->getModelMatrix();
+		vertexBufferCollection->modelDescriptor.modelMatrix = vertexBufferCollection->mesh->getModelMatrix() * vertexBufferCollection->vertexBuffer->getDequantizationMatrix();
 		vertexBufferCollection->modelDescriptor.normalMatrix = glm::transpose(glm::inverse(m_cameraControllerManager->getActiveCamera()->getViewMatrix() * vertexBufferCollection->modelDescriptor.modelMatrix));
 		m_modelDescriptorUniformBuffer->update(&vertexBufferCollection->modelDescriptor);
 		vertexBufferCollection->vertexBuffer->drawElements(GL_TRIANGLES);
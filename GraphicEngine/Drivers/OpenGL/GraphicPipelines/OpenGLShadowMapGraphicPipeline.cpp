@@ -45,12 +45,15 @@ GraphicEngine::OpenGL::OpenGLShadowMapGraphicPipeline::OpenGLShadowMapGraphicPip
 
 	m_depthTexture = depthTexture;
 
+	// Scene may be rendered into offscreen framebuffer, so previous binding is restored instead of default one
+	GLint previousFramebuffer{ 0 };
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
 	glGenFramebuffers(1, &dephMapFBO);
 	glBindFramebuffer(GL_FRAMEBUFFER, dephMapFBO);
 	glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_depthTexture->getTexture(), 0);
 	glDrawBuffer(GL_NONE);
 	glReadBuffer(GL_NONE);
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
 }
 
 void GraphicEngine::OpenGL::OpenGLShadowMapGraphicPipeline::draw()
@@ -60,20 +63,22 @@ void GraphicEngine::OpenGL::OpenGLShadowMapGraphicPipeline::draw()
 		glEnable(GL_CULL_FACE);
 		glCullFace(GL_FRONT);
 		m_shaderProgram->use();
+		GLint previousFramebuffer{ 0 };
+		glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
 		glViewport(0, 0, m_depthTexture->getWidth(), m_depthTexture->getHeight());
 		glBindFramebuffer(GL_FRAMEBUFFER, dephMapFBO);
 		glClear(GL_DEPTH_BUFFER_BIT); 
 
 		m_vertexBufferCollection->forEachEntity([&](auto vertexBufferCollection)
 			{
-				vertexBufferCollection->modelDescriptor.model = vertexBufferCollection->mesh->getModelMatrix();
+				vertexBufferCollection->modelDescriptor.model = vertexBufferCollection->mesh->getModelMatrix() * vertexBufferCollection->vertexBuffer->getDequantizationMatrix();
 				m_modelDescriptorUniformBuffer->update(&vertexBufferCollection->modelDescriptor);
 				Engines::Graphic::Shaders::ModelMatrix m(vertexBufferCollection->modelDescriptor.model);
 				m_modelMatrix->update(&m);
 				vertexBufferCollection->vertexBuffer->drawElements(GL_TRIANGLES);
 			});
 
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
 		glDisable(GL_CULL_FACE);
 	}
 }
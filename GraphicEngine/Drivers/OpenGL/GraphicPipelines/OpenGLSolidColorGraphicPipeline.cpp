@@ -1,15 +1,19 @@
 #include "OpenGLSolidColorGraphicPipeline.hpp"
 #include "../../../Core/IO/FileReader.hpp"
 #include "../../../Core/IO/FileSystem.hpp"
+#include "../../../Core/IO/ShaderSourceReader.hpp"
 
 #include "../../../Common/ShaderEnums.hpp"
 
+#include <cstring>
+#include <optional>
+
 GraphicEngine::OpenGL::OpenGLSolidColorGraphicPipeline::OpenGLSolidColorGraphicPipeline(std::shared_ptr<Services::CameraControllerManager> cameraControllerManager,
 	std::shared_ptr<Texture> depthTexture, std::shared_ptr<Texture> spotLightShadowMaps, std::shared_ptr<Texture> pointLightShadowMaps) :
 	Engines::Graphic::SolidColorGraphicPipeline<VertexBuffer, UniformBuffer, UniformBuffer>{ cameraControllerManager }
 {
 	OpenGLVertexShader vert(GraphicEngine::Core::IO::readFile<std::string>(Core::FileSystem::getOpenGlShaderPath("solid.vert").string()));
-	OpenGLFragmentShader frag(GraphicEngine::Core::IO::readFile<std::string>(Core::FileSystem::getOpenGlShaderPath("solid.frag").string()));
+	OpenGLFragmentShader frag(GraphicEngine::Core::IO::readShaderSource(Core::FileSystem::getOpenGlShaderPath("solid.frag")));
 
 	m_shaderProgram = std::make_shared<OpenGLShaderProgram>(std::vector<OpenGLShader>{ vert, frag });
 
@@ -43,9 +47,25 @@ void GraphicEngine::OpenGL::OpenGLSolidColorGraphicPipeline::draw()
 
 	glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 1, &m_diffuseOnlyIndex);
 
-	m_vertexBufferCollection->forEachEntity([&](auto vertexBufferCollection)
+	auto viewProjection = m_cameraControllerManager->getActiveCamera()->getViewProjectionMatrix();
+	auto eyePosition = m_cameraControllerManager->getActiveCamera()->getPosition();
+	std::vector<Common::DrawElementsCommand> meshletDraws;
+	std::optional<Engines::Graphic::Shaders::Material> currentMaterial;
+
+	// Draws are grouped by material, so material is uploaded only when it changes, and go front to back
+	m_vertexBufferCollection->forEachEntitySorted([&](const auto& vertexBufferCollection, uint32_t handle)
+	{
+		auto modelMatrix = vertexBufferCollection->mesh->getModelMatrix();
+		Common::DrawRecord record;
+		record.entity = handle;
+		record.materialId = vertexBufferCollection->mesh->getMaterialId();
+		record.lod = vertexBufferCollection->mesh->selectLod(viewProjection * modelMatrix);
+		record.sortKey = Common::RenderQueue::makeSortKey(record.materialId, glm::distance(eyePosition, glm::vec3(modelMatrix[3])));
+		return record;
+	},
+	[&](const auto& vertexBufferCollection, const Common::DrawRecord& record)
 	{
-		vertexBufferCollection->modelDescriptor.modelMatrix = vertexBufferCollection->mesh->getModelMatrix();
+		vertexBufferCollection->modelDescriptor.modelMatrix = vertexBufferCollection->mesh->getModelMatrix() * vertexBufferCollection->vertexBuffer->getDequantizationMatrix();
 		vertexBufferCollection->modelDescriptor.normalMatrix = glm::transpose(glm::inverse(vertexBufferCollection->modelDescriptor.modelMatrix));
 		m_solidColorUniformBuffer->update(&vertexBufferCollection->modelDescriptor);
 
@@ -53,12 +73,26 @@ void GraphicEngine::OpenGL::OpenGLSolidColorGraphicPipeline::draw()
 		{
 			auto meshMaterial = vertexBufferCollection->mesh->getMaterial();
 			auto material = std::get<Engines::Graphic::Shaders::Material>(meshMaterial.baseMaterial);
-			m_materialUniformBuffer->update(&material);
+			if (!currentMaterial || std::memcmp(&*currentMaterial, &material, sizeof(material)) != 0)
+			{
+				m_materialUniformBuffer->update(&material);
+				currentMaterial = material;
+			}
 		}
 		catch (const std::bad_variant_access&)
 		{
 			// TODO put textures
 		}
+		vertexBufferCollection->vertexBuffer->setLod(record.lod);
+
+		// Meshlets are built only for base level
+		if (record.lod == 0 && vertexBufferCollection->mesh->hasMeshlets())
+		{
+			meshletDraws.clear();
+			vertexBufferCollection->mesh->cullMeshlets(viewProjection, eyePosition, meshletDraws);
+			vertexBufferCollection->vertexBuffer->drawElements(GL_TRIANGLES, meshletDraws);
+			return;
+		}
 		vertexBufferCollection->vertexBuffer->drawElements(GL_TRIANGLES);
 	});
 }
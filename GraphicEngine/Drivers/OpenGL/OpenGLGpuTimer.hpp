@@ -0,0 +1,128 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include "../../Core/Profiler.hpp"
+
+#include <array>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#ifdef GRAPHIC_ENGINE_PROFILER
+#define PROFILE_GPU_ZONE(gpuTimer, name) GraphicEngine::OpenGL::GpuTimer::ScopedQuery PROFILER_CONCAT(gpuZone, __LINE__)(*(gpuTimer), name)
+#else
+#define PROFILE_GPU_ZONE(gpuTimer, name)
+#endif
+
+namespace GraphicEngine::OpenGL
+{
+	// GL_TIME_ELAPSED queries kept in ring per zone, results are read frames later when available so pipeline never stalls.
+	// Elapsed time queries can not be nested, so zones have to wrap consecutive passes.
+	class GpuTimer
+	{
+	public:
+		class ScopedQuery
+		{
+		public:
+			ScopedQuery(GpuTimer& gpuTimer, const std::string& name) :
+				m_gpuTimer{ gpuTimer }
+			{
+				m_gpuTimer.begin(name);
+			}
+
+			~ScopedQuery()
+			{
+				m_gpuTimer.end();
+			}
+
+			ScopedQuery(const ScopedQuery&) = delete;
+			ScopedQuery& operator=(const ScopedQuery&) = delete;
+
+		private:
+			GpuTimer& m_gpuTimer;
+		};
+
+		static constexpr uint32_t latency{ 4 };
+
+		GpuTimer(std::shared_ptr<Core::Profiler> profiler) :
+			m_profiler{ profiler }
+		{
+		}
+
+		void begin(const std::string& name)
+		{
+			if (m_activeZone != nullptr)
+			{
+				throw std::runtime_error("GPU timer zones can not be nested!");
+			}
+
+			auto& zone = m_zones[name];
+			if (zone.queries[0] == 0)
+			{
+				glGenQueries(latency, zone.queries.data());
+			}
+
+			// Oldest query is still in flight, sample is dropped instead of waiting for it
+			zone.pending[zone.next] = false;
+			glBeginQuery(GL_TIME_ELAPSED, zone.queries[zone.next]);
+			m_activeZone = &zone;
+		}
+
+		void end()
+		{
+			if (m_activeZone == nullptr)
+				return;
+
+			glEndQuery(GL_TIME_ELAPSED);
+			m_activeZone->pending[m_activeZone->next] = true;
+			m_activeZone->next = (m_activeZone->next + 1) % latency;
+			m_activeZone = nullptr;
+		}
+
+		// Forwards finished queries to profiler, should be called once per frame
+		void collect()
+		{
+			for (auto& [name, zone] : m_zones)
+			{
+				for (uint32_t i{ 0 }; i < latency; ++i)
+				{
+					uint32_t query = (zone.next + i) % latency;
+					if (!zone.pending[query])
+						continue;
+
+					GLint available{ 0 };
+					glGetQueryObjectiv(zone.queries[query], GL_QUERY_RESULT_AVAILABLE, &available);
+					if (!available)
+						break;
+
+					GLuint64 elapsed{ 0 };
+					glGetQueryObjectui64v(zone.queries[query], GL_QUERY_RESULT, &elapsed);
+					zone.pending[query] = false;
+					m_profiler->addGpuZone(name, elapsed / 1000000.0);
+				}
+			}
+		}
+
+		~GpuTimer()
+		{
+			for (auto& [name, zone] : m_zones)
+			{
+				glDeleteQueries(latency, zone.queries.data());
+			}
+		}
+
+	private:
+		struct Zone
+		{
+			std::array<GLuint, latency> queries{};
+			std::array<bool, latency> pending{};
+			uint32_t next{ 0 };
+		};
+
+		std::shared_ptr<Core::Profiler> m_profiler;
+		std::map<std::string, Zone> m_zones;
+		Zone* m_activeZone{ nullptr };
+	};
+}
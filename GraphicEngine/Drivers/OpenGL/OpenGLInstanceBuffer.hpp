@@ -0,0 +1,85 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include "OpenGLVertexAttribute.hpp"
+#include "../../Core/Profiler.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace GraphicEngine::OpenGL
+{
+	// Vertex array with per instance attributes only, geometry of an instance is generated in vertex shader from gl_VertexID
+	template <typename Instance>
+	class InstanceBuffer
+	{
+	public:
+		InstanceBuffer(uint32_t capacity = 1024) :
+			m_capacity{ std::max(capacity, 1u) }
+		{
+			glGenVertexArrays(1, &m_vao);
+			glGenBuffers(1, &m_vbo);
+
+			glBindVertexArray(m_vao);
+			glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+			glBufferData(GL_ARRAY_BUFFER, m_capacity * Instance::getStride(), nullptr, GL_STATIC_DRAW);
+
+			constexpr auto attributes = Instance::getSizeAndOffsets();
+
+			uint32_t i{ 0 };
+			for (const auto& attribute : attributes)
+			{
+				setVertexAttribute(i, attribute, Instance::getStride());
+				glVertexAttribDivisor(i, 1);
+				++i;
+			}
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			glBindVertexArray(0);
+		}
+
+		void update(const std::vector<Instance>& instances)
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+			if (instances.size() > m_capacity)
+			{
+				m_capacity = instances.size();
+				glBufferData(GL_ARRAY_BUFFER, m_capacity * Instance::getStride(), instances.data(), GL_STATIC_DRAW);
+				PROFILE_UPLOADED_BYTES(m_capacity * Instance::getStride());
+			}
+			else if (!instances.empty())
+			{
+				glBufferSubData(GL_ARRAY_BUFFER, 0, instances.size() * Instance::getStride(), instances.data());
+				PROFILE_UPLOADED_BYTES(instances.size() * Instance::getStride());
+			}
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+
+		void bind() const
+		{
+			glBindVertexArray(m_vao);
+		}
+
+		void draw(int primitiveTopology, uint32_t verticesCount, uint32_t firstInstance, uint32_t instancesCount) const
+		{
+			glDrawArraysInstancedBaseInstance(primitiveTopology, 0, verticesCount, instancesCount, firstInstance);
+			PROFILE_DRAW_CALLS(1);
+		}
+
+		void unbind() const
+		{
+			glBindVertexArray(0);
+		}
+
+		~InstanceBuffer()
+		{
+			glDeleteBuffers(1, &m_vbo);
+			glDeleteVertexArrays(1, &m_vao);
+		}
+
+	private:
+		GLuint m_vao{ 0 };
+		GLuint m_vbo{ 0 };
+		uint32_t m_capacity;
+	};
+}
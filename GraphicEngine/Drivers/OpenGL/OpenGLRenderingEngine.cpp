@@ -12,20 +12,27 @@ GraphicEngine::OpenGL::OpenGLRenderingEngine::OpenGLRenderingEngine(
 	std::shared_ptr<Services::ServicesManager> servicesManager,
 	std::shared_ptr<Core::EventManager> eventManager,
 	std::shared_ptr<Core::Timer> timer,
+	std::shared_ptr<Core::Profiler> profiler,
 	std::shared_ptr<Common::UI> ui,
 	std::shared_ptr<Core::Configuration> cfg,
 	std::unique_ptr<Core::Logger<OpenGLRenderingEngine>> logger) :
 	m_logger(std::move(logger)),
-	RenderingEngine(servicesManager, eventManager, timer, ui, cfg)
+	RenderingEngine(servicesManager, eventManager, timer, profiler, ui, cfg)
 {
 	m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Create OpenGL rendering engine instance.");
 }
 
 bool GraphicEngine::OpenGL::OpenGLRenderingEngine::drawFrame()
 {
+#ifdef GRAPHIC_ENGINE_PROFILER
+	m_gpuTimer->collect();
+#endif
+
 	// Create shadow maps
 	if (m_renderingOptionsManager->renderingOptions.shadowRendering.directional)
 	{
+		PROFILE_CPU_ZONE(m_profiler, "Directional shadows");
+		PROFILE_GPU_ZONE(m_gpuTimer, "Directional shadows");
 		glClearColor(m_viewportManager->backgroudColor.r, m_viewportManager->backgroudColor.g, m_viewportManager->backgroudColor.b, m_viewportManager->backgroudColor.a);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 		m_shadowMapGraphicPipeline->draw();
@@ -33,6 +40,8 @@ bool GraphicEngine::OpenGL::OpenGLRenderingEngine::drawFrame()
 
 	if (m_renderingOptionsManager->renderingOptions.shadowRendering.spot)
 	{
+		PROFILE_CPU_ZONE(m_profiler, "Spot shadows");
+		PROFILE_GPU_ZONE(m_gpuTimer, "Spot shadows");
 		glClearColor(m_viewportManager->backgroudColor.r, m_viewportManager->backgroudColor.g, m_viewportManager->backgroudColor.b, m_viewportManager->backgroudColor.a);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 		m_spotLightshadowMapGraphicPipeline->draw();
@@ -40,6 +49,8 @@ bool GraphicEngine::OpenGL::OpenGLRenderingEngine::drawFrame()
 
 	if (m_renderingOptionsManager->renderingOptions.shadowRendering.point)
 	{
+		PROFILE_CPU_ZONE(m_profiler, "Point shadows");
+		PROFILE_GPU_ZONE(m_gpuTimer, "Point shadows");
 		glClearColor(m_viewportManager->backgroudColor.r, m_viewportManager->backgroudColor.g, m_viewportManager->backgroudColor.b, m_viewportManager->backgroudColor.a);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 		m_pointLightshadowMapGraphicPipeline->draw();
@@ -60,19 +71,54 @@ bool GraphicEngine::OpenGL::OpenGLRenderingEngine::drawFrame()
 	Engines::Graphic::Shaders::Eye eye{ glm::vec4(eyePosition, 1.0) };
 	m_eyeUniformBuffer->update(&eye);
 
-	m_grassGraphicPipeline->draw();
+	{
+		PROFILE_CPU_ZONE(m_profiler, "Light clusters");
+		PROFILE_GPU_ZONE(m_gpuTimer, "Light clusters upload");
+		m_lightClusterGrid->build(projectionMatrix, static_cast<float>(m_width), static_cast<float>(m_height));
+		m_lightClusterGrid->assignLights(viewMatrix, m_clusteredPointLights, m_clusteredSpotLights);
+		auto lightClusterParameters = m_lightClusterGrid->getParameters();
+		m_lightClusterParametersUniformBuffer->update(&lightClusterParameters);
+		m_lightClusters->update(m_lightClusterGrid->getClusters());
+		m_lightIndices->update(m_lightClusterGrid->getLightIndices());
+	}
+
+	{
+		PROFILE_CPU_ZONE(m_profiler, "Grass");
+		PROFILE_GPU_ZONE(m_gpuTimer, "Grass");
+		m_grassGraphicPipeline->draw();
+	}
 	
 	if (m_viewportManager->displayNormal)
+	{
+		PROFILE_CPU_ZONE(m_profiler, "Normals");
+		PROFILE_GPU_ZONE(m_gpuTimer, "Normals");
 		m_normalDebugGraphicPipeline->draw();
+	}
 	if (m_viewportManager->displayWireframe)
+	{
+		PROFILE_CPU_ZONE(m_profiler, "Wireframe");
+		PROFILE_GPU_ZONE(m_gpuTimer, "Wireframe");
 		m_wireframeGraphicPipeline->draw();
+	}
 	if (m_viewportManager->displaySolid)
+	{
+		PROFILE_CPU_ZONE(m_profiler, "Solid");
+		PROFILE_GPU_ZONE(m_gpuTimer, "Solid");
 		m_solidColorGraphicPipeline->draw();
+	}
 	if (m_viewportManager->displaySkybox)
+	{
+		PROFILE_CPU_ZONE(m_profiler, "Skybox");
+		PROFILE_GPU_ZONE(m_gpuTimer, "Skybox");
 		m_skyboxGraphicPipeline->draw();
+	}
 
-	m_ui->drawUi();
-	m_uiRenderingBackend->renderData();
+	{
+		PROFILE_CPU_ZONE(m_profiler, "UI");
+		PROFILE_GPU_ZONE(m_gpuTimer, "UI");
+		m_ui->drawUi();
+		m_uiRenderingBackend->renderData();
+	}
 
 	return false;
 }
@@ -104,7 +150,8 @@ void GraphicEngine::OpenGL::OpenGLRenderingEngine::init(size_t width, size_t hei
 		m_wireframeGraphicPipeline = std::make_unique<OpenGLWireframeGraphicPipeline>(m_cameraControllerManager);
 		m_solidColorGraphicPipeline = std::make_unique<OpenGLSolidColorGraphicPipeline>(m_cameraControllerManager, m_directionalLightDepthTexture, m_spotLightdepthTexture, m_pointightdepthTexture);
 		m_normalDebugGraphicPipeline = std::make_unique<OpenGLNormalDebugGraphicPipeline>(m_cameraControllerManager);
-		m_grassGraphicPipeline = std::make_unique<OpenGLGrassGraphicPipeline>(m_cameraControllerManager, m_directionalLightDepthTexture, m_spotLightdepthTexture, m_pointightdepthTexture, m_windManager->getTextureObject<Texture2D>());
+		m_grassGraphicPipeline = std::make_unique<OpenGLGrassGraphicPipeline>(m_cameraControllerManager, m_directionalLightDepthTexture, m_spotLightdepthTexture, m_pointightdepthTexture, m_windManager->getTextureObject<Texture2D>(),
+			Engines::Graphic::Shaders::GrassParameters(std::make_shared<Core::Configuration>(m_cfg->getProperty<json>("scene:grass:parameters"))));
 		m_skyboxGraphicPipeline = std::make_unique<OpenGLSkyboxGraphicPipeline>(m_cfg->getProperty<std::string>("scene:skybox:texture path"));
 
 		Engines::Graphic::Shaders::LightSpaceMatrixArray lightSpaceMatrixArray;
@@ -143,6 +190,7 @@ void GraphicEngine::OpenGL::OpenGLRenderingEngine::init(size_t width, size_t hei
 				// Convert to seconds
 				Engines::Graphic::Shaders::Time t(timestamp/10000000);
 				m_timeUniformBuffer->update(&t);
+				m_windManager->update(t.timestamp);
 			});
 		m_windParametersUniformBuffer = std::make_unique<UniformBuffer<Engines::Graphic::Shaders::WindParameters>>(ShaderBinding::Global_WindParameters);
 		auto windParameters = m_windManager->getWindParameters();
@@ -163,6 +211,21 @@ void GraphicEngine::OpenGL::OpenGLRenderingEngine::init(size_t width, size_t hei
 		m_pointLights = std::make_shared<ShaderStorageBufferObject<Engines::Graphic::Shaders::PointLight>>(ShaderBinding::Global_PointLight);
 		m_spotLight = std::make_shared<ShaderStorageBufferObject<Engines::Graphic::Shaders::SpotLight>>(ShaderBinding::Global_SpotLight);
 
+#ifdef GRAPHIC_ENGINE_PROFILER
+		m_gpuTimer = std::make_unique<GpuTimer>(m_profiler);
+#endif
+
+		m_lightClusterGrid = std::make_unique<Engines::Graphic::LightClusterGrid>(
+			m_cfg->getProperty<int>("rendering options:light clusters:tiles x"),
+			m_cfg->getProperty<int>("rendering options:light clusters:tiles y"),
+			m_cfg->getProperty<int>("rendering options:light clusters:slices"),
+			m_cfg->getProperty<float>("rendering options:light clusters:near"));
+		m_lightClusterParametersUniformBuffer = std::make_unique<UniformBuffer<Engines::Graphic::Shaders::LightClusterParameters>>(ShaderBinding::Global_LightClusterParameters);
+		m_lightClusters = std::make_unique<ShaderStorageBufferObject<Engines::Graphic::Shaders::LightCluster>>(ShaderBinding::Global_LightClusters, m_lightClusterGrid->getClustersCount());
+		m_lightIndices = std::make_unique<ShaderStorageBufferObject<uint32_t>>(ShaderBinding::Global_LightIndices, 8 * m_lightClusterGrid->getClustersCount());
+		m_clusteredPointLights = m_lightManager->getPointLights();
+		m_clusteredSpotLights = m_lightManager->getSpotLights();
+
 		m_directionalLight->update(m_lightManager->getDirectionalLights());
 		m_lightManager->onUpdateDirectiionalLight([&](uint32_t index, Engines::Graphic::Shaders::DirectionalLight light)
 		{
@@ -184,11 +247,13 @@ void GraphicEngine::OpenGL::OpenGLRenderingEngine::init(size_t width, size_t hei
 		m_lightManager->onUpdatePointLight([&](uint32_t index, Engines::Graphic::Shaders::PointLight light)
 		{
 			m_pointLights->update(light, index);
+			m_clusteredPointLights[index] = light;
 			m_pointLightshadowMapGraphicPipeline->updateLight(light.getLightSpaceMatrices(), index, glm::vec4(glm::vec3(light.position), 25.0f));
 		});
 		m_lightManager->onUpdatePointLights([&](std::vector<Engines::Graphic::Shaders::PointLight> lights)
 		{
 			m_pointLights->update(lights);
+			m_clusteredPointLights = lights;
 			Engines::Graphic::Shaders::LightSpaceMatrixArray pointLightSpaceMatrixArray;
 			Engines::Graphic::Shaders::LightPositionFarPlaneArray pointLightPositionFarPlaneArray;
 			for (auto& pointLight : lights)
@@ -206,11 +271,13 @@ void GraphicEngine::OpenGL::OpenGLRenderingEngine::init(size_t width, size_t hei
 		m_lightManager->onUpdateSpotlLight([&](uint32_t index, Engines::Graphic::Shaders::SpotLight light)
 		{
 			m_spotLight->update(light, index);
+			m_clusteredSpotLights[index] = light;
 			m_spotLightshadowMapGraphicPipeline->updateLight(light.lightSpace, index, glm::vec4(glm::vec3(light.position), 50.0f));
 		});
 		m_lightManager->onUpdateSpotlLights([&](std::vector<Engines::Graphic::Shaders::SpotLight> lights)
 		{
 			m_spotLight->update(lights);
+			m_clusteredSpotLights = lights;
 			Engines::Graphic::Shaders::LightSpaceMatrixArray spotLightSpaceMatrixArray;
 			Engines::Graphic::Shaders::LightPositionFarPlaneArray spotLightPositionFarPlaneArray;
 			for (auto& spotLight : lights)
@@ -257,3 +324,24 @@ void GraphicEngine::OpenGL::OpenGLRenderingEngine::resizeFrameBuffer(size_t widt
 void GraphicEngine::OpenGL::OpenGLRenderingEngine::cleanup()
 {
 }
+
+GraphicEngine::FrameCapture GraphicEngine::OpenGL::OpenGLRenderingEngine::captureFrame()
+{
+	FrameCapture frameCapture{ m_width, m_height };
+	std::vector<uint8_t> pixels(static_cast<size_t>(m_width) * m_height * 4);
+
+	// Reads from framebuffer scene was drawn into, it is offscreen one in headless mode
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+	// OpenGL rows start at the bottom
+	size_t rowSize = static_cast<size_t>(m_width) * 4;
+	frameCapture.pixels.resize(pixels.size());
+	for (uint32_t y{ 0 }; y < m_height; ++y)
+	{
+		std::copy_n(pixels.data() + (m_height - 1 - y) * rowSize, rowSize, frameCapture.pixels.data() + y * rowSize);
+	}
+
+	return frameCapture;
+}
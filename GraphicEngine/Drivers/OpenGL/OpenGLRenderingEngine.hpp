@@ -2,9 +2,11 @@
 
 #include "../../Common/RenderingEngine.hpp"
 #include "../../Core/Logger.hpp"
+#include "../../Engines/Graphic/3D/LightClusterGrid.hpp"
 #include "../../Engines/Graphic/Shaders/Models/ModelMatrices.hpp"
 #include "../../Engines/Graphic/Shaders/Models/Time.hpp"
 
+#include "OpenGLGpuTimer.hpp"
 #include "OpenGLShader.hpp"
 #include "OpenGLTexture.hpp"
 #include "OpenGLUniformBuffer.hpp"
@@ -29,6 +31,7 @@ namespace GraphicEngine::OpenGL
 		OpenGLRenderingEngine(std::shared_ptr<Services::ServicesManager> servicesManager,
 			std::shared_ptr<Core::EventManager> eventManager,
 			std::shared_ptr<Core::Timer> timer,
+			std::shared_ptr<Core::Profiler> profiler,
 			std::shared_ptr<Common::UI> ui,
 			std::shared_ptr<Core::Configuration> cfg,
 			std::unique_ptr<Core::Logger<OpenGLRenderingEngine>> logger);
@@ -36,6 +39,7 @@ namespace GraphicEngine::OpenGL
 		virtual void init(size_t width, size_t height) override;
 		virtual void resizeFrameBuffer(size_t width, size_t height) override;
 		virtual void cleanup() override;
+		virtual FrameCapture captureFrame() override;
 
 		virtual ~OpenGLRenderingEngine() = default;
 	private:
@@ -48,6 +52,13 @@ namespace GraphicEngine::OpenGL
 		std::shared_ptr<ShaderStorageBufferObject<Engines::Graphic::Shaders::PointLight>> m_pointLights;
 		std::shared_ptr<ShaderStorageBufferObject<Engines::Graphic::Shaders::SpotLight>> m_spotLight;
 
+		std::unique_ptr<Engines::Graphic::LightClusterGrid> m_lightClusterGrid;
+		std::unique_ptr<UniformBuffer<Engines::Graphic::Shaders::LightClusterParameters>> m_lightClusterParametersUniformBuffer;
+		std::unique_ptr<ShaderStorageBufferObject<Engines::Graphic::Shaders::LightCluster>> m_lightClusters;
+		std::unique_ptr<ShaderStorageBufferObject<uint32_t>> m_lightIndices;
+		std::vector<Engines::Graphic::Shaders::PointLight> m_clusteredPointLights;
+		std::vector<Engines::Graphic::Shaders::SpotLight> m_clusteredSpotLights;
+
 		std::shared_ptr<Texture> m_directionalLightDepthTexture;
 		std::shared_ptr<Texture> m_spotLightdepthTexture;
 		std::shared_ptr<Texture> m_pointightdepthTexture;
@@ -64,6 +75,7 @@ namespace GraphicEngine::OpenGL
 		std::unique_ptr<OpenGLShadowMapGraphicPipeline> m_pointLightshadowMapGraphicPipeline;
 
 		std::shared_ptr<GUI::ImGuiImpl::OpenGlRenderEngineBackend> m_uiRenderingBackend;
+		std::unique_ptr<GpuTimer> m_gpuTimer;
 
 		uint32_t m_width;
 		uint32_t m_height;
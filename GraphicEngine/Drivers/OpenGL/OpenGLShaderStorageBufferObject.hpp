@@ -2,9 +2,13 @@
 
 #include <glm/mat4x2.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 #include <memory>
+#include <stdexcept>
+#include <string>
 
 #include "OpenGLShader.hpp"
+#include "../../Core/Profiler.hpp"
 #include "../../Core/Utils/GetClassName.hpp"
 
 namespace GraphicEngine::OpenGL
@@ -13,16 +17,18 @@ namespace GraphicEngine::OpenGL
 	class ShaderStorageBufferObject
 	{
 	public:
-		ShaderStorageBufferObject(const uint32_t index)
+		ShaderStorageBufferObject(const uint32_t index, uint32_t capacity = 126) :
+			m_index{ index }, m_capacity{ capacity }
 		{
 			glGenBuffers(1, &m_ssbo);
 			glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ssbo);
-			glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(T) * 126 + sizeof(uint32_t), nullptr, GL_STATIC_DRAW);
+			glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(T) * m_capacity + 4 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
 			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, index, m_ssbo);
 			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 		}
 
-		ShaderStorageBufferObject(const uint32_t index, std::shared_ptr<OpenGLShaderProgram> shaderProgram)
+		ShaderStorageBufferObject(const uint32_t index, std::shared_ptr<OpenGLShaderProgram> shaderProgram) :
+			m_index{ index }, m_capacity{ 0 }
 		{
 			std::string blockName = Core::Utils::getClassName<T>();
 			auto blockIndex = glGetProgramResourceIndex(shaderProgram->getShaderProgramId(), blockName.c_str());
@@ -34,8 +40,13 @@ namespace GraphicEngine::OpenGL
 			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 		}
 
-		void update(std::vector<T> values)
+		void update(const std::vector<T>& values)
 		{
+			if (values.size() > m_capacity)
+			{
+				reserve(std::max<uint32_t>(values.size(), 2 * m_capacity));
+			}
+
 			if (values.size() > 0)
 			{
 				glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ssbo);
@@ -43,6 +54,7 @@ namespace GraphicEngine::OpenGL
 				glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(unsigned int), &size);
 				glBufferSubData(GL_SHADER_STORAGE_BUFFER, 4 * sizeof(float), sizeof(T) * values.size(), &values[0]);
 				glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+				PROFILE_UPLOADED_BYTES(sizeof(unsigned int) + sizeof(T) * values.size());
 			}
 
 			else if (values.size() == 0)
@@ -51,18 +63,40 @@ namespace GraphicEngine::OpenGL
 				auto size = values.size();
 				glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(unsigned int), &size);
 				glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+				PROFILE_UPLOADED_BYTES(sizeof(unsigned int));
 			}
 		}
 
+		// Element is written into existing storage, so index has to be below reserved capacity
 		void update(T& val, uint32_t index)
 		{
+			if (index >= m_capacity)
+			{
+				throw std::out_of_range("Index " + std::to_string(index) + " is out of shader storage buffer of capacity " + std::to_string(m_capacity) + "!");
+			}
+
 			glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ssbo);
 			glBufferSubData(GL_SHADER_STORAGE_BUFFER, sizeof(T) * index + 4 * sizeof(float), sizeof(T), &val);
 			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+			PROFILE_UPLOADED_BYTES(sizeof(T));
+		}
+
+		void reserve(uint32_t capacity)
+		{
+			if (capacity <= m_capacity)
+				return;
+
+			m_capacity = capacity;
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ssbo);
+			glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(T) * m_capacity + 4 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, m_index, m_ssbo);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 		}
 
 	protected:
 		uint32_t m_ssbo;
+		uint32_t m_index;
+		uint32_t m_capacity;
 		std::shared_ptr<OpenGLShaderProgram> m_shaderProgram;
 	};
 }
@@ -1,8 +1,13 @@
 #include "OpenGLTexture.hpp"
 #include "../../Common/TextureReader.hpp"
+#include "../../Core/Profiler.hpp"
+#include <algorithm>
 #include <stdexcept>
 #include <iostream>
 
+#undef min
+#undef max
+
 constexpr std::array<GLenum, 4> GraphicEngine::OpenGL::Texture2D::internalFormats;
 
 GraphicEngine::OpenGL::Texture2D::Texture2D(const std::string& path, bool generateMipMap)
@@ -28,6 +33,7 @@ GraphicEngine::OpenGL::Texture2D::Texture2D(const std::string& path, bool genera
 		if (data)
 		{
 			glTexImage2D(textureType, 0, getFormat(channels), width, height, 0, getFormat(channels), GL_UNSIGNED_BYTE, data);
+			PROFILE_UPLOADED_BYTES(static_cast<size_t>(width) * height * channels);
 			if (generateMipMap)
 				glGenerateMipmap(textureType);
 		}
@@ -48,8 +54,8 @@ GraphicEngine::OpenGL::Texture2D::Texture2D(const uint8_t* data, int width, int
 	glGenTextures(1, &texture);
 	glBindTexture(textureType, texture);
 
-	glTexParameteri(textureType, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
-	glTexParameteri(textureType, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
+	glTexParameteri(textureType, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(textureType, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
 	glTexParameteri(textureType, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(textureType, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -57,11 +63,34 @@ GraphicEngine::OpenGL::Texture2D::Texture2D(const uint8_t* data, int width, int
 	if (data)
 	{
 		glTexImage2D(textureType, 0, getFormat(channels), width, height, 0, getFormat(channels), GL_UNSIGNED_BYTE, data);
+		PROFILE_UPLOADED_BYTES(static_cast<size_t>(width) * height * channels);
 		if (generateMipMap)
 			glGenerateMipmap(textureType);
 	}
 }
 
+void GraphicEngine::OpenGL::Texture2D::update(const uint8_t* data, int width, int height, int firstRow, int rowsCount)
+{
+	glBindTexture(textureType, texture);
+	if (width != this->width || height != this->height)
+	{
+		this->width = width;
+		this->height = height;
+		glTexImage2D(textureType, 0, getFormat(channels), width, height, 0, getFormat(channels), GL_UNSIGNED_BYTE, data);
+		PROFILE_UPLOADED_BYTES(static_cast<size_t>(width) * height * channels);
+		return;
+	}
+
+	rowsCount = std::min(rowsCount, height - firstRow);
+	if (rowsCount <= 0)
+		return;
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexSubImage2D(textureType, 0, 0, firstRow, width, rowsCount, getFormat(channels), GL_UNSIGNED_BYTE, data + static_cast<size_t>(firstRow) * width * channels);
+	PROFILE_UPLOADED_BYTES(static_cast<size_t>(rowsCount) * width * channels);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
 void GraphicEngine::OpenGL::Texture::use()
 {
 	glBindTexture(textureType, texture);
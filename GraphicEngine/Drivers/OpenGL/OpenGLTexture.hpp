@@ -41,6 +41,9 @@ namespace GraphicEngine::OpenGL
 		Texture2D(const std::string& path, bool generateMipMap = true);
 		Texture2D(const uint8_t* data, int width, int height, int channels, bool generateMipMap = true);
 
+		// Uploads rows [firstRow, firstRow + rowsCount) of data holding whole image, storage is reallocated only when size changed
+		void update(const uint8_t* data, int width, int height, int firstRow, int rowsCount);
+
 		static auto getFormat(int channels)
 		{
 			return internalFormats.at(static_cast<size_t>(channels) - 1);
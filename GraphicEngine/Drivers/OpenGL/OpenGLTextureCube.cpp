@@ -1,4 +1,5 @@
 #include "../../Common/TextureReader.hpp"
+#include "../../Core/Profiler.hpp"
 #include "OpenGLTextureCube.hpp"
 #include <execution>
 #include <mutex>
@@ -32,7 +33,10 @@ GraphicEngine::OpenGL::TextureCube::TextureCube(const std::array<std::string, 6>
 			height = h;
 			channels = c;
 			if (data)
+			{
 				glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, getFormat(channels), width, height, 0, getFormat(channels), GL_UNSIGNED_BYTE, data);
+				PROFILE_UPLOADED_BYTES(static_cast<size_t>(width) * height * channels);
+			}
 
 			++i;
 		}
@@ -62,6 +66,7 @@ GraphicEngine::OpenGL::TextureCube::TextureCube(const std::array<std::tuple<uint
 	for (const auto& data : faces)
 	{
 		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, getFormat(std::get<3>(data)), std::get<1>(data), std::get<2>(data), 0, getFormat(std::get<3>(data)), GL_UNSIGNED_BYTE, std::get<0>(data));
+		PROFILE_UPLOADED_BYTES(static_cast<size_t>(std::get<1>(data)) * std::get<2>(data) * std::get<3>(data));
 		++i;
 	}
 
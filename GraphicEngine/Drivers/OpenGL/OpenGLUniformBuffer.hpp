@@ -5,7 +5,8 @@
 #include <memory>
 
 #include "OpenGLShader.hpp"
-#include "../../Core/Utils/GetClassName.hpp"
+
+#include "../../Core/Profiler.hpp"#include "../../Core/Utils/GetClassName.hpp"
 
 namespace GraphicEngine::OpenGL
 {
@@ -37,6 +38,7 @@ namespace GraphicEngine::OpenGL
 		{
 			glBindBuffer(GL_UNIFORM_BUFFER, m_ubo);
 			glBufferSubData(GL_UNIFORM_BUFFER, stride, sizeof(Val) * count, val);
+			PROFILE_UPLOADED_BYTES(sizeof(Val) * count);
 			glBindBuffer(GL_UNIFORM_BUFFER, 0);
 		}
 
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "../../Common/Vertex.hpp"
+
+#include <GL/glew.h>
+
+#include <stdexcept>
+
+namespace GraphicEngine::OpenGL
+{
+	constexpr GLenum getVertexAttributeType(Common::VertexAttributeFormat format)
+	{
+		switch (format)
+		{
+		case Common::VertexAttributeFormat::Float:
+			return GL_FLOAT;
+		case Common::VertexAttributeFormat::HalfFloat:
+			return GL_HALF_FLOAT;
+		case Common::VertexAttributeFormat::Short:
+			return GL_SHORT;
+		case Common::VertexAttributeFormat::UnsignedShort:
+			return GL_UNSIGNED_SHORT;
+		case Common::VertexAttributeFormat::Byte:
+			return GL_BYTE;
+		case Common::VertexAttributeFormat::UnsignedByte:
+			return GL_UNSIGNED_BYTE;
+		}
+		throw std::invalid_argument("Vertex attribute format is not supported!");
+	}
+
+	// Enables attribute of currently bound vertex array and describes it in currently bound array buffer
+	inline void setVertexAttribute(GLuint index, const Common::VertexAttribute& attribute, uint32_t stride)
+	{
+		glEnableVertexAttribArray(index);
+		glVertexAttribPointer(index, attribute.size, getVertexAttributeType(attribute.format), attribute.normalized ? GL_TRUE : GL_FALSE, stride, reinterpret_cast<void*>(static_cast<uintptr_t>(attribute.offset)));
+	}
+}
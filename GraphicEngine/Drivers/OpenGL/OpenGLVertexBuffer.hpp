@@ -1,11 +1,17 @@
 #pragma once
 
+#include "OpenGLVertexAttribute.hpp"
+#include "../../Common/DrawElementsCommand.hpp"
+#include "../../Common/PackedVertex.hpp"
 #include "../../Common/VertexBuffer.hpp"
+#include "../../Core/Profiler.hpp"
 
 #include <GL/glew.h>
 
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace GraphicEngine::OpenGL
@@ -13,6 +19,9 @@ namespace GraphicEngine::OpenGL
 	template <typename _Vertex>
 	class VertexBuffer : public Common::VertexBuffer<OpenGL::VertexBuffer<_Vertex>, int>
 	{
+		// Layout of vertex in buffer, may be packed variant of _Vertex
+		using GpuVertex = typename Common::PackedVertex<_Vertex>::type;
+
 		class _IVerexBuffer
 		{
 		public:
@@ -24,8 +33,12 @@ namespace GraphicEngine::OpenGL
 
 			virtual void drawElements(int primitiveTopology) = 0;
 
+			virtual void drawElements(int primitiveTopology, const std::vector<Common::DrawElementsCommand>& commands) = 0;
+
 			virtual void drawEdges(int primitiveTopology) = 0;
 
+			virtual void setIndicesRange(uint32_t offset, uint32_t count) = 0;
+
 			virtual void unbind(int dummy = 0) const = 0;
 
 			virtual ~_IVerexBuffer() = default;
@@ -36,7 +49,7 @@ namespace GraphicEngine::OpenGL
 		{
 		public:
 			_VertexBuffer() {}
-			_VertexBuffer(const std::vector<_Vertex>& vertices)
+			_VertexBuffer(const std::vector<GpuVertex>& vertices)
 			{
 				this->m_vertexBufferSize = vertices.size();
 				glGenVertexArrays(1, &m_vao);
@@ -45,15 +58,15 @@ namespace GraphicEngine::OpenGL
 				bind();
 				glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
 
-				glBufferData(GL_ARRAY_BUFFER, vertices.size() * _Vertex::getStride(), vertices.data(), GL_STATIC_DRAW);
+				glBufferData(GL_ARRAY_BUFFER, vertices.size() * GpuVertex::getStride(), vertices.data(), GL_STATIC_DRAW);
+				PROFILE_UPLOADED_BYTES(vertices.size() * GpuVertex::getStride());
 
-				std::vector<std::pair<uint32_t, uint32_t>> sizesAndOffsets = _Vertex::getSizeAndOffsets();
+				constexpr auto attributes = GpuVertex::getSizeAndOffsets();
 
 				uint32_t i{ 0 };
-				for (auto sizeAndOffset : sizesAndOffsets)
+				for (const auto& attribute : attributes)
 				{
-					glEnableVertexAttribArray(i);
-					glVertexAttribPointer(i, sizeAndOffset.first, GL_FLOAT, GL_FALSE, _Vertex::getStride(), reinterpret_cast<void*>(sizeAndOffset.second));
+					setVertexAttribute(i, attribute, GpuVertex::getStride());
 					++i;
 				}
 				unbind();
@@ -72,6 +85,7 @@ namespace GraphicEngine::OpenGL
 			virtual void draw(int primitiveTopology)
 			{
 				glDrawArrays(primitiveTopology, 0, m_vertexBufferSize);
+				PROFILE_DRAW_CALLS(1);
 			}
 
 			virtual void drawElements(int primitiveTopology)
@@ -79,11 +93,21 @@ namespace GraphicEngine::OpenGL
 				throw std::logic_error("Function not yet implemented");
 			}
 
+			virtual void drawElements(int primitiveTopology, const std::vector<Common::DrawElementsCommand>& commands)
+			{
+				throw std::logic_error("Function not yet implemented");
+			}
+
 			virtual void drawEdges(int primitiveTopology)
 			{
 				throw std::logic_error("Function not yet implemented");
 			}
 
+			virtual void setIndicesRange(uint32_t offset, uint32_t count)
+			{
+				throw std::logic_error("Function not yet implemented");
+			}
+
 			virtual void unbind(int dummy = 0) const override
 			{
 				glBindVertexArray(0);
@@ -100,7 +124,7 @@ namespace GraphicEngine::OpenGL
 		{
 		public:
 			_VertexBufferWithElements() {}
-			_VertexBufferWithElements(const std::vector<_Vertex>& vertices, const std::vector<uint32_t>& indices)
+			_VertexBufferWithElements(const std::vector<GpuVertex>& vertices, const std::vector<uint32_t>& indices)
 			{
 				this->m_indicesBufferSize = indices.size();
 				this->m_vertexBufferSize = vertices.size();
@@ -110,18 +134,19 @@ namespace GraphicEngine::OpenGL
 
 				this->bind();
 				glBindBuffer(GL_ARRAY_BUFFER, this->m_vbo);
-				glBufferData(GL_ARRAY_BUFFER, vertices.size() * _Vertex::getStride(), vertices.data(), GL_STATIC_DRAW);
+				glBufferData(GL_ARRAY_BUFFER, vertices.size() * GpuVertex::getStride(), vertices.data(), GL_STATIC_DRAW);
+				PROFILE_UPLOADED_BYTES(vertices.size() * GpuVertex::getStride());
 
 				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->m_ebo);
 				glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+				PROFILE_UPLOADED_BYTES(indices.size() * sizeof(uint32_t));
 
-				std::vector<std::pair<uint32_t, uint32_t>> sizesAndOffsets = _Vertex::getSizeAndOffsets();
+				constexpr auto attributes = GpuVertex::getSizeAndOffsets();
 
 				uint32_t i{ 0 };
-				for (auto sizeAndOffset : sizesAndOffsets)
+				for (const auto& attribute : attributes)
 				{
-					glEnableVertexAttribArray(i);
-					glVertexAttribPointer(i, sizeAndOffset.first, GL_FLOAT, GL_FALSE, _Vertex::getStride(), reinterpret_cast<void*>(sizeAndOffset.second));
+					setVertexAttribute(i, attribute, GpuVertex::getStride());
 					++i;
 				}
 				glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -130,25 +155,55 @@ namespace GraphicEngine::OpenGL
 
 			virtual void drawElements(int primitiveTopology) override
 			{
-				glDrawElements(primitiveTopology, this->m_indicesBufferSize, GL_UNSIGNED_INT, nullptr);
+				glDrawElements(primitiveTopology, this->m_indicesBufferSize, GL_UNSIGNED_INT, reinterpret_cast<void*>(m_indicesOffset * sizeof(uint32_t)));
+				PROFILE_DRAW_CALLS(1);
+			}
+
+			virtual void drawElements(int primitiveTopology, const std::vector<Common::DrawElementsCommand>& commands) override
+			{
+				if (commands.empty())
+					return;
+
+				if (m_indirectBuffer == 0)
+				{
+					glGenBuffers(1, &m_indirectBuffer);
+				}
+
+				// Commands change every frame, so buffer is orphaned instead of waiting for previous draw
+				glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer);
+				glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(Common::DrawElementsCommand), commands.data(), GL_STREAM_DRAW);
+				PROFILE_UPLOADED_BYTES(commands.size() * sizeof(Common::DrawElementsCommand));
+
+				glMultiDrawElementsIndirect(primitiveTopology, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(commands.size()), 0);
+				glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+				PROFILE_DRAW_CALLS(1);
+			}
+
+			virtual void setIndicesRange(uint32_t offset, uint32_t count) override
+			{
+				m_indicesOffset = offset;
+				m_indicesBufferSize = count;
 			}
 
 			virtual void draw(int primitiveTopology) override
 			{
 				glDrawArrays(primitiveTopology, 0, this->m_vertexBufferSize);
+				PROFILE_DRAW_CALLS(1);
 			}
 
 			virtual ~_VertexBufferWithElements() = default;
 		protected:
 			GLuint m_ebo;
 			uint32_t m_indicesBufferSize;
+			uint32_t m_indicesOffset{ 0 };
+			GLuint m_indirectBuffer{ 0 };
 		};
 
 		class _VertexBufferWithElementsAndEdges : public _IVerexBuffer
 		{
 		public:
 			_VertexBufferWithElementsAndEdges() = default;
-			_VertexBufferWithElementsAndEdges(const std::vector<_Vertex>& vertices, const std::vector<uint32_t>& indices, const std::vector<uint32_t>& edges)
+			_VertexBufferWithElementsAndEdges(const std::vector<GpuVertex>& vertices, const std::vector<uint32_t>& indices, const std::vector<uint32_t>& edges)
 			{
 				m_elements = std::make_unique<_VertexBufferWithElements>(vertices, indices);
 				m_edges = std::make_unique<_VertexBufferWithElements>(vertices, edges);
@@ -174,12 +229,23 @@ namespace GraphicEngine::OpenGL
 				m_elements->drawElements(primitiveTopology);
 			}
 
+			virtual void drawElements(int primitiveTopology, const std::vector<Common::DrawElementsCommand>& commands) override
+			{
+				m_elements->bind();
+				m_elements->drawElements(primitiveTopology, commands);
+			}
+
 			virtual void drawEdges(int primitiveTopology) override
 			{
 				m_edges->bind();
 				m_edges->drawElements(primitiveTopology);
 			}
 
+			virtual void setIndicesRange(uint32_t offset, uint32_t count) override
+			{
+				m_elements->setIndicesRange(offset, count);
+			}
+
 			virtual void unbind(int dummy = 0) const override
 			{
 				m_elements->unbind();
@@ -197,16 +263,16 @@ namespace GraphicEngine::OpenGL
 
 		VertexBuffer(const std::vector<VertexType>& vertices)
 		{
-			m_data = std::make_unique<_VertexBuffer>(vertices);
+			m_data = std::make_unique<_VertexBuffer>(Common::packVertices(vertices, m_positionQuantization));
 		}
 		VertexBuffer(const std::vector<_Vertex>& vertices, const std::vector<uint32_t>& indices)
 		{
-			m_data = std::make_unique<_VertexBufferWithElements>(vertices, indices);
+			m_data = std::make_unique<_VertexBufferWithElements>(Common::packVertices(vertices, m_positionQuantization), indices);
 		}
 
 		VertexBuffer(const std::vector<_Vertex>& vertices, const std::vector<uint32_t>& indices, const std::vector<uint32_t>& edges)
 		{
-			m_data = std::make_unique<_VertexBufferWithElementsAndEdges>(vertices, indices, edges);
+			m_data = std::make_unique<_VertexBufferWithElementsAndEdges>(Common::packVertices(vertices, m_positionQuantization), indices, edges);
 		}
 
 		void bind(int dummy = 0) const
@@ -224,16 +290,43 @@ namespace GraphicEngine::OpenGL
 			m_data->drawElements(primitiveTopology);
 		}
 
+		void drawElements(int primitiveTopology, const std::vector<Common::DrawElementsCommand>& commands)
+		{
+			m_data->drawElements(primitiveTopology, commands);
+		}
+
 		void drawEdges(int primitiveTopology)
 		{
 			m_data->drawEdges(primitiveTopology);
 		}
 
+		void setLods(const std::vector<std::pair<uint32_t, uint32_t>>& lods)
+		{
+			m_lods = lods;
+		}
+
+		// Levels past last one draw last one
+		void setLod(uint32_t level)
+		{
+			if (m_lods.empty())
+				return;
+
+			auto lod = m_lods[std::min<size_t>(level, m_lods.size() - 1)];
+			m_data->setIndicesRange(lod.first, lod.second);
+		}
+
 		void unbind(int dummy = 0) const
 		{
 			m_data->unbind();
 		}
+
+		glm::mat4 getDequantizationMatrix() const
+		{
+			return Core::Math::getDequantizationMatrix(m_positionQuantization);
+		}
 	private:
 		std::unique_ptr<_IVerexBuffer> m_data;
+		std::vector<std::pair<uint32_t, uint32_t>> m_lods;
+		Core::Math::PositionQuantization m_positionQuantization;
 	};
 }
@@ -3,27 +3,161 @@
 #include "../VulkanFramework.hpp"
 #include "../VulkanUniformBuffer.hpp"
 #include "../VulkanVertexBuffer.hpp"
+#include "../../../Common/PackedVertex.hpp"
+
+#include <array>
+#include <atomic>
+#include <future>
+#include <mutex>
 
 namespace GraphicEngine::Vulkan
 {
+	// Pipeline is compiled when vertex type is used for first time, so permutations of vertex types without meshes are never created
 	template <typename VertexType>
-	struct VulkanGraphicPipelineInfo
+	class VulkanGraphicPipelineInfo
 	{
+	public:
 		using vertex_type = VertexType;
-		vk::UniquePipeline graphicPipeline;
-		vk::UniquePipelineCache pipelineCache;
 		vk::UniquePipelineLayout pipelineLayout;
 
-		VulkanGraphicPipelineInfo(std::shared_ptr<VulkanFramework> framework, vk::UniqueDescriptorSetLayout& descriptorSetLayout, const std::vector<ShaderInfo>& shadersInfo, vk::PrimitiveTopology primitiveTopology,
-			bool depthBuffered = true, vk::CullModeFlags cullMode = vk::CullModeFlagBits::eNone, bool depthBoundsTestEnable = false, bool stencilTestEnable = false, vk::CompareOp depthCompareOp = vk::CompareOp::eLess)
+		VulkanGraphicPipelineInfo(std::shared_ptr<VulkanFramework> framework, vk::UniqueDescriptorSetLayout& descriptorSetLayout, const std::vector<std::shared_ptr<VulkanShader>>& shaders, vk::PrimitiveTopology primitiveTopology,
+			bool depthBuffered = true, vk::CullModeFlags cullMode = vk::CullModeFlagBits::eNone, bool depthBoundsTestEnable = false, bool stencilTestEnable = false, vk::CompareOp depthCompareOp = vk::CompareOp::eLess) :
+			VulkanGraphicPipelineInfo{ framework, { descriptorSetLayout.get() }, {}, shaders, primitiveTopology, depthBuffered, cullMode, depthBoundsTestEnable, stencilTestEnable, depthCompareOp }
+		{
+		}
+
+		// Layouts are bound as consecutive sets starting from set 0
+		VulkanGraphicPipelineInfo(std::shared_ptr<VulkanFramework> framework, const std::vector<vk::DescriptorSetLayout>& descriptorSetLayouts, const std::vector<vk::PushConstantRange>& pushConstantRanges,
+			const std::vector<std::shared_ptr<VulkanShader>>& shaders, vk::PrimitiveTopology primitiveTopology,
+			bool depthBuffered = true, vk::CullModeFlags cullMode = vk::CullModeFlagBits::eNone, bool depthBoundsTestEnable = false, bool stencilTestEnable = false, vk::CompareOp depthCompareOp = vk::CompareOp::eLess) :
+			m_framework{ framework },
+			m_shaders{ shaders },
+			m_primitiveTopology{ primitiveTopology },
+			m_depthBuffered{ depthBuffered },
+			m_cullMode{ cullMode },
+			m_depthBoundsTestEnable{ depthBoundsTestEnable },
+			m_stencilTestEnable{ stencilTestEnable },
+			m_depthCompareOp{ depthCompareOp }
+		{
+			pipelineLayout = framework->m_device->createPipelineLayoutUnique(vk::PipelineLayoutCreateInfo(vk::PipelineLayoutCreateFlags(),
+				static_cast<uint32_t>(descriptorSetLayouts.size()), descriptorSetLayouts.data(), static_cast<uint32_t>(pushConstantRanges.size()), pushConstantRanges.data()));
+			m_shadersInfo = createShadersInfo(m_shaders);
+		}
+
+		VulkanGraphicPipelineInfo(const VulkanGraphicPipelineInfo&) = delete;
+		VulkanGraphicPipelineInfo& operator=(const VulkanGraphicPipelineInfo&) = delete;
+
+		// Starts compilation on worker thread, pipelines prepared together are compiled in parallel
+		void prepare()
 		{
-			pipelineCache = framework->m_device->createPipelineCacheUnique(vk::PipelineCacheCreateInfo());
-			pipelineLayout = framework->m_device->createPipelineLayoutUnique(vk::PipelineLayoutCreateInfo(vk::PipelineLayoutCreateFlags(), 1, &descriptorSetLayout.get()));
-			graphicPipeline = createGraphicPipeline(framework->m_device, pipelineCache,
-				shadersInfo,
-				createVertexInputAttributeDescriptions(vertex_type::getSizeAndOffsets()),
-				vk::VertexInputBindingDescription(0, vertex_type::getStride()), depthBuffered, vk::FrontFace::eCounterClockwise,
-				pipelineLayout, framework->m_renderPass, framework->m_msaaSamples, primitiveTopology, cullMode, depthBoundsTestEnable, stencilTestEnable, depthCompareOp);
+			std::call_once(m_prepareFlag, [this]()
+				{
+					m_graphicPipeline = compileGraphicPipeline(m_shadersInfo);
+					m_prepared = true;
+				});
 		}
+
+		// Waits for compilation started by prepare, pipeline which was not prepared is compiled now.
+		// It can be called from several recording threads at once
+		vk::Pipeline getGraphicPipeline()
+		{
+			prepare();
+			return m_graphicPipeline.get().get();
+		}
+
+		// Called by shader compiler on its watching thread after shaders were changed, it is never called at once with swapReloaded.
+		// Pipeline which is already used is compiled here, so swap does not stall frame
+		void reload(const std::vector<std::shared_ptr<VulkanShader>>& shaders)
+		{
+			auto shadersInfo = createShadersInfo(shaders);
+			std::shared_future<vk::UniquePipeline> graphicPipeline;
+			if (m_prepared)
+			{
+				// Failed compilation throws here, so current pipeline stays in use
+				graphicPipeline = compileGraphicPipeline(shadersInfo);
+				graphicPipeline.get();
+			}
+			m_reloadedShaders = shaders;
+			m_reloadedShadersInfo = std::move(shadersInfo);
+			m_reloadedGraphicPipeline = std::move(graphicPipeline);
+		}
+
+		// Called between frames, old pipeline is kept by framework until frames recorded with it are executed
+		void swapReloaded()
+		{
+			if (m_reloadedShaders.empty())
+			{
+				return;
+			}
+
+			// Compilation uses members of this object, so it is finished before pipeline is retired
+			if (m_graphicPipeline.valid())
+			{
+				m_graphicPipeline.wait();
+			}
+			m_framework->retireResource(std::make_shared<RetiredPipeline>(RetiredPipeline{ std::move(m_shaders), std::move(m_graphicPipeline) }));
+
+			m_shaders = std::move(m_reloadedShaders);
+			m_shadersInfo = std::move(m_reloadedShadersInfo);
+			m_graphicPipeline = std::move(m_reloadedGraphicPipeline);
+			m_reloadedShaders.clear();
+			m_reloadedGraphicPipeline = {};
+
+			// Pipeline prepared after shaders were reloaded is compiled again from new ones
+			if (m_prepared && !m_graphicPipeline.valid())
+			{
+				m_graphicPipeline = compileGraphicPipeline(m_shadersInfo);
+			}
+		}
+
+	private:
+		struct RetiredPipeline
+		{
+			std::vector<std::shared_ptr<VulkanShader>> shaders;
+			std::shared_future<vk::UniquePipeline> graphicPipeline;
+		};
+
+		static std::vector<ShaderInfo> createShadersInfo(const std::vector<std::shared_ptr<VulkanShader>>& shaders)
+		{
+			std::vector<ShaderInfo> shadersInfo;
+			for (const auto& shader : shaders)
+			{
+				shadersInfo.push_back(ShaderInfo{ shader->shaderModule.get(), vk::SpecializationInfo(), shader->getVulkanShaderType() });
+			}
+			return shadersInfo;
+		}
+
+		// Starts compilation on worker thread, infos of shaders are copied because they are replaced by reload
+		std::shared_future<vk::UniquePipeline> compileGraphicPipeline(std::vector<ShaderInfo> shadersInfo)
+		{
+			return std::async(std::launch::async, [this, shadersInfo{ std::move(shadersInfo) }]()
+				{
+					return createGraphicPipeline(m_framework->m_device, m_framework->m_pipelineCache,
+						shadersInfo,
+						createVertexInputAttributeDescriptions(Common::PackedVertex<vertex_type>::type::getSizeAndOffsets()),
+						vk::VertexInputBindingDescription(0, Common::PackedVertex<vertex_type>::type::getStride()), m_depthBuffered, vk::FrontFace::eCounterClockwise,
+						pipelineLayout, m_framework->m_renderPass, m_framework->m_msaaSamples, m_primitiveTopology, m_cullMode, m_depthBoundsTestEnable, m_stencilTestEnable, m_depthCompareOp);
+				}).share();
+		}
+
+	private:
+		std::shared_ptr<VulkanFramework> m_framework;
+		// Shader modules have to live until pipeline is compiled
+		std::vector<std::shared_ptr<VulkanShader>> m_shaders;
+		std::vector<ShaderInfo> m_shadersInfo;
+		vk::PrimitiveTopology m_primitiveTopology;
+		bool m_depthBuffered;
+		vk::CullModeFlags m_cullMode;
+		bool m_depthBoundsTestEnable;
+		bool m_stencilTestEnable;
+		vk::CompareOp m_depthCompareOp;
+		std::once_flag m_prepareFlag;
+		std::atomic<bool> m_prepared{ false };
+		// Shaders and pipeline compiled by reload, they replace current ones in swapReloaded
+		std::vector<std::shared_ptr<VulkanShader>> m_reloadedShaders;
+		std::vector<ShaderInfo> m_reloadedShadersInfo;
+		// Declared last, so destruction waits for unfinished compilation before members used by it are destroyed
+		std::shared_future<vk::UniquePipeline> m_reloadedGraphicPipeline;
+		std::shared_future<vk::UniquePipeline> m_graphicPipeline;
 	};
-}
\ No newline at end of file
+}
@@ -1,6 +1,9 @@
 #include "VulkanNormalDebugGraphicPileline.hpp"
-#include "../../../Core/IO/FileReader.hpp"
-#include "../../../Core/IO/FileSystem.hpp"
+
+namespace
+{
+	const std::vector<std::string> shaderFileNames{ "normalsBindless.vert", "normals.geom", "normals.frag" };
+}
 
 GraphicEngine::Vulkan::VulkanNormalDebugGraphicPipeline::VulkanNormalDebugGraphicPipeline(std::shared_ptr<VulkanFramework> framework, std::shared_ptr<UniformBuffer<Engines::Graphic::Shaders::CameraMatrices>> cameraUniformBuffer,
 	std::shared_ptr<Services::CameraControllerManager> cameraControllerManager) :
@@ -9,99 +12,93 @@ GraphicEngine::Vulkan::VulkanNormalDebugGraphicPipeline::VulkanNormalDebugGraphi
 	m_cameraControllerManager = cameraControllerManager;
 	m_vulkanGraphicPipelines = std::make_shared<Common::EntityByVertexTypeManager<VulkanGraphicPipelineInfo>>();
 	m_cameraUniformBuffer = cameraUniformBuffer;
-	m_modelDescriptorUniformBuffer = m_framework->getUniformBuffer<UniformBufferDynamic, Engines::Graphic::Shaders::ModelMartices>(1);
-
-	alignedSize = getDynamicAligmentSize<Engines::Graphic::Shaders::ModelMartices>(m_framework->m_physicalDevice);
 
+	// Set 0 is written once, model descriptors are read from bindless set 1
 	m_descriptorSetLayout = createDescriptorSetLayout(m_framework->m_device,
-		{ {m_cameraUniformBuffer->getDescriptorType(), 1, vk::ShaderStageFlagBits::eVertex},
-		 {m_modelDescriptorUniformBuffer->getDescriptorType(), 1, vk::ShaderStageFlagBits::eVertex} },
+		{ {m_cameraUniformBuffer->getDescriptorType(), 1, vk::ShaderStageFlagBits::eVertex} },
 		vk::DescriptorSetLayoutCreateFlags());
 
 	m_descriptorPool = createDescriptorPool(m_framework->m_device,
-		{ vk::DescriptorPoolSize(m_cameraUniformBuffer->getDescriptorType(), m_framework->m_maxFrames),
-		vk::DescriptorPoolSize(m_modelDescriptorUniformBuffer->getDescriptorType(), m_framework->m_maxFrames) });
+		{ vk::DescriptorPoolSize(m_cameraUniformBuffer->getDescriptorType(), m_framework->m_maxFrames) });
 
 	std::vector<vk::DescriptorSetLayout> layouts(m_framework->m_maxFrames, m_descriptorSetLayout.get());
 
 	m_descriptorSets = m_framework->m_device->allocateDescriptorSetsUnique(vk::DescriptorSetAllocateInfo(m_descriptorPool.get(), layouts.size(), layouts.data()));
 
-	std::vector<std::shared_ptr<IUniformBuffer>> uniformBuffers{ {m_cameraUniformBuffer, m_modelDescriptorUniformBuffer} };
+	std::vector<std::shared_ptr<IUniformBuffer>> uniformBuffers{ {m_cameraUniformBuffer} };
 
 	updateDescriptorSets(m_framework->m_device, m_descriptorPool, m_descriptorSetLayout, m_framework->m_maxFrames, m_descriptorSets, uniformBuffers, {});
 
-	auto vertexShader = m_framework->getVulkanVertexShader(Core::IO::readFile<std::string>(Core::FileSystem::getVulkanShaderPath("normals.vert.spv").string()));
-	auto geometryShader = m_framework->getVulkanGeometryShader(Core::IO::readFile<std::string>(Core::FileSystem::getVulkanShaderPath("normals.geom.spv").string()));
-	auto fragmentShader = m_framework->getVulkanFragmentShader(Core::IO::readFile<std::string>(Core::FileSystem::getVulkanShaderPath("normals.frag.spv").string()));
-
-	std::vector<ShaderInfo> shaderInfos = { { ShaderInfo{ vertexShader->shaderModule.get(),vk::SpecializationInfo(), vertexShader->getVulkanShaderType() },
-											ShaderInfo{ geometryShader->shaderModule.get(),vk::SpecializationInfo(), geometryShader->getVulkanShaderType() },
-											ShaderInfo{ fragmentShader->shaderModule.get(),vk::SpecializationInfo(), fragmentShader->getVulkanShaderType() } } };
+	auto shaders = m_framework->getVulkanShaders(shaderFileNames);
+	std::vector<vk::DescriptorSetLayout> descriptorSetLayouts = { m_descriptorSetLayout.get(), m_framework->m_bindlessDescriptors->getDescriptorSetLayout().get() };
 
 	Core::Utils::for_each(Common::VertexTypesRegister::types, [&](auto vertexType)
 	{
 		if constexpr (Core::Utils::has_normal_member<decltype(vertexType)>::value)
 		{
-			auto graphicPipeline = std::make_shared<VulkanGraphicPipelineInfo<decltype(vertexType)>>(m_framework, m_descriptorSetLayout, shaderInfos, vk::PrimitiveTopology::eTriangleList);
+			auto graphicPipeline = std::make_shared<VulkanGraphicPipelineInfo<decltype(vertexType)>>(m_framework, descriptorSetLayouts, std::vector<vk::PushConstantRange>{ BindlessDescriptors::getPushConstantRange() },
+				shaders, vk::PrimitiveTopology::eTriangleList);
 			m_vulkanGraphicPipelines->addEntity(graphicPipeline);
 		}
 	});
+
+	// Pipelines of all vertex types are compiled again when any of their shaders is changed
+	m_shaderWatch = m_framework->m_shaderCompiler->watch(shaderFileNames,
+		[this]()
+		{
+			auto shaders = m_framework->getVulkanShaders(shaderFileNames);
+			m_vulkanGraphicPipelines->forEachEntity([&](const auto& graphicPipeline) { graphicPipeline->reload(shaders); });
+		},
+		[this]()
+		{
+			m_vulkanGraphicPipelines->forEachEntity([](const auto& graphicPipeline) { graphicPipeline->swapReloaded(); });
+		});
 }
 
 void GraphicEngine::Vulkan::VulkanNormalDebugGraphicPipeline::draw(vk::UniqueCommandBuffer& commandBuffer, int index)
 {
-	uint32_t offset{ 0 };
-
-	m_vertexBufferCollection->forEachEntity([&](auto vertexBufferCollection)
-	{
-		auto graphicPipeline = m_vulkanGraphicPipelines->getFirstEntity<decltype(vertexBufferCollection)::element_type::vertex_type>();
-
-		commandBuffer->bindPipeline(vk::PipelineBindPoint::eGraphics, graphicPipeline->graphicPipeline.get());
-		commandBuffer->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, graphicPipeline->pipelineLayout.get(), 0, 1, &m_descriptorSets[index].get(), 1, &offset);
-
-		vertexBufferCollection->vertexBuffer->drawElements(commandBuffer);
-
-		offset += alignedSize;
-	});
+	draw(commandBuffer, index, 0, getDrawsCount());
 }
 
-void GraphicEngine::Vulkan::VulkanNormalDebugGraphicPipeline::updateDynamicUniforms()
+uint32_t GraphicEngine::Vulkan::VulkanNormalDebugGraphicPipeline::getDrawsCount()
 {
-	uint32_t i{ 0 };
-	m_vertexBufferCollection->forEachEntity([&](auto vertexBufferCollection)
-	{
-		vertexBufferCollection->modelDescriptor.modelMatrix = vertexBufferCollection->mesh->getModelMatrix();
-		vertexBufferCollection->modelDescriptor.normalMatrix = glm::transpose(glm::inverse(m_cameraControllerManager->getActiveCamera()->getViewMatrix() * vertexBufferCollection->modelDescriptor.modelMatrix));
-		m_modelDescriptors[i] = vertexBufferCollection->modelDescriptor;
-		++i;
-	});
-	m_modelDescriptorUniformBuffer->updateAndSet(m_modelDescriptors);
+	return m_vertexBufferCollection->getEntitiesCount();
 }
 
-void GraphicEngine::Vulkan::VulkanNormalDebugGraphicPipeline::addUniformBuffer()
+void GraphicEngine::Vulkan::VulkanNormalDebugGraphicPipeline::draw(vk::UniqueCommandBuffer& commandBuffer, int index, uint32_t first, uint32_t last)
 {
-	if (m_modelDescriptors.size() > 0)
+	vk::Pipeline boundPipeline;
+
+	m_vertexBufferCollection->forEachEntityInRange(first, last, [&](const auto& vertexBufferCollection, uint32_t handle)
 	{
-		m_modelDescriptorUniformBuffer->addInstance();
+		auto graphicPipeline = m_vulkanGraphicPipelines->getFirstEntity<typename std::decay_t<decltype(vertexBufferCollection)>::element_type::vertex_type>();
+		vk::Pipeline pipeline = graphicPipeline->getGraphicPipeline();
+		if (boundPipeline != pipeline)
+		{
+			boundPipeline = pipeline;
+			commandBuffer->bindPipeline(vk::PipelineBindPoint::eGraphics, boundPipeline);
+			std::array<vk::DescriptorSet, 2> descriptorSets = { m_descriptorSets[index].get(), m_framework->m_bindlessDescriptors->getDescriptorSet(index) };
+			commandBuffer->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, graphicPipeline->pipelineLayout.get(), 0, static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
+		}
 
-		std::vector<std::shared_ptr<IUniformBuffer>> uniformBuffers{ {m_cameraUniformBuffer, m_modelDescriptorUniformBuffer} };
-		updateDescriptorSets(m_framework->m_device, m_descriptorPool, m_descriptorSetLayout, m_framework->m_maxFrames, m_descriptorSets, uniformBuffers, {});
-	}
+		BindlessPushConstants pushConstants{ vertexBufferCollection->objectIndex };
+		commandBuffer->pushConstants(graphicPipeline->pipelineLayout.get(), BindlessDescriptors::getPushConstantRange().stageFlags, 0, sizeof(BindlessPushConstants), &pushConstants);
 
-	m_modelDescriptors.resize(m_modelDescriptors.size() + 1);
+		vertexBufferCollection->vertexBuffer->drawElements(commandBuffer);
+	});
 }
 
-void GraphicEngine::Vulkan::VulkanNormalDebugGraphicPipeline::deleteUniformBuffer()
+void GraphicEngine::Vulkan::VulkanNormalDebugGraphicPipeline::updateDynamicUniforms()
 {
-	if (m_modelDescriptors.size() > 0)
+	auto viewMatrix = m_cameraControllerManager->getActiveCamera()->getViewMatrix();
+	m_vertexBufferCollection->forEachEntity([&](auto vertexBufferCollection)
 	{
-		m_modelDescriptors.resize(m_modelDescriptors.size() - 1);
-		if (m_modelDescriptors.size() > 0)
-		{
-			m_modelDescriptorUniformBuffer->deleteInstance();
+		vertexBufferCollection->modelDescriptor.modelMatrix = vertexBufferCollection->mesh->getModelMatrix() * vertexBufferCollection->vertexBuffer->getDequantizationMatrix();
+		vertexBufferCollection->modelDescriptor.normalMatrix = glm::transpose(glm::inverse(viewMatrix * vertexBufferCollection->modelDescriptor.modelMatrix));
 
-			std::vector<std::shared_ptr<IUniformBuffer>> uniformBuffers{ {m_cameraUniformBuffer, m_modelDescriptorUniformBuffer} };
-			updateDescriptorSets(m_framework->m_device, m_descriptorPool, m_descriptorSetLayout, m_framework->m_maxFrames, m_descriptorSets, uniformBuffers, {});
-		}
-	}
+		BindlessObjectData objectData;
+		objectData.modelMatrix = vertexBufferCollection->modelDescriptor.modelMatrix;
+		objectData.normalMatrix = vertexBufferCollection->modelDescriptor.normalMatrix;
+		m_framework->m_bindlessDescriptors->setObject(vertexBufferCollection->objectIndex, objectData);
+	});
 }
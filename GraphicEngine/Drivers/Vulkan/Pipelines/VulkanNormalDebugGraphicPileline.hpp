@@ -11,44 +11,56 @@ namespace GraphicEngine::Vulkan
 		VulkanNormalDebugGraphicPipeline(std::shared_ptr<VulkanFramework> framework, std::shared_ptr<UniformBuffer<Engines::Graphic::Shaders::CameraMatrices>> cameraUniformBuffer,
 			std::shared_ptr<Services::CameraControllerManager> cameraControllerManager);
 
+		// Mesh gets own slot in bindless buffer of objects, descriptor sets are not touched
 		template <typename VertexType>
 		void addVertexBuffer(std::shared_ptr<Scene::Mesh<VertexType>> mesh, std::shared_ptr<VertexBuffer<VertexType>> vertexBuffer)
 		{
-			Engines::Graphic::NormalDebugGraphicPipeline<VertexBuffer, UniformBuffer, UniformBufferDynamic, vk::UniqueCommandBuffer&, int>::addVertexBuffer(mesh, vertexBuffer);
-			addUniformBuffer();
+			auto vertexBufferCollection = produceVertexBufferCollection(mesh, vertexBuffer);
+			vertexBufferCollection->objectIndex = m_framework->m_bindlessDescriptors->addObject();
+			m_vertexBufferCollection->addEntity(vertexBufferCollection);
+			// Pipeline of vertex type starts compiling with its first mesh
+			m_vulkanGraphicPipelines->getFirstEntity<VertexType>()->prepare();
 		}
 
 		template <typename VertexType>
 		void eraseVertexBuffer(std::shared_ptr<Scene::Mesh<VertexType>> mesh)
 		{
-			Engines::Graphic::NormalDebugGraphicPipeline<VertexBuffer, UniformBuffer, UniformBufferDynamic, vk::UniqueCommandBuffer&, int>::eraseVertexBuffer(mesh);
-			deleteUniformBuffer();
+			eraseVertexBufferIf<VertexType>([&](const auto& vertexBufferCollection) { return vertexBufferCollection->mesh == mesh; });
 		}
 
 		template <typename VertexType>
 		void eraseVertexBuffer(std::shared_ptr<VertexBuffer<VertexType>> vertexBuffer)
 		{
-			Engines::Graphic::NormalDebugGraphicPipeline<VertexBuffer, UniformBuffer, UniformBufferDynamic, vk::UniqueCommandBuffer&, int>::eraseVertexBuffer(vertexBuffer);
-			deleteUniformBuffer();
+			eraseVertexBufferIf<VertexType>([&](const auto& vertexBufferCollection) { return vertexBufferCollection->vertexBuffer == vertexBuffer; });
 		}
 
 		virtual void draw(vk::UniqueCommandBuffer& commandBuffer, int index) override;
 
+		uint32_t getDrawsCount();
+
+		// Records draws [first, last), disjoint ranges can be recorded from several threads
+		void draw(vk::UniqueCommandBuffer& commandBuffer, int index, uint32_t first, uint32_t last);
+
 		void updateDynamicUniforms();
 
 	private:
-		void addUniformBuffer();
-		void deleteUniformBuffer();
+		template <typename VertexType, typename Predicate>
+		void eraseVertexBufferIf(Predicate predicate)
+		{
+			auto it = m_vertexBufferCollection->findIf<VertexType>(predicate);
+			m_framework->m_bindlessDescriptors->removeObject((*it)->objectIndex);
+			m_vertexBufferCollection->eraseEntity<VertexType>(it);
+		}
 
 	private:
 		std::shared_ptr<VulkanFramework> m_framework;
 		std::shared_ptr<Common::EntityByVertexTypeManager<VulkanGraphicPipelineInfo>> m_vulkanGraphicPipelines;
-		uint32_t alignedSize;
-		std::vector<Engines::Graphic::Shaders::ModelMartices> m_modelDescriptors;
 
 	private:
 		vk::UniqueDescriptorPool m_descriptorPool;
 		vk::UniqueDescriptorSetLayout m_descriptorSetLayout;
 		std::vector<vk::UniqueDescriptorSet> m_descriptorSets;
+		// Declared last, so reload is not called on watching thread while pipelines are destroyed
+		std::unique_ptr<ShaderWatch> m_shaderWatch;
 	};
 }
\ No newline at end of file
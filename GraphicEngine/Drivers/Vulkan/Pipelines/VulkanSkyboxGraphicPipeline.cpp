@@ -1,6 +1,9 @@
 #include "VulkanSkyboxGraphicPipeline.hpp"
-#include "../../../Core/IO/FileReader.hpp"
-#include "../../../Core/IO/FileSystem.hpp"
+
+namespace
+{
+	const std::vector<std::string> shaderFileNames{ "skybox.vert", "skybox.frag" };
+}
 
 GraphicEngine::Vulkan::VulkanSkyboxGraphicPipeline::VulkanSkyboxGraphicPipeline(std::shared_ptr<VulkanFramework> framework, std::shared_ptr<UniformBuffer<Engines::Graphic::Shaders::CameraMatrices>> cameraUniformBuffer, const std::string& basePath)
 {
@@ -25,18 +28,20 @@ GraphicEngine::Vulkan::VulkanSkyboxGraphicPipeline::VulkanSkyboxGraphicPipeline(
 
 	updateDescriptorSets(m_framework->m_device, m_descriptorPool, m_descriptorSetLayout, m_framework->m_maxFrames, m_descriptorSets, uniformBuffers, textures);
 
-	auto vertexShader = m_framework->getVulkanVertexShader(Core::IO::readFile<std::string>(Core::FileSystem::getVulkanShaderPath("skybox.vert.spv").string()));
-	auto fragmentShader = m_framework->getVulkanFragmentShader(Core::IO::readFile<std::string>(Core::FileSystem::getVulkanShaderPath("skybox.frag.spv").string()));
+	auto shaders = m_framework->getVulkanShaders(shaderFileNames);
 
-	std::vector<ShaderInfo> shaderInfos = { { ShaderInfo{ vertexShader->shaderModule.get(),vk::SpecializationInfo(), vertexShader->getVulkanShaderType() },
-											ShaderInfo{ fragmentShader->shaderModule.get(),vk::SpecializationInfo(), fragmentShader->getVulkanShaderType() } } };
+	m_graphicPipeline = std::make_unique<VulkanGraphicPipelineInfo<Common::VertexP>>(m_framework, m_descriptorSetLayout, shaders, vk::PrimitiveTopology::eTriangleList, true, vk::CullModeFlagBits::eNone, false, false, vk::CompareOp::eLessOrEqual);
+	// Skybox is always drawn, so its pipeline is compiled in background while scene is loaded
+	m_graphicPipeline->prepare();
 
-	m_graphicPipeline = std::make_unique<VulkanGraphicPipelineInfo<Common::VertexP>>(m_framework, m_descriptorSetLayout, shaderInfos, vk::PrimitiveTopology::eTriangleList, true, vk::CullModeFlagBits::eNone, false, false, vk::CompareOp::eLessOrEqual);
+	m_shaderWatch = m_framework->m_shaderCompiler->watch(shaderFileNames,
+		[this]() { m_graphicPipeline->reload(m_framework->getVulkanShaders(shaderFileNames)); },
+		[this]() { m_graphicPipeline->swapReloaded(); });
 }
 
 void GraphicEngine::Vulkan::VulkanSkyboxGraphicPipeline::draw(vk::UniqueCommandBuffer& commandBuffer, int index)
 {
-	commandBuffer->bindPipeline(vk::PipelineBindPoint::eGraphics, m_graphicPipeline->graphicPipeline.get());
+	commandBuffer->bindPipeline(vk::PipelineBindPoint::eGraphics, m_graphicPipeline->getGraphicPipeline());
 	commandBuffer->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m_graphicPipeline->pipelineLayout.get(), 0, 1, &m_descriptorSets[index].get(), 0, nullptr);
 
 	m_cubeVertexBuffer->bind(commandBuffer);
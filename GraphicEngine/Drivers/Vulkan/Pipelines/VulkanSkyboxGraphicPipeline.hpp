@@ -23,5 +23,7 @@ namespace GraphicEngine::Vulkan
 		vk::UniqueDescriptorPool m_descriptorPool;
 		vk::UniqueDescriptorSetLayout m_descriptorSetLayout;
 		std::vector<vk::UniqueDescriptorSet> m_descriptorSets;
+		// Declared last, so reload is not called on watching thread while pipelines are destroyed
+		std::unique_ptr<ShaderWatch> m_shaderWatch;
 	};
 }
\ No newline at end of file
@@ -1,15 +1,19 @@
 #include "VulkanSolidColorGraphicPipeline.hpp"
-#include "../../../Core/IO/FileReader.hpp"
-#include "../../../Core/IO/FileSystem.hpp"
 #include "../../../Core/Utils/MemberTraits.hpp"
 
+namespace
+{
+	const std::vector<std::string> shaderFileNames{ "solidBindless.vert", "solidBindless.frag" };
+}
+
 GraphicEngine::Vulkan::VulkanSolidColorGraphicPipeline::VulkanSolidColorGraphicPipeline(std::shared_ptr<VulkanFramework> framework, std::shared_ptr<UniformBuffer<Engines::Graphic::Shaders::CameraMatrices>> cameraUniformBuffer,
 	std::shared_ptr<UniformBuffer<Engines::Graphic::Shaders::Eye>> eyePositionUniformBuffer,
 	std::shared_ptr<ShaderStorageBufferObject<Engines::Graphic::Shaders::DirectionalLight>> directionalLight, std::shared_ptr<ShaderStorageBufferObject<Engines::Graphic::Shaders::PointLight>> pointLights,
 	std::shared_ptr<ShaderStorageBufferObject<Engines::Graphic::Shaders::SpotLight>> spotLight,
-	std::shared_ptr<Services::CameraControllerManager> cameraControllerManager):
+	std::shared_ptr<Services::CameraControllerManager> cameraControllerManager, std::shared_ptr<CullingPass> cullingPass):
 	Engines::Graphic::SolidColorGraphicPipeline<VertexBuffer, UniformBuffer, UniformBufferDynamic, vk::UniqueCommandBuffer&, int>{ cameraControllerManager },
-	m_framework{ framework }
+	m_framework{ framework },
+	m_cullingPass{ cullingPass }
 {
 	m_cameraUniformBuffer = cameraUniformBuffer;
 	m_eyePositionUniformBuffer = eyePositionUniformBuffer;
@@ -19,19 +23,15 @@ GraphicEngine::Vulkan::VulkanSolidColorGraphicPipeline::VulkanSolidColorGraphicP
 	m_spotLight = spotLight;
 
 	m_vulkanGraphicPipelines = std::make_shared<Common::EntityByVertexTypeManager<VulkanGraphicPipelineInfo>>();
-	
-	m_solidColorUniformBuffer = m_framework->getUniformBuffer<UniformBufferDynamic, Engines::Graphic::Shaders::SolidColorModelDescriptor>(1);
-
-	alignedSize = getDynamicAligmentSize<Engines::Graphic::Shaders::SolidColorModelDescriptor>(m_framework->m_physicalDevice);
 
+	// Set 0 is written once, model descriptors are read from bindless set 1
 	m_descriptorSetLayout = createDescriptorSetLayout(m_framework->m_device,
 		{ 
 			{ m_cameraUniformBuffer->getDescriptorType(), 1, vk::ShaderStageFlagBits::eVertex },
 			{ m_directionalLight->getDescriptorType(), 1, vk::ShaderStageFlagBits::eFragment },
 			{ m_pointLights->getDescriptorType(), 1, vk::ShaderStageFlagBits::eFragment },
 			{ m_spotLight->getDescriptorType(), 1, vk::ShaderStageFlagBits::eFragment },
-			{ m_eyePositionUniformBuffer->getDescriptorType(), 1, vk::ShaderStageFlagBits::eFragment },
-			{ m_solidColorUniformBuffer->getDescriptorType(), 1, vk::ShaderStageFlagBits::eVertex }
+			{ m_eyePositionUniformBuffer->getDescriptorType(), 1, vk::ShaderStageFlagBits::eFragment }
 		},
 		vk::DescriptorSetLayoutCreateFlags());
 
@@ -41,88 +41,84 @@ GraphicEngine::Vulkan::VulkanSolidColorGraphicPipeline::VulkanSolidColorGraphicP
 			vk::DescriptorPoolSize(m_directionalLight->getDescriptorType(), m_framework->m_maxFrames),
 			vk::DescriptorPoolSize(m_pointLights->getDescriptorType(), m_framework->m_maxFrames),
 			vk::DescriptorPoolSize(m_spotLight->getDescriptorType(), m_framework->m_maxFrames),
-			vk::DescriptorPoolSize(m_eyePositionUniformBuffer->getDescriptorType(), m_framework->m_maxFrames),
-			vk::DescriptorPoolSize(m_solidColorUniformBuffer->getDescriptorType(), m_framework->m_maxFrames) 
+			vk::DescriptorPoolSize(m_eyePositionUniformBuffer->getDescriptorType(), m_framework->m_maxFrames)
 		});
 
 	std::vector<vk::DescriptorSetLayout> layouts(m_framework->m_maxFrames, m_descriptorSetLayout.get());
 
 	m_descriptorSets = m_framework->m_device->allocateDescriptorSetsUnique(vk::DescriptorSetAllocateInfo(m_descriptorPool.get(), layouts.size(), layouts.data()));
 
-	std::vector<std::shared_ptr<IUniformBuffer>> uniformBuffers{ {m_cameraUniformBuffer, m_directionalLight, m_pointLights, m_spotLight, m_eyePositionUniformBuffer, m_solidColorUniformBuffer} };
+	std::vector<std::shared_ptr<IUniformBuffer>> uniformBuffers{ {m_cameraUniformBuffer, m_directionalLight, m_pointLights, m_spotLight, m_eyePositionUniformBuffer} };
 
 	updateDescriptorSets(m_framework->m_device, m_descriptorPool, m_descriptorSetLayout, m_framework->m_maxFrames, m_descriptorSets, uniformBuffers, {});
 
-	auto vertexShader = m_framework->getVulkanVertexShader(Core::IO::readFile<std::string>(Core::FileSystem::getVulkanShaderPath("solid.vert.spv").string()));
-	auto fragmentShader = m_framework->getVulkanFragmentShader(Core::IO::readFile<std::string>(Core::FileSystem::getVulkanShaderPath("solid.frag.spv").string()));
-
-	std::vector<ShaderInfo> shaderInfos = { { ShaderInfo{ vertexShader->shaderModule.get(),vk::SpecializationInfo(), vertexShader->getVulkanShaderType() },
-											ShaderInfo{ fragmentShader->shaderModule.get(),vk::SpecializationInfo(), fragmentShader->getVulkanShaderType() } } };
+	auto shaders = m_framework->getVulkanShaders(shaderFileNames);
+	std::vector<vk::DescriptorSetLayout> descriptorSetLayouts = { m_descriptorSetLayout.get(), m_framework->m_bindlessDescriptors->getDescriptorSetLayout().get() };
 
 	Core::Utils::for_each(Common::VertexTypesRegister::types, [&](auto vertexType)
 	{
 		if constexpr (Core::Utils::has_normal_member<decltype(vertexType)>::value)
 		{
-			auto graphicPipeline = std::make_shared<VulkanGraphicPipelineInfo<decltype(vertexType)>>(m_framework, m_descriptorSetLayout, shaderInfos, vk::PrimitiveTopology::eTriangleList);
+			auto graphicPipeline = std::make_shared<VulkanGraphicPipelineInfo<decltype(vertexType)>>(m_framework, descriptorSetLayouts, std::vector<vk::PushConstantRange>{},
+				shaders, vk::PrimitiveTopology::eTriangleList);
 			m_vulkanGraphicPipelines->addEntity(graphicPipeline);
 		}
 	});
+
+	// Pipelines of all vertex types are compiled again when any of their shaders is changed
+	m_shaderWatch = m_framework->m_shaderCompiler->watch(shaderFileNames,
+		[this]()
+		{
+			auto shaders = m_framework->getVulkanShaders(shaderFileNames);
+			m_vulkanGraphicPipelines->forEachEntity([&](const auto& graphicPipeline) { graphicPipeline->reload(shaders); });
+		},
+		[this]()
+		{
+			m_vulkanGraphicPipelines->forEachEntity([](const auto& graphicPipeline) { graphicPipeline->swapReloaded(); });
+		});
 }
 
 void GraphicEngine::Vulkan::VulkanSolidColorGraphicPipeline::draw(vk::UniqueCommandBuffer& commandBuffer, int index)
 {
-	uint32_t offset{ 0 };
-
-	m_vertexBufferCollection->forEachEntity([&](auto vertexBufferCollection)
-	{
-		auto graphicPipeline = m_vulkanGraphicPipelines->getFirstEntity<decltype(vertexBufferCollection)::element_type::vertex_type>();
-
-		commandBuffer->bindPipeline(vk::PipelineBindPoint::eGraphics, graphicPipeline->graphicPipeline.get());
-		commandBuffer->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, graphicPipeline->pipelineLayout.get(), 0, 1, &m_descriptorSets[index].get(), 1, &offset);
-
-		vertexBufferCollection->vertexBuffer->drawElements(commandBuffer);
-
-		offset += alignedSize;
-	});
+	draw(commandBuffer, index, 0, getDrawsCount());
 }
 
-void GraphicEngine::Vulkan::VulkanSolidColorGraphicPipeline::updateDynamicUniforms()
+uint32_t GraphicEngine::Vulkan::VulkanSolidColorGraphicPipeline::getDrawsCount()
 {
-	uint32_t i{ 0 };
-	m_vertexBufferCollection->forEachEntity([&](auto vertexBufferCollection)
-	{
-		vertexBufferCollection->modelDescriptor.modelMatrix = vertexBufferCollection->mesh->getModelMatrix();
-		vertexBufferCollection->modelDescriptor.normalMatrix = glm::transpose(glm::inverse(m_cameraControllerManager->getActiveCamera()->getViewMatrix() * vertexBufferCollection->modelDescriptor.modelMatrix));
-		m_solidColorModelDescriptors[i] = vertexBufferCollection->modelDescriptor;
-		++i;
-	});
-	m_solidColorUniformBuffer->updateAndSet(m_solidColorModelDescriptors);
+	return m_vulkanGraphicPipelines->getEntitiesCount();
 }
 
-void GraphicEngine::Vulkan::VulkanSolidColorGraphicPipeline::addUniformBuffer()
+void GraphicEngine::Vulkan::VulkanSolidColorGraphicPipeline::draw(vk::UniqueCommandBuffer& commandBuffer, int index, uint32_t first, uint32_t last)
 {
-	if (m_solidColorModelDescriptors.size() > 0)
-	{
-		m_solidColorUniformBuffer->addInstance();
+	vk::Buffer commandsBuffer = m_cullingPass->getCommandsBuffer(index);
+	vk::Buffer countsBuffer = m_cullingPass->getCountsBuffer(index);
 
-		std::vector<std::shared_ptr<IUniformBuffer>> uniformBuffers{ {m_cameraUniformBuffer, m_directionalLight, m_pointLights, m_spotLight, m_eyePositionUniformBuffer, m_solidColorUniformBuffer} };
-		updateDescriptorSets(m_framework->m_device, m_descriptorPool, m_descriptorSetLayout, m_framework->m_maxFrames, m_descriptorSets, uniformBuffers, {});
-	}
-
-	m_solidColorModelDescriptors.resize(m_solidColorModelDescriptors.size() + 1);
+	m_vulkanGraphicPipelines->forEachEntityInRange(first, last, [&](const auto& graphicPipeline, uint32_t handle)
+	{
+		uint32_t batch = getBatch<typename std::decay_t<decltype(graphicPipeline)>::element_type::vertex_type>();
+		uint32_t batchDrawsCount = m_cullingPass->getBatchDrawsCount(batch);
+		if (batchDrawsCount == 0)
+			return;
+
+		commandBuffer->bindPipeline(vk::PipelineBindPoint::eGraphics, graphicPipeline->getGraphicPipeline());
+		std::array<vk::DescriptorSet, 2> descriptorSets = { m_descriptorSets[index].get(), m_framework->m_bindlessDescriptors->getDescriptorSet(index) };
+		commandBuffer->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, graphicPipeline->pipelineLayout.get(), 0, static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
+		m_framework->m_meshArena->bind(commandBuffer);
+
+		// Visible draws of selected levels of all objects of batch were compacted to beginning of its commands by culling pass
+		commandBuffer->drawIndexedIndirectCount(commandsBuffer, sizeof(Common::DrawElementsCommand) * m_cullingPass->getBatchFirstCommand(batch),
+			countsBuffer, sizeof(uint32_t) * batch, batchDrawsCount, sizeof(Common::DrawElementsCommand));
+		PROFILE_DRAW_CALLS(1);
+	});
 }
 
-void GraphicEngine::Vulkan::VulkanSolidColorGraphicPipeline::deleteUniformBuffer()
+void GraphicEngine::Vulkan::VulkanSolidColorGraphicPipeline::updateDynamicUniforms()
 {
-	if (m_solidColorModelDescriptors.size() > 0)
+	m_vertexBufferCollection->forEachEntity([&](auto vertexBufferCollection)
 	{
-		m_solidColorModelDescriptors.resize(m_solidColorModelDescriptors.size() - 1);
-		if (m_solidColorModelDescriptors.size() > 0)
+		if (vertexBufferCollection->mesh->getModelMatrix() != vertexBufferCollection->meshModelMatrix || vertexBufferCollection->mesh->getMaterial().solidColor != vertexBufferCollection->solidColor)
 		{
-			m_solidColorUniformBuffer->deleteInstance();
-
-			std::vector<std::shared_ptr<IUniformBuffer>> uniformBuffers{ {m_cameraUniformBuffer, m_directionalLight, m_pointLights, m_spotLight, m_eyePositionUniformBuffer, m_solidColorUniformBuffer} };
-			updateDescriptorSets(m_framework->m_device, m_descriptorPool, m_descriptorSetLayout, m_framework->m_maxFrames, m_descriptorSets, uniformBuffers, {});
+			writeObject(*vertexBufferCollection);
 		}
-	}
+	});
 }
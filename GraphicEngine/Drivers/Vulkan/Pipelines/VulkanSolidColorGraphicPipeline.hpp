@@ -2,9 +2,11 @@
 
 #include "../../../Engines/Graphic/Pipelines/SolidColorGraphicPipeline.hpp"
 #include "VulkanGraphicPipeline.hpp"
+#include "../VulkanCullingPass.hpp"
 #include "../VulkanShaderStorageBufferObject.hpp"
 
 #include <array>
+#include <stdexcept>
 
 namespace GraphicEngine::Vulkan
 {
@@ -15,42 +17,104 @@ namespace GraphicEngine::Vulkan
 			std::shared_ptr<UniformBuffer<Engines::Graphic::Shaders::Eye>> eyePositionUniformBuffer,
 			std::shared_ptr<ShaderStorageBufferObject<Engines::Graphic::Shaders::DirectionalLight>> directionalLight, std::shared_ptr<ShaderStorageBufferObject<Engines::Graphic::Shaders::PointLight>> pointLights,
 			std::shared_ptr<ShaderStorageBufferObject<Engines::Graphic::Shaders::SpotLight>> spotLight,
-		std::shared_ptr<Services::CameraControllerManager> cameraControllerManager);
+		std::shared_ptr<Services::CameraControllerManager> cameraControllerManager, std::shared_ptr<CullingPass> cullingPass);
 
+		// Mesh gets own slot in bindless buffer of objects, descriptor sets are not touched.
+		// Draws of every level are added to culling pass in batch of vertex type, which selects level and places draws in mesh arena,
+		// bounds stay in space of mesh and are brought to space of quantized vertices
 		template <typename VertexType>
 		void addVertexBuffer(std::shared_ptr<Scene::Mesh<VertexType>> mesh, std::shared_ptr<VertexBuffer<VertexType>> vertexBuffer)
 		{
-			Engines::Graphic::SolidColorGraphicPipeline<VertexBuffer, UniformBuffer, UniformBufferDynamic, vk::UniqueCommandBuffer&, int>::addVertexBuffer(mesh, vertexBuffer);
-			addUniformBuffer();
+			auto meshAllocation = vertexBuffer->getMeshAllocation();
+			if (!meshAllocation)
+			{
+				throw std::invalid_argument("Vertex buffer is not allocated in mesh arena!");
+			}
+
+			auto vertexBufferCollection = produceVertexBufferCollection(mesh, vertexBuffer);
+			vertexBufferCollection->objectIndex = m_framework->m_bindlessDescriptors->addObject();
+
+			auto cullingObject = mesh->getCullingObject();
+			cullingObject.meshMatrix = glm::inverse(vertexBuffer->getDequantizationMatrix());
+			cullingObject.vertexOffset = meshAllocation->vertexOffset;
+			cullingObject.firstIndex = meshAllocation->firstIndex;
+			cullingObject.batch = getBatch<VertexType>();
+			std::vector<Core::Math::CullingDraw> draws;
+			for (uint32_t level{ 0 }; level < cullingObject.lodsCount; ++level)
+			{
+				auto levelDraws = mesh->getCullingDraws(level);
+				draws.insert(std::end(draws), std::begin(levelDraws), std::end(levelDraws));
+			}
+			vertexBufferCollection->cullingRange = m_cullingPass->addDraws(vertexBufferCollection->objectIndex, std::move(draws), cullingObject);
+
+			writeObject(*vertexBufferCollection);
+			m_vertexBufferCollection->addEntity(vertexBufferCollection);
+			// Pipeline of vertex type starts compiling with its first mesh
+			m_vulkanGraphicPipelines->getFirstEntity<VertexType>()->prepare();
 		}
 
 		template <typename VertexType>
 		void eraseVertexBuffer(std::shared_ptr<Scene::Mesh<VertexType>> mesh)
 		{
-			Engines::Graphic::SolidColorGraphicPipeline<VertexBuffer, UniformBuffer, UniformBufferDynamic, vk::UniqueCommandBuffer&, int>::eraseVertexBuffer(mesh);
-			deleteUniformBuffer();
+			eraseVertexBufferIf<VertexType>([&](const auto& vertexBufferCollection) { return vertexBufferCollection->mesh == mesh; });
 		}
 
 		template <typename VertexType>
 		void eraseVertexBuffer(std::shared_ptr<VertexBuffer<VertexType>> vertexBuffer)
 		{
-			Engines::Graphic::SolidColorGraphicPipeline<VertexBuffer, UniformBuffer, UniformBufferDynamic, vk::UniqueCommandBuffer&, int>::eraseVertexBuffer(vertexBuffer);
-			deleteUniformBuffer();
+			eraseVertexBufferIf<VertexType>([&](const auto& vertexBufferCollection) { return vertexBufferCollection->vertexBuffer == vertexBuffer; });
 		}
 
 		virtual void draw(vk::UniqueCommandBuffer& commandBuffer, int index) override;
 
+		// One draw of every vertex type, objects of vertex type are drawn together by indirect draw of its batch
+		uint32_t getDrawsCount();
+
+		// Records draws [first, last), disjoint ranges can be recorded from several threads
+		void draw(vk::UniqueCommandBuffer& commandBuffer, int index, uint32_t first, uint32_t last);
+
+		// Writes data of objects whose model matrix or color changed since it was written last time
 		void updateDynamicUniforms();
 
 	private:
-		void addUniformBuffer();
-		void deleteUniformBuffer();
+		static_assert(Core::Utils::TypesCount<Common::VertexTypesRegister>::value <= Core::Math::maxCullingBatches, "Every vertex type needs own batch of culling pass!");
+
+		// Batch of culling pass is index of vertex type in register
+		template <typename VertexType>
+		static uint32_t getBatch()
+		{
+			return static_cast<uint32_t>(Core::Utils::IndexOfType<VertexType, Common::VertexTypesRegister>::value);
+		}
+
+		// Normals are packed in space of mesh, so only model matrix of mesh goes to normal matrix
+		template <typename VertexBufferCollection>
+		void writeObject(VertexBufferCollection& vertexBufferCollection)
+		{
+			vertexBufferCollection.meshModelMatrix = vertexBufferCollection.mesh->getModelMatrix();
+			vertexBufferCollection.solidColor = vertexBufferCollection.mesh->getMaterial().solidColor;
+			vertexBufferCollection.modelDescriptor.modelMatrix = vertexBufferCollection.meshModelMatrix * vertexBufferCollection.vertexBuffer->getDequantizationMatrix();
+			vertexBufferCollection.modelDescriptor.normalMatrix = glm::transpose(glm::inverse(vertexBufferCollection.meshModelMatrix));
+
+			BindlessObjectData objectData;
+			objectData.modelMatrix = vertexBufferCollection.modelDescriptor.modelMatrix;
+			objectData.normalMatrix = vertexBufferCollection.modelDescriptor.normalMatrix;
+			objectData.color = vertexBufferCollection.solidColor;
+			m_framework->m_bindlessDescriptors->setObject(vertexBufferCollection.objectIndex, objectData);
+		}
+
+		template <typename VertexType, typename Predicate>
+		void eraseVertexBufferIf(Predicate predicate)
+		{
+			auto it = m_vertexBufferCollection->findIf<VertexType>(predicate);
+			m_cullingPass->removeDraws((*it)->cullingRange);
+			m_framework->m_bindlessDescriptors->removeObject((*it)->objectIndex);
+			m_vertexBufferCollection->eraseEntity<VertexType>(it);
+		}
 
 	private:
 		std::shared_ptr<VulkanFramework> m_framework;
+		std::shared_ptr<CullingPass> m_cullingPass;
 		std::shared_ptr<Common::EntityByVertexTypeManager<VulkanGraphicPipelineInfo>> m_vulkanGraphicPipelines;
-		uint32_t alignedSize;
-		std::vector<Engines::Graphic::Shaders::SolidColorModelDescriptor> m_solidColorModelDescriptors;
 		std::shared_ptr<ShaderStorageBufferObject<Engines::Graphic::Shaders::DirectionalLight>> m_directionalLight;
 		std::shared_ptr<ShaderStorageBufferObject<Engines::Graphic::Shaders::PointLight>> m_pointLights;
 		std::shared_ptr<ShaderStorageBufferObject<Engines::Graphic::Shaders::SpotLight>> m_spotLight;
@@ -59,5 +123,7 @@ namespace GraphicEngine::Vulkan
 		vk::UniqueDescriptorPool m_descriptorPool;
 		vk::UniqueDescriptorSetLayout m_descriptorSetLayout;
 		std::vector<vk::UniqueDescriptorSet> m_descriptorSets;
+		// Declared last, so reload is not called on watching thread while pipelines are destroyed
+		std::unique_ptr<ShaderWatch> m_shaderWatch;
 	};
 }
\ No newline at end of file
@@ -1,100 +1,98 @@
 #include "VulkanWireframeGraphicPipeline.h"
-#include "../../../Core/IO/FileReader.hpp"
-#include "../../../Core/IO/FileSystem.hpp"
+
+namespace
+{
+	const std::vector<std::string> shaderFileNames{ "wireframeBindless.vert", "wireframe.frag" };
+}
 
 GraphicEngine::Vulkan::VulkanWireframeGraphicPipeline::VulkanWireframeGraphicPipeline(std::shared_ptr<VulkanFramework> framework, std::shared_ptr<UniformBuffer<Engines::Graphic::Shaders::CameraMatrices>> cameraUniformBuffer) :
 	m_framework{ framework }
 {
 	m_vulkanGraphicPipelines = std::make_shared<Common::EntityByVertexTypeManager<VulkanGraphicPipelineInfo>>();
 	m_cameraUniformBuffer = cameraUniformBuffer;
-	m_wireframeModelDescriptorUniformBuffer = m_framework->getUniformBuffer<UniformBufferDynamic, Engines::Graphic::Shaders::WireframeModelDescriptor>(1);
-
-	alignedSize = getDynamicAligmentSize<Engines::Graphic::Shaders::WireframeModelDescriptor>(m_framework->m_physicalDevice);
 
+	// Set 0 is written once, model descriptors are read from bindless set 1
 	m_descriptorSetLayout = createDescriptorSetLayout(m_framework->m_device,
-		{ {m_cameraUniformBuffer->getDescriptorType(), 1, vk::ShaderStageFlagBits::eVertex},
-		 {m_wireframeModelDescriptorUniformBuffer->getDescriptorType(), 1, vk::ShaderStageFlagBits::eVertex} },
+		{ {m_cameraUniformBuffer->getDescriptorType(), 1, vk::ShaderStageFlagBits::eVertex} },
 		vk::DescriptorSetLayoutCreateFlags());
 
 	m_descriptorPool = createDescriptorPool(m_framework->m_device,
-		{ vk::DescriptorPoolSize(m_cameraUniformBuffer->getDescriptorType(), m_framework->m_maxFrames),
-		vk::DescriptorPoolSize(m_wireframeModelDescriptorUniformBuffer->getDescriptorType(), m_framework->m_maxFrames) });
+		{ vk::DescriptorPoolSize(m_cameraUniformBuffer->getDescriptorType(), m_framework->m_maxFrames) });
 
 	std::vector<vk::DescriptorSetLayout> layouts(m_framework->m_maxFrames, m_descriptorSetLayout.get());
 
 	m_descriptorSets = m_framework->m_device->allocateDescriptorSetsUnique(vk::DescriptorSetAllocateInfo(m_descriptorPool.get(), layouts.size(), layouts.data()));
 
-	std::vector<std::shared_ptr<IUniformBuffer>> uniformBuffers{ {m_cameraUniformBuffer, m_wireframeModelDescriptorUniformBuffer} };
+	std::vector<std::shared_ptr<IUniformBuffer>> uniformBuffers{ {m_cameraUniformBuffer} };
 
 	updateDescriptorSets(m_framework->m_device, m_descriptorPool, m_descriptorSetLayout, m_framework->m_maxFrames, m_descriptorSets, uniformBuffers, {});
 
-	auto vertexShader = m_framework->getVulkanVertexShader(Core::IO::readFile<std::string>(Core::FileSystem::getVulkanShaderPath("wireframe.vert.spv").string()));
-	auto fragmentShader = m_framework->getVulkanFragmentShader(Core::IO::readFile<std::string>(Core::FileSystem::getVulkanShaderPath("wireframe.frag.spv").string()));
-
-	std::vector<ShaderInfo> shaderInfos = { { ShaderInfo{ vertexShader->shaderModule.get(),vk::SpecializationInfo(), vertexShader->getVulkanShaderType() },
-											ShaderInfo{ fragmentShader->shaderModule.get(),vk::SpecializationInfo(), fragmentShader->getVulkanShaderType() } } };
+	auto shaders = m_framework->getVulkanShaders(shaderFileNames);
+	std::vector<vk::DescriptorSetLayout> descriptorSetLayouts = { m_descriptorSetLayout.get(), m_framework->m_bindlessDescriptors->getDescriptorSetLayout().get() };
 
 	Core::Utils::for_each(Common::VertexTypesRegister::types, [&](auto vertexType)
 	{
-		auto graphicPipeline = std::make_shared<VulkanGraphicPipelineInfo<decltype(vertexType)>>(m_framework, m_descriptorSetLayout, shaderInfos, vk::PrimitiveTopology::eLineList);
+		auto graphicPipeline = std::make_shared<VulkanGraphicPipelineInfo<decltype(vertexType)>>(m_framework, descriptorSetLayouts, std::vector<vk::PushConstantRange>{ BindlessDescriptors::getPushConstantRange() },
+			shaders, vk::PrimitiveTopology::eLineList);
 		m_vulkanGraphicPipelines->addEntity(graphicPipeline);
 	});
+
+	// Pipelines of all vertex types are compiled again when any of their shaders is changed
+	m_shaderWatch = m_framework->m_shaderCompiler->watch(shaderFileNames,
+		[this]()
+		{
+			auto shaders = m_framework->getVulkanShaders(shaderFileNames);
+			m_vulkanGraphicPipelines->forEachEntity([&](const auto& graphicPipeline) { graphicPipeline->reload(shaders); });
+		},
+		[this]()
+		{
+			m_vulkanGraphicPipelines->forEachEntity([](const auto& graphicPipeline) { graphicPipeline->swapReloaded(); });
+		});
 }
 
 void GraphicEngine::Vulkan::VulkanWireframeGraphicPipeline::draw(vk::UniqueCommandBuffer& commandBuffer, int index)
 {
-	uint32_t offset{ 0 };
-
-	m_vertexBufferCollection->forEachEntity([&](auto vertexBufferCollection)
-	{
-		auto graphicPipeline = m_vulkanGraphicPipelines->getFirstEntity<decltype(vertexBufferCollection)::element_type::vertex_type>();
-
-		commandBuffer->bindPipeline(vk::PipelineBindPoint::eGraphics, graphicPipeline->graphicPipeline.get());
-		commandBuffer->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, graphicPipeline->pipelineLayout.get(), 0, 1, &m_descriptorSets[index].get(), 1, &offset);
-
-		vertexBufferCollection->vertexBuffer->drawEdges(commandBuffer);
-
-		offset += alignedSize;
-	});
+	draw(commandBuffer, index, 0, getDrawsCount());
 }
 
-void GraphicEngine::Vulkan::VulkanWireframeGraphicPipeline::updateDynamicUniforms()
+uint32_t GraphicEngine::Vulkan::VulkanWireframeGraphicPipeline::getDrawsCount()
 {
-	uint32_t i{ 0 };
-	m_vertexBufferCollection->forEachEntity([&](auto vertexBufferCollection)
-	{
-		vertexBufferCollection->modelDescriptor.modelMatrix = vertexBufferCollection->mesh->getModelMatrix();
-		vertexBufferCollection->modelDescriptor.wireframeColor = glm::vec4(Core::changeContrast(glm::vec3(vertexBufferCollection->mesh->getMaterial().solidColor), glm::vec3(1.2f)), 1.0f);
-		m_wireframeModelDescriptors[i] = vertexBufferCollection->modelDescriptor;
-		++i;
-	});
-	m_wireframeModelDescriptorUniformBuffer->updateAndSet(m_wireframeModelDescriptors);
+	return m_vertexBufferCollection->getEntitiesCount();
 }
 
-void GraphicEngine::Vulkan::VulkanWireframeGraphicPipeline::addUniformBuffer()
+void GraphicEngine::Vulkan::VulkanWireframeGraphicPipeline::draw(vk::UniqueCommandBuffer& commandBuffer, int index, uint32_t first, uint32_t last)
 {
-	if (m_wireframeModelDescriptors.size() > 0)
+	vk::Pipeline boundPipeline;
+
+	m_vertexBufferCollection->forEachEntityInRange(first, last, [&](const auto& vertexBufferCollection, uint32_t handle)
 	{
-		m_wireframeModelDescriptorUniformBuffer->addInstance();
+		auto graphicPipeline = m_vulkanGraphicPipelines->getFirstEntity<typename std::decay_t<decltype(vertexBufferCollection)>::element_type::vertex_type>();
+		vk::Pipeline pipeline = graphicPipeline->getGraphicPipeline();
+		if (boundPipeline != pipeline)
+		{
+			boundPipeline = pipeline;
+			commandBuffer->bindPipeline(vk::PipelineBindPoint::eGraphics, boundPipeline);
+			std::array<vk::DescriptorSet, 2> descriptorSets = { m_descriptorSets[index].get(), m_framework->m_bindlessDescriptors->getDescriptorSet(index) };
+			commandBuffer->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, graphicPipeline->pipelineLayout.get(), 0, static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
+		}
 
-		std::vector<std::shared_ptr<IUniformBuffer>> uniformBuffers{ {m_cameraUniformBuffer, m_wireframeModelDescriptorUniformBuffer} };
-		updateDescriptorSets(m_framework->m_device, m_descriptorPool, m_descriptorSetLayout, m_framework->m_maxFrames, m_descriptorSets, uniformBuffers, {});
-	}
+		BindlessPushConstants pushConstants{ vertexBufferCollection->objectIndex };
+		commandBuffer->pushConstants(graphicPipeline->pipelineLayout.get(), BindlessDescriptors::getPushConstantRange().stageFlags, 0, sizeof(BindlessPushConstants), &pushConstants);
 
-	m_wireframeModelDescriptors.resize(m_wireframeModelDescriptors.size() + 1);
+		vertexBufferCollection->vertexBuffer->drawEdges(commandBuffer);
+	});
 }
 
-void GraphicEngine::Vulkan::VulkanWireframeGraphicPipeline::deleteUniformBuffer()
+void GraphicEngine::Vulkan::VulkanWireframeGraphicPipeline::updateDynamicUniforms()
 {
-	if (m_wireframeModelDescriptors.size() > 0)
+	m_vertexBufferCollection->forEachEntity([&](auto vertexBufferCollection)
 	{
-		m_wireframeModelDescriptors.resize(m_wireframeModelDescriptors.size() - 1);
-		if (m_wireframeModelDescriptors.size() > 0)
-		{
-			m_wireframeModelDescriptorUniformBuffer->deleteInstance();
+		vertexBufferCollection->modelDescriptor.modelMatrix = vertexBufferCollection->mesh->getModelMatrix() * vertexBufferCollection->vertexBuffer->getDequantizationMatrix();
+		vertexBufferCollection->modelDescriptor.wireframeColor = glm::vec4(Core::changeContrast(glm::vec3(vertexBufferCollection->mesh->getMaterial().solidColor), glm::vec3(1.2f)), 1.0f);
 
-			std::vector<std::shared_ptr<IUniformBuffer>> uniformBuffers{ { m_cameraUniformBuffer, m_wireframeModelDescriptorUniformBuffer } };
-			updateDescriptorSets(m_framework->m_device, m_descriptorPool, m_descriptorSetLayout, m_framework->m_maxFrames, m_descriptorSets, uniformBuffers, {});
-		}
-	}
+		BindlessObjectData objectData;
+		objectData.modelMatrix = vertexBufferCollection->modelDescriptor.modelMatrix;
+		objectData.color = vertexBufferCollection->modelDescriptor.wireframeColor;
+		m_framework->m_bindlessDescriptors->setObject(vertexBufferCollection->objectIndex, objectData);
+	});
 }
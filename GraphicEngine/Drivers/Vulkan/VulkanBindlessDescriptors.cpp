@@ -0,0 +1,139 @@
+#include "VulkanBindlessDescriptors.hpp"
+
+#include <array>
+#include <stdexcept>
+
+namespace
+{
+	constexpr uint32_t objectsBinding{ 0 };
+	constexpr uint32_t texturesBinding{ 1 };
+}
+
+GraphicEngine::Vulkan::BindlessDescriptors::BindlessDescriptors(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, uint32_t imagesCount, uint32_t maxObjects, uint32_t maxTextures) :
+	m_device{ device.get() },
+	m_objectSlots{ maxObjects },
+	m_textureSlots{ maxTextures },
+	m_objects{ physicalDevice, device, imagesCount, maxObjects },
+	m_textures(maxTextures)
+{
+	constexpr vk::ShaderStageFlags stages = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eGeometry | vk::ShaderStageFlagBits::eFragment;
+	std::array<vk::DescriptorSetLayoutBinding, 2> bindings =
+	{
+		vk::DescriptorSetLayoutBinding(objectsBinding, vk::DescriptorType::eStorageBuffer, 1, stages),
+		vk::DescriptorSetLayoutBinding(texturesBinding, vk::DescriptorType::eCombinedImageSampler, maxTextures, stages)
+	};
+
+	// Texture array is written while frames in flight use it and its unwritten elements are never read
+	std::array<vk::DescriptorBindingFlags, 2> bindingFlags =
+	{
+		vk::DescriptorBindingFlags(),
+		vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind | vk::DescriptorBindingFlagBits::eVariableDescriptorCount
+	};
+
+	vk::StructureChain<vk::DescriptorSetLayoutCreateInfo, vk::DescriptorSetLayoutBindingFlagsCreateInfo> layoutCreateInfo(
+		{ vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool, static_cast<uint32_t>(bindings.size()), bindings.data() },
+		{ static_cast<uint32_t>(bindingFlags.size()), bindingFlags.data() });
+	m_descriptorSetLayout = device->createDescriptorSetLayoutUnique(layoutCreateInfo.get<vk::DescriptorSetLayoutCreateInfo>());
+
+	std::array<vk::DescriptorPoolSize, 2> poolSizes =
+	{
+		vk::DescriptorPoolSize(vk::DescriptorType::eStorageBuffer, imagesCount),
+		vk::DescriptorPoolSize(vk::DescriptorType::eCombinedImageSampler, maxTextures * imagesCount)
+	};
+	m_descriptorPool = device->createDescriptorPoolUnique(vk::DescriptorPoolCreateInfo(vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet | vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind,
+		imagesCount, static_cast<uint32_t>(poolSizes.size()), poolSizes.data()));
+
+	std::vector<vk::DescriptorSetLayout> layouts(imagesCount, m_descriptorSetLayout.get());
+	std::vector<uint32_t> texturesCounts(imagesCount, maxTextures);
+	vk::StructureChain<vk::DescriptorSetAllocateInfo, vk::DescriptorSetVariableDescriptorCountAllocateInfo> allocateInfo(
+		{ m_descriptorPool.get(), static_cast<uint32_t>(layouts.size()), layouts.data() },
+		{ static_cast<uint32_t>(texturesCounts.size()), texturesCounts.data() });
+	m_descriptorSets = device->allocateDescriptorSetsUnique(allocateInfo.get<vk::DescriptorSetAllocateInfo>());
+
+	// Buffers of objects are bound once, changed objects are copied to their memory by update
+	for (uint32_t i{ 0 }; i < imagesCount; ++i)
+	{
+		vk::DescriptorBufferInfo bufferInfo(m_objects.getBuffer(i), 0, VK_WHOLE_SIZE);
+		vk::WriteDescriptorSet writeDescriptorSet(m_descriptorSets[i].get(), objectsBinding, 0, 1, vk::DescriptorType::eStorageBuffer, nullptr, &bufferInfo, nullptr);
+		device->updateDescriptorSets(1, &writeDescriptorSet, 0, nullptr);
+	}
+}
+
+const vk::UniqueDescriptorSetLayout& GraphicEngine::Vulkan::BindlessDescriptors::getDescriptorSetLayout() const
+{
+	return m_descriptorSetLayout;
+}
+
+vk::DescriptorSet GraphicEngine::Vulkan::BindlessDescriptors::getDescriptorSet(uint32_t imageIndex) const
+{
+	return m_descriptorSets.at(imageIndex).get();
+}
+
+vk::Buffer GraphicEngine::Vulkan::BindlessDescriptors::getObjectsBuffer(uint32_t imageIndex) const
+{
+	return m_objects.getBuffer(imageIndex);
+}
+
+uint32_t GraphicEngine::Vulkan::BindlessDescriptors::getMaxObjects() const
+{
+	return m_objectSlots.getCapacity();
+}
+
+uint32_t GraphicEngine::Vulkan::BindlessDescriptors::addObject()
+{
+	auto objectIndex = m_objectSlots.allocate();
+	if (!objectIndex)
+	{
+		throw std::runtime_error("Buffer of bindless objects is full!");
+	}
+	return *objectIndex;
+}
+
+void GraphicEngine::Vulkan::BindlessDescriptors::removeObject(uint32_t objectIndex)
+{
+	m_objectSlots.free(objectIndex);
+}
+
+void GraphicEngine::Vulkan::BindlessDescriptors::setObject(uint32_t objectIndex, const BindlessObjectData& objectData)
+{
+	if (!m_objectSlots.isAllocated(objectIndex))
+	{
+		throw std::out_of_range("Bindless object is not allocated!");
+	}
+	m_objects.set(objectIndex, objectData);
+}
+
+void GraphicEngine::Vulkan::BindlessDescriptors::update(uint32_t imageIndex)
+{
+	m_objects.update(imageIndex);
+}
+
+uint32_t GraphicEngine::Vulkan::BindlessDescriptors::addTexture(const std::shared_ptr<Texture>& texture)
+{
+	auto textureIndex = m_textureSlots.allocate();
+	if (!textureIndex)
+	{
+		throw std::runtime_error("Array of bindless textures is full!");
+	}
+	m_textures[*textureIndex] = texture;
+
+	vk::DescriptorImageInfo imageInfo(texture->sampler.get(), texture->imageView.get(), vk::ImageLayout::eShaderReadOnlyOptimal);
+	std::vector<vk::WriteDescriptorSet> writeDescriptorSets;
+	for (const auto& descriptorSet : m_descriptorSets)
+	{
+		writeDescriptorSets.push_back(vk::WriteDescriptorSet(descriptorSet.get(), texturesBinding, *textureIndex, 1, vk::DescriptorType::eCombinedImageSampler, &imageInfo, nullptr, nullptr));
+	}
+	m_device.updateDescriptorSets(static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+	return *textureIndex;
+}
+
+void GraphicEngine::Vulkan::BindlessDescriptors::removeTexture(uint32_t textureIndex)
+{
+	// Element stays written and texture is kept until slot is reused, so frames in flight can still sample it
+	m_textureSlots.free(textureIndex);
+}
+
+vk::PushConstantRange GraphicEngine::Vulkan::BindlessDescriptors::getPushConstantRange()
+{
+	return vk::PushConstantRange(vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eGeometry | vk::ShaderStageFlagBits::eFragment, 0, sizeof(BindlessPushConstants));
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "VulkanHelper.hpp"
+#include "VulkanMirroredStorageBuffer.hpp"
+#include "../../Common/SlotAllocator.hpp"
+
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace GraphicEngine::Vulkan
+{
+	// Per object data read by shaders from array indexed by push constant or instance index, layout matches std430 in shaders
+	struct BindlessObjectData
+	{
+		glm::mat4 modelMatrix{ 1.0f };
+		glm::mat4 normalMatrix{ 1.0f };
+		glm::vec4 color{ 1.0f };
+		uint32_t materialIndex{ 0 };
+		uint32_t padding[3]{};
+	};
+
+	// Pushed before each draw
+	struct BindlessPushConstants
+	{
+		uint32_t objectIndex{ 0 };
+	};
+
+	// Global descriptor set shared by pipelines. Binding 0 is storage buffer with data of all objects and binding 1 is partially bound array of textures.
+	// Adding or removing object or texture writes only its slot, so descriptor sets are never rebuilt when scene changes
+	class BindlessDescriptors
+	{
+	public:
+		// Resources used by descriptor sets are created for every swap chain image
+		BindlessDescriptors(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, uint32_t imagesCount, uint32_t maxObjects, uint32_t maxTextures);
+
+		BindlessDescriptors(const BindlessDescriptors&) = delete;
+		BindlessDescriptors& operator=(const BindlessDescriptors&) = delete;
+
+		const vk::UniqueDescriptorSetLayout& getDescriptorSetLayout() const;
+		vk::DescriptorSet getDescriptorSet(uint32_t imageIndex) const;
+		// Storage buffer with data of all objects read by frame of given image
+		vk::Buffer getObjectsBuffer(uint32_t imageIndex) const;
+		uint32_t getMaxObjects() const;
+
+		uint32_t addObject();
+		void removeObject(uint32_t objectIndex);
+		// Data is copied to buffer of every image by its next update, unchanged data is not copied
+		void setObject(uint32_t objectIndex, const BindlessObjectData& objectData);
+		// Has to be called before submission of frame of given image, buffers of other images are still read by frames in flight
+		void update(uint32_t imageIndex);
+
+		// Index of texture is used as material index of objects
+		uint32_t addTexture(const std::shared_ptr<Texture>& texture);
+		void removeTexture(uint32_t textureIndex);
+
+		static vk::PushConstantRange getPushConstantRange();
+
+	private:
+		vk::Device m_device;
+		Common::SlotAllocator m_objectSlots;
+		Common::SlotAllocator m_textureSlots;
+		MirroredStorageBuffer<BindlessObjectData> m_objects;
+		// Textures are kept alive while descriptors point to them
+		std::vector<std::shared_ptr<Texture>> m_textures;
+		vk::UniqueDescriptorSetLayout m_descriptorSetLayout;
+		vk::UniqueDescriptorPool m_descriptorPool;
+		std::vector<vk::UniqueDescriptorSet> m_descriptorSets;
+	};
+}
@@ -0,0 +1,360 @@
+#include "VulkanCullingPass.hpp"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <stdexcept>
+
+namespace
+{
+	constexpr uint32_t cullingGroupSize{ 64 };
+	constexpr uint32_t depthPyramidGroupSize{ 8 };
+	constexpr uint32_t parametersBinding{ 0 };
+	constexpr uint32_t depthPyramidBinding{ 6 };
+}
+
+GraphicEngine::Vulkan::CullingPass::CullingPass(std::shared_ptr<VulkanFramework> framework, uint32_t maxDraws, bool occlusionCulling) :
+	m_framework{ framework },
+	m_maxDraws{ maxDraws },
+	m_occlusionCulling{ occlusionCulling },
+	m_drawRanges{ maxDraws }
+{
+	if (m_maxDraws == 0)
+	{
+		throw std::invalid_argument("Culling pass needs at least one draw!");
+	}
+	// Depth is copied to pyramid by shader reading samples of multisampled image
+	if (m_occlusionCulling && m_framework->m_msaaSamples == vk::SampleCountFlagBits::e1)
+	{
+		throw std::invalid_argument("Occlusion culling needs multisampled depth buffer!");
+	}
+
+	const auto& device = m_framework->m_device;
+	uint32_t imagesCount = m_framework->m_maxFrames;
+	uint32_t maxObjects = m_framework->m_bindlessDescriptors->getMaxObjects();
+
+	m_draws = std::make_unique<MirroredStorageBuffer<Core::Math::CullingDraw>>(m_framework->m_physicalDevice, device, imagesCount, m_maxDraws);
+	m_objects = std::make_unique<MirroredStorageBuffer<Core::Math::CullingObject>>(m_framework->m_physicalDevice, device, imagesCount, maxObjects);
+
+	m_parameters = m_framework->getUniformBuffer<UniformBuffer, CullingParameters>();
+	for (uint32_t i{ 0 }; i < imagesCount; ++i)
+	{
+		m_commandsBuffers.push_back(std::make_unique<BufferData>(m_framework->m_physicalDevice, device, vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer,
+			vk::MemoryPropertyFlagBits::eDeviceLocal, static_cast<uint32_t>(sizeof(Common::DrawElementsCommand) * m_maxDraws)));
+		m_countsBuffers.push_back(std::make_unique<BufferData>(m_framework->m_physicalDevice, device,
+			vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eTransferDst,
+			vk::MemoryPropertyFlagBits::eDeviceLocal, static_cast<uint32_t>(sizeof(uint32_t) * Core::Math::maxCullingBatches)));
+	}
+	m_imageDepthPyramids.resize(imagesCount);
+	m_builtDepthPyramids.resize(imagesCount);
+
+	// Pyramid is read with texel fetches, so sampler only has to cover all levels
+	vk::SamplerCreateInfo samplerCreateInfo({}, vk::Filter::eNearest, vk::Filter::eNearest, vk::SamplerMipmapMode::eNearest,
+		vk::SamplerAddressMode::eClampToEdge, vk::SamplerAddressMode::eClampToEdge, vk::SamplerAddressMode::eClampToEdge,
+		0.0f, false, 1.0f, false, vk::CompareOp::eAlways, 0.0f, VK_LOD_CLAMP_NONE, vk::BorderColor::eFloatOpaqueWhite, false);
+	m_sampler = device->createSamplerUnique(samplerCreateInfo);
+
+	// Pyramid stays unwritten when occlusion is disabled and before first frame is rendered, shader does not read it then
+	std::array<vk::DescriptorSetLayoutBinding, 7> bindings =
+	{
+		vk::DescriptorSetLayoutBinding(parametersBinding, vk::DescriptorType::eUniformBuffer, 1, vk::ShaderStageFlagBits::eCompute),
+		vk::DescriptorSetLayoutBinding(1, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute),
+		vk::DescriptorSetLayoutBinding(2, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute),
+		vk::DescriptorSetLayoutBinding(3, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute),
+		vk::DescriptorSetLayoutBinding(4, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute),
+		vk::DescriptorSetLayoutBinding(5, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute),
+		vk::DescriptorSetLayoutBinding(depthPyramidBinding, vk::DescriptorType::eCombinedImageSampler, 1, vk::ShaderStageFlagBits::eCompute)
+	};
+	std::array<vk::DescriptorBindingFlags, 7> bindingFlags{};
+	bindingFlags[depthPyramidBinding] = vk::DescriptorBindingFlagBits::ePartiallyBound;
+
+	vk::StructureChain<vk::DescriptorSetLayoutCreateInfo, vk::DescriptorSetLayoutBindingFlagsCreateInfo> layoutCreateInfo(
+		{ vk::DescriptorSetLayoutCreateFlags(), static_cast<uint32_t>(bindings.size()), bindings.data() },
+		{ static_cast<uint32_t>(bindingFlags.size()), bindingFlags.data() });
+	m_cullingDescriptorSetLayout = device->createDescriptorSetLayoutUnique(layoutCreateInfo.get<vk::DescriptorSetLayoutCreateInfo>());
+
+	m_depthCopyDescriptorSetLayout = createDescriptorSetLayout(device,
+		{
+			{ vk::DescriptorType::eCombinedImageSampler, 1, vk::ShaderStageFlagBits::eCompute },
+			{ vk::DescriptorType::eStorageImage, 1, vk::ShaderStageFlagBits::eCompute }
+		},
+		vk::DescriptorSetLayoutCreateFlags());
+	m_depthReduceDescriptorSetLayout = createDescriptorSetLayout(device,
+		{
+			{ vk::DescriptorType::eStorageImage, 1, vk::ShaderStageFlagBits::eCompute },
+			{ vk::DescriptorType::eStorageImage, 1, vk::ShaderStageFlagBits::eCompute }
+		},
+		vk::DescriptorSetLayoutCreateFlags());
+
+	m_descriptorPool = createDescriptorPool(device,
+		{
+			vk::DescriptorPoolSize(vk::DescriptorType::eUniformBuffer, imagesCount),
+			vk::DescriptorPoolSize(vk::DescriptorType::eStorageBuffer, 5 * imagesCount),
+			vk::DescriptorPoolSize(vk::DescriptorType::eCombinedImageSampler, imagesCount)
+		});
+	std::vector<vk::DescriptorSetLayout> layouts(imagesCount, m_cullingDescriptorSetLayout.get());
+	m_descriptorSets = device->allocateDescriptorSetsUnique(vk::DescriptorSetAllocateInfo(m_descriptorPool.get(), static_cast<uint32_t>(layouts.size()), layouts.data()));
+
+	for (uint32_t i{ 0 }; i < imagesCount; ++i)
+	{
+		std::array<vk::DescriptorBufferInfo, 6> bufferInfos =
+		{
+			vk::DescriptorBufferInfo(m_parameters->bufferData[i]->buffer.get(), 0, VK_WHOLE_SIZE),
+			vk::DescriptorBufferInfo(m_draws->getBuffer(i), 0, VK_WHOLE_SIZE),
+			vk::DescriptorBufferInfo(m_framework->m_bindlessDescriptors->getObjectsBuffer(i), 0, VK_WHOLE_SIZE),
+			vk::DescriptorBufferInfo(m_objects->getBuffer(i), 0, VK_WHOLE_SIZE),
+			vk::DescriptorBufferInfo(m_commandsBuffers[i]->buffer.get(), 0, VK_WHOLE_SIZE),
+			vk::DescriptorBufferInfo(m_countsBuffers[i]->buffer.get(), 0, VK_WHOLE_SIZE)
+		};
+
+		std::vector<vk::WriteDescriptorSet> writeDescriptorSets;
+		for (uint32_t binding{ 0 }; binding < bufferInfos.size(); ++binding)
+		{
+			writeDescriptorSets.push_back(vk::WriteDescriptorSet(m_descriptorSets[i].get(), binding, 0, 1,
+				binding == parametersBinding ? vk::DescriptorType::eUniformBuffer : vk::DescriptorType::eStorageBuffer, nullptr, &bufferInfos[binding], nullptr));
+		}
+		device->updateDescriptorSets(static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+	}
+
+	m_cullingPipelineLayout = device->createPipelineLayoutUnique(vk::PipelineLayoutCreateInfo(vk::PipelineLayoutCreateFlags(), 1, &m_cullingDescriptorSetLayout.get(), 0, nullptr));
+	m_cullingPipeline = createComputePipeline("cull.comp", m_cullingPipelineLayout);
+
+	if (m_occlusionCulling)
+	{
+		m_depthCopyPipelineLayout = device->createPipelineLayoutUnique(vk::PipelineLayoutCreateInfo(vk::PipelineLayoutCreateFlags(), 1, &m_depthCopyDescriptorSetLayout.get(), 0, nullptr));
+		m_depthReducePipelineLayout = device->createPipelineLayoutUnique(vk::PipelineLayoutCreateInfo(vk::PipelineLayoutCreateFlags(), 1, &m_depthReduceDescriptorSetLayout.get(), 0, nullptr));
+		m_depthCopyPipeline = createComputePipeline("depthPyramidCopy.comp", m_depthCopyPipelineLayout);
+		m_depthReducePipeline = createComputePipeline("depthPyramid.comp", m_depthReducePipelineLayout);
+	}
+}
+
+uint32_t GraphicEngine::Vulkan::CullingPass::addDraws(uint32_t objectIndex, std::vector<Core::Math::CullingDraw> draws, const Core::Math::CullingObject& object)
+{
+	if (draws.empty())
+	{
+		throw std::invalid_argument("Object has no draws to cull!");
+	}
+	if (object.batch >= Core::Math::maxCullingBatches)
+	{
+		throw std::out_of_range("Batch of culling object does not exist!");
+	}
+	uint32_t count = static_cast<uint32_t>(draws.size());
+
+	auto firstDraw = m_drawRanges.allocate(count);
+	if (!firstDraw)
+	{
+		throw std::runtime_error("Buffer of culling draws is full!");
+	}
+	m_batchDrawsCounts[object.batch] += count;
+
+	m_objects->set(objectIndex, object);
+	for (uint32_t i{ 0 }; i < count; ++i)
+	{
+		draws[i].objectIndex = objectIndex;
+		m_draws->set(*firstDraw + i, draws[i]);
+	}
+	return *firstDraw;
+}
+
+void GraphicEngine::Vulkan::CullingPass::removeDraws(uint32_t firstDraw)
+{
+	uint32_t count = m_drawRanges.getCount(firstDraw);
+	m_drawRanges.free(firstDraw);
+	m_batchDrawsCounts[m_objects->get(m_draws->get(firstDraw).objectIndex).batch] -= count;
+
+	// Buffers of frames in flight are not touched, removed draws are skipped by next frames of every image
+	Core::Math::CullingDraw removedDraw;
+	removedDraw.objectIndex = Core::Math::removedCullingObject;
+	for (uint32_t i{ 0 }; i < count; ++i)
+	{
+		m_draws->set(firstDraw + i, removedDraw);
+	}
+}
+
+uint32_t GraphicEngine::Vulkan::CullingPass::getBatchFirstCommand(uint32_t batch) const
+{
+	return std::accumulate(std::begin(m_batchDrawsCounts), std::begin(m_batchDrawsCounts) + batch, 0u);
+}
+
+uint32_t GraphicEngine::Vulkan::CullingPass::getBatchDrawsCount(uint32_t batch) const
+{
+	return m_batchDrawsCounts.at(batch);
+}
+
+void GraphicEngine::Vulkan::CullingPass::recordCulling(const vk::UniqueCommandBuffer& commandBuffer, uint32_t imageIndex, const glm::mat4& viewProjection, glm::vec3 eyePosition)
+{
+	uint32_t drawsCount = m_drawRanges.getEnd();
+	if (drawsCount == 0)
+		return;
+
+	m_draws->update(imageIndex);
+	m_objects->update(imageIndex);
+
+	CullingParameters parameters;
+	parameters.viewProjection = viewProjection;
+	parameters.eyePosition = glm::vec4(eyePosition, 1.0f);
+	parameters.drawsCount = drawsCount;
+	for (uint32_t batch{ 0 }; batch < Core::Math::maxCullingBatches; ++batch)
+	{
+		parameters.batchFirstCommands[batch / 4][batch % 4] = getBatchFirstCommand(batch);
+	}
+	if (m_depthPyramid && m_depthPyramid->built)
+	{
+		if (m_imageDepthPyramids[imageIndex] != m_depthPyramid)
+		{
+			writeDepthPyramid(imageIndex, m_depthPyramid);
+		}
+		parameters.depthPyramidViewProjection = m_depthPyramid->viewProjection;
+		parameters.depthPyramidSize = glm::uvec2(m_depthPyramid->extent.width, m_depthPyramid->extent.height);
+		parameters.depthPyramidLevels = m_depthPyramid->levelsCount;
+	}
+	m_parameters->updateAndSet(parameters);
+
+	vk::Buffer countsBuffer = m_countsBuffers[imageIndex]->buffer.get();
+	commandBuffer->fillBuffer(countsBuffer, 0, sizeof(uint32_t) * Core::Math::maxCullingBatches, 0);
+	vk::BufferMemoryBarrier countsBarrier(vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite,
+		VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, countsBuffer, 0, VK_WHOLE_SIZE);
+	commandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eComputeShader, vk::DependencyFlags(), 0, nullptr, 1, &countsBarrier, 0, nullptr);
+
+	commandBuffer->bindPipeline(vk::PipelineBindPoint::eCompute, m_cullingPipeline.get());
+	commandBuffer->bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_cullingPipelineLayout.get(), 0, 1, &m_descriptorSets[imageIndex].get(), 0, nullptr);
+	commandBuffer->dispatch((drawsCount + cullingGroupSize - 1) / cullingGroupSize, 1, 1);
+
+	vk::MemoryBarrier commandsBarrier(vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eIndirectCommandRead);
+	commandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eDrawIndirect, vk::DependencyFlags(), 1, &commandsBarrier, 0, nullptr, 0, nullptr);
+}
+
+void GraphicEngine::Vulkan::CullingPass::recordDepthPyramid(const vk::UniqueCommandBuffer& commandBuffer, uint32_t imageIndex, const glm::mat4& viewProjection)
+{
+	if (!m_occlusionCulling)
+		return;
+
+	if (!m_depthPyramid || m_depthPyramid->depthImageView != m_framework->m_depthBuffer->imageView.get() || m_depthPyramid->extent != m_framework->m_swapChainData.extent)
+	{
+		m_depthPyramid = createDepthPyramid();
+	}
+	// Frame which builds pyramid keeps it alive as well
+	m_builtDepthPyramids[imageIndex] = m_depthPyramid;
+
+	// Depth written by render pass is read by copy, culling of this frame has to finish before pyramid is overwritten
+	std::vector<vk::ImageMemoryBarrier> imageBarriers =
+	{
+		vk::ImageMemoryBarrier(vk::AccessFlagBits::eDepthStencilAttachmentWrite, vk::AccessFlagBits::eShaderRead,
+			vk::ImageLayout::eDepthStencilAttachmentOptimal, vk::ImageLayout::eDepthStencilReadOnlyOptimal, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+			m_framework->m_depthBuffer->image.get(), vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eDepth, 0, 1, 0, 1))
+	};
+	if (!m_depthPyramid->built)
+	{
+		imageBarriers.push_back(vk::ImageMemoryBarrier(vk::AccessFlags(), vk::AccessFlagBits::eShaderWrite,
+			vk::ImageLayout::eUndefined, vk::ImageLayout::eGeneral, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+			m_depthPyramid->image->image.get(), vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, m_depthPyramid->levelsCount, 0, 1)));
+	}
+	commandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eLateFragmentTests | vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eComputeShader,
+		vk::DependencyFlags(), 0, nullptr, 0, nullptr, static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+
+	vk::MemoryBarrier levelBarrier(vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eShaderRead);
+	for (uint32_t level{ 0 }; level < m_depthPyramid->levelsCount; ++level)
+	{
+		if (level > 0)
+		{
+			commandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eComputeShader, vk::DependencyFlags(), 1, &levelBarrier, 0, nullptr, 0, nullptr);
+		}
+
+		const auto& pipeline = (level == 0) ? m_depthCopyPipeline : m_depthReducePipeline;
+		const auto& pipelineLayout = (level == 0) ? m_depthCopyPipelineLayout : m_depthReducePipelineLayout;
+		commandBuffer->bindPipeline(vk::PipelineBindPoint::eCompute, pipeline.get());
+		commandBuffer->bindDescriptorSets(vk::PipelineBindPoint::eCompute, pipelineLayout.get(), 0, 1, &m_depthPyramid->descriptorSets[level].get(), 0, nullptr);
+
+		uint32_t width = std::max(1u, m_depthPyramid->extent.width >> level);
+		uint32_t height = std::max(1u, m_depthPyramid->extent.height >> level);
+		commandBuffer->dispatch((width + depthPyramidGroupSize - 1) / depthPyramidGroupSize, (height + depthPyramidGroupSize - 1) / depthPyramidGroupSize, 1);
+	}
+
+	// Pyramid is read by culling of next frame and its render pass writes depth only after copy has read it
+	commandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader,
+		vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eEarlyFragmentTests | vk::PipelineStageFlagBits::eLateFragmentTests | vk::PipelineStageFlagBits::eColorAttachmentOutput,
+		vk::DependencyFlags(), 1, &levelBarrier, 0, nullptr, 0, nullptr);
+
+	m_depthPyramid->built = true;
+	m_depthPyramid->viewProjection = viewProjection;
+}
+
+vk::Buffer GraphicEngine::Vulkan::CullingPass::getCommandsBuffer(uint32_t imageIndex) const
+{
+	return m_commandsBuffers.at(imageIndex)->buffer.get();
+}
+
+vk::Buffer GraphicEngine::Vulkan::CullingPass::getCountsBuffer(uint32_t imageIndex) const
+{
+	return m_countsBuffers.at(imageIndex)->buffer.get();
+}
+
+std::shared_ptr<GraphicEngine::Vulkan::CullingPass::DepthPyramid> GraphicEngine::Vulkan::CullingPass::createDepthPyramid()
+{
+	const auto& device = m_framework->m_device;
+	auto depthPyramid = std::make_shared<DepthPyramid>();
+	depthPyramid->depthImageView = m_framework->m_depthBuffer->imageView.get();
+	depthPyramid->extent = m_framework->m_swapChainData.extent;
+
+	// Levels are halved and rounded down like mip levels, so last one has single texel
+	uint32_t size = std::max(depthPyramid->extent.width, depthPyramid->extent.height);
+	while (size >> depthPyramid->levelsCount)
+	{
+		++depthPyramid->levelsCount;
+	}
+
+	depthPyramid->image = std::make_unique<ImageData>(m_framework->m_physicalDevice, device, vk::Extent3D(depthPyramid->extent, 1), vk::Format::eR32Sfloat, vk::SampleCountFlagBits::e1,
+		vk::MemoryPropertyFlagBits::eDeviceLocal, vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled, vk::ImageTiling::eOptimal,
+		depthPyramid->levelsCount, 1, vk::ImageLayout::eUndefined, vk::ImageAspectFlagBits::eColor);
+	for (uint32_t level{ 0 }; level < depthPyramid->levelsCount; ++level)
+	{
+		depthPyramid->levelViews.push_back(device->createImageViewUnique(vk::ImageViewCreateInfo(vk::ImageViewCreateFlags(), depthPyramid->image->image.get(),
+			vk::ImageViewType::e2D, vk::Format::eR32Sfloat, vk::ComponentMapping(), vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, level, 1, 0, 1))));
+	}
+
+	depthPyramid->descriptorPool = createDescriptorPool(device,
+		{
+			vk::DescriptorPoolSize(vk::DescriptorType::eCombinedImageSampler, 1),
+			vk::DescriptorPoolSize(vk::DescriptorType::eStorageImage, 2 * depthPyramid->levelsCount - 1)
+		});
+	std::vector<vk::DescriptorSetLayout> layouts(depthPyramid->levelsCount, m_depthReduceDescriptorSetLayout.get());
+	layouts[0] = m_depthCopyDescriptorSetLayout.get();
+	depthPyramid->descriptorSets = device->allocateDescriptorSetsUnique(vk::DescriptorSetAllocateInfo(depthPyramid->descriptorPool.get(), static_cast<uint32_t>(layouts.size()), layouts.data()));
+
+	vk::DescriptorImageInfo depthInfo(m_sampler.get(), depthPyramid->depthImageView, vk::ImageLayout::eDepthStencilReadOnlyOptimal);
+	std::vector<vk::DescriptorImageInfo> levelInfos;
+	for (const auto& levelView : depthPyramid->levelViews)
+	{
+		levelInfos.push_back(vk::DescriptorImageInfo(vk::Sampler(), levelView.get(), vk::ImageLayout::eGeneral));
+	}
+
+	std::vector<vk::WriteDescriptorSet> writeDescriptorSets =
+	{
+		vk::WriteDescriptorSet(depthPyramid->descriptorSets[0].get(), 0, 0, 1, vk::DescriptorType::eCombinedImageSampler, &depthInfo, nullptr, nullptr),
+		vk::WriteDescriptorSet(depthPyramid->descriptorSets[0].get(), 1, 0, 1, vk::DescriptorType::eStorageImage, &levelInfos[0], nullptr, nullptr)
+	};
+	for (uint32_t level{ 1 }; level < depthPyramid->levelsCount; ++level)
+	{
+		writeDescriptorSets.push_back(vk::WriteDescriptorSet(depthPyramid->descriptorSets[level].get(), 0, 0, 1, vk::DescriptorType::eStorageImage, &levelInfos[level - 1], nullptr, nullptr));
+		writeDescriptorSets.push_back(vk::WriteDescriptorSet(depthPyramid->descriptorSets[level].get(), 1, 0, 1, vk::DescriptorType::eStorageImage, &levelInfos[level], nullptr, nullptr));
+	}
+	device->updateDescriptorSets(static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+	return depthPyramid;
+}
+
+void GraphicEngine::Vulkan::CullingPass::writeDepthPyramid(uint32_t imageIndex, const std::shared_ptr<DepthPyramid>& depthPyramid)
+{
+	// Frame which used set of this image is finished, so it can be written and its previous pyramid released
+	vk::DescriptorImageInfo imageInfo(m_sampler.get(), depthPyramid->image->imageView.get(), vk::ImageLayout::eGeneral);
+	vk::WriteDescriptorSet writeDescriptorSet(m_descriptorSets[imageIndex].get(), depthPyramidBinding, 0, 1, vk::DescriptorType::eCombinedImageSampler, &imageInfo, nullptr, nullptr);
+	m_framework->m_device->updateDescriptorSets(1, &writeDescriptorSet, 0, nullptr);
+	m_imageDepthPyramids[imageIndex] = depthPyramid;
+}
+
+vk::UniquePipeline GraphicEngine::Vulkan::CullingPass::createComputePipeline(const std::string& shaderName, const vk::UniquePipelineLayout& pipelineLayout)
+{
+	auto shader = m_framework->getVulkanComputeShader(m_framework->m_shaderCompiler->getSpirv(shaderName));
+	vk::PipelineShaderStageCreateInfo shaderStageCreateInfo(vk::PipelineShaderStageCreateFlags(), vk::ShaderStageFlagBits::eCompute, shader->shaderModule.get(), "main");
+	return m_framework->m_device->createComputePipelineUnique(m_framework->m_pipelineCache.get(),
+		vk::ComputePipelineCreateInfo(vk::PipelineCreateFlags(), shaderStageCreateInfo, pipelineLayout.get())).value;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "VulkanFramework.hpp"
+#include "VulkanMirroredStorageBuffer.hpp"
+#include "VulkanUniformBuffer.hpp"
+#include "../../Common/RangeAllocator.hpp"
+#include "../../Core/Math/DrawCulling.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace GraphicEngine::Vulkan
+{
+	// Uniforms of cull.comp, layout matches std140 block of shader
+	struct CullingParameters
+	{
+		glm::mat4 viewProjection{ 1.0f };
+		glm::mat4 depthPyramidViewProjection{ 1.0f };
+		glm::vec4 eyePosition{ 0.0f };
+		glm::uvec2 depthPyramidSize{ 0 };
+		// Zero disables occlusion test
+		uint32_t depthPyramidLevels{ 0 };
+		uint32_t drawsCount{ 0 };
+		// First command of every batch, four in each element like std140 array of shader
+		glm::uvec4 batchFirstCommands[Core::Math::maxCullingBatches / 4]{};
+	};
+
+	static_assert(sizeof(CullingParameters) == 224, "Culling parameters have to match layout of shader");
+
+	// Compute pass which selects level of detail of every object and tests its draws against frustum, cones of meshlets and depth pyramid of previous frame.
+	// Every batch occupies contiguous range of commands, visible draws of its objects are compacted to its beginning and their number is written
+	// to counts buffer at index of batch, so all objects of batch are drawn by one indirect draw with count
+	class CullingPass
+	{
+	public:
+		// Occlusion test builds depth pyramid from depth buffer of framework, so it has to be multisampled and created with sampled usage
+		CullingPass(std::shared_ptr<VulkanFramework> framework, uint32_t maxDraws, bool occlusionCulling);
+
+		CullingPass(const CullingPass&) = delete;
+		CullingPass& operator=(const CullingPass&) = delete;
+
+		// Draws of all levels of object are culled with model matrix of bindless object multiplied by mesh matrix of culling object.
+		// Returns first draw of range which identifies it
+		uint32_t addDraws(uint32_t objectIndex, std::vector<Core::Math::CullingDraw> draws, const Core::Math::CullingObject& object);
+		// Draws of range are skipped from now on and range is reused by next added draws
+		void removeDraws(uint32_t firstDraw);
+
+		// Commands of batch start at this offset in commands buffer, room is kept for all draws of its objects
+		uint32_t getBatchFirstCommand(uint32_t batch) const;
+		uint32_t getBatchDrawsCount(uint32_t batch) const;
+
+		// Has to be recorded outside of render pass before draws which read commands, draws and objects changed since last frame of image are copied to its buffers
+		void recordCulling(const vk::UniqueCommandBuffer& commandBuffer, uint32_t imageIndex, const glm::mat4& viewProjection, glm::vec3 eyePosition);
+		// Has to be recorded after render pass, pyramid is read by culling of next frame together with view projection depth was rendered with
+		void recordDepthPyramid(const vk::UniqueCommandBuffer& commandBuffer, uint32_t imageIndex, const glm::mat4& viewProjection);
+
+		vk::Buffer getCommandsBuffer(uint32_t imageIndex) const;
+		vk::Buffer getCountsBuffer(uint32_t imageIndex) const;
+
+	private:
+		// Levels of pyramid are mip levels of one image kept in general layout
+		struct DepthPyramid
+		{
+			// Depth buffer from which pyramid is built, it is recreated when framework replaces depth buffer
+			vk::ImageView depthImageView;
+			vk::Extent2D extent;
+			uint32_t levelsCount{ 0 };
+			std::unique_ptr<ImageData> image;
+			std::vector<vk::UniqueImageView> levelViews;
+			// Declared before sets, so they are freed before pool is destroyed
+			vk::UniqueDescriptorPool descriptorPool;
+			// Set of each level reads previous level, first one reads depth buffer
+			std::vector<vk::UniqueDescriptorSet> descriptorSets;
+			// Culling reads pyramid only after it was built once, with view projection of frame it was built in
+			bool built{ false };
+			glm::mat4 viewProjection{ 1.0f };
+		};
+
+		std::shared_ptr<DepthPyramid> createDepthPyramid();
+		void writeDepthPyramid(uint32_t imageIndex, const std::shared_ptr<DepthPyramid>& depthPyramid);
+		vk::UniquePipeline createComputePipeline(const std::string& shaderName, const vk::UniquePipelineLayout& pipelineLayout);
+
+	private:
+		std::shared_ptr<VulkanFramework> m_framework;
+		uint32_t m_maxDraws;
+		bool m_occlusionCulling;
+
+		// Draws and objects are written by CPU when objects are added or removed, every image has own copy of them
+		std::unique_ptr<MirroredStorageBuffer<Core::Math::CullingDraw>> m_draws;
+		std::unique_ptr<MirroredStorageBuffer<Core::Math::CullingObject>> m_objects;
+		Common::RangeAllocator m_drawRanges;
+		std::array<uint32_t, Core::Math::maxCullingBatches> m_batchDrawsCounts{};
+
+		std::shared_ptr<UniformBuffer<CullingParameters>> m_parameters;
+		std::vector<std::unique_ptr<BufferData>> m_commandsBuffers;
+		std::vector<std::unique_ptr<BufferData>> m_countsBuffers;
+		// Pyramid written to set of each image is kept until that image is recorded again, so frames in flight can still read old one
+		std::vector<std::shared_ptr<DepthPyramid>> m_imageDepthPyramids;
+		// Pyramid built by frame of each image is kept in same way
+		std::vector<std::shared_ptr<DepthPyramid>> m_builtDepthPyramids;
+		std::shared_ptr<DepthPyramid> m_depthPyramid;
+
+		vk::UniqueSampler m_sampler;
+		vk::UniqueDescriptorSetLayout m_cullingDescriptorSetLayout;
+		vk::UniqueDescriptorSetLayout m_depthCopyDescriptorSetLayout;
+		vk::UniqueDescriptorSetLayout m_depthReduceDescriptorSetLayout;
+		vk::UniqueDescriptorPool m_descriptorPool;
+		std::vector<vk::UniqueDescriptorSet> m_descriptorSets;
+		vk::UniquePipelineLayout m_cullingPipelineLayout;
+		vk::UniquePipelineLayout m_depthCopyPipelineLayout;
+		vk::UniquePipelineLayout m_depthReducePipelineLayout;
+		vk::UniquePipeline m_cullingPipeline;
+		vk::UniquePipeline m_depthCopyPipeline;
+		vk::UniquePipeline m_depthReducePipeline;
+	};
+}
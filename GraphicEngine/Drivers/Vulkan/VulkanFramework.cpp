@@ -1,7 +1,21 @@
 #include "VulkanFramework.hpp"
+#include "../../Core/IO/FileReader.hpp"
+#include "../../Core/IO/FileSystem.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
 
 #undef max
 
+namespace
+{
+	// Allocations bigger than half of block get own device memory
+	constexpr uint64_t memoryBlockSize{ 64 * 1024 * 1024 };
+	// Uploads bigger than quarter of staging buffer are split
+	constexpr uint32_t stagingBufferSize{ 32 * 1024 * 1024 };
+}
+
 GraphicEngine::Vulkan::VulkanFramework::VulkanFramework():
 	VulkanShaderFactory{ this }
 {
@@ -25,7 +39,7 @@ GraphicEngine::Vulkan::VulkanFramework& GraphicEngine::Vulkan::VulkanFramework::
 	m_logger = std::move(logger);
 	m_logger->debug(__FILE__, __LINE__, __FUNCTION__, "Initialize Vulkan Framework");
 
-	m_instance = createUniqueInstance(m_appName, m_engineName, m_validationLayers, m_vulkanWindowContext->getRequiredExtensions(), VK_API_VERSION_1_1);
+	m_instance = createUniqueInstance(m_appName, m_engineName, m_validationLayers, m_vulkanWindowContext->getRequiredExtensions(), VK_API_VERSION_1_2);
 	{
 		auto surface = m_vulkanWindowContext->createSurface(m_instance);
 		vk::ObjectDestroy<vk::Instance, VULKAN_HPP_DEFAULT_DISPATCHER_TYPE> _deleter(m_instance.get());
@@ -34,14 +48,60 @@ GraphicEngine::Vulkan::VulkanFramework& GraphicEngine::Vulkan::VulkanFramework::
 	}
 	m_physicalDevice = getPhysicalDevice(m_instance, m_surface);
 	m_device = getUniqueLogicalDevice(m_physicalDevice, m_surface);
+	m_memoryAllocator = std::make_shared<DeviceMemoryAllocator>(VulkanMemoryDevice(m_physicalDevice, m_device.get()), memoryBlockSize);
+	setDeviceMemoryAllocator(m_device, m_memoryAllocator);
 	m_indices = findGraphicAndPresentQueueFamilyIndices(m_physicalDevice, m_surface);
 
 	m_graphicQueue = m_device->getQueue(m_indices.graphicsFamily.value(), 0);
 	m_presentQueue = m_device->getQueue(m_indices.presentFamily.value(), 0);
+	m_transferQueue = m_device->getQueue(m_indices.transferFamily.value(), 0);
+
+	m_transferBatcher = std::make_shared<TransferBatcher>(m_physicalDevice, m_device, m_indices, m_transferQueue, stagingBufferSize);
+	setDeviceTransferBatcher(m_device, m_transferBatcher);
+
+	m_pipelineCache = m_device->createPipelineCacheUnique(vk::PipelineCacheCreateInfo());
 
 	return *this;
 }
 
+GraphicEngine::Vulkan::VulkanFramework& GraphicEngine::Vulkan::VulkanFramework::setSwapChainImageUsage(vk::ImageUsageFlags imageUsage)
+{
+	m_swapChainImageUsage = vk::ImageUsageFlagBits::eColorAttachment | imageUsage;
+	return *this;
+}
+
+GraphicEngine::Vulkan::VulkanFramework& GraphicEngine::Vulkan::VulkanFramework::setDepthBufferUsage(vk::ImageUsageFlags imageUsage)
+{
+	m_depthBufferUsage = imageUsage;
+	return *this;
+}
+
+GraphicEngine::Vulkan::VulkanFramework& GraphicEngine::Vulkan::VulkanFramework::setFramesInFlight(uint32_t framesInFlight)
+{
+	if (framesInFlight == 0)
+	{
+		throw std::invalid_argument("At least one frame has to be in flight!");
+	}
+	m_framesInFlight = framesInFlight;
+	return *this;
+}
+
+GraphicEngine::Vulkan::VulkanFramework& GraphicEngine::Vulkan::VulkanFramework::setRecordingThreads(uint32_t recordingThreads)
+{
+	if (recordingThreads == 0)
+	{
+		throw std::invalid_argument("At least one thread has to record command buffers!");
+	}
+	m_recordingThreads = recordingThreads;
+	return *this;
+}
+
+GraphicEngine::Vulkan::VulkanFramework& GraphicEngine::Vulkan::VulkanFramework::setPresentMode(vk::PresentModeKHR presentMode)
+{
+	m_presentMode = presentMode;
+	return *this;
+}
+
 GraphicEngine::Vulkan::VulkanFramework& GraphicEngine::Vulkan::VulkanFramework::initializeFramebuffer(int width, int height)
 {
 	m_logger->debug(__FILE__, __LINE__, __FUNCTION__, "Initialize frame buffer. Width {}, Height {}", width, height);
@@ -50,18 +110,17 @@ GraphicEngine::Vulkan::VulkanFramework& GraphicEngine::Vulkan::VulkanFramework::
 	this->m_height = height;
 	
 	m_device->waitIdle();
-	m_swapChainData = SwapChainData(m_physicalDevice, m_device, m_surface, m_indices, frameBufferSize, m_swapChainData.swapChain, vk::ImageUsageFlagBits::eColorAttachment);
+	m_retiredSwapChains.clear();
+	m_swapChainData = SwapChainData(m_physicalDevice, m_device, m_surface, m_indices, frameBufferSize, m_swapChainData.swapChain, m_swapChainImageUsage, m_presentMode);
 	m_maxFrames = m_swapChainData.images.size();
+	if (m_renderingBarriers)
+	{
+		m_renderingBarriers->imagesInFlight.assign(m_maxFrames, vk::Fence());
+	}
+	m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Swap chain with {} images, present mode {}", m_maxFrames, vk::to_string(m_swapChainData.presentMode));
 
-	m_commandBuffers = m_device->allocateCommandBuffersUnique(vk::CommandBufferAllocateInfo(m_commandPool.get(), vk::CommandBufferLevel::ePrimary, m_maxFrames));
-
-	m_depthBuffer = std::make_unique<DepthBufferData>(m_physicalDevice, m_device, vk::Extent3D(frameBufferSize, 1), findDepthFormat(m_physicalDevice), m_msaaSamples);
-	m_renderPass = createRenderPass(m_device, m_swapChainData.format, m_depthBuffer->format, m_msaaSamples);
-	m_image = std::make_unique<ImageData>(m_physicalDevice, m_device,
-		vk::Extent3D(m_swapChainData.extent, 1), m_swapChainData.format, m_msaaSamples,
-		vk::MemoryPropertyFlagBits::eDeviceLocal, vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransientAttachment,
-		vk::ImageTiling::eOptimal, 1, 1, vk::ImageLayout::eUndefined, vk::ImageAspectFlagBits::eColor);
-	m_frameBuffers = createFrameBuffers(m_device, m_renderPass, m_swapChainData.extent, 1, m_image->imageView, m_depthBuffer->imageView, m_swapChainData.imageViews);
+	m_renderPass = createRenderPass(m_device, m_swapChainData.format, findDepthFormat(m_physicalDevice), m_msaaSamples);
+	createFramebufferAttachments();
 
 	return *this;
 }
@@ -71,96 +130,308 @@ GraphicEngine::Vulkan::VulkanFramework& GraphicEngine::Vulkan::VulkanFramework::
 	return this->initializeFramebuffer(m_width, m_height);
 }
 
+bool GraphicEngine::Vulkan::VulkanFramework::recreateSwapChain(int width, int height)
+{
+	// Minimized window has zero extent, swap chain is recreated again when window is restored
+	vk::Extent2D surfaceExtent = m_physicalDevice.getSurfaceCapabilitiesKHR(m_surface.get()).currentExtent;
+	if (width == 0 || height == 0 || surfaceExtent.width == 0 || surfaceExtent.height == 0)
+	{
+		return false;
+	}
+	m_logger->debug(__FILE__, __LINE__, __FUNCTION__, "Recreate swap chain. Width {}, Height {}", width, height);
+	m_width = width;
+	m_height = height;
+
+	// Old swap chain is passed to new one, so presentation engine can reuse its resources and images already acquired from it can still be presented
+	SwapChainData swapChainData(m_physicalDevice, m_device, m_surface, m_indices, vk::Extent2D(width, height), m_swapChainData.swapChain, m_swapChainImageUsage,
+		m_presentMode, static_cast<uint32_t>(m_swapChainData.images.size()));
+	// Render pass and resources created for every image are kept, so pipelines and descriptor sets are not rebuilt
+	if (swapChainData.images.size() != m_maxFrames)
+	{
+		throw std::runtime_error("Recreated swap chain has different number of images!");
+	}
+	if (swapChainData.format != m_swapChainData.format)
+	{
+		throw std::runtime_error("Recreated swap chain has different format!");
+	}
+
+	m_retiredSwapChains.push_back(RetiredSwapChain{ m_submittedFrames, std::move(m_swapChainData), std::move(m_depthBuffer), std::move(m_image), std::move(m_frameBuffers) });
+	m_swapChainData = std::move(swapChainData);
+	createFramebufferAttachments();
+	m_renderingBarriers->imagesInFlight.assign(m_maxFrames, vk::Fence());
+
+	return true;
+}
+
+bool GraphicEngine::Vulkan::VulkanFramework::recreateSwapChain()
+{
+	return recreateSwapChain(m_width, m_height);
+}
+
 GraphicEngine::Vulkan::VulkanFramework& GraphicEngine::Vulkan::VulkanFramework::initializeCommandBuffer()
 {
 	m_commandPool = createUniqueCommandPool(m_device, m_indices);
-	m_commandBuffers = m_device->allocateCommandBuffersUnique(vk::CommandBufferAllocateInfo(m_commandPool.get(), vk::CommandBufferLevel::ePrimary, m_maxFrames));
+
+	// Command buffers are recorded again every frame, so whole pool is reset instead of single buffers
+	// Buffers are freed before their pools are destroyed
+	m_secondaryCommandBuffers.clear();
+	m_secondaryCommandPools.clear();
+	m_commandBuffers.clear();
+	m_frameCommandPools.clear();
+	for (uint32_t i{ 0 }; i < m_framesInFlight; ++i)
+	{
+		m_frameCommandPools.push_back(createUniqueCommandPool(m_device, m_indices, vk::CommandPoolCreateFlagBits::eTransient));
+		auto commandBuffers = m_device->allocateCommandBuffersUnique(vk::CommandBufferAllocateInfo(m_frameCommandPools.back().get(), vk::CommandBufferLevel::ePrimary, 1));
+		m_commandBuffers.push_back(std::move(commandBuffers.front()));
+
+		m_secondaryCommandPools.emplace_back();
+		m_secondaryCommandBuffers.emplace_back();
+		for (uint32_t j{ 0 }; j <= m_recordingThreads; ++j)
+		{
+			m_secondaryCommandPools.back().push_back(createUniqueCommandPool(m_device, m_indices, vk::CommandPoolCreateFlagBits::eTransient));
+			auto secondaryCommandBuffers = m_device->allocateCommandBuffersUnique(vk::CommandBufferAllocateInfo(m_secondaryCommandPools.back().back().get(), vk::CommandBufferLevel::eSecondary, 1));
+			m_secondaryCommandBuffers.back().push_back(std::move(secondaryCommandBuffers.front()));
+		}
+	}
 
 	return *this;
 }
 
 GraphicEngine::Vulkan::VulkanFramework& GraphicEngine::Vulkan::VulkanFramework::initalizeRenderingBarriers()
 {
-	m_renderingBarriers = std::make_unique<RenderingBarriers>(m_device, m_maxFrames);
+	m_renderingBarriers = std::make_unique<RenderingBarriers>(m_device, m_framesInFlight, m_maxFrames);
+	m_frameNumbers.assign(m_framesInFlight, 0);
 
 	return *this;
 }
 
-bool GraphicEngine::Vulkan::VulkanFramework::acquireFrame()
+GraphicEngine::Vulkan::VulkanFramework& GraphicEngine::Vulkan::VulkanFramework::initializeBindlessDescriptors(uint32_t maxObjects, uint32_t maxTextures)
+{
+	m_bindlessDescriptors = std::make_shared<BindlessDescriptors>(m_physicalDevice, m_device, m_maxFrames, maxObjects, maxTextures);
+	m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Bindless descriptors for {} objects and {} textures", maxObjects, maxTextures);
+
+	return *this;
+}
+
+GraphicEngine::Vulkan::VulkanFramework& GraphicEngine::Vulkan::VulkanFramework::initializeMeshArena(uint32_t verticesSize, uint32_t maxIndices)
+{
+	m_meshArena = std::make_shared<MeshArena>(m_physicalDevice, m_device, m_transferBatcher, verticesSize, maxIndices);
+	setDeviceMeshArena(m_device, m_meshArena);
+	m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Mesh arena with {} bytes of vertices and {} indices", verticesSize, maxIndices);
+
+	return *this;
+}
+
+GraphicEngine::Vulkan::VulkanFramework& GraphicEngine::Vulkan::VulkanFramework::initializePipelineCache(const std::string& path)
 {
+	m_pipelineCachePath = path;
+	if (!std::filesystem::exists(path))
+	{
+		m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Pipeline cache {} does not exist, pipelines are compiled from scratch", path);
+		return *this;
+	}
+
+	auto data = Core::IO::readFile<std::string>(path);
+	auto properties = m_physicalDevice.getProperties();
+	std::array<uint8_t, VK_UUID_SIZE> pipelineCacheUuid;
+	std::copy(std::begin(properties.pipelineCacheUUID), std::end(properties.pipelineCacheUUID), std::begin(pipelineCacheUuid));
+	if (!isPipelineCacheCompatible(data, properties.vendorID, properties.deviceID, pipelineCacheUuid))
+	{
+		m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Pipeline cache {} was saved by other device or driver, it is discarded", path);
+		return *this;
+	}
+
+	m_pipelineCache = m_device->createPipelineCacheUnique(vk::PipelineCacheCreateInfo(vk::PipelineCacheCreateFlags(), data.size(), data.data()));
+	m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Pipeline cache loaded from {}, {} bytes", path, data.size());
+	return *this;
+}
+
+void GraphicEngine::Vulkan::VulkanFramework::savePipelineCache()
+{
+	if (m_pipelineCachePath.empty() || !m_pipelineCache)
+	{
+		return;
+	}
+
+	auto data = m_device->getPipelineCacheData(m_pipelineCache.get());
+	std::filesystem::path path{ m_pipelineCachePath };
+	if (path.has_parent_path())
+	{
+		std::filesystem::create_directories(path.parent_path());
+	}
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		throw std::runtime_error("Failed when open file: " + m_pipelineCachePath);
+	}
+	file.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+GraphicEngine::Vulkan::VulkanFramework& GraphicEngine::Vulkan::VulkanFramework::initializeShaderCompiler(const std::string& cachePath)
+{
+	m_shaderCompiler = std::make_shared<ShaderCompiler>(Core::FileSystem::getOpenGlShaderPath(), cachePath, std::make_unique<Core::Logger<ShaderCompiler>>());
+	return *this;
+}
+
+void GraphicEngine::Vulkan::VulkanFramework::retireResource(std::shared_ptr<void> resource)
+{
+	m_retiredResources.push_back(RetiredResource{ m_submittedFrames, std::move(resource) });
+}
+
+GraphicEngine::Vulkan::VulkanFramework::~VulkanFramework()
+{
+	// Cache is saved at exit, so it contains pipelines of all vertex types used during run
 	try
 	{
-		m_device->waitForFences(1, &(m_renderingBarriers->inFlightFences[m_currentFrameIndex].get()), true, std::numeric_limits<uint64_t>::max());
-		m_imageIndex = m_device->acquireNextImageKHR(m_swapChainData.swapChain.get(), std::numeric_limits<uint64_t>::max(), m_renderingBarriers->imageAvailableSemaphores[m_currentFrameIndex].get(), vk::Fence());
+		savePipelineCache();
+	}
+	catch (std::exception& err)
+	{
+		m_logger->error(__FILE__, __LINE__, __FUNCTION__, "Failed to save pipeline cache: {}", err.what());
+	}
+}
+
+bool GraphicEngine::Vulkan::VulkanFramework::acquireFrame()
+{
+	m_device->waitForFences(1, &(m_renderingBarriers->inFlightFences[m_currentFrameIndex].get()), true, std::numeric_limits<uint64_t>::max());
+	// Fence is signaled after all earlier submissions to queue, so every frame up to its one is completed
+	m_completedFrames = std::max(m_completedFrames, m_frameNumbers[m_currentFrameIndex]);
+	releaseRetiredSwapChains();
+	releaseRetiredResources();
 
-		if (m_imageIndex.result == vk::Result::eErrorOutOfDateKHR)
+	while (true)
+	{
+		try
 		{
-			// Should recreate swapchain
-			return false;
+			m_imageIndex = m_device->acquireNextImageKHR(m_swapChainData.swapChain.get(), std::numeric_limits<uint64_t>::max(), m_renderingBarriers->imageAvailableSemaphores[m_currentFrameIndex].get(), vk::Fence());
+			break;
 		}
-
-		else if (m_imageIndex.result != vk::Result::eSuccess && m_imageIndex.result != vk::Result::eSuboptimalKHR)
+		catch (vk::OutOfDateKHRError&)
 		{
-			throw std::runtime_error("Failed to acquire next image!");
+			// Semaphore is not signaled by failed acquire, so image is acquired again from recreated swap chain and frame is not dropped
+			if (!recreateSwapChain())
+			{
+				return false;
+			}
 		}
+	}
+
+	if (m_imageIndex.result != vk::Result::eSuccess && m_imageIndex.result != vk::Result::eSuboptimalKHR)
+	{
+		throw std::runtime_error("Failed to acquire next image!");
+	}
 
-		if (m_renderingBarriers->imagesInFlight[m_imageIndex.value] != vk::Fence())
-			m_device->waitForFences(1, &(m_renderingBarriers->imagesInFlight[m_imageIndex.value]), true, std::numeric_limits<uint64_t>::max());
+	if (m_renderingBarriers->imagesInFlight[m_imageIndex.value] != vk::Fence())
+		m_device->waitForFences(1, &(m_renderingBarriers->imagesInFlight[m_imageIndex.value]), true, std::numeric_limits<uint64_t>::max());
 
-		m_renderingBarriers->imagesInFlight[m_imageIndex.value] = m_renderingBarriers->inFlightFences[m_currentFrameIndex].get();
+	m_renderingBarriers->imagesInFlight[m_imageIndex.value] = m_renderingBarriers->inFlightFences[m_currentFrameIndex].get();
 
-		m_device->resetFences(1, &(m_renderingBarriers->inFlightFences[m_currentFrameIndex].get()));
-	}
-	catch (vk::OutOfDateKHRError err)
+	m_device->resetFences(1, &(m_renderingBarriers->inFlightFences[m_currentFrameIndex].get()));
+	m_device->resetCommandPool(m_frameCommandPools[m_currentFrameIndex].get(), vk::CommandPoolResetFlags());
+	for (auto& commandPool : m_secondaryCommandPools[m_currentFrameIndex])
 	{
-		// Should recreate swapchain
-		return false;
+		m_device->resetCommandPool(commandPool.get(), vk::CommandPoolResetFlags());
 	}
 	return true;
 }
 
 bool GraphicEngine::Vulkan::VulkanFramework::submitFrame()
 {
-	try
+	// Value of binary semaphore is ignored
+	std::array<vk::Semaphore, 2> waitSemaphores = { m_renderingBarriers->imageAvailableSemaphores[m_currentFrameIndex].get(), m_transferBatcher->getSemaphore() };
+	std::array<uint64_t, 2> waitValues = { 0, m_transferBatcher->flush() };
+	std::array<vk::PipelineStageFlags, 2> pipelineStageFlags = { vk::PipelineStageFlagBits::eColorAttachmentOutput, vk::PipelineStageFlagBits::eVertexInput };
+	vk::Semaphore signalSemaphore(m_renderingBarriers->renderFinishedSemaphores[m_currentFrameIndex].get());
+	vk::TimelineSemaphoreSubmitInfo timelineSubmitInfo(static_cast<uint32_t>(waitValues.size()), waitValues.data(), 0, nullptr);
+	vk::SubmitInfo submitInfo(static_cast<uint32_t>(waitSemaphores.size()), waitSemaphores.data(), pipelineStageFlags.data(), 1, &(m_commandBuffers[m_currentFrameIndex].get()), 1, &signalSemaphore);
+	submitInfo.pNext = &timelineSubmitInfo;
+	vk::Result submitResult = m_graphicQueue.submit(1, &submitInfo, m_renderingBarriers->inFlightFences[m_currentFrameIndex].get());
+	if (submitResult != vk::Result::eSuccess)
 	{
-		vk::Semaphore waitSemaphore(m_renderingBarriers->imageAvailableSemaphores[m_currentFrameIndex].get());
-		vk::Semaphore signalSemaphore(m_renderingBarriers->renderFinishedSemaphores[m_currentFrameIndex].get());
-		vk::PipelineStageFlags pipelineStageFlags(vk::PipelineStageFlagBits::eColorAttachmentOutput);
-		vk::SubmitInfo submitInfo(1, &waitSemaphore, &pipelineStageFlags, 1, &(m_commandBuffers[m_imageIndex.value].get()), 1, &signalSemaphore);
-		vk::Result submitResult = m_graphicQueue.submit(1, &submitInfo, m_renderingBarriers->inFlightFences[m_currentFrameIndex].get());
-		if (submitResult != vk::Result::eSuccess)
+		throw std::runtime_error("Failed to submit draw command buffer!");
+	}
+	m_frameNumbers[m_currentFrameIndex] = ++m_submittedFrames;
+	// Meshes removed up to now may still be drawn by this frame
+	if (m_meshArena)
+	{
+		if (auto freedRanges = m_meshArena->retireFreedRanges())
 		{
-			throw std::runtime_error("Failed to submit draw command buffer!");
+			retireResource(freedRanges);
 		}
+	}
 
-		vk::SwapchainKHR sp(m_swapChainData.swapChain.get());
-
-		vk::PresentInfoKHR presentInfo(1, &signalSemaphore, 1, &sp, &m_imageIndex.value);
+	vk::SwapchainKHR sp(m_swapChainData.swapChain.get());
 
-		vk::Result presentResult = m_presentQueue.presentKHR(presentInfo);
+	vk::PresentInfoKHR presentInfo(1, &signalSemaphore, 1, &sp, &m_imageIndex.value);
 
-		if (presentResult == vk::Result::eErrorOutOfDateKHR || presentResult == vk::Result::eSuboptimalKHR)
-		{
-			// Should recreate swapchain
-			return false;
-		}
-		else if (m_imageIndex.result != vk::Result::eSuccess)
-		{
-			throw std::runtime_error("failed to present swap chain image!");
-		}
+	vk::Result presentResult;
+	try
+	{
+		presentResult = m_presentQueue.presentKHR(presentInfo);
 	}
-
-	catch (vk::OutOfDateKHRError err)
+	catch (vk::OutOfDateKHRError&)
 	{
-		// Should recreate swapchain
-		return false;
+		presentResult = vk::Result::eErrorOutOfDateKHR;
 	}
-
 	m_currentFrameIndex = calculateNextIndex();
+
+	if (presentResult == vk::Result::eErrorOutOfDateKHR || presentResult == vk::Result::eSuboptimalKHR)
+	{
+		// Frame is already submitted, new swap chain is used from next frame
+		recreateSwapChain();
+	}
+	else if (presentResult != vk::Result::eSuccess)
+	{
+		throw std::runtime_error("failed to present swap chain image!");
+	}
 	return true;
 }
 
+vk::UniqueCommandBuffer& GraphicEngine::Vulkan::VulkanFramework::getFrameCommandBuffer()
+{
+	return m_commandBuffers[m_currentFrameIndex];
+}
+
+void GraphicEngine::Vulkan::VulkanFramework::logMemoryStatistics()
+{
+	auto statistics = m_memoryAllocator->getStatistics();
+	m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Device memory: {} allocations in {} blocks and {} dedicated allocations, {} of {} bytes used, fragmentation {}",
+		statistics.allocationsCount, statistics.blocksCount, statistics.dedicatedAllocationsCount, statistics.usedBytes, statistics.reservedBytes, statistics.fragmentation);
+}
+
+std::vector<vk::UniqueCommandBuffer>& GraphicEngine::Vulkan::VulkanFramework::getFrameSecondaryCommandBuffers()
+{
+	return m_secondaryCommandBuffers[m_currentFrameIndex];
+}
+
 uint32_t GraphicEngine::Vulkan::VulkanFramework::calculateNextIndex()
 {
-	return (m_currentFrameIndex + 1) % m_maxFrames;
+	return (m_currentFrameIndex + 1) % m_framesInFlight;
+}
+
+void GraphicEngine::Vulkan::VulkanFramework::createFramebufferAttachments()
+{
+	m_depthBuffer = std::make_unique<DepthBufferData>(m_physicalDevice, m_device, vk::Extent3D(m_swapChainData.extent, 1), findDepthFormat(m_physicalDevice), m_msaaSamples, m_depthBufferUsage);
+	m_image = std::make_unique<ImageData>(m_physicalDevice, m_device,
+		vk::Extent3D(m_swapChainData.extent, 1), m_swapChainData.format, m_msaaSamples,
+		vk::MemoryPropertyFlagBits::eDeviceLocal, vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransientAttachment,
+		vk::ImageTiling::eOptimal, 1, 1, vk::ImageLayout::eUndefined, vk::ImageAspectFlagBits::eColor);
+	m_frameBuffers = createFrameBuffers(m_device, m_renderPass, m_swapChainData.extent, 1, m_image->imageView, m_depthBuffer->imageView, m_swapChainData.imageViews);
+}
+
+void GraphicEngine::Vulkan::VulkanFramework::releaseRetiredSwapChains()
+{
+	while (!m_retiredSwapChains.empty() && m_retiredSwapChains.front().lastFrame <= m_completedFrames)
+	{
+		m_retiredSwapChains.pop_front();
+	}
+}
+
+void GraphicEngine::Vulkan::VulkanFramework::releaseRetiredResources()
+{
+	while (!m_retiredResources.empty() && m_retiredResources.front().lastFrame <= m_completedFrames)
+	{
+		m_retiredResources.pop_front();
+	}
 }
\ No newline at end of file
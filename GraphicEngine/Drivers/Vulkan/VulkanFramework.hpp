@@ -1,10 +1,17 @@
 #pragma once
 
+#include "VulkanBindlessDescriptors.hpp"
 #include "VulkanHelper.hpp"
+#include "VulkanMeshArena.hpp"
+#include "VulkanPipelineCache.hpp"
+#include "VulkanShaderCompiler.hpp"
+#include "VulkanTransferBatcher.hpp"
 #include "VulkanWindowContext.hpp"
 #include "VulkanShaderFactory.hpp"
 #include "../../Core/Logger.hpp"
 
+#include <deque>
+
 namespace GraphicEngine::Vulkan
 {
 	class VulkanFramework : public VulkanShaderFactory
@@ -21,27 +28,96 @@ namespace GraphicEngine::Vulkan
 			const std::vector<std::string>& validationLayers,
 			std::unique_ptr<Core::Logger<VulkanFramework>> logger);
 
+		// Swap chain images are created with given usage in addition to color attachment, has to be set before framebuffer initialization
+		VulkanFramework& setSwapChainImageUsage(vk::ImageUsageFlags imageUsage);
+
+		// Depth buffer is created with given usage in addition to depth attachment, has to be set before framebuffer initialization
+		VulkanFramework& setDepthBufferUsage(vk::ImageUsageFlags imageUsage);
+
+		// Number of frames recorded by CPU while GPU still works on previous ones, has to be set before command buffer initialization
+		VulkanFramework& setFramesInFlight(uint32_t framesInFlight);
+
+		// Number of threads recording secondary command buffers of one frame, has to be set before command buffer initialization
+		VulkanFramework& setRecordingThreads(uint32_t recordingThreads);
+
+		// Present mode used when surface supports it, otherwise mailbox, immediate and fifo are tried. Swap chain is recreated with it on next resize
+		VulkanFramework& setPresentMode(vk::PresentModeKHR presentMode);
+
 		VulkanFramework& initializeFramebuffer(int width, int height);
 		VulkanFramework& initializeFramebuffer();
 
+		// Creates new swap chain from current one without waiting for device, resources of old one are destroyed when frames using them are finished.
+		// Returns false when window is minimized and swap chain can not be created
+		bool recreateSwapChain(int width, int height);
+		bool recreateSwapChain();
+
 		VulkanFramework& initializeCommandBuffer();
 		
 		VulkanFramework& initalizeRenderingBarriers();
 
+		// Global descriptor set of objects and textures used by pipelines, has to be initialized after framebuffer
+		VulkanFramework& initializeBindlessDescriptors(uint32_t maxObjects, uint32_t maxTextures);
+
+		// Vertex and index buffers shared by meshes, vertex buffers created after it are placed in it
+		VulkanFramework& initializeMeshArena(uint32_t verticesSize, uint32_t maxIndices);
+
+		// Pipeline cache is loaded from given file when it was saved by same device and driver, and it is saved back on destruction
+		VulkanFramework& initializePipelineCache(const std::string& path);
+
+		void savePipelineCache();
+
+		// GLSL shaders are compiled at runtime and SPIR-V is cached in given directory
+		VulkanFramework& initializeShaderCompiler(const std::string& cachePath);
+
+		// Resource used by submitted frames, e.g. pipeline replaced by shader reload, is kept until they are executed by GPU
+		void retireResource(std::shared_ptr<void> resource);
+
+		// Waits until command buffer of current frame is executed and resets its pool, so it can be recorded again.
+		// Out of date swap chain is recreated and image is acquired from new one, false is returned only when window is minimized
 		bool acquireFrame();
+		// Pending uploads are submitted first and frame waits for them before reading vertices.
+		// Swap chain reported as out of date or suboptimal by presentation is recreated before next frame
 		bool submitFrame();
 
+		vk::UniqueCommandBuffer& getFrameCommandBuffer();
+
+		void logMemoryStatistics();
+
+		// One secondary command buffer for every recording thread and last one for commands recorded by main thread
+		std::vector<vk::UniqueCommandBuffer>& getFrameSecondaryCommandBuffers();
+
 		template <template <typename> typename UniformBuffer, typename T, typename... Args>
 		std::shared_ptr<UniformBuffer<T>> getUniformBuffer(Args... args)
 		{
 			return std::make_shared<UniformBuffer<T>>(this, args...);
 		}
 
-		virtual ~VulkanFramework() = default;
+		virtual ~VulkanFramework();
 	protected:
 
 	private:
 		uint32_t calculateNextIndex();
+		void createFramebufferAttachments();
+		void releaseRetiredSwapChains();
+		void releaseRetiredResources();
+
+		// Swap chain replaced by recreation with resources rendering to its images
+		struct RetiredSwapChain
+		{
+			// Number of last frame submitted before retirement
+			uint64_t lastFrame;
+			SwapChainData swapChainData;
+			std::unique_ptr<DepthBufferData> depthBuffer;
+			std::unique_ptr<ImageData> image;
+			std::vector<vk::UniqueFramebuffer> frameBuffers;
+		};
+
+		struct RetiredResource
+		{
+			// Number of last frame submitted before retirement
+			uint64_t lastFrame;
+			std::shared_ptr<void> resource;
+		};
 
 	public:
 		std::shared_ptr<VulkanWindowContext> m_vulkanWindowContext;
@@ -50,8 +126,18 @@ namespace GraphicEngine::Vulkan
 		vk::PhysicalDevice m_physicalDevice;
 		vk::UniqueSurfaceKHR m_surface;
 		vk::UniqueDevice m_device;
+		// Declared after device, so its blocks are freed before device is destroyed
+		std::shared_ptr<DeviceMemoryAllocator> m_memoryAllocator;
 		vk::Queue m_graphicQueue;
 		vk::Queue m_presentQueue;
+		vk::Queue m_transferQueue;
+		// Declared after memory allocator, so it waits for copies before staging buffer is freed
+		std::shared_ptr<TransferBatcher> m_transferBatcher;
+		std::shared_ptr<MeshArena> m_meshArena;
+		// Shared by all pipelines, driver synchronizes access to it, so pipelines can be created from several threads
+		vk::UniquePipelineCache m_pipelineCache;
+		std::shared_ptr<BindlessDescriptors> m_bindlessDescriptors;
+		std::shared_ptr<ShaderCompiler> m_shaderCompiler;
 
 		SwapChainData m_swapChainData;
 		std::unique_ptr<DepthBufferData> m_depthBuffer;
@@ -59,20 +145,39 @@ namespace GraphicEngine::Vulkan
 		std::unique_ptr<ImageData> m_image;
 		std::vector<vk::UniqueFramebuffer> m_frameBuffers;
 
+		// Pool for single time commands, every frame in flight has own pool with one command buffer
 		vk::UniqueCommandPool m_commandPool;
+		std::vector<vk::UniqueCommandPool> m_frameCommandPools;
 		std::vector<vk::UniqueCommandBuffer> m_commandBuffers;
+		// Command pools can not be used from several threads at once, so every secondary command buffer has own pool
+		std::vector<std::vector<vk::UniqueCommandPool>> m_secondaryCommandPools;
+		std::vector<std::vector<vk::UniqueCommandBuffer>> m_secondaryCommandBuffers;
 
 		std::unique_ptr<RenderingBarriers> m_renderingBarriers;
 
 	private:
 		std::string m_appName;
 		std::string m_engineName;
+		std::string m_pipelineCachePath;
 		int m_width;
 		int m_height;
+		std::deque<RetiredSwapChain> m_retiredSwapChains;
+		std::deque<RetiredResource> m_retiredResources;
+		// Frames are counted from one, frames up to completed one were executed by GPU
+		uint64_t m_submittedFrames{ 0 };
+		uint64_t m_completedFrames{ 0 };
+		// Number of frame submitted with fence of each frame in flight
+		std::vector<uint64_t> m_frameNumbers;
 
 	public:
 		vk::SampleCountFlagBits m_msaaSamples;
+		vk::ImageUsageFlags m_swapChainImageUsage{ vk::ImageUsageFlagBits::eColorAttachment };
+		vk::ImageUsageFlags m_depthBufferUsage;
+		vk::PresentModeKHR m_presentMode{ vk::PresentModeKHR::eMailbox };
+		// Number of swap chain images, resources used by descriptor sets are created for each of them
 		uint32_t m_maxFrames{ 1 };
+		uint32_t m_framesInFlight{ 2 };
+		uint32_t m_recordingThreads{ 1 };
 		uint32_t m_currentFrameIndex{ 0 };
 		QueueFamilyIndices m_indices;
 		vk::ResultValue<uint32_t> m_imageIndex{ {}, 0 };
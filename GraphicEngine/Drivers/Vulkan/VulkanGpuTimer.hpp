@@ -0,0 +1,116 @@
+#pragma once
+
+#include "VulkanFramework.hpp"
+#include "../../Core/Profiler.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef GRAPHIC_ENGINE_PROFILER
+#define PROFILE_GPU_COMMAND_ZONE(gpuTimer, commandBuffer, bufferIndex, name) GraphicEngine::Vulkan::GpuTimer::ScopedQuery PROFILER_CONCAT(gpuZone, __LINE__)(*(gpuTimer), commandBuffer, bufferIndex, name)
+#else
+#define PROFILE_GPU_COMMAND_ZONE(gpuTimer, commandBuffer, bufferIndex, name)
+#endif
+
+namespace GraphicEngine::Vulkan
+{
+	// Timestamp query pool with range of queries for every command buffer, zones are written while command buffer is recorded
+	// and read back after command buffer executed, before it is recorded again.
+	class GpuTimer
+	{
+	public:
+		class ScopedQuery
+		{
+		public:
+			ScopedQuery(GpuTimer& gpuTimer, vk::UniqueCommandBuffer& commandBuffer, uint32_t bufferIndex, const std::string& name) :
+				m_gpuTimer{ gpuTimer },
+				m_commandBuffer{ commandBuffer },
+				m_bufferIndex{ bufferIndex }
+			{
+				m_gpuTimer.begin(m_commandBuffer, m_bufferIndex, name);
+			}
+
+			~ScopedQuery()
+			{
+				m_gpuTimer.end(m_commandBuffer, m_bufferIndex);
+			}
+
+			ScopedQuery(const ScopedQuery&) = delete;
+			ScopedQuery& operator=(const ScopedQuery&) = delete;
+
+		private:
+			GpuTimer& m_gpuTimer;
+			vk::UniqueCommandBuffer& m_commandBuffer;
+			uint32_t m_bufferIndex;
+		};
+
+		static constexpr uint32_t maxZones{ 16 };
+
+		GpuTimer(VulkanFramework* framework, std::shared_ptr<Core::Profiler> profiler) :
+			m_framework{ framework },
+			m_profiler{ profiler },
+			m_zones(framework->m_commandBuffers.size())
+		{
+			m_timestampPeriod = m_framework->m_physicalDevice.getProperties().limits.timestampPeriod;
+			m_queryPool = m_framework->m_device->createQueryPoolUnique(vk::QueryPoolCreateInfo(vk::QueryPoolCreateFlags(), vk::QueryType::eTimestamp, static_cast<uint32_t>(m_zones.size()) * maxZones * 2));
+		}
+
+		// Has to be recorded outside of render pass
+		void reset(vk::UniqueCommandBuffer& commandBuffer, uint32_t bufferIndex)
+		{
+			if (bufferIndex >= m_zones.size())
+				return;
+
+			commandBuffer->resetQueryPool(m_queryPool.get(), bufferIndex * maxZones * 2, maxZones * 2);
+			m_zones[bufferIndex].clear();
+		}
+
+		void begin(vk::UniqueCommandBuffer& commandBuffer, uint32_t bufferIndex, const std::string& name)
+		{
+			if (bufferIndex >= m_zones.size() || m_zones[bufferIndex].size() >= maxZones)
+				return;
+
+			uint32_t query = (bufferIndex * maxZones + static_cast<uint32_t>(m_zones[bufferIndex].size())) * 2;
+			commandBuffer->writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, m_queryPool.get(), query);
+			m_zones[bufferIndex].push_back(name);
+		}
+
+		void end(vk::UniqueCommandBuffer& commandBuffer, uint32_t bufferIndex)
+		{
+			if (bufferIndex >= m_zones.size() || m_zones[bufferIndex].empty())
+				return;
+
+			uint32_t query = (bufferIndex * maxZones + static_cast<uint32_t>(m_zones[bufferIndex].size()) - 1) * 2 + 1;
+			commandBuffer->writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, m_queryPool.get(), query);
+		}
+
+		// Reads zones of executed command buffer without waiting, nothing is reported when results are not ready yet
+		void collect(uint32_t bufferIndex)
+		{
+			if (bufferIndex >= m_zones.size() || m_zones[bufferIndex].empty())
+				return;
+
+			const auto& names = m_zones[bufferIndex];
+			std::vector<uint64_t> timestamps(names.size() * 2);
+			auto result = m_framework->m_device->getQueryPoolResults(m_queryPool.get(), bufferIndex * maxZones * 2, static_cast<uint32_t>(timestamps.size()),
+				timestamps.size() * sizeof(uint64_t), timestamps.data(), sizeof(uint64_t), vk::QueryResultFlagBits::e64);
+			if (result != vk::Result::eSuccess)
+				return;
+
+			for (size_t i{ 0 }; i < names.size(); ++i)
+			{
+				double nanoseconds = static_cast<double>(timestamps[2 * i + 1] - timestamps[2 * i]) * m_timestampPeriod;
+				m_profiler->addGpuZone(names[i], nanoseconds / 1000000.0);
+			}
+		}
+
+	private:
+		VulkanFramework* m_framework;
+		std::shared_ptr<Core::Profiler> m_profiler;
+
+		vk::UniqueQueryPool m_queryPool;
+		float m_timestampPeriod{ 1.0f };
+		std::vector<std::vector<std::string>> m_zones;
+	};
+}
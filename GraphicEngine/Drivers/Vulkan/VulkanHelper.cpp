@@ -4,8 +4,11 @@
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <numeric>
 #include <set>
+#include <stdexcept>
+#include <tuple>
 
 #undef max
 
@@ -41,6 +44,34 @@ std::optional<uint32_t> GraphicEngine::Vulkan::getGraphicQueueFamilyIndex(const
 	return tempGraphicQueueFamilyIndex < queueFamilyProperties.size() ? std::optional<uint32_t>{tempGraphicQueueFamilyIndex} : std::nullopt;
 }
 
+std::optional<uint32_t> GraphicEngine::Vulkan::getTransferQueueFamilyIndex(const vk::PhysicalDevice& physicalDevice)
+{
+	std::vector<vk::QueueFamilyProperties> queueFamilyProperties = physicalDevice.getQueueFamilyProperties();
+
+	// Family only for transfers is usually backed by DMA engine, compute family without graphics is next best choice
+	std::optional<uint32_t> transferQueueFamilyIndex;
+	for (uint32_t i{ 0 }; i < queueFamilyProperties.size(); ++i)
+	{
+		vk::QueueFlags flags = queueFamilyProperties[i].queueFlags;
+		if (flags & vk::QueueFlagBits::eGraphics || !(flags & (vk::QueueFlagBits::eTransfer | vk::QueueFlagBits::eCompute)))
+		{
+			continue;
+		}
+
+		if (!(flags & vk::QueueFlagBits::eCompute))
+		{
+			return i;
+		}
+
+		if (!transferQueueFamilyIndex.has_value())
+		{
+			transferQueueFamilyIndex = i;
+		}
+	}
+
+	return transferQueueFamilyIndex;
+}
+
 GraphicEngine::Vulkan::QueueFamilyIndices GraphicEngine::Vulkan::findGraphicAndPresentQueueFamilyIndices(const vk::PhysicalDevice& physicalDevice, vk::UniqueSurfaceKHR& surface)
 {
 	std::vector<vk::QueueFamilyProperties> queueFamilyProperties = physicalDevice.getQueueFamilyProperties();
@@ -79,6 +110,12 @@ GraphicEngine::Vulkan::QueueFamilyIndices GraphicEngine::Vulkan::findGraphicAndP
 				}
 			}
 		}
+
+		indices.transferFamily = getTransferQueueFamilyIndex(physicalDevice);
+		if (!indices.transferFamily.has_value())
+		{
+			indices.transferFamily = indices.graphicsFamily;
+		}
 	}
 	return indices;
 }
@@ -152,7 +189,21 @@ bool GraphicEngine::Vulkan::isPhysicalDeviceSuitable(const vk::PhysicalDevice& p
 {
 	QueueFamilyIndices indices = findGraphicAndPresentQueueFamilyIndices(physicalDevice, surface);
 
-	return indices.isComplete() && physicalDevice.getFeatures().samplerAnisotropy;;
+	if (physicalDevice.getProperties().apiVersion < VK_API_VERSION_1_2)
+	{
+		return false;
+	}
+
+	// Uploads are tracked by timeline semaphores, objects are drawn with bindless descriptors and culled draws with indirect count, all are core since Vulkan 1.2
+	auto features = physicalDevice.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>().get<vk::PhysicalDeviceVulkan12Features>();
+	bool descriptorIndexing = features.runtimeDescriptorArray && features.descriptorBindingPartiallyBound && features.descriptorBindingVariableDescriptorCount &&
+		features.descriptorBindingSampledImageUpdateAfterBind && features.shaderSampledImageArrayNonUniformIndexing;
+
+	// Culling pass writes index of object as first instance of draws, which are drawn by one indirect draw per vertex type
+	auto deviceFeatures = physicalDevice.getFeatures();
+	bool indirectDraws = deviceFeatures.multiDrawIndirect && deviceFeatures.drawIndirectFirstInstance && features.drawIndirectCount;
+
+	return indices.isComplete() && deviceFeatures.samplerAnisotropy && features.timelineSemaphore && indirectDraws && descriptorIndexing;
 }
 
 vk::PhysicalDevice GraphicEngine::Vulkan::getPhysicalDevice(const vk::UniqueInstance& instance, vk::UniqueSurfaceKHR& surface)
@@ -176,7 +227,7 @@ vk::UniqueDevice GraphicEngine::Vulkan::getUniqueLogicalDevice(const vk::Physica
 
 	if (indices.isComplete())
 	{
-		std::set<uint32_t> setIndices = { indices.graphicsFamily.value(), indices.presentFamily.value() };
+		std::set<uint32_t> setIndices = { indices.graphicsFamily.value(), indices.presentFamily.value(), indices.transferFamily.value() };
 
 		std::vector<vk::DeviceQueueCreateInfo> deviceQueueCreateInfos;
 		for (uint32_t ind : setIndices)
@@ -188,24 +239,34 @@ vk::UniqueDevice GraphicEngine::Vulkan::getUniqueLogicalDevice(const vk::Physica
 		vk::PhysicalDeviceFeatures deviceFeatures = physicalDevice.getFeatures();
 
 		auto extensions = getDeviceExtension();
-		vk::DeviceCreateInfo deviceCreateInfo(vk::DeviceCreateFlags(),
-			static_cast<uint32_t>(deviceQueueCreateInfos.size()), deviceQueueCreateInfos.data(),
-			0, nullptr,
-			static_cast<uint32_t>(extensions.size()), extensions.data(),
-			&deviceFeatures);
-
-
-		return physicalDevice.createDeviceUnique(deviceCreateInfo);
+		vk::PhysicalDeviceVulkan12Features vulkan12Features;
+		vulkan12Features.timelineSemaphore = true;
+		vulkan12Features.runtimeDescriptorArray = true;
+		vulkan12Features.descriptorBindingPartiallyBound = true;
+		vulkan12Features.descriptorBindingVariableDescriptorCount = true;
+		vulkan12Features.descriptorBindingSampledImageUpdateAfterBind = true;
+		vulkan12Features.shaderSampledImageArrayNonUniformIndexing = true;
+		vulkan12Features.drawIndirectCount = true;
+
+		vk::StructureChain<vk::DeviceCreateInfo, vk::PhysicalDeviceVulkan12Features> deviceCreateInfo(
+			{ vk::DeviceCreateFlags(),
+				static_cast<uint32_t>(deviceQueueCreateInfos.size()), deviceQueueCreateInfos.data(),
+				0, nullptr,
+				static_cast<uint32_t>(extensions.size()), extensions.data(),
+				&deviceFeatures },
+			vulkan12Features);
+
+		return physicalDevice.createDeviceUnique(deviceCreateInfo.get<vk::DeviceCreateInfo>());
 	}
 
 	throw std::runtime_error("Failed to create logical device!");
 }
 
-vk::UniqueCommandPool GraphicEngine::Vulkan::createUniqueCommandPool(const vk::UniqueDevice& device, const QueueFamilyIndices& queueFamilyIndex)
+vk::UniqueCommandPool GraphicEngine::Vulkan::createUniqueCommandPool(const vk::UniqueDevice& device, const QueueFamilyIndices& queueFamilyIndex, vk::CommandPoolCreateFlags flags)
 {
 	if (queueFamilyIndex.graphicsFamily.has_value())
 	{
-		vk::CommandPoolCreateInfo createInfo(vk::CommandPoolCreateFlagBits::eResetCommandBuffer, queueFamilyIndex.graphicsFamily.value());
+		vk::CommandPoolCreateInfo createInfo(flags, queueFamilyIndex.graphicsFamily.value());
 		return device->createCommandPoolUnique(createInfo);
 	}
 
@@ -232,9 +293,116 @@ uint32_t GraphicEngine::Vulkan::findMemoryType(const vk::PhysicalDevice& physica
 	throw std::runtime_error("Failed to find situable memory!");
 }
 
-vk::UniqueDeviceMemory GraphicEngine::Vulkan::allocateMemory(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, vk::MemoryPropertyFlags memoryProperty, const vk::MemoryRequirements& memoryRequirements)
+namespace
+{
+	std::mutex memoryAllocatorsMutex;
+	std::map<VkDevice, std::weak_ptr<GraphicEngine::Vulkan::DeviceMemoryAllocator>> memoryAllocators;
+}
+
+void GraphicEngine::Vulkan::setDeviceMemoryAllocator(const vk::UniqueDevice& device, std::shared_ptr<DeviceMemoryAllocator> memoryAllocator)
+{
+	std::lock_guard<std::mutex> lock{ memoryAllocatorsMutex };
+	memoryAllocators[static_cast<VkDevice>(device.get())] = memoryAllocator;
+}
+
+std::shared_ptr<GraphicEngine::Vulkan::DeviceMemoryAllocator> GraphicEngine::Vulkan::getDeviceMemoryAllocator(const vk::UniqueDevice& device)
+{
+	std::lock_guard<std::mutex> lock{ memoryAllocatorsMutex };
+	auto memoryAllocator = memoryAllocators.find(static_cast<VkDevice>(device.get()));
+	if (memoryAllocator == std::end(memoryAllocators) || memoryAllocator->second.expired())
+	{
+		throw std::runtime_error("Memory allocator is not created for device!");
+	}
+	return memoryAllocator->second.lock();
+}
+
+GraphicEngine::Vulkan::MemoryAllocation GraphicEngine::Vulkan::allocateMemory(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, vk::MemoryPropertyFlags memoryProperty, const vk::MemoryRequirements& memoryRequirements,
+	MemoryLifetime lifetime, bool image)
+{
+	auto memoryAllocator = getDeviceMemoryAllocator(device);
+	uint32_t memoryType = findMemoryType(physicalDevice, memoryRequirements.memoryTypeBits, memoryProperty);
+	return MemoryAllocation(memoryAllocator, memoryAllocator->allocate(memoryType, memoryRequirements.size, memoryRequirements.alignment, lifetime, image));
+}
+
+GraphicEngine::Vulkan::VulkanMemoryDevice::VulkanMemoryDevice(const vk::PhysicalDevice& physicalDevice, vk::Device device) :
+	m_device{ device },
+	m_memoryProperties{ physicalDevice.getMemoryProperties() }
+{
+}
+
+vk::DeviceMemory GraphicEngine::Vulkan::VulkanMemoryDevice::allocate(uint32_t memoryType, uint64_t size)
+{
+	return m_device.allocateMemory(vk::MemoryAllocateInfo(size, memoryType));
+}
+
+void GraphicEngine::Vulkan::VulkanMemoryDevice::free(vk::DeviceMemory memory)
+{
+	// Mapped memory is unmapped implicitly
+	m_device.freeMemory(memory);
+}
+
+bool GraphicEngine::Vulkan::VulkanMemoryDevice::isHostVisible(uint32_t memoryType)
+{
+	return static_cast<bool>(m_memoryProperties.memoryTypes[memoryType].propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible);
+}
+
+void* GraphicEngine::Vulkan::VulkanMemoryDevice::map(vk::DeviceMemory memory, uint64_t size)
+{
+	return m_device.mapMemory(memory, 0, size, vk::MemoryMapFlags());
+}
+
+GraphicEngine::Vulkan::MemoryAllocation::MemoryAllocation(std::shared_ptr<DeviceMemoryAllocator> allocator, DeviceMemoryAllocator::Allocation allocation) :
+	m_allocator{ allocator },
+	m_allocation{ allocation }
 {
-	return device->allocateMemoryUnique(vk::MemoryAllocateInfo(memoryRequirements.size, findMemoryType(physicalDevice, memoryRequirements.memoryTypeBits, memoryProperty)));
+}
+
+GraphicEngine::Vulkan::MemoryAllocation::MemoryAllocation(MemoryAllocation&& other) noexcept :
+	m_allocator{ std::move(other.m_allocator) },
+	m_allocation{ other.m_allocation }
+{
+	other.m_allocator.reset();
+}
+
+GraphicEngine::Vulkan::MemoryAllocation& GraphicEngine::Vulkan::MemoryAllocation::operator=(MemoryAllocation&& other) noexcept
+{
+	if (this != &other)
+	{
+		release();
+		m_allocator = std::move(other.m_allocator);
+		m_allocation = other.m_allocation;
+		other.m_allocator.reset();
+	}
+	return *this;
+}
+
+GraphicEngine::Vulkan::MemoryAllocation::~MemoryAllocation()
+{
+	release();
+}
+
+vk::DeviceMemory GraphicEngine::Vulkan::MemoryAllocation::get() const
+{
+	return m_allocation.memory;
+}
+
+uint64_t GraphicEngine::Vulkan::MemoryAllocation::getOffset() const
+{
+	return m_allocation.offset;
+}
+
+void* GraphicEngine::Vulkan::MemoryAllocation::getMappedData() const
+{
+	return m_allocation.mappedData;
+}
+
+void GraphicEngine::Vulkan::MemoryAllocation::release()
+{
+	if (m_allocator)
+	{
+		m_allocator->free(m_allocation);
+		m_allocator.reset();
+	}
 }
 
 vk::UniqueRenderPass GraphicEngine::Vulkan::createRenderPass(const vk::UniqueDevice& device, vk::Format colorFormat, vk::Format depthFormat, vk::SampleCountFlagBits msaaSample)
@@ -377,25 +545,30 @@ vk::UniquePipeline GraphicEngine::Vulkan::createGraphicPipeline(const vk::Unique
 	return device->createGraphicsPipelineUnique(pipeliceCache.get(), graphicPipelineCreateInfo).value;
 }
 
-std::vector<vk::VertexInputAttributeDescription> GraphicEngine::Vulkan::createVertexInputAttributeDescriptions(const std::vector<std::pair<uint32_t, uint32_t>>& vertexSizeOffset)
-{
-	std::vector<vk::VertexInputAttributeDescription> attributeDescriptions;
-
-	std::map<uint32_t, vk::Format> dataFormatTypes = {
-		{1, vk::Format::eR32Sfloat},
-		{2, vk::Format::eR32G32Sfloat},
-		{3, vk::Format::eR32G32B32Sfloat},
-		{4, vk::Format::eR32G32B32A32Sfloat},
+vk::Format GraphicEngine::Vulkan::getVertexAttributeFormat(const Common::VertexAttribute& vertexAttribute)
+{
+	// Format by data type, normalization and number of components
+	static const std::map<std::tuple<Common::VertexAttributeFormat, bool, uint32_t>, vk::Format> dataFormatTypes = {
+		{{Common::VertexAttributeFormat::Float, false, 1}, vk::Format::eR32Sfloat},
+		{{Common::VertexAttributeFormat::Float, false, 2}, vk::Format::eR32G32Sfloat},
+		{{Common::VertexAttributeFormat::Float, false, 3}, vk::Format::eR32G32B32Sfloat},
+		{{Common::VertexAttributeFormat::Float, false, 4}, vk::Format::eR32G32B32A32Sfloat},
+		{{Common::VertexAttributeFormat::HalfFloat, false, 2}, vk::Format::eR16G16Sfloat},
+		{{Common::VertexAttributeFormat::HalfFloat, false, 4}, vk::Format::eR16G16B16A16Sfloat},
+		{{Common::VertexAttributeFormat::Short, true, 2}, vk::Format::eR16G16Snorm},
+		{{Common::VertexAttributeFormat::Short, true, 4}, vk::Format::eR16G16B16A16Snorm},
+		{{Common::VertexAttributeFormat::UnsignedShort, true, 2}, vk::Format::eR16G16Unorm},
+		{{Common::VertexAttributeFormat::UnsignedShort, true, 4}, vk::Format::eR16G16B16A16Unorm},
+		{{Common::VertexAttributeFormat::Byte, true, 4}, vk::Format::eR8G8B8A8Snorm},
+		{{Common::VertexAttributeFormat::UnsignedByte, true, 4}, vk::Format::eR8G8B8A8Unorm},
 	};
 
-	for (size_t i{ 0 }; i < vertexSizeOffset.size(); ++i)
+	auto format = dataFormatTypes.find({ vertexAttribute.format, vertexAttribute.normalized, vertexAttribute.size });
+	if (format == std::end(dataFormatTypes))
 	{
-		attributeDescriptions.emplace_back(
-			vk::VertexInputAttributeDescription(i, 0, dataFormatTypes[vertexSizeOffset[i].first],
-				vertexSizeOffset[i].second));
+		throw std::invalid_argument("Vertex attribute format is not supported!");
 	}
-
-	return attributeDescriptions;
+	return format->second;
 }
 
 vk::UniqueDescriptorPool GraphicEngine::Vulkan::createDescriptorPool(const vk::UniqueDevice& device, const std::vector<vk::DescriptorPoolSize>& descriptorSizes)
@@ -570,19 +743,25 @@ vk::Format GraphicEngine::Vulkan::findSupportedFormat(const vk::PhysicalDevice&
 	throw std::runtime_error("Failed to find supported format!");
 }
 
-GraphicEngine::Vulkan::SwapChainData::SwapChainData(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const vk::UniqueSurfaceKHR& surface, const QueueFamilyIndices& indices, const vk::Extent2D& extend, const vk::UniqueSwapchainKHR& oldSwapChain, vk::ImageUsageFlags imageUsage)
+GraphicEngine::Vulkan::SwapChainData::SwapChainData(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const vk::UniqueSurfaceKHR& surface, const QueueFamilyIndices& indices, const vk::Extent2D& extend, const vk::UniqueSwapchainKHR& oldSwapChain, vk::ImageUsageFlags imageUsage,
+	vk::PresentModeKHR preferredPresentMode, uint32_t imageCount)
 {
-	createSwapChainData(physicalDevice, device, surface, indices, extend, oldSwapChain, imageUsage);
+	createSwapChainData(physicalDevice, device, surface, indices, extend, oldSwapChain, imageUsage, preferredPresentMode, imageCount);
 }
 
-void GraphicEngine::Vulkan::SwapChainData::createSwapChainData(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const vk::UniqueSurfaceKHR& surface, const QueueFamilyIndices& indices, const vk::Extent2D& extend, const vk::UniqueSwapchainKHR& oldSwapChain, vk::ImageUsageFlags imageUsage)
+void GraphicEngine::Vulkan::SwapChainData::createSwapChainData(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const vk::UniqueSurfaceKHR& surface, const QueueFamilyIndices& indices, const vk::Extent2D& extend, const vk::UniqueSwapchainKHR& oldSwapChain, vk::ImageUsageFlags imageUsage,
+	vk::PresentModeKHR preferredPresentMode, uint32_t imageCount)
 {
 	SwapChainSupportDetails swapChainSupportDetails = getSwapChainSupportDetails(physicalDevice, surface);
 	this->extent = pickSurfaceExtent(swapChainSupportDetails.capabilities, extend);
 	vk::SurfaceFormatKHR surfaceFormat = pickSurfaceFormat(swapChainSupportDetails.formats).format;
 	this->format = surfaceFormat.format;
 
-	uint32_t imageCount = swapChainSupportDetails.capabilities.minImageCount + 1;
+	if (imageCount == 0)
+	{
+		imageCount = swapChainSupportDetails.capabilities.minImageCount + 1;
+	}
+	imageCount = std::max(imageCount, swapChainSupportDetails.capabilities.minImageCount);
 	if (swapChainSupportDetails.capabilities.maxImageCount > 0 && imageCount > swapChainSupportDetails.capabilities.maxImageCount)
 	{
 		imageCount = swapChainSupportDetails.capabilities.maxImageCount;
@@ -595,8 +774,10 @@ void GraphicEngine::Vulkan::SwapChainData::createSwapChainData(const vk::Physica
 		(swapChainSupportDetails.capabilities.supportedCompositeAlpha & vk::CompositeAlphaFlagBitsKHR::ePostMultiplied) ? vk::CompositeAlphaFlagBitsKHR::ePostMultiplied :
 		(swapChainSupportDetails.capabilities.supportedCompositeAlpha & vk::CompositeAlphaFlagBitsKHR::eInherit) ? vk::CompositeAlphaFlagBitsKHR::eInherit : vk::CompositeAlphaFlagBitsKHR::eOpaque;
 
+	presentMode = pickPresentMode(swapChainSupportDetails.presentModes, preferredPresentMode);
+
 	vk::SwapchainCreateInfoKHR swapChainCreateInfo({}, surface.get(), imageCount, surfaceFormat.format, surfaceFormat.colorSpace, this->extent, 1, imageUsage, vk::SharingMode::eExclusive, 0, nullptr,
-		preTransform, compositeAlpha, pickPresentMode(swapChainSupportDetails.presentModes), true, *oldSwapChain);
+		preTransform, compositeAlpha, presentMode, true, *oldSwapChain);
 
 	swapChain = device->createSwapchainKHRUnique(swapChainCreateInfo);
 	images = device->getSwapchainImagesKHR(swapChain.get());
@@ -641,17 +822,13 @@ vk::SurfaceFormatKHR GraphicEngine::Vulkan::SwapChainData::pickSurfaceFormat(con
 	throw std::runtime_error("Failed to pick surface format!");
 }
 
-vk::PresentModeKHR GraphicEngine::Vulkan::SwapChainData::pickPresentMode(const std::vector<vk::PresentModeKHR>& presentModes)
+vk::PresentModeKHR GraphicEngine::Vulkan::SwapChainData::pickPresentMode(const std::vector<vk::PresentModeKHR>& presentModes, vk::PresentModeKHR preferredPresentMode)
 {
-	if (presentModes.size() > 0)
+	// Fifo has to be supported by every surface, so it is last fallback
+	std::array<vk::PresentModeKHR, 4> requestPresentModes = { preferredPresentMode, vk::PresentModeKHR::eMailbox, vk::PresentModeKHR::eImmediate, vk::PresentModeKHR::eFifo };
+	for (const vk::PresentModeKHR requestPresentMode : requestPresentModes)
 	{
-		auto it = std::find(std::begin(presentModes), std::end(presentModes), vk::PresentModeKHR::eMailbox);
-		if (it != std::end(presentModes))
-		{
-			return *it;
-		}
-
-		it = std::find(std::begin(presentModes), std::end(presentModes), vk::PresentModeKHR::eImmediate);
+		auto it = std::find(std::begin(presentModes), std::end(presentModes), requestPresentMode);
 		if (it != std::end(presentModes))
 		{
 			return *it;
@@ -697,9 +874,9 @@ void GraphicEngine::Vulkan::ImageData::initImageData(const vk::PhysicalDevice& p
 	vk::ImageCreateInfo imageCreateInfo(flags, imageType, format, extent, mipLevel, arrayCount, numOfSamples, tiling, imageUsage, vk::SharingMode::eExclusive, 0, nullptr, layout);
 
 	this->image = device->createImageUnique(imageCreateInfo);
-	this->deviceMemory = allocateMemory(physicalDevice, device, memoryProperty, device->getImageMemoryRequirements(image.get()));
+	this->deviceMemory = allocateMemory(physicalDevice, device, memoryProperty, device->getImageMemoryRequirements(image.get()), MemoryLifetime::Persistent, true);
 
-	device->bindImageMemory(image.get(), deviceMemory.get(), 0);
+	device->bindImageMemory(image.get(), deviceMemory.get(), deviceMemory.getOffset());
 
 	vk::ComponentMapping componentMapping(vk::ComponentSwizzle::eR, vk::ComponentSwizzle::eG, vk::ComponentSwizzle::eB, vk::ComponentSwizzle::eA);
 	vk::ImageSubresourceRange subResourceRange(aspectFlags, 0, mipLevel, 0, arrayCount);
@@ -707,27 +884,35 @@ void GraphicEngine::Vulkan::ImageData::initImageData(const vk::PhysicalDevice& p
 	imageView = device->createImageViewUnique(createInfo);
 }
 
-GraphicEngine::Vulkan::DepthBufferData::DepthBufferData(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, vk::Extent3D extent, vk::Format format, vk::SampleCountFlagBits numOfSamples) :
+GraphicEngine::Vulkan::DepthBufferData::DepthBufferData(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, vk::Extent3D extent, vk::Format format, vk::SampleCountFlagBits numOfSamples,
+	vk::ImageUsageFlags imageUsage) :
 	ImageData(physicalDevice, device, extent, format, numOfSamples,
-		vk::MemoryPropertyFlagBits::eDeviceLocal, vk::ImageUsageFlagBits::eDepthStencilAttachment, vk::ImageTiling::eOptimal, 1, 1, vk::ImageLayout::eUndefined, vk::ImageAspectFlagBits::eDepth)
+		vk::MemoryPropertyFlagBits::eDeviceLocal, vk::ImageUsageFlagBits::eDepthStencilAttachment | imageUsage, vk::ImageTiling::eOptimal, 1, 1, vk::ImageLayout::eUndefined, vk::ImageAspectFlagBits::eDepth)
 {
 }
 
 GraphicEngine::Vulkan::BufferData::BufferData(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device,
-	const vk::BufferUsageFlags& usageFlags, const vk::MemoryPropertyFlags& properties, uint32_t size)
+	const vk::BufferUsageFlags& usageFlags, const vk::MemoryPropertyFlags& properties, uint32_t size, MemoryLifetime lifetime,
+	const std::vector<uint32_t>& queueFamilyIndices)
 {
-	buffer = device->createBufferUnique(vk::BufferCreateInfo(vk::BufferCreateFlags(), size, usageFlags, vk::SharingMode::eExclusive));
-	vk::MemoryRequirements memoryRequirements = device->getBufferMemoryRequirements(buffer.get());
-
-	vk::MemoryAllocateInfo allocateInfo(memoryRequirements.size, findMemoryType(physicalDevice, memoryRequirements.memoryTypeBits, properties));
-	memory = device->allocateMemoryUnique(allocateInfo);
-	device->bindBufferMemory(buffer.get(), memory.get(), 0);
+	// Buffer used by several queue families is shared concurrently, so it does not need ownership transfers
+	if (queueFamilyIndices.size() > 1)
+	{
+		buffer = device->createBufferUnique(vk::BufferCreateInfo(vk::BufferCreateFlags(), size, usageFlags, vk::SharingMode::eConcurrent,
+			static_cast<uint32_t>(queueFamilyIndices.size()), queueFamilyIndices.data()));
+	}
+	else
+	{
+		buffer = device->createBufferUnique(vk::BufferCreateInfo(vk::BufferCreateFlags(), size, usageFlags, vk::SharingMode::eExclusive));
+	}
+	memory = allocateMemory(physicalDevice, device, properties, device->getBufferMemoryRequirements(buffer.get()), lifetime);
+	device->bindBufferMemory(buffer.get(), memory.get(), memory.getOffset());
 }
 
-GraphicEngine::Vulkan::RenderingBarriers::RenderingBarriers(const vk::UniqueDevice& device, size_t maxFrames)
+GraphicEngine::Vulkan::RenderingBarriers::RenderingBarriers(const vk::UniqueDevice& device, size_t framesInFlight, size_t imagesCount)
 {
-	imagesInFlight.resize(maxFrames);
-	for (size_t i{ 0 }; i < maxFrames; ++i)
+	imagesInFlight.resize(imagesCount);
+	for (size_t i{ 0 }; i < framesInFlight; ++i)
 	{
 		vk::SemaphoreCreateInfo semaphoreCreateInfo;
 		imageAvailableSemaphores.push_back(device->createSemaphoreUnique(semaphoreCreateInfo));
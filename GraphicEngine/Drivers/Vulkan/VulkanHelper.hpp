@@ -1,30 +1,79 @@
 #pragma once
 
 #include <array>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
 #include <vulkan/vulkan.hpp>
 
+#include "VulkanMemoryAllocator.hpp"
+#include "../../Common/Vertex.hpp"
+#include "../../Core/Profiler.hpp"
+
 namespace GraphicEngine::Vulkan
 {
+	// Device memory of Vulkan device for MemoryAllocator
+	class VulkanMemoryDevice
+	{
+	public:
+		using Memory = vk::DeviceMemory;
+
+		VulkanMemoryDevice(const vk::PhysicalDevice& physicalDevice, vk::Device device);
+
+		Memory allocate(uint32_t memoryType, uint64_t size);
+		void free(Memory memory);
+		bool isHostVisible(uint32_t memoryType);
+		void* map(Memory memory, uint64_t size);
+
+	private:
+		vk::Device m_device;
+		vk::PhysicalDeviceMemoryProperties m_memoryProperties;
+	};
+
+	using DeviceMemoryAllocator = MemoryAllocator<VulkanMemoryDevice>;
+
+	// Range of device memory bound to buffer or image, it is given back to allocator on destruction
+	class MemoryAllocation
+	{
+	public:
+		MemoryAllocation() = default;
+		MemoryAllocation(std::shared_ptr<DeviceMemoryAllocator> allocator, DeviceMemoryAllocator::Allocation allocation);
+		MemoryAllocation(MemoryAllocation&& other) noexcept;
+		MemoryAllocation& operator=(MemoryAllocation&& other) noexcept;
+		MemoryAllocation(const MemoryAllocation&) = delete;
+		MemoryAllocation& operator=(const MemoryAllocation&) = delete;
+		~MemoryAllocation();
+
+		vk::DeviceMemory get() const;
+		uint64_t getOffset() const;
+		// Null for memory which is not host visible
+		void* getMappedData() const;
+
+	private:
+		void release();
+
+	private:
+		std::shared_ptr<DeviceMemoryAllocator> m_allocator;
+		DeviceMemoryAllocator::Allocation m_allocation;
+	};
+
+	// Host visible memory is mapped for whole its life and all of it is host coherent, so data is only copied
 	template <typename T>
-	void copyMemoryToDevice(const vk::UniqueDevice& device, const vk::UniqueDeviceMemory& memory, const T* data, uint32_t count, uint32_t offset)
+	void copyMemoryToDevice(const MemoryAllocation& memory, const T* data, uint32_t count, uint32_t offset)
 	{
 		uint32_t deviceSize = sizeof(T) * count;
-		uint32_t deviceOffset = offset;
-		void* _data;
-		device->mapMemory(memory.get(), deviceOffset, deviceSize, vk::MemoryMapFlags(), &_data);
-		memcpy(_data, data, deviceSize);
-		device->unmapMemory(memory.get());
+		memcpy(static_cast<char*>(memory.getMappedData()) + offset, data, deviceSize);
+		PROFILE_UPLOADED_BYTES(deviceSize);
 	}
 
 	template <typename T>
-	void copyMemoryToDevice(const vk::UniqueDevice& device, const vk::UniqueDeviceMemory& memory, const T* data, uint32_t count)
+	void copyMemoryToDevice(const MemoryAllocation& memory, const T* data, uint32_t count)
 	{
-		copyMemoryToDevice<T>(device, memory, data, count, 0);
+		copyMemoryToDevice<T>(memory, data, count, 0);
 	}
 
 	template <typename F, typename... Args>
@@ -62,6 +111,8 @@ namespace GraphicEngine::Vulkan
 	{
 		std::optional<uint32_t> graphicsFamily;
 		std::optional<uint32_t> presentFamily;
+		// Family without graphics used for uploads, same as graphics family when device has no such family
+		std::optional<uint32_t> transferFamily;
 
 		bool isComplete()
 		{
@@ -85,9 +136,10 @@ namespace GraphicEngine::Vulkan
 		std::vector<vk::PresentModeKHR> presentModes;
 	};
 
+	// Semaphores and fences of every frame in flight, and fence of frame which last used each swap chain image
 	struct RenderingBarriers
 	{
-		RenderingBarriers(const vk::UniqueDevice& device, size_t maxFrames);
+		RenderingBarriers(const vk::UniqueDevice& device, size_t framesInFlight, size_t imagesCount);
 		std::vector<vk::UniqueSemaphore> imageAvailableSemaphores;
 		std::vector<vk::UniqueSemaphore> renderFinishedSemaphores;
 		std::vector<vk::UniqueFence> inFlightFences;
@@ -98,23 +150,28 @@ namespace GraphicEngine::Vulkan
 	{
 	public:
 		SwapChainData() {};
+		// Preferred present mode is used when surface supports it, otherwise mailbox, immediate and fifo are tried in that order.
+		// Zero image count requests one image more than minimum, recreated swap chain asks for same count as previous one
 		SwapChainData(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const vk::UniqueSurfaceKHR& surface,
-			const QueueFamilyIndices& indices, const vk::Extent2D& extend, const vk::UniqueSwapchainKHR& oldSwapChain, vk::ImageUsageFlags imageUsage);
+			const QueueFamilyIndices& indices, const vk::Extent2D& extend, const vk::UniqueSwapchainKHR& oldSwapChain, vk::ImageUsageFlags imageUsage,
+			vk::PresentModeKHR preferredPresentMode = vk::PresentModeKHR::eMailbox, uint32_t imageCount = 0);
 
 		vk::Extent2D extent;
 		vk::Format format;
 		vk::UniqueSwapchainKHR swapChain;
 		std::vector<vk::Image> images;
 		std::vector<vk::UniqueImageView> imageViews;
+		vk::PresentModeKHR presentMode;
 
 	private:
 		void createSwapChainData(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const vk::UniqueSurfaceKHR& surface,
-			const QueueFamilyIndices& indices, const vk::Extent2D& extend, const vk::UniqueSwapchainKHR& oldSwapChain, vk::ImageUsageFlags imageUsage);
+			const QueueFamilyIndices& indices, const vk::Extent2D& extend, const vk::UniqueSwapchainKHR& oldSwapChain, vk::ImageUsageFlags imageUsage,
+			vk::PresentModeKHR preferredPresentMode, uint32_t imageCount);
 
 		SwapChainSupportDetails getSwapChainSupportDetails(const vk::PhysicalDevice& physicalDevice, const vk::UniqueSurfaceKHR& surface);
 
 		vk::SurfaceFormatKHR pickSurfaceFormat(const std::vector<vk::SurfaceFormatKHR>& formats);
-		vk::PresentModeKHR pickPresentMode(const std::vector<vk::PresentModeKHR>& presentModes);
+		vk::PresentModeKHR pickPresentMode(const std::vector<vk::PresentModeKHR>& presentModes, vk::PresentModeKHR preferredPresentMode);
 		vk::Extent2D pickSurfaceExtent(const vk::SurfaceCapabilitiesKHR& capabilities, vk::Extent2D frameBufferExtent);
 	};
 
@@ -123,10 +180,12 @@ namespace GraphicEngine::Vulkan
 	public:
 
 		BufferData(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device,
-			const vk::BufferUsageFlags& usageFlags, const vk::MemoryPropertyFlags& properties, uint32_t size);
+			const vk::BufferUsageFlags& usageFlags, const vk::MemoryPropertyFlags& properties, uint32_t size, MemoryLifetime lifetime = MemoryLifetime::Persistent,
+			const std::vector<uint32_t>& queueFamilyIndices = {});
 		virtual ~BufferData() = default;
 
-		vk::UniqueDeviceMemory memory;
+		// Buffer is destroyed before its memory is given back
+		MemoryAllocation memory;
 		vk::UniqueBuffer buffer;
 	};
 
@@ -145,7 +204,7 @@ namespace GraphicEngine::Vulkan
 			vk::ImageCreateFlags flags = vk::ImageCreateFlags());
 
 		vk::Format format;
-		vk::UniqueDeviceMemory deviceMemory;
+		MemoryAllocation deviceMemory;
 		vk::UniqueImage image;
 		vk::UniqueImageView imageView;
 	};
@@ -167,7 +226,9 @@ namespace GraphicEngine::Vulkan
 	class DepthBufferData : public ImageData
 	{
 	public:
-		DepthBufferData(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, vk::Extent3D extent, vk::Format format, vk::SampleCountFlagBits numOfSamples);
+		// Image is created with given usage in addition to depth attachment
+		DepthBufferData(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, vk::Extent3D extent, vk::Format format, vk::SampleCountFlagBits numOfSamples,
+			vk::ImageUsageFlags imageUsage = vk::ImageUsageFlags());
 	};
 
 	class IUniformBuffer;
@@ -176,6 +237,8 @@ namespace GraphicEngine::Vulkan
 
 	std::optional<uint32_t> getGraphicQueueFamilyIndex(const vk::PhysicalDevice& physicalDevice);
 
+	std::optional<uint32_t> getTransferQueueFamilyIndex(const vk::PhysicalDevice& physicalDevice);
+
 	QueueFamilyIndices findGraphicAndPresentQueueFamilyIndices(const vk::PhysicalDevice& physicalDevice, vk::UniqueSurfaceKHR& surface);
 
 	vk::UniqueInstance createUniqueInstance(std::string appName = "",
@@ -190,13 +253,19 @@ namespace GraphicEngine::Vulkan
 
 	vk::UniqueDevice getUniqueLogicalDevice(const vk::PhysicalDevice& physicalDevice, vk::UniqueSurfaceKHR& surface);
 
-	vk::UniqueCommandPool createUniqueCommandPool(const vk::UniqueDevice& device, const QueueFamilyIndices& queueFamilyIndex);
+	vk::UniqueCommandPool createUniqueCommandPool(const vk::UniqueDevice& device, const QueueFamilyIndices& queueFamilyIndex, vk::CommandPoolCreateFlags flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer);
 
 	std::vector<vk::UniqueCommandBuffer> createUniqueCommandBuffers(const vk::UniqueDevice& device, const vk::UniqueCommandPool& commandPool, uint32_t commandCount = 1);
 
 	uint32_t findMemoryType(const vk::PhysicalDevice& physicalDevice, uint32_t typeFilter, vk::MemoryPropertyFlags memoryProperty);
 
-	vk::UniqueDeviceMemory allocateMemory(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, vk::MemoryPropertyFlags memoryProperty, const vk::MemoryRequirements& memoryRequirements);
+	// Allocator used by buffers and images of device, it is created together with device by framework
+	void setDeviceMemoryAllocator(const vk::UniqueDevice& device, std::shared_ptr<DeviceMemoryAllocator> memoryAllocator);
+
+	std::shared_ptr<DeviceMemoryAllocator> getDeviceMemoryAllocator(const vk::UniqueDevice& device);
+
+	MemoryAllocation allocateMemory(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, vk::MemoryPropertyFlags memoryProperty, const vk::MemoryRequirements& memoryRequirements,
+		MemoryLifetime lifetime = MemoryLifetime::Persistent, bool image = false);
 
 	vk::UniqueRenderPass createRenderPass(const vk::UniqueDevice& device, vk::Format colorFormat, vk::Format depthFormat, vk::SampleCountFlagBits msaaSample);
 
@@ -219,7 +288,19 @@ namespace GraphicEngine::Vulkan
 		const vk::UniqueRenderPass& renderPass, vk::SampleCountFlagBits msaaSample, vk::PrimitiveTopology primitiveTopology = vk::PrimitiveTopology::eTriangleList, vk::CullModeFlags cullMode = vk::CullModeFlagBits::eNone, bool depthBoundsTestEnable = false,
 		bool stencilTestEnable = false, vk::CompareOp depthCompareOp = vk::CompareOp::eLess);
 
-	std::vector<vk::VertexInputAttributeDescription> createVertexInputAttributeDescriptions(const std::vector<std::pair<uint32_t, uint32_t>>& vertexSizeOffset);
+	vk::Format getVertexAttributeFormat(const Common::VertexAttribute& vertexAttribute);
+
+	template <size_t N>
+	std::vector<vk::VertexInputAttributeDescription> createVertexInputAttributeDescriptions(const std::array<Common::VertexAttribute, N>& vertexAttributes)
+	{
+		std::vector<vk::VertexInputAttributeDescription> attributeDescriptions;
+		attributeDescriptions.reserve(N);
+		for (uint32_t i{ 0 }; i < N; ++i)
+		{
+			attributeDescriptions.emplace_back(i, 0, getVertexAttributeFormat(vertexAttributes[i]), vertexAttributes[i].offset);
+		}
+		return attributeDescriptions;
+	}
 
 	vk::UniqueDescriptorPool createDescriptorPool(const vk::UniqueDevice& device, const std::vector<vk::DescriptorPoolSize>& descriptorSizes);
 
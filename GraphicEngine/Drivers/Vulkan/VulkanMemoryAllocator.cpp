@@ -0,0 +1,271 @@
+#include "VulkanMemoryAllocator.hpp"
+
+namespace
+{
+	bool isPowerOfTwo(uint64_t value)
+	{
+		return value > 0 && (value & (value - 1)) == 0;
+	}
+
+	uint64_t nextPowerOfTwo(uint64_t value)
+	{
+		uint64_t power{ 1 };
+		while (power < value)
+		{
+			power <<= 1;
+		}
+		return power;
+	}
+
+	uint64_t alignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+}
+
+GraphicEngine::Vulkan::LinearAllocator::LinearAllocator(uint64_t size) :
+	m_size{ size }
+{
+}
+
+std::optional<uint64_t> GraphicEngine::Vulkan::LinearAllocator::allocate(uint64_t size, uint64_t alignment)
+{
+	uint64_t offset = alignUp(m_offset, std::max<uint64_t>(alignment, 1));
+	if (offset + size > m_size)
+	{
+		return std::nullopt;
+	}
+	m_offset = offset + size;
+	++m_allocationsCount;
+	return offset;
+}
+
+void GraphicEngine::Vulkan::LinearAllocator::free(uint64_t offset)
+{
+	if (m_allocationsCount == 0 || offset >= m_offset)
+	{
+		throw std::invalid_argument("Offset was not allocated by linear allocator!");
+	}
+
+	--m_allocationsCount;
+	if (m_allocationsCount == 0)
+	{
+		m_offset = 0;
+	}
+}
+
+bool GraphicEngine::Vulkan::LinearAllocator::isEmpty() const
+{
+	return m_allocationsCount == 0;
+}
+
+uint64_t GraphicEngine::Vulkan::LinearAllocator::getUsedSize() const
+{
+	return m_offset;
+}
+
+uint64_t GraphicEngine::Vulkan::LinearAllocator::getLargestFreeSize() const
+{
+	return m_size - m_offset;
+}
+
+uint64_t GraphicEngine::Vulkan::LinearAllocator::getSize() const
+{
+	return m_size;
+}
+
+GraphicEngine::Vulkan::BuddyAllocator::BuddyAllocator(uint64_t size, uint64_t minBlockSize) :
+	m_size{ size },
+	m_minBlockSize{ minBlockSize }
+{
+	if (!isPowerOfTwo(size) || !isPowerOfTwo(minBlockSize) || minBlockSize > size)
+	{
+		throw std::invalid_argument("Sizes of buddy allocator have to be powers of two!");
+	}
+
+	m_freeBlocks.resize(getLevel(minBlockSize) + 1);
+	m_freeBlocks[0].insert(0);
+}
+
+std::optional<uint64_t> GraphicEngine::Vulkan::BuddyAllocator::allocate(uint64_t size, uint64_t alignment)
+{
+	uint64_t blockSize = std::max({ nextPowerOfTwo(size), nextPowerOfTwo(alignment), m_minBlockSize });
+	if (blockSize > m_size)
+	{
+		return std::nullopt;
+	}
+
+	// Smallest free block which is not smaller than needed one
+	uint32_t level = getLevel(blockSize);
+	uint32_t freeLevel = level + 1;
+	while (freeLevel > 0 && m_freeBlocks[freeLevel - 1].empty())
+	{
+		--freeLevel;
+	}
+	if (freeLevel == 0)
+	{
+		return std::nullopt;
+	}
+	--freeLevel;
+
+	// Lowest offset keeps allocations together at start of memory
+	uint64_t offset = *m_freeBlocks[freeLevel].begin();
+	m_freeBlocks[freeLevel].erase(std::begin(m_freeBlocks[freeLevel]));
+
+	// Upper halves of split blocks stay free
+	for (uint32_t splitLevel{ freeLevel + 1 }; splitLevel <= level; ++splitLevel)
+	{
+		m_freeBlocks[splitLevel].insert(offset + (m_size >> splitLevel));
+	}
+
+	m_allocatedLevels[offset] = level;
+	m_usedSize += blockSize;
+	return offset;
+}
+
+void GraphicEngine::Vulkan::BuddyAllocator::free(uint64_t offset)
+{
+	auto allocated = m_allocatedLevels.find(offset);
+	if (allocated == std::end(m_allocatedLevels))
+	{
+		throw std::invalid_argument("Offset was not allocated by buddy allocator!");
+	}
+
+	uint32_t level = allocated->second;
+	m_allocatedLevels.erase(allocated);
+	m_usedSize -= m_size >> level;
+
+	while (level > 0)
+	{
+		uint64_t buddy = offset ^ (m_size >> level);
+		auto freeBuddy = m_freeBlocks[level].find(buddy);
+		if (freeBuddy == std::end(m_freeBlocks[level]))
+		{
+			break;
+		}
+		m_freeBlocks[level].erase(freeBuddy);
+		offset = std::min(offset, buddy);
+		--level;
+	}
+	m_freeBlocks[level].insert(offset);
+}
+
+bool GraphicEngine::Vulkan::BuddyAllocator::isEmpty() const
+{
+	return m_allocatedLevels.empty();
+}
+
+uint64_t GraphicEngine::Vulkan::BuddyAllocator::getUsedSize() const
+{
+	return m_usedSize;
+}
+
+uint64_t GraphicEngine::Vulkan::BuddyAllocator::getLargestFreeSize() const
+{
+	for (uint32_t level{ 0 }; level < m_freeBlocks.size(); ++level)
+	{
+		if (!m_freeBlocks[level].empty())
+		{
+			return m_size >> level;
+		}
+	}
+	return 0;
+}
+
+uint64_t GraphicEngine::Vulkan::BuddyAllocator::getSize() const
+{
+	return m_size;
+}
+
+uint32_t GraphicEngine::Vulkan::BuddyAllocator::getLevel(uint64_t blockSize) const
+{
+	uint32_t level{ 0 };
+	while ((m_size >> level) > blockSize)
+	{
+		++level;
+	}
+	return level;
+}
+
+GraphicEngine::Vulkan::RingAllocator::RingAllocator(uint64_t size) :
+	m_size{ size }
+{
+}
+
+std::optional<uint64_t> GraphicEngine::Vulkan::RingAllocator::allocate(uint64_t size, uint64_t alignment)
+{
+	uint64_t freeSize = m_size - m_usedSize;
+	uint64_t offset = alignUp(m_head, std::max<uint64_t>(alignment, 1));
+	uint64_t takenSize = offset - m_head + size;
+	if (offset + size > m_size)
+	{
+		// Rest of buffer is skipped and allocation starts at beginning
+		offset = 0;
+		takenSize = m_size - m_head + size;
+	}
+
+	if (takenSize > freeSize)
+	{
+		return std::nullopt;
+	}
+
+	m_head = offset + size;
+	m_usedSize += takenSize;
+	m_openBatchSize += takenSize;
+	return offset;
+}
+
+void GraphicEngine::Vulkan::RingAllocator::closeBatch(uint64_t value)
+{
+	if (value < m_lastValue)
+	{
+		throw std::invalid_argument("Values of batches have to grow!");
+	}
+
+	m_lastValue = value;
+	if (m_openBatchSize > 0)
+	{
+		m_batches.push_back(Batch{ m_openBatchSize, value });
+		m_openBatchSize = 0;
+	}
+}
+
+void GraphicEngine::Vulkan::RingAllocator::release(uint64_t completedValue)
+{
+	while (!m_batches.empty() && m_batches.front().value <= completedValue)
+	{
+		m_usedSize -= m_batches.front().size;
+		m_batches.pop_front();
+	}
+
+	// Whole buffer is free, so next allocations do not have to wrap around
+	if (m_usedSize == 0)
+	{
+		m_head = 0;
+	}
+}
+
+std::optional<uint64_t> GraphicEngine::Vulkan::RingAllocator::getOldestBatchValue() const
+{
+	return m_batches.empty() ? std::nullopt : std::optional<uint64_t>{ m_batches.front().value };
+}
+
+bool GraphicEngine::Vulkan::RingAllocator::hasOpenBatch() const
+{
+	return m_openBatchSize > 0;
+}
+
+bool GraphicEngine::Vulkan::RingAllocator::isEmpty() const
+{
+	return m_usedSize == 0;
+}
+
+uint64_t GraphicEngine::Vulkan::RingAllocator::getUsedSize() const
+{
+	return m_usedSize;
+}
+
+uint64_t GraphicEngine::Vulkan::RingAllocator::getSize() const
+{
+	return m_size;
+}
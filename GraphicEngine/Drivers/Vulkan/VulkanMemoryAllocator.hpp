@@ -0,0 +1,337 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace GraphicEngine::Vulkan
+{
+	struct MemoryStatistics
+	{
+		uint32_t blocksCount{ 0 };
+		uint32_t dedicatedAllocationsCount{ 0 };
+		uint32_t allocationsCount{ 0 };
+		// Bytes of all device memory allocations
+		uint64_t reservedBytes{ 0 };
+		// Bytes taken from blocks and dedicated allocations, includes alignment and rounding of buddy blocks
+		uint64_t usedBytes{ 0 };
+		// Part of free memory in blocks which is not in largest free range of its block, 0 when every block has free memory in one piece
+		float fragmentation{ 0.0f };
+	};
+
+	// Manages ranges of one device memory block
+	class ISubAllocator
+	{
+	public:
+		virtual std::optional<uint64_t> allocate(uint64_t size, uint64_t alignment) = 0;
+		virtual void free(uint64_t offset) = 0;
+		virtual bool isEmpty() const = 0;
+		virtual uint64_t getUsedSize() const = 0;
+		virtual uint64_t getLargestFreeSize() const = 0;
+		virtual uint64_t getSize() const = 0;
+		virtual ~ISubAllocator() = default;
+	};
+
+	// Allocates after last allocation, space is reused only when all allocations are freed.
+	// Suits staging data which is freed right after upload
+	class LinearAllocator : public ISubAllocator
+	{
+	public:
+		LinearAllocator(uint64_t size);
+
+		virtual std::optional<uint64_t> allocate(uint64_t size, uint64_t alignment) override;
+		virtual void free(uint64_t offset) override;
+		virtual bool isEmpty() const override;
+		virtual uint64_t getUsedSize() const override;
+		virtual uint64_t getLargestFreeSize() const override;
+		virtual uint64_t getSize() const override;
+
+	private:
+		uint64_t m_size;
+		uint64_t m_offset{ 0 };
+		uint32_t m_allocationsCount{ 0 };
+	};
+
+	// Power of two blocks are split in halves until they fit allocation, freed block is merged with its free buddy.
+	// Block is aligned to its size, so alignment is given by rounding size up
+	class BuddyAllocator : public ISubAllocator
+	{
+	public:
+		BuddyAllocator(uint64_t size, uint64_t minBlockSize);
+
+		virtual std::optional<uint64_t> allocate(uint64_t size, uint64_t alignment) override;
+		virtual void free(uint64_t offset) override;
+		virtual bool isEmpty() const override;
+		virtual uint64_t getUsedSize() const override;
+		virtual uint64_t getLargestFreeSize() const override;
+		virtual uint64_t getSize() const override;
+
+	private:
+		uint32_t getLevel(uint64_t blockSize) const;
+
+	private:
+		uint64_t m_size;
+		uint64_t m_minBlockSize;
+		uint64_t m_usedSize{ 0 };
+		// Offsets of free blocks for each level, level 0 is whole memory
+		std::vector<std::set<uint64_t>> m_freeBlocks;
+		std::unordered_map<uint64_t, uint32_t> m_allocatedLevels;
+	};
+
+	// Allocates after last allocation and wraps around to start of buffer. Allocations are freed in batches,
+	// in same order as they were made, when value which marks end of batch is reached by GPU
+	class RingAllocator
+	{
+	public:
+		RingAllocator(uint64_t size);
+
+		// Empty when free space behind last allocation is too small, space is freed by releasing older batches
+		std::optional<uint64_t> allocate(uint64_t size, uint64_t alignment);
+		// Allocations made since previous batch are freed when completed value reaches given one
+		void closeBatch(uint64_t value);
+		void release(uint64_t completedValue);
+		// Value of oldest batch which is not released
+		std::optional<uint64_t> getOldestBatchValue() const;
+		bool hasOpenBatch() const;
+		bool isEmpty() const;
+		uint64_t getUsedSize() const;
+		uint64_t getSize() const;
+
+	private:
+		struct Batch
+		{
+			uint64_t size;
+			uint64_t value;
+		};
+
+		uint64_t m_size;
+		uint64_t m_head{ 0 };
+		// Includes alignment and end of buffer skipped on wrap around
+		uint64_t m_usedSize{ 0 };
+		uint64_t m_openBatchSize{ 0 };
+		uint64_t m_lastValue{ 0 };
+		std::deque<Batch> m_batches;
+	};
+
+	enum class MemoryLifetime
+	{
+		// Resources living until scene is released, taken from buddy allocated blocks
+		Persistent,
+		// Staging data freed right after upload, taken from linearly allocated blocks
+		Transient
+	};
+
+	// Sub-allocates device memory from big blocks, so count of device allocations does not grow with count of resources.
+	// Device has to provide type Memory and methods:
+	//   Memory allocate(uint32_t memoryType, uint64_t size);
+	//   void free(Memory memory);
+	//   bool isHostVisible(uint32_t memoryType);
+	//   void* map(Memory memory, uint64_t size);
+	template <typename Device>
+	class MemoryAllocator
+	{
+	public:
+		using Memory = typename Device::Memory;
+
+		struct Allocation
+		{
+			Memory memory{};
+			uint64_t offset{ 0 };
+			uint64_t size{ 0 };
+			// Host visible memory stays mapped for whole life of its block
+			void* mappedData{ nullptr };
+			// Block of allocation, null for dedicated allocation
+			const void* block{ nullptr };
+		};
+
+		// Allocations bigger than half of block get own device memory
+		MemoryAllocator(Device device, uint64_t blockSize, uint64_t minBuddyBlockSize = 256) :
+			m_device{ device },
+			m_blockSize{ blockSize },
+			m_minBuddyBlockSize{ minBuddyBlockSize }
+		{
+		}
+
+		MemoryAllocator(const MemoryAllocator&) = delete;
+		MemoryAllocator& operator=(const MemoryAllocator&) = delete;
+
+		// Images are kept in other blocks than buffers, so they never share page of buffer image granularity
+		Allocation allocate(uint32_t memoryType, uint64_t size, uint64_t alignment, MemoryLifetime lifetime, bool image = false)
+		{
+			std::lock_guard<std::mutex> lock{ m_mutex };
+
+			if (size > m_blockSize / 2)
+			{
+				Allocation allocation;
+				allocation.memory = m_device.allocate(memoryType, size);
+				allocation.size = size;
+				if (m_device.isHostVisible(memoryType))
+				{
+					allocation.mappedData = m_device.map(allocation.memory, size);
+				}
+				++m_dedicatedAllocationsCount;
+				m_dedicatedBytes += size;
+				return allocation;
+			}
+
+			for (auto& block : m_blocks)
+			{
+				if (block->memoryType == memoryType && block->lifetime == lifetime && block->image == image)
+				{
+					if (auto offset = block->allocator->allocate(size, alignment))
+					{
+						return makeAllocation(*block, *offset, size);
+					}
+				}
+			}
+
+			auto& block = createBlock(memoryType, lifetime, image);
+			auto offset = block.allocator->allocate(size, alignment);
+			if (!offset)
+			{
+				throw std::invalid_argument("Alignment of allocation is bigger than memory block!");
+			}
+			return makeAllocation(block, *offset, size);
+		}
+
+		void free(const Allocation& allocation)
+		{
+			std::lock_guard<std::mutex> lock{ m_mutex };
+
+			if (allocation.block == nullptr)
+			{
+				m_device.free(allocation.memory);
+				--m_dedicatedAllocationsCount;
+				m_dedicatedBytes -= allocation.size;
+				return;
+			}
+
+			auto blockIt = std::find_if(std::begin(m_blocks), std::end(m_blocks), [&](const auto& block) { return block.get() == allocation.block; });
+			if (blockIt == std::end(m_blocks))
+			{
+				throw std::invalid_argument("Allocation does not belong to memory allocator!");
+			}
+
+			auto& block = **blockIt;
+			block.allocator->free(allocation.offset);
+			--block.allocationsCount;
+
+			// One empty block of each kind is kept, so allocating and freeing at its border does not allocate device memory each time
+			if (block.allocator->isEmpty())
+			{
+				bool hasOtherEmptyBlock = std::any_of(std::begin(m_blocks), std::end(m_blocks), [&](const auto& other)
+					{
+						return other.get() != &block && other->memoryType == block.memoryType && other->lifetime == block.lifetime && other->image == block.image && other->allocator->isEmpty();
+					});
+				if (hasOtherEmptyBlock)
+				{
+					m_device.free(block.memory);
+					m_blocks.erase(blockIt);
+				}
+			}
+		}
+
+		MemoryStatistics getStatistics()
+		{
+			std::lock_guard<std::mutex> lock{ m_mutex };
+
+			MemoryStatistics statistics;
+			statistics.blocksCount = static_cast<uint32_t>(m_blocks.size());
+			statistics.dedicatedAllocationsCount = m_dedicatedAllocationsCount;
+			statistics.allocationsCount = m_dedicatedAllocationsCount;
+			statistics.reservedBytes = m_dedicatedBytes;
+			statistics.usedBytes = m_dedicatedBytes;
+
+			uint64_t freeBytes{ 0 };
+			uint64_t largestFreeBytes{ 0 };
+			for (const auto& block : m_blocks)
+			{
+				statistics.allocationsCount += block->allocationsCount;
+				statistics.reservedBytes += block->allocator->getSize();
+				statistics.usedBytes += block->allocator->getUsedSize();
+				freeBytes += block->allocator->getSize() - block->allocator->getUsedSize();
+				largestFreeBytes += block->allocator->getLargestFreeSize();
+			}
+			if (freeBytes > 0)
+			{
+				statistics.fragmentation = 1.0f - static_cast<float>(static_cast<double>(largestFreeBytes) / static_cast<double>(freeBytes));
+			}
+			return statistics;
+		}
+
+		~MemoryAllocator()
+		{
+			for (auto& block : m_blocks)
+			{
+				m_device.free(block->memory);
+			}
+		}
+
+	private:
+		struct Block
+		{
+			Memory memory{};
+			void* mappedData{ nullptr };
+			uint32_t memoryType{ 0 };
+			MemoryLifetime lifetime{ MemoryLifetime::Persistent };
+			bool image{ false };
+			uint32_t allocationsCount{ 0 };
+			std::unique_ptr<ISubAllocator> allocator;
+		};
+
+		Block& createBlock(uint32_t memoryType, MemoryLifetime lifetime, bool image)
+		{
+			auto block = std::make_unique<Block>();
+			block->memory = m_device.allocate(memoryType, m_blockSize);
+			if (m_device.isHostVisible(memoryType))
+			{
+				block->mappedData = m_device.map(block->memory, m_blockSize);
+			}
+			block->memoryType = memoryType;
+			block->lifetime = lifetime;
+			block->image = image;
+			if (lifetime == MemoryLifetime::Persistent)
+			{
+				block->allocator = std::make_unique<BuddyAllocator>(m_blockSize, m_minBuddyBlockSize);
+			}
+			else
+			{
+				block->allocator = std::make_unique<LinearAllocator>(m_blockSize);
+			}
+			m_blocks.push_back(std::move(block));
+			return *m_blocks.back();
+		}
+
+		Allocation makeAllocation(Block& block, uint64_t offset, uint64_t size)
+		{
+			++block.allocationsCount;
+
+			Allocation allocation;
+			allocation.memory = block.memory;
+			allocation.offset = offset;
+			allocation.size = size;
+			allocation.block = &block;
+			if (block.mappedData)
+			{
+				allocation.mappedData = static_cast<char*>(block.mappedData) + offset;
+			}
+			return allocation;
+		}
+
+	private:
+		Device m_device;
+		uint64_t m_blockSize;
+		uint64_t m_minBuddyBlockSize;
+		std::vector<std::unique_ptr<Block>> m_blocks;
+		uint32_t m_dedicatedAllocationsCount{ 0 };
+		uint64_t m_dedicatedBytes{ 0 };
+		std::mutex m_mutex;
+	};
+}
@@ -0,0 +1,119 @@
+#include "VulkanMeshArena.hpp"
+
+#include <map>
+#include <stdexcept>
+
+namespace
+{
+	std::mutex meshArenasMutex;
+	std::map<VkDevice, std::weak_ptr<GraphicEngine::Vulkan::MeshArena>> meshArenas;
+}
+
+GraphicEngine::Vulkan::MeshArena::MeshArena(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, std::shared_ptr<TransferBatcher> transferBatcher, uint32_t verticesSize, uint32_t maxIndices) :
+	m_transferBatcher{ transferBatcher },
+	m_ranges{ std::make_shared<Ranges>(verticesSize, maxIndices) }
+{
+	auto queueFamilies = m_transferBatcher->getSharingQueueFamilies();
+	m_vertexBuffer = std::make_unique<BufferData>(physicalDevice, device, vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst,
+		vk::MemoryPropertyFlagBits::eDeviceLocal, verticesSize, MemoryLifetime::Persistent, queueFamilies);
+	m_indexBuffer = std::make_unique<BufferData>(physicalDevice, device, vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eTransferDst,
+		vk::MemoryPropertyFlagBits::eDeviceLocal, static_cast<uint32_t>(sizeof(uint32_t) * maxIndices), MemoryLifetime::Persistent, queueFamilies);
+}
+
+GraphicEngine::Vulkan::MeshArena::Allocation GraphicEngine::Vulkan::MeshArena::allocate(const void* vertices, uint32_t vertexSize, uint32_t verticesCount, const uint32_t* indices, uint32_t indexCount)
+{
+	Allocation allocation;
+	{
+		std::lock_guard<std::mutex> lock{ m_ranges->mutex };
+		auto verticesOffset = m_ranges->vertices.allocate(vertexSize * verticesCount, vertexSize);
+		if (!verticesOffset)
+		{
+			throw std::runtime_error("Vertex buffer of mesh arena is full!");
+		}
+		auto firstIndex = m_ranges->indices.allocate(indexCount);
+		if (!firstIndex)
+		{
+			m_ranges->vertices.free(*verticesOffset);
+			throw std::runtime_error("Index buffer of mesh arena is full!");
+		}
+
+		allocation.verticesOffset = *verticesOffset;
+		allocation.vertexOffset = static_cast<int32_t>(*verticesOffset / vertexSize);
+		allocation.verticesCount = verticesCount;
+		allocation.firstIndex = *firstIndex;
+		allocation.indexCount = indexCount;
+	}
+
+	m_transferBatcher->upload(m_vertexBuffer->buffer.get(), vertices, static_cast<uint64_t>(vertexSize) * verticesCount, allocation.verticesOffset);
+	m_transferBatcher->upload(m_indexBuffer->buffer.get(), indices, sizeof(uint32_t) * indexCount, sizeof(uint32_t) * allocation.firstIndex);
+	return allocation;
+}
+
+void GraphicEngine::Vulkan::MeshArena::free(const Allocation& allocation)
+{
+	std::lock_guard<std::mutex> lock{ m_ranges->mutex };
+	m_ranges->freedAllocations.push_back(allocation);
+}
+
+std::shared_ptr<void> GraphicEngine::Vulkan::MeshArena::retireFreedRanges()
+{
+	std::lock_guard<std::mutex> lock{ m_ranges->mutex };
+	if (m_ranges->freedAllocations.empty())
+	{
+		return nullptr;
+	}
+	auto retiredRanges = std::make_shared<RetiredRanges>();
+	retiredRanges->ranges = m_ranges;
+	retiredRanges->allocations = std::move(m_ranges->freedAllocations);
+	m_ranges->freedAllocations.clear();
+	return retiredRanges;
+}
+
+void GraphicEngine::Vulkan::MeshArena::bind(const vk::UniqueCommandBuffer& commandBuffer) const
+{
+	commandBuffer->bindVertexBuffers(0, m_vertexBuffer->buffer.get(), { 0 });
+	commandBuffer->bindIndexBuffer(m_indexBuffer->buffer.get(), 0, vk::IndexType::eUint32);
+}
+
+vk::Buffer GraphicEngine::Vulkan::MeshArena::getVertexBuffer() const
+{
+	return m_vertexBuffer->buffer.get();
+}
+
+vk::Buffer GraphicEngine::Vulkan::MeshArena::getIndexBuffer() const
+{
+	return m_indexBuffer->buffer.get();
+}
+
+GraphicEngine::Vulkan::MeshArena::Ranges::Ranges(uint32_t verticesSize, uint32_t maxIndices) :
+	vertices{ verticesSize },
+	indices{ maxIndices }
+{
+}
+
+GraphicEngine::Vulkan::MeshArena::RetiredRanges::~RetiredRanges()
+{
+	std::lock_guard<std::mutex> lock{ ranges->mutex };
+	for (const auto& allocation : allocations)
+	{
+		ranges->vertices.free(static_cast<uint32_t>(allocation.verticesOffset));
+		ranges->indices.free(allocation.firstIndex);
+	}
+}
+
+void GraphicEngine::Vulkan::setDeviceMeshArena(const vk::UniqueDevice& device, std::shared_ptr<MeshArena> meshArena)
+{
+	std::lock_guard<std::mutex> lock{ meshArenasMutex };
+	meshArenas[static_cast<VkDevice>(device.get())] = meshArena;
+}
+
+std::shared_ptr<GraphicEngine::Vulkan::MeshArena> GraphicEngine::Vulkan::findDeviceMeshArena(const vk::UniqueDevice& device)
+{
+	std::lock_guard<std::mutex> lock{ meshArenasMutex };
+	auto meshArena = meshArenas.find(static_cast<VkDevice>(device.get()));
+	if (meshArena == std::end(meshArenas))
+	{
+		return nullptr;
+	}
+	return meshArena->second.lock();
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "VulkanHelper.hpp"
+#include "VulkanTransferBatcher.hpp"
+#include "../../Common/RangeAllocator.hpp"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace GraphicEngine::Vulkan
+{
+	// Device local vertex and index buffers shared by meshes, so all meshes of one vertex type can be drawn by one indirect draw.
+	// Vertices of mesh start at multiple of their size, so they are addressed by vertex offset of draw
+	class MeshArena
+	{
+	public:
+		struct Allocation
+		{
+			// Offset of first vertex in bytes, used when mesh is bound alone
+			vk::DeviceSize verticesOffset{ 0 };
+			int32_t vertexOffset{ 0 };
+			uint32_t verticesCount{ 0 };
+			uint32_t firstIndex{ 0 };
+			uint32_t indexCount{ 0 };
+		};
+
+		// Data is uploaded by given batcher and buffers are shared with its queue families
+		MeshArena(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, std::shared_ptr<TransferBatcher> transferBatcher, uint32_t verticesSize, uint32_t maxIndices);
+
+		MeshArena(const MeshArena&) = delete;
+		MeshArena& operator=(const MeshArena&) = delete;
+
+		// Copies are recorded by transfer batcher, so mesh can be drawn by frame submitted after them
+		Allocation allocate(const void* vertices, uint32_t vertexSize, uint32_t verticesCount, const uint32_t* indices, uint32_t indexCount);
+		// Frames in flight may still draw mesh, so ranges are reused only after they are retired
+		void free(const Allocation& allocation);
+		// Ranges freed since last call are given back to arena when returned resource is destroyed, null when nothing was freed
+		std::shared_ptr<void> retireFreedRanges();
+
+		// Vertex buffer is bound at offset 0, so draws of meshes are placed by vertex offset and first index
+		void bind(const vk::UniqueCommandBuffer& commandBuffer) const;
+		vk::Buffer getVertexBuffer() const;
+		vk::Buffer getIndexBuffer() const;
+
+	private:
+		// Shared with retired ranges, which can be released after arena itself
+		struct Ranges
+		{
+			Ranges(uint32_t verticesSize, uint32_t maxIndices);
+
+			std::mutex mutex;
+			Common::RangeAllocator vertices;
+			Common::RangeAllocator indices;
+			std::vector<Allocation> freedAllocations;
+		};
+
+		struct RetiredRanges
+		{
+			std::shared_ptr<Ranges> ranges;
+			std::vector<Allocation> allocations;
+
+			~RetiredRanges();
+		};
+
+	private:
+		std::shared_ptr<TransferBatcher> m_transferBatcher;
+		std::shared_ptr<Ranges> m_ranges;
+		std::unique_ptr<BufferData> m_vertexBuffer;
+		std::unique_ptr<BufferData> m_indexBuffer;
+	};
+
+	// Arena used by vertex buffers of device, it is created by framework
+	void setDeviceMeshArena(const vk::UniqueDevice& device, std::shared_ptr<MeshArena> meshArena);
+
+	// Null when device has no arena, then every vertex buffer has own buffers
+	std::shared_ptr<MeshArena> findDeviceMeshArena(const vk::UniqueDevice& device);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "VulkanHelper.hpp"
+
+#include <cstring>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace GraphicEngine::Vulkan
+{
+	// Array of elements kept by CPU and mirrored to host visible storage buffer of every swap chain image.
+	// Buffer of image is only written by update of that image, so frames in flight keep reading elements they were recorded with
+	template <typename T>
+	class MirroredStorageBuffer
+	{
+	public:
+		MirroredStorageBuffer(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, uint32_t imagesCount, uint32_t capacity) :
+			m_elements(capacity),
+			m_dirtyElements(imagesCount)
+		{
+			// Buffers start with default elements, so setting element to default value does not have to be copied
+			for (uint32_t i{ 0 }; i < imagesCount; ++i)
+			{
+				m_buffers.push_back(std::make_unique<BufferData>(physicalDevice, device, vk::BufferUsageFlagBits::eStorageBuffer,
+					vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, static_cast<uint32_t>(sizeof(T) * capacity)));
+				copyMemoryToDevice(m_buffers.back()->memory, m_elements.data(), capacity);
+			}
+		}
+
+		MirroredStorageBuffer(const MirroredStorageBuffer&) = delete;
+		MirroredStorageBuffer& operator=(const MirroredStorageBuffer&) = delete;
+
+		// Element equal to current one is not copied again
+		void set(uint32_t index, const T& element)
+		{
+			T& current = m_elements.at(index);
+			if (std::memcmp(&current, &element, sizeof(T)) == 0)
+				return;
+
+			current = element;
+			for (auto& dirtyElements : m_dirtyElements)
+			{
+				dirtyElements.insert(index);
+			}
+		}
+
+		const T& get(uint32_t index) const
+		{
+			return m_elements.at(index);
+		}
+
+		// Copies elements changed since last update of image, neighbouring ones are copied together.
+		// Frame which read buffer of image has to be finished, e.g. image was just acquired
+		void update(uint32_t imageIndex)
+		{
+			auto& dirtyElements = m_dirtyElements.at(imageIndex);
+			auto element = std::begin(dirtyElements);
+			while (element != std::end(dirtyElements))
+			{
+				uint32_t first = *element;
+				uint32_t count{ 1 };
+				while (++element != std::end(dirtyElements) && *element == first + count)
+				{
+					++count;
+				}
+				copyMemoryToDevice(m_buffers[imageIndex]->memory, &m_elements[first], count, static_cast<uint32_t>(sizeof(T) * first));
+			}
+			dirtyElements.clear();
+		}
+
+		vk::Buffer getBuffer(uint32_t imageIndex) const
+		{
+			return m_buffers.at(imageIndex)->buffer.get();
+		}
+
+		uint32_t getCapacity() const
+		{
+			return static_cast<uint32_t>(m_elements.size());
+		}
+
+	private:
+		std::vector<T> m_elements;
+		std::vector<std::set<uint32_t>> m_dirtyElements;
+		std::vector<std::unique_ptr<BufferData>> m_buffers;
+	};
+}
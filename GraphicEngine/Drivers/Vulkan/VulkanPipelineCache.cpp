@@ -0,0 +1,48 @@
+#include "VulkanPipelineCache.hpp"
+
+#include <cstring>
+
+namespace
+{
+	// Values of VkPipelineCacheHeaderVersionOne
+	constexpr uint32_t headerVersionOne{ 1 };
+	constexpr uint32_t headerVersionOneSize{ 32 };
+
+	uint32_t readUint32(const std::string& data, size_t offset)
+	{
+		// Header is written in little endian order
+		uint32_t value{ 0 };
+		for (size_t i{ 0 }; i < sizeof(uint32_t); ++i)
+		{
+			value |= static_cast<uint32_t>(static_cast<uint8_t>(data[offset + i])) << (8 * i);
+		}
+		return value;
+	}
+}
+
+std::optional<GraphicEngine::Vulkan::PipelineCacheHeader> GraphicEngine::Vulkan::readPipelineCacheHeader(const std::string& data)
+{
+	if (data.size() < headerVersionOneSize)
+	{
+		return std::nullopt;
+	}
+
+	PipelineCacheHeader header;
+	header.headerSize = readUint32(data, 0);
+	header.headerVersion = readUint32(data, 4);
+	header.vendorId = readUint32(data, 8);
+	header.deviceId = readUint32(data, 12);
+	std::memcpy(header.pipelineCacheUuid.data(), data.data() + 16, header.pipelineCacheUuid.size());
+
+	if (header.headerVersion != headerVersionOne || header.headerSize < headerVersionOneSize || header.headerSize > data.size())
+	{
+		return std::nullopt;
+	}
+	return header;
+}
+
+bool GraphicEngine::Vulkan::isPipelineCacheCompatible(const std::string& data, uint32_t vendorId, uint32_t deviceId, const std::array<uint8_t, 16>& pipelineCacheUuid)
+{
+	auto header = readPipelineCacheHeader(data);
+	return header.has_value() && header->vendorId == vendorId && header->deviceId == deviceId && header->pipelineCacheUuid == pipelineCacheUuid;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace GraphicEngine::Vulkan
+{
+	// Header written by driver at start of pipeline cache data, same layout as VkPipelineCacheHeaderVersionOne
+	struct PipelineCacheHeader
+	{
+		uint32_t headerSize{ 0 };
+		uint32_t headerVersion{ 0 };
+		uint32_t vendorId{ 0 };
+		uint32_t deviceId{ 0 };
+		std::array<uint8_t, 16> pipelineCacheUuid{};
+	};
+
+	// Empty when data is too short for header or header is not version one
+	std::optional<PipelineCacheHeader> readPipelineCacheHeader(const std::string& data);
+
+	// Cache saved by other device or driver version is rejected, so driver does not have to parse it
+	bool isPipelineCacheCompatible(const std::string& data, uint32_t vendorId, uint32_t deviceId, const std::array<uint8_t, 16>& pipelineCacheUuid);
+}
@@ -6,17 +6,54 @@
 #include "VulkanTextureFactory.hpp"
 #include "VulkanVertexBufferFactory.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <execution>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <thread>
+
 #undef max
+#undef min
+
+namespace
+{
+	// Smaller parts are recorded faster by one thread than it takes to start another one
+	constexpr uint32_t minDrawsPerRecordingThread{ 256 };
+	// Saved shader is usually compiled before next frame is looked at
+	constexpr std::chrono::milliseconds shaderWatchInterval{ 250 };
+
+	vk::PresentModeKHR parsePresentMode(const std::string& presentMode)
+	{
+		static const std::map<std::string, vk::PresentModeKHR> presentModes =
+		{
+			{ "mailbox", vk::PresentModeKHR::eMailbox },
+			{ "immediate", vk::PresentModeKHR::eImmediate },
+			{ "fifo", vk::PresentModeKHR::eFifo },
+			{ "fifo relaxed", vk::PresentModeKHR::eFifoRelaxed }
+		};
+
+		auto it = presentModes.find(presentMode);
+		if (it == std::end(presentModes))
+		{
+			throw std::invalid_argument("Unknown present mode: " + presentMode);
+		}
+		return it->second;
+	}
+}
 
 GraphicEngine::Vulkan::VulkanRenderingEngine::VulkanRenderingEngine(std::shared_ptr<VulkanWindowContext> vulkanWindowContext,
 	std::shared_ptr<Services::ServicesManager> servicesManager,
 	std::shared_ptr<Core::EventManager> eventManager,
 	std::shared_ptr<Core::Timer> timer,
+	std::shared_ptr<Core::Profiler> profiler,
 	std::shared_ptr<Common::UI> ui,
 	std::shared_ptr<Core::Configuration> cfg,
 	std::unique_ptr<Core::Logger<VulkanRenderingEngine>> logger) :
 	m_vulkanWindowContext(vulkanWindowContext),
-	RenderingEngine(servicesManager, eventManager, timer, ui, cfg)
+	RenderingEngine(servicesManager, eventManager, timer, profiler, ui, cfg)
 {
 }
 
@@ -24,8 +61,17 @@ bool GraphicEngine::Vulkan::VulkanRenderingEngine::drawFrame()
 {
 	try
 	{
-		m_framework->acquireFrame();
-		buildCommandBuffers();
+		// Window is minimized, nothing can be presented
+		if (!m_framework->acquireFrame())
+		{
+			return false;
+		}
+		// Pipelines recompiled on watching thread replace old ones before recording
+		m_framework->m_shaderCompiler->update();
+		{
+			PROFILE_CPU_ZONE(m_profiler, "Record command buffer");
+			recordCommandBuffer();
+		}
 
 		auto view = m_cameraControllerManager->getActiveCamera()->getViewMatrix();
 		auto projection = m_cameraControllerManager->getActiveCamera()->getProjectionMatrix();
@@ -43,9 +89,14 @@ bool GraphicEngine::Vulkan::VulkanRenderingEngine::drawFrame()
 			m_wireframeGraphicPipeline->updateDynamicUniforms();
 		if (m_viewportManager->displaySolid)
 			m_solidColorraphicPipeline->updateDynamicUniforms();
+		// Only objects changed since last frame of this image are copied
+		m_framework->m_bindlessDescriptors->update(m_framework->m_imageIndex.value);
 		
 
-		m_framework->submitFrame();
+		{
+			PROFILE_CPU_ZONE(m_profiler, "Submit");
+			m_framework->submitFrame();
+		}
 	}
 
 	catch (vk::OutOfDateKHRError err)
@@ -60,12 +111,24 @@ void GraphicEngine::Vulkan::VulkanRenderingEngine::init(size_t width, size_t hei
 {
 	try
 	{
+		// Zero records with all hardware threads
+		uint32_t recordingThreads = m_cfg->getProperty<int>("rendering options:recording threads");
+		bool occlusionCulling = m_cfg->getProperty<bool>("rendering options:gpu culling:occlusion");
 		m_framework = std::make_shared<VulkanFramework>();
 		m_framework->
 			initialize(m_vulkanWindowContext, "Graphic Engine", "Vulkan Base", width, height, vk::SampleCountFlagBits::e2, { "VK_LAYER_KHRONOS_validation" }, std::make_unique<Core::Logger<VulkanFramework>>())
+			.setSwapChainImageUsage(m_frameCaptureEnabled ? vk::ImageUsageFlagBits::eTransferSrc : vk::ImageUsageFlags())
+			.setDepthBufferUsage(occlusionCulling ? vk::ImageUsageFlagBits::eSampled : vk::ImageUsageFlags())
+			.setFramesInFlight(m_cfg->getProperty<int>("rendering options:frames in flight"))
+			.setPresentMode(parsePresentMode(m_cfg->getProperty<std::string>("rendering options:present mode")))
+			.setRecordingThreads(recordingThreads > 0 ? recordingThreads : std::max(1u, std::thread::hardware_concurrency()))
 			.initializeCommandBuffer()
 			.initializeFramebuffer()
-			.initalizeRenderingBarriers();
+			.initalizeRenderingBarriers()
+			.initializeBindlessDescriptors(m_cfg->getProperty<int>("rendering options:bindless:max objects"), m_cfg->getProperty<int>("rendering options:bindless:max textures"))
+			.initializeMeshArena(m_cfg->getProperty<int>("rendering options:mesh arena:vertices size"), m_cfg->getProperty<int>("rendering options:mesh arena:max indices"))
+			.initializePipelineCache(m_cfg->getProperty<std::string>("paths:pipeline cache"))
+			.initializeShaderCompiler(m_cfg->getProperty<std::string>("paths:shader cache"));
 
 		m_cameraUniformBuffer = m_framework->getUniformBuffer<UniformBuffer,Engines::Graphic::Shaders::CameraMatrices>();
 		m_directionalLight = std::make_shared<ShaderStorageBufferObject<Engines::Graphic::Shaders::DirectionalLight>>(m_framework.get());
@@ -75,9 +138,14 @@ void GraphicEngine::Vulkan::VulkanRenderingEngine::init(size_t width, size_t hei
 		m_eyePositionUniformBuffer = m_framework->getUniformBuffer<UniformBuffer, Engines::Graphic::Shaders::Eye>();
 
 		m_wireframeGraphicPipeline = std::make_shared<VulkanWireframeGraphicPipeline>(m_framework, m_cameraUniformBuffer);
-		m_solidColorraphicPipeline = std::make_shared<VulkanSolidColorGraphicPipeline>(m_framework, m_cameraUniformBuffer, m_eyePositionUniformBuffer, m_directionalLight, m_pointLights, m_spotLight, m_cameraControllerManager);
+		m_cullingPass = std::make_shared<CullingPass>(m_framework, m_cfg->getProperty<int>("rendering options:gpu culling:max draws"), occlusionCulling);
+		m_solidColorraphicPipeline = std::make_shared<VulkanSolidColorGraphicPipeline>(m_framework, m_cameraUniformBuffer, m_eyePositionUniformBuffer, m_directionalLight, m_pointLights, m_spotLight, m_cameraControllerManager, m_cullingPass);
 		m_normalDebugGraphicPipeline = std::make_shared<VulkanNormalDebugGraphicPipeline>(m_framework, m_cameraUniformBuffer, m_cameraControllerManager);
 		m_skyboxGraphicPipeline = std::make_unique<VulkanSkyboxGraphicPipeline>(m_framework, m_cameraUniformBuffer, m_cfg->getProperty<std::string>("scene:skybox:texture path"));
+		if (m_cfg->getProperty<bool>("rendering options:shader hot reload"))
+		{
+			m_framework->m_shaderCompiler->startWatching(shaderWatchInterval);
+		}
 
 		m_modelManager->getModelEntityContainer()->forEachEntity([&](auto model)
 		{
@@ -89,8 +157,16 @@ void GraphicEngine::Vulkan::VulkanRenderingEngine::init(size_t width, size_t hei
 				m_normalDebugGraphicPipeline->addVertexBuffer<decltype(mesh)::element_type::vertex_type>(mesh, vb);
 			}
 		});
+		// Copies of all meshes are submitted together and first frame waits for them on GPU
+		m_framework->m_transferBatcher->flush();
+		m_framework->logMemoryStatistics();
+
 		m_uiRenderingBackend = std::make_shared<GUI::ImGuiImpl::VulkanRenderEngineBackend>(m_framework);
 		m_ui->addBackend(m_uiRenderingBackend);
+
+#ifdef GRAPHIC_ENGINE_PROFILER
+		m_gpuTimer = std::make_unique<GpuTimer>(m_framework.get(), m_profiler);
+#endif
 	}
 
 	catch (vk::SystemError& err)
@@ -114,9 +190,11 @@ void GraphicEngine::Vulkan::VulkanRenderingEngine::resizeFrameBuffer(size_t widt
 	if (width == 0 || height == 0)
 		return;
 
-	m_framework->initializeFramebuffer(width, height);
+	// Swap chain may be already recreated when acquire or present reported it out of date
+	if (m_framework->m_swapChainData.extent == vk::Extent2D(static_cast<uint32_t>(width), static_cast<uint32_t>(height)))
+		return;
 
-	buildCommandBuffers();
+	m_framework->recreateSwapChain(static_cast<int>(width), static_cast<int>(height));
 }
 
 void GraphicEngine::Vulkan::VulkanRenderingEngine::cleanup()
@@ -125,44 +203,200 @@ void GraphicEngine::Vulkan::VulkanRenderingEngine::cleanup()
 	m_framework->m_device->waitIdle();
 }
 
-void GraphicEngine::Vulkan::VulkanRenderingEngine::buildCommandBuffers()
+GraphicEngine::FrameCapture GraphicEngine::Vulkan::VulkanRenderingEngine::captureFrame()
+{
+	if (!m_frameCaptureEnabled)
+	{
+		throw std::runtime_error("Frame capture has to be enabled before Vulkan rendering engine initialization!");
+	}
+
+	auto extent = m_framework->m_swapChainData.extent;
+	FrameCapture frameCapture{ extent.width, extent.height };
+	frameCapture.pixels.resize(static_cast<size_t>(extent.width) * extent.height * 4);
+
+	m_framework->m_device->waitIdle();
+	auto& captureBuffer = m_captureBuffers[m_framework->m_imageIndex.value];
+	std::memcpy(frameCapture.pixels.data(), captureBuffer->memory.getMappedData(), frameCapture.pixels.size());
+
+	auto format = m_framework->m_swapChainData.format;
+	if (format == vk::Format::eB8G8R8A8Unorm || format == vk::Format::eB8G8R8A8Srgb)
+	{
+		for (size_t i{ 0 }; i < frameCapture.pixels.size(); i += 4)
+		{
+			std::swap(frameCapture.pixels[i], frameCapture.pixels[i + 2]);
+		}
+	}
+
+	return frameCapture;
+}
+
+void GraphicEngine::Vulkan::VulkanRenderingEngine::recordFrameCapture(vk::UniqueCommandBuffer& commandBuffer, uint32_t imageIndex)
+{
+	// Presented image does not belong to application anymore, so it is copied out as part of the frame
+	auto extent = m_framework->m_swapChainData.extent;
+	uint32_t size = extent.width * extent.height * 4;
+	if (m_captureBuffers.size() != m_framework->m_swapChainData.images.size() || m_captureBufferSize != size)
+	{
+		// Frames in flight may still copy into old buffers, so they are kept until those frames are finished
+		for (auto& captureBuffer : m_captureBuffers)
+		{
+			m_framework->retireResource(std::move(captureBuffer));
+		}
+		m_captureBuffers.resize(m_framework->m_swapChainData.images.size());
+		for (auto& captureBuffer : m_captureBuffers)
+		{
+			captureBuffer = std::make_unique<BufferData>(m_framework->m_physicalDevice, m_framework->m_device, vk::BufferUsageFlagBits::eTransferDst,
+				vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, size);
+		}
+		m_captureBufferSize = size;
+	}
+
+	vk::Image image = m_framework->m_swapChainData.images[imageIndex];
+	vk::ImageSubresourceRange subresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1);
+
+	vk::ImageMemoryBarrier toTransfer(vk::AccessFlagBits::eColorAttachmentWrite, vk::AccessFlagBits::eTransferRead,
+		vk::ImageLayout::ePresentSrcKHR, vk::ImageLayout::eTransferSrcOptimal, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, image, subresourceRange);
+	commandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eColorAttachmentOutput, vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlags(), nullptr, nullptr, toTransfer);
+
+	vk::BufferImageCopy region(0, 0, 0, vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1), vk::Offset3D(0, 0, 0), vk::Extent3D(extent, 1));
+	commandBuffer->copyImageToBuffer(image, vk::ImageLayout::eTransferSrcOptimal, m_captureBuffers[imageIndex]->buffer.get(), region);
+
+	vk::ImageMemoryBarrier toPresent(vk::AccessFlagBits::eTransferRead, vk::AccessFlags(),
+		vk::ImageLayout::eTransferSrcOptimal, vk::ImageLayout::ePresentSrcKHR, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, image, subresourceRange);
+	commandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe, vk::DependencyFlags(), nullptr, nullptr, toPresent);
+}
+
+void GraphicEngine::Vulkan::VulkanRenderingEngine::recordCommandBuffer()
 {
 	std::array<vk::ClearValue, 3> clearValues;
 
 	clearValues[0].color = vk::ClearColorValue(std::array<float, 4>({ m_viewportManager->backgroudColor.r, m_viewportManager->backgroudColor.g, m_viewportManager->backgroudColor.b, m_viewportManager->backgroudColor.a }));
 	clearValues[1].depthStencil = vk::ClearDepthStencilValue(1.0f, 0.0f);
 	clearValues[2].color = vk::ClearColorValue(std::array<float, 4>({ m_viewportManager->backgroudColor.r, m_viewportManager->backgroudColor.g, m_viewportManager->backgroudColor.b, m_viewportManager->backgroudColor.a }));
-	int i{ 0 };
-	m_framework->m_device->waitIdle();
+
+	// Frame buffer and per image resources are selected by acquired image, queries by frame in flight
+	uint32_t imageIndex = m_framework->m_imageIndex.value;
+	uint32_t frameIndex = m_framework->m_currentFrameIndex;
+	auto& commandBuffer = m_framework->getFrameCommandBuffer();
+
+#ifdef GRAPHIC_ENGINE_PROFILER
+	// Fence of this frame was waited in acquire, so queries of its previous submission are available
+	m_gpuTimer->collect(frameIndex);
+#endif
 
 	m_ui->nextFrame();
 	m_ui->drawUi();
 
-	for (auto& commandBuffer : m_framework->m_commandBuffers)
+	// Draws of all enabled pipelines are one list split into contiguous parts, every part is recorded by one thread into own secondary buffer
+	std::vector<std::pair<uint32_t, std::function<void(vk::UniqueCommandBuffer&, uint32_t, uint32_t)>>> drawLists;
+	if (m_viewportManager->displayNormal)
+	{
+		drawLists.emplace_back(m_normalDebugGraphicPipeline->getDrawsCount(), [&](vk::UniqueCommandBuffer& secondaryCommandBuffer, uint32_t first, uint32_t last)
+		{
+			m_normalDebugGraphicPipeline->draw(secondaryCommandBuffer, imageIndex, first, last);
+		});
+	}
+	if (m_viewportManager->displayWireframe)
 	{
-		commandBuffer->begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlags()));
+		drawLists.emplace_back(m_wireframeGraphicPipeline->getDrawsCount(), [&](vk::UniqueCommandBuffer& secondaryCommandBuffer, uint32_t first, uint32_t last)
+		{
+			m_wireframeGraphicPipeline->draw(secondaryCommandBuffer, imageIndex, first, last);
+		});
+	}
+	if (m_viewportManager->displaySolid)
+	{
+		drawLists.emplace_back(m_solidColorraphicPipeline->getDrawsCount(), [&](vk::UniqueCommandBuffer& secondaryCommandBuffer, uint32_t first, uint32_t last)
+		{
+			m_solidColorraphicPipeline->draw(secondaryCommandBuffer, imageIndex, first, last);
+		});
+	}
 
-		commandBuffer->setViewport(0, vk::Viewport(0.0f, static_cast<float>(m_framework->m_swapChainData.extent.height),
-			static_cast<float>(m_framework->m_swapChainData.extent.width), -static_cast<float>(m_framework->m_swapChainData.extent.height), 0.0f, 1.0f));
-		commandBuffer->setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), m_framework->m_swapChainData.extent));
+	auto& secondaryCommandBuffers = m_framework->getFrameSecondaryCommandBuffers();
+	uint32_t drawsCount = std::accumulate(std::begin(drawLists), std::end(drawLists), 0u, [](uint32_t count, const auto& drawList) { return count + drawList.first; });
+	uint32_t partsCount = std::min(m_framework->m_recordingThreads, (drawsCount + minDrawsPerRecordingThread - 1) / minDrawsPerRecordingThread);
 
-		vk::RenderPassBeginInfo renderPassBeginInfo(m_framework->m_renderPass.get(), m_framework->m_frameBuffers[i].get(), vk::Rect2D(vk::Offset2D(0, 0), m_framework->m_swapChainData.extent), static_cast<uint32_t>(clearValues.size()), clearValues.data());
-		commandBuffer->beginRenderPass(renderPassBeginInfo, vk::SubpassContents::eInline);
+	vk::CommandBufferInheritanceInfo inheritanceInfo(m_framework->m_renderPass.get(), 0, m_framework->m_frameBuffers[imageIndex].get());
+	vk::CommandBufferBeginInfo secondaryBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit | vk::CommandBufferUsageFlagBits::eRenderPassContinue, &inheritanceInfo);
+	vk::Viewport viewport(0.0f, static_cast<float>(m_framework->m_swapChainData.extent.height),
+		static_cast<float>(m_framework->m_swapChainData.extent.width), -static_cast<float>(m_framework->m_swapChainData.extent.height), 0.0f, 1.0f);
+	vk::Rect2D scissor(vk::Offset2D(0, 0), m_framework->m_swapChainData.extent);
 
-		if (m_viewportManager->displayNormal)
-			m_normalDebugGraphicPipeline->draw(commandBuffer, i);
-		if (m_viewportManager->displayWireframe)
-			m_wireframeGraphicPipeline->draw(commandBuffer, i);
-		if (m_viewportManager->displaySolid)
-			m_solidColorraphicPipeline->draw(commandBuffer, i);
-		if (m_viewportManager->displaySkybox)
-			m_skyboxGraphicPipeline->draw(commandBuffer, i);
+	// Dynamic state is not inherited from primary command buffer
+	auto beginSecondaryCommandBuffer = [&](vk::UniqueCommandBuffer& secondaryCommandBuffer)
+	{
+		secondaryCommandBuffer->begin(secondaryBeginInfo);
+		secondaryCommandBuffer->setViewport(0, viewport);
+		secondaryCommandBuffer->setScissor(0, scissor);
+	};
+
+	std::vector<uint32_t> parts(partsCount);
+	std::iota(std::begin(parts), std::end(parts), 0);
+	std::for_each(std::execution::par, std::begin(parts), std::end(parts), [&](uint32_t part)
+	{
+		auto& secondaryCommandBuffer = secondaryCommandBuffers[part];
+		uint32_t first = static_cast<uint32_t>(static_cast<uint64_t>(drawsCount) * part / partsCount);
+		uint32_t last = static_cast<uint32_t>(static_cast<uint64_t>(drawsCount) * (part + 1) / partsCount);
 
-		m_uiRenderingBackend->renderData(commandBuffer);
+		beginSecondaryCommandBuffer(secondaryCommandBuffer);
+		uint32_t firstDraw{ 0 };
+		for (auto& [count, draw] : drawLists)
+		{
+			uint32_t begin = std::max(first, firstDraw);
+			uint32_t end = std::min(last, firstDraw + count);
+			if (begin < end)
+			{
+				draw(secondaryCommandBuffer, begin - firstDraw, end - firstDraw);
+			}
+			firstDraw += count;
+		}
+		secondaryCommandBuffer->end();
+	});
+
+	// Skybox is drawn after scene, so it is rejected by depth test, and UI is drawn over everything
+	auto& lastCommandBuffer = secondaryCommandBuffers.back();
+	beginSecondaryCommandBuffer(lastCommandBuffer);
+	if (m_viewportManager->displaySkybox)
+	{
+		m_skyboxGraphicPipeline->draw(lastCommandBuffer, imageIndex);
+	}
+	m_uiRenderingBackend->renderData(lastCommandBuffer);
+	lastCommandBuffer->end();
 
-		commandBuffer->endRenderPass();
+	commandBuffer->begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+#ifdef GRAPHIC_ENGINE_PROFILER
+	m_gpuTimer->reset(commandBuffer, frameIndex);
+#endif
 
-		commandBuffer->end();
-		++i;
+	// Commands of solid draws are written by culling pass, which can not run inside render pass
+	auto camera = m_cameraControllerManager->getActiveCamera();
+	if (m_viewportManager->displaySolid)
+	{
+		m_cullingPass->recordCulling(commandBuffer, imageIndex, camera->getViewProjectionMatrix(), camera->getPosition());
 	}
+
+	vk::RenderPassBeginInfo renderPassBeginInfo(m_framework->m_renderPass.get(), m_framework->m_frameBuffers[imageIndex].get(), vk::Rect2D(vk::Offset2D(0, 0), m_framework->m_swapChainData.extent), static_cast<uint32_t>(clearValues.size()), clearValues.data());
+
+	{
+		// Render pass with secondary command buffers allows only their execution, so queries can not be written between pipelines
+		PROFILE_GPU_COMMAND_ZONE(m_gpuTimer, commandBuffer, frameIndex, "Scene");
+		commandBuffer->beginRenderPass(renderPassBeginInfo, vk::SubpassContents::eSecondaryCommandBuffers);
+
+		std::vector<vk::CommandBuffer> executedCommandBuffers;
+		for (uint32_t part{ 0 }; part < partsCount; ++part)
+		{
+			executedCommandBuffers.push_back(secondaryCommandBuffers[part].get());
+		}
+		executedCommandBuffers.push_back(lastCommandBuffer.get());
+		commandBuffer->executeCommands(executedCommandBuffers);
+
+		commandBuffer->endRenderPass();
+	}
+
+	// Depth of this frame is reduced for occlusion test of next one
+	m_cullingPass->recordDepthPyramid(commandBuffer, imageIndex, camera->getViewProjectionMatrix());
+
+	if (m_frameCaptureEnabled)
+		recordFrameCapture(commandBuffer, imageIndex);
+
+	commandBuffer->end();
 }
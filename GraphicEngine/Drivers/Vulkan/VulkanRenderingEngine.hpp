@@ -2,7 +2,9 @@
 
 #include "../../Common/RenderingEngine.hpp"
 #include "VulkanShader.hpp"
+#include "VulkanCullingPass.hpp"
 #include "VulkanFramework.hpp"
+#include "VulkanGpuTimer.hpp"
 #include "VulkanWindowContext.hpp"
 #include "VulkanTexture.hpp"
 #include "VulkanVertexBuffer.hpp"
@@ -26,6 +28,7 @@ namespace GraphicEngine::Vulkan
 			std::shared_ptr<Services::ServicesManager> servicesManager,
 			std::shared_ptr<Core::EventManager> eventManager,
 			std::shared_ptr<Core::Timer> timer,
+			std::shared_ptr<Core::Profiler> profiler,
 			std::shared_ptr<Common::UI> ui,
 			std::shared_ptr<Core::Configuration> cfg,
 			std::unique_ptr<Core::Logger<VulkanRenderingEngine>> logger);
@@ -33,10 +36,13 @@ namespace GraphicEngine::Vulkan
 		virtual void init(size_t width, size_t height) override;
 		virtual void resizeFrameBuffer(size_t width, size_t height) override;
 		virtual void cleanup() override;
+		virtual FrameCapture captureFrame() override;
 
 		virtual ~VulkanRenderingEngine() = default;
 	private:
-		void buildCommandBuffers();
+		// Records command buffer of current frame only, buffers of other frames in flight can still be executed
+		void recordCommandBuffer();
+		void recordFrameCapture(vk::UniqueCommandBuffer& commandBuffer, uint32_t imageIndex);
 	private:
 		std::shared_ptr<VulkanFramework> m_framework;
 		std::shared_ptr<UniformBuffer<Engines::Graphic::Shaders::CameraMatrices>> m_cameraUniformBuffer;
@@ -50,10 +56,16 @@ namespace GraphicEngine::Vulkan
 
 	private:
 		std::shared_ptr<VulkanWireframeGraphicPipeline> m_wireframeGraphicPipeline;
+		std::shared_ptr<CullingPass> m_cullingPass;
 		std::shared_ptr<VulkanSolidColorGraphicPipeline> m_solidColorraphicPipeline;
 		std::shared_ptr<VulkanNormalDebugGraphicPipeline> m_normalDebugGraphicPipeline;
 		std::shared_ptr<VulkanSkyboxGraphicPipeline> m_skyboxGraphicPipeline;
 
 		std::shared_ptr<GUI::ImGuiImpl::VulkanRenderEngineBackend> m_uiRenderingBackend;
+
+		std::unique_ptr<GpuTimer> m_gpuTimer;
+
+		std::vector<std::unique_ptr<BufferData>> m_captureBuffers;
+		uint32_t m_captureBufferSize{ 0 };
 	};
 }
@@ -9,7 +9,8 @@ GraphicEngine::ShaderType GraphicEngine::Vulkan::GetShaderType(vk::ShaderStageFl
 		{ vk::ShaderStageFlagBits::eFragment, ShaderType::Fragment },
 		{ vk::ShaderStageFlagBits::eGeometry, ShaderType::Geometry },
 		{ vk::ShaderStageFlagBits::eTessellationControl, ShaderType::TessalationControll },
-		{ vk::ShaderStageFlagBits::eTessellationEvaluation, ShaderType::TessalationEvaluation }
+		{ vk::ShaderStageFlagBits::eTessellationEvaluation, ShaderType::TessalationEvaluation },
+		{ vk::ShaderStageFlagBits::eCompute, ShaderType::Compute }
 	};
 
 	return shaderTypeMap[shaderType];
@@ -22,7 +23,8 @@ vk::ShaderStageFlagBits GraphicEngine::Vulkan::GetVulkanShaderType(ShaderType sh
 		{ ShaderType::Fragment , vk::ShaderStageFlagBits::eFragment },
 		{ ShaderType::Geometry, vk::ShaderStageFlagBits::eGeometry },
 		{ ShaderType::TessalationControll, vk::ShaderStageFlagBits::eTessellationControl },
-		{ ShaderType::TessalationEvaluation, vk::ShaderStageFlagBits::eTessellationEvaluation }
+		{ ShaderType::TessalationEvaluation, vk::ShaderStageFlagBits::eTessellationEvaluation },
+		{ ShaderType::Compute, vk::ShaderStageFlagBits::eCompute }
 	};
 
 	return shaderTypeMap[shaderType];
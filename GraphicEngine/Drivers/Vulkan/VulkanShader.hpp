@@ -112,6 +112,19 @@ namespace GraphicEngine::Vulkan
 			VulkanShader{ device, reader, path, vk::ShaderStageFlagBits::eTessellationEvaluation }
 		{}
 	};
+
+	class VulkanComputeShader : public VulkanShader
+	{
+	public:
+		VulkanComputeShader(const vk::UniqueDevice& device, const std::string& code) :
+			VulkanShader{ device, code, vk::ShaderStageFlagBits::eCompute }
+		{}
+
+		template <typename Reader>
+		VulkanComputeShader(const vk::UniqueDevice& device, Reader reader, const std::string& path) :
+			VulkanShader{ device, reader, path, vk::ShaderStageFlagBits::eCompute }
+		{}
+	};
 }
 
 #endif // !GRAPHIC_ENGINE_DRIVERS_VULKAN_SHADER_VULKAN_HPP
@@ -0,0 +1,61 @@
+#include "VulkanShaderCache.hpp"
+
+#include <cstdio>
+#include <map>
+
+namespace
+{
+	constexpr uint64_t fnvOffsetBasis{ 14695981039346656037ull };
+	constexpr uint64_t fnvPrime{ 1099511628211ull };
+
+	uint64_t hashBytes(uint64_t hash, const std::string& data)
+	{
+		for (char byte : data)
+		{
+			hash ^= static_cast<uint8_t>(byte);
+			hash *= fnvPrime;
+		}
+		return hash;
+	}
+}
+
+uint64_t GraphicEngine::Vulkan::hashShaderSource(const std::string& source, const std::string& compileOptions)
+{
+	// Separator keeps end of source from being read as beginning of options
+	uint64_t hash = hashBytes(fnvOffsetBasis, source);
+	hash = hashBytes(hash, std::string(1, '\0'));
+	return hashBytes(hash, compileOptions);
+}
+
+std::string GraphicEngine::Vulkan::getShaderCacheFileName(const std::string& fileName, uint64_t hash)
+{
+	char hexHash[17];
+	std::snprintf(hexHash, sizeof(hexHash), "%016llx", static_cast<unsigned long long>(hash));
+	return fileName + "." + hexHash + ".spv";
+}
+
+std::optional<GraphicEngine::ShaderType> GraphicEngine::Vulkan::getShaderTypeFromFileName(const std::string& fileName)
+{
+	static const std::map<std::string, ShaderType> shaderTypes =
+	{
+		{ "vert", ShaderType::Vertex },
+		{ "frag", ShaderType::Fragment },
+		{ "geom", ShaderType::Geometry },
+		{ "tesc", ShaderType::TessalationControll },
+		{ "tese", ShaderType::TessalationEvaluation },
+		{ "comp", ShaderType::Compute }
+	};
+
+	auto dot = fileName.find_last_of('.');
+	if (dot == std::string::npos)
+	{
+		return std::nullopt;
+	}
+
+	auto it = shaderTypes.find(fileName.substr(dot + 1));
+	if (it == std::end(shaderTypes))
+	{
+		return std::nullopt;
+	}
+	return it->second;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "../../Common/Shader.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace GraphicEngine::Vulkan
+{
+	// FNV-1a of source followed by options of compiler, so cached SPIR-V is invalidated by change of either
+	uint64_t hashShaderSource(const std::string& source, const std::string& compileOptions);
+
+	// Cached SPIR-V keeps name of its source, e.g. solid.frag.<hash>.spv
+	std::string getShaderCacheFileName(const std::string& fileName, uint64_t hash);
+
+	// Stage is given by last extension like in glslc, empty for unknown extension
+	std::optional<ShaderType> getShaderTypeFromFileName(const std::string& fileName);
+}
@@ -0,0 +1,239 @@
+#include "VulkanShaderCompiler.hpp"
+#include "VulkanShaderCache.hpp"
+#include "../../Core/IO/FileReader.hpp"
+#include "../../Core/IO/ShaderSourceReader.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace
+{
+	// Cache file name is source name followed by dot, 16 hexadecimal digits of hash and .spv
+	constexpr size_t cacheFileSuffixSize{ 1 + 16 + 4 };
+
+	std::string joinFileNames(const std::vector<std::string>& fileNames)
+	{
+		std::string joined;
+		for (const auto& fileName : fileNames)
+		{
+			joined += (joined.empty() ? "" : ", ") + fileName;
+		}
+		return joined;
+	}
+}
+
+GraphicEngine::Vulkan::ShaderWatch::ShaderWatch(ShaderCompiler* shaderCompiler, uint32_t watchId) :
+	m_shaderCompiler{ shaderCompiler },
+	m_watchId{ watchId }
+{
+}
+
+GraphicEngine::Vulkan::ShaderWatch::~ShaderWatch()
+{
+	m_shaderCompiler->unwatch(m_watchId);
+}
+
+GraphicEngine::Vulkan::ShaderCompiler::ShaderCompiler(std::filesystem::path sourcePath, std::filesystem::path cachePath, std::unique_ptr<Core::Logger<ShaderCompiler>> logger) :
+	m_sourcePath{ std::move(sourcePath) },
+	m_cachePath{ std::move(cachePath) },
+	m_logger{ std::move(logger) }
+{
+	m_compileOptions.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_2);
+	m_compileOptions.SetOptimizationLevel(shaderc_optimization_level_performance);
+	// Sources shared with OpenGL renderer declare Vulkan set and binding of their resources under this macro
+	m_compileOptions.AddMacroDefinition("VULKAN");
+	m_compileOptionsKey = "vulkan1.2 performance VULKAN";
+	m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Shaders are compiled from {} and cached in {}", m_sourcePath.string(), m_cachePath.string());
+}
+
+GraphicEngine::Vulkan::ShaderCompiler::~ShaderCompiler()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_stopMutex);
+		m_stopped = true;
+	}
+	m_stopCondition.notify_all();
+	if (m_watchingThread.joinable())
+	{
+		m_watchingThread.join();
+	}
+}
+
+std::string GraphicEngine::Vulkan::ShaderCompiler::getSpirv(const std::string& fileName)
+{
+	// Includes are resolved before hashing, so change of included file gives new cache entry
+	auto source = Core::IO::readShaderSource(m_sourcePath / fileName);
+	auto cacheFileName = getShaderCacheFileName(fileName, hashShaderSource(source, m_compileOptionsKey));
+	auto cacheFile = m_cachePath / cacheFileName;
+
+	std::lock_guard<std::mutex> lock(m_compileMutex);
+	if (std::filesystem::exists(cacheFile))
+	{
+		return Core::IO::readFile<std::string>(cacheFile.string());
+	}
+
+	auto spirv = compile(fileName, source);
+	m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Shader {} compiled, {} bytes", fileName, spirv.size());
+
+	// Cache is only speed up, so shader compiled without it is still used
+	std::error_code error;
+	std::filesystem::create_directories(m_cachePath, error);
+	std::ofstream file(cacheFile, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		m_logger->warn(__FILE__, __LINE__, __FUNCTION__, "Shader cache {} can not be written", cacheFile.string());
+		return spirv;
+	}
+	file.write(spirv.data(), spirv.size());
+
+	// Entries of previous versions of shader are never read again
+	for (const auto& entry : std::filesystem::directory_iterator(m_cachePath, error))
+	{
+		auto entryName = entry.path().filename().string();
+		if (entryName != cacheFileName && entryName.size() == fileName.size() + cacheFileSuffixSize && entryName.compare(0, fileName.size() + 1, fileName + ".") == 0)
+		{
+			std::filesystem::remove(entry.path(), error);
+		}
+	}
+	return spirv;
+}
+
+std::unique_ptr<GraphicEngine::Vulkan::ShaderWatch> GraphicEngine::Vulkan::ShaderCompiler::watch(const std::vector<std::string>& fileNames, std::function<void()> reload, std::function<void()> swap)
+{
+	std::lock_guard<std::mutex> lock(m_watchesMutex);
+	uint32_t watchId = m_nextWatchId++;
+	m_watches.emplace(watchId, Watch{ fileNames, std::move(reload), std::move(swap) });
+	return std::make_unique<ShaderWatch>(this, watchId);
+}
+
+void GraphicEngine::Vulkan::ShaderCompiler::startWatching(std::chrono::milliseconds interval)
+{
+	if (m_watchingThread.joinable())
+	{
+		throw std::logic_error("Shader sources are already watched!");
+	}
+	// Files present now are compiled by pipelines when they are created
+	m_watchingThread = std::thread(&ShaderCompiler::watchSources, this, Core::IO::FileWatcher(m_sourcePath), interval);
+	m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Watching shaders in {} every {} ms", m_sourcePath.string(), interval.count());
+}
+
+void GraphicEngine::Vulkan::ShaderCompiler::update()
+{
+	std::unique_lock<std::mutex> lock(m_watchesMutex, std::try_to_lock);
+	if (!lock.owns_lock())
+	{
+		return;
+	}
+
+	for (uint32_t watchId : m_pendingSwaps)
+	{
+		auto watch = m_watches.find(watchId);
+		if (watch != std::end(m_watches))
+		{
+			watch->second.swap();
+		}
+	}
+	m_pendingSwaps.clear();
+}
+
+void GraphicEngine::Vulkan::ShaderCompiler::unwatch(uint32_t watchId)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_watchesMutex);
+		m_watches.erase(watchId);
+	}
+	// Waits only for reload running on watching thread, so callbacks are never called after this returns
+	std::lock_guard<std::mutex> reloadLock(m_reloadMutex);
+}
+
+bool GraphicEngine::Vulkan::ShaderCompiler::isWatched(uint32_t watchId)
+{
+	std::lock_guard<std::mutex> lock(m_watchesMutex);
+	return m_watches.count(watchId) > 0;
+}
+
+void GraphicEngine::Vulkan::ShaderCompiler::watchSources(Core::IO::FileWatcher fileWatcher, std::chrono::milliseconds interval)
+{
+	std::unique_lock<std::mutex> stopLock(m_stopMutex);
+	while (!m_stopCondition.wait_for(stopLock, interval, [this]() { return m_stopped; }))
+	{
+		stopLock.unlock();
+		auto changedFiles = fileWatcher.getChangedFiles();
+		if (!changedFiles.empty())
+		{
+			// Included file can be used by any shader, unchanged ones are only read from cache
+			bool includeChanged = std::any_of(std::begin(changedFiles), std::end(changedFiles), Core::IO::isShaderInclude);
+
+			// Watches are copied, so shaders are compiled without blocking update and unwatch
+			std::map<uint32_t, Watch> changedWatches;
+			{
+				std::lock_guard<std::mutex> lock(m_watchesMutex);
+				std::copy_if(std::begin(m_watches), std::end(m_watches), std::inserter(changedWatches, std::end(changedWatches)), [&](const auto& watch)
+				{
+					return includeChanged || std::any_of(std::begin(watch.second.fileNames), std::end(watch.second.fileNames), [&](const std::string& fileName)
+					{
+						return std::find(std::begin(changedFiles), std::end(changedFiles), fileName) != std::end(changedFiles);
+					});
+				});
+			}
+
+			for (auto& [watchId, watch] : changedWatches)
+			{
+				// Invalid shader keeps previous pipelines, so it can be fixed while application runs
+				try
+				{
+					for (const auto& fileName : watch.fileNames)
+					{
+						getSpirv(fileName);
+					}
+
+					std::lock_guard<std::mutex> reloadLock(m_reloadMutex);
+					if (!isWatched(watchId))
+						continue;
+					watch.reload();
+
+					std::lock_guard<std::mutex> lock(m_watchesMutex);
+					// Watch removed during reload never gets its swap
+					if (m_watches.count(watchId) > 0 && std::find(std::begin(m_pendingSwaps), std::end(m_pendingSwaps), watchId) == std::end(m_pendingSwaps))
+					{
+						m_pendingSwaps.push_back(watchId);
+					}
+					m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Shaders {} reloaded", joinFileNames(watch.fileNames));
+				}
+				catch (const std::exception& e)
+				{
+					m_logger->error(__FILE__, __LINE__, __FUNCTION__, "Shaders {} were not reloaded: {}", joinFileNames(watch.fileNames), e.what());
+				}
+			}
+		}
+		stopLock.lock();
+	}
+}
+
+std::string GraphicEngine::Vulkan::ShaderCompiler::compile(const std::string& fileName, const std::string& source)
+{
+	static const std::map<ShaderType, shaderc_shader_kind> shaderKinds =
+	{
+		{ ShaderType::Vertex, shaderc_vertex_shader },
+		{ ShaderType::Fragment, shaderc_fragment_shader },
+		{ ShaderType::Geometry, shaderc_geometry_shader },
+		{ ShaderType::TessalationControll, shaderc_tess_control_shader },
+		{ ShaderType::TessalationEvaluation, shaderc_tess_evaluation_shader },
+		{ ShaderType::Compute, shaderc_compute_shader }
+	};
+
+	auto shaderType = getShaderTypeFromFileName(fileName);
+	if (!shaderType)
+	{
+		throw std::invalid_argument("Stage of shader can not be found from its name: " + fileName);
+	}
+
+	auto result = m_compiler.CompileGlslToSpv(source, shaderKinds.at(*shaderType), fileName.c_str(), m_compileOptions);
+	if (result.GetCompilationStatus() != shaderc_compilation_status_success)
+	{
+		throw std::runtime_error("Shader " + fileName + " failed to compile:\n" + result.GetErrorMessage());
+	}
+	return std::string(reinterpret_cast<const char*>(result.cbegin()), reinterpret_cast<const char*>(result.cend()));
+}
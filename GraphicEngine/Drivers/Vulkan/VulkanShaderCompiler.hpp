@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../../Core/Logger.hpp"
+#include "../../Core/IO/FileWatcher.hpp"
+
+#include <shaderc/shaderc.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace GraphicEngine::Vulkan
+{
+	class ShaderCompiler;
+
+	// Callbacks registered by watch are removed when it is destroyed
+	class ShaderWatch
+	{
+	public:
+		ShaderWatch(ShaderCompiler* shaderCompiler, uint32_t watchId);
+		~ShaderWatch();
+
+		ShaderWatch(const ShaderWatch&) = delete;
+		ShaderWatch& operator=(const ShaderWatch&) = delete;
+
+	private:
+		ShaderCompiler* m_shaderCompiler;
+		uint32_t m_watchId;
+	};
+
+	// Compiles GLSL to SPIR-V with shaderc. Result is cached on disk under name with hash of source, so unchanged shaders are only read.
+	// Source directory can be watched from own thread, changed shaders are compiled there and pipelines using them are recreated
+	class ShaderCompiler
+	{
+	public:
+		ShaderCompiler(std::filesystem::path sourcePath, std::filesystem::path cachePath, std::unique_ptr<Core::Logger<ShaderCompiler>> logger);
+		~ShaderCompiler();
+
+		ShaderCompiler(const ShaderCompiler&) = delete;
+		ShaderCompiler& operator=(const ShaderCompiler&) = delete;
+
+		// Name of source file in source directory, e.g. solid.frag, its #include lines are resolved from same directory.
+		// Throws runtime_error with messages of compiler when source is invalid
+		std::string getSpirv(const std::string& fileName);
+
+		// Reload is called on watching thread after any of given shaders was changed and all of them compiled, so pipelines can be created there.
+		// Swap is called by update between frames to replace pipelines used for recording
+		std::unique_ptr<ShaderWatch> watch(const std::vector<std::string>& fileNames, std::function<void()> reload, std::function<void()> swap);
+
+		// Source directory is checked for changes with given interval
+		void startWatching(std::chrono::milliseconds interval);
+
+		// Calls swaps of reloaded shaders, when watching thread is reloading they are left for next update, so frame is never stalled
+		void update();
+
+	private:
+		friend class ShaderWatch;
+
+		struct Watch
+		{
+			std::vector<std::string> fileNames;
+			std::function<void()> reload;
+			std::function<void()> swap;
+		};
+
+		void unwatch(uint32_t watchId);
+		bool isWatched(uint32_t watchId);
+		void watchSources(Core::IO::FileWatcher fileWatcher, std::chrono::milliseconds interval);
+		std::string compile(const std::string& fileName, const std::string& source);
+
+	private:
+		std::filesystem::path m_sourcePath;
+		std::filesystem::path m_cachePath;
+		shaderc::Compiler m_compiler;
+		shaderc::CompileOptions m_compileOptions;
+		// Options are part of hash, so cache compiled with other options is not used
+		std::string m_compileOptionsKey;
+		// Same shader can be requested by main and watching thread, cache file is written by one of them
+		std::mutex m_compileMutex;
+
+		// Guards watches and pending swaps, never held while shaders are compiled or pipelines reloaded
+		std::mutex m_watchesMutex;
+		// Held by watching thread while it reloads pipelines, so unwatch can wait for running reload
+		std::mutex m_reloadMutex;
+		std::map<uint32_t, Watch> m_watches;
+		uint32_t m_nextWatchId{ 0 };
+		// Watches reloaded since last update
+		std::vector<uint32_t> m_pendingSwaps;
+
+		std::mutex m_stopMutex;
+		std::condition_variable m_stopCondition;
+		bool m_stopped{ false };
+		std::thread m_watchingThread;
+		std::unique_ptr<Core::Logger<ShaderCompiler>> m_logger;
+	};
+}
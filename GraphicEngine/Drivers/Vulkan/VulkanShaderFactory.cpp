@@ -1,5 +1,6 @@
 #include "VulkanShaderFactory.hpp"
 #include "VulkanFramework.hpp"
+#include "VulkanShaderCache.hpp"
 
 GraphicEngine::Vulkan::VulkanShaderFactory::VulkanShaderFactory(VulkanFramework* framework):
 	m_framework{framework}
@@ -40,3 +41,19 @@ std::shared_ptr<GraphicEngine::Vulkan::VulkanTessellationEvaluationShader> Graph
 {
 	return std::make_shared<VulkanTessellationEvaluationShader>(m_framework->m_device, data);
 }
+
+std::shared_ptr<GraphicEngine::Vulkan::VulkanComputeShader> GraphicEngine::Vulkan::VulkanShaderFactory::getVulkanComputeShader(const std::string& data)
+{
+	return std::make_shared<VulkanComputeShader>(m_framework->m_device, data);
+}
+
+std::vector<std::shared_ptr<GraphicEngine::Vulkan::VulkanShader>> GraphicEngine::Vulkan::VulkanShaderFactory::getVulkanShaders(const std::vector<std::string>& fileNames)
+{
+	std::vector<std::shared_ptr<VulkanShader>> shaders;
+	for (const auto& fileName : fileNames)
+	{
+		auto spirv = m_framework->m_shaderCompiler->getSpirv(fileName);
+		shaders.push_back(getVulkanShader(getShaderTypeFromFileName(fileName).value(), spirv));
+	}
+	return shaders;
+}
\ No newline at end of file
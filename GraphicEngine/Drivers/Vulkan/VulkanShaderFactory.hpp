@@ -24,6 +24,11 @@ namespace GraphicEngine::Vulkan
 
 		std::shared_ptr<VulkanTessellationEvaluationShader> getVulkanTessellationEvaluationShader(const std::string& data);
 
+		std::shared_ptr<VulkanComputeShader> getVulkanComputeShader(const std::string& data);
+
+		// GLSL sources are compiled by shader compiler of framework, stage of each shader is given by extension of its name
+		std::vector<std::shared_ptr<VulkanShader>> getVulkanShaders(const std::vector<std::string>& fileNames);
+
 	protected:
 		VulkanFramework* m_framework;
 	};
@@ -20,9 +20,9 @@ namespace GraphicEngine::Vulkan
 		void update(const std::vector<T>& data)
 		{
 			uint32_t count = data.size();
-			copyMemoryToDevice<uint32_t>(m_framework->m_device, bufferData[m_framework->m_imageIndex.value]->memory, &count, 1);
+			copyMemoryToDevice<uint32_t>(bufferData[m_framework->m_imageIndex.value]->memory, &count, 1);
 			if (data.size() > 0)
-				copyMemoryToDevice<T>(m_framework->m_device, bufferData[m_framework->m_imageIndex.value]->memory, &data[0], data.size(), 4 * sizeof(float));
+				copyMemoryToDevice<T>(bufferData[m_framework->m_imageIndex.value]->memory, &data[0], data.size(), 4 * sizeof(float));
 		}
 		virtual int size()
 		{
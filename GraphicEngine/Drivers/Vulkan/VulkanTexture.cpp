@@ -12,8 +12,8 @@ GraphicEngine::Vulkan::Texture2D::Texture2D(const vk::PhysicalDevice& physicalDe
 	int mipLevels = Core::calculateMipLevels(width, height);
 
 	BufferData stagingBuffer(physicalDevice, device, vk::BufferUsageFlagBits::eTransferSrc,
-		vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, sizeof(uint8_t) * size);
-	copyMemoryToDevice<uint8_t>(device, stagingBuffer.memory, data, size);
+		vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, sizeof(uint8_t) * size, MemoryLifetime::Transient);
+	copyMemoryToDevice<uint8_t>(stagingBuffer.memory, data, size);
 	transitionImageLayout(device, commandPool, queue, image, getFormat(channels), vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, mipLevels);
 	singleTimeCommand(device, commandPool, queue, [&](const vk::UniqueCommandBuffer& commandBuffer)
 		{
@@ -41,8 +41,8 @@ void GraphicEngine::Vulkan::TextureCube::initialize(const vk::PhysicalDevice& ph
 	//int mipLevels = Core::calculateMipLevels(width, height);
 
 	BufferData stagingBuffer(physicalDevice, device, vk::BufferUsageFlagBits::eTransferSrc,
-		vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, sizeof(uint8_t) * size);
-	copyMemoryToDevice<uint8_t>(device, stagingBuffer.memory, data, size);
+		vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, sizeof(uint8_t) * size, MemoryLifetime::Transient);
+	copyMemoryToDevice<uint8_t>(stagingBuffer.memory, data, size);
 	transitionImageLayout(device, commandPool, queue, image, vk::Format::eR8G8B8A8Unorm, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, /*mipLevels*/1, 6);
 	singleTimeCommand(device, commandPool, queue, [&](const vk::UniqueCommandBuffer& commandBuffer)
 	{
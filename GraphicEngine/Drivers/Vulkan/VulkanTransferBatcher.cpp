@@ -0,0 +1,208 @@
+#include "VulkanTransferBatcher.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+#undef max
+#undef min
+
+namespace
+{
+	// Offsets of copies are aligned, so data in staging buffer can be copied by wide words
+	constexpr uint64_t copyAlignment{ 16 };
+
+	std::mutex transferBatchersMutex;
+	std::map<VkDevice, std::weak_ptr<GraphicEngine::Vulkan::TransferBatcher>> transferBatchers;
+}
+
+GraphicEngine::Vulkan::TransferBatcher::TransferBatcher(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const QueueFamilyIndices& indices, vk::Queue transferQueue, uint32_t stagingSize) :
+	m_device{ device.get() },
+	m_queue{ transferQueue },
+	m_stagingRing{ stagingSize },
+	// Copies are split to quarters of staging buffer, so they fit into it after wrap around
+	m_maxCopySize{ std::max<uint64_t>(stagingSize / 4, 1) }
+{
+	uint32_t transferFamily = indices.transferFamily.value_or(indices.graphicsFamily.value());
+	if (transferFamily != indices.graphicsFamily.value())
+	{
+		m_sharingQueueFamilies = { indices.graphicsFamily.value(), transferFamily };
+	}
+
+	m_stagingBuffer = std::make_unique<BufferData>(physicalDevice, device, vk::BufferUsageFlagBits::eTransferSrc,
+		vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, stagingSize);
+
+	vk::StructureChain<vk::SemaphoreCreateInfo, vk::SemaphoreTypeCreateInfo> semaphoreCreateInfo({}, { vk::SemaphoreType::eTimeline, 0 });
+	m_semaphore = device->createSemaphoreUnique(semaphoreCreateInfo.get<vk::SemaphoreCreateInfo>());
+
+	m_commandPool = device->createCommandPoolUnique(vk::CommandPoolCreateInfo(vk::CommandPoolCreateFlagBits::eTransient | vk::CommandPoolCreateFlagBits::eResetCommandBuffer, transferFamily));
+}
+
+void GraphicEngine::Vulkan::TransferBatcher::upload(vk::Buffer buffer, const void* data, uint64_t size, uint64_t offset)
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+
+	uint64_t uploadedSize{ 0 };
+	while (uploadedSize < size)
+	{
+		uint64_t copySize = std::min(size - uploadedSize, m_maxCopySize);
+		auto stagingOffset = m_stagingRing.allocate(copySize, copyAlignment);
+		while (!stagingOffset)
+		{
+			if (m_stagingRing.hasOpenBatch())
+			{
+				flushBatch();
+			}
+			else
+			{
+				waitForValue(m_stagingRing.getOldestBatchValue().value());
+			}
+			reclaim();
+			stagingOffset = m_stagingRing.allocate(copySize, copyAlignment);
+		}
+
+		memcpy(static_cast<char*>(m_stagingBuffer->memory.getMappedData()) + *stagingOffset, static_cast<const char*>(data) + uploadedSize, copySize);
+		PROFILE_UPLOADED_BYTES(copySize);
+		m_pendingCopies.push_back(PendingCopy{ buffer, vk::BufferCopy(*stagingOffset, offset + uploadedSize, copySize) });
+		uploadedSize += copySize;
+	}
+}
+
+uint64_t GraphicEngine::Vulkan::TransferBatcher::flush()
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+	return flushBatch();
+}
+
+void GraphicEngine::Vulkan::TransferBatcher::wait(uint64_t value)
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+	waitForValue(value);
+	reclaim();
+}
+
+bool GraphicEngine::Vulkan::TransferBatcher::isCompleted(uint64_t value)
+{
+	return m_device.getSemaphoreCounterValue(m_semaphore.get()) >= value;
+}
+
+void GraphicEngine::Vulkan::TransferBatcher::finish()
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+	waitForValue(flushBatch());
+	reclaim();
+}
+
+vk::Semaphore GraphicEngine::Vulkan::TransferBatcher::getSemaphore() const
+{
+	return m_semaphore.get();
+}
+
+uint64_t GraphicEngine::Vulkan::TransferBatcher::getLastSubmittedValue()
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+	return m_lastSubmittedValue;
+}
+
+std::vector<uint32_t> GraphicEngine::Vulkan::TransferBatcher::getSharingQueueFamilies() const
+{
+	return m_sharingQueueFamilies;
+}
+
+GraphicEngine::Vulkan::TransferBatcher::~TransferBatcher()
+{
+	// Staging buffer and command buffers can not be destroyed while copies are executed
+	try
+	{
+		finish();
+	}
+	catch (vk::SystemError&)
+	{
+	}
+}
+
+uint64_t GraphicEngine::Vulkan::TransferBatcher::flushBatch()
+{
+	if (m_pendingCopies.empty())
+	{
+		return m_lastSubmittedValue;
+	}
+
+	reclaim();
+	vk::UniqueCommandBuffer commandBuffer;
+	if (m_freeCommandBuffers.empty())
+	{
+		commandBuffer = std::move(m_device.allocateCommandBuffersUnique(vk::CommandBufferAllocateInfo(m_commandPool.get(), vk::CommandBufferLevel::ePrimary, 1)).front());
+	}
+	else
+	{
+		commandBuffer = std::move(m_freeCommandBuffers.back());
+		m_freeCommandBuffers.pop_back();
+	}
+
+	// Consecutive copies to same buffer are recorded by one command
+	commandBuffer->begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+	std::vector<vk::BufferCopy> regions;
+	for (size_t i{ 0 }; i < m_pendingCopies.size(); ++i)
+	{
+		regions.push_back(m_pendingCopies[i].region);
+		if (i + 1 == m_pendingCopies.size() || m_pendingCopies[i + 1].buffer != m_pendingCopies[i].buffer)
+		{
+			commandBuffer->copyBuffer(m_stagingBuffer->buffer.get(), m_pendingCopies[i].buffer, regions);
+			regions.clear();
+		}
+	}
+	commandBuffer->end();
+
+	uint64_t value = m_lastSubmittedValue + 1;
+	vk::TimelineSemaphoreSubmitInfo timelineSubmitInfo(0, nullptr, 1, &value);
+	vk::Semaphore semaphore = m_semaphore.get();
+	vk::SubmitInfo submitInfo(0, nullptr, nullptr, 1, &(commandBuffer.get()), 1, &semaphore);
+	submitInfo.pNext = &timelineSubmitInfo;
+	m_queue.submit(submitInfo, vk::Fence());
+
+	m_lastSubmittedValue = value;
+	m_stagingRing.closeBatch(value);
+	m_submittedCommandBuffers.emplace_back(value, std::move(commandBuffer));
+	m_pendingCopies.clear();
+	return value;
+}
+
+void GraphicEngine::Vulkan::TransferBatcher::waitForValue(uint64_t value)
+{
+	vk::Semaphore semaphore = m_semaphore.get();
+	vk::SemaphoreWaitInfo waitInfo(vk::SemaphoreWaitFlags(), 1, &semaphore, &value);
+	if (m_device.waitSemaphores(waitInfo, std::numeric_limits<uint64_t>::max()) != vk::Result::eSuccess)
+	{
+		throw std::runtime_error("Failed to wait for transfer batch!");
+	}
+}
+
+void GraphicEngine::Vulkan::TransferBatcher::reclaim()
+{
+	uint64_t completedValue = m_device.getSemaphoreCounterValue(m_semaphore.get());
+	m_stagingRing.release(completedValue);
+	while (!m_submittedCommandBuffers.empty() && m_submittedCommandBuffers.front().first <= completedValue)
+	{
+		m_freeCommandBuffers.push_back(std::move(m_submittedCommandBuffers.front().second));
+		m_submittedCommandBuffers.pop_front();
+	}
+}
+
+void GraphicEngine::Vulkan::setDeviceTransferBatcher(const vk::UniqueDevice& device, std::shared_ptr<TransferBatcher> transferBatcher)
+{
+	std::lock_guard<std::mutex> lock{ transferBatchersMutex };
+	transferBatchers[static_cast<VkDevice>(device.get())] = transferBatcher;
+}
+
+std::shared_ptr<GraphicEngine::Vulkan::TransferBatcher> GraphicEngine::Vulkan::findDeviceTransferBatcher(const vk::UniqueDevice& device)
+{
+	std::lock_guard<std::mutex> lock{ transferBatchersMutex };
+	auto transferBatcher = transferBatchers.find(static_cast<VkDevice>(device.get()));
+	if (transferBatcher == std::end(transferBatchers))
+	{
+		return nullptr;
+	}
+	return transferBatcher->second.lock();
+}
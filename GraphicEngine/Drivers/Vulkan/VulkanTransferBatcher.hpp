@@ -0,0 +1,76 @@
+#pragma once
+
+#include "VulkanHelper.hpp"
+#include "VulkanMemoryAllocator.hpp"
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace GraphicEngine::Vulkan
+{
+	// Collects copies to device local buffers and submits them together, so uploading many buffers does not wait for queue after each of them.
+	// Data goes through ring staging buffer, finished copies are tracked by values of timeline semaphore
+	class TransferBatcher
+	{
+	public:
+		TransferBatcher(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const QueueFamilyIndices& indices, vk::Queue transferQueue, uint32_t stagingSize);
+
+		TransferBatcher(const TransferBatcher&) = delete;
+		TransferBatcher& operator=(const TransferBatcher&) = delete;
+
+		// Data is copied to staging buffer right away, copy to buffer is submitted with next flush.
+		// Data bigger than staging buffer is split, full staging buffer submits current batch and waits for oldest one
+		void upload(vk::Buffer buffer, const void* data, uint64_t size, uint64_t offset = 0);
+
+		// Submits copies recorded since last flush and returns value of semaphore signaled when they are done
+		uint64_t flush();
+		void wait(uint64_t value);
+		bool isCompleted(uint64_t value);
+		// Submits recorded copies and waits until all of them are done
+		void finish();
+
+		vk::Semaphore getSemaphore() const;
+		uint64_t getLastSubmittedValue();
+		// Queue families which use uploaded buffers, buffers are shared concurrently when transfer queue is in other family than graphic queue
+		std::vector<uint32_t> getSharingQueueFamilies() const;
+
+		~TransferBatcher();
+
+	private:
+		struct PendingCopy
+		{
+			vk::Buffer buffer;
+			vk::BufferCopy region;
+		};
+
+		uint64_t flushBatch();
+		void waitForValue(uint64_t value);
+		// Frees staging memory and command buffers of completed batches
+		void reclaim();
+
+	private:
+		vk::Device m_device;
+		vk::Queue m_queue;
+		std::vector<uint32_t> m_sharingQueueFamilies;
+		std::unique_ptr<BufferData> m_stagingBuffer;
+		RingAllocator m_stagingRing;
+		uint64_t m_maxCopySize;
+		vk::UniqueSemaphore m_semaphore;
+		uint64_t m_lastSubmittedValue{ 0 };
+		std::vector<PendingCopy> m_pendingCopies;
+		// Command buffers are freed before their pool is destroyed
+		vk::UniqueCommandPool m_commandPool;
+		std::vector<vk::UniqueCommandBuffer> m_freeCommandBuffers;
+		std::deque<std::pair<uint64_t, vk::UniqueCommandBuffer>> m_submittedCommandBuffers;
+		std::mutex m_mutex;
+	};
+
+	// Batcher used by device buffers of device, it is created together with device by framework
+	void setDeviceTransferBatcher(const vk::UniqueDevice& device, std::shared_ptr<TransferBatcher> transferBatcher);
+
+	// Null when device has no batcher, then buffers are uploaded by single time commands
+	std::shared_ptr<TransferBatcher> findDeviceTransferBatcher(const vk::UniqueDevice& device);
+}
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "VulkanFramework.hpp"
-#include "../../Core/Utils/MememoryUtils.hpp"
+#include "../../Common/DynamicInstanceStorage.hpp"
 
 namespace GraphicEngine::Vulkan
 {
@@ -57,7 +57,7 @@ namespace GraphicEngine::Vulkan
 
 		virtual void update() override
 		{
-			copyMemoryToDevice<T>(m_framework->m_device, bufferData[m_framework->m_imageIndex.value]->memory, &m_value, 1);
+			copyMemoryToDevice<T>(bufferData[m_framework->m_imageIndex.value]->memory, &m_value, 1);
 		}
 
 		virtual int size() override
@@ -75,29 +75,52 @@ namespace GraphicEngine::Vulkan
 		T m_value{};
 	};
 
+	// Instances are kept in host storage and changed ones are copied to buffer of each swap chain image when that image is updated
 	template <typename T>
 	class UniformBufferDynamic : public IUniformBuffer
 	{
 	public:
-		UniformBufferDynamic(VulkanFramework* framework, uint32_t instances) : IUniformBuffer(framework, vk::DescriptorType::eUniformBufferDynamic, vk::BufferUsageFlagBits::eUniformBuffer)
+		UniformBufferDynamic(VulkanFramework* framework, uint32_t instances) : IUniformBuffer(framework, vk::DescriptorType::eUniformBufferDynamic, vk::BufferUsageFlagBits::eUniformBuffer),
+			m_storage{ getDynamicAligmentSize<T>(framework->m_physicalDevice), framework->m_maxFrames, instances }
 		{
-			m_aligmentSize = getDynamicAligmentSize<T>(framework->m_physicalDevice);
-			resizeInstancesCount(instances);
+			replaceBufferData();
 		}
 
+		// Instance i of values is written to slot i, only values which differ from previous ones are marked for copy
 		void setValue(const std::vector<T>& values)
 		{
-			Core::Utils::copyValuesToAlignedBuffer<std::vector, T>(values, m_values, m_aligmentSize);
+			reserve(static_cast<uint32_t>(values.size()));
+			for (uint32_t i{ 0 }; i < values.size(); ++i)
+			{
+				setValue(i, values[i]);
+			}
 		}
 
+		void setValue(uint32_t instance, const T& value)
+		{
+			m_storage.setValue(instance, &value, sizeof(T));
+		}
+
+		// Copies range of changed instances to buffer of current image
 		virtual void update() override
 		{
-			copyMemoryToDevice<char>(m_framework->m_device, bufferData[m_framework->m_imageIndex.value]->memory, m_values.data(), m_values.size());
+			uint32_t image = m_framework->m_imageIndex.value;
+			if (auto dirtyRange = m_storage.takeDirtyRange(image))
+			{
+				auto [offset, size] = *dirtyRange;
+				copyMemoryToDevice<char>(bufferData[image]->memory, m_storage.getData() + offset, size, offset);
+			}
+
+			// Every image was updated since buffers were replaced, so no frame in flight reads retired buffers
+			if (!m_retiredBufferData.empty() && ++m_updatesSinceGrowth >= m_framework->m_maxFrames)
+			{
+				m_retiredBufferData.clear();
+			}
 		}
 
 		int size() override
 		{
-			return m_values.size();
+			return m_storage.getSize();
 		}
 
 		void updateAndSet(const std::vector<T>& values)
@@ -106,32 +129,69 @@ namespace GraphicEngine::Vulkan
 			update();
 		}
 
-		void resizeInstancesCount(uint32_t instances)
+		// Buffers are replaced when capacity grows, so descriptor sets using them have to be written again
+		bool reserve(uint32_t instances)
 		{
-			m_instancesCount = instances;
-			m_values.resize(m_instancesCount * m_aligmentSize);
-			initializeBufferData(m_instancesCount * m_aligmentSize);
+			if (!m_storage.reserve(instances))
+			{
+				return false;
+			}
+			replaceBufferData();
+			return true;
 		}
 
-		void addInstance()
+		// Takes lowest free slot, buffers grow only when all slots are used
+		uint32_t addInstance()
 		{
-			resizeInstancesCount(m_instancesCount + 1);
+			uint32_t capacity = m_storage.getCapacity();
+			uint32_t instance = m_storage.addInstance();
+			if (m_storage.getCapacity() != capacity)
+			{
+				replaceBufferData();
+			}
+			return instance;
 		}
 
-		void deleteInstance()
+		// Slot is reused by next added instance
+		void deleteInstance(uint32_t instance)
 		{
-			resizeInstancesCount(m_instancesCount + 1);
+			m_storage.deleteInstance(instance);
 		}
 
 		uint32_t getInstancesCount()
 		{
-			return m_instancesCount;
+			return m_storage.getInstancesCount();
+		}
+
+		uint32_t getCapacity()
+		{
+			return m_storage.getCapacity();
+		}
+
+		uint32_t getAligmentSize()
+		{
+			return m_storage.getAligmentSize();
+		}
+
+	private:
+		// Old buffers are kept until every image was updated, new ones get whole storage
+		void replaceBufferData()
+		{
+			for (auto& buffer : bufferData)
+			{
+				m_retiredBufferData.push_back(buffer);
+			}
+			m_updatesSinceGrowth = 0;
+			initializeBufferData(m_storage.getSize());
+			for (auto& buffer : bufferData)
+			{
+				copyMemoryToDevice<char>(buffer->memory, m_storage.getData(), m_storage.getSize());
+			}
 		}
 
 	private:
-		std::vector<char> m_values;
-		uint32_t m_aligmentSize;
-		uint32_t m_instancesCount{ 0 };
-		uint32_t m_bufferDataInstancesCount = 500;
+		Common::DynamicInstanceStorage m_storage;
+		std::vector<std::shared_ptr<BufferData>> m_retiredBufferData;
+		uint32_t m_updatesSinceGrowth{ 0 };
 	};
-}
+}
\ No newline at end of file
@@ -1,9 +1,17 @@
 #pragma once
 
 #include "VulkanHelper.hpp"
+#include "VulkanMeshArena.hpp"
+#include "VulkanTransferBatcher.hpp"
+#include "../../Common/DrawElementsCommand.hpp"
+#include "../../Common/PackedVertex.hpp"
 #include "../../Common/VertexBuffer.hpp"
+#include "../../Core/Profiler.hpp"
 
+#include <algorithm>
+#include <optional>
 #include <stdexcept>
+#include <utility>
 
 namespace GraphicEngine::Vulkan
 {
@@ -14,8 +22,17 @@ namespace GraphicEngine::Vulkan
 		DeviceBufferData(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const vk::UniqueCommandPool& commandPool, vk::Queue queue,
 			const vk::BufferUsageFlags& usageFlags, const T* data, uint32_t size)
 		{
-			BufferData stagingBuffer(physicalDevice, device, vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, sizeof(T) * size);
-			copyMemoryToDevice<T>(device, stagingBuffer.memory, data, size);
+			// Copy is only recorded, batch of copies is submitted before first frame which uses the buffer
+			if (auto transferBatcher = findDeviceTransferBatcher(device))
+			{
+				buffer = std::make_unique<BufferData>(physicalDevice, device, usageFlags, vk::MemoryPropertyFlagBits::eDeviceLocal, sizeof(T) * size,
+					MemoryLifetime::Persistent, transferBatcher->getSharingQueueFamilies());
+				transferBatcher->upload(buffer->buffer.get(), data, sizeof(T) * size);
+				return;
+			}
+
+			BufferData stagingBuffer(physicalDevice, device, vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent, sizeof(T) * size, MemoryLifetime::Transient);
+			copyMemoryToDevice<T>(stagingBuffer.memory, data, size);
 			buffer = std::make_unique<BufferData>(physicalDevice, device, usageFlags, vk::MemoryPropertyFlagBits::eDeviceLocal, sizeof(T) * size);
 			singleTimeCommand(device, commandPool, queue, [&](const vk::UniqueCommandBuffer& commandBuffer)
 				{
@@ -50,6 +67,9 @@ namespace GraphicEngine::Vulkan
 	template <typename _Vertex>
 	class VertexBuffer : public Common::VertexBuffer<VertexBuffer<_Vertex>, vk::UniqueCommandPool&>
 	{
+		// Layout of vertex in buffer, may be packed variant of _Vertex
+		using GpuVertex = typename Common::PackedVertex<_Vertex>::type;
+
 		class _IVerexBuffer
 		{
 		public:
@@ -61,23 +81,32 @@ namespace GraphicEngine::Vulkan
 
 			virtual void drawElements(const vk::UniqueCommandBuffer& commandBuffer) = 0;
 
+			virtual void drawElements(const vk::UniqueCommandBuffer& commandBuffer, const std::vector<Common::DrawElementsCommand>& commands) = 0;
+
+			virtual void drawElementsIndirectCount(const vk::UniqueCommandBuffer& commandBuffer, vk::Buffer commands, vk::DeviceSize offset, vk::Buffer counts, vk::DeviceSize countOffset, uint32_t maxDrawsCount) = 0;
+
 			virtual void drawEdges(const vk::UniqueCommandBuffer& commandBuffer) = 0;
 
+			virtual void setIndicesRange(uint32_t offset, uint32_t count) = 0;
+
+			virtual std::optional<MeshArena::Allocation> getMeshAllocation() const = 0;
+
 			virtual ~_IVerexBuffer() = default;
 		};
 
 		class _VertexBuffer : public _IVerexBuffer
 		{
 		public:
-			_VertexBuffer(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const vk::UniqueCommandPool& commandPool, vk::Queue queue, const std::vector<_Vertex>& vertices)
+			_VertexBuffer(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const vk::UniqueCommandPool& commandPool, vk::Queue queue, const std::vector<GpuVertex>& vertices)
 			{
 				m_vertexBufferSize = vertices.size();
-				m_vertexArrayObject = std::make_unique<VertexDeviceBuffer<_Vertex>>(physicalDevice, device, commandPool, queue, vertices);
+				m_vertexArrayObject = std::make_unique<VertexDeviceBuffer<GpuVertex>>(physicalDevice, device, commandPool, queue, vertices);
+				m_vertexBuffer = m_vertexArrayObject->buffer->buffer.get();
 			}
 
 			virtual void bind(const vk::UniqueCommandBuffer& commandBuffer) override
 			{
-				commandBuffer->bindVertexBuffers(0, this->m_vertexArrayObject->buffer->buffer.get(), { 0 });
+				commandBuffer->bindVertexBuffers(0, m_vertexBuffer, { m_vertexBufferOffset });
 			}
 
 			virtual void bindSecond(const vk::UniqueCommandBuffer& commandBuffer) override
@@ -85,24 +114,60 @@ namespace GraphicEngine::Vulkan
 				throw std::logic_error("Function not yet implemented");
 			}
 
+			vk::Buffer getVertexBuffer() const
+			{
+				return m_vertexBuffer;
+			}
+
+			vk::DeviceSize getVertexBufferOffset() const
+			{
+				return m_vertexBufferOffset;
+			}
+
 			virtual void drawElements(const vk::UniqueCommandBuffer& commandBuffer) override
 			{
 				throw std::logic_error("Function not yet implemented");
 			}
 
+			virtual void drawElements(const vk::UniqueCommandBuffer& commandBuffer, const std::vector<Common::DrawElementsCommand>& commands) override
+			{
+				throw std::logic_error("Function not yet implemented");
+			}
+
+			virtual void drawElementsIndirectCount(const vk::UniqueCommandBuffer& commandBuffer, vk::Buffer commands, vk::DeviceSize offset, vk::Buffer counts, vk::DeviceSize countOffset, uint32_t maxDrawsCount) override
+			{
+				throw std::logic_error("Function not yet implemented");
+			}
+
 			virtual void drawEdges(const vk::UniqueCommandBuffer& commandBuffer) override
 			{
 				throw std::logic_error("Function not yet implemented");
 			}
 
+			virtual void setIndicesRange(uint32_t offset, uint32_t count) override
+			{
+				throw std::logic_error("Function not yet implemented");
+			}
+
 			virtual void draw(const vk::UniqueCommandBuffer& commandBuffer) override
 			{
 				commandBuffer->draw(m_vertexBufferSize, 1, 0, 0);
+				PROFILE_DRAW_CALLS(1);
+			}
+
+			virtual std::optional<MeshArena::Allocation> getMeshAllocation() const override
+			{
+				return std::nullopt;
 			}
 
 			virtual ~_VertexBuffer() = default;
 		protected:
-			std::unique_ptr<VertexDeviceBuffer<_Vertex>> m_vertexArrayObject;
+			_VertexBuffer() = default;
+
+			// Null when vertices are placed in mesh arena
+			std::unique_ptr<VertexDeviceBuffer<GpuVertex>> m_vertexArrayObject;
+			vk::Buffer m_vertexBuffer;
+			vk::DeviceSize m_vertexBufferOffset{ 0 };
 			uint32_t m_vertexBufferSize;
 		};
 
@@ -110,45 +175,108 @@ namespace GraphicEngine::Vulkan
 		class _VertexBufferWithIndices : public _VertexBuffer
 		{
 		public:
-			_VertexBufferWithIndices(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const vk::UniqueCommandPool& commandPool, vk::Queue queue, const std::vector<_Vertex>& vertices, const std::vector<uint32_t>& indices) :
-				_VertexBuffer(physicalDevice, device, commandPool, queue, vertices)
+			_VertexBufferWithIndices(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const vk::UniqueCommandPool& commandPool, vk::Queue queue, const std::vector<GpuVertex>& vertices, const std::vector<uint32_t>& indices)
 			{
 				this->m_vertexBufferSize = vertices.size();
 				m_indicesBufferSize = indices.size();
+
+				// Meshes share buffers of arena when device has one, so meshes of one vertex type can be drawn together
+				m_meshArena = findDeviceMeshArena(device);
+				if (m_meshArena)
+				{
+					m_meshAllocation = m_meshArena->allocate(vertices.data(), sizeof(GpuVertex), static_cast<uint32_t>(vertices.size()), indices.data(), static_cast<uint32_t>(indices.size()));
+					this->m_vertexBuffer = m_meshArena->getVertexBuffer();
+					this->m_vertexBufferOffset = m_meshAllocation->verticesOffset;
+					m_indexBuffer = m_meshArena->getIndexBuffer();
+					m_indexBufferOffset = sizeof(uint32_t) * m_meshAllocation->firstIndex;
+					return;
+				}
+
+				this->m_vertexArrayObject = std::make_unique<VertexDeviceBuffer<GpuVertex>>(physicalDevice, device, commandPool, queue, vertices);
+				this->m_vertexBuffer = this->m_vertexArrayObject->buffer->buffer.get();
 				m_indicesDeviceBuffer = std::make_unique<IndicesDeviceBuffer>(physicalDevice, device, commandPool, queue, indices);
+				m_indexBuffer = m_indicesDeviceBuffer->buffer->buffer.get();
 			}
 
+			_VertexBufferWithIndices(const _VertexBufferWithIndices&) = delete;
+			_VertexBufferWithIndices& operator=(const _VertexBufferWithIndices&) = delete;
+
 			virtual void bind(const vk::UniqueCommandBuffer& commandBuffer) override
 			{
-				commandBuffer->bindVertexBuffers(0, this->m_vertexArrayObject->buffer->buffer.get(), { 0 });
-				commandBuffer->bindIndexBuffer(m_indicesDeviceBuffer->buffer->buffer.get(), 0, vk::IndexType::eUint32);
+				commandBuffer->bindVertexBuffers(0, this->m_vertexBuffer, { this->m_vertexBufferOffset });
+				commandBuffer->bindIndexBuffer(m_indexBuffer, m_indexBufferOffset, vk::IndexType::eUint32);
 			}
 
 			virtual void drawElements(const vk::UniqueCommandBuffer& commandBuffer) override
 			{
-				commandBuffer->drawIndexed(this->m_indicesBufferSize, 1, 0, 0, 0);
+				commandBuffer->drawIndexed(this->m_indicesBufferSize, 1, m_indicesOffset, 0, 0);
+				PROFILE_DRAW_CALLS(1);
+			}
+
+			// Command buffers are recorded every frame, so commands are recorded directly instead of through indirect buffer
+			virtual void drawElements(const vk::UniqueCommandBuffer& commandBuffer, const std::vector<Common::DrawElementsCommand>& commands) override
+			{
+				for (const auto& command : commands)
+				{
+					commandBuffer->drawIndexed(command.indexCount, command.instanceCount, command.firstIndex, command.vertexOffset, command.firstInstance);
+				}
+				PROFILE_DRAW_CALLS(commands.size());
+			}
+
+			// Commands and their number are written by GPU, so only one indirect draw is counted
+			virtual void drawElementsIndirectCount(const vk::UniqueCommandBuffer& commandBuffer, vk::Buffer commands, vk::DeviceSize offset, vk::Buffer counts, vk::DeviceSize countOffset, uint32_t maxDrawsCount) override
+			{
+				commandBuffer->drawIndexedIndirectCount(commands, offset, counts, countOffset, maxDrawsCount, sizeof(Common::DrawElementsCommand));
+				PROFILE_DRAW_CALLS(1);
+			}
+
+			virtual void setIndicesRange(uint32_t offset, uint32_t count) override
+			{
+				m_indicesOffset = offset;
+				m_indicesBufferSize = count;
 			}
 
 			virtual void draw(const vk::UniqueCommandBuffer& commandBuffer) override
 			{
 				commandBuffer->draw(this->m_vertexBufferSize, 1, 0, 0);
+				PROFILE_DRAW_CALLS(1);
 			}
 
-			virtual ~_VertexBufferWithIndices() = default;
+			virtual std::optional<MeshArena::Allocation> getMeshAllocation() const override
+			{
+				return m_meshAllocation;
+			}
+
+			// Ranges stay in arena until frames which may draw them are finished
+			virtual ~_VertexBufferWithIndices()
+			{
+				if (m_meshArena)
+				{
+					m_meshArena->free(*m_meshAllocation);
+				}
+			}
 
 		private:
+			std::shared_ptr<MeshArena> m_meshArena;
+			std::optional<MeshArena::Allocation> m_meshAllocation;
+			// Null when indices are placed in mesh arena
 			std::unique_ptr<IndicesDeviceBuffer> m_indicesDeviceBuffer;
+			vk::Buffer m_indexBuffer;
+			vk::DeviceSize m_indexBufferOffset{ 0 };
 			uint32_t m_indicesBufferSize;
+			uint32_t m_indicesOffset{ 0 };
 		};
 
 		class _VertexBufferWithElementsAndEdges : public _IVerexBuffer
 		{
 		public:
 			_VertexBufferWithElementsAndEdges() = default;
-			_VertexBufferWithElementsAndEdges(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const vk::UniqueCommandPool& commandPool, vk::Queue queue, const std::vector<_Vertex>& vertices, const std::vector<uint32_t>& indices, const std::vector<uint32_t>& edges)
+			// Elements and edges index same vertices, so vertices are uploaded once
+			_VertexBufferWithElementsAndEdges(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const vk::UniqueCommandPool& commandPool, vk::Queue queue, const std::vector<GpuVertex>& vertices, const std::vector<uint32_t>& indices, const std::vector<uint32_t>& edges)
 			{
 				m_elements = std::make_unique<_VertexBufferWithIndices>(physicalDevice, device, commandPool, queue, vertices, indices);
-				m_edges = std::make_unique<_VertexBufferWithIndices>(physicalDevice, device, commandPool, queue, vertices, edges);
+				m_edgesCount = edges.size();
+				m_edgesDeviceBuffer = std::make_unique<IndicesDeviceBuffer>(physicalDevice, device, commandPool, queue, edges);
 			}
 			virtual void bind(const vk::UniqueCommandBuffer& commandBuffer) override
 			{
@@ -157,7 +285,8 @@ namespace GraphicEngine::Vulkan
 
 			virtual void bindSecond(const vk::UniqueCommandBuffer& commandBuffer) override
 			{
-				m_edges->bind(commandBuffer);
+				commandBuffer->bindVertexBuffers(0, m_elements->getVertexBuffer(), { m_elements->getVertexBufferOffset() });
+				commandBuffer->bindIndexBuffer(m_edgesDeviceBuffer->buffer->buffer.get(), 0, vk::IndexType::eUint32);
 			}
 
 			virtual void draw(const vk::UniqueCommandBuffer& commandBuffer) override
@@ -171,34 +300,58 @@ namespace GraphicEngine::Vulkan
 				m_elements->drawElements(commandBuffer);
 			}
 
+			virtual void drawElements(const vk::UniqueCommandBuffer& commandBuffer, const std::vector<Common::DrawElementsCommand>& commands) override
+			{
+				m_elements->bind(commandBuffer);
+				m_elements->drawElements(commandBuffer, commands);
+			}
+
+			virtual void drawElementsIndirectCount(const vk::UniqueCommandBuffer& commandBuffer, vk::Buffer commands, vk::DeviceSize offset, vk::Buffer counts, vk::DeviceSize countOffset, uint32_t maxDrawsCount) override
+			{
+				m_elements->bind(commandBuffer);
+				m_elements->drawElementsIndirectCount(commandBuffer, commands, offset, counts, countOffset, maxDrawsCount);
+			}
+
 			virtual void drawEdges(const vk::UniqueCommandBuffer& commandBuffer) override
 			{
-				m_edges->bind(commandBuffer);
-				m_edges->drawElements(commandBuffer);
+				bindSecond(commandBuffer);
+				commandBuffer->drawIndexed(m_edgesCount, 1, 0, 0, 0);
+				PROFILE_DRAW_CALLS(1);
+			}
+
+			virtual void setIndicesRange(uint32_t offset, uint32_t count) override
+			{
+				m_elements->setIndicesRange(offset, count);
+			}
+
+			virtual std::optional<MeshArena::Allocation> getMeshAllocation() const override
+			{
+				return m_elements->getMeshAllocation();
 			}
 
 			virtual ~_VertexBufferWithElementsAndEdges() = default;
 
 		private:
 			std::unique_ptr<_VertexBufferWithIndices> m_elements;
-			std::unique_ptr<_VertexBufferWithIndices> m_edges;
+			std::unique_ptr<IndicesDeviceBuffer> m_edgesDeviceBuffer;
+			uint32_t m_edgesCount;
 		};
 	public:
 		using VertexType = _Vertex;
 
 		VertexBuffer(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const vk::UniqueCommandPool& commandPool, vk::Queue queue, const std::vector<VertexType>& vertices)
 		{
-			m_data = std::make_unique<_VertexBuffer>(physicalDevice, device, commandPool, queue, vertices);
+			m_data = std::make_unique<_VertexBuffer>(physicalDevice, device, commandPool, queue, Common::packVertices(vertices, m_positionQuantization));
 		}
 
 		VertexBuffer(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const vk::UniqueCommandPool& commandPool, vk::Queue queue, const std::vector<VertexType>& vertices, const std::vector<uint32_t>& indices)
 		{
-			m_data = std::make_unique<_VertexBufferWithIndices>(physicalDevice, device, commandPool, queue, vertices, indices);
+			m_data = std::make_unique<_VertexBufferWithIndices>(physicalDevice, device, commandPool, queue, Common::packVertices(vertices, m_positionQuantization), indices);
 		}
 
 		VertexBuffer(const vk::PhysicalDevice& physicalDevice, const vk::UniqueDevice& device, const vk::UniqueCommandPool& commandPool, vk::Queue queue, const std::vector<VertexType>& vertices, const std::vector<uint32_t>& indices, const std::vector<uint32_t>& edges)
 		{
-			m_data = std::make_unique<_VertexBufferWithElementsAndEdges>(physicalDevice, device, commandPool, queue, vertices, indices, edges);
+			m_data = std::make_unique<_VertexBufferWithElementsAndEdges>(physicalDevice, device, commandPool, queue, Common::packVertices(vertices, m_positionQuantization), indices, edges);
 		}
 
 		void bind(const vk::UniqueCommandBuffer& commandBuffer)
@@ -216,16 +369,55 @@ namespace GraphicEngine::Vulkan
 			m_data->drawElements(commandBuffer);
 		}
 
+		void drawElements(const vk::UniqueCommandBuffer& commandBuffer, const std::vector<Common::DrawElementsCommand>& commands)
+		{
+			m_data->drawElements(commandBuffer, commands);
+		}
+
+		// Draws up to given number of commands from indirect buffer, their number is read from counts buffer
+		void drawElementsIndirectCount(const vk::UniqueCommandBuffer& commandBuffer, vk::Buffer commands, vk::DeviceSize offset, vk::Buffer counts, vk::DeviceSize countOffset, uint32_t maxDrawsCount)
+		{
+			m_data->drawElementsIndirectCount(commandBuffer, commands, offset, counts, countOffset, maxDrawsCount);
+		}
+
 		void drawEdges(const vk::UniqueCommandBuffer& commandBuffer)
 		{
 			m_data->drawEdges(commandBuffer);
 		}
 
+		void setLods(const std::vector<std::pair<uint32_t, uint32_t>>& lods)
+		{
+			m_lods = lods;
+		}
+
+		// Levels past last one draw last one
+		void setLod(uint32_t level)
+		{
+			if (m_lods.empty())
+				return;
+
+			auto lod = m_lods[std::min<size_t>(level, m_lods.size() - 1)];
+			m_data->setIndicesRange(lod.first, lod.second);
+		}
+
 		void unbind(const vk::UniqueCommandBuffer& commandBuffer)
 		{
 			// Vulkan do not need unbinding method
 		}
+
+		glm::mat4 getDequantizationMatrix() const
+		{
+			return Core::Math::getDequantizationMatrix(m_positionQuantization);
+		}
+
+		// Place of vertices and indices in mesh arena of device, empty when buffer has own buffers
+		std::optional<MeshArena::Allocation> getMeshAllocation() const
+		{
+			return m_data->getMeshAllocation();
+		}
 	private:
 		std::unique_ptr<_IVerexBuffer> m_data;
+		std::vector<std::pair<uint32_t, uint32_t>> m_lods;
+		Core::Math::PositionQuantization m_positionQuantization;
 	};
 }
\ No newline at end of file
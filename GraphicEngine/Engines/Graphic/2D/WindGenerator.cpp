@@ -1,33 +1,358 @@
 #include "WindGenerator.hpp"
-#include <random>
-#include <glm\glm.hpp>
-#include <glm\gtc\noise.hpp>
-#include <chrono>
-#include <random>
 
-cv::Mat GraphicEngine::Engines::Graphic::WindGenerator::generate(int dim, float speed)
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define WIND_GENERATOR_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define WIND_GENERATOR_AVX2_TARGET
+#else
+#include <cpuid.h>
+#define WIND_GENERATOR_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+#undef min
+#undef max
+
+namespace
+{
+	constexpr uint32_t octavesCount{ 3 };
+	// Cycles per texture at full speed and weight of each octave
+	constexpr std::array<float, octavesCount> octaveFrequencies{ 2.0f, 4.0f, 16.0f };
+	constexpr std::array<float, octavesCount> octaveWeights{ 1.0f, 0.5f, 0.25f };
+	constexpr float weightsSum{ 1.75f };
+	// Distinct lattice slices in time for every channel and octave, so channels are not correlated
+	constexpr std::array<std::array<float, octavesCount>, 2> timeOffsets{ { { 0.0f, 101.0f, 211.0f }, { 307.0f, 401.0f, 503.0f } } };
+
+	constexpr uint32_t hashX{ 0x8da6b343u };
+	constexpr uint32_t hashY{ 0xd8163841u };
+	constexpr uint32_t hashZ{ 0xcb1ab31fu };
+	constexpr uint32_t hashMix{ 0x2c1b3c6du };
+
+	struct Octave
+	{
+		int32_t period;
+		float scale;
+		float weight;
+	};
+
+	// Frequencies are rounded to whole cycles per texture to keep the field tileable
+	std::array<Octave, octavesCount> getOctaves(uint32_t dim, float speed)
+	{
+		std::array<Octave, octavesCount> octaves;
+		for (uint32_t k{ 0 }; k < octavesCount; ++k)
+		{
+			int32_t period = std::max(static_cast<int32_t>(std::round(octaveFrequencies[k] * speed)), 1);
+			octaves[k] = Octave{ period, static_cast<float>(period) / static_cast<float>(dim), octaveWeights[k] };
+		}
+		return octaves;
+	}
+
+	inline uint32_t hash(int32_t x, int32_t y, int32_t z)
+	{
+		uint32_t h = static_cast<uint32_t>(x) * hashX ^ (static_cast<uint32_t>(y) * hashY ^ static_cast<uint32_t>(z) * hashZ);
+		h ^= h >> 15;
+		h *= hashMix;
+		h ^= h >> 12;
+		return h;
+	}
+
+	// One of 8 diagonal gradients selected by hash
+	inline float gradient(uint32_t h, float x, float y, float z)
+	{
+		return ((h & 1) ? -x : x) + ((h & 2) ? -y : y) + ((h & 4) ? -z : z);
+	}
+
+	inline float fade(float t)
+	{
+		return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+	}
+
+	inline float lerp(float a, float b, float t)
+	{
+		return a + t * (b - a);
+	}
+
+	inline int32_t wrap(int32_t value, int32_t period)
+	{
+		return ((value % period) + period) % period;
+	}
+
+	inline uint8_t toTexel(float value)
+	{
+		return static_cast<uint8_t>(std::min(std::max(value * 0.5f + 0.5f, 0.0f), 1.0f) * 255.0f + 0.5f);
+	}
+
+#if defined(WIND_GENERATOR_X86)
+	bool detectAvx2()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		__cpuid(info, 1);
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+		if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+			return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+
+	struct AxisLattice
+	{
+		int32_t i0;
+		int32_t i1;
+		float t;
+		float fade;
+	};
+
+	inline AxisLattice getAxisLattice(float value, int32_t period)
+	{
+		float floor = std::floor(value);
+		int32_t i0 = period > 0 ? wrap(static_cast<int32_t>(floor), period) : static_cast<int32_t>(floor);
+		int32_t i1 = period > 0 ? wrap(i0 + 1, period) : i0 + 1;
+		float t = value - floor;
+		return AxisLattice{ i0, i1, t, fade(t) };
+	}
+
+	WIND_GENERATOR_AVX2_TARGET inline __m256i hashAvx2(__m256i x, uint32_t yz)
+	{
+		__m256i h = _mm256_xor_si256(_mm256_mullo_epi32(x, _mm256_set1_epi32(static_cast<int32_t>(hashX))), _mm256_set1_epi32(static_cast<int32_t>(yz)));
+		h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 15));
+		h = _mm256_mullo_epi32(h, _mm256_set1_epi32(static_cast<int32_t>(hashMix)));
+		return _mm256_xor_si256(h, _mm256_srli_epi32(h, 12));
+	}
+
+	WIND_GENERATOR_AVX2_TARGET inline __m256 gradientAvx2(__m256i h, __m256 x, float y, float z)
+	{
+		__m256i one = _mm256_set1_epi32(1);
+		__m256 gx = _mm256_xor_ps(x, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, one), 31)));
+		__m256 gy = _mm256_xor_ps(_mm256_set1_ps(y), _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), 30)));
+		__m256 gz = _mm256_xor_ps(_mm256_set1_ps(z), _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(4)), 29)));
+		return _mm256_add_ps(_mm256_add_ps(gx, gy), gz);
+	}
+
+	WIND_GENERATOR_AVX2_TARGET inline __m256 fadeAvx2(__m256 t)
+	{
+		__m256 f = _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f));
+		f = _mm256_add_ps(_mm256_mul_ps(t, f), _mm256_set1_ps(10.0f));
+		return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t), f);
+	}
+
+	WIND_GENERATOR_AVX2_TARGET inline __m256 lerpAvx2(__m256 a, __m256 b, __m256 t)
+	{
+		return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+	}
+
+	// Same operations in the same order as WindGenerator::noise, for 8 consecutive x values with shared y and z
+	WIND_GENERATOR_AVX2_TARGET __m256 noiseAvx2(__m256 x, const AxisLattice& y, const AxisLattice& z, int32_t periodX)
+	{
+		__m256i period = _mm256_set1_epi32(periodX);
+		__m256 floor = _mm256_floor_ps(x);
+		__m256i x0 = _mm256_cvttps_epi32(floor);
+		x0 = _mm256_andnot_si256(_mm256_cmpeq_epi32(x0, period), x0);
+		__m256i x1 = _mm256_add_epi32(x0, _mm256_set1_epi32(1));
+		x1 = _mm256_andnot_si256(_mm256_cmpeq_epi32(x1, period), x1);
+		__m256 tx = _mm256_sub_ps(x, floor);
+		__m256 tx1 = _mm256_sub_ps(tx, _mm256_set1_ps(1.0f));
+		__m256 u = fadeAvx2(tx);
+
+		uint32_t y0z0 = static_cast<uint32_t>(y.i0) * hashY ^ static_cast<uint32_t>(z.i0) * hashZ;
+		uint32_t y1z0 = static_cast<uint32_t>(y.i1) * hashY ^ static_cast<uint32_t>(z.i0) * hashZ;
+		uint32_t y0z1 = static_cast<uint32_t>(y.i0) * hashY ^ static_cast<uint32_t>(z.i1) * hashZ;
+		uint32_t y1z1 = static_cast<uint32_t>(y.i1) * hashY ^ static_cast<uint32_t>(z.i1) * hashZ;
+
+		float ty1 = y.t - 1.0f;
+		float tz1 = z.t - 1.0f;
+
+		__m256 n000 = gradientAvx2(hashAvx2(x0, y0z0), tx, y.t, z.t);
+		__m256 n100 = gradientAvx2(hashAvx2(x1, y0z0), tx1, y.t, z.t);
+		__m256 n010 = gradientAvx2(hashAvx2(x0, y1z0), tx, ty1, z.t);
+		__m256 n110 = gradientAvx2(hashAvx2(x1, y1z0), tx1, ty1, z.t);
+		__m256 n001 = gradientAvx2(hashAvx2(x0, y0z1), tx, y.t, tz1);
+		__m256 n101 = gradientAvx2(hashAvx2(x1, y0z1), tx1, y.t, tz1);
+		__m256 n011 = gradientAvx2(hashAvx2(x0, y1z1), tx, ty1, tz1);
+		__m256 n111 = gradientAvx2(hashAvx2(x1, y1z1), tx1, ty1, tz1);
+
+		__m256 v = _mm256_set1_ps(y.fade);
+		__m256 w = _mm256_set1_ps(z.fade);
+		__m256 nx00 = lerpAvx2(n000, n100, u);
+		__m256 nx10 = lerpAvx2(n010, n110, u);
+		__m256 nx01 = lerpAvx2(n001, n101, u);
+		__m256 nx11 = lerpAvx2(n011, n111, u);
+		return lerpAvx2(lerpAvx2(nx00, nx10, v), lerpAvx2(nx01, nx11, v), w);
+	}
+
+	WIND_GENERATOR_AVX2_TARGET __m256i toTexelAvx2(__m256 value)
+	{
+		__m256 v = _mm256_add_ps(_mm256_mul_ps(value, _mm256_set1_ps(0.5f)), _mm256_set1_ps(0.5f));
+		v = _mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+		return _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(v, _mm256_set1_ps(255.0f)), _mm256_set1_ps(0.5f)));
+	}
+#endif
+}
+
+#if defined(WIND_GENERATOR_X86)
+bool GraphicEngine::Engines::Graphic::WindGenerator::s_avx2Enabled{ detectAvx2() };
+#else
+bool GraphicEngine::Engines::Graphic::WindGenerator::s_avx2Enabled{ false };
+#endif
+
+void GraphicEngine::Engines::Graphic::WindGenerator::generate(uint8_t* data, uint32_t dim, float speed, float time, uint32_t firstRow, uint32_t rowsCount)
 {
-	cv::Mat mat(dim, dim, CV_8UC4);
-	cv::parallel_for_(cv::Range(0, dim * dim), [&](cv::Range range) {
-		for (int r = range.start; r < range.end; ++r)
+	uint32_t lastRow = std::min(firstRow + rowsCount, dim);
+	for (uint32_t y{ firstRow }; y < lastRow; ++y)
+	{
+		uint8_t* row = data + static_cast<size_t>(y) * dim * 4;
+		if (s_avx2Enabled)
+		{
+			generateRowAvx2(row, dim, y, speed, time);
+		}
+		else
 		{
-			int i = r / dim;
-			int j = r % dim;
-			double x = (double)i / dim;
-			double y = (double)j / dim;
-
-			double x2 = (double)i / dim - 0.5;
-			double y2 = (double)j / dim - 0.5;
-			double e1 = glm::perlin(glm::vec2(speed * 2 * x, speed * 2 * y)) +  0.5 * glm::perlin(glm::vec2(4 * speed * x, 4 * speed * y)) + 0.25 * glm::perlin(glm::vec2(16 * speed * x2, 16 * speed * y2));
-			e1 /= (1.75);
-			//e1 *= glm::perlin(glm::vec2(speed * x, speed * y));
-			e1 = 255 * (e1 * 0.5 + 0.5);
-			double e2 = glm::perlin(glm::vec2(speed * 2 * x2, speed * 2 * y2)) +  0.5 * glm::perlin(glm::vec2(4 * speed * x2, 4 * speed * y2)) + 0.25 * glm::perlin(glm::vec2(16 * speed * x, 16 * speed * y));
-			e1 /= (1.75);
-			//e2 *= glm::perlin(glm::vec2(speed * x2 - 0.2122, speed * y2 + 0.2212));
-			e2 = 255 * (e2 * 0.5 + 0.5);
-			mat.at<cv::Vec4b>(i, j) = cv::Vec4b(e2, 0.0f, e1, 0.0f);
+			generateRow(row, dim, y, speed, time, 0);
 		}
-		});
-	return mat;
-}
\ No newline at end of file
+	}
+}
+
+void GraphicEngine::Engines::Graphic::WindGenerator::generate(uint8_t* data, uint32_t dim, float speed, float time)
+{
+	generate(data, dim, speed, time, 0, dim);
+}
+
+float GraphicEngine::Engines::Graphic::WindGenerator::noise(float x, float y, float z, int32_t periodX, int32_t periodY)
+{
+	float floorX = std::floor(x);
+	float floorY = std::floor(y);
+	float floorZ = std::floor(z);
+
+	int32_t x0 = wrap(static_cast<int32_t>(floorX), periodX);
+	int32_t x1 = wrap(x0 + 1, periodX);
+	int32_t y0 = wrap(static_cast<int32_t>(floorY), periodY);
+	int32_t y1 = wrap(y0 + 1, periodY);
+	int32_t z0 = static_cast<int32_t>(floorZ);
+	int32_t z1 = z0 + 1;
+
+	float tx = x - floorX;
+	float ty = y - floorY;
+	float tz = z - floorZ;
+	float tx1 = tx - 1.0f;
+	float ty1 = ty - 1.0f;
+	float tz1 = tz - 1.0f;
+
+	float n000 = gradient(hash(x0, y0, z0), tx, ty, tz);
+	float n100 = gradient(hash(x1, y0, z0), tx1, ty, tz);
+	float n010 = gradient(hash(x0, y1, z0), tx, ty1, tz);
+	float n110 = gradient(hash(x1, y1, z0), tx1, ty1, tz);
+	float n001 = gradient(hash(x0, y0, z1), tx, ty, tz1);
+	float n101 = gradient(hash(x1, y0, z1), tx1, ty, tz1);
+	float n011 = gradient(hash(x0, y1, z1), tx, ty1, tz1);
+	float n111 = gradient(hash(x1, y1, z1), tx1, ty1, tz1);
+
+	float u = fade(tx);
+	float v = fade(ty);
+	float w = fade(tz);
+	float nx00 = lerp(n000, n100, u);
+	float nx10 = lerp(n010, n110, u);
+	float nx01 = lerp(n001, n101, u);
+	float nx11 = lerp(n011, n111, u);
+	return lerp(lerp(nx00, nx10, v), lerp(nx01, nx11, v), w);
+}
+
+bool GraphicEngine::Engines::Graphic::WindGenerator::isAvx2Supported()
+{
+#if defined(WIND_GENERATOR_X86)
+	static bool supported = detectAvx2();
+	return supported;
+#else
+	return false;
+#endif
+}
+
+void GraphicEngine::Engines::Graphic::WindGenerator::setAvx2Enabled(bool enabled)
+{
+	s_avx2Enabled = enabled && isAvx2Supported();
+}
+
+void GraphicEngine::Engines::Graphic::WindGenerator::generateRow(uint8_t* row, uint32_t dim, uint32_t y, float speed, float time, uint32_t firstColumn)
+{
+	auto octaves = getOctaves(dim, speed);
+	for (uint32_t x{ firstColumn }; x < dim; ++x)
+	{
+		std::array<float, 2> e{ 0.0f, 0.0f };
+		for (uint32_t k{ 0 }; k < octavesCount; ++k)
+		{
+			const Octave& octave = octaves[k];
+			for (uint32_t channel{ 0 }; channel < 2; ++channel)
+			{
+				float n = noise(static_cast<float>(x) * octave.scale, static_cast<float>(y) * octave.scale, time * (k + 1) + timeOffsets[channel][k], octave.period, octave.period);
+				e[channel] = e[channel] + octave.weight * n;
+			}
+		}
+
+		uint8_t* texel = row + 4 * x;
+		texel[0] = toTexel(e[1] / weightsSum);
+		texel[1] = 0;
+		texel[2] = toTexel(e[0] / weightsSum);
+		texel[3] = 0;
+	}
+}
+
+#if defined(WIND_GENERATOR_X86)
+WIND_GENERATOR_AVX2_TARGET void GraphicEngine::Engines::Graphic::WindGenerator::generateRowAvx2(uint8_t* row, uint32_t dim, uint32_t y, float speed, float time)
+{
+	auto octaves = getOctaves(dim, speed);
+
+	// Row and time lattice is shared by all columns
+	std::array<AxisLattice, octavesCount> yLattices;
+	std::array<std::array<AxisLattice, 2>, octavesCount> zLattices;
+	for (uint32_t k{ 0 }; k < octavesCount; ++k)
+	{
+		yLattices[k] = getAxisLattice(static_cast<float>(y) * octaves[k].scale, octaves[k].period);
+		for (uint32_t channel{ 0 }; channel < 2; ++channel)
+		{
+			zLattices[k][channel] = getAxisLattice(time * (k + 1) + timeOffsets[channel][k], 0);
+		}
+	}
+
+	__m256 laneOffsets = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+	__m256 weightsSumVector = _mm256_set1_ps(weightsSum);
+	uint32_t vectorizedColumns = dim & ~7u;
+	for (uint32_t x{ 0 }; x < vectorizedColumns; x += 8)
+	{
+		__m256 columns = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(x)), laneOffsets);
+		__m256 blue = _mm256_setzero_ps();
+		__m256 red = _mm256_setzero_ps();
+		for (uint32_t k{ 0 }; k < octavesCount; ++k)
+		{
+			__m256 position = _mm256_mul_ps(columns, _mm256_set1_ps(octaves[k].scale));
+			__m256 weight = _mm256_set1_ps(octaves[k].weight);
+			blue = _mm256_add_ps(blue, _mm256_mul_ps(weight, noiseAvx2(position, yLattices[k], zLattices[k][0], octaves[k].period)));
+			red = _mm256_add_ps(red, _mm256_mul_ps(weight, noiseAvx2(position, yLattices[k], zLattices[k][1], octaves[k].period)));
+		}
+
+		// Red (second channel) goes to byte 0 and blue (first channel) to byte 2 of each texel
+		__m256i texels = _mm256_or_si256(toTexelAvx2(_mm256_div_ps(red, weightsSumVector)), _mm256_slli_epi32(toTexelAvx2(_mm256_div_ps(blue, weightsSumVector)), 16));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(row + 4 * x), texels);
+	}
+
+	generateRow(row, dim, y, speed, time, vectorizedColumns);
+}
+#else
+void GraphicEngine::Engines::Graphic::WindGenerator::generateRowAvx2(uint8_t* row, uint32_t dim, uint32_t y, float speed, float time)
+{
+	generateRow(row, dim, y, speed, time, 0);
+}
+#endif
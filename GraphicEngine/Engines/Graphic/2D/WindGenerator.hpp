@@ -1,12 +1,30 @@
 #pragma once
 
-#include <opencv2\opencv.hpp>
+#include <stdint.h>
 
 namespace GraphicEngine::Engines::Graphic
 {
-    class WindGenerator
-    {
-    public:
-	    static cv::Mat generate(int dim, float speed);
-    };
-}
\ No newline at end of file
+	// Tileable, time sliced gradient noise wind field stored as RGBA8 texels, red and blue channels hold wind strength along x and z.
+	// Noise is periodic in texture space and continuous in time, so texture can be wrapped and regenerated band by band while gusts evolve.
+	class WindGenerator
+	{
+	public:
+		// Writes rows [firstRow, firstRow + rowsCount) of dim x dim RGBA8 image into preallocated data holding whole image
+		static void generate(uint8_t* data, uint32_t dim, float speed, float time, uint32_t firstRow, uint32_t rowsCount);
+		static void generate(uint8_t* data, uint32_t dim, float speed, float time = 0.0f);
+
+		// Gradient noise periodic in x and y, scalar reference of vectorized kernel
+		static float noise(float x, float y, float z, int32_t periodX, int32_t periodY);
+
+		static bool isAvx2Supported();
+		// Allows to compare scalar and vectorized kernel
+		static void setAvx2Enabled(bool enabled);
+
+	private:
+		static void generateRow(uint8_t* row, uint32_t dim, uint32_t y, float speed, float time, uint32_t firstColumn);
+		static void generateRowAvx2(uint8_t* row, uint32_t dim, uint32_t y, float speed, float time);
+
+	private:
+		static bool s_avx2Enabled;
+	};
+}
@@ -0,0 +1,270 @@
+#include "GrassField.hpp"
+
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#undef min
+#undef max
+
+GraphicEngine::Engines::Graphic::GrassField::GrassField(Shaders::GrassParameters parameters, uint32_t seed) :
+	m_parameters{ parameters },
+	m_seed{ seed }
+{
+	if (m_parameters.patchSize <= 0.0f || m_parameters.segments == 0)
+	{
+		throw std::invalid_argument("Grass patch size and blade segments count must be positive!");
+	}
+
+	m_draws.resize(m_parameters.segments);
+}
+
+uint32_t GraphicEngine::Engines::Graphic::GrassField::addSurface(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& normals, const std::vector<uint32_t>& indices, const glm::mat4& modelMatrix)
+{
+	uint32_t surface = m_nextSurface++;
+	// Seed depends only on field seed and order of surfaces, so placement is reproducible
+	auto& added = m_surfaces.emplace(surface, Surface{ m_seed + surface * 0x9e3779b9u, {} }).first->second;
+	scatter(added, positions, normals, indices, modelMatrix);
+	return surface;
+}
+
+void GraphicEngine::Engines::Graphic::GrassField::updateSurface(uint32_t surface, const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& normals, const std::vector<uint32_t>& indices, const glm::mat4& modelMatrix)
+{
+	auto& updated = getSurface(surface);
+	updated.blades.clear();
+	scatter(updated, positions, normals, indices, modelMatrix);
+}
+
+void GraphicEngine::Engines::Graphic::GrassField::removeSurface(uint32_t surface)
+{
+	getSurface(surface);
+	m_surfaces.erase(surface);
+}
+
+void GraphicEngine::Engines::Graphic::GrassField::scatter(Surface& surface, const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& normals, const std::vector<uint32_t>& indices, const glm::mat4& modelMatrix)
+{
+	seedRandom(surface.seed);
+	glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(modelMatrix)));
+
+	for (size_t i{ 0 }; i + 2 < indices.size(); i += 3)
+	{
+		std::array<glm::vec3, 3> triangle;
+		std::array<glm::vec3, 3> triangleNormals;
+		for (uint32_t j{ 0 }; j < 3; ++j)
+		{
+			triangle[j] = glm::vec3(modelMatrix * glm::vec4(positions[indices[i + j]], 1.0f));
+		}
+
+		glm::vec3 cross = glm::cross(triangle[1] - triangle[0], triangle[2] - triangle[0]);
+		float area = 0.5f * glm::length(cross);
+		if (area <= std::numeric_limits<float>::epsilon())
+			continue;
+
+		for (uint32_t j{ 0 }; j < 3; ++j)
+		{
+			triangleNormals[j] = normals.empty() ? cross / (2.0f * area) : glm::normalize(normalMatrix * normals[indices[i + j]]);
+		}
+
+		// Fractional part of expected blades count is resolved randomly to keep density right on small triangles
+		float expectedBlades = area * m_parameters.density;
+		uint32_t bladesCount = static_cast<uint32_t>(expectedBlades);
+		if (random() < expectedBlades - bladesCount)
+			++bladesCount;
+
+		for (uint32_t blade{ 0 }; blade < bladesCount; ++blade)
+		{
+			// Uniform point on triangle
+			float r1 = std::sqrt(random());
+			float r2 = random();
+			glm::vec3 weights(1.0f - r1, r1 * (1.0f - r2), r1 * r2);
+			glm::vec3 position = weights.x * triangle[0] + weights.y * triangle[1] + weights.z * triangle[2];
+			glm::vec3 normal = weights.x * triangleNormals[0] + weights.y * triangleNormals[1] + weights.z * triangleNormals[2];
+			addBlade(surface.blades, position, glm::normalize(normal));
+		}
+	}
+}
+
+void GraphicEngine::Engines::Graphic::GrassField::build()
+{
+	m_blades.clear();
+	m_patches.clear();
+
+	std::map<std::pair<int32_t, int32_t>, std::vector<Shaders::GrassBlade>> patchBlades;
+	for (const auto& [handle, surface] : m_surfaces)
+	{
+		for (const auto& blade : surface.blades)
+		{
+			std::pair<int32_t, int32_t> key{
+				static_cast<int32_t>(std::floor(blade.positionRotation.x / m_parameters.patchSize)),
+				static_cast<int32_t>(std::floor(blade.positionRotation.z / m_parameters.patchSize)) };
+			patchBlades[key].push_back(blade);
+		}
+	}
+
+	// Blades bend and sway, so patch bounds are extended by blade height in every direction
+	float margin = m_parameters.height * 1.25f;
+
+	seedRandom(m_seed);
+	for (auto& [key, blades] : patchBlades)
+	{
+		for (size_t i{ blades.size() }; i > 1; --i)
+		{
+			std::swap(blades[i - 1], blades[static_cast<size_t>(random() * i) % i]);
+		}
+
+		GrassPatch patch{ glm::vec3(std::numeric_limits<float>::max()), glm::vec3(std::numeric_limits<float>::lowest()), static_cast<uint32_t>(m_blades.size()), static_cast<uint32_t>(blades.size()) };
+		for (const auto& blade : blades)
+		{
+			patch.minPoint = glm::min(patch.minPoint, glm::vec3(blade.positionRotation));
+			patch.maxPoint = glm::max(patch.maxPoint, glm::vec3(blade.positionRotation));
+		}
+		patch.minPoint -= margin;
+		patch.maxPoint += margin;
+
+		m_patches.push_back(patch);
+		m_blades.insert(std::end(m_blades), std::begin(blades), std::end(blades));
+	}
+}
+
+void GraphicEngine::Engines::Graphic::GrassField::selectLods(const glm::mat4& viewProjectionMatrix, glm::vec3 eyePosition)
+{
+	for (auto& draws : m_draws)
+	{
+		draws.clear();
+	}
+
+	// Frustum planes in world space (Gribb, Hartmann)
+	glm::mat4 m = glm::transpose(viewProjectionMatrix);
+	std::array<glm::vec4, 6> planes{ m[3] + m[0], m[3] - m[0], m[3] + m[1], m[3] - m[1], m[3] + m[2], m[3] - m[2] };
+
+	for (const auto& patch : m_patches)
+	{
+		glm::vec3 closestPoint = glm::clamp(eyePosition, patch.minPoint, patch.maxPoint);
+		float distance = glm::length(closestPoint - eyePosition);
+		if (distance > m_parameters.lodFar)
+			continue;
+
+		bool visible{ true };
+		for (const auto& plane : planes)
+		{
+			glm::vec3 positiveVertex(
+				plane.x >= 0.0f ? patch.maxPoint.x : patch.minPoint.x,
+				plane.y >= 0.0f ? patch.maxPoint.y : patch.minPoint.y,
+				plane.z >= 0.0f ? patch.maxPoint.z : patch.minPoint.z);
+			if (glm::dot(glm::vec3(plane), positiveVertex) + plane.w < 0.0f)
+			{
+				visible = false;
+				break;
+			}
+		}
+
+		if (!visible)
+			continue;
+
+		uint32_t bladesCount = static_cast<uint32_t>(std::ceil(patch.bladesCount * getDensity(distance)));
+		if (bladesCount == 0)
+			continue;
+
+		auto& draws = m_draws[getSegments(distance) - 1];
+		// Neighbour patches drawn in full are merged into one draw
+		if (!draws.empty() && draws.back().firstBlade + draws.back().bladesCount == patch.firstBlade && bladesCount == patch.bladesCount)
+		{
+			draws.back().bladesCount += bladesCount;
+		}
+		else
+		{
+			draws.push_back(GrassPatchDraw{ patch.firstBlade, bladesCount });
+		}
+	}
+}
+
+uint32_t GraphicEngine::Engines::Graphic::GrassField::getSegments(float distance) const
+{
+	float t = getLodFactor(distance);
+	return std::clamp(static_cast<uint32_t>(std::ceil(m_parameters.segments * (1.0f - t))), 1u, m_parameters.segments);
+}
+
+float GraphicEngine::Engines::Graphic::GrassField::getDensity(float distance) const
+{
+	if (distance > m_parameters.lodFar)
+		return 0.0f;
+
+	return 1.0f + (m_parameters.minDensity - 1.0f) * getLodFactor(distance);
+}
+
+const std::vector<GraphicEngine::Engines::Graphic::GrassPatchDraw>& GraphicEngine::Engines::Graphic::GrassField::getDraws(uint32_t segments) const
+{
+	if (segments == 0 || segments > m_draws.size())
+	{
+		throw std::out_of_range("Grass blade segments count out of bound");
+	}
+
+	return m_draws[segments - 1];
+}
+
+const std::vector<GraphicEngine::Engines::Graphic::Shaders::GrassBlade>& GraphicEngine::Engines::Graphic::GrassField::getBlades() const
+{
+	return m_blades;
+}
+
+const std::vector<GraphicEngine::Engines::Graphic::GrassPatch>& GraphicEngine::Engines::Graphic::GrassField::getPatches() const
+{
+	return m_patches;
+}
+
+GraphicEngine::Engines::Graphic::Shaders::GrassParameters GraphicEngine::Engines::Graphic::GrassField::getParameters() const
+{
+	return m_parameters;
+}
+
+void GraphicEngine::Engines::Graphic::GrassField::clear()
+{
+	m_surfaces.clear();
+	m_blades.clear();
+	m_patches.clear();
+	for (auto& draws : m_draws)
+	{
+		draws.clear();
+	}
+}
+
+GraphicEngine::Engines::Graphic::GrassField::Surface& GraphicEngine::Engines::Graphic::GrassField::getSurface(uint32_t surface)
+{
+	auto it = m_surfaces.find(surface);
+	if (it == std::end(m_surfaces))
+	{
+		throw std::out_of_range("Grass surface does not exist");
+	}
+	return it->second;
+}
+
+void GraphicEngine::Engines::Graphic::GrassField::addBlade(std::vector<Shaders::GrassBlade>& blades, glm::vec3 position, glm::vec3 normal)
+{
+	float rotation = random() * 2.0f * glm::pi<float>();
+	blades.emplace_back(glm::vec4(position, rotation), glm::vec4(normal, random()));
+}
+
+float GraphicEngine::Engines::Graphic::GrassField::getLodFactor(float distance) const
+{
+	float lodRange = m_parameters.lodFar - m_parameters.lodNear;
+	if (lodRange <= 0.0f)
+		return distance > m_parameters.lodNear ? 1.0f : 0.0f;
+
+	return std::clamp((distance - m_parameters.lodNear) / lodRange, 0.0f, 1.0f);
+}
+
+void GraphicEngine::Engines::Graphic::GrassField::seedRandom(uint32_t seed)
+{
+	m_randomState = (seed * 2654435761u) | 1u;
+}
+
+float GraphicEngine::Engines::Graphic::GrassField::random()
+{
+	// xorshift32, same sequence on every platform so placement is reproducible
+	m_randomState ^= m_randomState << 13;
+	m_randomState ^= m_randomState >> 17;
+	m_randomState ^= m_randomState << 5;
+	return (m_randomState >> 8) * (1.0f / 16777216.0f);
+}
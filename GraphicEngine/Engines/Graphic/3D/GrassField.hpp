@@ -0,0 +1,84 @@
+#pragma once
+
+#include "../Shaders/Models/GrassBlade.hpp"
+#include "../Shaders/Models/GrassParameters.hpp"
+
+#include <glm/glm.hpp>
+#include <array>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace GraphicEngine::Engines::Graphic
+{
+	struct GrassPatch
+	{
+		glm::vec3 minPoint;
+		glm::vec3 maxPoint;
+		uint32_t firstBlade;
+		uint32_t bladesCount;
+	};
+
+	struct GrassPatchDraw
+	{
+		uint32_t firstBlade;
+		uint32_t bladesCount;
+	};
+
+	// Grass blades scattered over mesh triangles in world space and grouped into square ground patches.
+	// Blades of each patch are shuffled, so any prefix of a patch is evenly thinned out grass.
+	class GrassField
+	{
+	public:
+		GrassField(Shaders::GrassParameters parameters, uint32_t seed = 0);
+
+		// Triangles are given in local space, normals can be empty to use face normals. Returns handle of surface
+		uint32_t addSurface(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& normals, const std::vector<uint32_t>& indices, const glm::mat4& modelMatrix);
+		// Scatters blades again, e.g. after model matrix changed. Surface keeps its seed, so moved surface keeps its grass
+		void updateSurface(uint32_t surface, const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& normals, const std::vector<uint32_t>& indices, const glm::mat4& modelMatrix);
+		void removeSurface(uint32_t surface);
+
+		// Flattens blades of all surfaces into instance list and patches
+		void build();
+
+		// Frustum culls patches and fills draw lists, one list per blade segments count
+		void selectLods(const glm::mat4& viewProjectionMatrix, glm::vec3 eyePosition);
+
+		uint32_t getSegments(float distance) const;
+		float getDensity(float distance) const;
+
+		const std::vector<GrassPatchDraw>& getDraws(uint32_t segments) const;
+		const std::vector<Shaders::GrassBlade>& getBlades() const;
+		const std::vector<GrassPatch>& getPatches() const;
+		Shaders::GrassParameters getParameters() const;
+
+		void clear();
+
+	private:
+		struct Surface
+		{
+			uint32_t seed;
+			std::vector<Shaders::GrassBlade> blades;
+		};
+
+		void scatter(Surface& surface, const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& normals, const std::vector<uint32_t>& indices, const glm::mat4& modelMatrix);
+		Surface& getSurface(uint32_t surface);
+		void addBlade(std::vector<Shaders::GrassBlade>& blades, glm::vec3 position, glm::vec3 normal);
+		void seedRandom(uint32_t seed);
+		// 0 up to lodNear, 1 at lodFar
+		float getLodFactor(float distance) const;
+		float random();
+
+	private:
+		Shaders::GrassParameters m_parameters;
+		uint32_t m_seed;
+		uint32_t m_randomState{ 1u };
+
+		std::map<uint32_t, Surface> m_surfaces;
+		uint32_t m_nextSurface{ 0 };
+
+		std::vector<Shaders::GrassBlade> m_blades;
+		std::vector<GrassPatch> m_patches;
+		std::vector<std::vector<GrassPatchDraw>> m_draws;
+	};
+}
@@ -0,0 +1,277 @@
+#include "LightClusterGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#undef min
+#undef max
+
+GraphicEngine::Engines::Graphic::LightClusterGrid::LightClusterGrid(uint32_t tilesX, uint32_t tilesY, uint32_t slices, float clusterNear) :
+	m_tilesX{ tilesX },
+	m_tilesY{ tilesY },
+	m_slices{ slices },
+	m_clusterNear{ clusterNear }
+{
+	if (m_tilesX == 0 || m_tilesY == 0 || m_slices < 2)
+	{
+		throw std::invalid_argument("Light cluster grid needs at least one tile and two depth slices!");
+	}
+
+	uint32_t clustersCount = getClustersCount();
+	m_clustersMin.resize(clustersCount);
+	m_clustersMax.resize(clustersCount);
+	m_columnsBounds.resize(m_slices * m_tilesX);
+	m_rowsBounds.resize(m_slices * m_tilesY);
+	m_counts.resize(2 * clustersCount + 1);
+	m_clusters.resize(clustersCount);
+
+	m_parameters.gridSize = glm::uvec4(m_tilesX, m_tilesY, m_slices, 0);
+}
+
+void GraphicEngine::Engines::Graphic::LightClusterGrid::build(const glm::mat4& projectionMatrix, float width, float height)
+{
+	m_parameters.screenSize = glm::vec2(width, height);
+
+	if (projectionMatrix == m_projectionMatrix)
+		return;
+
+	m_projectionMatrix = projectionMatrix;
+	glm::mat4 inverseProjection = glm::inverse(projectionMatrix);
+	auto unproject = [&inverseProjection](glm::vec3 ndc)
+	{
+		glm::vec4 p = inverseProjection * glm::vec4(ndc, 1.0f);
+		return glm::vec3(p) / p.w;
+	};
+
+	m_zNear = std::max(-unproject(glm::vec3(0.0f, 0.0f, -1.0f)).z, std::numeric_limits<float>::epsilon());
+	m_zFar = std::max(-unproject(glm::vec3(0.0f, 0.0f, 1.0f)).z, m_zNear);
+
+	float clusterNear = std::clamp(m_clusterNear, m_zNear, m_zFar);
+	float logDepthRange = std::log(m_zFar / clusterNear);
+	m_parameters.clusterNear = clusterNear;
+	m_parameters.sliceScale = logDepthRange > 0.0f ? static_cast<float>(m_slices - 1) / logDepthRange : 0.0f;
+	m_parameters.sliceBias = -std::log(clusterNear) * m_parameters.sliceScale;
+
+	// Rays through tile corners, works for perspective and orthographic projection
+	std::vector<std::pair<glm::vec3, glm::vec3>> cornerRays((m_tilesX + 1) * (m_tilesY + 1));
+	for (uint32_t y{ 0 }; y <= m_tilesY; ++y)
+	{
+		for (uint32_t x{ 0 }; x <= m_tilesX; ++x)
+		{
+			glm::vec2 ndc = 2.0f * glm::vec2(static_cast<float>(x) / m_tilesX, static_cast<float>(y) / m_tilesY) - 1.0f;
+			cornerRays[y * (m_tilesX + 1) + x] = { unproject(glm::vec3(ndc, -1.0f)), unproject(glm::vec3(ndc, 1.0f)) };
+		}
+	}
+
+	auto pointAtDepth = [](const std::pair<glm::vec3, glm::vec3>& ray, float depth)
+	{
+		float dz = ray.second.z - ray.first.z;
+		float t = std::abs(dz) > std::numeric_limits<float>::epsilon() ? (-depth - ray.first.z) / dz : 0.0f;
+		return ray.first + t * (ray.second - ray.first);
+	};
+
+	std::fill(std::begin(m_columnsBounds), std::end(m_columnsBounds), glm::vec2(std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest()));
+	std::fill(std::begin(m_rowsBounds), std::end(m_rowsBounds), glm::vec2(std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest()));
+
+	for (uint32_t slice{ 0 }; slice < m_slices; ++slice)
+	{
+		float sliceNear = getSliceDepth(slice);
+		float sliceFar = getSliceDepth(slice + 1);
+
+		for (uint32_t y{ 0 }; y < m_tilesY; ++y)
+		{
+			for (uint32_t x{ 0 }; x < m_tilesX; ++x)
+			{
+				glm::vec3 minPoint(std::numeric_limits<float>::max());
+				glm::vec3 maxPoint(std::numeric_limits<float>::lowest());
+				for (uint32_t corner{ 0 }; corner < 4; ++corner)
+				{
+					const auto& ray = cornerRays[(y + corner / 2) * (m_tilesX + 1) + x + corner % 2];
+					for (float depth : { sliceNear, sliceFar })
+					{
+						glm::vec3 p = pointAtDepth(ray, depth);
+						minPoint = glm::min(minPoint, p);
+						maxPoint = glm::max(maxPoint, p);
+					}
+				}
+
+				uint32_t index = getClusterIndex(x, y, slice);
+				m_clustersMin[index] = minPoint;
+				m_clustersMax[index] = maxPoint;
+
+				glm::vec2& column = m_columnsBounds[slice * m_tilesX + x];
+				column = glm::vec2(std::min(column.x, minPoint.x), std::max(column.y, maxPoint.x));
+				glm::vec2& row = m_rowsBounds[slice * m_tilesY + y];
+				row = glm::vec2(std::min(row.x, minPoint.y), std::max(row.y, maxPoint.y));
+			}
+		}
+	}
+}
+
+void GraphicEngine::Engines::Graphic::LightClusterGrid::assignLights(const glm::mat4& viewMatrix, const std::vector<Shaders::PointLight>& pointLights, const std::vector<Shaders::SpotLight>& spotLights)
+{
+	m_assignments.clear();
+
+	for (uint32_t i{ 0 }; i < pointLights.size(); ++i)
+	{
+		glm::vec3 center = glm::vec3(viewMatrix * glm::vec4(glm::vec3(pointLights[i].position), 1.0f));
+		assignLight(center, pointLights[i].getRange(), i, 0);
+	}
+
+	for (uint32_t i{ 0 }; i < spotLights.size(); ++i)
+	{
+		const Shaders::SpotLight& spotLight = spotLights[i];
+		float range = spotLight.getRange();
+		glm::vec3 position = glm::vec3(spotLight.position);
+		glm::vec3 direction = glm::normalize(glm::vec3(spotLight.direction));
+		float cosAngle = spotLight.outterCutOff;
+
+		// Bounding sphere of the lit cone
+		glm::vec3 center = position;
+		float radius = range;
+		if (cosAngle >= std::sqrt(0.5f))
+		{
+			radius = range / (2.0f * cosAngle);
+			center = position + radius * direction;
+		}
+		else if (cosAngle > 0.0f)
+		{
+			radius = range * std::sqrt(1.0f - cosAngle * cosAngle);
+			center = position + range * cosAngle * direction;
+		}
+
+		center = glm::vec3(viewMatrix * glm::vec4(center, 1.0f));
+		assignLight(center, radius, i, 1);
+	}
+
+	// Counting sort by (cluster, light type) key
+	std::fill(std::begin(m_counts), std::end(m_counts), 0);
+	for (const auto& [key, lightIndex] : m_assignments)
+	{
+		++m_counts[key + 1];
+	}
+
+	for (size_t i{ 1 }; i < m_counts.size(); ++i)
+	{
+		m_counts[i] += m_counts[i - 1];
+	}
+
+	for (uint32_t i{ 0 }; i < m_clusters.size(); ++i)
+	{
+		m_clusters[i].offset = m_counts[2 * i];
+		m_clusters[i].pointLightCount = m_counts[2 * i + 1] - m_counts[2 * i];
+		m_clusters[i].spotLightCount = m_counts[2 * i + 2] - m_counts[2 * i + 1];
+	}
+
+	m_lightIndices.resize(m_assignments.size());
+	for (const auto& [key, lightIndex] : m_assignments)
+	{
+		m_lightIndices[m_counts[key]++] = lightIndex;
+	}
+}
+
+uint32_t GraphicEngine::Engines::Graphic::LightClusterGrid::getClusterIndex(uint32_t x, uint32_t y, uint32_t slice) const
+{
+	return x + m_tilesX * (y + m_tilesY * slice);
+}
+
+uint32_t GraphicEngine::Engines::Graphic::LightClusterGrid::getClusterIndex(glm::vec2 fragCoord, float viewDepth) const
+{
+	glm::vec2 tile = fragCoord / m_parameters.screenSize * glm::vec2(m_tilesX, m_tilesY);
+	uint32_t x = std::min(static_cast<uint32_t>(std::max(tile.x, 0.0f)), m_tilesX - 1);
+	uint32_t y = std::min(static_cast<uint32_t>(std::max(tile.y, 0.0f)), m_tilesY - 1);
+	return getClusterIndex(x, y, getSliceIndex(viewDepth));
+}
+
+uint32_t GraphicEngine::Engines::Graphic::LightClusterGrid::getSliceIndex(float viewDepth) const
+{
+	if (viewDepth < m_parameters.clusterNear)
+		return 0;
+
+	float slice = std::log(viewDepth) * m_parameters.sliceScale + m_parameters.sliceBias;
+	return std::min(static_cast<uint32_t>(std::max(slice, 0.0f)) + 1, m_slices - 1);
+}
+
+float GraphicEngine::Engines::Graphic::LightClusterGrid::getSliceDepth(uint32_t slice) const
+{
+	if (slice == 0)
+		return m_zNear;
+
+	if (slice >= m_slices)
+		return m_zFar;
+
+	float clusterNear = m_parameters.clusterNear;
+	return clusterNear * std::pow(m_zFar / clusterNear, static_cast<float>(slice - 1) / (m_slices - 1));
+}
+
+uint32_t GraphicEngine::Engines::Graphic::LightClusterGrid::getClustersCount() const
+{
+	return m_tilesX * m_tilesY * m_slices;
+}
+
+std::pair<glm::vec3, glm::vec3> GraphicEngine::Engines::Graphic::LightClusterGrid::getClusterBounds(uint32_t index) const
+{
+	if (index >= m_clustersMin.size())
+	{
+		throw std::out_of_range("Cluster index out of bound");
+	}
+
+	return { m_clustersMin[index], m_clustersMax[index] };
+}
+
+GraphicEngine::Engines::Graphic::Shaders::LightClusterParameters GraphicEngine::Engines::Graphic::LightClusterGrid::getParameters() const
+{
+	return m_parameters;
+}
+
+const std::vector<GraphicEngine::Engines::Graphic::Shaders::LightCluster>& GraphicEngine::Engines::Graphic::LightClusterGrid::getClusters() const
+{
+	return m_clusters;
+}
+
+const std::vector<uint32_t>& GraphicEngine::Engines::Graphic::LightClusterGrid::getLightIndices() const
+{
+	return m_lightIndices;
+}
+
+void GraphicEngine::Engines::Graphic::LightClusterGrid::assignLight(glm::vec3 center, float radius, uint32_t lightIndex, uint32_t lightType)
+{
+	float depth = -center.z;
+	if (radius <= 0.0f || depth + radius < m_zNear || depth - radius > m_zFar)
+		return;
+
+	uint32_t firstSlice = getSliceIndex(std::max(depth - radius, m_zNear));
+	uint32_t lastSlice = getSliceIndex(std::min(depth + radius, m_zFar));
+
+	for (uint32_t slice{ firstSlice }; slice <= lastSlice; ++slice)
+	{
+		for (uint32_t y{ 0 }; y < m_tilesY; ++y)
+		{
+			const glm::vec2& row = m_rowsBounds[slice * m_tilesY + y];
+			if (center.y + radius < row.x || center.y - radius > row.y)
+				continue;
+
+			for (uint32_t x{ 0 }; x < m_tilesX; ++x)
+			{
+				const glm::vec2& column = m_columnsBounds[slice * m_tilesX + x];
+				if (center.x + radius < column.x || center.x - radius > column.y)
+					continue;
+
+				uint32_t clusterIndex = getClusterIndex(x, y, slice);
+				if (intersects(clusterIndex, center, radius))
+				{
+					m_assignments.emplace_back(2 * clusterIndex + lightType, lightIndex);
+				}
+			}
+		}
+	}
+}
+
+bool GraphicEngine::Engines::Graphic::LightClusterGrid::intersects(uint32_t clusterIndex, glm::vec3 center, float radius) const
+{
+	glm::vec3 closestPoint = glm::clamp(center, m_clustersMin[clusterIndex], m_clustersMax[clusterIndex]);
+	glm::vec3 distance = closestPoint - center;
+	return glm::dot(distance, distance) <= radius * radius;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "../Shaders/Models/Light.hpp"
+#include "../Shaders/Models/LightCluster.hpp"
+
+#include <glm/glm.hpp>
+#include <utility>
+#include <vector>
+
+namespace GraphicEngine::Engines::Graphic
+{
+	// Froxel grid in camera view space used to bin point and spot lights for clustered forward shading.
+	// Depth is sliced exponentially from clusterNear to the far plane, everything closer lands in slice 0.
+	class LightClusterGrid
+	{
+	public:
+		LightClusterGrid(uint32_t tilesX = 16, uint32_t tilesY = 9, uint32_t slices = 24, float clusterNear = 0.1f);
+
+		// Recalculates cluster bounds only when projection matrix changed
+		void build(const glm::mat4& projectionMatrix, float width, float height);
+
+		void assignLights(const glm::mat4& viewMatrix, const std::vector<Shaders::PointLight>& pointLights, const std::vector<Shaders::SpotLight>& spotLights);
+
+		uint32_t getClusterIndex(uint32_t x, uint32_t y, uint32_t slice) const;
+		// Same lookup as in fragment shader, fragCoord is in pixels with origin in lower left corner
+		uint32_t getClusterIndex(glm::vec2 fragCoord, float viewDepth) const;
+		uint32_t getSliceIndex(float viewDepth) const;
+		float getSliceDepth(uint32_t slice) const;
+		uint32_t getClustersCount() const;
+
+		std::pair<glm::vec3, glm::vec3> getClusterBounds(uint32_t index) const;
+
+		Shaders::LightClusterParameters getParameters() const;
+		const std::vector<Shaders::LightCluster>& getClusters() const;
+		const std::vector<uint32_t>& getLightIndices() const;
+
+	private:
+		void assignLight(glm::vec3 center, float radius, uint32_t lightIndex, uint32_t lightType);
+		bool intersects(uint32_t clusterIndex, glm::vec3 center, float radius) const;
+
+	private:
+		uint32_t m_tilesX;
+		uint32_t m_tilesY;
+		uint32_t m_slices;
+		float m_clusterNear;
+		float m_zNear{ 0.0f };
+		float m_zFar{ 0.0f };
+
+		glm::mat4 m_projectionMatrix{ 0.0f };
+		Shaders::LightClusterParameters m_parameters;
+
+		std::vector<glm::vec3> m_clustersMin;
+		std::vector<glm::vec3> m_clustersMax;
+		// Union of cluster bounds per slice column and row, used to reject tiles before exact test
+		std::vector<glm::vec2> m_columnsBounds;
+		std::vector<glm::vec2> m_rowsBounds;
+
+		// (cluster index * 2 + light type, light index) pairs, sorted into light index list by counting sort
+		std::vector<std::pair<uint32_t, uint32_t>> m_assignments;
+		std::vector<uint32_t> m_counts;
+
+		std::vector<Shaders::LightCluster> m_clusters;
+		std::vector<uint32_t> m_lightIndices;
+	};
+}
@@ -10,108 +10,112 @@ namespace GraphicEngine::Engines::Graphic
 	class ConeGenerator : public IObjectGenerator<Vertex, glm::vec3, float, float, glm::ivec3, bool, bool, TriangleDirection>
 	{
 	public:
+		// Bottom is center with scale.y + 1 rings, middle has scale.z + 1 rings and separate apex for every triangle of tip
+		static size_t getVerticesCount(glm::ivec3 scale, bool generateBottom = true, bool generateMiddle = true)
+		{
+			size_t columns = scale.x + 1;
+			return (generateBottom ? 1 + columns * (scale.y + 1) : 0) + (generateMiddle ? columns * (scale.z + 2) : 0);
+		}
+
+		static size_t getIndicesCount(glm::ivec3 scale, bool generateBottom = true, bool generateMiddle = true)
+		{
+			size_t columns = scale.x + 1;
+			return 3 * ((generateBottom ? columns * (1 + 2 * scale.y) : 0) + (generateMiddle ? columns * (1 + 2 * scale.z) : 0));
+		}
+
 		virtual std::tuple<std::vector<std::shared_ptr<Vertex>>, std::vector<std::shared_ptr<Scene::Face>>, Core::BoudingBox3D, glm::vec3> getObject(glm::vec3 center, float radius, float height, glm::ivec3 scale,
 			bool generateBottom = true, bool generateMiddle = true,
 			TriangleDirection triangleDirection = TriangleDirection::Clockwise) override
 		{
-			float fiStep = 360.0f / (scale.x + 1);
+			return this->toObject(getBuffers(center, radius, height, scale, generateBottom, generateMiddle, triangleDirection));
+		}
+
+		virtual ObjectBuffers<Vertex> getBuffers(glm::vec3 center, float radius, float height, glm::ivec3 scale,
+			bool generateBottom = true, bool generateMiddle = true,
+			TriangleDirection triangleDirection = TriangleDirection::Clockwise) override
+		{
+			ObjectBuffers<Vertex> buffers;
+			buffers.vertices.resize(getVerticesCount(scale, generateBottom, generateMiddle));
+			buffers.indices.resize(getIndicesCount(scale, generateBottom, generateMiddle));
+			buffers.boudingBox = Core::BoudingBox3D(glm::vec3(-radius, 0.0f, -radius) + center, glm::vec3(radius, height, radius) + center);
+			buffers.pivotPoint = center;
+
+			uint32_t columns = scale.x + 1;
+			float fiStep = 360.0f / columns;
 			float radiusStep = radius / (scale.y + 1);
 			float heightStep = height / (scale.z + 1);
 			float secondRadiusStep{ radius / (scale.z + 1) };
-			
-			Core::BoudingBox3D boudingBox(glm::vec3(-radius, 0.0f, -radius) + center, glm::vec3(radius, height, radius) + center);
-
-			std::vector<std::shared_ptr<Vertex>> vertices;
-			std::vector<std::shared_ptr<Scene::Face>> faces;
-			vertices.reserve((scale.x + 1) * (scale.y + 1) + (scale.x + 2) * (scale.z + 2));
-			faces.reserve(2 * (scale.x * scale.y) + 2 * scale.x * scale.z + 2 * scale.x);
 
 			uint32_t verticesOffset{ 0 };
+			size_t trianglesOffset{ 0 };
 
 			if (generateBottom)
 			{
-				auto v1 = std::make_shared<Vertex>();
-				v1->position = center;
-				vertices.push_back(v1);
-				boudingBox.extendBox(v1->position);
+				buffers.vertices[0].position = center;
 
-				uint32_t verticesOffset = vertices.size();
-
-				for (uint32_t y{ 0 }; y < scale.y + 1; ++y)
+				this->forEachRow(scale.y + 1, [&](uint32_t y)
 				{
 					float internalRadius{ (y + 1) * radiusStep };
-					for (uint32_t x{ 0 }; x < scale.x + 1; ++x)
+					for (uint32_t x{ 0 }; x < columns; ++x)
 					{
 						float internalFi{ glm::radians(x * fiStep) };
-						auto v2 = std::make_shared<Vertex>();
-						v2->position = glm::vec3(internalRadius * std::cos(internalFi), 0.0f, internalRadius * std::sin(internalFi)) + center;
-						vertices.push_back(v2);
-						boudingBox.extendBox(v2->position);
+						buffers.vertices[1 + static_cast<size_t>(y) * columns + x].position = glm::vec3(internalRadius * std::cos(internalFi), 0.0f, internalRadius * std::sin(internalFi)) + center;
 					}
-				}
+				});
 
-				for (uint32_t i{ 0 }; i < scale.x + 1; ++i)
+				// Row 0 is fan around center
+				this->forEachRow(scale.y + 1, [&](uint32_t y)
 				{
-					faces.push_back(this->buildFace(0, i == scale.x ? 1 : i + 2, i + 1, triangleDirection));
-				}
-
-				for (uint32_t y{ 0 }; y < scale.y; ++y)
-				{
-					for (uint32_t x{ 0 }; x < scale.x + 1; ++x)
+					if (y == 0)
 					{
-						uint32_t point = x + (y * (scale.x + 1)) + 1;
-						faces.push_back(this->buildFace(point, (x == scale.x ? point + 1 : point + 2 + scale.x), point + 1 + scale.x, triangleDirection));
-						faces.push_back(this->buildFace(point, (x == scale.x ? (point - scale.x) : (point + 1)), (x == scale.x ? point + 1 : point + 2 + scale.x), triangleDirection));
+						this->setRingFan(buffers.indices, 0, 0, 1, columns, triangleDirection);
+						return;
 					}
-				}
+					this->setRingBand(buffers.indices, columns + 2 * static_cast<size_t>(columns) * (y - 1), 1 + (y - 1) * columns, columns, triangleDirection);
+				});
+
+				verticesOffset = 1 + columns * (scale.y + 1);
+				trianglesOffset = columns * (1 + 2 * static_cast<size_t>(scale.y));
 			}
 
 			if (generateMiddle)
 			{
-				verticesOffset = vertices.size();
+				uint32_t apexOffset = verticesOffset + columns * (scale.z + 1);
+				uint32_t lastRing = apexOffset - columns;
 
-				for (uint32_t z{ 0 }; z < scale.z + 1; ++z)
+				this->forEachRow(scale.z + 1, [&](uint32_t z)
 				{
 					float internalRadius{ radius - z * secondRadiusStep };
-					for (uint32_t x{ 0 }; x < scale.x + 1; ++x)
+					for (uint32_t x{ 0 }; x < columns; ++x)
 					{
 						float internalFi{ glm::radians(x * fiStep) };
-						auto v2 = std::make_shared<Vertex>();
-						v2->position = glm::vec3(internalRadius * std::cos(internalFi), z * heightStep, internalRadius * std::sin(internalFi)) + center;
-						vertices.push_back(v2);
-						boudingBox.extendBox(v2->position);
+						buffers.vertices[verticesOffset + static_cast<size_t>(z) * columns + x].position = glm::vec3(internalRadius * std::cos(internalFi), z * heightStep, internalRadius * std::sin(internalFi)) + center;
 					}
-				}
+				});
 
-				for (uint32_t z{ 0 }; z < scale.z; ++z)
+				for (uint32_t x{ 0 }; x < columns; ++x)
 				{
-					for (uint32_t x{ 0 }; x < scale.x + 1; ++x)
-					{
-						uint32_t point = x + (z * (scale.x + 1)) + verticesOffset;
-						faces.push_back(this->buildFace(point, (x == scale.x ? point + 1 : point + 2 + scale.x), point + 1 + scale.x, triangleDirection));
-						faces.push_back(this->buildFace(point, (x == scale.x ? (point - scale.x) : (point + 1)), (x == scale.x ? point + 1 : point + 2 + scale.x), triangleDirection));
-					}
+					buffers.vertices[apexOffset + x].position = center + glm::vec3(0.0f, height, 0.0f);
 				}
 
-				uint32_t last = vertices.size() - 1;
-				uint32_t offset = last - (scale.x + 1);
-				for (uint32_t i{ offset }; i < last - 1; ++i)
+				// Last row closes tip
+				this->forEachRow(scale.z + 1, [&](uint32_t z)
 				{
-					auto v3 = std::make_shared<Vertex>();
-					v3->position = center + glm::vec3(0.0f, height, 0.0f);
-					vertices.push_back(v3);
-					boudingBox.extendBox(v3->position);
-					faces.push_back(this->buildFace(i, i + 1, vertices.size() - 1, triangleDirection));
-				}
+					size_t triangle = trianglesOffset + 2 * static_cast<size_t>(columns) * z;
+					if (z == static_cast<uint32_t>(scale.z))
+					{
+						for (uint32_t i{ 0 }; i < columns; ++i)
+						{
+							this->setTriangle(buffers.indices, triangle + i, lastRing + i, lastRing + (i + 1) % columns, apexOffset + i, triangleDirection);
+						}
+						return;
+					}
 
-				auto v3 = std::make_shared<Vertex>();
-				v3->position = center + glm::vec3(0.0f, height, 0.0f);
-				vertices.push_back(v3);
-				boudingBox.extendBox(v3->position);
-				faces.push_back(this->buildFace(last - 1, offset, vertices.size() - 1, triangleDirection));
+					this->setRingBand(buffers.indices, triangle, verticesOffset + z * columns, columns, triangleDirection);
+				});
 			}
 
-			return std::make_tuple(vertices, faces, boudingBox, center);
+			return buffers;
 		}
 	};
-}
\ No newline at end of file
+}
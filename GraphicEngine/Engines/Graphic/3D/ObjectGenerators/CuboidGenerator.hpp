@@ -3,21 +3,37 @@
 #include "IObjectGenerator.hpp"
 #include <glm/vec3.hpp>
 
+#include <array>
+
 namespace GraphicEngine::Engines::Graphic
 {
 	template <typename Vertex>
 	class CuboidGenerator : public IObjectGenerator<Vertex, glm::vec3, glm::vec3, glm::ivec3, GeneratingPosition, TriangleDirection>
 	{
 	public:
+		// Every wall has its own vertices so normals are not shared between walls
+		static size_t getVerticesCount(glm::ivec3 scale)
+		{
+			return 2 * (static_cast<size_t>(scale.x + 1) * (scale.z + 1) + static_cast<size_t>(scale.x + 1) * (scale.y + 1) + static_cast<size_t>(scale.y + 1) * (scale.z + 1));
+		}
+
+		static size_t getIndicesCount(glm::ivec3 scale)
+		{
+			return 12 * (static_cast<size_t>(scale.x) * scale.z + static_cast<size_t>(scale.x) * scale.y + static_cast<size_t>(scale.y) * scale.z);
+		}
+
 		virtual std::tuple<std::vector<std::shared_ptr<Vertex>>, std::vector<std::shared_ptr<Scene::Face>>, Core::BoudingBox3D, glm::vec3> getObject(glm::vec3 beginPosition, glm::vec3 endPosition, glm::ivec3 scale,
 			GeneratingPosition generateFrom = GeneratingPosition::Corner, TriangleDirection triangleDirection = TriangleDirection::Clockwise) override
 		{
-			auto verticesSize = 2 * (((scale.x + 1) * (scale.z + 1)) + ((scale.x + 1) * (scale.y + 1)) + ((scale.y + 1) * (scale.z + 1)));
-			std::vector<std::shared_ptr<Vertex>> vertices;
-			std::vector<std::shared_ptr<Scene::Face>> faces;
+			return this->toObject(getBuffers(beginPosition, endPosition, scale, generateFrom, triangleDirection));
+		}
 
-			vertices.reserve(verticesSize);
-			faces.reserve(4 * scale.x * scale.y * scale.z);
+		virtual ObjectBuffers<Vertex> getBuffers(glm::vec3 beginPosition, glm::vec3 endPosition, glm::ivec3 scale,
+			GeneratingPosition generateFrom = GeneratingPosition::Corner, TriangleDirection triangleDirection = TriangleDirection::Clockwise) override
+		{
+			ObjectBuffers<Vertex> buffers;
+			buffers.vertices.resize(getVerticesCount(scale));
+			buffers.indices.resize(getIndicesCount(scale));
 
 			auto from = beginPosition;
 			auto to = endPosition;
@@ -28,140 +44,72 @@ namespace GraphicEngine::Engines::Graphic
 				to = beginPosition + endPosition;
 			}
 
-			Core::BoudingBox3D boudingBox(from, to);
+			buffers.boudingBox = Core::BoudingBox3D(from, to);
+			buffers.pivotPoint = buffers.boudingBox.getCenter();
 
 			glm::vec3 step(to - from);
 			step.x /= scale.x;
 			step.y /= scale.y;
 			step.z /= scale.z;
 
-			// Vertices
-
-			// first wall x,z
-			for (uint32_t z{ 0 }; z < scale.z + 1; ++z)
+			// Walls as pairs of axes spanning them, wall axis is fixed on from and then on to
+			struct Wall
 			{
-				for (uint32_t x{ 0 }; x < scale.x + 1; ++x)
-				{
-					auto v = std::make_shared<Vertex>();
-					v->position = glm::vec3(from + step * glm::vec3(x, 0.0f, z));
-					vertices.push_back(v);
-					boudingBox.extendBox(v->position);
-				}
-			}
-
-			// second wall x,z
-			for (uint32_t z{ 0 }; z < scale.z + 1; ++z)
-			{
-				for (uint32_t x{ 0 }; x < scale.x + 1; ++x)
-				{
-					auto v = std::make_shared<Vertex>();
-					v->position = glm::vec3(from + step * glm::vec3(x, 0.0f, z));
-					v->position.y = to.y;
-					vertices.push_back(v);
-					boudingBox.extendBox(v->position);
-				}
-			}
-
-			// first wall x,y
-			for (uint32_t y{ 0 }; y < scale.y + 1; ++y)
+				int columnAxis;
+				int rowAxis;
+				int fixedAxis;
+			};
+			const std::array<Wall, 3> walls{ { { 0, 2, 1 }, { 0, 1, 2 }, { 1, 2, 0 } } };
+
+			size_t verticesOffset{ 0 };
+			size_t trianglesOffset{ 0 };
+			for (const auto& wall : walls)
 			{
-				for (uint32_t x{ 0 }; x < scale.x + 1; ++x)
-				{
-					auto v = std::make_shared<Vertex>();
-					v->position = glm::vec3(from + step * glm::vec3(x, y, 0.0f));
-					vertices.push_back(v);
-					boudingBox.extendBox(v->position);
-				}
-			}
+				uint32_t columns = scale[wall.columnAxis];
+				uint32_t rows = scale[wall.rowAxis];
+				size_t wallVertices = static_cast<size_t>(columns + 1) * (rows + 1);
+				size_t wallTriangles = 2 * static_cast<size_t>(columns) * rows;
 
-			// second wall x,y
-			for (uint32_t y{ 0 }; y < scale.y + 1; ++y)
-			{
-				for (uint32_t x{ 0 }; x < scale.x + 1; ++x)
+				// Vertices
+				this->forEachRow(2 * (rows + 1), [&](uint32_t row)
 				{
-					auto v = std::make_shared<Vertex>();
-					v->position = glm::vec3(from + step * glm::vec3(x, y, 0.0f));
-					v->position.z = to.z;
-					vertices.push_back(v);
-					boudingBox.extendBox(v->position);
-				}
-			}
-
-			// first wall y,z
-			for (uint32_t z{ 0 }; z < scale.z + 1; ++z)
-			{
-				for (uint32_t y{ 0 }; y < scale.y + 1; ++y)
-				{
-					auto v = std::make_shared<Vertex>();
-					v->position = glm::vec3(from + step * glm::vec3(0.0f, y, z));
-					vertices.push_back(v);
-					boudingBox.extendBox(v->position);
-				}
-			}
-
-			// second wall y,z
-			for (uint32_t z{ 0 }; z < scale.z + 1; ++z)
-			{
-				for (uint32_t y{ 0 }; y < scale.y + 1; ++y)
-				{
-					auto v = std::make_shared<Vertex>();
-					v->position = glm::vec3(from + step * glm::vec3(0.0f, y, z));
-					v->position.x = to.x;
-					vertices.push_back(v);
-					boudingBox.extendBox(v->position);
-				}
-			}
-
-			// Faces
-
-			// walls x,z
-			for (uint32_t z{ 0 }; z < scale.z; ++z)
-			{
-				auto offset = (scale.x + 1) * (scale.z + 1);
-				for (uint32_t x{ 0 }; x < scale.x; ++x)
-				{
-					uint32_t point = x + (z * (scale.x + 1));
-					faces.push_back(this->buildFace(point, point + 2 + scale.x, point + 1, triangleDirection));
-					faces.push_back(this->buildFace(point, point + 1 + scale.x, point + 2 + scale.x, triangleDirection));
-					point = x + (z * (scale.x + 1)) + offset;
-					faces.push_back(this->buildFace(point, point + 2 + scale.x, point + 1 + scale.x, triangleDirection));
-					faces.push_back(this->buildFace(point, point + 1, point + 2 + scale.x, triangleDirection));
-				}
-			}
-
-			// walls x,y
-			for (uint32_t y{ 0 }; y < scale.y; ++y)
-			{
-				auto offset = 2 * (scale.x + 1) * (scale.z + 1);
-				auto baseOffset = (2 * (scale.x + 1) * (scale.z + 1)) + (scale.x + 1) * (scale.y + 1);
-				for (uint32_t x{ 0 }; x < scale.x; ++x)
-				{
-					uint32_t point = x + (y * (scale.x + 1)) + offset;
-					faces.push_back(this->buildFace(point, point + 2 + scale.x, point + 1 + scale.x, triangleDirection));
-					faces.push_back(this->buildFace(point, point + 1, point + 2 + scale.x, triangleDirection));
-					point = x + (y * (scale.x + 1)) + baseOffset;
-					faces.push_back(this->buildFace(point, point + 2 + scale.x, point + 1, triangleDirection));
-					faces.push_back(this->buildFace(point, point + 1 + scale.x, point + 2 + scale.x, triangleDirection));
-				}
-			}
-
-			// walls y,z
-			for (uint32_t z{ 0 }; z < scale.z; ++z)
-			{
-				auto offset = 2 * ((scale.x + 1) * (scale.z + 1) + (scale.x + 1) * (scale.y + 1));
-				auto baseOffset = offset + (scale.z + 1) * (scale.x + 1);
-				for (uint32_t x{ 0 }; x < scale.x; ++x)
+					bool second = row > rows;
+					uint32_t r = second ? row - rows - 1 : row;
+					size_t vertex = verticesOffset + (second ? wallVertices : 0) + static_cast<size_t>(r) * (columns + 1);
+					for (uint32_t c{ 0 }; c < columns + 1; ++c)
+					{
+						glm::vec3 position{ 0.0f };
+						position[wall.columnAxis] = static_cast<float>(c);
+						position[wall.rowAxis] = static_cast<float>(r);
+						position = from + step * position;
+						position[wall.fixedAxis] = second ? to[wall.fixedAxis] : from[wall.fixedAxis];
+						buffers.vertices[vertex++].position = position;
+					}
+				});
+
+				// Faces, front and back walls have opposite winding
+				bool xz = wall.fixedAxis == 1;
+				this->forEachRow(rows, [&](uint32_t r)
 				{
-					uint32_t point = x + (z * (scale.x + 1)) + offset;
-					faces.push_back(this->buildFace(point, point + 2 + scale.x, point + 1 + scale.x, triangleDirection));
-					faces.push_back(this->buildFace(point, point + 1, point + 2 + scale.x, triangleDirection));
-					point = x + (z * (scale.x + 1)) + baseOffset;
-					faces.push_back(this->buildFace(point, point + 2 + scale.x, point + 1, triangleDirection));
-					faces.push_back(this->buildFace(point, point + 1 + scale.x, point + 2 + scale.x, triangleDirection));
-				}
+					size_t triangle = trianglesOffset + 4 * static_cast<size_t>(r) * columns;
+					for (uint32_t c{ 0 }; c < columns; ++c)
+					{
+						uint32_t point = static_cast<uint32_t>(verticesOffset) + c + r * (columns + 1);
+						uint32_t otherPoint = point + static_cast<uint32_t>(wallVertices);
+						uint32_t first = xz ? point : otherPoint;
+						uint32_t second = xz ? otherPoint : point;
+						this->setTriangle(buffers.indices, triangle++, first, first + 2 + columns, first + 1, triangleDirection);
+						this->setTriangle(buffers.indices, triangle++, first, first + 1 + columns, first + 2 + columns, triangleDirection);
+						this->setTriangle(buffers.indices, triangle++, second, second + 2 + columns, second + 1 + columns, triangleDirection);
+						this->setTriangle(buffers.indices, triangle++, second, second + 1, second + 2 + columns, triangleDirection);
+					}
+				});
+
+				verticesOffset += 2 * wallVertices;
+				trianglesOffset += 2 * wallTriangles;
 			}
 
-			return std::make_tuple(vertices, faces, boudingBox, boudingBox.getCenter());
+			return buffers;
 		}
 	};
-}
\ No newline at end of file
+}
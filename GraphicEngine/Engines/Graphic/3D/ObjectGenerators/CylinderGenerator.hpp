@@ -10,134 +10,119 @@ namespace GraphicEngine::Engines::Graphic
 	class CylinderGenerator : public IObjectGenerator<Vertex, glm::vec3, float, float, float, glm::ivec3, bool, bool, bool, TriangleDirection>
 	{
 	public:
+		// Bottom and top are center with scale.y + 1 rings, middle has scale.z + 2 rings
+		static size_t getVerticesCount(glm::ivec3 scale, bool generateBottom = true, bool generateMiddle = true, bool generateTop = true)
+		{
+			size_t columns = scale.x + 1;
+			size_t capVertices = 1 + columns * (scale.y + 1);
+			return (generateBottom ? capVertices : 0) + (generateMiddle ? columns * (scale.z + 2) : 0) + (generateTop ? capVertices : 0);
+		}
+
+		static size_t getIndicesCount(glm::ivec3 scale, bool generateBottom = true, bool generateMiddle = true, bool generateTop = true)
+		{
+			size_t columns = scale.x + 1;
+			size_t capTriangles = columns * (1 + 2 * scale.y);
+			return 3 * ((generateBottom ? capTriangles : 0) + (generateMiddle ? 2 * columns * (scale.z + 1) : 0) + (generateTop ? capTriangles : 0));
+		}
+
 		virtual std::tuple<std::vector<std::shared_ptr<Vertex>>, std::vector<std::shared_ptr<Scene::Face>>, Core::BoudingBox3D, glm::vec3> getObject(
 			glm::vec3 center, float radiusBottom, float radiusTop, float height, glm::ivec3 scale,
 			bool generateBottom = true, bool generateMiddle = true, bool generateTop = true,
 			TriangleDirection triangleDirection = TriangleDirection::Clockwise) override
 		{
-			float fiStep{ 360.0f / (scale.x + 1) };
-			float bottomRadiusStep{ radiusBottom / (scale.y + 1) };
-			float topRadiusStep{ radiusTop / (scale.y + 1) };
-			float heightStep{ height / (scale.z + 1) };
-			float secondRadiusStep{ (radiusBottom - radiusTop) / (scale.z + 1) };
+			return this->toObject(getBuffers(center, radiusBottom, radiusTop, height, scale, generateBottom, generateMiddle, generateTop, triangleDirection));
+		}
+
+		virtual ObjectBuffers<Vertex> getBuffers(
+			glm::vec3 center, float radiusBottom, float radiusTop, float height, glm::ivec3 scale,
+			bool generateBottom = true, bool generateMiddle = true, bool generateTop = true,
+			TriangleDirection triangleDirection = TriangleDirection::Clockwise) override
+		{
 			float boudingBoxRadius{ std::max(radiusBottom, radiusTop) };
 
-			Core::BoudingBox3D boudingBox(glm::vec3(-boudingBoxRadius, 0.0f, -boudingBoxRadius) + center, glm::vec3(boudingBoxRadius, height, boudingBoxRadius) + center);
+			ObjectBuffers<Vertex> buffers;
+			buffers.vertices.resize(getVerticesCount(scale, generateBottom, generateMiddle, generateTop));
+			buffers.indices.resize(getIndicesCount(scale, generateBottom, generateMiddle, generateTop));
+			buffers.boudingBox = Core::BoudingBox3D(glm::vec3(-boudingBoxRadius, 0.0f, -boudingBoxRadius) + center, glm::vec3(boudingBoxRadius, height, boudingBoxRadius) + center);
+			buffers.pivotPoint = center;
 
-			std::vector<std::shared_ptr<Vertex>> vertices;
-			std::vector<std::shared_ptr<Scene::Face>> faces;
-			vertices.reserve(2*(scale.x + 1) * (scale.y + 1) + (scale.x + 1) * (scale.z + 2) + 2);
-			faces.reserve(4 * (scale.x * scale.y) + 2 * scale.x * scale.z + 2 * scale.x);
+			uint32_t columns = scale.x + 1;
+			float fiStep{ 360.0f / columns };
+			float heightStep{ height / (scale.z + 1) };
+			float secondRadiusStep{ (radiusBottom - radiusTop) / (scale.z + 1) };
 
 			uint32_t verticesOffset{ 0 };
+			size_t trianglesOffset{ 0 };
 
 			if (generateBottom)
 			{
-				auto v1 = std::make_shared<Vertex>();
-				v1->position = center;
-				vertices.push_back(v1);
-				boudingBox.extendBox(v1->position);
-
-				verticesOffset = vertices.size();
-
-				for (uint32_t y{ 0 }; y < scale.y + 1; ++y)
-				{
-					float internalRadius{ (y + 1) * bottomRadiusStep };
-					for (uint32_t x{ 0 }; x < scale.x + 1; ++x)
-					{
-						float internalFi{ glm::radians(x * fiStep) };
-						auto v2 = std::make_shared<Vertex>();
-						v2->position = glm::vec3(internalRadius * std::cos(internalFi), 0.0f, internalRadius * std::sin(internalFi)) + center;
-						vertices.push_back(v2);
-						boudingBox.extendBox(v2->position);
-					}
-				}
-
-				for (uint32_t i{ 0 }; i < scale.x + 1; ++i)
-				{
-					faces.push_back(this->buildFace(verticesOffset - 1, verticesOffset + (i == scale.x ? 1 : i + 2), verticesOffset + i + 1, triangleDirection));
-				}
-
-				for (uint32_t y{ 0 }; y < scale.y; ++y)
-				{
-					for (uint32_t x{ 0 }; x < scale.x + 1; ++x)
-					{
-						uint32_t point = x + (y * (scale.x + 1)) + 1;
-						faces.push_back(this->buildFace(point, (x == scale.x ? point + 1 : point + 2 + scale.x), point + 1 + scale.x, triangleDirection));
-						faces.push_back(this->buildFace(point, (x == scale.x ? (point - scale.x) : (point + 1)), (x == scale.x ? point + 1 : point + 2 + scale.x), triangleDirection));
-					}
-				}
+				generateCap(buffers, verticesOffset, trianglesOffset, center, radiusBottom, scale, false, triangleDirection);
+				verticesOffset += 1 + columns * (scale.y + 1);
+				trianglesOffset += columns * (1 + 2 * static_cast<size_t>(scale.y));
 			}
 
 			if (generateMiddle)
 			{
-				verticesOffset = vertices.size();
-
-				for (uint32_t z{ 0 }; z < scale.z + 2; ++z)
+				this->forEachRow(scale.z + 2, [&](uint32_t z)
 				{
 					float internalRadius{ radiusBottom - z * secondRadiusStep };
-					for (uint32_t x{ 0 }; x < scale.x + 1; ++x)
+					for (uint32_t x{ 0 }; x < columns; ++x)
 					{
 						float internalFi{ glm::radians(x * fiStep) };
-						auto v2 = std::make_shared<Vertex>();
-						v2->position = glm::vec3(internalRadius * std::cos(internalFi), z * heightStep, internalRadius * std::sin(internalFi)) + center;
-						vertices.push_back(v2);
-						boudingBox.extendBox(v2->position);
+						buffers.vertices[verticesOffset + static_cast<size_t>(z) * columns + x].position = glm::vec3(internalRadius * std::cos(internalFi), z * heightStep, internalRadius * std::sin(internalFi)) + center;
 					}
-				}
+				});
 
-				for (uint32_t z{ 0 }; z < scale.z + 1; ++z)
+				this->forEachRow(scale.z + 1, [&](uint32_t z)
 				{
-					for (uint32_t x{ 0 }; x < scale.x + 1; ++x)
-					{
-						uint32_t point = x + (z * (scale.x + 1)) + verticesOffset;
-						faces.push_back(this->buildFace(point, (x == scale.x ? point + 1 : point + 2 + scale.x), point + 1 + scale.x, triangleDirection));
-						faces.push_back(this->buildFace(point, (x == scale.x ? (point - scale.x) : (point + 1)), (x == scale.x ? point + 1 : point + 2 + scale.x), triangleDirection));
-					}
-				}
+					this->setRingBand(buffers.indices, trianglesOffset + 2 * static_cast<size_t>(columns) * z, verticesOffset + z * columns, columns, triangleDirection);
+				});
+
+				verticesOffset += columns * (scale.z + 2);
+				trianglesOffset += 2 * static_cast<size_t>(columns) * (scale.z + 1);
 			}
 
 			if (generateTop)
 			{
-				verticesOffset = vertices.size();
+				generateCap(buffers, verticesOffset, trianglesOffset, center + glm::vec3(0.0f, height, 0.0f), radiusTop, scale, true, triangleDirection);
+			}
 
-				auto v3 = std::make_shared<Vertex>();
-				v3->position = center + glm::vec3(0.0f, height, 0.0f);
-				vertices.push_back(v3);
-				boudingBox.extendBox(v3->position);
+			return buffers;
+		}
 
-				verticesOffset = vertices.size();
+	private:
+		// Center vertex followed by scale.y + 1 rings, top cap is facing opposite direction
+		void generateCap(ObjectBuffers<Vertex>& buffers, uint32_t verticesOffset, size_t trianglesOffset, glm::vec3 center, float radius, glm::ivec3 scale,
+			bool top, TriangleDirection triangleDirection)
+		{
+			uint32_t columns = scale.x + 1;
+			float fiStep{ 360.0f / columns };
+			float radiusStep{ radius / (scale.y + 1) };
+			uint32_t ringsOffset = verticesOffset + 1;
 
-				for (uint32_t y{ 0 }; y < scale.y + 1; ++y)
-				{
-					float internalRadius{ (y + 1) * topRadiusStep };
-					for (uint32_t x{ 0 }; x < scale.x + 1; ++x)
-					{
-						float internalFi{ glm::radians(x * fiStep) };
-						auto v2 = std::make_shared<Vertex>();
-						v2->position = glm::vec3(internalRadius * std::cos(internalFi), height, internalRadius * std::sin(internalFi)) + center;
-						vertices.push_back(v2);
-						boudingBox.extendBox(v2->position);
-					}
-				}
+			buffers.vertices[verticesOffset].position = center;
 
-				for (uint32_t i{ 0 }; i < scale.x + 1; ++i)
+			this->forEachRow(scale.y + 1, [&](uint32_t y)
+			{
+				float internalRadius{ (y + 1) * radiusStep };
+				for (uint32_t x{ 0 }; x < columns; ++x)
 				{
-					faces.push_back(this->buildFace(verticesOffset - 1, verticesOffset + i + 1, verticesOffset + (i == scale.x ? 1 : i + 2), triangleDirection));
+					float internalFi{ glm::radians(x * fiStep) };
+					buffers.vertices[ringsOffset + static_cast<size_t>(y) * columns + x].position = glm::vec3(internalRadius * std::cos(internalFi), 0.0f, internalRadius * std::sin(internalFi)) + center;
 				}
+			});
 
-				for (uint32_t y{ 0 }; y < scale.y; ++y)
+			// Row 0 is fan around center
+			auto direction = top ? this->flip(triangleDirection) : triangleDirection;
+			this->forEachRow(scale.y + 1, [&](uint32_t y)
+			{
+				if (y == 0)
 				{
-					for (uint32_t x{ 0 }; x < scale.x + 1; ++x)
-					{
-						uint32_t point = x + (y * (scale.x + 1)) + verticesOffset;
-						faces.push_back(this->buildFace(point, point + 1 + scale.x, (x == scale.x ? point + 1 : point + 2 + scale.x), triangleDirection));
-						faces.push_back(this->buildFace(point, (x == scale.x ? point + 1 : point + 2 + scale.x), (x == scale.x ? (point - scale.x) : (point + 1)), triangleDirection));
-					}
+					this->setRingFan(buffers.indices, trianglesOffset, verticesOffset, ringsOffset, columns, direction);
+					return;
 				}
-			}
-
-			return std::make_tuple(vertices, faces, boudingBox, center);
+				this->setRingBand(buffers.indices, trianglesOffset + columns + 2 * static_cast<size_t>(columns) * (y - 1), ringsOffset + (y - 1) * columns, columns, direction);
+			});
 		}
 	};
-}
\ No newline at end of file
+}
@@ -2,6 +2,10 @@
 
 #include "../../../../Scene/Resources/Model.hpp"
 
+#include <algorithm>
+#include <execution>
+#include <numeric>
+
 namespace GraphicEngine::Engines::Graphic
 {
 	enum class GeneratingPosition
@@ -15,6 +19,16 @@ namespace GraphicEngine::Engines::Graphic
 		Clockwise,
 		CounterClockwise
 	};
+
+	// Contiguous result of generator, indices are triangle list
+	template <typename Vertex>
+	struct ObjectBuffers
+	{
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+		Core::BoudingBox3D boudingBox;
+		glm::vec3 pivotPoint;
+	};
 }
 
 namespace GraphicEngine::Engines::Graphic
@@ -23,6 +37,9 @@ namespace GraphicEngine::Engines::Graphic
 	class IObjectGenerator
 	{
 	public:
+		// Vertices and indices counts are known up front, so buffers are allocated once and filled row by row in parallel
+		virtual ObjectBuffers<Vertex> getBuffers(Args... args) = 0;
+
 		virtual std::tuple<std::vector<std::shared_ptr<Vertex>>, std::vector<std::shared_ptr<Scene::Face>>, Core::BoudingBox3D, glm::vec3> getObject(Args... args) = 0;
 
 		std::shared_ptr<Scene::Mesh<Vertex>> getMesh(Args... args)
@@ -41,11 +58,67 @@ namespace GraphicEngine::Engines::Graphic
 			return std::make_shared<Scene::Model<Vertex>>(meshes, mesh->getPivotPoint(), name);
 		}
 
-		std::shared_ptr<Scene::Face> buildFace(uint32_t i1, uint32_t i2, uint32_t i3, TriangleDirection direction)
+	protected:
+		// Scene::Mesh keeps vertices and faces behind shared pointers
+		static std::tuple<std::vector<std::shared_ptr<Vertex>>, std::vector<std::shared_ptr<Scene::Face>>, Core::BoudingBox3D, glm::vec3> toObject(const ObjectBuffers<Vertex>& buffers)
+		{
+			std::vector<std::shared_ptr<Vertex>> vertices;
+			vertices.reserve(buffers.vertices.size());
+			for (const auto& vertex : buffers.vertices)
+			{
+				vertices.push_back(std::make_shared<Vertex>(vertex));
+			}
+
+			std::vector<std::shared_ptr<Scene::Face>> faces;
+			faces.reserve(buffers.indices.size() / 3);
+			for (size_t i{ 0 }; i < buffers.indices.size(); i += 3)
+			{
+				faces.push_back(std::make_shared<Scene::Face>(std::vector<uint32_t>{ buffers.indices[i], buffers.indices[i + 1], buffers.indices[i + 2] }));
+			}
+
+			return std::make_tuple(std::move(vertices), std::move(faces), buffers.boudingBox, buffers.pivotPoint);
+		}
+
+		static void setTriangle(std::vector<uint32_t>& indices, size_t triangle, uint32_t i1, uint32_t i2, uint32_t i3, TriangleDirection direction)
 		{
-			return std::make_shared<Scene::Face>(direction == TriangleDirection::Clockwise ?
-				Scene::Face({ i1, i2, i3 }) :
-				Scene::Face({ i1, i3, i2 }));
+			indices[3 * triangle] = i1;
+			indices[3 * triangle + 1] = direction == TriangleDirection::Clockwise ? i2 : i3;
+			indices[3 * triangle + 2] = direction == TriangleDirection::Clockwise ? i3 : i2;
+		}
+
+		static TriangleDirection flip(TriangleDirection direction)
+		{
+			return direction == TriangleDirection::Clockwise ? TriangleDirection::CounterClockwise : TriangleDirection::Clockwise;
+		}
+
+		// Two triangles for every column between ring and the next one, last column closes seam with first vertices of rings
+		static void setRingBand(std::vector<uint32_t>& indices, size_t triangle, uint32_t ring, uint32_t columns, TriangleDirection direction)
+		{
+			for (uint32_t x{ 0 }; x < columns; ++x)
+			{
+				uint32_t point = ring + x;
+				uint32_t next = ring + (x + 1) % columns;
+				setTriangle(indices, triangle++, point, next + columns, point + columns, direction);
+				setTriangle(indices, triangle++, point, next, next + columns, direction);
+			}
+		}
+
+		// Triangle from center to every edge of ring
+		static void setRingFan(std::vector<uint32_t>& indices, size_t triangle, uint32_t center, uint32_t ring, uint32_t columns, TriangleDirection direction)
+		{
+			for (uint32_t x{ 0 }; x < columns; ++x)
+			{
+				setTriangle(indices, triangle + x, center, ring + (x + 1) % columns, ring + x, direction);
+			}
+		}
+
+		// Rows have to write disjoint ranges of buffers
+		template <typename Func>
+		static void forEachRow(uint32_t rows, Func func)
+		{
+			std::vector<uint32_t> rowsIndices(rows);
+			std::iota(std::begin(rowsIndices), std::end(rowsIndices), 0);
+			std::for_each(std::execution::par, std::begin(rowsIndices), std::end(rowsIndices), func);
 		}
 	};
-}
\ No newline at end of file
+}
@@ -10,18 +10,35 @@ namespace GraphicEngine::Engines::Graphic
 	class PlaneGenerator : public IObjectGenerator<Vertex, glm::vec2, glm::vec2, glm::ivec2, GeneratingPosition, TriangleDirection>
 	{
 	public:
+		// Previous row of stripe has to stay in 32 entries FIFO cache while next row is inserted, 14 is the widest that fits
+		static constexpr uint32_t stripeColumns{ 14 };
+
+		static size_t getVerticesCount(glm::ivec2 scale)
+		{
+			return static_cast<size_t>(scale.x + 1) * (scale.y + 1);
+		}
+
+		static size_t getIndicesCount(glm::ivec2 scale)
+		{
+			return 6 * static_cast<size_t>(scale.x) * scale.y;
+		}
+
 		virtual std::tuple<std::vector<std::shared_ptr<Vertex>>, std::vector<std::shared_ptr<Scene::Face>>, Core::BoudingBox3D, glm::vec3> getObject(glm::vec2 beginPosition, glm::vec2 endPosition, glm::ivec2 scale,
 			GeneratingPosition generateFrom = GeneratingPosition::Corner, TriangleDirection triangleDirection = TriangleDirection::Clockwise) override
 		{
-			std::vector<std::shared_ptr<Vertex>> vertices;
-			std::vector<std::shared_ptr<Scene::Face>> faces;
+			return this->toObject(getBuffers(beginPosition, endPosition, scale, generateFrom, triangleDirection));
+		}
 
-			vertices.reserve((scale.x + 1) * (scale.y + 1));
-			faces.reserve(scale.x * scale.y * 2);
+		virtual ObjectBuffers<Vertex> getBuffers(glm::vec2 beginPosition, glm::vec2 endPosition, glm::ivec2 scale,
+			GeneratingPosition generateFrom = GeneratingPosition::Corner, TriangleDirection triangleDirection = TriangleDirection::Clockwise) override
+		{
+			ObjectBuffers<Vertex> buffers;
+			buffers.vertices.resize(getVerticesCount(scale));
+			buffers.indices.resize(getIndicesCount(scale));
 
 			auto from = beginPosition;
 			auto to = endPosition;
-			
+
 			if (generateFrom == GeneratingPosition::Center)
 			{
 				from = beginPosition - endPosition;
@@ -30,27 +47,28 @@ namespace GraphicEngine::Engines::Graphic
 
 			auto thick = std::max(scale.x, scale.y) * 0.01f;
 
-			Core::BoudingBox3D boudingBox(glm::vec3(from.x, -thick, from.y), glm::vec3(to.x, thick, to.y));
+			buffers.boudingBox = Core::BoudingBox3D(glm::vec3(from.x, -thick, from.y), glm::vec3(to.x, thick, to.y));
+			buffers.pivotPoint = buffers.boudingBox.getCenter();
 
 			glm::vec2 step(to - from);
 			step.x /= scale.x;
 			step.y /= scale.y;
 
+			uint32_t columns = scale.y + 1;
+
 			// Generate vertices
-			for (uint32_t x{ 0 }; x < scale.x + 1; ++x)
+			this->forEachRow(scale.x + 1, [&](uint32_t x)
 			{
-				for (uint32_t y{ 0 }; y < scale.y + 1; ++y)
+				for (uint32_t y{ 0 }; y < columns; ++y)
 				{
-					auto v = std::make_shared<Vertex>();
-					v->position = glm::vec3(from + step * glm::vec2(x, y), 0.0f);
-					std::swap(v->position.y, v->position.z);
-					vertices.push_back(v);
-					boudingBox.extendBox(v->position);
+					// Last row and column are placed at end exactly, accumulated steps could leave bounding box
+					glm::vec2 position(x == scale.x ? to.x : from.x + step.x * x, y == scale.y ? to.y : from.y + step.y * y);
+					buffers.vertices[static_cast<size_t>(x) * columns + y].position = glm::vec3(position.x, 0.0f, position.y);
 				}
-			}
+			});
 
 			// Generate triangles from vertices.
-			//	  
+			//
 			//     __ __ __ __ 19
 			//   3| /| /| /| /|
 			//    |/_|/_|/_|/_|
@@ -60,17 +78,26 @@ namespace GraphicEngine::Engines::Graphic
 			//    |/_|/_|/_|/_|
 			//   0   4  8  12 16
 
-			for (uint32_t x{ 0 }; x < scale.x; ++x)
+			// Triangles are emitted in stripes of cells narrow enough that previous row of stripe
+			// is still in post-transform vertex cache when next row is drawn
+			uint32_t stripes = (scale.y + stripeColumns - 1) / stripeColumns;
+			this->forEachRow(stripes, [&](uint32_t stripe)
 			{
-				for (uint32_t y{ 0 }; y < scale.y; ++y)
+				uint32_t begin = stripe * stripeColumns;
+				uint32_t end = std::min(begin + stripeColumns, static_cast<uint32_t>(scale.y));
+				size_t triangle = 2 * static_cast<size_t>(scale.x) * begin;
+				for (uint32_t x{ 0 }; x < static_cast<uint32_t>(scale.x); ++x)
 				{
-					uint32_t point = y + (x * (scale.y + 1));
-					faces.push_back(this->buildFace(point, point + 1 + scale.y, point + 2 + scale.y, triangleDirection));
-					faces.push_back(this->buildFace(point, point + 2 + scale.y, point + 1, triangleDirection));
+					for (uint32_t y{ begin }; y < end; ++y)
+					{
+						uint32_t point = y + (x * columns);
+						this->setTriangle(buffers.indices, triangle++, point, point + 1 + scale.y, point + 2 + scale.y, triangleDirection);
+						this->setTriangle(buffers.indices, triangle++, point, point + 2 + scale.y, point + 1, triangleDirection);
+					}
 				}
-			}
+			});
 
-			return std::make_tuple(vertices, faces, boudingBox, boudingBox.getCenter());
+			return buffers;
 		}
 	};
-}
\ No newline at end of file
+}
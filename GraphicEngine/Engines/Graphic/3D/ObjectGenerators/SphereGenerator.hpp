@@ -3,6 +3,7 @@
 #include "IObjectGenerator.hpp"
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
+#include <stdexcept>
 
 namespace GraphicEngine::Engines::Graphic
 {
@@ -10,71 +11,80 @@ namespace GraphicEngine::Engines::Graphic
 	class SphereGenerator : public IObjectGenerator<Vertex, glm::vec3, float, glm::ivec2, TriangleDirection>
 	{
 	public:
+		// Poles and scale.y rings of scale.x + 1 vertices
+		static size_t getVerticesCount(glm::ivec2 scale)
+		{
+			return 2 + static_cast<size_t>(scale.x + 1) * scale.y;
+		}
+
+		static size_t getIndicesCount(glm::ivec2 scale)
+		{
+			return 6 * static_cast<size_t>(scale.x + 1) * scale.y;
+		}
+
 		virtual std::tuple<std::vector<std::shared_ptr<Vertex>>, std::vector<std::shared_ptr<Scene::Face>>, Core::BoudingBox3D, glm::vec3> getObject(glm::vec3 centerPosition, float radius, glm::ivec2 scale,
 			TriangleDirection triangleDirection = TriangleDirection::Clockwise) override
 		{
-			std::vector<std::shared_ptr<Vertex>> vertices;
-			std::vector<std::shared_ptr<Scene::Face>> faces;
+			return this->toObject(getBuffers(centerPosition, radius, scale, triangleDirection));
+		}
 
-			Core::BoudingBox3D boudingBox(glm::vec3(-radius) + centerPosition, glm::vec3(radius) + centerPosition);
+		virtual ObjectBuffers<Vertex> getBuffers(glm::vec3 centerPosition, float radius, glm::ivec2 scale,
+			TriangleDirection triangleDirection = TriangleDirection::Clockwise) override
+		{
+			if (scale.y < 1)
+			{
+				throw std::invalid_argument("Sphere needs at least one ring!");
+			}
+
+			ObjectBuffers<Vertex> buffers;
+			buffers.vertices.resize(getVerticesCount(scale));
+			buffers.indices.resize(getIndicesCount(scale));
+			buffers.boudingBox = Core::BoudingBox3D(glm::vec3(-radius) + centerPosition, glm::vec3(radius) + centerPosition);
+			buffers.pivotPoint = centerPosition;
 
-			vertices.reserve(2 + ((scale.x + 1) * scale.y));
-			faces.reserve(2 * (scale.x + 1) * (scale.y + 1));
-			float fiStep = 360.0f / (scale.x + 1);
+			uint32_t columns = scale.x + 1;
+			float fiStep = 360.0f / columns;
 			float thetaStep = 180.f / (scale.y + 1);
 
-			auto v1 = std::make_shared<Vertex>();
-			v1->position = glm::vec3(centerPosition.x, centerPosition.z - radius, centerPosition.y);
-			vertices.push_back(v1);
-			boudingBox.extendBox(v1->position);
+			buffers.vertices.front().position = centerPosition - glm::vec3(0.0f, radius, 0.0f);
+			buffers.vertices.back().position = centerPosition + glm::vec3(0.0f, radius, 0.0f);
 
-			for (float theta = -180.0f + thetaStep; theta < -0.1f; theta += thetaStep)
+			this->forEachRow(scale.y, [&](uint32_t y)
 			{
-				float radTheta = glm::radians(theta);
+				float radTheta = glm::radians(-180.0f + (y + 1) * thetaStep);
 				float sinTheta = std::sin(radTheta);
 				float cosTheta = std::cos(radTheta);
-				for (float fi{ 0.0f }; fi < 359.0f; fi += fiStep)
+				for (uint32_t x{ 0 }; x < columns; ++x)
 				{
-					float radFi = glm::radians(fi);
+					float radFi = glm::radians(x * fiStep);
 					float sinFi = std::sin(radFi);
 					float cosFi = std::cos(radFi);
-					auto v3 = std::make_shared<Vertex>();
-					v3->position = glm::vec3(radius * sinTheta * cosFi, radius * cosTheta, radius * sinTheta * sinFi) + centerPosition;
-					vertices.push_back(v3);
-					boudingBox.extendBox(v3->position);
+					buffers.vertices[1 + static_cast<size_t>(y) * columns + x].position = glm::vec3(radius * sinTheta * cosFi, radius * cosTheta, radius * sinTheta * sinFi) + centerPosition;
 				}
-			}
+			});
 
-			auto v2 = std::make_shared<Vertex>();
-			v2->position = glm::vec3(centerPosition.x, centerPosition.z + radius, centerPosition.y);
-			vertices.push_back(v2);
-			boudingBox.extendBox(v2->position);
+			uint32_t last = static_cast<uint32_t>(buffers.vertices.size()) - 1;
+			uint32_t offset = last - columns;
 
-			for (uint32_t i{ 0 }; i < scale.x + 1; ++i)
+			// Row 0 is bottom fan, rows between rings follow and last row is top fan
+			this->forEachRow(scale.y + 1, [&](uint32_t y)
 			{
-				faces.push_back(this->buildFace(0, i == scale.x ? 1 : i + 2, i + 1, triangleDirection));
-			}
-
-			for (uint32_t y{ 0 }; y < scale.y - 1; ++y)
-			{
-				for (uint32_t x{ 0 }; x < scale.x + 1; ++x)
+				size_t triangle = y == 0 ? 0 : columns + 2 * static_cast<size_t>(columns) * (y - 1);
+				if (y == 0)
 				{
-					uint32_t point = x + (y * (scale.x + 1)) + 1;
-					faces.push_back(this->buildFace(point, (x == scale.x ? point + 1 : point + 2 + scale.x), point + 1 + scale.x, triangleDirection));
-					faces.push_back(this->buildFace(point, (x == scale.x ? (point - scale.x) : (point + 1)), (x == scale.x ? point + 1 : point + 2 + scale.x), triangleDirection));
+					this->setRingFan(buffers.indices, triangle, 0, 1, columns, triangleDirection);
 				}
-			}
-
-			uint32_t last = vertices.size() - 1;
-			uint32_t offset = last - (scale.x + 1);
-			for (uint32_t i{ offset }; i < last - 1; ++i)
-			{
-				faces.push_back(this->buildFace(i, i + 1, last, triangleDirection));
-			}
-
-			faces.push_back(this->buildFace(last -1, offset, last, triangleDirection));
+				else if (y == static_cast<uint32_t>(scale.y))
+				{
+					this->setRingFan(buffers.indices, triangle, last, offset, columns, this->flip(triangleDirection));
+				}
+				else
+				{
+					this->setRingBand(buffers.indices, triangle, 1 + (y - 1) * columns, columns, triangleDirection);
+				}
+			});
 
-			return std::make_tuple(vertices, faces, boudingBox, centerPosition);
+			return buffers;
 		}
 	};
 }
@@ -1,8 +1,8 @@
 #pragma once
 
+#include "../3D/GrassField.hpp"
 #include "../Shaders/Models/CameraMatrices.hpp"
 #include "../Shaders/Models/GrassParameters.hpp"
-#include "../Shaders/Models/ModelMatrices.hpp"
 #include "../Shaders/Models/GrassMaterial.hpp"
 #include "GraphicPipeline.hpp"
 
@@ -13,8 +13,10 @@ namespace GraphicEngine::Engines::Graphic
 	{
 		using vertex_type = VertexType;
 		std::shared_ptr<VertexBuffer<VertexType>> vertexBuffer;
-		Shaders::ModelMartices modelDescriptor;
 		std::shared_ptr<Scene::Mesh<VertexType>> mesh;
+		// Surface of grass field scattered over mesh with this model matrix
+		uint32_t grassSurface;
+		glm::mat4 modelMatrix;
 	};
 
 	template <template <typename> typename VertexBuffer, template <typename> typename UniformBuffer, template <typename> typename UniformBufferDynamic, typename... Args>
@@ -29,16 +31,79 @@ namespace GraphicEngine::Engines::Graphic
 			auto vertexBufferCollection = std::make_shared<VGrassVertexBufferCollection<VertexType>>();
 			vertexBufferCollection->vertexBuffer = vertexBuffer;
 			vertexBufferCollection->mesh = mesh;
+
+			// Blades are scattered in world space, mesh vertex buffer is not used for drawing grass
+			auto [positions, normals] = getSurfaceGeometry(mesh);
+			vertexBufferCollection->modelMatrix = mesh->getModelMatrix();
+			vertexBufferCollection->grassSurface = m_grassField->addSurface(positions, normals, mesh->getGeometryIndices(), vertexBufferCollection->modelMatrix);
+			m_grassFieldOutdated = true;
+
 			return vertexBufferCollection;
 		}
 
+		template <typename VertexType>
+		void eraseVertexBuffer(std::shared_ptr<Scene::Mesh<VertexType>> mesh)
+		{
+			eraseVertexBufferIf<VertexType>([&](const auto& vertexBufferCollection) { return vertexBufferCollection->mesh == mesh; });
+		}
+
+		template <typename VertexType>
+		void eraseVertexBuffer(std::shared_ptr<VertexBuffer<VertexType>> vertexBuffer)
+		{
+			eraseVertexBufferIf<VertexType>([&](const auto& vertexBufferCollection) { return vertexBufferCollection->vertexBuffer == vertexBuffer; });
+		}
+
 		virtual void draw(Args... args) = 0;
 
+	protected:
+		// Grass of meshes whose model matrix changed since it was scattered is scattered again
+		void updateGrassSurfaces()
+		{
+			this->m_vertexBufferCollection->forEachEntity([&](auto vertexBufferCollection)
+			{
+				auto modelMatrix = vertexBufferCollection->mesh->getModelMatrix();
+				if (modelMatrix == vertexBufferCollection->modelMatrix)
+					return;
+
+				// Vertices are read again, because applied transformation moves them and resets model matrix
+				auto [positions, normals] = getSurfaceGeometry(vertexBufferCollection->mesh);
+				m_grassField->updateSurface(vertexBufferCollection->grassSurface, positions, normals, vertexBufferCollection->mesh->getGeometryIndices(), modelMatrix);
+				vertexBufferCollection->modelMatrix = modelMatrix;
+				m_grassFieldOutdated = true;
+			});
+		}
+
+	private:
+		template <typename VertexType>
+		static std::pair<std::vector<glm::vec3>, std::vector<glm::vec3>> getSurfaceGeometry(std::shared_ptr<Scene::Mesh<VertexType>> mesh)
+		{
+			std::vector<glm::vec3> positions;
+			std::vector<glm::vec3> normals;
+			for (const auto& vertex : mesh->getVertices())
+			{
+				positions.push_back(vertex.position);
+				if constexpr (Core::Utils::has_normal_member<VertexType>::value)
+					normals.push_back(vertex.normal);
+			}
+			return { positions, normals };
+		}
+
+		template <typename VertexType, typename Predicate>
+		void eraseVertexBufferIf(Predicate predicate)
+		{
+			auto it = this->m_vertexBufferCollection->template findIf<VertexType>(predicate);
+			m_grassField->removeSurface((*it)->grassSurface);
+			m_grassFieldOutdated = true;
+			this->m_vertexBufferCollection->template eraseEntity<VertexType>(it);
+		}
+
 	protected:
 		std::shared_ptr<UniformBuffer<Engines::Graphic::Shaders::CameraMatrices>> m_cameraUniformBuffer;
 		std::shared_ptr<Services::CameraControllerManager> m_cameraControllerManager;
-		std::shared_ptr<UniformBufferDynamic<Shaders::ModelMartices>> m_modelDescriptorUniformBuffer;
 		std::shared_ptr<UniformBufferDynamic<Shaders::GrassParameters>> m_grassParametersUniformBuffer;
 		std::shared_ptr<UniformBufferDynamic<Shaders::GrassMaterial>> m_materialUniformBuffer;
+
+		std::shared_ptr<GrassField> m_grassField;
+		bool m_grassFieldOutdated{ false };
 	};
 }
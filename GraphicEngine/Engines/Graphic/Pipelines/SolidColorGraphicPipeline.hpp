@@ -18,6 +18,13 @@ namespace GraphicEngine::Engines::Graphic
 		std::shared_ptr<VertexBuffer<VertexType>> vertexBuffer;
 		Shaders::SolidColorModelDescriptor modelDescriptor;
 		std::shared_ptr<Scene::Mesh<VertexType>> mesh;
+		// Slot of per object data of renderers which index objects in one buffer
+		uint32_t objectIndex{ 0 };
+		// First draw of range of culling draws of all levels of detail, used by renderers which cull draws on GPU
+		uint32_t cullingRange{ 0 };
+		// Model matrix and color per object data was written with, so it is written again only when they change
+		glm::mat4 meshModelMatrix{ 1.0f };
+		glm::vec4 solidColor{ 0.0f };
 	};
 
 	template <template <typename> typename VertexBuffer, template <typename> typename UniformBuffer, template <typename> typename UniformBufferDynamic, typename... Args>
@@ -13,6 +13,8 @@ namespace GraphicEngine::Engines::Graphic
 		std::shared_ptr<VertexBuffer<VertexType>> vertexBuffer;
 		Shaders::WireframeModelDescriptor modelDescriptor;
 		std::shared_ptr<Scene::Mesh<VertexType>> mesh;
+		// Slot of per object data of renderers which index objects in one buffer
+		uint32_t objectIndex{ 0 };
 	};
 
 	template <template <typename> typename VertexBuffer, template <typename> typename UniformBuffer, template <typename> typename UniformBufferDynamic, typename... Args>
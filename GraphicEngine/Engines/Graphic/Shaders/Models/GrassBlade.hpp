@@ -0,0 +1,35 @@
+#pragma once
+
+#include "../../../../Common/Vertex.hpp"
+
+#include <glm/vec4.hpp>
+
+#include <array>
+#include <cstddef>
+#include <stdint.h>
+
+namespace GraphicEngine::Engines::Graphic::Shaders
+{
+	// Per instance data of a single grass blade, the blade shape is expanded in vertex shader
+	struct GrassBlade
+	{
+		GrassBlade() = default;
+		GrassBlade(glm::vec4 positionRotation, glm::vec4 normalRandom) :
+			positionRotation{ positionRotation }, normalRandom{ normalRandom } {}
+
+		// xyz - root position in world space, w - facing angle in radians
+		glm::vec4 positionRotation{ 0.0f };
+		// xyz - ground normal, w - random value in [0, 1) used for blade variation
+		glm::vec4 normalRandom{ 0.0f };
+
+		static constexpr std::array<Common::VertexAttribute, 2> getSizeAndOffsets()
+		{
+			return { Common::VertexAttribute(4, offsetof(GrassBlade, positionRotation)), Common::VertexAttribute(4, offsetof(GrassBlade, normalRandom)) };
+		}
+
+		static constexpr uint32_t getStride()
+		{
+			return sizeof(GrassBlade);
+		}
+	};
+}
@@ -0,0 +1,19 @@
+#include "GrassParameters.hpp"
+
+#include <algorithm>
+
+#undef min
+#undef max
+
+GraphicEngine::Engines::Graphic::Shaders::GrassParameters::GrassParameters(std::shared_ptr<Core::Configuration> cfg)
+{
+	thick = cfg->getProperty<float>("width");
+	height = cfg->getProperty<float>("height");
+	stiffness = std::clamp(cfg->getProperty<float>("stiffness"), 0.0f, 1.0f);
+	density = std::max(cfg->getProperty<float>("density"), 0.0f);
+	patchSize = std::max(cfg->getProperty<float>("patch size"), 0.01f);
+	lodNear = std::max(cfg->getProperty<float>("lod near"), 0.0f);
+	lodFar = std::max(cfg->getProperty<float>("lod far"), lodNear);
+	minDensity = std::clamp(cfg->getProperty<float>("min density"), 0.0f, 1.0f);
+	segments = std::max(cfg->getProperty<uint32_t>("segments"), 1u);
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "../../../../Core/Configuration.hpp"
+#include <stdint.h>
+
 namespace GraphicEngine::Engines::Graphic::Shaders
 {
 	struct GrassParameters
@@ -7,9 +10,20 @@ namespace GraphicEngine::Engines::Graphic::Shaders
 		GrassParameters() = default;
 		GrassParameters(float thick, float height, float stiffness) :
 			thick{ thick }, height{ height }, stiffness{ stiffness } {}
+		GrassParameters(std::shared_ptr<Core::Configuration> cfg);
             
-		float thick;
-        float height;
-        float stiffness;
+		float thick{ 0.005f };
+        float height{ 0.2f };
+        float stiffness{ 0.5f };
+		// Blades per square unit of ground
+		float density{ 400.0f };
+		// Edge length of square ground patch used for culling and LOD selection
+		float patchSize{ 2.0f };
+		// Full blade density and segments count up to lodNear, no grass beyond lodFar
+		float lodNear{ 4.0f };
+		float lodFar{ 40.0f };
+		// Fraction of blades still drawn at lodFar
+		float minDensity{ 0.1f };
+		uint32_t segments{ 4 };
 	};
-}
\ No newline at end of file
+}
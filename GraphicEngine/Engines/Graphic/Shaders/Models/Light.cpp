@@ -1,5 +1,27 @@
 #include "Light.hpp"
 
+#include <algorithm>
+#include <limits>
+
+#undef max
+
+static float calculateAttenuationRange(float constant, float linear, float quadric, const GraphicEngine::Engines::Graphic::Shaders::LightColor& color, float threshold)
+{
+	float intensity = std::max({ color.diffuse.r, color.diffuse.g, color.diffuse.b, color.specular.r, color.specular.g, color.specular.b });
+	// Solve intensity / (constant + linear * d + quadric * d^2) = threshold
+	float c = constant - intensity / threshold;
+	if (c >= 0.0f)
+		return 0.0f;
+
+	if (quadric > 0.0f)
+		return (-linear + std::sqrt(linear * linear - 4.0f * quadric * c)) / (2.0f * quadric);
+
+	if (linear > 0.0f)
+		return -c / linear;
+
+	return std::numeric_limits<float>::max();
+}
+
 GraphicEngine::Engines::Graphic::Shaders::LightColor::LightColor(std::shared_ptr<Core::Configuration> cfg)
 {
 	diffuse = glm::vec4(Core::Utils::Converter::fromArrayToObject<glm::vec3, std::vector<float>, 3>(cfg->getProperty<std::vector<float>>("diffuse")), 1.0f);
@@ -53,6 +75,11 @@ GraphicEngine::Engines::Graphic::Shaders::PointLight::PointLight(std::shared_ptr
 GraphicEngine::Engines::Graphic::Shaders::PointLight::PointLight(glm::vec4 position, float constant, float linear, float quadric, LightColor color) :
 	position{ position }, constant{ constant }, linear{ linear }, quadric{ quadric }, color{ color } {}
 
+float GraphicEngine::Engines::Graphic::Shaders::PointLight::getRange(float threshold) const
+{
+	return calculateAttenuationRange(constant, linear, quadric, color, threshold);
+}
+
 std::array<GraphicEngine::Engines::Graphic::Shaders::LightSpaceMatrix, 6> GraphicEngine::Engines::Graphic::Shaders::PointLight::getLightSpaceMatrices()
 {
 	std::array<Engines::Graphic::Shaders::LightSpaceMatrix, 6> lightSpaceMatrices;
@@ -98,3 +125,8 @@ void GraphicEngine::Engines::Graphic::Shaders::SpotLight::calculateLigthSpace()
 	glm::mat4 lightView = glm::lookAt(glm::vec3(position), glm::vec3(position) + glm::normalize(glm::vec3(direction)), glm::vec3(0.0f, 1.0f, 0.0f));
 	lightSpace = lightProjection * lightView;
 }
+
+float GraphicEngine::Engines::Graphic::Shaders::SpotLight::getRange(float threshold) const
+{
+	return calculateAttenuationRange(constant, linear, quadric, color, threshold);
+}
@@ -48,6 +48,8 @@ namespace GraphicEngine::Engines::Graphic::Shaders
 		LightColor color;
 
 		std::array<LightSpaceMatrix, 6> getLightSpaceMatrices();
+		// Distance after which light contribution falls below threshold
+		float getRange(float threshold = 1.0f / 256.0f) const;
 	};
 
 	struct SpotLight
@@ -57,6 +59,7 @@ namespace GraphicEngine::Engines::Graphic::Shaders
 		SpotLight(glm::vec4 position, glm::vec4 direction, float innerCutOff, float outterCutOff, float constant, float linear, float quadric, LightColor color);
 
 		void calculateLigthSpace();
+		float getRange(float threshold = 1.0f / 256.0f) const;
 
 		alignas(16) glm::mat4 lightSpace;
 		alignas(16) glm::vec4 position{ 0.0f, 8.0f, 8.0f, 1.0f };
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <stdint.h>
+
+namespace GraphicEngine::Engines::Graphic::Shaders
+{
+	struct LightClusterParameters
+	{
+		alignas(16) glm::uvec4 gridSize{ 16, 9, 24, 0 };
+		glm::vec2 screenSize{ 1920.0f, 1080.0f };
+		float sliceScale{ 0.0f };
+		float sliceBias{ 0.0f };
+		float clusterNear{ 0.1f };
+	};
+
+	// Point lights of a cluster start at offset and spot lights follow them in the light index list
+	struct alignas(16) LightCluster
+	{
+		uint32_t offset{ 0 };
+		uint32_t pointLightCount{ 0 };
+		uint32_t spotLightCount{ 0 };
+		uint32_t padding{ 0 };
+	};
+}
@@ -11,18 +11,19 @@ Application::Application(int argc, char** argv)
 	// TODO - parse argc and argv to get parameters
 }
 
-void Application::exec()
+int Application::exec()
 {
 	try
 	{
 		GraphicEngine::Core::Configuration cfg;
 
 		std::string engineType = cfg.getProperty<std::string>("engine");
+		std::string windowType = cfg.getProperty<std::string>("window:type");
 
-		auto engine = GraphicEngine::Engine::createEngine(engineType, "glfw");
+		auto engine = GraphicEngine::Engine::createEngine(engineType, windowType);
 
 		engine->initialize();
-		engine->run();
+		return engine->run();
 	}
 
 	catch (std::runtime_error& err)
@@ -36,4 +37,5 @@ void Application::exec()
 		GraphicEngine::Core::Logger<Application> logger;
 		logger.warn(__FILE__, __LINE__, __FUNCTION__, ex.what());
 	}
+	return 1;
 }
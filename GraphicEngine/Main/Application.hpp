@@ -5,5 +5,5 @@ class Application
 public:
 	Application(int argc, char** argv);
 
-	void exec();
+	int exec();
 };
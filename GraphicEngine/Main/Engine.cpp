@@ -2,8 +2,16 @@
 
 #include "../Platform/Glfw/OpenGL/GlfwOpenGLInjector.hpp"
 #include "../Platform/Glfw/Vulkan/GlfwVulkanInjector.hpp"
+#include "../Platform/Headless/OpenGL/HeadlessOpenGLInjector.hpp"
+#include "../Platform/Headless/Vulkan/HeadlessVulkanInjector.hpp"
 
-GraphicEngine::Engine::Engine(std::shared_ptr<Common::WindowKeyboardMouse> window,
+#include <opencv2\opencv.hpp>
+
+#include <cstdio>
+#include <filesystem>
+
+GraphicEngine::Engine::Engine(std::shared_ptr<Core::Configuration> cfg,
+	std::shared_ptr<Common::WindowKeyboardMouse> window,
 	std::shared_ptr<RenderingEngine> renderingEngine,
 	std::shared_ptr<Core::Inputs::KeyboardEventProxy> keyboard,
 	std::shared_ptr<Core::Inputs::MouseEventProxy> mouse,
@@ -11,7 +19,10 @@ GraphicEngine::Engine::Engine(std::shared_ptr<Common::WindowKeyboardMouse> windo
 	std::shared_ptr<Common::UI> ui,
 	std::shared_ptr<GUI::SettingWindow> settingWindow,
 	std::shared_ptr<Core::Timer> timer,
+	std::shared_ptr<Core::Profiler> profiler,
+	std::shared_ptr<Services::BenchmarkManager> benchmarkManager,
 	std::unique_ptr<Core::Logger<Engine>> logger) :
+	m_cfg(cfg),
 	m_window(window),
 	m_renderingEngine(renderingEngine),
 	m_keyboard(keyboard),
@@ -20,6 +31,8 @@ GraphicEngine::Engine::Engine(std::shared_ptr<Common::WindowKeyboardMouse> windo
 	m_settingWindow{ settingWindow },
 	m_eventManager(eventManager),
 	m_timer(timer),
+	m_profiler(profiler),
+	m_benchmarkManager(benchmarkManager),
 	m_logger(std::move(logger))
 {
 }
@@ -27,6 +40,23 @@ GraphicEngine::Engine::Engine(std::shared_ptr<Common::WindowKeyboardMouse> windo
 void GraphicEngine::Engine::initialize()
 {
 	m_logger->debug(__FILE__, __LINE__, __FUNCTION__, "Initialize Engine");
+	m_headless = m_cfg->getProperty<std::string>("window:type") == "headless";
+	if (m_headless)
+	{
+		m_timer->setFixedInterval(m_cfg->getProperty<double>("headless:timestep"));
+		m_outputPath = m_cfg->getProperty<std::string>("headless:output path");
+		// Writing frames would be measured as part of benchmark frames
+		if (m_benchmarkManager->isEnabled())
+		{
+			m_outputPath.clear();
+		}
+		if (!m_outputPath.empty())
+		{
+			std::filesystem::create_directories(m_outputPath);
+			m_renderingEngine->enableFrameCapture();
+		}
+	}
+
 	m_window->init();
 
 	m_keyboard->onKeyDown([&](Core::Inputs::KeyboardKey key)
@@ -51,20 +81,54 @@ void GraphicEngine::Engine::initialize()
 	m_ui->initialize();
 }
 
-void GraphicEngine::Engine::run()
+int GraphicEngine::Engine::run()
 {
 	m_logger->debug(__FILE__, __LINE__, __FUNCTION__, "Run Engine");
 	m_timer->start();
-	while (!m_window->windowShouldBeClosed() && !shutdown)
+	uint32_t frameIndex{ 0 };
+	while (shouldRun())
 	{
-		m_renderingEngine->drawFrame();
-		m_window->swapBuffer();
-		m_timer->updateTime();
-		m_window->poolEvents();
-		m_eventManager->call();
+		m_benchmarkManager->beginFrame();
+		PROFILE_BEGIN_FRAME(m_profiler);
+		{
+			PROFILE_CPU_ZONE(m_profiler, "Draw frame");
+			m_renderingEngine->drawFrame();
+		}
+		if (m_headless && !m_outputPath.empty())
+		{
+			PROFILE_CPU_ZONE(m_profiler, "Save frame");
+			saveFrame(frameIndex);
+		}
+		++frameIndex;
+		{
+			PROFILE_CPU_ZONE(m_profiler, "Swap buffers");
+			m_window->swapBuffer();
+		}
+		{
+			PROFILE_CPU_ZONE(m_profiler, "Update");
+			m_timer->updateTime();
+			m_window->poolEvents();
+			m_eventManager->call();
+		}
+		PROFILE_END_FRAME(m_profiler);
+		m_benchmarkManager->endFrame();
 	}
 	m_renderingEngine->cleanup();
 	m_ui->shutdown();
+
+	return m_benchmarkManager->hasRegressions() ? 1 : 0;
+}
+
+bool GraphicEngine::Engine::shouldRun()
+{
+	if (shutdown)
+		return false;
+
+	// Headless window closes after configured frames count, benchmark decides by itself when all paths were flown
+	if (m_benchmarkManager->isEnabled())
+		return !m_benchmarkManager->isFinished() && (m_headless || !m_window->windowShouldBeClosed());
+
+	return !m_window->windowShouldBeClosed();
 }
 
 std::unique_ptr<GraphicEngine::Engine> GraphicEngine::Engine::createEngine(std::string driverType, std::string windowType)
@@ -74,6 +138,13 @@ std::unique_ptr<GraphicEngine::Engine> GraphicEngine::Engine::createEngine(std::
 		return injector.template create<std::unique_ptr<GraphicEngine::Engine>>();
 	};
 
+	if (windowType == "headless")
+	{
+		return driverType == "vulkan" ?
+			createEngine(GraphicEngine::Headless::injectHeadlessVulkanResources()) :
+			createEngine(GraphicEngine::Headless::injectHeadlessOpenGlResources());
+	}
+
 	auto engine = driverType == "vulkan" ?
 		createEngine(GraphicEngine::GLFW::injectGlfwVulkanResources()) :
 		createEngine(GraphicEngine::GLFW::injectGlfwOpenGlResources());
@@ -81,6 +152,24 @@ std::unique_ptr<GraphicEngine::Engine> GraphicEngine::Engine::createEngine(std::
 	return engine;
 }
 
+void GraphicEngine::Engine::saveFrame(uint32_t frameIndex)
+{
+	auto frame = m_renderingEngine->captureFrame();
+	if (frame.pixels.empty())
+		return;
+
+	cv::Mat image(static_cast<int>(frame.height), static_cast<int>(frame.width), CV_8UC4, frame.pixels.data());
+	cv::cvtColor(image, image, cv::COLOR_RGBA2BGRA);
+
+	char fileName[32];
+	std::snprintf(fileName, sizeof(fileName), "frame_%05u.png", frameIndex);
+	auto path = (std::filesystem::path(m_outputPath) / fileName).string();
+	if (!cv::imwrite(path, image))
+	{
+		throw std::runtime_error("Failed to write frame " + path);
+	}
+}
+
 GraphicEngine::Engine::~Engine()
 {
 	m_logger->debug(__FILE__, __LINE__, __FUNCTION__, "Shutdown Engine");
@@ -8,7 +8,9 @@
 #include "../Core/Input/Keyboard/KeyboardEventProxy.hpp"
 #include "../Core/Input/Mouse/MouseEventProxy.hpp"
 #include "../Core/Logger.hpp"
+#include "../Core/Profiler.hpp"
 #include "../Core/Timer.hpp"
+#include "../Services/BenchmarkManager.hpp"
 #include "../Services/CameraControllerManager.hpp"
 #include "../Common/UI.hpp"
 #include "../UI/ImGui/Components/SettingsWindow.hpp"
@@ -22,7 +24,8 @@ namespace GraphicEngine
 	{
 	public:
 
-		Engine(std::shared_ptr<Common::WindowKeyboardMouse> window,
+		Engine(std::shared_ptr<Core::Configuration> cfg,
+			std::shared_ptr<Common::WindowKeyboardMouse> window,
 			std::shared_ptr<RenderingEngine> renderingEngine,
 			std::shared_ptr<Core::Inputs::KeyboardEventProxy> keyboard,
 			std::shared_ptr<Core::Inputs::MouseEventProxy> mouse,
@@ -30,16 +33,23 @@ namespace GraphicEngine
 			std::shared_ptr<Common::UI> ui,
 			std::shared_ptr<GUI::SettingWindow> settingWindow,
 			std::shared_ptr<Core::Timer> timer,
+			std::shared_ptr<Core::Profiler> profiler,
+			std::shared_ptr<Services::BenchmarkManager> benchmarkManager,
 			std::unique_ptr<Core::Logger<Engine>> logger);
 
 		void initialize();
-		void run();
+		// Returns exit code, benchmark run which found regressions fails
+		int run();
 
 		static std::unique_ptr<Engine> createEngine(std::string driverType, std::string windowType);
 
 		~Engine();
 	protected:
+		bool shouldRun();
+		void saveFrame(uint32_t frameIndex);
+
 	private:
+		std::shared_ptr<Core::Configuration> m_cfg;
 		std::shared_ptr<Common::WindowKeyboardMouse> m_window;
 		std::shared_ptr<RenderingEngine> m_renderingEngine;
 		std::shared_ptr<Core::Inputs::KeyboardEventProxy> m_keyboard;
@@ -48,8 +58,14 @@ namespace GraphicEngine
 		std::shared_ptr<Common::UI> m_ui;
 		std::shared_ptr<GUI::SettingWindow> m_settingWindow;
 		std::shared_ptr<Core::Timer> m_timer;
+		std::shared_ptr<Core::Profiler> m_profiler;
+		std::shared_ptr<Services::BenchmarkManager> m_benchmarkManager;
 		std::unique_ptr<Core::Logger<Engine>> m_logger;
 
 		bool shutdown = false;
+
+		// Headless mode renders fixed number of frames with fixed time step and writes them to output path
+		bool m_headless{ false };
+		std::string m_outputPath;
 	};
 }
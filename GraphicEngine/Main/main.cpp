@@ -3,6 +3,5 @@
 int main()
 {
 	Application app(0, nullptr);
-	app.exec();
-	return 0;
+	return app.exec();
 }
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "HeadlessWindow.hpp"
+#include "../../UI/ImGui/ImGuiImpl.hpp"
+
+std::vector<GraphicEngine::Core::Inputs::KeyboardKey> GraphicEngine::Headless::HeadlessWindow::getPressedKeys()
+{
+	return {};
+}
+
+std::vector<GraphicEngine::Core::Inputs::MouseButton> GraphicEngine::Headless::HeadlessWindow::getPressedButtons()
+{
+	return {};
+}
+
+void GraphicEngine::Headless::HeadlessWindow::setCursorPosition(const glm::vec2& pos)
+{
+	m_cursorPosition = pos;
+}
+
+glm::vec2 GraphicEngine::Headless::HeadlessWindow::getCursorPosition()
+{
+	return m_cursorPosition;
+}
+
+glm::vec2 GraphicEngine::Headless::HeadlessWindow::getScrollValue()
+{
+	return glm::vec2();
+}
+
+void GraphicEngine::Headless::HeadlessWindow::swapBuffer()
+{
+	++m_renderedFramesCount;
+}
+
+void GraphicEngine::Headless::HeadlessWindow::initialize()
+{
+	m_framesCount = Window::m_cfg->getProperty<uint32_t>("headless:frames");
+	createContext();
+	m_ui->addWidow(std::make_shared<GUI::ImGuiImpl::HeadlessEngineBackend>(static_cast<float>(m_width), static_cast<float>(m_height), Window::m_cfg->getProperty<float>("headless:timestep")));
+}
+
+void GraphicEngine::Headless::HeadlessWindow::poolEvents()
+{
+}
+
+bool GraphicEngine::Headless::HeadlessWindow::windowShouldBeClosed()
+{
+	return m_renderedFramesCount >= m_framesCount;
+}
+
+std::pair<uint32_t, uint32_t> GraphicEngine::Headless::HeadlessWindow::getFrameBufferSize()
+{
+	return std::pair<uint32_t, uint32_t>(static_cast<uint32_t>(m_width), static_cast<uint32_t>(m_height));
+}
+
+uint32_t GraphicEngine::Headless::HeadlessWindow::getRenderedFramesCount() const
+{
+	return m_renderedFramesCount;
+}
+
+void GraphicEngine::Headless::HeadlessWindow::createContext()
+{
+}
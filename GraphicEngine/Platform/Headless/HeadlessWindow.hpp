@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../../Common/WindowKeyboardMouse.hpp"
+#include "../../Common/UI.hpp"
+
+#include <memory>
+
+namespace GraphicEngine::Headless
+{
+	// Window without display, reports fixed size, has no input and asks to be closed after configured number of frames
+	class HeadlessWindow : public Common::WindowKeyboardMouse
+	{
+	public:
+		HeadlessWindow(std::shared_ptr<Core::Configuration> cfg, std::shared_ptr<Common::UI> ui) :WindowKeyboardMouse(cfg), m_ui{ ui } {}
+
+		//From Keyboard interface
+		std::vector<Core::Inputs::KeyboardKey> getPressedKeys() override;
+
+		// From Mouse Interface
+		std::vector<Core::Inputs::MouseButton> getPressedButtons() override;
+
+		void setCursorPosition(const glm::vec2& pos) override;
+
+		glm::vec2 getCursorPosition() override;
+
+		glm::vec2 getScrollValue() override;
+
+		// Inherited via Window
+		virtual void swapBuffer() override;
+		virtual void initialize() override;
+
+		virtual void poolEvents() override;
+
+		virtual bool windowShouldBeClosed() override;
+
+		virtual std::pair<uint32_t, uint32_t> getFrameBufferSize() override;
+
+		uint32_t getRenderedFramesCount() const;
+
+		virtual ~HeadlessWindow() = default;
+
+	protected:
+		// Creates rendering context and offscreen target for API which needs one
+		virtual void createContext();
+
+	protected:
+		std::shared_ptr<Common::UI> m_ui;
+
+		uint32_t m_framesCount{ 0 };
+		uint32_t m_renderedFramesCount{ 0 };
+	};
+}
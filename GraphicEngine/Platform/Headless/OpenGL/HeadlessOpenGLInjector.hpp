@@ -0,0 +1,25 @@
+#pragma once
+#define BOOST_DI_CFG_DIAGNOSTICS_LEVEL 2
+#define __has_builtin(...) 1
+#define BOOST_DI_CFG_CTOR_LIMIT_SIZE 20
+#include <boost/di.hpp>
+
+#include "../../../Drivers/OpenGL/OpenGLRenderingEngine.hpp"
+#include "HeadlessOpenGLWindow.hpp"
+
+namespace di = boost::di;
+
+namespace GraphicEngine::Headless
+{
+	auto injectHeadlessOpenGlResources()
+	{
+		return di::make_injector
+		(
+			di::bind<GraphicEngine::Common::WindowKeyboardMouse, GraphicEngine::Headless::HeadlessWindow>.to<GraphicEngine::Headless::HeadlessOpenGLWindow>().in(di::singleton),
+			di::bind<GraphicEngine::RenderingEngine>.to<GraphicEngine::OpenGL::OpenGLRenderingEngine>().in(di::unique),
+			di::bind<GraphicEngine::Common::UI>.to<GraphicEngine::GUI::ImGuiImpl>().in(di::singleton),
+			di::bind<GraphicEngine::Core::EventManager>.in(di::singleton),
+			di::bind<GraphicEngine::Services::WindManager>.in(di::singleton)
+		);
+	}
+}
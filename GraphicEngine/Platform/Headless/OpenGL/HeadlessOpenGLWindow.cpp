@@ -0,0 +1,127 @@
+#include "HeadlessOpenGLWindow.hpp"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <GLFW/glfw3.h>
+#else
+#include <EGL/eglext.h>
+#endif
+
+GraphicEngine::Headless::HeadlessOpenGLWindow::HeadlessOpenGLWindow(std::shared_ptr<Core::Configuration> cfg, std::shared_ptr<Common::UI> ui) :
+	HeadlessWindow{ cfg, ui }
+{
+}
+
+GraphicEngine::Headless::HeadlessOpenGLWindow::~HeadlessOpenGLWindow()
+{
+	if (m_framebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_framebuffer);
+		glDeleteRenderbuffers(1, &m_colorRenderbuffer);
+		glDeleteRenderbuffers(1, &m_depthRenderbuffer);
+	}
+
+#ifdef _WIN32
+	if (m_hiddenWindow != nullptr)
+	{
+		glfwDestroyWindow(m_hiddenWindow);
+		glfwTerminate();
+	}
+#else
+	if (m_display != EGL_NO_DISPLAY)
+	{
+		eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		if (m_context != EGL_NO_CONTEXT)
+			eglDestroyContext(m_display, m_context);
+		eglTerminate(m_display);
+	}
+#endif
+}
+
+void GraphicEngine::Headless::HeadlessOpenGLWindow::createContext()
+{
+#ifdef _WIN32
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+	m_hiddenWindow = glfwCreateWindow(static_cast<int>(m_width), static_cast<int>(m_height), m_title.c_str(), nullptr, nullptr);
+	if (m_hiddenWindow == nullptr)
+		throw std::runtime_error("Failed to create hidden GLFW window!");
+
+	glfwMakeContextCurrent(m_hiddenWindow);
+#else
+	// Surfaceless platform does not need any display server, default display is used when extension is missing
+	auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+	if (getPlatformDisplay != nullptr)
+		m_display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+	if (m_display == EGL_NO_DISPLAY)
+		m_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+	EGLint major{ 0 }, minor{ 0 };
+	if (m_display == EGL_NO_DISPLAY || !eglInitialize(m_display, &major, &minor))
+		throw std::runtime_error("Failed to initialize EGL display!");
+
+	if (!eglBindAPI(EGL_OPENGL_API))
+		throw std::runtime_error("EGL does not support desktop OpenGL!");
+
+	const EGLint configAttributes[] = {
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8,
+		EGL_GREEN_SIZE, 8,
+		EGL_BLUE_SIZE, 8,
+		EGL_ALPHA_SIZE, 8,
+		EGL_DEPTH_SIZE, 24,
+		EGL_NONE
+	};
+	EGLConfig config{ nullptr };
+	EGLint configsCount{ 0 };
+	eglChooseConfig(m_display, configAttributes, &config, 1, &configsCount);
+
+	const EGLint contextAttributes[] = {
+		EGL_CONTEXT_MAJOR_VERSION, 4,
+		EGL_CONTEXT_MINOR_VERSION, 5,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE
+	};
+	m_context = eglCreateContext(m_display, configsCount > 0 ? config : EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttributes);
+	if (m_context == EGL_NO_CONTEXT)
+		throw std::runtime_error("Failed to create EGL OpenGL 4.5 context!");
+
+	if (!eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_context))
+		throw std::runtime_error("Failed to make EGL context current!");
+#endif
+
+	glewExperimental = GL_TRUE;
+	if (glewInit() != GLEW_OK)
+		throw std::runtime_error("Failed to initialize GLEW!");
+
+	createFramebuffer();
+}
+
+void GraphicEngine::Headless::HeadlessOpenGLWindow::createFramebuffer()
+{
+	GLsizei width = static_cast<GLsizei>(m_width);
+	GLsizei height = static_cast<GLsizei>(m_height);
+
+	glGenRenderbuffers(1, &m_colorRenderbuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_colorRenderbuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+	glGenRenderbuffers(1, &m_depthRenderbuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_depthRenderbuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &m_framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorRenderbuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthRenderbuffer);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		throw std::runtime_error("Headless framebuffer is not complete!");
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../HeadlessWindow.hpp"
+
+#include <GL/glew.h>
+
+#ifdef _WIN32
+struct GLFWwindow;
+#else
+#include <EGL/egl.h>
+#endif
+
+namespace GraphicEngine::Headless
+{
+	// OpenGL 4.5 core context without window, frames are rendered into framebuffer object which stays bound as default target.
+	// Uses EGL surfaceless context (works with Mesa llvmpipe), on Windows hidden GLFW window provides context.
+	class HeadlessOpenGLWindow : public HeadlessWindow
+	{
+	public:
+		HeadlessOpenGLWindow(std::shared_ptr<Core::Configuration> cfg, std::shared_ptr<Common::UI> ui);
+		virtual ~HeadlessOpenGLWindow();
+
+	protected:
+		virtual void createContext() override;
+		void createFramebuffer();
+
+	protected:
+#ifdef _WIN32
+		GLFWwindow* m_hiddenWindow{ nullptr };
+#else
+		EGLDisplay m_display{ EGL_NO_DISPLAY };
+		EGLContext m_context{ EGL_NO_CONTEXT };
+#endif
+		GLuint m_framebuffer{ 0 };
+		GLuint m_colorRenderbuffer{ 0 };
+		GLuint m_depthRenderbuffer{ 0 };
+	};
+}
@@ -0,0 +1,27 @@
+#pragma once
+#define BOOST_DI_CFG_DIAGNOSTICS_LEVEL 2
+#define __has_builtin(...) 1
+#define BOOST_DI_CFG_CTOR_LIMIT_SIZE 20
+#include <boost/di.hpp>
+
+#include "../../../Drivers/Vulkan/VulkanRenderingEngine.hpp"
+#include "HeadlessVulkanWindowContext.hpp"
+
+
+namespace di = boost::di;
+
+namespace GraphicEngine::Headless
+{
+	auto injectHeadlessVulkanResources()
+	{
+		return di::make_injector
+		(
+			di::bind<GraphicEngine::Common::WindowKeyboardMouse, GraphicEngine::Headless::HeadlessWindow>.to<GraphicEngine::Headless::HeadlessWindow>().in(di::singleton),
+			di::bind<GraphicEngine::Vulkan::VulkanWindowContext>.to<GraphicEngine::Headless::HeadlessVulkanWindowContext>().in(di::singleton),
+			di::bind<GraphicEngine::RenderingEngine>.to<GraphicEngine::Vulkan::VulkanRenderingEngine>().in(di::singleton),
+			di::bind<GraphicEngine::Common::UI>.to<GraphicEngine::GUI::ImGuiImpl>().in(di::singleton),
+			di::bind<GraphicEngine::Core::EventManager>.in(di::singleton),
+			di::bind<GraphicEngine::Core::Timer>.in(di::singleton)
+		);
+	}
+}
@@ -0,0 +1,29 @@
+#include "HeadlessVulkanWindowContext.hpp"
+
+#include <stdexcept>
+
+GraphicEngine::Headless::HeadlessVulkanWindowContext::HeadlessVulkanWindowContext(std::shared_ptr<HeadlessWindow> headlessWindow) :
+	m_headlessWindow(headlessWindow)
+{
+}
+
+VkSurfaceKHR GraphicEngine::Headless::HeadlessVulkanWindowContext::createSurface(const vk::UniqueInstance& instance)
+{
+	auto createHeadlessSurface = reinterpret_cast<PFN_vkCreateHeadlessSurfaceEXT>(vkGetInstanceProcAddr(instance.get(), "vkCreateHeadlessSurfaceEXT"));
+	if (createHeadlessSurface == nullptr)
+		throw std::runtime_error("VK_EXT_headless_surface is not supported!");
+
+	VkHeadlessSurfaceCreateInfoEXT createInfo{};
+	createInfo.sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT;
+
+	VkSurfaceKHR surface{ VK_NULL_HANDLE };
+	if (createHeadlessSurface(instance.get(), &createInfo, nullptr, &surface) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create headless surface!");
+
+	return surface;
+}
+
+std::vector<std::string> GraphicEngine::Headless::HeadlessVulkanWindowContext::getRequiredExtensions()
+{
+	return { VK_KHR_SURFACE_EXTENSION_NAME, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME };
+}
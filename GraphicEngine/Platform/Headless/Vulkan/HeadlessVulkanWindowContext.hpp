@@ -0,0 +1,18 @@
+#pragma once
+#include "../HeadlessWindow.hpp"
+#include "../../../Drivers/Vulkan/VulkanWindowContext.hpp"
+
+namespace GraphicEngine::Headless
+{
+	// Surface from VK_EXT_headless_surface, presentation succeeds without displaying anything (supported by Mesa lavapipe)
+	class HeadlessVulkanWindowContext : public Vulkan::VulkanWindowContext
+	{
+	public:
+		HeadlessVulkanWindowContext(std::shared_ptr<HeadlessWindow> headlessWindow);
+		VkSurfaceKHR createSurface(const vk::UniqueInstance& instance) override;
+		std::vector<std::string> getRequiredExtensions() override;
+
+	protected:
+		std::shared_ptr<HeadlessWindow> m_headlessWindow;
+	};
+}
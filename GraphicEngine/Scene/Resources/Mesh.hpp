@@ -3,7 +3,11 @@
 #include "Face.hpp"
 #include "MeshMaterial.hpp"
 #include "Transformation.hpp"
+#include "../../Core/Math/DrawCulling.hpp"
 #include "../../Core/Math/GeometryUtils.hpp"
+#include "../../Core/Math/Meshlets.hpp"
+#include "../../Core/Math/MeshSimplifier.hpp"
+#include "../../Core/Math/VertexCacheOptimizer.hpp"
 #include "../../Core/Math/Geometry/3D/Octree.hpp"
 #include "../../Core/Utils/MemberTraits.hpp"
 #include "../../Core/Utils/UniqueIdentifier.hpp"
@@ -11,8 +15,12 @@
 
 #include <glm\geometric.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <execution>
 #include <functional>
 #include <memory>
+#include <numeric>
 #include <utility>
 #include <type_traits>
 #include <set>
@@ -67,7 +75,9 @@ namespace GraphicEngine::Scene
 		template <template<typename> typename VertexBufferFactory, template<typename> typename VertexBuffer, typename... Args>
 		std::shared_ptr<VertexBuffer<Vertex>> compile(Args&... args)
 		{
-			return VertexBufferFactory<Vertex>::produceVertexBuffer(args..., getVertices(), getGeometryIndices(), getWireframeIndices());
+			auto vertexBuffer = VertexBufferFactory<Vertex>::produceVertexBuffer(args..., getVertices(), getLodIndices(), getWireframeIndices());
+			vertexBuffer->setLods(getLodRanges());
+			return vertexBuffer;
 		}
 
 		void addVertex(std::shared_ptr<Vertex> vertex)
@@ -163,6 +173,126 @@ namespace GraphicEngine::Scene
 			return std::move(indices);
 		}
 
+		// Reorders triangles for post-transform vertex cache, nothing is changed when mesh has other polygons than triangles
+		Core::Math::VertexCacheStatistics optimizeVertexCache()
+		{
+			Core::Math::VertexCacheStatistics statistics;
+			if (!isTriangleMesh())
+				return statistics;
+
+			auto indices = getGeometryIndices();
+			statistics.acmrBefore = Core::Math::calculateACMR(indices, m_vertices.size());
+
+			std::vector<std::shared_ptr<Face>> faces;
+			faces.reserve(m_faces.size());
+			for (uint32_t triangle : Core::Math::calculateVertexCacheOrder(indices, m_vertices.size()))
+			{
+				faces.push_back(m_faces[triangle]);
+			}
+			m_faces = std::move(faces);
+
+			statistics.acmrAfter = Core::Math::calculateACMR(getGeometryIndices(), m_vertices.size());
+
+			for (auto& lod : m_lods)
+			{
+				lod.indices = Core::Math::optimizeVertexCache(lod.indices, m_vertices.size());
+			}
+
+			// Meshlets are ranges of old order of faces
+			m_meshlets.clear();
+			return statistics;
+		}
+
+		// Every level has reduction times less triangles than previous one, levels are simplified from base mesh in parallel.
+		// Nothing is generated when mesh has other polygons than triangles
+		void generateLods(uint32_t levels, float reduction = 0.5f, float maxScreenError = 0.002f)
+		{
+			m_lods.clear();
+			m_lodScreenError = maxScreenError;
+			if (!isTriangleMesh())
+				return;
+
+			auto indices = getGeometryIndices();
+			std::vector<glm::vec3> positions;
+			positions.reserve(m_vertices.size());
+			for (auto& vertex : m_vertices)
+			{
+				positions.push_back(vertex->position);
+			}
+
+			std::vector<uint32_t> lodLevels(levels);
+			std::iota(std::begin(lodLevels), std::end(lodLevels), 1);
+			m_lods.resize(levels);
+			std::for_each(std::execution::par, std::begin(lodLevels), std::end(lodLevels), [&](uint32_t level)
+			{
+				size_t targetTriangles = static_cast<size_t>(indices.size() / 3 * std::pow(reduction, static_cast<float>(level)));
+				m_lods[level - 1] = Core::Math::simplifyMesh(positions, indices, 3 * targetTriangles);
+			});
+
+			// Levels which could not be simplified more than previous one are not worth switching to
+			size_t previousIndices{ indices.size() };
+			m_lods.erase(std::remove_if(std::begin(m_lods), std::end(m_lods), [&](const Core::Math::SimplifiedMesh& lod)
+			{
+				if (lod.indices.size() >= previousIndices)
+					return true;
+				previousIndices = lod.indices.size();
+				return false;
+			}), std::end(m_lods));
+		}
+
+		// Base mesh is level 0
+		uint32_t getLodsCount()
+		{
+			return static_cast<uint32_t>(m_lods.size()) + 1;
+		}
+
+		std::vector<Core::Math::SimplifiedMesh> getLods()
+		{
+			return m_lods;
+		}
+
+		// Geometry indices followed by indices of every level
+		std::vector<uint32_t> getLodIndices()
+		{
+			auto indices = getGeometryIndices();
+			for (auto& lod : m_lods)
+			{
+				indices.insert(std::end(indices), std::begin(lod.indices), std::end(lod.indices));
+			}
+			return indices;
+		}
+
+		// Offset and count of indices of every level in getLodIndices
+		std::vector<std::pair<uint32_t, uint32_t>> getLodRanges()
+		{
+			uint32_t offset{ 0 };
+			for (auto& face : m_faces)
+			{
+				offset += face->indices.size();
+			}
+
+			std::vector<std::pair<uint32_t, uint32_t>> ranges{ { 0, offset } };
+			for (auto& lod : m_lods)
+			{
+				ranges.emplace_back(offset, static_cast<uint32_t>(lod.indices.size()));
+				offset += lod.indices.size();
+			}
+			return ranges;
+		}
+
+		// Coarsest level which error projected on screen stays under limit given to generateLods
+		uint32_t selectLod(glm::mat4 modelViewProjection)
+		{
+			float projectedSize = getMeshBoudingBox().getProjectedSize(modelViewProjection);
+
+			uint32_t level{ 0 };
+			while (level < m_lods.size() && m_lods[level].error * projectedSize <= m_lodScreenError)
+			{
+				++level;
+			}
+			return level;
+		}
+
 		void generate(Common::VertexType resources)
 		{
 			if (resources & Common::VertexType::Normal)
@@ -262,6 +392,11 @@ namespace GraphicEngine::Scene
 			return m_material;
 		}
 
+		uint32_t getMaterialId()
+		{
+			return m_materialId;
+		}
+
 		void setMaterial(MeshMaterial material)
 		{
 			m_material = material;
@@ -271,9 +406,114 @@ namespace GraphicEngine::Scene
 				m_material.solidColor = glm::vec4(glm::vec3(material.diffuse), 1.0);
 			}
 			catch (const std::bad_variant_access&) {}
+			m_materialId = calculateMaterialId(m_material);
+		}
+
+		// Faces are reordered so every meshlet is contiguous range of them, order inside meshlet still follows vertex cache order
+		void generateMeshlets(uint32_t maxVertices = 64, uint32_t maxTriangles = 124)
+		{
+			m_meshlets.clear();
+			if (!isTriangleMesh())
+				return;
+
+			std::vector<glm::vec3> positions;
+			positions.reserve(m_vertices.size());
+			for (auto& vertex : m_vertices)
+			{
+				positions.push_back(vertex->position);
+			}
+			auto clustering = Core::Math::buildMeshlets(positions, getGeometryIndices(), maxVertices, maxTriangles);
+
+			std::vector<std::shared_ptr<Face>> faces;
+			faces.reserve(m_faces.size());
+			for (uint32_t triangle : clustering.triangleOrder)
+			{
+				faces.push_back(m_faces[triangle]);
+			}
+			m_faces = std::move(faces);
+			m_meshlets = std::move(clustering.meshlets);
+		}
+
+		std::vector<Core::Math::Meshlet> getMeshlets()
+		{
+			return m_meshlets;
+		}
+
+		bool hasMeshlets()
+		{
+			return !m_meshlets.empty();
+		}
+
+		// Appends draws of meshlets of base level which are in frustum and not facing away from eye
+		void cullMeshlets(const glm::mat4& viewProjection, glm::vec3 eyePosition, std::vector<Common::DrawElementsCommand>& commands)
+		{
+			auto modelMatrix = getModelMatrix();
+			glm::vec3 localEyePosition = glm::vec3(glm::inverse(modelMatrix) * glm::vec4(eyePosition, 1.0f));
+			Core::Math::cullMeshlets(m_meshlets, viewProjection * modelMatrix, localEyePosition, commands);
+		}
+
+		// Draws of level culled on GPU, base level is split into meshlets when they are built and other levels are bounded by box of mesh
+		std::vector<Core::Math::CullingDraw> getCullingDraws(uint32_t level)
+		{
+			std::vector<Core::Math::CullingDraw> draws;
+			if (level == 0 && hasMeshlets())
+			{
+				for (const auto& meshlet : m_meshlets)
+				{
+					Core::Math::CullingDraw draw;
+					draw.center = meshlet.center;
+					draw.radius = meshlet.radius;
+					draw.coneApex = meshlet.coneApex;
+					draw.coneAxis = meshlet.coneAxis;
+					draw.coneCutoff = meshlet.coneCutoff;
+					draw.firstIndex = meshlet.firstIndex;
+					draw.indexCount = 3 * meshlet.trianglesCount;
+					draws.push_back(draw);
+				}
+				return draws;
+			}
+
+			auto lodRanges = getLodRanges();
+			auto lodRange = lodRanges.at(std::min<size_t>(level, lodRanges.size() - 1));
+			auto boudingBox = getMeshBoudingBox();
+			Core::Math::CullingDraw draw;
+			draw.center = boudingBox.getCenter();
+			draw.radius = glm::length(boudingBox.getRight() - boudingBox.getLeft()) / 2.0f;
+			draw.firstIndex = lodRange.first;
+			draw.indexCount = lodRange.second;
+			draw.lod = level;
+			draws.push_back(draw);
+			return draws;
+		}
+
+		// Bounds and errors of levels used by GPU culling to select level of detail, levels past limit of culling are dropped
+		Core::Math::CullingObject getCullingObject()
+		{
+			auto boudingBox = getMeshBoudingBox();
+			Core::Math::CullingObject object;
+			object.boundsMin = boudingBox.getLeft();
+			object.boundsMax = boudingBox.getRight();
+			object.lodsCount = std::min(getLodsCount(), Core::Math::maxCullingLods);
+			object.lodScreenError = m_lodScreenError;
+			for (uint32_t level{ 1 }; level < object.lodsCount; ++level)
+			{
+				object.lodErrors[level] = m_lods[level - 1].error;
+			}
+			return object;
 		}
 
 	private:
+		// Bounding box is moved to world by model matrix, levels of detail and culling draws are bounded in space of mesh
+		Core::BoudingBox3D getMeshBoudingBox()
+		{
+			return Core::BoudingBox3D(m_boudingBox.getBaseLeft(), m_boudingBox.getBaseRight());
+		}
+
+		bool isTriangleMesh()
+		{
+			return !m_faces.empty() && std::all_of(std::begin(m_faces), std::end(m_faces), [](const std::shared_ptr<Face>& face) { return face->indices.size() == 3; });
+		}
+
 		void generateDefaultMaterial()
 		{
 			Engines::Graphic::Shaders::Material material;
@@ -282,6 +522,7 @@ namespace GraphicEngine::Scene
 			material.ambient = glm::vec4(Core::randomColor(), 1.0f);
 			m_material.baseMaterial = material;
 			m_material.solidColor = glm::vec4(glm::vec3(material.diffuse), 1.0);
+			m_materialId = calculateMaterialId(m_material);
 		}
 
 	private:
@@ -290,6 +531,11 @@ namespace GraphicEngine::Scene
 
 		std::shared_ptr<Core::Octree<Vertex, OctreeLevels>> m_octree;
 
+		std::vector<Core::Math::SimplifiedMesh> m_lods;
+		std::vector<Core::Math::Meshlet> m_meshlets;
+		float m_lodScreenError{ 0.0f };
+
 		MeshMaterial m_material;
+		uint32_t m_materialId{ 0 };
 	};
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../../Engines/Graphic/Shaders/Models/Material.hpp"
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <variant>
 
@@ -18,4 +20,37 @@ namespace GraphicEngine::Scene
 		glm::vec4 solidColor;
 		std::variant<Engines::Graphic::Shaders::Material, MeshMaterialTexturePaths> baseMaterial;
 	};
+
+	// Same materials get same identifier, so draws can be grouped by material
+	inline uint32_t calculateMaterialId(const MeshMaterial& material)
+	{
+		size_t seed{ material.baseMaterial.index() };
+		auto combine = [&](auto value)
+		{
+			seed ^= std::hash<decltype(value)>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		};
+		auto combineVector = [&](const glm::vec4& value)
+		{
+			for (int i{ 0 }; i < 4; ++i)
+			{
+				combine(value[i]);
+			}
+		};
+
+		if (auto baseMaterial = std::get_if<Engines::Graphic::Shaders::Material>(&material.baseMaterial))
+		{
+			combineVector(baseMaterial->ambient);
+			combineVector(baseMaterial->diffuse);
+			combineVector(baseMaterial->specular);
+			combine(baseMaterial->shininess);
+		}
+		else if (auto texturePaths = std::get_if<MeshMaterialTexturePaths>(&material.baseMaterial))
+		{
+			combine(texturePaths->ambient);
+			combine(texturePaths->diffuse);
+			combine(texturePaths->specular);
+			combine(texturePaths->shinnes);
+		}
+		return static_cast<uint32_t>(seed);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,238 @@
+#include "BenchmarkManager.hpp"
+
+#include "../Engines/Graphic/3D/ObjectGenerator.hpp"
+
+#include <filesystem>
+#include <random>
+
+GraphicEngine::Services::BenchmarkManager::BenchmarkManager(std::shared_ptr<Core::Configuration> cfg,
+	std::shared_ptr<ModelManager> modelManager,
+	std::shared_ptr<LightManager> lightManager,
+	std::shared_ptr<CameraControllerManager> cameraControllerManager,
+	std::shared_ptr<Core::Profiler> profiler,
+	std::unique_ptr<Core::Logger<BenchmarkManager>> logger) :
+	m_cfg{ cfg },
+	m_modelManager{ modelManager },
+	m_lightManager{ lightManager },
+	m_cameraControllerManager{ cameraControllerManager },
+	m_profiler{ profiler },
+	m_logger{ std::move(logger) }
+{
+	m_enabled = m_cfg->getProperty<bool>("benchmark:enabled");
+	if (!m_enabled)
+		return;
+
+#ifndef GRAPHIC_ENGINE_PROFILER
+	m_logger->warn(__FILE__, __LINE__, __FUNCTION__, "Profiler is not compiled in, benchmark report will have no measurements");
+#endif
+
+	m_warmupFrames = m_cfg->getProperty<uint32_t>("benchmark:warmup frames");
+	for (auto pathDefinition : m_cfg->getProperty<std::vector<json>>("benchmark:camera paths"))
+	{
+		Core::Configuration pathCfg(pathDefinition);
+		std::vector<Common::CameraPathKey> keys;
+		for (auto keyDefinition : pathCfg.getProperty<std::vector<json>>("keys"))
+		{
+			Core::Configuration keyCfg(keyDefinition);
+			keys.push_back(Common::CameraPathKey{
+				Core::Utils::Converter::fromArrayToObject<glm::vec3, std::vector<float>, 3>(keyCfg.getProperty<std::vector<float>>("position")),
+				Core::Utils::Converter::fromArrayToObject<glm::vec3, std::vector<float>, 3>(keyCfg.getProperty<std::vector<float>>("target")) });
+		}
+
+		auto frames = pathCfg.getProperty<uint32_t>("frames");
+		// Statistics are taken from profiler window, longer path would lose its first frames
+		if (frames > Core::Profiler::framesWindow)
+		{
+			throw std::runtime_error("Benchmark camera path can not be longer than " + std::to_string(Core::Profiler::framesWindow) + " frames!");
+		}
+		m_paths.emplace_back(pathCfg.getProperty<std::string>("name"), frames, std::move(keys));
+	}
+
+	if (m_paths.empty())
+	{
+		throw std::runtime_error("Benchmark has no camera paths!");
+	}
+
+	auto sceneJson = m_cfg->getProperty<json>("benchmark:scene");
+	createScene(std::make_shared<Core::Configuration>(sceneJson));
+	m_report = Core::BenchmarkReport(nlohmann::json::object({
+		{ "engine", m_cfg->getProperty<std::string>("engine") },
+		{ "window", { { "width", m_cfg->getProperty<uint32_t>("window:width") }, { "height", m_cfg->getProperty<uint32_t>("window:height") } } },
+		{ "warmup frames", m_warmupFrames },
+		{ "scene", sceneJson } }));
+}
+
+bool GraphicEngine::Services::BenchmarkManager::isEnabled() const
+{
+	return m_enabled;
+}
+
+bool GraphicEngine::Services::BenchmarkManager::isFinished() const
+{
+	return m_finished;
+}
+
+bool GraphicEngine::Services::BenchmarkManager::hasRegressions() const
+{
+	return !m_report.getRegressions().empty();
+}
+
+void GraphicEngine::Services::BenchmarkManager::beginFrame()
+{
+	if (!m_enabled || m_finished)
+		return;
+
+	const auto& path = m_paths[m_currentPath];
+	uint32_t pathFrame = m_frame < m_warmupFrames ? 0 : m_frame - m_warmupFrames;
+	if (m_frame == m_warmupFrames)
+	{
+		// Samples of warmup and previous path are dropped, so statistics cover only this path
+		m_profiler->reset();
+	}
+
+	auto key = path.sample(pathFrame);
+	m_cameraControllerManager->getActiveCamera()->setView(key.position, key.target - key.position);
+}
+
+void GraphicEngine::Services::BenchmarkManager::endFrame()
+{
+	if (!m_enabled || m_finished)
+		return;
+
+	const auto& path = m_paths[m_currentPath];
+	if (++m_frame < m_warmupFrames + path.getFramesCount())
+		return;
+
+	m_report.addPath(path.getName(), m_profiler->getFramesCount(), m_profiler->getStatistics(), m_profiler->getCounterStatistics());
+	m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Benchmark path {} finished", path.getName());
+
+	m_frame = 0;
+	if (++m_currentPath == m_paths.size())
+	{
+		finish();
+	}
+}
+
+void GraphicEngine::Services::BenchmarkManager::createScene(std::shared_ptr<Core::Configuration> sceneCfg)
+{
+	using Generator = Engines::Graphic::ObjectGenerator<Common::VertexPN>;
+
+	std::mt19937 generator(sceneCfg->getProperty<uint32_t>("seed"));
+	auto groundTiles = sceneCfg->getProperty<uint32_t>("ground tiles");
+	auto tileSize = sceneCfg->getProperty<float>("tile size");
+	auto tileScale = sceneCfg->getProperty<int>("tile scale");
+	float halfSize = groundTiles * tileSize / 2.0f;
+
+	std::uniform_real_distribution<float> positionDistribution(-halfSize, halfSize);
+	std::uniform_real_distribution<float> sizeDistribution(0.2f, 1.0f);
+	std::uniform_real_distribution<float> colorDistribution(0.1f, 1.0f);
+
+	auto randomMaterial = [&]()
+	{
+		glm::vec4 color(colorDistribution(generator), colorDistribution(generator), colorDistribution(generator), 1.0f);
+		Engines::Graphic::Shaders::Material material;
+		material.ambient = color * 0.2f;
+		material.diffuse = color;
+		material.specular = glm::vec4(0.5f, 0.5f, 0.5f, 1.0f);
+		material.shininess = 32.0f;
+
+		Scene::MeshMaterial meshMaterial;
+		meshMaterial.solidColor = color;
+		meshMaterial.baseMaterial = material;
+		return meshMaterial;
+	};
+
+	auto addModel = [&](std::shared_ptr<Scene::Model<Common::VertexPN>> model)
+	{
+		auto meshMaterial = randomMaterial();
+		for (auto& mesh : model->getMeshes())
+		{
+			mesh->setMaterial(meshMaterial);
+		}
+		m_modelManager->addModel(model);
+	};
+
+	m_modelManager->clearModels();
+
+	// Ground is split into tiles on XZ plane so grass patches and culling work on several meshes
+	for (uint32_t x{ 0 }; x < groundTiles; ++x)
+	{
+		for (uint32_t y{ 0 }; y < groundTiles; ++y)
+		{
+			glm::vec2 begin(-halfSize + x * tileSize, -halfSize + y * tileSize);
+			addModel(Generator::getPlaneModel(begin, begin + glm::vec2(tileSize), glm::ivec2(tileScale)));
+		}
+	}
+
+	auto spheresCount = sceneCfg->getProperty<uint32_t>("spheres");
+	auto sphereScale = Core::Utils::Converter::fromArrayToObject<glm::ivec2, std::vector<int>, 2>(sceneCfg->getProperty<std::vector<int>>("sphere scale"));
+	for (uint32_t i{ 0 }; i < spheresCount; ++i)
+	{
+		float radius = sizeDistribution(generator) * 0.5f;
+		glm::vec3 center(positionDistribution(generator), radius, positionDistribution(generator));
+		addModel(Generator::getSphereModel(center, radius, sphereScale));
+	}
+
+	auto conesCount = sceneCfg->getProperty<uint32_t>("cones");
+	auto coneScale = Core::Utils::Converter::fromArrayToObject<glm::ivec3, std::vector<int>, 3>(sceneCfg->getProperty<std::vector<int>>("cone scale"));
+	for (uint32_t i{ 0 }; i < conesCount; ++i)
+	{
+		float radius = sizeDistribution(generator) * 0.5f;
+		glm::vec3 center(positionDistribution(generator), 0.0f, positionDistribution(generator));
+		addModel(Generator::getConeModel(center, radius, radius * 3.0f, coneScale));
+	}
+
+	while (!m_lightManager->getPointLights().empty())
+	{
+		m_lightManager->deletePointLight(0);
+	}
+	while (!m_lightManager->getSpotLights().empty())
+	{
+		m_lightManager->deleteSpotLight(0);
+	}
+
+	auto pointLightsCount = sceneCfg->getProperty<uint32_t>("point lights");
+	for (uint32_t i{ 0 }; i < pointLightsCount; ++i)
+	{
+		glm::vec4 position(positionDistribution(generator), 1.0f + sizeDistribution(generator), positionDistribution(generator), 1.0f);
+		glm::vec4 color(colorDistribution(generator), colorDistribution(generator), colorDistribution(generator), 1.0f);
+		m_lightManager->addPointLight(Engines::Graphic::Shaders::PointLight(position, 1.0f, 0.7f, 1.8f,
+			Engines::Graphic::Shaders::LightColor(color, color * 0.05f, color)));
+	}
+
+	m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Benchmark scene created with {} ground tiles, {} spheres, {} cones and {} point lights",
+		groundTiles * groundTiles, spheresCount, conesCount, pointLightsCount);
+}
+
+void GraphicEngine::Services::BenchmarkManager::finish()
+{
+	m_finished = true;
+
+	auto baselinePath = m_cfg->getProperty<std::string>("benchmark:baseline path");
+	if (!baselinePath.empty() && std::filesystem::exists(baselinePath))
+	{
+		Core::BenchmarkThresholds thresholds{
+			m_cfg->getProperty<double>("benchmark:thresholds:cpu"),
+			m_cfg->getProperty<double>("benchmark:thresholds:gpu"),
+			m_cfg->getProperty<double>("benchmark:thresholds:counters"),
+			m_cfg->getProperty<double>("benchmark:thresholds:minimum time") };
+
+		for (const auto& regression : m_report.compare(Core::BenchmarkReport::load(baselinePath), thresholds))
+		{
+			m_logger->warn(__FILE__, __LINE__, __FUNCTION__, "Regression in path {}, {} {}: {} -> {} ({:+.1f}%)",
+				regression.path, regression.group, regression.name, regression.baseline, regression.current, regression.change * 100.0);
+		}
+	}
+
+	auto outputPath = m_cfg->getProperty<std::string>("benchmark:output path");
+	if (!outputPath.empty())
+	{
+		auto directory = std::filesystem::path(outputPath).parent_path();
+		if (!directory.empty())
+		{
+			std::filesystem::create_directories(directory);
+		}
+		m_report.save(outputPath);
+		m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Benchmark report written to {}", outputPath);
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../Common/CameraPath.hpp"
+#include "../Core/BenchmarkReport.hpp"
+#include "../Core/Configuration.hpp"
+#include "../Core/Logger.hpp"
+#include "../Core/Profiler.hpp"
+#include "CameraControllerManager.hpp"
+#include "LightManager.hpp"
+#include "ModelManager.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GraphicEngine::Services
+{
+	// Replaces configured scene with seeded synthetic scene and flies active camera along fixed paths.
+	// Profiler samples of every path are collected after warmup and written as report comparable with baseline of earlier run.
+	class BenchmarkManager
+	{
+	public:
+		BenchmarkManager(std::shared_ptr<Core::Configuration> cfg,
+			std::shared_ptr<ModelManager> modelManager,
+			std::shared_ptr<LightManager> lightManager,
+			std::shared_ptr<CameraControllerManager> cameraControllerManager,
+			std::shared_ptr<Core::Profiler> profiler,
+			std::unique_ptr<Core::Logger<BenchmarkManager>> logger);
+
+		bool isEnabled() const;
+		bool isFinished() const;
+		bool hasRegressions() const;
+
+		// Places camera for frame, has to be called before frame is drawn
+		void beginFrame();
+		// Has to be called after profiler finished frame
+		void endFrame();
+
+	private:
+		void createScene(std::shared_ptr<Core::Configuration> sceneCfg);
+		void finish();
+
+	private:
+		std::shared_ptr<Core::Configuration> m_cfg;
+		std::shared_ptr<ModelManager> m_modelManager;
+		std::shared_ptr<LightManager> m_lightManager;
+		std::shared_ptr<CameraControllerManager> m_cameraControllerManager;
+		std::shared_ptr<Core::Profiler> m_profiler;
+		std::unique_ptr<Core::Logger<BenchmarkManager>> m_logger;
+
+		bool m_enabled{ false };
+		bool m_finished{ false };
+		uint32_t m_warmupFrames{ 0 };
+		std::vector<Common::CameraPath> m_paths;
+		size_t m_currentPath{ 0 };
+		// Frame of current path, warmup frames are counted before path frames
+		uint32_t m_frame{ 0 };
+
+		Core::BenchmarkReport m_report;
+	};
+}
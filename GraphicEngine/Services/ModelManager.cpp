@@ -17,6 +17,11 @@ GraphicEngine::Services::ModelManager::ModelManager(std::shared_ptr<Core::Config
 	try
 	{
 		auto objectsDefinitions = cfg->getProperty<std::vector<json>>("scene:objects");
+		auto vertexCacheOptimization = cfg->getProperty<bool>("rendering options:vertex cache optimization");
+		auto lodLevels = cfg->getProperty<uint32_t>("rendering options:levels of detail:levels");
+		auto lodReduction = cfg->getProperty<float>("rendering options:levels of detail:reduction");
+		auto lodScreenError = cfg->getProperty<float>("rendering options:levels of detail:screen error");
+		auto meshlets = cfg->getProperty<bool>("rendering options:meshlets");
 		std::mutex m;
 		std::for_each(std::execution::par, std::begin(objectsDefinitions), std::end(objectsDefinitions), [&](auto objectDefinition)
 			{
@@ -43,6 +48,18 @@ GraphicEngine::Services::ModelManager::ModelManager(std::shared_ptr<Core::Config
 					{
 						mesh->setMaterial(meshMaterial);
 					}
+					if (lodLevels > 0)
+					{
+						generateLods(model, modelConfiguration->getProperty<std::string>("type"), lodLevels, lodReduction, lodScreenError);
+					}
+					if (vertexCacheOptimization)
+					{
+						optimizeVertexCache(model, modelConfiguration->getProperty<std::string>("type"));
+					}
+					if (meshlets)
+					{
+						generateMeshlets(model, modelConfiguration->getProperty<std::string>("type"));
+					}
 					std::lock_guard<std::mutex> guard(m);
 					addModel(model);
 				}
@@ -61,6 +78,18 @@ GraphicEngine::Services::ModelManager::ModelManager(std::shared_ptr<Core::Config
 					meshMaterial.baseMaterial = Engines::Graphic::Shaders::Material(std::make_shared<Core::Configuration>(materialProperties));
 					for (auto& model : models)
 					{
+						if (lodLevels > 0)
+						{
+							generateLods(model, modelConfiguration->getProperty<std::string>("path"), lodLevels, lodReduction, lodScreenError);
+						}
+						if (vertexCacheOptimization)
+						{
+							optimizeVertexCache(model, modelConfiguration->getProperty<std::string>("path"));
+						}
+						if (meshlets)
+						{
+							generateMeshlets(model, modelConfiguration->getProperty<std::string>("path"));
+						}
 						std::lock_guard<std::mutex> guard(m);
 						addModel(model);
 						for (auto& mesh : model->getMeshes())
@@ -78,6 +107,11 @@ GraphicEngine::Services::ModelManager::ModelManager(std::shared_ptr<Core::Config
 	}
 }
 
+void GraphicEngine::Services::ModelManager::clearModels()
+{
+	m_modelContainer->clear();
+}
+
 std::shared_ptr<GraphicEngine::Services::ModelEntityContainer> GraphicEngine::Services::ModelManager::getModelEntityContainer()
 {
 	return m_modelContainer;
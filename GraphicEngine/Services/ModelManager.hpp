@@ -29,8 +29,67 @@ namespace GraphicEngine::Services
 			m_modelContainer->eraseEntity(it);
 		}
 
+		// Drops all models, has to be called before rendering engine compiles meshes
+		void clearModels();
+
 		std::shared_ptr<ModelEntityContainer> getModelEntityContainer();
 	protected:
+	private:
+		template <typename VertexType>
+		void optimizeVertexCache(std::shared_ptr<Scene::Model<VertexType>> model, const std::string& name)
+		{
+			// ACMR of whole model is average of meshes weighted by their triangles
+			uint32_t meshIndex{ 0 };
+			uint32_t optimizedMeshes{ 0 };
+			size_t triangles{ 0 };
+			double missesBefore{ 0.0 };
+			double missesAfter{ 0.0 };
+			for (auto& mesh : model->getMeshes())
+			{
+				auto statistics = mesh->optimizeVertexCache();
+				m_logger->debug(__FILE__, __LINE__, __FUNCTION__, "Vertex cache of {} mesh {} optimized, ACMR {} -> {}", name, meshIndex++, statistics.acmrBefore, statistics.acmrAfter);
+				if (statistics.acmrBefore == 0.0f)
+					continue;
+
+				size_t meshTriangles = mesh->getGeometryIndices().size() / 3;
+				++optimizedMeshes;
+				triangles += meshTriangles;
+				missesBefore += statistics.acmrBefore * meshTriangles;
+				missesAfter += statistics.acmrAfter * meshTriangles;
+			}
+
+			if (triangles > 0)
+			{
+				m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Vertex cache of {} optimized, {} meshes, ACMR {} -> {}", name, optimizedMeshes, missesBefore / triangles, missesAfter / triangles);
+			}
+		}
+
+		template <typename VertexType>
+		void generateLods(std::shared_ptr<Scene::Model<VertexType>> model, const std::string& name, uint32_t levels, float reduction, float maxScreenError)
+		{
+			uint32_t meshIndex{ 0 };
+			for (auto& mesh : model->getMeshes())
+			{
+				mesh->generateLods(levels, reduction, maxScreenError);
+				for (auto& lod : mesh->getLods())
+				{
+					m_logger->info(__FILE__, __LINE__, __FUNCTION__, "LOD of {} mesh {} generated, {} triangles, error {}", name, meshIndex, lod.indices.size() / 3, lod.error);
+				}
+				++meshIndex;
+			}
+		}
+
+		template <typename VertexType>
+		void generateMeshlets(std::shared_ptr<Scene::Model<VertexType>> model, const std::string& name)
+		{
+			uint32_t meshIndex{ 0 };
+			for (auto& mesh : model->getMeshes())
+			{
+				mesh->generateMeshlets();
+				m_logger->info(__FILE__, __LINE__, __FUNCTION__, "Meshlets of {} mesh {} generated, {} meshlets", name, meshIndex++, mesh->getMeshlets().size());
+			}
+		}
+
 	private:
 		std::shared_ptr<ModelEntityContainer> m_modelContainer = std::make_shared<ModelEntityContainer>();;
 		std::unique_ptr<Core::Logger<ModelManager>> m_logger;
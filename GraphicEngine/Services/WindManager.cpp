@@ -1,12 +1,23 @@
 #include "WindManager.hpp"
-#include <filesystem>
+#include <opencv2\opencv.hpp>
+#include <algorithm>
+#include <chrono>
+
+#undef min
+#undef max
 
 GraphicEngine::Services::WindManager::WindManager(std::shared_ptr<Core::Configuration> cfg)
 {
 	auto windParametersJson = cfg->getProperty<json>("scene:wind:parameters");
 	m_windParameters = Engines::Graphic::Shaders::WindParameters(std::make_shared<Core::Configuration>(windParametersJson));
-	m_windTexturePath = cfg->getProperty<std::string>("scene:wind:generator:path");
-	loadWind();
+
+	m_resolution = cfg->getProperty<uint32_t>("scene:wind:generator:resolution");
+	m_generatorSpeed = cfg->getProperty<float>("scene:wind:generator:speed");
+	m_rowsPerFrame = cfg->getProperty<uint32_t>("scene:wind:generator:rows per frame");
+	m_gustSpeed = cfg->getProperty<float>("scene:wind:generator:gust speed");
+
+	// Texture object is created from initial data, so first texture is generated up front
+	m_windTexture = generate(m_resolution, m_generatorSpeed, 0.0f);
 }
 
 GraphicEngine::Engines::Graphic::Shaders::WindParameters GraphicEngine::Services::WindManager::getWindParameters()
@@ -39,10 +50,47 @@ void GraphicEngine::Services::WindManager::setWindDirection(glm::vec2 direction)
 
 void GraphicEngine::Services::WindManager::generateWindTexture(uint32_t resolution, float speed)
 {
-	m_windTexture = Engines::Graphic::WindGenerator::generate(resolution, speed);
-	m_resolution = resolution;
-	m_textureObject.reset();
-	cv::imwrite(m_windTexturePath, m_windTexture);
+	// Destroying unfinished future would block, so request is queued until running generation finishes
+	if (m_pendingTexture.valid())
+	{
+		m_queuedGeneration = std::make_pair(resolution, speed);
+		return;
+	}
+
+	startGeneration(resolution, speed);
+}
+
+void GraphicEngine::Services::WindManager::update(float time)
+{
+	m_time = time;
+	if (m_pendingTexture.valid())
+	{
+		if (m_pendingTexture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			return;
+
+		m_windTexture = m_pendingTexture.get();
+		m_resolution = m_pendingResolution;
+		m_generatorSpeed = m_pendingSpeed;
+		m_nextRow = 0;
+		if (m_updateTextureObject)
+			m_updateTextureObject(m_windTexture.data(), m_resolution, 0, m_resolution);
+
+		if (m_queuedGeneration.has_value())
+		{
+			startGeneration(m_queuedGeneration->first, m_queuedGeneration->second);
+			m_queuedGeneration.reset();
+		}
+		return;
+	}
+
+	if (m_rowsPerFrame == 0 || !m_updateTextureObject)
+		return;
+
+	// Gusts evolve by regenerating one band of rows per frame, noise is continuous in time so bands blend with neighbours
+	uint32_t rowsCount = std::min(m_rowsPerFrame, m_resolution - m_nextRow);
+	Engines::Graphic::WindGenerator::generate(m_windTexture.data(), m_resolution, m_generatorSpeed, time * m_gustSpeed, m_nextRow, rowsCount);
+	m_updateTextureObject(m_windTexture.data(), m_resolution, m_nextRow, rowsCount);
+	m_nextRow = (m_nextRow + rowsCount) % m_resolution;
 }
 
 uint32_t GraphicEngine::Services::WindManager::getWindTextureResolution()
@@ -50,15 +98,20 @@ uint32_t GraphicEngine::Services::WindManager::getWindTextureResolution()
 	return m_resolution;
 }
 
-void GraphicEngine::Services::WindManager::loadWind()
+std::vector<uint8_t> GraphicEngine::Services::WindManager::generate(uint32_t resolution, float speed, float time)
 {
-	if (std::filesystem::exists(m_windTexturePath))
-	{
-		m_windTexture = cv::imread(m_windTexturePath, cv::IMREAD_UNCHANGED);
-		m_resolution = m_windTexture.rows;
-	}
-	else
-	{
-		generateWindTexture(1024, 1.0);
-	}
+	std::vector<uint8_t> data(static_cast<size_t>(resolution) * resolution * 4);
+	cv::parallel_for_(cv::Range(0, resolution), [&](cv::Range range)
+		{
+			Engines::Graphic::WindGenerator::generate(data.data(), resolution, speed, time, range.start, range.end - range.start);
+		}, resolution / 16.0);
+	return data;
+}
+
+void GraphicEngine::Services::WindManager::startGeneration(uint32_t resolution, float speed)
+{
+	m_pendingResolution = resolution;
+	m_pendingSpeed = speed;
+	// Generated for current time, so swapped texture continues animated bands without a jump
+	m_pendingTexture = std::async(std::launch::async, &WindManager::generate, resolution, speed, m_time * m_gustSpeed);
 }
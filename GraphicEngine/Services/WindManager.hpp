@@ -5,9 +5,14 @@
 
 #include "../Engines/Graphic/2D/WindGenerator.hpp"
 #include <any>
+#include <future>
+#include <optional>
+#include <vector>
 
 namespace GraphicEngine::Services
 {
+	// Wind texture is generated deterministically, so it is kept only in memory and on GPU.
+	// Regeneration runs on a worker thread and finished texture is streamed into existing texture object on render thread.
 	class WindManager
 	{
 	public:
@@ -22,28 +27,54 @@ namespace GraphicEngine::Services
 		void setWindSpeed(float speed);
 		void setWindDirection(glm::vec2 direction);
 
+		// Starts generation in background, texture object is updated by next update call after generation finished
 		void generateWindTexture(uint32_t resolution = 1024, float speed = 1.0);
 
+		// Has to be called on rendering thread, uploads finished texture or animates next band of rows
+		void update(float time);
+
 		uint32_t getWindTextureResolution();
 
 		template <typename Texture>
 		std::shared_ptr<Texture> getTextureObject()
 		{
 			if (!m_textureObject.has_value())
-				m_textureObject = std::make_shared<Texture>(m_windTexture.data, m_resolution, m_resolution, 4, false);
+			{
+				auto texture = std::make_shared<Texture>(m_windTexture.data(), m_resolution, m_resolution, 4, false);
+				std::weak_ptr<Texture> weakTexture = texture;
+				m_updateTextureObject = [weakTexture](const uint8_t* data, uint32_t resolution, uint32_t firstRow, uint32_t rowsCount)
+				{
+					if (auto texture = weakTexture.lock())
+						texture->update(data, resolution, resolution, firstRow, rowsCount);
+				};
+				m_textureObject = texture;
+			}
 			return std::any_cast<std::shared_ptr<Texture>>(m_textureObject);
 		}
 
 	private:
-		void loadWind();
+		static std::vector<uint8_t> generate(uint32_t resolution, float speed, float time);
+		void startGeneration(uint32_t resolution, float speed);
+
 	private:
 		Engines::Graphic::Shaders::WindParameters m_windParameters{};
 		Core::Subject<Engines::Graphic::Shaders::WindParameters> m_updateWindParametersSubject;
 
-		cv::Mat m_windTexture;
-		std::string m_windTexturePath;
-
+		std::vector<uint8_t> m_windTexture;
 		uint32_t m_resolution;
+		float m_generatorSpeed;
+
+		uint32_t m_rowsPerFrame;
+		float m_gustSpeed;
+		uint32_t m_nextRow{ 0 };
+		float m_time{ 0.0f };
+
+		std::future<std::vector<uint8_t>> m_pendingTexture;
+		uint32_t m_pendingResolution{ 0 };
+		float m_pendingSpeed{ 0.0f };
+		std::optional<std::pair<uint32_t, float>> m_queuedGeneration;
+
 		std::any m_textureObject;
+		std::function<void(const uint8_t*, uint32_t, uint32_t, uint32_t)> m_updateTextureObject;
 	};
 }
@@ -0,0 +1,30 @@
+#include "ProfilerWindow.hpp"
+
+#include "../Widgets/Button.hpp"
+#include "../Widgets/ProfilerTable.hpp"
+#include "../Widgets/Text.hpp"
+
+GraphicEngine::GUI::ProfilerWindow::ProfilerWindow(std::shared_ptr<Core::Profiler> profiler, std::shared_ptr<Core::Configuration> cfg) :
+	m_profiler{ profiler },
+	m_tracePath{ cfg->getProperty<std::string>("debug:profiler trace path") }
+{
+	m_container = std::make_shared<CollapsingHeader>("Profiler");
+
+#ifdef GRAPHIC_ENGINE_PROFILER
+	m_container->addChildren(std::make_shared<ProfilerTable>("Zones", m_profiler));
+
+	auto exportTrace = std::make_shared<Button>("Export Chrome trace");
+	exportTrace->onClicked([&]()
+		{
+			m_profiler->saveChromeTrace(m_tracePath);
+		});
+	m_container->addChildren(exportTrace);
+#else
+	m_container->addChildren(std::make_shared<Text>("Profiler is compiled out, define GRAPHIC_ENGINE_PROFILER to enable it."));
+#endif
+}
+
+void GraphicEngine::GUI::ProfilerWindow::draw()
+{
+	m_container->draw();
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "../Widgets/CollapsingHeader.hpp"
+#include "../../../Core/Configuration.hpp"
+#include "../../../Core/Profiler.hpp"
+
+namespace GraphicEngine::GUI
+{
+	class ProfilerWindow : public Widget
+	{
+	public:
+		ProfilerWindow(std::shared_ptr<Core::Profiler> profiler, std::shared_ptr<Core::Configuration> cfg);
+	protected:
+		// Inherited via Widget
+		virtual void draw() override;
+
+		std::shared_ptr<Core::Profiler> m_profiler;
+		std::shared_ptr<CollapsingHeader> m_container;
+		std::string m_tracePath;
+	};
+}
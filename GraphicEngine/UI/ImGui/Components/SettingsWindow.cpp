@@ -1,7 +1,7 @@
 #include "SettingsWindow.hpp"
 
 GraphicEngine::GUI::SettingWindow::SettingWindow(std::shared_ptr<ViewportSettingWindow> settingWindow, std::shared_ptr<RenderingSettingsWindow> renderingSettingWindow, std::shared_ptr<CameraManagerWindow> cameraManagerWindow, std::shared_ptr<LightManagerWindow> lightManager,
-	std::shared_ptr<WindManagerWindow> windManagerWindow)
+	std::shared_ptr<WindManagerWindow> windManagerWindow, std::shared_ptr<ProfilerWindow> profilerWindow)
 {
 	m_body = std::make_shared<WindowBody>("Settings");
 	m_body->addChildren(settingWindow);
@@ -9,6 +9,7 @@ GraphicEngine::GUI::SettingWindow::SettingWindow(std::shared_ptr<ViewportSetting
 	m_body->addChildren(cameraManagerWindow);
 	m_body->addChildren(lightManager);
 	m_body->addChildren(windManagerWindow);
+	m_body->addChildren(profilerWindow);
 }
 
 void GraphicEngine::GUI::SettingWindow::init()
@@ -6,6 +6,7 @@
 #include "ViewportSettingsWindow.hpp"
 #include "RenderingSettingsWindow.hpp"
 #include "WindManagerWindow.hpp"
+#include "ProfilerWindow.hpp"
 
 namespace GraphicEngine::GUI
 {
@@ -13,7 +14,7 @@ namespace GraphicEngine::GUI
 	{
 	public:
 		SettingWindow(std::shared_ptr<ViewportSettingWindow> settingWindow, std::shared_ptr<RenderingSettingsWindow> renderingSettingWindow, std::shared_ptr<CameraManagerWindow> cameraManagerWindow, std::shared_ptr<LightManagerWindow> lightManager,
-			std::shared_ptr<WindManagerWindow> windManagerWindow);
+			std::shared_ptr<WindManagerWindow> windManagerWindow, std::shared_ptr<ProfilerWindow> profilerWindow);
 
 		virtual void init() override;
 	protected:
@@ -102,6 +102,29 @@ void GraphicEngine::GUI::ImGuiImpl::GlfwVulkanEngineBackend::initialize()
 	ImGui_ImplGlfw_InitForVulkan(window.get(), true);
 }
 
+GraphicEngine::GUI::ImGuiImpl::HeadlessEngineBackend::HeadlessEngineBackend(float width, float height, float deltaTime) :
+	width{ width },
+	height{ height },
+	deltaTime{ deltaTime }
+{
+}
+
+void GraphicEngine::GUI::ImGuiImpl::HeadlessEngineBackend::initialize()
+{
+	nextFrame();
+}
+
+void GraphicEngine::GUI::ImGuiImpl::HeadlessEngineBackend::nextFrame()
+{
+	ImGuiIO& io = ImGui::GetIO();
+	io.DisplaySize = ImVec2(width, height);
+	io.DeltaTime = deltaTime;
+}
+
+void GraphicEngine::GUI::ImGuiImpl::HeadlessEngineBackend::shutdown()
+{
+}
+
 GraphicEngine::GUI::ImGuiImpl::VulkanRenderEngineBackend::VulkanRenderEngineBackend(std::shared_ptr<Vulkan::VulkanFramework> framework) :
 	m_framework{ framework }
 {
@@ -110,8 +133,6 @@ GraphicEngine::GUI::ImGuiImpl::VulkanRenderEngineBackend::VulkanRenderEngineBack
 void GraphicEngine::GUI::ImGuiImpl::VulkanRenderEngineBackend::initialize()
 {
 	// TODO: Create specific render pass for UI
-	m_pipelineCache = m_framework->m_device->createPipelineCacheUnique(vk::PipelineCacheCreateInfo());
-
 	m_descriptorPool = Vulkan::createDescriptorPool(m_framework->m_device,
 		{
 			vk::DescriptorPoolSize(vk::DescriptorType::eSampler, 1000),
@@ -133,7 +154,7 @@ void GraphicEngine::GUI::ImGuiImpl::VulkanRenderEngineBackend::initialize()
 	init_info.Device = m_framework->m_device.get();
 	init_info.QueueFamily = m_framework->m_indices.graphicsFamily.value();
 	init_info.Queue = m_framework->m_graphicQueue;
-	init_info.PipelineCache = m_pipelineCache.get();
+	init_info.PipelineCache = m_framework->m_pipelineCache.get();
 	init_info.DescriptorPool = m_descriptorPool.get();
 	init_info.Allocator = nullptr;
 	init_info.MinImageCount = m_framework->m_maxFrames;
@@ -44,6 +44,21 @@ namespace GraphicEngine::GUI
 			virtual ~GlfwVulkanEngineBackend() = default;
 		};
 
+		// Window backend without platform window, display size and time step are fixed
+		struct HeadlessEngineBackend : EngineBackend
+		{
+			HeadlessEngineBackend(float width, float height, float deltaTime);
+			virtual void initialize() override;
+			virtual void nextFrame() override;
+			virtual void shutdown() override;
+			virtual ~HeadlessEngineBackend() = default;
+
+		protected:
+			float width;
+			float height;
+			float deltaTime;
+		};
+
 		struct VulkanRenderEngineBackend : RenderEngineBackend<VulkanRenderEngineBackend, vk::UniqueCommandBuffer&>
 		{
 			VulkanRenderEngineBackend(std::shared_ptr<Vulkan::VulkanFramework> framework);
@@ -54,7 +69,6 @@ namespace GraphicEngine::GUI
 
 		private:
 			vk::UniqueDescriptorPool m_descriptorPool;
-			vk::UniquePipelineCache m_pipelineCache;
 			std::shared_ptr<Vulkan::VulkanFramework> m_framework;
 		};
 
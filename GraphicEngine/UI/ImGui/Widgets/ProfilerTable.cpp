@@ -0,0 +1,35 @@
+#include "ProfilerTable.hpp"
+#include <imgui.h>
+
+GraphicEngine::GUI::ProfilerTable::ProfilerTable(std::string label, std::shared_ptr<Core::Profiler> profiler) :
+	Widget{ label },
+	m_profiler{ profiler }
+{
+}
+
+void GraphicEngine::GUI::ProfilerTable::draw()
+{
+	if (ImGui::BeginTable(label.c_str(), 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("Zone [ms]");
+		ImGui::TableSetupColumn("last");
+		ImGui::TableSetupColumn("avg");
+		ImGui::TableSetupColumn("p50");
+		ImGui::TableSetupColumn("p95");
+		ImGui::TableSetupColumn("p99");
+		ImGui::TableHeadersRow();
+
+		for (const auto& zone : m_profiler->getStatistics())
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%s %s", zone.gpu ? "GPU" : "CPU", zone.name.c_str());
+			for (double value : { zone.last, zone.average, zone.p50, zone.p95, zone.p99 })
+			{
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", value);
+			}
+		}
+		ImGui::EndTable();
+	}
+}
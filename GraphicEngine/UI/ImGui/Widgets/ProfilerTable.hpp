@@ -0,0 +1,18 @@
+#pragma once
+
+#include "../../../Common/Widget.hpp"
+#include "../../../Core/Profiler.hpp"
+
+namespace GraphicEngine::GUI
+{
+	class ProfilerTable : public Widget
+	{
+	public:
+		ProfilerTable(std::string label, std::shared_ptr<Core::Profiler> profiler);
+
+		// Inherited via Widget
+		virtual void draw() override;
+	private:
+		std::shared_ptr<Core::Profiler> m_profiler;
+	};
+}
@@ -0,0 +1,318 @@
+#include <benchmark/benchmark.h>
+
+#include "../GraphicEngine/Common/Vertex.hpp"
+#include "../GraphicEngine/Core/Math/Geometry/3D/BoudingBox3D.hpp"
+#include "../GraphicEngine/Core/Math/Geometry/3D/BoudingBox3D.cpp"
+#include "../GraphicEngine/Core/Math/Geometry/3D/Octree.hpp"
+#include "../GraphicEngine/Core/Math/GeometryUtils.hpp"
+#include "../GraphicEngine/Core/Math/GeometryUtils.cpp"
+#include "../GraphicEngine/Core/Math/ImageUtils.cpp"
+#include "../GraphicEngine/Core/Math/MeshSimplifier.cpp"
+#include "../GraphicEngine/Core/Math/VertexCacheOptimizer.cpp"
+#include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/ConeGenerator.hpp"
+#include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/CuboidGenerator.hpp"
+#include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/PlaneGenerator.hpp"
+#include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/SphereGenerator.hpp"
+#include "../GraphicEngine/Scene/Resources/Transformation.cpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace GraphicEngine::Common;
+using namespace GraphicEngine::Core;
+using namespace GraphicEngine::Engines::Graphic;
+
+// Sizes are vertices (or points, boxes, polygons) count, shared_ptr based structures are capped lower to fit in memory
+namespace
+{
+	const glm::vec3 areaBegin{ -100.0f };
+	const glm::vec3 areaEnd{ 100.0f };
+
+	std::vector<glm::vec3> randomPoints(int64_t count)
+	{
+		std::mt19937 generator(42);
+		std::uniform_real_distribution<float> distribution(areaBegin.x, areaEnd.x);
+		std::vector<glm::vec3> points(static_cast<size_t>(count));
+		for (auto& point : points)
+		{
+			point = glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+		}
+		return points;
+	}
+
+	std::vector<std::shared_ptr<VertexPN>> randomVertices(int64_t count)
+	{
+		std::vector<std::shared_ptr<VertexPN>> vertices;
+		vertices.reserve(static_cast<size_t>(count));
+		for (const auto& point : randomPoints(count))
+		{
+			auto vertex = std::make_shared<VertexPN>();
+			vertex->position = point;
+			vertices.push_back(vertex);
+		}
+		return vertices;
+	}
+
+	// Segments of square grid which has about given number of vertices
+	int gridScale(int64_t vertices)
+	{
+		return std::max(1, static_cast<int>(std::sqrt(static_cast<double>(vertices))) - 1);
+	}
+
+	std::shared_ptr<GraphicEngine::Scene::Mesh<VertexPN>> createPlaneMesh(int64_t vertices)
+	{
+		auto [planeVertices, faces, boudingBox, center] = PlaneGenerator<VertexPN>{}.getObject(glm::vec2(-10.0f), glm::vec2(10.0f), glm::ivec2(gridScale(vertices)));
+		return std::make_shared<GraphicEngine::Scene::Mesh<VertexPN>>(planeVertices, faces, boudingBox);
+	}
+}
+
+static void BoudingBox3D_ExtendBox(benchmark::State& state)
+{
+	auto points = randomPoints(state.range(0));
+	for (auto _ : state)
+	{
+		BoudingBox3D boudingBox;
+		for (const auto& point : points)
+		{
+			boudingBox.extendBox(point);
+		}
+		benchmark::DoNotOptimize(boudingBox.getCenter());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BoudingBox3D_ExtendBox)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond);
+
+static void BoudingBox3D_IsPointInside(benchmark::State& state)
+{
+	auto points = randomPoints(state.range(0));
+	BoudingBox3D boudingBox(glm::vec3(-50.0f), glm::vec3(50.0f));
+	for (auto _ : state)
+	{
+		int64_t inside{ 0 };
+		for (const auto& point : points)
+		{
+			inside += boudingBox.isPointInside(point);
+		}
+		benchmark::DoNotOptimize(inside);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BoudingBox3D_IsPointInside)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond);
+
+static void BoudingBox3D_Transform(benchmark::State& state)
+{
+	auto points = randomPoints(state.range(0));
+	std::vector<BoudingBox3D> boudingBoxes;
+	boudingBoxes.reserve(points.size());
+	for (const auto& point : points)
+	{
+		boudingBoxes.emplace_back(point, point + glm::vec3(1.0f));
+	}
+
+	auto modelMatrix = glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 3.0f)), glm::radians(30.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	for (auto _ : state)
+	{
+		for (auto& boudingBox : boudingBoxes)
+		{
+			boudingBox.transform(modelMatrix);
+		}
+		benchmark::DoNotOptimize(boudingBoxes.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BoudingBox3D_Transform)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+
+// Same call pattern as Mesh::generateNormals, polygon is copied into vector before every call
+static void Geometry_CalculateNormalFromPolygon(benchmark::State& state)
+{
+	int64_t corners = state.range(1);
+	auto points = randomPoints(state.range(0) * corners);
+	std::vector<glm::vec3> polygon(static_cast<size_t>(corners));
+	for (auto _ : state)
+	{
+		glm::vec3 sum(0.0f);
+		for (size_t i{ 0 }; i < points.size(); i += corners)
+		{
+			std::copy(std::begin(points) + i, std::begin(points) + i + corners, std::begin(polygon));
+			sum += Math::calculateNormalFromPolygon(polygon);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Geometry_CalculateNormalFromPolygon)->ArgsProduct({ { 1000, 10000, 100000, 1000000 }, { 3, 4 } })->Unit(benchmark::kMicrosecond);
+
+static void Mesh_GetGeometryIndices(benchmark::State& state)
+{
+	auto mesh = createPlaneMesh(state.range(0));
+	for (auto _ : state)
+	{
+		auto indices = mesh->getGeometryIndices();
+		benchmark::DoNotOptimize(indices.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Mesh_GetGeometryIndices)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+
+static void Mesh_GetWireframeIndices(benchmark::State& state)
+{
+	auto mesh = createPlaneMesh(state.range(0));
+	for (auto _ : state)
+	{
+		auto indices = mesh->getWireframeIndices();
+		benchmark::DoNotOptimize(indices.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Mesh_GetWireframeIndices)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void Mesh_GenerateNormals(benchmark::State& state)
+{
+	auto mesh = createPlaneMesh(state.range(0));
+	for (auto _ : state)
+	{
+		mesh->generateNormals();
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Mesh_GenerateNormals)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+template <int Levels>
+static void Octree_Build(benchmark::State& state)
+{
+	auto vertices = randomVertices(state.range(0));
+	BoudingBox3D boudingBox(areaBegin, areaEnd);
+	for (auto _ : state)
+	{
+		Octree<VertexPN, Levels> octree(boudingBox, vertices);
+		benchmark::DoNotOptimize(&octree);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(Octree_Build, 0)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Octree_Build, 4)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+
+static void Octree_FindNode(benchmark::State& state)
+{
+	auto vertices = randomVertices(state.range(0));
+	Octree<VertexPN> octree(BoudingBox3D(areaBegin, areaEnd), vertices);
+	for (auto _ : state)
+	{
+		for (const auto& vertex : vertices)
+		{
+			auto [node, level] = octree.findNode(vertex);
+			benchmark::DoNotOptimize(node);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Octree_FindNode)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+
+// Sphere rings are wider than cache, so its generated order is what optimization starts from
+static void VertexCache_Optimize(benchmark::State& state)
+{
+	int scale = gridScale(state.range(0));
+	auto buffers = SphereGenerator<VertexPN>{}.getBuffers(glm::vec3(0.0f), 1.0f, glm::ivec2(scale));
+	std::vector<uint32_t> indices;
+	for (auto _ : state)
+	{
+		indices = GraphicEngine::Core::Math::optimizeVertexCache(buffers.indices, buffers.vertices.size());
+		benchmark::DoNotOptimize(indices.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.counters["ACMR before"] = GraphicEngine::Core::Math::calculateACMR(buffers.indices, buffers.vertices.size());
+	state.counters["ACMR after"] = GraphicEngine::Core::Math::calculateACMR(indices, buffers.vertices.size());
+}
+BENCHMARK(VertexCache_Optimize)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+// Second argument is reduction in percent, error counter is relative to bouding box diagonal
+static void MeshSimplifier_Simplify(benchmark::State& state)
+{
+	int scale = gridScale(state.range(0));
+	auto buffers = SphereGenerator<VertexPN>{}.getBuffers(glm::vec3(0.0f), 1.0f, glm::ivec2(scale));
+	std::vector<glm::vec3> positions;
+	positions.reserve(buffers.vertices.size());
+	for (const auto& vertex : buffers.vertices)
+	{
+		positions.push_back(vertex.position);
+	}
+
+	size_t targetIndices = 3 * (buffers.indices.size() / 3 * state.range(1) / 100);
+	GraphicEngine::Core::Math::SimplifiedMesh simplified;
+	for (auto _ : state)
+	{
+		simplified = GraphicEngine::Core::Math::simplifyMesh(positions, buffers.indices, targetIndices);
+		benchmark::DoNotOptimize(simplified.indices.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.counters["triangles"] = static_cast<double>(simplified.indices.size() / 3);
+	state.counters["error"] = simplified.error;
+}
+BENCHMARK(MeshSimplifier_Simplify)->ArgsProduct({ { 1000, 10000, 100000, 1000000 }, { 50, 10 } })->Unit(benchmark::kMillisecond);
+
+static void ObjectGenerator_Plane(benchmark::State& state)
+{
+	int scale = gridScale(state.range(0));
+	for (auto _ : state)
+	{
+		auto object = PlaneGenerator<VertexPN>{}.getBuffers(glm::vec2(-10.0f), glm::vec2(10.0f), glm::ivec2(scale));
+		benchmark::DoNotOptimize(&object);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Last size is 4096x4096 terrain
+BENCHMARK(ObjectGenerator_Plane)->RangeMultiplier(10)->Range(1000, 10000000)->Arg(4097 * 4097)->Unit(benchmark::kMillisecond);
+
+static void ObjectGenerator_Sphere(benchmark::State& state)
+{
+	int scale = gridScale(state.range(0));
+	for (auto _ : state)
+	{
+		auto object = SphereGenerator<VertexPN>{}.getBuffers(glm::vec3(0.0f), 1.0f, glm::ivec2(scale));
+		benchmark::DoNotOptimize(&object);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ObjectGenerator_Sphere)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void ObjectGenerator_Cuboid(benchmark::State& state)
+{
+	// Six faces share vertices count
+	int scale = gridScale(state.range(0) / 6);
+	for (auto _ : state)
+	{
+		auto object = CuboidGenerator<VertexPN>{}.getBuffers(glm::vec3(-1.0f), glm::vec3(1.0f), glm::ivec3(scale));
+		benchmark::DoNotOptimize(&object);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ObjectGenerator_Cuboid)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void ObjectGenerator_Cone(benchmark::State& state)
+{
+	// Bottom disc and side get half of vertices each
+	int scale = gridScale(state.range(0) / 2);
+	for (auto _ : state)
+	{
+		auto object = ConeGenerator<VertexPN>{}.getBuffers(glm::vec3(0.0f), 1.0f, 2.0f, glm::ivec3(scale));
+		benchmark::DoNotOptimize(&object);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ObjectGenerator_Cone)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+// Mesh creation includes normals and octree generation
+static void ObjectGenerator_PlaneMesh(benchmark::State& state)
+{
+	int scale = gridScale(state.range(0));
+	for (auto _ : state)
+	{
+		auto mesh = PlaneGenerator<VertexPN>{}.getMesh(glm::vec2(-10.0f), glm::vec2(10.0f), glm::ivec2(scale), GeneratingPosition::Corner, TriangleDirection::CounterClockwise);
+		benchmark::DoNotOptimize(mesh.get());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ObjectGenerator_PlaneMesh)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include "../GraphicEngine/Core/Configuration.cpp"
+#include "../GraphicEngine/Engines/Graphic/3D/LightClusterGrid.hpp"
+#include "../GraphicEngine/Engines/Graphic/3D/LightClusterGrid.cpp"
+#include "../GraphicEngine/Engines/Graphic/Shaders/Models/Light.cpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+using namespace GraphicEngine::Engines::Graphic;
+using namespace GraphicEngine::Engines::Graphic::Shaders;
+
+static void LightClusterGrid_Build(benchmark::State& state)
+{
+	LightClusterGrid grid(16, 9, 24);
+	float fov{ 45.0f };
+	for (auto _ : state)
+	{
+		// Force rebuild on every iteration
+		fov = fov == 45.0f ? 46.0f : 45.0f;
+		grid.build(glm::perspective(glm::radians(fov), 16.0f / 9.0f, 0.1f, 1000.0f), 1920.0f, 1080.0f);
+		benchmark::DoNotOptimize(grid.getClusterBounds(0));
+	}
+}
+BENCHMARK(LightClusterGrid_Build);
+
+static void LightClusterGrid_AssignLights(benchmark::State& state)
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> distribution(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> angle(5.0f, 40.0f);
+
+	std::vector<PointLight> pointLights;
+	std::vector<SpotLight> spotLights;
+	for (int64_t i{ 0 }; i < state.range(0); ++i)
+	{
+		glm::vec4 position(distribution(generator), distribution(generator), distribution(generator), 1.0f);
+		if (i % 4 == 0)
+		{
+			float outterAngle = angle(generator);
+			spotLights.emplace_back(position, glm::vec4(0.0f, -1.0f, 0.0f, 1.0f), glm::cos(glm::radians(outterAngle * 0.8f)), glm::cos(glm::radians(outterAngle)),
+				1.0f, 0.14f, 0.07f, LightColor());
+		}
+		else
+		{
+			pointLights.emplace_back(position, 1.0f, 0.35f, 0.44f, LightColor());
+		}
+	}
+
+	LightClusterGrid grid(16, 9, 24);
+	grid.build(glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f), 1920.0f, 1080.0f);
+	glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 10.0f, 60.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+	for (auto _ : state)
+	{
+		grid.assignLights(view, pointLights, spotLights);
+		benchmark::DoNotOptimize(grid.getLightIndices().data());
+	}
+
+	state.counters["indices"] = static_cast<double>(grid.getLightIndices().size());
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(LightClusterGrid_AssignLights)->Arg(128)->Arg(1000)->Arg(4096)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include "../GraphicEngine/Engines/Graphic/2D/WindGenerator.hpp"
+#include "../GraphicEngine/Engines/Graphic/2D/WindGenerator.cpp"
+
+#include <vector>
+
+using namespace GraphicEngine::Engines::Graphic;
+
+static void WindGenerator_Generate(benchmark::State& state)
+{
+	uint32_t dim = static_cast<uint32_t>(state.range(0));
+	WindGenerator::setAvx2Enabled(state.range(1) != 0);
+	std::vector<uint8_t> data(static_cast<size_t>(dim) * dim * 4);
+	float time{ 0.0f };
+	for (auto _ : state)
+	{
+		WindGenerator::generate(data.data(), dim, 0.75f, time);
+		time += 0.016f;
+		benchmark::DoNotOptimize(data.data());
+	}
+	state.SetItemsProcessed(state.iterations() * dim * dim);
+	WindGenerator::setAvx2Enabled(true);
+}
+BENCHMARK(WindGenerator_Generate)->Args({ 1024, 0 })->Args({ 1024, 1 })->Unit(benchmark::kMillisecond);
+
+// Band of rows regenerated every frame to animate gusts
+static void WindGenerator_GenerateRows(benchmark::State& state)
+{
+	const uint32_t dim{ 1024 };
+	uint32_t rowsCount = static_cast<uint32_t>(state.range(0));
+	std::vector<uint8_t> data(static_cast<size_t>(dim) * dim * 4);
+	uint32_t firstRow{ 0 };
+	float time{ 0.0f };
+	for (auto _ : state)
+	{
+		WindGenerator::generate(data.data(), dim, 0.75f, time, firstRow, rowsCount);
+		firstRow = (firstRow + rowsCount) % dim;
+		time += 0.016f;
+		benchmark::DoNotOptimize(data.data());
+	}
+	state.SetItemsProcessed(state.iterations() * dim * rowsCount);
+}
+BENCHMARK(WindGenerator_GenerateRows)->Arg(16)->Arg(64)->Unit(benchmark::kMicrosecond);
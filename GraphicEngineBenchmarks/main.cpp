@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+	const std::string baselineFlag{ "--baseline=" };
+	const std::string thresholdFlag{ "--baseline_threshold=" };
+	constexpr double defaultThreshold{ 0.1 };
+
+	const std::map<std::string, double> timeUnitSeconds{ { "ns", 1e-9 }, { "us", 1e-6 }, { "ms", 1e-3 }, { "s", 1.0 } };
+
+	// Console output stays unchanged, cpu time of every run is kept for comparison with baseline
+	class BaselineReporter : public benchmark::ConsoleReporter
+	{
+	public:
+		void ReportRuns(const std::vector<Run>& reports) override
+		{
+			for (const auto& run : reports)
+			{
+				if (run.run_type == Run::RT_Iteration && !run.error_occurred)
+				{
+					m_cpuSeconds[run.benchmark_name()] = run.GetAdjustedCPUTime() / benchmark::GetTimeUnitMultiplier(run.time_unit);
+				}
+			}
+			ConsoleReporter::ReportRuns(reports);
+		}
+
+		const std::map<std::string, double>& getCpuSeconds() const
+		{
+			return m_cpuSeconds;
+		}
+
+	private:
+		std::map<std::string, double> m_cpuSeconds;
+	};
+
+	bool compareWithBaseline(const std::map<std::string, double>& cpuSeconds, const std::string& baselinePath, double threshold)
+	{
+		std::ifstream file(baselinePath);
+		if (!file.is_open())
+		{
+			std::cerr << "Baseline " << baselinePath << " can not be opened" << std::endl;
+			return false;
+		}
+		auto baseline = nlohmann::json::parse(file);
+
+		size_t compared{ 0 };
+		size_t regressions{ 0 };
+		for (const auto& entry : baseline.at("benchmarks"))
+		{
+			// Benchmarks skipped by --benchmark_filter are not compared
+			auto current = cpuSeconds.find(entry.at("name").get<std::string>());
+			if (entry.value("run_type", "iteration") != "iteration" || current == std::end(cpuSeconds))
+				continue;
+
+			double baselineSeconds = entry.at("cpu_time").get<double>() * timeUnitSeconds.at(entry.at("time_unit").get<std::string>());
+			double change = current->second / baselineSeconds - 1.0;
+			++compared;
+			if (change > threshold)
+			{
+				++regressions;
+				std::cout << "Regression: " << current->first << " is " << change * 100.0 << "% slower than baseline" << std::endl;
+			}
+		}
+
+		std::cout << regressions << " of " << compared << " benchmarks are slower than " << baselinePath << " by more than " << threshold * 100.0 << "%" << std::endl;
+		return regressions == 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	// Baseline flags are taken out before google benchmark rejects them as unrecognized
+	std::string baselinePath;
+	double threshold{ defaultThreshold };
+	std::vector<char*> arguments;
+	for (int i = 0; i < argc; ++i)
+	{
+		std::string argument{ argv[i] };
+		if (argument.compare(0, baselineFlag.size(), baselineFlag) == 0)
+			baselinePath = argument.substr(baselineFlag.size());
+		else if (argument.compare(0, thresholdFlag.size(), thresholdFlag) == 0)
+			threshold = std::stod(argument.substr(thresholdFlag.size()));
+		else
+			arguments.push_back(argv[i]);
+	}
+	int argumentsCount = static_cast<int>(arguments.size());
+
+	benchmark::Initialize(&argumentsCount, arguments.data());
+	if (benchmark::ReportUnrecognizedArguments(argumentsCount, arguments.data()))
+		return 1;
+
+	BaselineReporter reporter;
+	benchmark::RunSpecifiedBenchmarks(&reporter);
+	benchmark::Shutdown();
+
+	if (baselinePath.empty())
+		return 0;
+	return compareWithBaseline(reporter.getCpuSeconds(), baselinePath, threshold) ? 0 : 1;
+}
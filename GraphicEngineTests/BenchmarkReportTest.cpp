@@ -0,0 +1,90 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Common/CameraPath.hpp"
+#include "../GraphicEngine/Common/CameraPath.cpp"
+#include "../GraphicEngine/Core/BenchmarkReport.hpp"
+#include "../GraphicEngine/Core/BenchmarkReport.cpp"
+
+using namespace GraphicEngine::Common;
+using namespace GraphicEngine::Core;
+
+namespace
+{
+	ProfilerZoneStatistics zone(const std::string& name, bool gpu, double value)
+	{
+		return ProfilerZoneStatistics{ name, gpu, value, value, value, value, value };
+	}
+
+	BenchmarkReport createReport(double frame, double pass, double drawCalls)
+	{
+		BenchmarkReport report(nlohmann::json::object({ { "engine", "opengl" } }));
+		report.addPath("orbit", 240, { zone("Frame", false, frame), zone("Pass", true, pass), zone("Tiny", false, 0.01 * frame) }, { zone("Draw calls", false, drawCalls) });
+		return report;
+	}
+}
+
+TEST(CameraPath, KeysAreSpreadOverFrames)
+{
+	CameraPath path("line", 5, { { glm::vec3(0.0f), glm::vec3(1.0f) }, { glm::vec3(2.0f), glm::vec3(3.0f) }, { glm::vec3(4.0f), glm::vec3(5.0f) } });
+
+	EXPECT_EQ(path.sample(0).position, glm::vec3(0.0f));
+	EXPECT_EQ(path.sample(1).position, glm::vec3(1.0f));
+	EXPECT_EQ(path.sample(2).position, glm::vec3(2.0f));
+	EXPECT_EQ(path.sample(3).target, glm::vec3(4.0f));
+	EXPECT_EQ(path.sample(4).position, glm::vec3(4.0f));
+	// Frames after the end stay at last key
+	EXPECT_EQ(path.sample(10).target, glm::vec3(5.0f));
+}
+
+TEST(CameraPath, EmptyPathThrows)
+{
+	EXPECT_THROW(CameraPath("empty", 10, {}), std::invalid_argument);
+	EXPECT_THROW(CameraPath("still", 0, { { glm::vec3(0.0f), glm::vec3(1.0f) } }), std::invalid_argument);
+}
+
+TEST(BenchmarkReport, PathsAreGroupedByTimerAndCounters)
+{
+	auto json = createReport(10.0, 4.0, 100.0).toJson();
+
+	EXPECT_EQ(json["version"], BenchmarkReport::version);
+	EXPECT_EQ(json["description"]["engine"], "opengl");
+	const auto& orbit = json["paths"]["orbit"];
+	EXPECT_EQ(orbit["frames"], 240);
+	EXPECT_DOUBLE_EQ(orbit["cpu"]["Frame"]["p50"].get<double>(), 10.0);
+	EXPECT_FALSE(orbit["cpu"].contains("Pass"));
+	EXPECT_DOUBLE_EQ(orbit["gpu"]["Pass"]["p95"].get<double>(), 4.0);
+	EXPECT_DOUBLE_EQ(orbit["counters"]["Draw calls"]["average"].get<double>(), 100.0);
+	EXPECT_TRUE(json["regressions"].empty());
+}
+
+TEST(BenchmarkReport, GrowthAboveThresholdIsRegression)
+{
+	auto baseline = createReport(10.0, 4.0, 100.0).toJson();
+	auto report = createReport(10.5, 5.0, 120.0);
+
+	auto regressions = report.compare(baseline, BenchmarkThresholds{ 0.1, 0.1, 0.05, 0.5 });
+	ASSERT_EQ(regressions.size(), 2);
+	EXPECT_EQ(regressions[0].group, "gpu");
+	EXPECT_EQ(regressions[0].name, "Pass");
+	EXPECT_DOUBLE_EQ(regressions[0].change, 0.25);
+	EXPECT_EQ(regressions[1].group, "counters");
+	EXPECT_EQ(regressions[1].name, "Draw calls");
+	EXPECT_EQ(report.toJson()["regressions"].size(), 2);
+}
+
+TEST(BenchmarkReport, ImprovementsAndShortZonesAreNotRegressions)
+{
+	auto baseline = createReport(10.0, 4.0, 100.0).toJson();
+	// Tiny zone doubles but stays below minimum time
+	auto report = createReport(20.0, 2.0, 50.0);
+
+	auto regressions = report.compare(baseline, BenchmarkThresholds{ 0.1, 0.1, 0.05, 0.5 });
+	ASSERT_EQ(regressions.size(), 1);
+	EXPECT_EQ(regressions[0].name, "Frame");
+}
+
+TEST(BenchmarkReport, UnknownBaselineFormatThrows)
+{
+	auto report = createReport(10.0, 4.0, 100.0);
+	EXPECT_THROW(report.compare(nlohmann::json{ { "paths", nlohmann::json::object() } }, BenchmarkThresholds{}), std::runtime_error);
+}
@@ -56,4 +56,15 @@ TEST(BoudingBox, BoudingBoxTranslateTransform)
 
 	EXPECT_EQ(boudingBox.getLeft(), glm::vec3(0.0f));
 	EXPECT_EQ(boudingBox.getRight(), glm::vec3(1.0f));
-}
\ No newline at end of file
+}
+
+TEST(BoudingBox, ProjectedSizeShrinksWithDistance)
+{
+	BoudingBox3D boudingBox(glm::vec3(-1.0f), glm::vec3(1.0f));
+	auto projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+
+	// Box fills whole viewport when its front face is at distance equal to half of its size
+	EXPECT_NEAR(boudingBox.getProjectedSize(projection * glm::translate(glm::vec3(0.0f, 0.0f, -2.0f))), 1.0f, 1e-4f);
+	EXPECT_NEAR(boudingBox.getProjectedSize(projection * glm::translate(glm::vec3(0.0f, 0.0f, -11.0f))), 0.1f, 1e-4f);
+	EXPECT_TRUE(std::isinf(boudingBox.getProjectedSize(projection)));
+}
@@ -0,0 +1,153 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Core/Math/DrawCulling.hpp"
+#include "../GraphicEngine/Core/Math/DrawCulling.cpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace GraphicEngine::Core::Math;
+using namespace GraphicEngine::Common;
+
+namespace
+{
+	// Camera at origin looking down negative z
+	glm::mat4 viewProjection()
+	{
+		return glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 100.0f) * glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	}
+
+	// Depth buffer filled by wall at given distance from camera
+	DepthPyramid wall(float distance)
+	{
+		glm::vec4 clip = viewProjection() * glm::vec4(0.0f, 0.0f, -distance, 1.0f);
+		return buildDepthPyramid(std::vector<float>(64 * 48, clip.z / clip.w), 64, 48);
+	}
+
+	CullingDraw sphereDraw(glm::vec3 center, float radius, uint32_t objectIndex, uint32_t firstIndex, uint32_t lod = 0)
+	{
+		CullingDraw draw;
+		draw.center = center;
+		draw.radius = radius;
+		draw.objectIndex = objectIndex;
+		draw.firstIndex = firstIndex;
+		draw.indexCount = 3;
+		draw.lod = lod;
+		return draw;
+	}
+}
+
+TEST(DrawCulling, Depth_pyramid_keeps_farthest_depth)
+{
+	std::vector<float> depth(5 * 3, 0.1f);
+	depth[2 * 5 + 4] = 0.9f;
+	auto depthPyramid = buildDepthPyramid(depth, 5, 3);
+
+	ASSERT_EQ(depthPyramid.getLevelsCount(), 3);
+	EXPECT_EQ(depthPyramid.sizes[1], glm::uvec2(2, 1));
+	EXPECT_EQ(depthPyramid.sizes[2], glm::uvec2(1, 1));
+	// Last odd row and column are merged into last texel
+	EXPECT_FLOAT_EQ(depthPyramid.getDepth(1, 0, 0), 0.1f);
+	EXPECT_FLOAT_EQ(depthPyramid.getDepth(1, 1, 0), 0.9f);
+	EXPECT_FLOAT_EQ(depthPyramid.getDepth(2, 0, 0), 0.9f);
+
+	EXPECT_THROW(buildDepthPyramid(depth, 4, 3), std::invalid_argument);
+}
+
+TEST(DrawCulling, Only_spheres_behind_depth_are_occluded)
+{
+	auto depthPyramid = wall(10.0f);
+
+	EXPECT_TRUE(isSphereOccluded(glm::vec3(0.0f, 0.0f, -30.0f), 2.0f, viewProjection(), depthPyramid));
+	EXPECT_FALSE(isSphereOccluded(glm::vec3(0.0f, 0.0f, -5.0f), 2.0f, viewProjection(), depthPyramid));
+	// Sphere reaching through wall is visible
+	EXPECT_FALSE(isSphereOccluded(glm::vec3(0.0f, 0.0f, -11.0f), 2.0f, viewProjection(), depthPyramid));
+	// Sphere around camera crosses near plane
+	EXPECT_FALSE(isSphereOccluded(glm::vec3(0.0f, 0.0f, 0.0f), 2.0f, viewProjection(), buildDepthPyramid(std::vector<float>(64 * 48, 0.0f), 64, 48)));
+}
+
+TEST(DrawCulling, Visible_draws_are_compacted_in_their_batches)
+{
+	std::vector<CullingDraw> draws =
+	{
+		sphereDraw(glm::vec3(0.0f, 0.0f, -5.0f), 1.0f, 0, 0),
+		sphereDraw(glm::vec3(0.0f, 0.0f, 50.0f), 1.0f, 0, 3),
+		sphereDraw(glm::vec3(1.0f, 0.0f, -5.0f), 1.0f, 0, 6),
+		sphereDraw(glm::vec3(0.0f, 0.0f, -5.0f), 1.0f, 1, 0),
+		sphereDraw(glm::vec3(0.0f, 0.0f, -5.0f), 1.0f, removedCullingObject, 0)
+	};
+	std::vector<CullingObject> objects(2);
+	objects[0].firstIndex = 30;
+	objects[0].vertexOffset = 100;
+	objects[1].batch = 1;
+	std::vector<glm::mat4> modelMatrices(2, glm::mat4(1.0f));
+	std::vector<DrawElementsCommand> commands(draws.size());
+	std::vector<uint32_t> counts(2, 7);
+
+	cullDraws(draws, objects, modelMatrices, viewProjection(), glm::vec3(0.0f), nullptr, glm::mat4(1.0f), { 0, 3 }, commands, counts);
+
+	EXPECT_EQ(counts, std::vector<uint32_t>({ 2, 1 }));
+	EXPECT_EQ(commands[0].firstIndex, 30);
+	EXPECT_EQ(commands[1].firstIndex, 36);
+	EXPECT_EQ(commands[1].indexCount, 3);
+	EXPECT_EQ(commands[1].instanceCount, 1);
+	EXPECT_EQ(commands[1].vertexOffset, 100);
+	EXPECT_EQ(commands[1].firstInstance, 0);
+	EXPECT_EQ(commands[3].firstIndex, 0);
+	EXPECT_EQ(commands[3].firstInstance, 1);
+}
+
+TEST(DrawCulling, Draws_are_tested_in_space_of_mesh)
+{
+	// Object is moved in front of camera and mesh is stretched, so draw behind camera in space of mesh is visible
+	std::vector<CullingDraw> draws = { sphereDraw(glm::vec3(0.0f, 0.0f, 1.0f), 0.5f, 0, 0) };
+	draws[0].coneApex = draws[0].center;
+	draws[0].coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+	draws[0].coneCutoff = 0.5f;
+	std::vector<CullingObject> objects(1);
+	objects[0].meshMatrix = glm::scale(glm::mat4(1.0f), glm::vec3(1.0f, 1.0f, 4.0f));
+	std::vector<glm::mat4> modelMatrices = { glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -20.0f)) };
+	std::vector<DrawElementsCommand> commands(1);
+	std::vector<uint32_t> counts(1);
+
+	cullDraws(draws, objects, modelMatrices, viewProjection(), glm::vec3(0.0f), nullptr, glm::mat4(1.0f), { 0 }, commands, counts);
+	EXPECT_EQ(counts[0], 1);
+
+	// Eye is on side to which triangles are facing away
+	cullDraws(draws, objects, modelMatrices, viewProjection(), glm::vec3(0.0f, 0.0f, -40.0f), nullptr, glm::mat4(1.0f), { 0 }, commands, counts);
+	EXPECT_EQ(counts[0], 0);
+
+	// Draw is hidden behind wall only when pyramid is given
+	auto depthPyramid = wall(5.0f);
+	cullDraws(draws, objects, modelMatrices, viewProjection(), glm::vec3(0.0f), &depthPyramid, viewProjection(), { 0 }, commands, counts);
+	EXPECT_EQ(counts[0], 0);
+}
+
+TEST(DrawCulling, Only_draws_of_selected_level_are_kept)
+{
+	CullingObject object;
+	object.boundsMin = glm::vec3(-1.0f);
+	object.boundsMax = glm::vec3(1.0f);
+	object.lodsCount = 2;
+	object.lodErrors[1] = 0.01f;
+	object.lodScreenError = 0.002f;
+	std::vector<CullingDraw> draws = { sphereDraw(glm::vec3(0.0f), 2.0f, 0, 0, 0), sphereDraw(glm::vec3(0.0f), 2.0f, 0, 3, 1) };
+	std::vector<DrawElementsCommand> commands(2);
+	std::vector<uint32_t> counts(1);
+
+	// Error of coarse level is too big on screen when object is near
+	std::vector<glm::mat4> modelMatrices = { glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -4.0f)) };
+	EXPECT_EQ(selectCullingLod(object, viewProjection() * modelMatrices[0]), 0);
+	cullDraws(draws, { object }, modelMatrices, viewProjection(), glm::vec3(0.0f), nullptr, glm::mat4(1.0f), { 0 }, commands, counts);
+	EXPECT_EQ(counts[0], 1);
+	EXPECT_EQ(commands[0].firstIndex, 0);
+
+	modelMatrices[0] = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -90.0f));
+	EXPECT_EQ(selectCullingLod(object, viewProjection() * modelMatrices[0]), 1);
+	cullDraws(draws, { object }, modelMatrices, viewProjection(), glm::vec3(0.0f), nullptr, glm::mat4(1.0f), { 0 }, commands, counts);
+	EXPECT_EQ(counts[0], 1);
+	EXPECT_EQ(commands[0].firstIndex, 3);
+
+	// Levels past limit of culling are never selected
+	object.lodsCount = maxCullingLods + 4;
+	EXPECT_LT(selectCullingLod(object, viewProjection() * modelMatrices[0]), maxCullingLods);
+}
@@ -0,0 +1,79 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Common/DynamicInstanceStorage.cpp"
+
+using namespace GraphicEngine::Common;
+
+TEST(DynamicInstanceStorage, Capacity_grows_geometrically_only_when_all_slots_are_used)
+{
+	DynamicInstanceStorage storage(256, 2, 2);
+	EXPECT_EQ(storage.getCapacity(), 2);
+	EXPECT_EQ(storage.getSize(), 2 * 256);
+
+	EXPECT_EQ(storage.addInstance(), 0);
+	EXPECT_EQ(storage.addInstance(), 1);
+	EXPECT_EQ(storage.addInstance(), 2);
+	EXPECT_EQ(storage.getCapacity(), 4);
+
+	EXPECT_FALSE(storage.reserve(4));
+	EXPECT_TRUE(storage.reserve(5));
+	EXPECT_EQ(storage.getCapacity(), 8);
+	EXPECT_TRUE(storage.reserve(20));
+	EXPECT_EQ(storage.getCapacity(), 20);
+}
+
+TEST(DynamicInstanceStorage, Deleted_instances_are_reused_without_growth)
+{
+	DynamicInstanceStorage storage(64, 1, 4);
+	for (uint32_t i{ 0 }; i < 4; ++i)
+	{
+		storage.addInstance();
+	}
+
+	for (uint32_t i{ 0 }; i < 100; ++i)
+	{
+		storage.deleteInstance(1);
+		EXPECT_EQ(storage.addInstance(), 1);
+	}
+	EXPECT_EQ(storage.getCapacity(), 4);
+	EXPECT_EQ(storage.getInstancesCount(), 4);
+
+	storage.deleteInstance(3);
+	EXPECT_EQ(storage.getInstancesCount(), 3);
+	EXPECT_EQ(storage.getCapacity(), 4);
+	EXPECT_THROW(storage.deleteInstance(3), std::invalid_argument);
+}
+
+TEST(DynamicInstanceStorage, Dirty_range_covers_changed_instances_for_each_image)
+{
+	DynamicInstanceStorage storage(16, 2, 8);
+	float value = 1.0f;
+	storage.setValue(2, &value, sizeof(value));
+	storage.setValue(5, &value, sizeof(value));
+
+	EXPECT_EQ(storage.takeDirtyRange(0), std::make_pair(2u * 16, 4u * 16));
+	EXPECT_FALSE(storage.takeDirtyRange(0));
+
+	// Equal value is not marked again
+	storage.setValue(2, &value, sizeof(value));
+	EXPECT_FALSE(storage.takeDirtyRange(0));
+	EXPECT_EQ(storage.takeDirtyRange(1), std::make_pair(2u * 16, 4u * 16));
+
+	value = 2.0f;
+	storage.setValue(7, &value, sizeof(value));
+	EXPECT_EQ(storage.takeDirtyRange(1), std::make_pair(7u * 16, 16u));
+	EXPECT_EQ(*reinterpret_cast<const float*>(storage.getData() + 7 * 16), 2.0f);
+}
+
+TEST(DynamicInstanceStorage, Growth_keeps_values_and_clears_dirty_ranges)
+{
+	DynamicInstanceStorage storage(16, 2, 1);
+	float value = 3.0f;
+	storage.setValue(0, &value, sizeof(value));
+	EXPECT_THROW(storage.setValue(1, &value, sizeof(value)), std::out_of_range);
+
+	EXPECT_TRUE(storage.reserve(2));
+	EXPECT_FALSE(storage.takeDirtyRange(0));
+	EXPECT_FALSE(storage.takeDirtyRange(1));
+	EXPECT_EQ(*reinterpret_cast<const float*>(storage.getData()), 3.0f);
+}
@@ -0,0 +1,85 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Core/IO/FileWatcher.cpp"
+
+#include <chrono>
+#include <fstream>
+
+using namespace GraphicEngine::Core::IO;
+
+namespace
+{
+	class FileWatcherTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			directory = std::filesystem::temp_directory_path() / ("FileWatcherTest_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+			std::filesystem::remove_all(directory);
+			std::filesystem::create_directories(directory);
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove_all(directory);
+		}
+
+		void writeFile(const std::string& fileName, const std::string& content)
+		{
+			std::ofstream file(directory / fileName, std::ios::binary | std::ios::trunc);
+			file << content;
+		}
+
+		// Write time is moved explicitly, so test does not depend on resolution of file system clock
+		void touchFile(const std::string& fileName)
+		{
+			auto path = directory / fileName;
+			std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(1));
+		}
+
+		std::filesystem::path directory;
+	};
+}
+
+TEST_F(FileWatcherTest, Existing_files_are_unchanged)
+{
+	writeFile("solid.frag", "void main() {}");
+	FileWatcher fileWatcher(directory);
+
+	EXPECT_TRUE(fileWatcher.getChangedFiles().empty());
+}
+
+TEST_F(FileWatcherTest, Modified_and_added_files_are_reported_once)
+{
+	writeFile("solid.frag", "void main() {}");
+	writeFile("solid.vert", "void main() {}");
+	FileWatcher fileWatcher(directory);
+
+	touchFile("solid.frag");
+	writeFile("cull.comp", "void main() {}");
+	EXPECT_EQ(fileWatcher.getChangedFiles(), std::vector<std::string>({ "cull.comp", "solid.frag" }));
+	EXPECT_TRUE(fileWatcher.getChangedFiles().empty());
+
+	// Change of size is found even when write time stays same
+	auto writeTime = std::filesystem::last_write_time(directory / "solid.vert");
+	writeFile("solid.vert", "void main() { }");
+	std::filesystem::last_write_time(directory / "solid.vert", writeTime);
+	EXPECT_EQ(fileWatcher.getChangedFiles(), std::vector<std::string>({ "solid.vert" }));
+}
+
+TEST_F(FileWatcherTest, Removed_files_are_forgotten)
+{
+	writeFile("solid.frag", "void main() {}");
+	FileWatcher fileWatcher(directory);
+
+	std::filesystem::remove(directory / "solid.frag");
+	EXPECT_TRUE(fileWatcher.getChangedFiles().empty());
+
+	writeFile("solid.frag", "void main() {}");
+	EXPECT_EQ(fileWatcher.getChangedFiles(), std::vector<std::string>({ "solid.frag" }));
+}
+
+TEST_F(FileWatcherTest, Missing_directory_throws)
+{
+	EXPECT_THROW(FileWatcher(directory / "missing"), std::runtime_error);
+}
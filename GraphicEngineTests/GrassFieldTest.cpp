@@ -0,0 +1,237 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Engines/Graphic/3D/GrassField.hpp"
+#include "../GraphicEngine/Engines/Graphic/3D/GrassField.cpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace GraphicEngine::Engines::Graphic;
+using namespace GraphicEngine::Engines::Graphic::Shaders;
+
+namespace
+{
+	GrassParameters getParameters()
+	{
+		GrassParameters parameters(0.005f, 0.2f, 0.5f);
+		parameters.density = 100.0f;
+		parameters.patchSize = 2.0f;
+		parameters.lodNear = 4.0f;
+		parameters.lodFar = 40.0f;
+		parameters.minDensity = 0.1f;
+		parameters.segments = 4;
+		return parameters;
+	}
+
+	// Flat square ground of given size centered in origin, split into two triangles
+	void addGround(GrassField& grassField, float size, glm::mat4 modelMatrix = glm::mat4(1.0f))
+	{
+		float h = size / 2.0f;
+		std::vector<glm::vec3> positions{ { -h, 0.0f, -h }, { h, 0.0f, -h }, { h, 0.0f, h }, { -h, 0.0f, h } };
+		std::vector<glm::vec3> normals(4, glm::vec3(0.0f, 1.0f, 0.0f));
+		std::vector<uint32_t> indices{ 0, 2, 1, 0, 3, 2 };
+		grassField.addSurface(positions, normals, indices, modelMatrix);
+	}
+
+	uint32_t countBlades(const GrassField& grassField)
+	{
+		uint32_t count{ 0 };
+		for (uint32_t segments{ 1 }; segments <= grassField.getParameters().segments; ++segments)
+		{
+			for (const auto& draw : grassField.getDraws(segments))
+			{
+				count += draw.bladesCount;
+			}
+		}
+		return count;
+	}
+}
+
+TEST(GrassField, BladesCountFollowsDensity)
+{
+	GrassField grassField(getParameters());
+	addGround(grassField, 10.0f);
+	grassField.build();
+
+	// 100 square units * 100 blades
+	EXPECT_NEAR(static_cast<float>(grassField.getBlades().size()), 10000.0f, 2.0f);
+}
+
+TEST(GrassField, PlacementIsReproducible)
+{
+	GrassField first(getParameters(), 7);
+	GrassField second(getParameters(), 7);
+	addGround(first, 4.0f);
+	addGround(second, 4.0f);
+	first.build();
+	second.build();
+
+	ASSERT_EQ(first.getBlades().size(), second.getBlades().size());
+	for (size_t i{ 0 }; i < first.getBlades().size(); ++i)
+	{
+		EXPECT_EQ(first.getBlades()[i].positionRotation, second.getBlades()[i].positionRotation);
+	}
+}
+
+TEST(GrassField, BladesLieOnTransformedSurface)
+{
+	GrassField grassField(getParameters());
+	glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(10.0f, 1.0f, 0.0f));
+	modelMatrix = glm::rotate(modelMatrix, glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+	addGround(grassField, 4.0f, modelMatrix);
+	grassField.build();
+
+	ASSERT_FALSE(grassField.getBlades().empty());
+	for (const auto& blade : grassField.getBlades())
+	{
+		EXPECT_NEAR(blade.positionRotation.z, 0.0f, 1e-4f);
+		EXPECT_NEAR(blade.normalRandom.z, 1.0f, 1e-4f);
+		EXPECT_GE(blade.normalRandom.w, 0.0f);
+		EXPECT_LT(blade.normalRandom.w, 1.0f);
+	}
+}
+
+TEST(GrassField, PatchesAreContiguousAndBounded)
+{
+	GrassField grassField(getParameters());
+	addGround(grassField, 8.0f);
+	grassField.build();
+
+	// 8x8 ground split into 2x2 patches
+	EXPECT_EQ(grassField.getPatches().size(), 16);
+
+	uint32_t firstBlade{ 0 };
+	for (const auto& patch : grassField.getPatches())
+	{
+		EXPECT_EQ(patch.firstBlade, firstBlade);
+		firstBlade += patch.bladesCount;
+
+		EXPECT_LE(patch.maxPoint.x - patch.minPoint.x, 2.0f + 2.0f * 1.25f * 0.2f + 1e-4f);
+		for (uint32_t i{ patch.firstBlade }; i < patch.firstBlade + patch.bladesCount; ++i)
+		{
+			glm::vec3 position = glm::vec3(grassField.getBlades()[i].positionRotation);
+			for (int axis{ 0 }; axis < 3; ++axis)
+			{
+				EXPECT_GE(position[axis], patch.minPoint[axis]);
+				EXPECT_LE(position[axis], patch.maxPoint[axis]);
+			}
+		}
+	}
+	EXPECT_EQ(firstBlade, grassField.getBlades().size());
+}
+
+TEST(GrassField, LodDecreasesWithDistance)
+{
+	GrassField grassField(getParameters());
+
+	EXPECT_EQ(grassField.getSegments(0.0f), 4);
+	EXPECT_EQ(grassField.getSegments(4.0f), 4);
+	EXPECT_EQ(grassField.getSegments(40.0f), 1);
+	EXPECT_FLOAT_EQ(grassField.getDensity(2.0f), 1.0f);
+	EXPECT_FLOAT_EQ(grassField.getDensity(40.0f), 0.1f);
+	EXPECT_FLOAT_EQ(grassField.getDensity(41.0f), 0.0f);
+
+	for (float distance{ 1.0f }; distance < 40.0f; distance += 1.0f)
+	{
+		EXPECT_GE(grassField.getSegments(distance), grassField.getSegments(distance + 1.0f));
+		EXPECT_GE(grassField.getDensity(distance), grassField.getDensity(distance + 1.0f));
+	}
+}
+
+TEST(GrassField, PatchesOutsideFrustumAreCulled)
+{
+	GrassField grassField(getParameters());
+	addGround(grassField, 20.0f);
+	grassField.build();
+
+	glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+	glm::vec3 eye(0.0f, 1.0f, 0.0f);
+
+	// Looking at the ground, everything is closer than lodFar
+	grassField.selectLods(projection * glm::lookAt(eye, glm::vec3(0.0f, 0.0f, -5.0f), glm::vec3(0.0f, 1.0f, 0.0f)), eye);
+	uint32_t visibleBlades = countBlades(grassField);
+	EXPECT_GT(visibleBlades, 0);
+	EXPECT_LT(visibleBlades, grassField.getBlades().size());
+
+	// Looking at the sky
+	grassField.selectLods(projection * glm::lookAt(eye, glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f)), eye);
+	EXPECT_EQ(countBlades(grassField), 0);
+
+	// Camera too far away
+	glm::vec3 farEye(0.0f, 100.0f, 0.0f);
+	grassField.selectLods(projection * glm::lookAt(farEye, glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f)), farEye);
+	EXPECT_EQ(countBlades(grassField), 0);
+}
+
+TEST(GrassField, DistantPatchesAreThinnedOut)
+{
+	GrassField grassField(getParameters());
+	addGround(grassField, 80.0f);
+	grassField.build();
+
+	glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 200.0f);
+	glm::vec3 eye(0.0f, 30.0f, 0.0f);
+	grassField.selectLods(projection * glm::lookAt(eye, glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f)), eye);
+
+	// Eye is 30 units above the ground, so no patch gets full detail
+	EXPECT_TRUE(grassField.getDraws(4).empty());
+	uint32_t visibleBlades = countBlades(grassField);
+	EXPECT_GT(visibleBlades, 0);
+	EXPECT_LT(visibleBlades, grassField.getBlades().size() / 2);
+
+	for (uint32_t segments{ 1 }; segments <= 4; ++segments)
+	{
+		for (const auto& draw : grassField.getDraws(segments))
+		{
+			EXPECT_LE(draw.firstBlade + draw.bladesCount, grassField.getBlades().size());
+		}
+	}
+}
+
+TEST(GrassField, MovedSurfaceKeepsItsGrass)
+{
+	GrassField grassField(getParameters());
+	float h = 2.0f;
+	std::vector<glm::vec3> positions{ { -h, 0.0f, -h }, { h, 0.0f, -h }, { h, 0.0f, h }, { -h, 0.0f, h } };
+	std::vector<uint32_t> indices{ 0, 2, 1, 0, 3, 2 };
+	uint32_t surface = grassField.addSurface(positions, {}, indices, glm::mat4(1.0f));
+	grassField.build();
+	auto blades = grassField.getBlades();
+
+	glm::vec3 offset(20.0f, 0.0f, 0.0f);
+	grassField.updateSurface(surface, positions, {}, indices, glm::translate(glm::mat4(1.0f), offset));
+	grassField.build();
+
+	ASSERT_EQ(grassField.getBlades().size(), blades.size());
+	glm::vec3 oldCenter(0.0f);
+	glm::vec3 newCenter(0.0f);
+	for (size_t i{ 0 }; i < blades.size(); ++i)
+	{
+		oldCenter += glm::vec3(blades[i].positionRotation);
+		newCenter += glm::vec3(grassField.getBlades()[i].positionRotation);
+	}
+	EXPECT_NEAR(glm::length((newCenter - oldCenter) / static_cast<float>(blades.size()) - offset), 0.0f, 1e-3f);
+	for (const auto& patch : grassField.getPatches())
+	{
+		EXPECT_GT(patch.maxPoint.x, 18.0f);
+	}
+}
+
+TEST(GrassField, RemovedSurfaceLeavesOtherSurfaces)
+{
+	GrassField grassField(getParameters());
+	addGround(grassField, 4.0f);
+	uint32_t surface = grassField.addSurface({ { 10.0f, 0.0f, 0.0f }, { 12.0f, 0.0f, 0.0f }, { 10.0f, 0.0f, 2.0f } }, {}, { 0, 2, 1 }, glm::mat4(1.0f));
+	grassField.build();
+	auto bladesCount = grassField.getBlades().size();
+
+	grassField.removeSurface(surface);
+	grassField.build();
+
+	// Second surface is 2 square units
+	EXPECT_NEAR(static_cast<float>(bladesCount - grassField.getBlades().size()), 200.0f, 2.0f);
+	for (const auto& blade : grassField.getBlades())
+	{
+		EXPECT_LT(blade.positionRotation.x, 2.0f + 1e-4f);
+	}
+	EXPECT_THROW(grassField.removeSurface(surface), std::out_of_range);
+}
@@ -0,0 +1,170 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Engines/Graphic/3D/LightClusterGrid.hpp"
+#include "../GraphicEngine/Engines/Graphic/3D/LightClusterGrid.cpp"
+#include "../GraphicEngine/Engines/Graphic/Shaders/Models/Light.cpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+using namespace GraphicEngine::Engines::Graphic;
+using namespace GraphicEngine::Engines::Graphic::Shaders;
+
+namespace
+{
+	const float width{ 1920.0f };
+	const float height{ 1080.0f };
+
+	glm::mat4 getProjection()
+	{
+		return glm::perspective(glm::radians(45.0f), width / height, 0.1f, 100.0f);
+	}
+
+	PointLight getPointLight(glm::vec3 position)
+	{
+		// Range is around 8.2 units
+		return PointLight(glm::vec4(position, 1.0f), 1.0f, 0.7f, 1.8f, LightColor());
+	}
+
+	glm::vec3 getViewPosition(const glm::mat4& projection, glm::vec2 fragCoord, float depth)
+	{
+		glm::mat4 inverseProjection = glm::inverse(projection);
+		glm::vec2 ndc = 2.0f * fragCoord / glm::vec2(width, height) - 1.0f;
+		glm::vec4 n = inverseProjection * glm::vec4(ndc, -1.0f, 1.0f);
+		glm::vec4 f = inverseProjection * glm::vec4(ndc, 1.0f, 1.0f);
+		glm::vec3 nearPoint = glm::vec3(n) / n.w;
+		glm::vec3 farPoint = glm::vec3(f) / f.w;
+		float t = (-depth - nearPoint.z) / (farPoint.z - nearPoint.z);
+		return nearPoint + t * (farPoint - nearPoint);
+	}
+}
+
+TEST(LightClusterGrid, ClustersCount)
+{
+	LightClusterGrid grid(16, 9, 24);
+	grid.build(getProjection(), width, height);
+
+	EXPECT_EQ(grid.getClustersCount(), 16 * 9 * 24);
+	EXPECT_EQ(grid.getClusters().size(), 16 * 9 * 24);
+}
+
+TEST(LightClusterGrid, SliceDepthsAreMonotonic)
+{
+	LightClusterGrid grid(16, 9, 24, 0.5f);
+	grid.build(getProjection(), width, height);
+
+	EXPECT_FLOAT_EQ(grid.getSliceDepth(0), 0.1f);
+	EXPECT_FLOAT_EQ(grid.getSliceDepth(1), 0.5f);
+	EXPECT_NEAR(grid.getSliceDepth(24), 100.0f, 0.01f);
+	for (uint32_t slice{ 1 }; slice < 24; ++slice)
+	{
+		EXPECT_LT(grid.getSliceDepth(slice - 1), grid.getSliceDepth(slice));
+		float middle = 0.5f * (grid.getSliceDepth(slice) + grid.getSliceDepth(slice + 1));
+		EXPECT_EQ(grid.getSliceIndex(middle), slice);
+	}
+}
+
+TEST(LightClusterGrid, PointLightInFrontOfCamera)
+{
+	LightClusterGrid grid;
+	grid.build(getProjection(), width, height);
+	grid.assignLights(glm::mat4(1.0f), { getPointLight(glm::vec3(0.0f, 0.0f, -10.0f)) }, {});
+
+	auto cluster = grid.getClusters()[grid.getClusterIndex(glm::vec2(width, height) / 2.0f, 10.0f)];
+	EXPECT_EQ(cluster.pointLightCount, 1);
+	EXPECT_EQ(cluster.spotLightCount, 0);
+	EXPECT_EQ(grid.getLightIndices()[cluster.offset], 0);
+
+	// Far away from light range
+	auto farCluster = grid.getClusters()[grid.getClusterIndex(glm::vec2(width, height) / 2.0f, 50.0f)];
+	EXPECT_EQ(farCluster.pointLightCount, 0);
+}
+
+TEST(LightClusterGrid, LightBehindCameraIsSkipped)
+{
+	LightClusterGrid grid;
+	grid.build(getProjection(), width, height);
+	grid.assignLights(glm::mat4(1.0f), { getPointLight(glm::vec3(0.0f, 0.0f, 20.0f)) }, {});
+
+	EXPECT_TRUE(grid.getLightIndices().empty());
+}
+
+TEST(LightClusterGrid, SpotLightsFollowPointLights)
+{
+	LightClusterGrid grid;
+	grid.build(getProjection(), width, height);
+
+	SpotLight spotLight(glm::vec4(0.0f, 0.0f, -5.0f, 1.0f), glm::vec4(0.0f, 0.0f, -1.0f, 1.0f),
+		glm::cos(glm::radians(10.0f)), glm::cos(glm::radians(20.0f)), 1.0f, 0.7f, 1.8f, LightColor());
+	grid.assignLights(glm::mat4(1.0f), { getPointLight(glm::vec3(0.0f, 0.0f, -8.0f)) }, { spotLight, spotLight });
+
+	auto cluster = grid.getClusters()[grid.getClusterIndex(glm::vec2(width, height) / 2.0f, 8.0f)];
+	EXPECT_EQ(cluster.pointLightCount, 1);
+	EXPECT_EQ(cluster.spotLightCount, 2);
+	EXPECT_EQ(grid.getLightIndices()[cluster.offset], 0);
+	EXPECT_EQ(grid.getLightIndices()[cluster.offset + 1], 0);
+	EXPECT_EQ(grid.getLightIndices()[cluster.offset + 2], 1);
+}
+
+TEST(LightClusterGrid, LightIndexListIsCompact)
+{
+	LightClusterGrid grid;
+	grid.build(getProjection(), width, height);
+
+	std::mt19937 generator(7);
+	std::uniform_real_distribution<float> distribution(-30.0f, 30.0f);
+	std::vector<PointLight> pointLights;
+	for (uint32_t i{ 0 }; i < 200; ++i)
+	{
+		pointLights.push_back(getPointLight(glm::vec3(distribution(generator), distribution(generator), distribution(generator) - 30.0f)));
+	}
+	grid.assignLights(glm::mat4(1.0f), pointLights, {});
+
+	uint32_t offset{ 0 };
+	for (const auto& cluster : grid.getClusters())
+	{
+		EXPECT_EQ(cluster.offset, offset);
+		offset += cluster.pointLightCount + cluster.spotLightCount;
+	}
+	EXPECT_EQ(offset, grid.getLightIndices().size());
+}
+
+TEST(LightClusterGrid, ThousandLightsMatchBruteForce)
+{
+	LightClusterGrid grid;
+	glm::mat4 projection = getProjection();
+	glm::mat4 view = glm::lookAt(glm::vec3(3.0f, 4.0f, 5.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	grid.build(projection, width, height);
+
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> distribution(-40.0f, 40.0f);
+	std::vector<PointLight> pointLights;
+	for (uint32_t i{ 0 }; i < 1000; ++i)
+	{
+		pointLights.push_back(getPointLight(glm::vec3(distribution(generator), distribution(generator), distribution(generator))));
+	}
+	grid.assignLights(view, pointLights, {});
+
+	std::uniform_real_distribution<float> x(0.0f, width);
+	std::uniform_real_distribution<float> y(0.0f, height);
+	std::uniform_real_distribution<float> depth(0.2f, 90.0f);
+	for (uint32_t sample{ 0 }; sample < 2000; ++sample)
+	{
+		glm::vec2 fragCoord(x(generator), y(generator));
+		float fragDepth = depth(generator);
+		glm::vec3 position = getViewPosition(projection, fragCoord, fragDepth);
+
+		auto cluster = grid.getClusters()[grid.getClusterIndex(fragCoord, fragDepth)];
+		auto begin = std::begin(grid.getLightIndices()) + cluster.offset;
+		auto end = begin + cluster.pointLightCount;
+
+		for (uint32_t i{ 0 }; i < pointLights.size(); ++i)
+		{
+			glm::vec3 lightPosition = glm::vec3(view * pointLights[i].position);
+			if (glm::length(lightPosition - position) < pointLights[i].getRange() * 0.999f)
+			{
+				EXPECT_NE(std::find(begin, end, i), end);
+			}
+		}
+	}
+}
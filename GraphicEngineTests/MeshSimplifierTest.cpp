@@ -0,0 +1,191 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Common/Vertex.hpp"
+#include "../GraphicEngine/Core/Math/MeshSimplifier.hpp"
+#include "../GraphicEngine/Core/Math/MeshSimplifier.cpp"
+#include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/ConeGenerator.hpp"
+#include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/PlaneGenerator.hpp"
+#include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/SphereGenerator.hpp"
+
+#include <glm/gtx/transform.hpp>
+
+#include <algorithm>
+#include <set>
+#include <tuple>
+
+using namespace GraphicEngine::Core::Math;
+using namespace GraphicEngine::Engines::Graphic;
+using namespace GraphicEngine::Common;
+
+namespace
+{
+	template <typename Vertex>
+	std::vector<glm::vec3> getPositions(const ObjectBuffers<Vertex>& buffers)
+	{
+		std::vector<glm::vec3> positions;
+		for (auto& vertex : buffers.vertices)
+		{
+			positions.push_back(vertex.position);
+		}
+		return positions;
+	}
+
+	void expectValidTriangles(const std::vector<uint32_t>& indices, size_t verticesCount)
+	{
+		ASSERT_EQ(indices.size() % 3, 0);
+		for (size_t i{ 0 }; i < indices.size(); i += 3)
+		{
+			ASSERT_LT(indices[i], verticesCount);
+			ASSERT_LT(indices[i + 1], verticesCount);
+			ASSERT_LT(indices[i + 2], verticesCount);
+			EXPECT_NE(indices[i], indices[i + 1]);
+			EXPECT_NE(indices[i + 1], indices[i + 2]);
+			EXPECT_NE(indices[i], indices[i + 2]);
+		}
+	}
+}
+
+TEST(MeshSimplifier, Flat_plane_is_simplified_without_error)
+{
+	auto buffers = PlaneGenerator<VertexP>{}.getBuffers(glm::vec2(0.0f), glm::vec2(10.0f), glm::ivec2(20, 20));
+	auto positions = getPositions(buffers);
+
+	auto simplified = simplifyMesh(positions, buffers.indices, buffers.indices.size() / 4);
+
+	expectValidTriangles(simplified.indices, positions.size());
+	EXPECT_LE(simplified.indices.size(), buffers.indices.size() / 4);
+	EXPECT_NEAR(simplified.error, 0.0f, 1e-3f);
+
+	// All triangles still face same side as source ones
+	auto normal = [&](const std::vector<uint32_t>& indices, size_t i)
+	{
+		return glm::cross(positions[indices[i + 1]] - positions[indices[i]], positions[indices[i + 2]] - positions[indices[i]]);
+	};
+	float side = normal(buffers.indices, 0).y;
+	for (size_t i{ 0 }; i < simplified.indices.size(); i += 3)
+	{
+		EXPECT_GT(normal(simplified.indices, i).y * side, 0.0f);
+	}
+}
+
+TEST(MeshSimplifier, Border_vertices_are_kept)
+{
+	auto buffers = PlaneGenerator<VertexP>{}.getBuffers(glm::vec2(0.0f), glm::vec2(10.0f), glm::ivec2(20, 20));
+	auto positions = getPositions(buffers);
+
+	auto simplified = simplifyMesh(positions, buffers.indices, 0);
+
+	std::set<uint32_t> used(std::begin(simplified.indices), std::end(simplified.indices));
+	for (uint32_t vertex{ 0 }; vertex < positions.size(); ++vertex)
+	{
+		auto position = positions[vertex];
+		if (position.x == 0.0f || position.x == 10.0f || position.z == 0.0f || position.z == 10.0f)
+		{
+			EXPECT_TRUE(used.count(vertex)) << "Border vertex " << vertex << " was collapsed";
+		}
+	}
+}
+
+TEST(MeshSimplifier, Seam_vertices_are_kept)
+{
+	// Bottom and side of cone have separate vertices on same positions, as well as apex
+	auto buffers = ConeGenerator<VertexP>{}.getBuffers(glm::vec3(0.0f), 1.0f, 2.0f, glm::ivec3(24, 4, 8));
+	auto positions = getPositions(buffers);
+
+	auto simplified = simplifyMesh(positions, buffers.indices, buffers.indices.size() / 8);
+	expectValidTriangles(simplified.indices, positions.size());
+
+	// Triangle of single apex copy can disappear, but position of seam has to stay in mesh
+	auto positionLess = [](glm::vec3 p1, glm::vec3 p2) { return std::tie(p1.x, p1.y, p1.z) < std::tie(p2.x, p2.y, p2.z); };
+	std::set<glm::vec3, decltype(positionLess)> usedPositions(positionLess);
+	for (uint32_t index : simplified.indices)
+	{
+		usedPositions.insert(positions[index]);
+	}
+	for (uint32_t v1{ 0 }; v1 < positions.size(); ++v1)
+	{
+		for (uint32_t v2{ v1 + 1 }; v2 < positions.size(); ++v2)
+		{
+			if (positions[v1] == positions[v2])
+			{
+				EXPECT_TRUE(usedPositions.count(positions[v1])) << "Seam vertex " << v1 << " was collapsed";
+			}
+		}
+	}
+}
+
+TEST(MeshSimplifier, Error_grows_with_reduction)
+{
+	auto buffers = SphereGenerator<VertexP>{}.getBuffers(glm::vec3(0.0f), 1.0f, glm::ivec2(64, 32));
+	auto positions = getPositions(buffers);
+
+	float previousError{ 0.0f };
+	size_t previousSize{ buffers.indices.size() };
+	for (size_t divider : { 2, 4, 8, 16 })
+	{
+		auto simplified = simplifyMesh(positions, buffers.indices, buffers.indices.size() / divider);
+		expectValidTriangles(simplified.indices, positions.size());
+		EXPECT_LE(simplified.indices.size(), buffers.indices.size() / divider);
+		EXPECT_LT(simplified.indices.size(), previousSize);
+		EXPECT_GE(simplified.error, previousError);
+
+		// Vertices stay on sphere, so only triangles can sink into it
+		float maxDistance{ 0.0f };
+		for (size_t i{ 0 }; i < simplified.indices.size(); i += 3)
+		{
+			auto centroid = (positions[simplified.indices[i]] + positions[simplified.indices[i + 1]] + positions[simplified.indices[i + 2]]) / 3.0f;
+			maxDistance = std::max(maxDistance, 1.0f - glm::length(centroid));
+		}
+		// Error is relative to diagonal of bouding box of unit sphere
+		float relativeDistance = maxDistance / std::sqrt(12.0f);
+		EXPECT_LT(relativeDistance, 2.0f * simplified.error + 1e-3f);
+		EXPECT_LT(simplified.error, 0.05f);
+
+		previousError = simplified.error;
+		previousSize = simplified.indices.size();
+	}
+	EXPECT_GT(previousError, 0.0f);
+}
+
+TEST(MeshSimplifier, Invalid_indices_throw)
+{
+	std::vector<glm::vec3> positions{ glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f) };
+	EXPECT_THROW(simplifyMesh(positions, { 0, 1 }, 0), std::invalid_argument);
+	EXPECT_THROW(simplifyMesh(positions, { 0, 1, 3 }, 0), std::out_of_range);
+	EXPECT_EQ(simplifyMesh(positions, { 0, 1, 2 }, 3).indices.size(), 3);
+}
+
+TEST(MeshSimplifier, Mesh_selects_coarser_lod_with_distance)
+{
+	auto mesh = SphereGenerator<VertexPN>{}.getMesh(glm::vec3(0.0f), 1.0f, glm::ivec2(64, 32), TriangleDirection::Clockwise);
+	mesh->generateLods(3, 0.5f, 0.002f);
+
+	ASSERT_EQ(mesh->getLodsCount(), 4);
+	auto ranges = mesh->getLodRanges();
+	auto indices = mesh->getLodIndices();
+	ASSERT_EQ(ranges.size(), 4);
+	EXPECT_EQ(ranges.front().first, 0);
+	EXPECT_EQ(ranges.back().first + ranges.back().second, indices.size());
+	for (size_t level{ 1 }; level < ranges.size(); ++level)
+	{
+		EXPECT_EQ(ranges[level].first, ranges[level - 1].first + ranges[level - 1].second);
+		EXPECT_LT(ranges[level].second, ranges[level - 1].second);
+	}
+
+	auto projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 10000.0f);
+	auto lodAtDistance = [&](float distance)
+	{
+		return mesh->selectLod(projection * glm::lookAt(glm::vec3(0.0f, 0.0f, distance), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+	};
+
+	EXPECT_EQ(lodAtDistance(0.5f), 0);
+	EXPECT_EQ(lodAtDistance(3.0f), 0);
+	EXPECT_EQ(lodAtDistance(5000.0f), 3);
+
+	uint32_t previousLod{ 0 };
+	for (float distance{ 3.0f }; distance < 5000.0f; distance *= 2.0f)
+	{
+		EXPECT_GE(lodAtDistance(distance), previousLod);
+		previousLod = lodAtDistance(distance);
+	}
+}
@@ -0,0 +1,165 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Common/Vertex.hpp"
+#include "../GraphicEngine/Core/Math/Meshlets.hpp"
+#include "../GraphicEngine/Core/Math/Meshlets.cpp"
+#include "../GraphicEngine/Core/Math/VertexCacheOptimizer.hpp"
+#include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/PlaneGenerator.hpp"
+#include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/SphereGenerator.hpp"
+
+#include <glm/gtx/transform.hpp>
+
+#include <set>
+
+using namespace GraphicEngine::Core::Math;
+using namespace GraphicEngine::Engines::Graphic;
+using namespace GraphicEngine::Common;
+
+namespace
+{
+	struct MeshletsFixture
+	{
+		std::vector<glm::vec3> positions;
+		std::vector<uint32_t> indices;
+		std::vector<Meshlet> meshlets;
+	};
+
+	MeshletsFixture unitSphere()
+	{
+		MeshletsFixture fixture;
+		auto buffers = SphereGenerator<VertexP>{}.getBuffers(glm::vec3(0.0f), 1.0f, glm::ivec2(64, 32));
+		for (auto& vertex : buffers.vertices)
+		{
+			fixture.positions.push_back(vertex.position);
+		}
+		auto indices = optimizeVertexCache(buffers.indices, buffers.vertices.size());
+		auto clustering = buildMeshlets(fixture.positions, indices);
+		fixture.indices = reorderTriangles(indices, clustering.triangleOrder);
+		fixture.meshlets = std::move(clustering.meshlets);
+		return fixture;
+	}
+
+	bool isTriangleFacingEye(const MeshletsFixture& fixture, size_t i, glm::vec3 eyePosition)
+	{
+		auto p0 = fixture.positions[fixture.indices[i]];
+		auto normal = glm::cross(fixture.positions[fixture.indices[i + 1]] - p0, fixture.positions[fixture.indices[i + 2]] - p0);
+		return glm::dot(normal, eyePosition - p0) > 0.0f;
+	}
+}
+
+TEST(Meshlets, Meshlets_cover_triangles_within_limits)
+{
+	auto fixture = unitSphere();
+
+	uint32_t nextIndex{ 0 };
+	for (const auto& meshlet : fixture.meshlets)
+	{
+		EXPECT_EQ(meshlet.firstIndex, nextIndex);
+		EXPECT_GT(meshlet.trianglesCount, 0);
+		EXPECT_LE(meshlet.trianglesCount, 124);
+		EXPECT_LE(meshlet.verticesCount, 64);
+
+		std::set<uint32_t> vertices;
+		for (uint32_t i{ meshlet.firstIndex }; i < meshlet.firstIndex + 3 * meshlet.trianglesCount; ++i)
+		{
+			vertices.insert(fixture.indices[i]);
+			EXPECT_LE(glm::length(fixture.positions[fixture.indices[i]] - meshlet.center), meshlet.radius + 1e-5f);
+		}
+		EXPECT_EQ(vertices.size(), meshlet.verticesCount);
+
+		nextIndex = meshlet.firstIndex + 3 * meshlet.trianglesCount;
+	}
+	EXPECT_EQ(nextIndex, fixture.indices.size());
+}
+
+TEST(Meshlets, Back_facing_culling_is_conservative)
+{
+	auto fixture = unitSphere();
+	glm::vec3 eyePosition(0.0f, 1.0f, 10.0f);
+
+	uint32_t culled{ 0 };
+	for (const auto& meshlet : fixture.meshlets)
+	{
+		if (!isMeshletBackFacing(meshlet, eyePosition))
+			continue;
+
+		++culled;
+		for (uint32_t i{ meshlet.firstIndex }; i < meshlet.firstIndex + 3 * meshlet.trianglesCount; i += 3)
+		{
+			EXPECT_FALSE(isTriangleFacingEye(fixture, i, eyePosition)) << "Meshlet with visible triangle " << i / 3 << " was culled";
+		}
+	}
+
+	// Around half of sphere is facing away from eye
+	EXPECT_GT(culled, fixture.meshlets.size() / 4);
+}
+
+TEST(Meshlets, Flat_meshlet_is_culled_only_from_behind)
+{
+	auto buffers = PlaneGenerator<VertexP>{}.getBuffers(glm::vec2(0.0f), glm::vec2(1.0f), glm::ivec2(4, 4));
+	std::vector<glm::vec3> positions;
+	for (auto& vertex : buffers.vertices)
+	{
+		positions.push_back(vertex.position);
+	}
+	auto meshlets = buildMeshlets(positions, buffers.indices).meshlets;
+	ASSERT_EQ(meshlets.size(), 1);
+
+	auto normal = glm::cross(positions[buffers.indices[1]] - positions[buffers.indices[0]], positions[buffers.indices[2]] - positions[buffers.indices[0]]);
+	glm::vec3 front = meshlets.front().center + glm::normalize(normal);
+	glm::vec3 behind = meshlets.front().center - glm::normalize(normal);
+	EXPECT_FALSE(isMeshletBackFacing(meshlets.front(), front));
+	EXPECT_TRUE(isMeshletBackFacing(meshlets.front(), behind));
+}
+
+TEST(Meshlets, Meshlets_outside_of_frustum_are_culled)
+{
+	auto fixture = unitSphere();
+	auto projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+	glm::vec3 eyePosition(0.0f, 0.0f, 5.0f);
+
+	std::vector<DrawElementsCommand> commands;
+	cullMeshlets(fixture.meshlets, projection * glm::lookAt(eyePosition, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f)), eyePosition, commands);
+
+	// Neighbouring meshlets are merged, so there are less commands than visible meshlets
+	ASSERT_FALSE(commands.empty());
+	uint32_t drawnIndices{ 0 };
+	for (size_t i{ 0 }; i < commands.size(); ++i)
+	{
+		EXPECT_EQ(commands[i].instanceCount, 1);
+		EXPECT_LE(commands[i].firstIndex + commands[i].indexCount, fixture.indices.size());
+		if (i > 0)
+		{
+			EXPECT_GT(commands[i].firstIndex, commands[i - 1].firstIndex + commands[i - 1].indexCount);
+		}
+		drawnIndices += commands[i].indexCount;
+	}
+	EXPECT_LT(drawnIndices, fixture.indices.size());
+
+	// Every triangle facing eye is drawn
+	for (size_t i{ 0 }; i < fixture.indices.size(); i += 3)
+	{
+		if (!isTriangleFacingEye(fixture, i, eyePosition))
+			continue;
+
+		bool drawn = std::any_of(std::begin(commands), std::end(commands), [&](const DrawElementsCommand& command)
+		{
+			return i >= command.firstIndex && i < command.firstIndex + command.indexCount;
+		});
+		EXPECT_TRUE(drawn) << "Visible triangle " << i / 3 << " was culled";
+	}
+
+	// Sphere behind eye
+	commands.clear();
+	cullMeshlets(fixture.meshlets, projection * glm::lookAt(eyePosition, glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(0.0f, 1.0f, 0.0f)), eyePosition, commands);
+	EXPECT_TRUE(commands.empty());
+}
+
+TEST(Meshlets, Invalid_arguments_throw)
+{
+	std::vector<glm::vec3> positions{ glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f) };
+	EXPECT_THROW(buildMeshlets(positions, { 0, 1 }), std::invalid_argument);
+	EXPECT_THROW(buildMeshlets(positions, { 0, 1, 3 }), std::out_of_range);
+	EXPECT_THROW(buildMeshlets(positions, { 0, 1, 2 }, 2, 1), std::invalid_argument);
+	EXPECT_TRUE(buildMeshlets(positions, {}).meshlets.empty());
+}
@@ -1,7 +1,10 @@
 #include "pch.h"
 
 #include "../GraphicEngine/Common/Vertex.hpp"
+#include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/ConeGenerator.hpp"
 #include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/CuboidGenerator.hpp"
+#include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/CylinderGenerator.hpp"
+#include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/PlaneGenerator.hpp"
 #include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/SphereGenerator.hpp"
 
 using namespace GraphicEngine::Engines::Graphic;
@@ -9,17 +12,103 @@ using namespace GraphicEngine::Common;
 
 TEST(Cuboid_Generator, Check_size_of_generated_vector)
 {
+	// Every face is separate grid, so edges shared by faces have their own vertices
 	auto scale = glm::ivec3(2, 2, 3);
-	auto verticesSize = 2 * (((scale.x + 1) * (scale.z + 1)) + ((scale.x + 1) * (scale.y - 1)) + ((scale.y - 1) * (scale.z - 1)));
+	auto verticesSize = 2 * (((scale.x + 1) * (scale.z + 1)) + ((scale.x + 1) * (scale.y + 1)) + ((scale.y + 1) * (scale.z + 1)));
 	auto [vertices, faces, boudingBox, center] = CuboidGenerator<VertexPN>{}.getObject(glm::vec3(-10.0f), glm::vec3(10.0f), scale);
 	EXPECT_EQ(vertices.size(), verticesSize);
+	EXPECT_EQ(vertices.size(), CuboidGenerator<VertexPN>::getVerticesCount(scale));
+	EXPECT_EQ(faces.size() * 3, CuboidGenerator<VertexPN>::getIndicesCount(scale));
 }
 
 
 TEST(Cuboid_Generator, Check_size_of_generated_vector_for_sphere)
 {
+	// Two poles and scale.y rings of scale.x + 1 vertices
 	auto scale = glm::ivec2(6, 6);
-	auto verticesSize = 2 + (scale.x * (scale.y - 1));
+	auto verticesSize = 2 + ((scale.x + 1) * scale.y);
 	auto [vertices, faces, boudingBox, center] = SphereGenerator<VertexPN>{}.getObject(glm::vec3(0.0f), 5 , scale);
 	EXPECT_EQ(vertices.size(), verticesSize);
-}
\ No newline at end of file
+	EXPECT_EQ(vertices.size(), SphereGenerator<VertexPN>::getVerticesCount(scale));
+	EXPECT_EQ(faces.size() * 3, SphereGenerator<VertexPN>::getIndicesCount(scale));
+}
+
+namespace
+{
+	template <typename Vertex>
+	void expectValidBuffers(const ObjectBuffers<Vertex>& buffers, size_t verticesCount, size_t indicesCount)
+	{
+		ASSERT_EQ(buffers.vertices.size(), verticesCount);
+		ASSERT_EQ(buffers.indices.size(), indicesCount);
+		for (size_t i{ 0 }; i < buffers.indices.size(); i += 3)
+		{
+			ASSERT_LT(buffers.indices[i], verticesCount);
+			ASSERT_LT(buffers.indices[i + 1], verticesCount);
+			ASSERT_LT(buffers.indices[i + 2], verticesCount);
+			EXPECT_NE(buffers.indices[i], buffers.indices[i + 1]);
+			EXPECT_NE(buffers.indices[i], buffers.indices[i + 2]);
+			EXPECT_NE(buffers.indices[i + 1], buffers.indices[i + 2]);
+		}
+	}
+}
+
+TEST(Object_Generators, Buffers_have_precomputed_sizes)
+{
+	expectValidBuffers(PlaneGenerator<VertexP>{}.getBuffers(glm::vec2(-5.0f), glm::vec2(5.0f), glm::ivec2(7, 3)),
+		PlaneGenerator<VertexP>::getVerticesCount(glm::ivec2(7, 3)), PlaneGenerator<VertexP>::getIndicesCount(glm::ivec2(7, 3)));
+	expectValidBuffers(SphereGenerator<VertexP>{}.getBuffers(glm::vec3(0.0f), 2.0f, glm::ivec2(9, 4)),
+		SphereGenerator<VertexP>::getVerticesCount(glm::ivec2(9, 4)), SphereGenerator<VertexP>::getIndicesCount(glm::ivec2(9, 4)));
+	expectValidBuffers(CuboidGenerator<VertexP>{}.getBuffers(glm::vec3(-1.0f), glm::vec3(1.0f), glm::ivec3(2, 3, 4)),
+		CuboidGenerator<VertexP>::getVerticesCount(glm::ivec3(2, 3, 4)), CuboidGenerator<VertexP>::getIndicesCount(glm::ivec3(2, 3, 4)));
+	expectValidBuffers(ConeGenerator<VertexP>{}.getBuffers(glm::vec3(0.0f), 1.0f, 2.0f, glm::ivec3(8, 2, 3)),
+		ConeGenerator<VertexP>::getVerticesCount(glm::ivec3(8, 2, 3)), ConeGenerator<VertexP>::getIndicesCount(glm::ivec3(8, 2, 3)));
+	expectValidBuffers(ConeGenerator<VertexP>{}.getBuffers(glm::vec3(0.0f), 1.0f, 2.0f, glm::ivec3(8, 2, 3), false, true),
+		ConeGenerator<VertexP>::getVerticesCount(glm::ivec3(8, 2, 3), false, true), ConeGenerator<VertexP>::getIndicesCount(glm::ivec3(8, 2, 3), false, true));
+	expectValidBuffers(CylinderGenerator<VertexP>{}.getBuffers(glm::vec3(0.0f), 1.0f, 0.5f, 2.0f, glm::ivec3(8, 2, 3)),
+		CylinderGenerator<VertexP>::getVerticesCount(glm::ivec3(8, 2, 3)), CylinderGenerator<VertexP>::getIndicesCount(glm::ivec3(8, 2, 3)));
+	expectValidBuffers(CylinderGenerator<VertexP>{}.getBuffers(glm::vec3(0.0f), 1.0f, 0.5f, 2.0f, glm::ivec3(8, 2, 3), true, false, true),
+		CylinderGenerator<VertexP>::getVerticesCount(glm::ivec3(8, 2, 3), true, false, true), CylinderGenerator<VertexP>::getIndicesCount(glm::ivec3(8, 2, 3), true, false, true));
+}
+
+TEST(Object_Generators, Sphere_has_exact_rings_for_high_tessellation)
+{
+	// Accumulated angle used to skip last column for such steps
+	auto scale = glm::ivec2(1000, 500);
+	auto buffers = SphereGenerator<VertexP>{}.getBuffers(glm::vec3(1.0f, 2.0f, 3.0f), 2.0f, scale);
+	expectValidBuffers(buffers, 2 + 1001 * 500, 6 * 1001 * 500);
+
+	EXPECT_EQ(buffers.vertices.front().position, glm::vec3(1.0f, 0.0f, 3.0f));
+	EXPECT_EQ(buffers.vertices.back().position, glm::vec3(1.0f, 4.0f, 3.0f));
+	for (const auto& vertex : buffers.vertices)
+	{
+		EXPECT_NEAR(glm::length(vertex.position - glm::vec3(1.0f, 2.0f, 3.0f)), 2.0f, 1e-5f);
+	}
+}
+
+TEST(Object_Generators, Plane_lies_in_xz)
+{
+	auto buffers = PlaneGenerator<VertexP>{}.getBuffers(glm::vec2(-4.0f, -2.0f), glm::vec2(4.0f, 2.0f), glm::ivec2(4, 2));
+	EXPECT_EQ(buffers.vertices.front().position, glm::vec3(-4.0f, 0.0f, -2.0f));
+	EXPECT_EQ(buffers.vertices[1].position, glm::vec3(-4.0f, 0.0f, 0.0f));
+	EXPECT_EQ(buffers.vertices.back().position, glm::vec3(4.0f, 0.0f, 2.0f));
+	EXPECT_EQ(buffers.indices[0], 0);
+	EXPECT_EQ(buffers.indices[1], 3);
+	EXPECT_EQ(buffers.indices[2], 4);
+}
+
+TEST(Object_Generators, Object_matches_buffers)
+{
+	auto buffers = ConeGenerator<VertexP>{}.getBuffers(glm::vec3(0.0f), 1.0f, 2.0f, glm::ivec3(6, 1, 2), true, true, TriangleDirection::CounterClockwise);
+	auto [vertices, faces, boudingBox, center] = ConeGenerator<VertexP>{}.getObject(glm::vec3(0.0f), 1.0f, 2.0f, glm::ivec3(6, 1, 2), true, true, TriangleDirection::CounterClockwise);
+
+	ASSERT_EQ(vertices.size(), buffers.vertices.size());
+	ASSERT_EQ(faces.size() * 3, buffers.indices.size());
+	for (size_t i{ 0 }; i < vertices.size(); ++i)
+	{
+		EXPECT_EQ(vertices[i]->position, buffers.vertices[i].position);
+	}
+	for (size_t i{ 0 }; i < faces.size(); ++i)
+	{
+		EXPECT_EQ(faces[i]->indices, std::vector<uint32_t>({ buffers.indices[3 * i], buffers.indices[3 * i + 1], buffers.indices[3 * i + 2] }));
+	}
+}
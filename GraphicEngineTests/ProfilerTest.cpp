@@ -0,0 +1,194 @@
+#include "pch.h"
+
+#define GRAPHIC_ENGINE_PROFILER
+#include "../GraphicEngine/Core/Profiler.hpp"
+#include "../GraphicEngine/Core/Profiler.cpp"
+
+#include <sstream>
+#include <thread>
+
+using namespace GraphicEngine::Core;
+
+namespace
+{
+	const ProfilerZoneStatistics* findZone(const std::vector<ProfilerZoneStatistics>& statistics, const std::string& name, bool gpu)
+	{
+		for (const auto& zone : statistics)
+		{
+			if (zone.name == name && zone.gpu == gpu)
+				return &zone;
+		}
+		return nullptr;
+	}
+}
+
+TEST(Profiler, PercentileUsesNearestRank)
+{
+	std::vector<double> samples;
+	for (int i{ 100 }; i >= 1; --i)
+	{
+		samples.push_back(static_cast<double>(i));
+	}
+
+	EXPECT_DOUBLE_EQ(Profiler::percentile(samples, 50.0), 50.0);
+	EXPECT_DOUBLE_EQ(Profiler::percentile(samples, 95.0), 95.0);
+	EXPECT_DOUBLE_EQ(Profiler::percentile(samples, 99.0), 99.0);
+	EXPECT_DOUBLE_EQ(Profiler::percentile(samples, 100.0), 100.0);
+	EXPECT_DOUBLE_EQ(Profiler::percentile(samples, 0.0), 1.0);
+	EXPECT_DOUBLE_EQ(Profiler::percentile({}, 50.0), 0.0);
+}
+
+TEST(Profiler, NestedZonesAreMeasured)
+{
+	Profiler profiler;
+	profiler.beginFrame();
+	{
+		PROFILE_CPU_ZONE(&profiler, "Outer");
+		{
+			PROFILE_CPU_ZONE(&profiler, "Inner");
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}
+	}
+	profiler.endFrame();
+
+	auto statistics = profiler.getStatistics();
+	auto outer = findZone(statistics, "Outer", false);
+	auto inner = findZone(statistics, "Inner", false);
+	auto frame = findZone(statistics, "Frame", false);
+	ASSERT_NE(outer, nullptr);
+	ASSERT_NE(inner, nullptr);
+	ASSERT_NE(frame, nullptr);
+
+	EXPECT_GE(inner->last, 2.0);
+	EXPECT_GE(outer->last, inner->last);
+	EXPECT_GE(frame->last, outer->last);
+	EXPECT_EQ(profiler.getFramesCount(), 1);
+}
+
+TEST(Profiler, ZonesAreSummedPerFrame)
+{
+	Profiler profiler;
+	profiler.beginFrame();
+	profiler.addGpuZone("Pass", 1.0);
+	profiler.addGpuZone("Pass", 2.5);
+	profiler.endFrame();
+
+	auto statistics = profiler.getStatistics();
+	auto pass = findZone(statistics, "Pass", true);
+	ASSERT_NE(pass, nullptr);
+	EXPECT_DOUBLE_EQ(pass->last, 3.5);
+	EXPECT_EQ(findZone(statistics, "Pass", false), nullptr);
+}
+
+TEST(Profiler, StatisticsCoverRollingWindow)
+{
+	Profiler profiler;
+	// First frames are pushed out of the window by later ones
+	for (uint32_t frame{ 0 }; frame < Profiler::framesWindow + 10; ++frame)
+	{
+		profiler.beginFrame();
+		profiler.addGpuZone("Pass", frame < 10 ? 1000.0 : static_cast<double>(frame - 10 + 1));
+		profiler.endFrame();
+	}
+
+	auto pass = findZone(profiler.getStatistics(), "Pass", true);
+	ASSERT_NE(pass, nullptr);
+	EXPECT_DOUBLE_EQ(pass->last, static_cast<double>(Profiler::framesWindow));
+	EXPECT_DOUBLE_EQ(pass->p99, std::ceil(0.99 * Profiler::framesWindow));
+	EXPECT_DOUBLE_EQ(pass->p50, Profiler::framesWindow / 2.0);
+	EXPECT_DOUBLE_EQ(pass->average, (Profiler::framesWindow + 1) / 2.0);
+}
+
+TEST(Profiler, CountersAreSummedPerFrame)
+{
+	Profiler profiler;
+	profiler.beginFrame();
+	profiler.addCounter("Instances", 10.0);
+	profiler.addCounter("Instances", 5.0);
+	PROFILE_DRAW_CALLS(3);
+	PROFILE_DRAW_CALLS(4);
+	PROFILE_UPLOADED_BYTES(256);
+	profiler.endFrame();
+
+	auto counters = profiler.getCounterStatistics();
+	auto instances = findZone(counters, "Instances", false);
+	auto drawCalls = findZone(counters, "Draw calls", false);
+	auto uploadedBytes = findZone(counters, "Uploaded bytes", false);
+	ASSERT_NE(instances, nullptr);
+	ASSERT_NE(drawCalls, nullptr);
+	ASSERT_NE(uploadedBytes, nullptr);
+	EXPECT_DOUBLE_EQ(instances->last, 15.0);
+	EXPECT_DOUBLE_EQ(drawCalls->last, 7.0);
+	EXPECT_DOUBLE_EQ(uploadedBytes->last, 256.0);
+	EXPECT_EQ(findZone(profiler.getStatistics(), "Instances", false), nullptr);
+
+	// Driver counters start from zero every frame
+	profiler.beginFrame();
+	profiler.endFrame();
+	drawCalls = findZone(profiler.getCounterStatistics(), "Draw calls", false);
+	ASSERT_NE(drawCalls, nullptr);
+	EXPECT_DOUBLE_EQ(drawCalls->last, 0.0);
+	EXPECT_DOUBLE_EQ(drawCalls->average, 3.5);
+}
+
+TEST(Profiler, ResetDropsSamples)
+{
+	Profiler profiler;
+	profiler.beginFrame();
+	profiler.addGpuZone("Pass", 10.0);
+	profiler.endFrame();
+	profiler.reset();
+
+	EXPECT_TRUE(profiler.getStatistics().empty());
+	EXPECT_TRUE(profiler.getCounterStatistics().empty());
+	EXPECT_EQ(profiler.getFramesCount(), 0);
+
+	profiler.beginFrame();
+	profiler.addGpuZone("Pass", 2.0);
+	profiler.endFrame();
+	auto pass = findZone(profiler.getStatistics(), "Pass", true);
+	ASSERT_NE(pass, nullptr);
+	EXPECT_DOUBLE_EQ(pass->average, 2.0);
+}
+
+TEST(Profiler, ZoneEndedWithoutBeginThrows)
+{
+	Profiler profiler;
+	EXPECT_THROW(profiler.endZone(), std::runtime_error);
+}
+
+TEST(Profiler, ChromeTraceContainsCompleteEvents)
+{
+	Profiler profiler;
+	profiler.beginFrame();
+	{
+		PROFILE_CPU_ZONE(&profiler, "Shadows \"directional\"");
+	}
+	profiler.addGpuZone("Grass", 0.5);
+	profiler.addGpuZone("Solid", 1.5);
+	profiler.endFrame();
+
+	std::stringstream stream;
+	profiler.writeChromeTrace(stream);
+	auto trace = nlohmann::json::parse(stream.str());
+
+	std::vector<nlohmann::json> cpuEvents;
+	std::vector<nlohmann::json> gpuEvents;
+	for (const auto& event : trace["traceEvents"])
+	{
+		if (event["ph"] != "X")
+			continue;
+		(event["tid"] == 1 ? gpuEvents : cpuEvents).push_back(event);
+	}
+
+	ASSERT_EQ(cpuEvents.size(), 2);
+	EXPECT_EQ(cpuEvents[0]["name"], "Shadows \"directional\"");
+	EXPECT_EQ(cpuEvents[1]["name"], "Frame");
+
+	// GPU events follow each other from frame start
+	ASSERT_EQ(gpuEvents.size(), 2);
+	EXPECT_DOUBLE_EQ(gpuEvents[0]["ts"].get<double>(), cpuEvents[1]["ts"].get<double>());
+	EXPECT_DOUBLE_EQ(gpuEvents[0]["dur"].get<double>(), 500.0);
+	EXPECT_DOUBLE_EQ(gpuEvents[1]["ts"].get<double>(), gpuEvents[0]["ts"].get<double>() + 500.0);
+	EXPECT_DOUBLE_EQ(gpuEvents[1]["dur"].get<double>(), 1500.0);
+}
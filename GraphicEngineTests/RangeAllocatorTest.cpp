@@ -0,0 +1,55 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Common/RangeAllocator.cpp"
+
+using namespace GraphicEngine::Common;
+
+TEST(RangeAllocator, First_free_range_which_fits_is_reused)
+{
+	RangeAllocator allocator(16);
+	EXPECT_EQ(allocator.allocate(4), 0);
+	EXPECT_EQ(allocator.allocate(2), 4);
+	EXPECT_EQ(allocator.allocate(3), 6);
+	EXPECT_EQ(allocator.getEnd(), 9);
+
+	allocator.free(0);
+	EXPECT_THROW(allocator.free(0), std::out_of_range);
+	EXPECT_EQ(allocator.allocate(5), 9);
+	// Rest of reused range stays free
+	EXPECT_EQ(allocator.allocate(3), 0);
+	EXPECT_EQ(allocator.allocate(1), 3);
+	EXPECT_EQ(allocator.getCount(9), 5);
+	EXPECT_FALSE(allocator.allocate(3));
+}
+
+TEST(RangeAllocator, Freed_neighbours_are_merged_and_end_moves_back)
+{
+	RangeAllocator allocator(16);
+	allocator.allocate(2);
+	allocator.allocate(2);
+	allocator.allocate(2);
+	allocator.allocate(2);
+
+	allocator.free(2);
+	allocator.free(4);
+	EXPECT_EQ(allocator.getEnd(), 8);
+	EXPECT_EQ(allocator.allocate(4), 2);
+
+	allocator.free(6);
+	EXPECT_EQ(allocator.getEnd(), 6);
+	allocator.free(2);
+	allocator.free(0);
+	EXPECT_EQ(allocator.getEnd(), 0);
+	EXPECT_EQ(allocator.allocate(16), 0);
+}
+
+TEST(RangeAllocator, Ranges_start_at_multiple_of_alignment)
+{
+	RangeAllocator allocator(64);
+	EXPECT_EQ(allocator.allocate(5), 0);
+	EXPECT_EQ(allocator.allocate(12, 12), 12);
+	// Padding before aligned range is free
+	EXPECT_EQ(allocator.allocate(7), 5);
+	EXPECT_EQ(allocator.allocate(8, 8), 24);
+	EXPECT_THROW(allocator.allocate(0), std::invalid_argument);
+}
@@ -0,0 +1,143 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Common/EntityByVertexTypeManager.hpp"
+#include "../GraphicEngine/Common/RenderQueue.cpp"
+
+#include <random>
+
+using namespace GraphicEngine::Common;
+
+namespace
+{
+	template <typename VertexType>
+	struct TestEntity
+	{
+		using vertex_type = VertexType;
+		float depth{ 0.0f };
+		uint32_t material{ 0 };
+	};
+}
+
+TEST(RenderQueue, Records_are_sorted_by_key)
+{
+	std::mt19937_64 generator(7);
+	RenderQueue renderQueue;
+	std::vector<uint64_t> keys;
+	for (uint32_t i{ 0 }; i < 1000; ++i)
+	{
+		uint64_t key = generator();
+		keys.push_back(key);
+		renderQueue.push({ key, i });
+	}
+	renderQueue.sort();
+	std::sort(std::begin(keys), std::end(keys));
+
+	const auto& records = renderQueue.getRecords();
+	ASSERT_EQ(records.size(), keys.size());
+	for (size_t i{ 0 }; i < records.size(); ++i)
+	{
+		EXPECT_EQ(records[i].sortKey, keys[i]);
+	}
+}
+
+TEST(RenderQueue, Sort_is_stable)
+{
+	RenderQueue renderQueue;
+	for (uint32_t i{ 0 }; i < 100; ++i)
+	{
+		renderQueue.push({ RenderQueue::makeSortKey(i % 3, 1.0f), i });
+	}
+	renderQueue.sort();
+
+	const auto& records = renderQueue.getRecords();
+	for (size_t i{ 1 }; i < records.size(); ++i)
+	{
+		if (records[i - 1].sortKey == records[i].sortKey)
+		{
+			EXPECT_LT(records[i - 1].entity, records[i].entity);
+		}
+	}
+}
+
+TEST(RenderQueue, Key_groups_material_and_goes_front_to_back)
+{
+	EXPECT_LT(RenderQueue::makeSortKey(1, 100.0f), RenderQueue::makeSortKey(2, 0.5f));
+	EXPECT_LT(RenderQueue::makeSortKey(1, 0.5f), RenderQueue::makeSortKey(1, 2.0f));
+	EXPECT_LT(RenderQueue::makeSortKey(1, 2.0f), RenderQueue::makeSortKey(1, 1000.0f));
+	EXPECT_EQ(RenderQueue::makeSortKey(1, -5.0f), RenderQueue::makeSortKey(1, 0.0f));
+}
+
+TEST(EntityByVertexTypeManager, Entities_are_visited_sorted_for_each_vertex_type)
+{
+	EntityByVertexTypeManager<TestEntity> manager;
+	for (float depth : { 3.0f, 1.0f, 2.0f })
+	{
+		manager.addEntity(std::make_shared<TestEntity<VertexP>>(TestEntity<VertexP>{ depth, 0 }));
+	}
+	manager.addEntity(std::make_shared<TestEntity<VertexPN>>(TestEntity<VertexPN>{ 5.0f, 1 }));
+	manager.addEntity(std::make_shared<TestEntity<VertexPN>>(TestEntity<VertexPN>{ 4.0f, 0 }));
+
+	std::vector<float> depths;
+	std::vector<uint32_t> handles;
+	manager.forEachEntitySorted([](const auto& entity, uint32_t handle)
+	{
+		DrawRecord record;
+		record.entity = handle;
+		record.sortKey = RenderQueue::makeSortKey(entity->material, entity->depth);
+		return record;
+	},
+	[&](const auto& entity, const DrawRecord& record)
+	{
+		depths.push_back(entity->depth);
+		handles.push_back(record.entity);
+	});
+
+	EXPECT_EQ(depths, (std::vector<float>{ 1.0f, 2.0f, 3.0f, 4.0f, 5.0f }));
+	// Handles follow order of forEachEntity
+	EXPECT_EQ(handles, (std::vector<uint32_t>{ 1, 2, 0, 4, 3 }));
+
+	uint32_t count{ 0 };
+	manager.forEachEntity([&](auto entity) { ++count; });
+	EXPECT_EQ(count, 5);
+
+	auto it = manager.findIf<VertexPN>([](auto entity) { return entity->depth == 5.0f; });
+	manager.eraseEntity<VertexPN>(it);
+	EXPECT_EQ(manager.getFirstEntity<VertexPN>()->depth, 4.0f);
+	manager.clear();
+	EXPECT_THROW(manager.getFirstEntity<VertexP>(), std::out_of_range);
+}
+
+TEST(EntityByVertexTypeManager, Split_ranges_visit_every_entity_once)
+{
+	EntityByVertexTypeManager<TestEntity> manager;
+	for (float depth : { 3.0f, 1.0f, 2.0f })
+	{
+		manager.addEntity(std::make_shared<TestEntity<VertexP>>(TestEntity<VertexP>{ depth, 0 }));
+	}
+	manager.addEntity(std::make_shared<TestEntity<VertexPN>>(TestEntity<VertexPN>{ 5.0f, 0 }));
+	manager.addEntity(std::make_shared<TestEntity<VertexPN>>(TestEntity<VertexPN>{ 4.0f, 0 }));
+	ASSERT_EQ(manager.getEntitiesCount(), 5);
+
+	// Parts cross boundary between vertex types
+	std::vector<uint32_t> handles;
+	for (auto [first, last] : { std::pair<uint32_t, uint32_t>{ 0, 2 }, { 2, 4 }, { 4, 5 } })
+	{
+		manager.forEachEntityInRange(first, last, [&](const auto& entity, uint32_t handle) { handles.push_back(handle); });
+	}
+	EXPECT_EQ(handles, (std::vector<uint32_t>{ 0, 1, 2, 3, 4 }));
+
+	manager.sortEntities([](const auto& entity, uint32_t handle)
+	{
+		DrawRecord record;
+		record.entity = handle;
+		record.sortKey = RenderQueue::makeSortKey(entity->material, entity->depth);
+		return record;
+	});
+
+	std::vector<float> depths;
+	for (auto [first, last] : { std::pair<uint32_t, uint32_t>{ 0, 2 }, { 2, 4 }, { 4, 5 } })
+	{
+		manager.forEachSortedEntity(first, last, [&](const auto& entity, const DrawRecord& record) { depths.push_back(entity->depth); });
+	}
+	EXPECT_EQ(depths, (std::vector<float>{ 1.0f, 2.0f, 3.0f, 4.0f, 5.0f }));
+}
@@ -0,0 +1,72 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Core/IO/ShaderSourceReader.cpp"
+
+#include <fstream>
+
+using namespace GraphicEngine::Core::IO;
+
+namespace
+{
+	class ShaderSourceReaderTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			directory = std::filesystem::temp_directory_path() / ("ShaderSourceReaderTest_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+			std::filesystem::remove_all(directory);
+			std::filesystem::create_directories(directory);
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove_all(directory);
+		}
+
+		void writeFile(const std::string& fileName, const std::string& content)
+		{
+			std::ofstream file(directory / fileName, std::ios::binary | std::ios::trunc);
+			file << content;
+		}
+
+		std::filesystem::path directory;
+	};
+}
+
+TEST_F(ShaderSourceReaderTest, Include_is_replaced_by_file_content_and_line_is_restored)
+{
+	writeFile("light.glsl", "uniform vec4 light;\n");
+	writeFile("solid.frag", "#version 450 core\n#include \"light.glsl\"\nvoid main() {}\n");
+
+	EXPECT_EQ(readShaderSource(directory / "solid.frag"), "#version 450 core\nuniform vec4 light;\n#line 3\nvoid main() {}\n");
+}
+
+TEST_F(ShaderSourceReaderTest, Each_file_is_included_once)
+{
+	writeFile("a.glsl", "#include \"b.glsl\"\nint a;\n");
+	writeFile("b.glsl", "#include \"a.glsl\"\nint b;\n");
+	writeFile("grass.frag", "#include \"a.glsl\"\n  #include \"b.glsl\"\nvoid main() {}\n");
+
+	EXPECT_EQ(readShaderSource(directory / "grass.frag"), "int b;\n#line 2\nint a;\n#line 2\nvoid main() {}\n");
+}
+
+TEST_F(ShaderSourceReaderTest, Change_of_included_file_changes_source)
+{
+	writeFile("light.glsl", "int count;\n");
+	writeFile("solid.frag", "#include \"light.glsl\"\n");
+	auto before = readShaderSource(directory / "solid.frag");
+
+	writeFile("light.glsl", "uint count;\n");
+	EXPECT_NE(readShaderSource(directory / "solid.frag"), before);
+}
+
+TEST_F(ShaderSourceReaderTest, Missing_or_invalid_include_throws)
+{
+	writeFile("missing.frag", "#include \"missing.glsl\"\n");
+	writeFile("invalid.frag", "#include light.glsl\n");
+
+	EXPECT_THROW(readShaderSource(directory / "missing.frag"), std::runtime_error);
+	EXPECT_THROW(readShaderSource(directory / "invalid.frag"), std::runtime_error);
+	EXPECT_TRUE(isShaderInclude("lightCluster.glsl"));
+	EXPECT_FALSE(isShaderInclude("solid.frag"));
+}
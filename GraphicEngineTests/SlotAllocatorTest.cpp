@@ -0,0 +1,47 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Common/SlotAllocator.cpp"
+
+using namespace GraphicEngine::Common;
+
+TEST(SlotAllocator, Freed_slots_are_reused_from_lowest_one)
+{
+	SlotAllocator allocator(8);
+	for (uint32_t i{ 0 }; i < 5; ++i)
+	{
+		EXPECT_EQ(allocator.allocate(), i);
+	}
+
+	allocator.free(3);
+	allocator.free(1);
+	EXPECT_EQ(allocator.getAllocatedCount(), 3);
+	EXPECT_EQ(allocator.getEnd(), 5);
+	EXPECT_FALSE(allocator.isAllocated(1));
+	EXPECT_THROW(allocator.free(1), std::invalid_argument);
+
+	EXPECT_EQ(allocator.allocate(), 1);
+	EXPECT_EQ(allocator.allocate(), 3);
+	EXPECT_EQ(allocator.allocate(), 5);
+}
+
+TEST(SlotAllocator, End_moves_back_when_last_slots_are_freed)
+{
+	SlotAllocator allocator(4);
+	for (uint32_t i{ 0 }; i < 4; ++i)
+	{
+		allocator.allocate();
+	}
+	EXPECT_FALSE(allocator.allocate());
+
+	allocator.free(2);
+	EXPECT_EQ(allocator.getEnd(), 4);
+	allocator.free(3);
+	EXPECT_EQ(allocator.getEnd(), 2);
+	EXPECT_EQ(allocator.allocate(), 2);
+
+	allocator.free(0);
+	allocator.free(1);
+	allocator.free(2);
+	EXPECT_EQ(allocator.getEnd(), 0);
+	EXPECT_EQ(allocator.getAllocatedCount(), 0);
+}
@@ -0,0 +1,96 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Common/Vertex.hpp"
+#include "../GraphicEngine/Core/Math/VertexCacheOptimizer.hpp"
+#include "../GraphicEngine/Core/Math/VertexCacheOptimizer.cpp"
+#include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/PlaneGenerator.hpp"
+#include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/SphereGenerator.hpp"
+
+#include <algorithm>
+
+using namespace GraphicEngine::Core::Math;
+using namespace GraphicEngine::Engines::Graphic;
+using namespace GraphicEngine::Common;
+
+namespace
+{
+	std::vector<std::array<uint32_t, 3>> sortedTriangles(const std::vector<uint32_t>& indices)
+	{
+		std::vector<std::array<uint32_t, 3>> triangles;
+		for (size_t i{ 0 }; i < indices.size(); i += 3)
+		{
+			// Rotation keeps winding, smallest index goes first
+			std::array<uint32_t, 3> triangle{ indices[i], indices[i + 1], indices[i + 2] };
+			std::rotate(std::begin(triangle), std::min_element(std::begin(triangle), std::end(triangle)), std::end(triangle));
+			triangles.push_back(triangle);
+		}
+		std::sort(std::begin(triangles), std::end(triangles));
+		return triangles;
+	}
+
+	// Row by row grid which rows do not fit in cache
+	std::vector<uint32_t> rowMajorGrid(uint32_t size)
+	{
+		std::vector<uint32_t> indices;
+		for (uint32_t x{ 0 }; x < size; ++x)
+		{
+			for (uint32_t y{ 0 }; y < size; ++y)
+			{
+				uint32_t point = y + x * (size + 1);
+				indices.insert(std::end(indices), { point, point + size + 1, point + size + 2, point, point + size + 2, point + 1 });
+			}
+		}
+		return indices;
+	}
+}
+
+TEST(VertexCacheOptimizer, ACMR_counts_cache_misses)
+{
+	// Two triangles sharing edge need four vertices
+	EXPECT_FLOAT_EQ(calculateACMR({ 0, 1, 2, 2, 1, 3 }, 4), 2.0f);
+	// Same triangle again is fully cached
+	EXPECT_FLOAT_EQ(calculateACMR({ 0, 1, 2, 0, 1, 2 }, 3), 1.5f);
+	// Cache of three entries drops first vertex
+	EXPECT_FLOAT_EQ(calculateACMR({ 0, 1, 2, 3, 4, 5, 0, 1, 2 }, 6, 3), 3.0f);
+	EXPECT_FLOAT_EQ(calculateACMR({}, 0), 0.0f);
+}
+
+TEST(VertexCacheOptimizer, Optimized_order_is_permutation_of_triangles)
+{
+	auto buffers = SphereGenerator<VertexP>{}.getBuffers(glm::vec3(0.0f), 1.0f, glm::ivec2(40, 30));
+	auto optimized = optimizeVertexCache(buffers.indices, buffers.vertices.size());
+	EXPECT_EQ(sortedTriangles(optimized), sortedTriangles(buffers.indices));
+
+	auto order = calculateVertexCacheOrder(buffers.indices, buffers.vertices.size());
+	std::sort(std::begin(order), std::end(order));
+	for (uint32_t i{ 0 }; i < order.size(); ++i)
+	{
+		ASSERT_EQ(order[i], i);
+	}
+}
+
+TEST(VertexCacheOptimizer, Optimization_reduces_ACMR)
+{
+	auto indices = rowMajorGrid(64);
+	size_t verticesCount = 65 * 65;
+	float before = calculateACMR(indices, verticesCount);
+	float after = calculateACMR(optimizeVertexCache(indices, verticesCount), verticesCount);
+	EXPECT_GT(before, 0.95f);
+	EXPECT_LT(after, 0.75f);
+
+	auto buffers = SphereGenerator<VertexP>{}.getBuffers(glm::vec3(0.0f), 1.0f, glm::ivec2(64, 64));
+	EXPECT_LT(calculateACMR(optimizeVertexCache(buffers.indices, buffers.vertices.size()), buffers.vertices.size()), calculateACMR(buffers.indices, buffers.vertices.size()));
+}
+
+TEST(VertexCacheOptimizer, Generated_plane_is_cache_friendly)
+{
+	auto buffers = PlaneGenerator<VertexP>{}.getBuffers(glm::vec2(-5.0f), glm::vec2(5.0f), glm::ivec2(64, 64));
+	EXPECT_EQ(sortedTriangles(buffers.indices), sortedTriangles(rowMajorGrid(64)));
+	EXPECT_LT(calculateACMR(buffers.indices, buffers.vertices.size()), 0.75f);
+}
+
+TEST(VertexCacheOptimizer, Invalid_indices_throw)
+{
+	EXPECT_THROW(calculateVertexCacheOrder({ 0, 1 }, 2), std::invalid_argument);
+	EXPECT_THROW(calculateVertexCacheOrder({ 0, 1, 5 }, 3), std::out_of_range);
+}
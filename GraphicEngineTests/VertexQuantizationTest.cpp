@@ -0,0 +1,85 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Common/PackedVertex.hpp"
+#include "../GraphicEngine/Core/Math/VertexQuantization.hpp"
+#include "../GraphicEngine/Core/Math/VertexQuantization.cpp"
+#include "../GraphicEngine/Engines/Graphic/3D/ObjectGenerators/SphereGenerator.hpp"
+
+#include <glm/gtc/packing.hpp>
+
+using namespace GraphicEngine::Core::Math;
+using namespace GraphicEngine::Engines::Graphic;
+using namespace GraphicEngine::Common;
+
+TEST(VertexQuantization, Packed_vertices_are_smaller)
+{
+	EXPECT_EQ(VertexPNPacked::getStride(), 16);
+	EXPECT_EQ(VertexPTcNPacked::getStride(), 20);
+	EXPECT_EQ(VertexPTcNTBPacked::getStride(), 36);
+
+	// Attributes have to be in same order and count as in source vertex, so same shaders can read them
+	EXPECT_EQ(VertexPNPacked::getSizeAndOffsets().size(), VertexPN::getSizeAndOffsets().size());
+	EXPECT_EQ(VertexPTcNPacked::getSizeAndOffsets().size(), VertexPTcN::getSizeAndOffsets().size());
+	EXPECT_EQ(VertexPTcNTBPacked::getSizeAndOffsets().size(), VertexPTcNTB::getSizeAndOffsets().size());
+	EXPECT_EQ(VertexPNPacked::getType(), VertexPN::getType());
+	EXPECT_EQ(VertexPTcNTBPacked::getType(), VertexPTcNTB::getType());
+}
+
+TEST(VertexQuantization, Sphere_is_restored_within_quantization_error)
+{
+	glm::vec3 center(10.0f, -4.0f, 2.0f);
+	auto buffers = SphereGenerator<VertexPN>{}.getBuffers(center, 3.0f, glm::ivec2(64, 32));
+	for (auto& vertex : buffers.vertices)
+	{
+		vertex.normal = glm::normalize(vertex.position - center);
+	}
+
+	PositionQuantization quantization;
+	auto packed = packVertices(buffers.vertices, quantization);
+	ASSERT_EQ(packed.size(), buffers.vertices.size());
+	EXPECT_NEAR(quantization.extent, 6.0f, 1e-4f);
+
+	auto dequantization = getDequantizationMatrix(quantization);
+	for (size_t i{ 0 }; i < packed.size(); ++i)
+	{
+		// Half of 16 bit step of 6 units cube
+		glm::vec3 position = dequantizePosition(packed[i].position, quantization);
+		EXPECT_LT(glm::length(position - buffers.vertices[i].position), 6.0f / 65535.0f);
+
+		// Shader reads unorm as [0, 1] and applies dequantization before model matrix
+		glm::vec3 shaderPosition = glm::vec3(dequantization * glm::vec4(glm::vec3(glm::unpackUnorm<float>(packed[i].position)), 1.0f));
+		EXPECT_LT(glm::length(shaderPosition - position), 1e-4f);
+
+		glm::vec3 normal = dequantizeNormal(packed[i].normal);
+		EXPECT_GT(glm::dot(glm::normalize(normal), buffers.vertices[i].normal), 0.9999f);
+	}
+}
+
+TEST(VertexQuantization, Texture_coordinates_are_half_floats)
+{
+	for (float u : { 0.0f, 0.125f, 0.5f, 0.75f, 1.0f })
+	{
+		glm::vec2 texCoord(u, 1.0f - u);
+		auto restored = dequantizeTexCoord(quantizeTexCoord(texCoord));
+		EXPECT_NEAR(restored.x, texCoord.x, 1e-3f);
+		EXPECT_NEAR(restored.y, texCoord.y, 1e-3f);
+	}
+}
+
+TEST(VertexQuantization, Vertices_without_packed_variant_are_not_changed)
+{
+	std::vector<VertexP> vertices{ VertexP(glm::vec3(1.0f, 2.0f, 3.0f)), VertexP(glm::vec3(-5.0f, 0.0f, 8.0f)) };
+
+	PositionQuantization quantization;
+	auto packed = packVertices(vertices, quantization);
+	ASSERT_EQ(packed.size(), vertices.size());
+	EXPECT_EQ(packed[1].position, vertices[1].position);
+	EXPECT_EQ(getDequantizationMatrix(quantization), glm::mat4(1.0f));
+}
+
+TEST(VertexQuantization, Flat_mesh_has_valid_quantization)
+{
+	auto quantization = calculatePositionQuantization(glm::vec3(1.0f), glm::vec3(1.0f));
+	EXPECT_EQ(quantization.extent, 1.0f);
+	EXPECT_EQ(dequantizePosition(quantizePosition(glm::vec3(1.0f), quantization), quantization), glm::vec3(1.0f));
+}
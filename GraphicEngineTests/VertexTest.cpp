@@ -6,8 +6,8 @@ using namespace GraphicEngine::Common;
 TEST(VertexSizeOffsetStrideTest, IsBasicValuesCorrect)
 {
 	auto sizeAndOffset = VertexP::getSizeAndOffsets();
-	EXPECT_EQ(sizeAndOffset[0].first, 3);
-	EXPECT_EQ(sizeAndOffset[0].second, 0);
+	EXPECT_EQ(sizeAndOffset[0].size, 3);
+	EXPECT_EQ(sizeAndOffset[0].offset, 0);
 	uint32_t stride = VertexP::getStride();
 	EXPECT_EQ(stride, 12);
 }
@@ -17,12 +17,26 @@ TEST(VertexSizeOffsetStrideTest, IsPositionColorTexCoordCorrect)
 	auto sizeAndOffset = VertexPCTc::getSizeAndOffsets();
 
 	EXPECT_EQ(sizeAndOffset.size(), 3);
-	EXPECT_EQ(sizeAndOffset[0].first, 3);
-	EXPECT_EQ(sizeAndOffset[0].second, 0);
-	EXPECT_EQ(sizeAndOffset[1].first, 3);
-	EXPECT_EQ(sizeAndOffset[1].second, 3*4);
-	EXPECT_EQ(sizeAndOffset[2].first, 2);
-	EXPECT_EQ(sizeAndOffset[2].second, 2 * 3 * 4);
+	EXPECT_EQ(sizeAndOffset[0].size, 3);
+	EXPECT_EQ(sizeAndOffset[0].offset, 0);
+	EXPECT_EQ(sizeAndOffset[1].size, 3);
+	EXPECT_EQ(sizeAndOffset[1].offset, 3*4);
+	EXPECT_EQ(sizeAndOffset[2].size, 2);
+	EXPECT_EQ(sizeAndOffset[2].offset, 2 * 3 * 4);
 	uint32_t stride = VertexPCTc::getStride();
 	EXPECT_EQ(stride, (3 + 3 + 2) * 4);
-}
\ No newline at end of file
+}
+
+TEST(VertexSizeOffsetStrideTest, IsLayoutKnownAtCompileTime)
+{
+	constexpr auto sizeAndOffset = VertexPTcNTBW::getSizeAndOffsets();
+	static_assert(sizeAndOffset.size() == 6);
+	static_assert(sizeAndOffset[3].size == 3 && sizeAndOffset[3].offset == (3 + 2 + 3) * 4);
+	static_assert(sizeAndOffset[5].size == 4 && sizeAndOffset[5].offset == (3 + 2 + 3 + 3 + 3) * 4);
+	static_assert(VertexPTcNTBW::getStride() == (3 + 2 + 3 + 3 + 3 + 4) * 4);
+	static_assert(VertexPCN::getType() == (VertexType::Position | VertexType::Color | VertexType::Normal));
+
+	VertexPCN vertex(glm::vec3(1.0f), glm::vec3(0.5f), glm::vec3(0.0f, 1.0f, 0.0f));
+	EXPECT_EQ(vertex.color, glm::vec3(0.5f));
+	EXPECT_EQ(reinterpret_cast<const char*>(&vertex.normal) - reinterpret_cast<const char*>(&vertex), VertexPCN::getSizeAndOffsets()[2].offset);
+}
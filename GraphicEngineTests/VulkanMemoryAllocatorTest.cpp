@@ -0,0 +1,202 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Drivers/Vulkan/VulkanMemoryAllocator.cpp"
+
+#include <map>
+
+using namespace GraphicEngine::Vulkan;
+
+namespace
+{
+	// Memory type 1 is host visible, memory is identified by number of allocation
+	struct MockMemoryDevice
+	{
+		using Memory = uint32_t;
+
+		Memory allocate(uint32_t memoryType, uint64_t size)
+		{
+			++allocationsCount;
+			memories[++lastMemory] = std::vector<char>(size);
+			return lastMemory;
+		}
+
+		void free(Memory memory)
+		{
+			memories.erase(memory);
+		}
+
+		bool isHostVisible(uint32_t memoryType)
+		{
+			return memoryType == 1;
+		}
+
+		void* map(Memory memory, uint64_t size)
+		{
+			return memories[memory].data();
+		}
+
+		std::map<Memory, std::vector<char>>& memories;
+		uint32_t& allocationsCount;
+		Memory lastMemory{ 0 };
+	};
+
+	constexpr uint64_t blockSize{ 1 << 20 };
+}
+
+TEST(BuddyAllocator, Freed_blocks_are_merged_with_buddies)
+{
+	BuddyAllocator allocator(1024, 64);
+	auto first = allocator.allocate(100, 4);
+	auto second = allocator.allocate(64, 4);
+	auto third = allocator.allocate(200, 4);
+	ASSERT_TRUE(first && second && third);
+	EXPECT_EQ(*first, 0);
+	EXPECT_EQ(*second, 128);
+	EXPECT_EQ(*third, 256);
+	EXPECT_EQ(allocator.getUsedSize(), 128 + 64 + 256);
+	EXPECT_EQ(allocator.getLargestFreeSize(), 512);
+
+	allocator.free(*second);
+	allocator.free(*first);
+	EXPECT_EQ(allocator.getLargestFreeSize(), 512);
+	allocator.free(*third);
+	EXPECT_TRUE(allocator.isEmpty());
+	EXPECT_EQ(allocator.getLargestFreeSize(), 1024);
+	EXPECT_THROW(allocator.free(*third), std::invalid_argument);
+}
+
+TEST(BuddyAllocator, Offsets_respect_alignment)
+{
+	BuddyAllocator allocator(4096, 16);
+	allocator.allocate(16, 16);
+	auto aligned = allocator.allocate(16, 256);
+	ASSERT_TRUE(aligned);
+	EXPECT_EQ(*aligned % 256, 0);
+	EXPECT_FALSE(allocator.allocate(8192, 16));
+}
+
+TEST(LinearAllocator, Space_is_reused_when_all_allocations_are_freed)
+{
+	LinearAllocator allocator(1024);
+	auto first = allocator.allocate(100, 1);
+	auto second = allocator.allocate(100, 64);
+	ASSERT_TRUE(first && second);
+	EXPECT_EQ(*second, 128);
+	EXPECT_FALSE(allocator.allocate(1024, 1));
+
+	allocator.free(*first);
+	EXPECT_EQ(allocator.getUsedSize(), 228);
+	allocator.free(*second);
+	EXPECT_TRUE(allocator.isEmpty());
+	EXPECT_EQ(allocator.getLargestFreeSize(), 1024);
+}
+
+TEST(RingAllocator, Batches_are_released_in_order_and_allocations_wrap_around)
+{
+	RingAllocator allocator(1024);
+	auto first = allocator.allocate(400, 16);
+	allocator.closeBatch(1);
+	auto second = allocator.allocate(400, 16);
+	allocator.closeBatch(2);
+	ASSERT_TRUE(first && second);
+	EXPECT_EQ(*second, 400);
+	EXPECT_EQ(allocator.getOldestBatchValue(), 1);
+
+	// Only 224 bytes are left at end of buffer and start is still used by first batch
+	EXPECT_FALSE(allocator.allocate(300, 16));
+	allocator.release(1);
+	auto third = allocator.allocate(300, 16);
+	ASSERT_TRUE(third);
+	EXPECT_EQ(*third, 0);
+	EXPECT_TRUE(allocator.hasOpenBatch());
+	EXPECT_EQ(allocator.getUsedSize(), 224 + 400 + 300);
+	allocator.closeBatch(3);
+
+	allocator.release(3);
+	EXPECT_TRUE(allocator.isEmpty());
+	EXPECT_FALSE(allocator.getOldestBatchValue());
+	EXPECT_THROW(allocator.closeBatch(2), std::invalid_argument);
+}
+
+TEST(MemoryAllocator, Small_allocations_share_device_memory)
+{
+	std::map<uint32_t, std::vector<char>> memories;
+	uint32_t deviceAllocationsCount{ 0 };
+	MemoryAllocator<MockMemoryDevice> allocator(MockMemoryDevice{ memories, deviceAllocationsCount }, blockSize);
+
+	std::vector<MemoryAllocator<MockMemoryDevice>::Allocation> allocations;
+	for (uint32_t i{ 0 }; i < 2000; ++i)
+	{
+		allocations.push_back(allocator.allocate(0, 600 + i % 7, 16, MemoryLifetime::Persistent));
+	}
+	EXPECT_EQ(deviceAllocationsCount, 2);
+
+	auto statistics = allocator.getStatistics();
+	EXPECT_EQ(statistics.allocationsCount, 2000);
+	EXPECT_EQ(statistics.blocksCount, 2);
+	EXPECT_EQ(statistics.reservedBytes, 2 * blockSize);
+	EXPECT_EQ(statistics.usedBytes, 2000 * 1024);
+
+	// Every second allocation leaves holes which can not be merged
+	for (size_t i{ 0 }; i < allocations.size(); i += 2)
+	{
+		allocator.free(allocations[i]);
+	}
+	EXPECT_GT(allocator.getStatistics().fragmentation, 0.0f);
+
+	for (size_t i{ 1 }; i < allocations.size(); i += 2)
+	{
+		allocator.free(allocations[i]);
+	}
+	statistics = allocator.getStatistics();
+	EXPECT_EQ(statistics.allocationsCount, 0);
+	// One empty block is kept for next allocations
+	EXPECT_EQ(statistics.blocksCount, 1);
+	EXPECT_EQ(memories.size(), 1);
+	EXPECT_EQ(statistics.fragmentation, 0.0f);
+}
+
+TEST(MemoryAllocator, Big_allocations_get_own_memory)
+{
+	std::map<uint32_t, std::vector<char>> memories;
+	uint32_t deviceAllocationsCount{ 0 };
+	MemoryAllocator<MockMemoryDevice> allocator(MockMemoryDevice{ memories, deviceAllocationsCount }, blockSize);
+
+	auto allocation = allocator.allocate(1, blockSize, 256, MemoryLifetime::Persistent);
+	EXPECT_EQ(allocation.block, nullptr);
+	EXPECT_EQ(allocation.offset, 0);
+	EXPECT_EQ(allocation.mappedData, memories[allocation.memory].data());
+	EXPECT_EQ(allocator.getStatistics().dedicatedAllocationsCount, 1);
+
+	allocator.free(allocation);
+	EXPECT_TRUE(memories.empty());
+	EXPECT_EQ(allocator.getStatistics().reservedBytes, 0);
+}
+
+TEST(MemoryAllocator, Kinds_of_resources_are_kept_in_separate_blocks)
+{
+	std::map<uint32_t, std::vector<char>> memories;
+	uint32_t deviceAllocationsCount{ 0 };
+	MemoryAllocator<MockMemoryDevice> allocator(MockMemoryDevice{ memories, deviceAllocationsCount }, blockSize);
+
+	auto buffer = allocator.allocate(1, 1024, 16, MemoryLifetime::Persistent);
+	auto image = allocator.allocate(1, 1024, 16, MemoryLifetime::Persistent, true);
+	auto staging = allocator.allocate(1, 1024, 16, MemoryLifetime::Transient);
+	auto otherType = allocator.allocate(0, 1024, 16, MemoryLifetime::Persistent);
+	EXPECT_EQ(deviceAllocationsCount, 4);
+	EXPECT_NE(buffer.memory, image.memory);
+	EXPECT_NE(buffer.memory, staging.memory);
+	EXPECT_EQ(otherType.mappedData, nullptr);
+
+	// Host visible blocks are mapped once and allocations point inside of them
+	auto secondBuffer = allocator.allocate(1, 1024, 16, MemoryLifetime::Persistent);
+	EXPECT_EQ(secondBuffer.memory, buffer.memory);
+	EXPECT_EQ(static_cast<char*>(secondBuffer.mappedData), memories[buffer.memory].data() + secondBuffer.offset);
+
+	// Freed staging memory is reused from start of block
+	allocator.free(staging);
+	auto nextStaging = allocator.allocate(1, 1024, 16, MemoryLifetime::Transient);
+	EXPECT_EQ(nextStaging.memory, staging.memory);
+	EXPECT_EQ(nextStaging.offset, 0);
+	EXPECT_EQ(deviceAllocationsCount, 4);
+}
@@ -0,0 +1,65 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Drivers/Vulkan/VulkanPipelineCache.cpp"
+
+using namespace GraphicEngine::Vulkan;
+
+namespace
+{
+	void writeUint32(std::string& data, uint32_t value)
+	{
+		for (size_t i{ 0 }; i < sizeof(uint32_t); ++i)
+		{
+			data.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+		}
+	}
+
+	std::string makeCacheData(uint32_t vendorId, uint32_t deviceId, const std::array<uint8_t, 16>& uuid)
+	{
+		std::string data;
+		writeUint32(data, 32);
+		writeUint32(data, 1);
+		writeUint32(data, vendorId);
+		writeUint32(data, deviceId);
+		data.append(std::begin(uuid), std::end(uuid));
+		// Driver specific data after header
+		data.append(64, '\x7f');
+		return data;
+	}
+
+	const std::array<uint8_t, 16> uuid{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+}
+
+TEST(PipelineCache, Header_is_read_from_cache_data)
+{
+	auto header = readPipelineCacheHeader(makeCacheData(0x10de, 0x2204, uuid));
+	ASSERT_TRUE(header);
+	EXPECT_EQ(header->headerSize, 32);
+	EXPECT_EQ(header->vendorId, 0x10de);
+	EXPECT_EQ(header->deviceId, 0x2204);
+	EXPECT_EQ(header->pipelineCacheUuid, uuid);
+}
+
+TEST(PipelineCache, Cache_of_other_device_is_rejected)
+{
+	auto data = makeCacheData(0x10de, 0x2204, uuid);
+	EXPECT_TRUE(isPipelineCacheCompatible(data, 0x10de, 0x2204, uuid));
+	EXPECT_FALSE(isPipelineCacheCompatible(data, 0x1002, 0x2204, uuid));
+	EXPECT_FALSE(isPipelineCacheCompatible(data, 0x10de, 0x2206, uuid));
+
+	// Driver update changes UUID of cache
+	auto otherUuid = uuid;
+	otherUuid[15] = 0;
+	EXPECT_FALSE(isPipelineCacheCompatible(data, 0x10de, 0x2204, otherUuid));
+}
+
+TEST(PipelineCache, Truncated_or_empty_data_is_rejected)
+{
+	EXPECT_FALSE(readPipelineCacheHeader(""));
+	EXPECT_FALSE(readPipelineCacheHeader(makeCacheData(0x10de, 0x2204, uuid).substr(0, 20)));
+
+	auto data = makeCacheData(0x10de, 0x2204, uuid);
+	// Unknown header version
+	data[4] = 2;
+	EXPECT_FALSE(isPipelineCacheCompatible(data, 0x10de, 0x2204, uuid));
+}
@@ -0,0 +1,38 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Drivers/Vulkan/VulkanShaderCache.cpp"
+
+using namespace GraphicEngine;
+using namespace GraphicEngine::Vulkan;
+
+TEST(VulkanShaderCache, Hash_changes_with_source_and_options)
+{
+	auto hash = hashShaderSource("void main() {}", "vulkan1.2");
+
+	EXPECT_EQ(hash, hashShaderSource("void main() {}", "vulkan1.2"));
+	EXPECT_NE(hash, hashShaderSource("void main() { }", "vulkan1.2"));
+	EXPECT_NE(hash, hashShaderSource("void main() {}", "vulkan1.1"));
+	// Bytes moved from source to options give other hash
+	EXPECT_NE(hashShaderSource("ab", "c"), hashShaderSource("a", "bc"));
+	// Hash of empty input is offset basis of FNV-1a followed by separator
+	EXPECT_EQ(hashShaderSource("", ""), (14695981039346656037ull ^ 0) * 1099511628211ull);
+}
+
+TEST(VulkanShaderCache, Cache_file_name_keeps_source_name)
+{
+	EXPECT_EQ(getShaderCacheFileName("solid.frag", 0x1234abcdull), "solid.frag.000000001234abcd.spv");
+	EXPECT_EQ(getShaderCacheFileName("cull.comp", 0xffffffffffffffffull), "cull.comp.ffffffffffffffff.spv");
+}
+
+TEST(VulkanShaderCache, Stage_is_given_by_last_extension)
+{
+	EXPECT_EQ(getShaderTypeFromFileName("solid.vert"), ShaderType::Vertex);
+	EXPECT_EQ(getShaderTypeFromFileName("solid.frag"), ShaderType::Fragment);
+	EXPECT_EQ(getShaderTypeFromFileName("normals.geom"), ShaderType::Geometry);
+	EXPECT_EQ(getShaderTypeFromFileName("terrain.tesc"), ShaderType::TessalationControll);
+	EXPECT_EQ(getShaderTypeFromFileName("terrain.tese"), ShaderType::TessalationEvaluation);
+	EXPECT_EQ(getShaderTypeFromFileName("cull.comp"), ShaderType::Compute);
+
+	EXPECT_FALSE(getShaderTypeFromFileName("shadowmap.geom.template").has_value());
+	EXPECT_FALSE(getShaderTypeFromFileName("compile").has_value());
+}
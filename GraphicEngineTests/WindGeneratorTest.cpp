@@ -0,0 +1,122 @@
+#include "pch.h"
+
+#include "../GraphicEngine/Engines/Graphic/2D/WindGenerator.hpp"
+#include "../GraphicEngine/Engines/Graphic/2D/WindGenerator.cpp"
+
+#include <vector>
+
+using namespace GraphicEngine::Engines::Graphic;
+
+namespace
+{
+	std::vector<uint8_t> generate(uint32_t dim, float speed, float time, bool avx2)
+	{
+		std::vector<uint8_t> data(static_cast<size_t>(dim) * dim * 4);
+		WindGenerator::setAvx2Enabled(avx2);
+		WindGenerator::generate(data.data(), dim, speed, time);
+		WindGenerator::setAvx2Enabled(true);
+		return data;
+	}
+}
+
+TEST(WindGenerator, NoiseIsPeriodic)
+{
+	for (float x{ 0.0f }; x < 4.0f; x += 0.37f)
+	{
+		for (float y{ 0.0f }; y < 3.0f; y += 0.29f)
+		{
+			EXPECT_NEAR(WindGenerator::noise(x, y, 0.4f, 4, 3), WindGenerator::noise(x + 4.0f, y, 0.4f, 4, 3), 1e-5f);
+			EXPECT_NEAR(WindGenerator::noise(x, y, 0.4f, 4, 3), WindGenerator::noise(x, y + 3.0f, 0.4f, 4, 3), 1e-5f);
+		}
+	}
+}
+
+TEST(WindGenerator, NoiseVanishesOnLattice)
+{
+	EXPECT_FLOAT_EQ(WindGenerator::noise(1.0f, 2.0f, 3.0f, 4, 4), 0.0f);
+	EXPECT_NE(WindGenerator::noise(1.5f, 2.5f, 3.5f, 4, 4), 0.0f);
+}
+
+TEST(WindGenerator, TextureIsTileable)
+{
+	const uint32_t dim{ 64 };
+	auto data = generate(dim, 1.0f, 0.0f, false);
+
+	// Neighbour texels across the texture edge differ as little as neighbours inside the texture
+	int maxInnerStep{ 0 };
+	int maxEdgeStep{ 0 };
+	for (uint32_t y{ 0 }; y < dim; ++y)
+	{
+		for (uint32_t x{ 0 }; x < dim; ++x)
+		{
+			int current = data[4 * (y * dim + x) + 2];
+			int next = data[4 * (y * dim + (x + 1) % dim) + 2];
+			int& step = x + 1 == dim ? maxEdgeStep : maxInnerStep;
+			step = std::max(step, std::abs(current - next));
+		}
+	}
+	EXPECT_LE(maxEdgeStep, maxInnerStep + 1);
+}
+
+TEST(WindGenerator, Avx2MatchesScalar)
+{
+	if (!WindGenerator::isAvx2Supported())
+		GTEST_SKIP();
+
+	// 100 is not multiple of 8, so scalar tail of vectorized rows is tested too
+	for (uint32_t dim : { 64u, 100u })
+	{
+		auto scalar = generate(dim, 0.75f, 1.3f, false);
+		auto vectorized = generate(dim, 0.75f, 1.3f, true);
+		ASSERT_EQ(scalar.size(), vectorized.size());
+		for (size_t i{ 0 }; i < scalar.size(); ++i)
+		{
+			EXPECT_LE(std::abs(scalar[i] - vectorized[i]), 1) << "texel " << i / 4;
+		}
+	}
+}
+
+TEST(WindGenerator, RowsRangeMatchesFullTexture)
+{
+	const uint32_t dim{ 32 };
+	auto full = generate(dim, 1.0f, 0.5f, true);
+
+	std::vector<uint8_t> partial(full.size(), 0);
+	WindGenerator::generate(partial.data(), dim, 1.0f, 0.5f, 8, 4);
+	for (size_t i{ 0 }; i < partial.size(); ++i)
+	{
+		size_t row = i / (4 * dim);
+		EXPECT_EQ(partial[i], row >= 8 && row < 12 ? full[i] : 0);
+	}
+}
+
+TEST(WindGenerator, FieldEvolvesInTime)
+{
+	const uint32_t dim{ 32 };
+	auto first = generate(dim, 1.0f, 0.0f, true);
+	auto slightlyLater = generate(dim, 1.0f, 0.01f, true);
+	auto later = generate(dim, 1.0f, 0.5f, true);
+
+	int slightDifference{ 0 };
+	int difference{ 0 };
+	for (size_t i{ 0 }; i < first.size(); ++i)
+	{
+		slightDifference = std::max(slightDifference, std::abs(first[i] - slightlyLater[i]));
+		difference = std::max(difference, std::abs(first[i] - later[i]));
+	}
+	EXPECT_LE(slightDifference, 8);
+	EXPECT_GT(difference, 8);
+}
+
+TEST(WindGenerator, ChannelsLayout)
+{
+	auto data = generate(16, 1.0f, 0.0f, true);
+	bool channelsDiffer{ false };
+	for (size_t i{ 0 }; i < data.size(); i += 4)
+	{
+		EXPECT_EQ(data[i + 1], 0);
+		EXPECT_EQ(data[i + 3], 0);
+		channelsDiffer = channelsDiffer || data[i] != data[i + 2];
+	}
+	EXPECT_TRUE(channelsDiffer);
+}